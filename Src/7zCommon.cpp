@@ -100,12 +100,152 @@ String NTAPI GetClearTempPath(LPVOID pOwner, LPCTSTR pchExt)
 	return strPath;
 }
 
+// Property IDs as defined in 7-Zip's PropID.h
+enum
+{
+	kpidSize = 7,
+	kpidAttrib = 9,
+	kpidCRC = 19
+};
+
+InspectorListing::InspectorListing(LPCTSTR folder)
+	: ArchiveListing(folder)
+	, m_piInspector(NULL)
+{
+}
+
+InspectorListing::~InspectorListing()
+{
+	if (m_piInspector)
+		m_piInspector->Free();
+}
+
+/**
+ * @brief Read the entries of given archive.
+ * @return false if the archive can not be inspected, or has entries whose
+ * paths do not stay inside the folder to extract to.
+ */
+bool InspectorListing::Open(HWND hwnd, Merge7z::Format *piHandler, LPCTSTR path)
+{
+	m_piInspector = piHandler->Open(hwnd, path);
+	if (m_piInspector == NULL)
+		return false;
+	UINT32 const numItems = m_piInspector->Open();
+	for (UINT32 index = 0; index < numItems; ++index)
+	{
+		Entry entry;
+		entry.index = index;
+		BSTR bstrPath = m_piInspector->GetPath(index);
+		if (bstrPath == NULL)
+			return false;
+		SysFreeString(Assign(entry.path, bstrPath));
+		std::replace(entry.path.begin(), entry.path.end(), _T('/'), _T('\\'));
+		String::size_type const len = entry.path.find_last_not_of(_T('\\'));
+		if (len == String::npos || entry.path[0] == _T('\\') ||
+			entry.path.find(_T(':')) != String::npos ||
+			(_T("\\") + entry.path + _T("\\")).find(_T("\\..\\")) != String::npos)
+		{
+			return false;
+		}
+		entry.path.resize(len + 1);
+		entry.bFolder = m_piInspector->IsFolder(index) != VARIANT_FALSE;
+		entry.mtime = m_piInspector->LastWriteTime(index);
+		PROPVARIANT value;
+		// An entry of unknown size never compares identical
+		entry.size = SUCCEEDED(m_piInspector->GetProperty(index, kpidSize, &value, VT_UI8)) ?
+			value.uhVal.QuadPart : ~UINT64(0);
+		entry.attributes = SUCCEEDED(m_piInspector->GetProperty(index, kpidAttrib, &value, VT_UI4)) ?
+			value.ulVal & (FILE_ATTRIBUTE_READONLY | FILE_ATTRIBUTE_HIDDEN |
+			FILE_ATTRIBUTE_SYSTEM | FILE_ATTRIBUTE_ARCHIVE) : 0;
+		entry.bHasCrc = SUCCEEDED(m_piInspector->GetProperty(index, kpidCRC, &value, VT_UI4));
+		entry.crc = entry.bHasCrc ? value.ulVal : 0;
+		Add(entry);
+	}
+	Sort();
+	return true;
+}
+
+HRESULT InspectorListing::ExtractItems(HWND hwnd, LPCTSTR folder, const UINT32 *indices, UINT32 numItems)
+{
+	return m_piInspector->Extract(hwnd, folder, indices, numItems);
+}
+
+CTempPathContext::CTempPathContext()
+	: m_pParent(NULL)
+	, m_pLeftListing(NULL)
+	, m_pRightListing(NULL)
+{
+}
+
+/**
+ * @brief Check if given handler stores a single stream, like gzip does.
+ */
+static bool HasAddExtension(HWND hwnd, Merge7z::Format *piHandler)
+{
+	BSTR bstr = piHandler->GetHandlerAddExtension(hwnd);
+	UINT const len = SysStringLen(bstr);
+	SysFreeString(bstr);
+	return len != 0;
+}
+
+/**
+ * @brief Extract two archives for comparison, except for the entries which
+ * are identical by their stored size and CRC. Those remain deferred in the
+ * listings, and get extracted only when needed.
+ * @param [in] hwnd Window to own any UI.
+ * @param [in, out] strLeft Path to left archive, on success replaced by path
+ * to folder it got extracted to.
+ * @param [in, out] strRight Path to right archive, on success replaced by
+ * path to folder it got extracted to.
+ * @return New temp path context, or NULL if the archives can not be compared
+ * this way.
+ */
+CTempPathContext *CTempPathContext::ExtractDifferences(HWND hwnd, String &strLeft, String &strRight)
+{
+	if (strLeft == strRight)
+		return NULL;
+	Merge7z::Format *const piLeft = ArchiveGuessFormat(strLeft.c_str());
+	if (piLeft == NULL)
+		return NULL;
+	Merge7z::Format *const piRight = ArchiveGuessFormat(strRight.c_str());
+	if (piRight == NULL)
+		return NULL;
+	// Single stream archives may nest other archives, so leave them alone
+	if (HasAddExtension(hwnd, piLeft) || HasAddExtension(hwnd, piRight))
+		return NULL;
+	CTempPathContext *const pTempPathContext = new CTempPathContext;
+	String const strLeftFolder = GetClearTempPath(pTempPathContext, _T("0"));
+	String const strRightFolder = GetClearTempPath(pTempPathContext, _T("1"));
+	InspectorListing *const pLeftListing = new InspectorListing(strLeftFolder.c_str());
+	InspectorListing *const pRightListing = new InspectorListing(strRightFolder.c_str());
+	pTempPathContext->m_pLeftListing = pLeftListing;
+	pTempPathContext->m_pRightListing = pRightListing;
+	if (pLeftListing->Open(hwnd, piLeft, strLeft.c_str()) &&
+		pRightListing->Open(hwnd, piRight, strRight.c_str()))
+	{
+		ArchiveListing::DeferIdentical(*pLeftListing, *pRightListing);
+		if (SUCCEEDED(pLeftListing->Extract(hwnd)) &&
+			SUCCEEDED(pRightListing->Extract(hwnd)))
+		{
+			pTempPathContext->m_strLeftDisplayRoot = strLeft;
+			pTempPathContext->m_strRightDisplayRoot = strRight;
+			strLeft = strLeftFolder;
+			strRight = strRightFolder;
+			return pTempPathContext;
+		}
+	}
+	pTempPathContext->DeleteHead();
+	return NULL;
+}
+
 /**
  * @brief Delete head of temp path context list, and return its parent context.
  */
 CTempPathContext *CTempPathContext::DeleteHead()
 {
 	CTempPathContext *pParent = m_pParent;
+	delete m_pLeftListing;
+	delete m_pRightListing;
 	GetClearTempPath(this, _T("*"));
 	delete this;
 	return pParent;
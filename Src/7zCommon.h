@@ -3,6 +3,7 @@
 #include "../ArchiveSupport/Merge7z/Merge7z.h"
 
 #include "DirView.h"
+#include "ArchiveListing.h"
 
 extern Merge7z::Proxy Merge7z;
 
@@ -10,12 +11,28 @@ Merge7z::Format *ArchiveGuessFormat(LPCTSTR);
 
 String NTAPI GetClearTempPath(LPVOID pOwner, LPCTSTR pchExt);
 
+/**
+ * @brief ArchiveListing which reads and extracts entries through Merge7z.
+ */
+class InspectorListing : public ArchiveListing
+{
+public:
+	explicit InspectorListing(LPCTSTR folder);
+	~InspectorListing();
+	bool Open(HWND, Merge7z::Format *, LPCTSTR path);
+protected:
+	virtual HRESULT ExtractItems(HWND, LPCTSTR folder, const UINT32 *indices, UINT32 numItems);
+private:
+	Merge7z::Format::Inspector *m_piInspector;
+};
+
 /**
  * @brief temp path context
  */
 class CTempPathContext
 {
 public:
+	CTempPathContext();
 	CTempPathContext *m_pParent;
 	String m_strLeftDisplayRoot;
 	String m_strRightDisplayRoot;
@@ -23,6 +40,9 @@ public:
 	String m_strRightRoot;
 	String m_strLeftParent;
 	String m_strRightParent;
+	ArchiveListing *m_pLeftListing; /**< Set if left archive is extracted selectively */
+	ArchiveListing *m_pRightListing; /**< Set if right archive is extracted selectively */
+	static CTempPathContext *ExtractDifferences(HWND, String &strLeft, String &strRight);
 	CTempPathContext *DeleteHead();
 };
 
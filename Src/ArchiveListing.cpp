@@ -0,0 +1,377 @@
+/**
+ *  @file ArchiveListing.cpp
+ *
+ *  @brief Implementation of class ArchiveListing
+ */
+#include "StdAfx.h"
+#include "DirItem.h"
+#include "ArchiveListing.h"
+#include "paths.h"
+
+/**
+ * @brief Orders entries by folder, then by name, ignoring case.
+ * This way, the entries of a folder form a contiguous range.
+ */
+class ArchiveListing::Less
+{
+public:
+	static int Compare(LPCTSTR p, LPCTSTR q)
+	{
+		LPCTSTR const ps = _tcsrchr(p, _T('\\'));
+		LPCTSTR const qs = _tcsrchr(q, _T('\\'));
+		size_t const pn = ps ? ps - p : 0;
+		size_t const qn = qs ? qs - q : 0;
+		if (int cmp = _tcsnicmp(p, q, min(pn, qn)))
+			return cmp;
+		if (pn != qn)
+			return pn < qn ? -1 : 1;
+		return _tcsicmp(ps ? ps + 1 : p, qs ? qs + 1 : q);
+	}
+	bool operator()(const Entry &a, const Entry &b) const
+	{
+		return Compare(a.path.c_str(), b.path.c_str()) < 0;
+	}
+	bool operator()(const Entry &a, LPCTSTR b) const
+	{
+		return Compare(a.path.c_str(), b) < 0;
+	}
+	bool operator()(LPCTSTR a, const Entry &b) const
+	{
+		return Compare(a, b.path.c_str()) < 0;
+	}
+};
+
+ArchiveListing::ArchiveListing(LPCTSTR folder)
+	: m_strFolder(folder)
+	, m_nDeferred(0)
+{
+	InitializeCriticalSection(&m_cs);
+}
+
+ArchiveListing::~ArchiveListing()
+{
+	DeleteCriticalSection(&m_cs);
+}
+
+/**
+ * @brief Add an entry. Call Sort() once all entries are added.
+ */
+void ArchiveListing::Add(const Entry &entry)
+{
+	m_rgEntries.push_back(entry);
+	m_rgEntries.back().bDeferred = false;
+}
+
+/**
+ * @brief Sort entries to prepare for lookup.
+ */
+void ArchiveListing::Sort()
+{
+	std::sort(m_rgEntries.begin(), m_rgEntries.end(), Less());
+}
+
+/**
+ * @brief Tell whether the stored metadata proves two entries identical.
+ */
+bool ArchiveListing::IsIdentical(const Entry &a, const Entry &b)
+{
+	if (a.bFolder || b.bFolder || a.size != b.size)
+		return false;
+	if (a.size == 0)
+		return true;
+	return a.bHasCrc && b.bHasCrc && a.crc == b.crc;
+}
+
+/**
+ * @brief Defer the entries which exist on both sides and are identical.
+ * Paths which occur more than once on either side are never deferred.
+ * @return Number of deferred pairs.
+ */
+UINT ArchiveListing::DeferIdentical(ArchiveListing &left, ArchiveListing &right)
+{
+	Less const less;
+	UINT n = 0;
+	std::vector<Entry>::iterator p = left.m_rgEntries.begin();
+	std::vector<Entry>::iterator q = right.m_rgEntries.begin();
+	std::vector<Entry>::iterator const pEnd = left.m_rgEntries.end();
+	std::vector<Entry>::iterator const qEnd = right.m_rgEntries.end();
+	while (p != pEnd && q != qEnd)
+	{
+		if (less(*p, *q))
+		{
+			++p;
+		}
+		else if (less(*q, *p))
+		{
+			++q;
+		}
+		else
+		{
+			std::vector<Entry>::iterator p1 = p + 1;
+			while (p1 != pEnd && !less(*p, *p1))
+				++p1;
+			std::vector<Entry>::iterator q1 = q + 1;
+			while (q1 != qEnd && !less(*q, *q1))
+				++q1;
+			if (p1 - p == 1 && q1 - q == 1 && IsIdentical(*p, *q))
+			{
+				p->bDeferred = q->bDeferred = true;
+				++n;
+			}
+			p = p1;
+			q = q1;
+		}
+	}
+	left.m_nDeferred += n;
+	right.m_nDeferred += n;
+	return n;
+}
+
+/**
+ * @brief Extract all entries which are not deferred.
+ * Folders of deferred entries are created so the folder compare finds them.
+ * Entries which are extracted are no longer needed and get dropped.
+ */
+HRESULT ArchiveListing::Extract(HWND hwnd)
+{
+	paths_CreateIfNeeded(m_strFolder.c_str());
+	std::vector<UINT32> indices;
+	std::vector<Entry>::iterator p = m_rgEntries.begin();
+	std::vector<Entry>::iterator const pEnd = m_rgEntries.end();
+	for ( ; p != pEnd; ++p)
+	{
+		if (!p->bDeferred)
+			indices.push_back(p->index);
+	}
+	HRESULT hr = S_OK;
+	if (!indices.empty())
+		hr = ExtractItems(hwnd, m_strFolder.c_str(), &indices.front(), static_cast<UINT32>(indices.size()));
+	if (FAILED(hr))
+		return hr;
+	std::vector<Entry>::iterator q = m_rgEntries.begin();
+	LPCTSTR folder = NULL;
+	size_t cchFolder = 0;
+	for (p = m_rgEntries.begin(); p != pEnd; ++p)
+	{
+		if (!p->bDeferred)
+			continue;
+		// Entries are sorted by folder, so look out for a change of folder
+		LPCTSTR const path = p->path.c_str();
+		LPCTSTR const slash = _tcsrchr(path, _T('\\'));
+		size_t const cch = slash ? slash - path : 0;
+		if (folder == NULL || cch != cchFolder || _tcsnicmp(path, folder, cch) != 0)
+		{
+			if (cch != 0)
+				paths_CreateIfNeeded((m_strFolder + p->path).c_str(), true);
+			cchFolder = cch;
+		}
+		if (q != p)
+			*q = *p;
+		folder = q->path.c_str();
+		++q;
+	}
+	m_rgEntries.erase(q, pEnd);
+	return hr;
+}
+
+/**
+ * @brief Extract the deferred entries at or below given path.
+ * @param [in] hwnd Window to own any UI, or NULL.
+ * @param [in] path Full path to a file or folder.
+ * @return false if extraction failed.
+ */
+bool ArchiveListing::Materialize(HWND hwnd, LPCTSTR path)
+{
+	LPCTSTR const rel = GetRelativePath(path);
+	if (rel == NULL || m_nDeferred == 0)
+		return true;
+	size_t len = _tcslen(rel);
+	while (len != 0 && rel[len - 1] == _T('\\'))
+		--len;
+	HRESULT hr = S_OK;
+	EnterCriticalSection(&m_cs);
+	std::vector<UINT32> indices;
+	std::vector<Entry *> entries;
+	std::vector<Entry>::iterator p = m_rgEntries.begin();
+	std::vector<Entry>::iterator const pEnd = m_rgEntries.end();
+	for ( ; p != pEnd; ++p)
+	{
+		LPCTSTR const q = p->path.c_str();
+		if (p->bDeferred && (len == 0 || (_tcsnicmp(q, rel, len) == 0 &&
+			(q[len] == _T('\0') || q[len] == _T('\\')))))
+		{
+			indices.push_back(p->index);
+			entries.push_back(&*p);
+		}
+	}
+	if (!indices.empty())
+	{
+		hr = ExtractItems(hwnd, m_strFolder.c_str(), &indices.front(), static_cast<UINT32>(indices.size()));
+		if (SUCCEEDED(hr))
+		{
+			std::vector<Entry *>::iterator q = entries.begin();
+			while (q != entries.end())
+				(*q++)->bDeferred = false;
+			m_nDeferred -= static_cast<UINT>(entries.size());
+		}
+	}
+	LeaveCriticalSection(&m_cs);
+	return SUCCEEDED(hr);
+}
+
+/**
+ * @brief Find the deferred entry for given full path.
+ * @return The entry, or NULL if path does not refer to a deferred entry.
+ */
+const ArchiveListing::Entry *ArchiveListing::FindDeferred(LPCTSTR path) const
+{
+	LPCTSTR const rel = GetRelativePath(path);
+	if (rel == NULL)
+		return NULL;
+	const Entry *entry = NULL;
+	// Materialize() may be clearing deferred states on some other thread
+	EnterCriticalSection(&m_cs);
+	if (m_nDeferred != 0)
+	{
+		std::vector<Entry>::const_iterator const p = std::lower_bound(
+			m_rgEntries.begin(), m_rgEntries.end(), rel, Less());
+		if (p != m_rgEntries.end() && p->bDeferred && Less::Compare(p->path.c_str(), rel) == 0)
+			entry = &*p;
+	}
+	LeaveCriticalSection(&m_cs);
+	return entry;
+}
+
+/**
+ * @brief Append the deferred files which live in given folder.
+ * @param [in] dir Full path to the folder.
+ * @param [in, out] files Array where files are stored.
+ * @return Number of files appended.
+ */
+UINT ArchiveListing::LoadDeferredFiles(LPCTSTR dir, std::vector<DirItem> *files) const
+{
+	LPCTSTR const rel = GetRelativePath(dir);
+	if (rel == NULL)
+		return 0;
+	size_t len = _tcslen(rel);
+	while (len != 0 && rel[len - 1] == _T('\\'))
+		--len;
+	String prefix(rel, len);
+	if (len != 0)
+		prefix.push_back(_T('\\'));
+	len = prefix.length();
+	UINT n = 0;
+	EnterCriticalSection(&m_cs);
+	std::vector<Entry>::const_iterator p = m_nDeferred == 0 ? m_rgEntries.end() :
+		std::lower_bound(m_rgEntries.begin(), m_rgEntries.end(), prefix.c_str(), Less());
+	for ( ; p != m_rgEntries.end(); ++p)
+	{
+		LPCTSTR const name = p->path.c_str() + len;
+		if (_tcsnicmp(p->path.c_str(), prefix.c_str(), len) != 0 || _tcschr(name, _T('\\')))
+			break;
+		if (!p->bDeferred)
+			continue;
+		DirItem ent;
+		ent.path = dir;
+		ent.filename = name;
+		ent.mtime = p->mtime;
+		ent.size.int64 = p->size;
+		// Ensure attributes to be nonzero for existing files
+		ent.flags.attributes = p->attributes | FILE_ATTRIBUTE_NORMAL;
+		files->push_back(ent);
+		++n;
+	}
+	LeaveCriticalSection(&m_cs);
+	return n;
+}
+
+/**
+ * @brief Strip the extraction folder from given full path.
+ * @return Path relative to archive root, or NULL if outside of archive.
+ */
+LPCTSTR ArchiveListing::GetRelativePath(LPCTSTR path) const
+{
+	String::size_type const len = m_strFolder.length();
+	if (len == 0 || _tcsnicmp(path, m_strFolder.c_str(), len - 1) != 0)
+		return NULL;
+	switch (path[len - 1])
+	{
+	case _T('\0'):
+		return path + len - 1;
+	case _T('\\'):
+		return path + len;
+	}
+	return NULL;
+}
+
+TESTCASE
+{
+	class Listing : public ArchiveListing
+	{
+	public:
+		UINT32 numExtracted;
+		Listing() : ArchiveListing(_T("C:\\Temp\\0.7z0\\")), numExtracted(0) { }
+		void Add(LPCTSTR path, UINT32 index, UINT64 size, DWORD crc, bool bHasCrc = true)
+		{
+			Entry entry;
+			entry.path = path;
+			entry.index = index;
+			entry.size = size;
+			entry.mtime.dwLowDateTime = entry.mtime.dwHighDateTime = 0;
+			entry.attributes = 0;
+			entry.crc = crc;
+			entry.bHasCrc = bHasCrc;
+			entry.bFolder = false;
+			ArchiveListing::Add(entry);
+		}
+	protected:
+		virtual HRESULT ExtractItems(HWND, LPCTSTR, const UINT32 *, UINT32 numItems)
+		{
+			numExtracted += numItems;
+			return S_OK;
+		}
+	} left, right;
+	left.Add(_T("a.txt"), 0, 3, 1);
+	left.Add(_T("dir\\b.txt"), 1, 5, 2);
+	left.Add(_T("dir\\c.txt"), 2, 5, 3);
+	left.Add(_T("dir\\sub\\d.txt"), 3, 7, 4);
+	left.Add(_T("empty"), 4, 0, 0, false);
+	left.Add(_T("dup"), 5, 1, 5);
+	left.Add(_T("dup"), 6, 1, 5);
+	left.Add(_T("nocrc"), 7, 2, 0, false);
+	left.Sort();
+	right.Add(_T("nocrc"), 0, 2, 0, false);
+	right.Add(_T("dup"), 1, 1, 5);
+	right.Add(_T("empty"), 2, 0, 0, false);
+	right.Add(_T("DIR\\SUB\\D.TXT"), 3, 7, 4);
+	right.Add(_T("dir\\c.txt"), 4, 5, 6);
+	right.Add(_T("dir\\b.txt"), 5, 5, 2);
+	right.Add(_T("A.TXT"), 6, 3, 1);
+	right.Sort();
+	// Same size and CRC, or both empty, tells identical
+	assert(ArchiveListing::DeferIdentical(left, right) == 4);
+	assert(left.FindDeferred(_T("C:\\Temp\\0.7z0\\a.txt")) != NULL);
+	assert(right.FindDeferred(_T("C:\\Temp\\0.7z0\\a.txt"))->index == 6);
+	assert(left.FindDeferred(_T("C:\\Temp\\0.7z0\\dir\\c.txt")) == NULL);
+	assert(left.FindDeferred(_T("C:\\Temp\\0.7z0\\dup")) == NULL);
+	assert(left.FindDeferred(_T("C:\\Temp\\0.7z0\\nocrc")) == NULL);
+	assert(left.FindDeferred(_T("C:\\Temp\\1.7z0\\a.txt")) == NULL);
+	// Deferred files get listed with the folder they live in
+	std::vector<DirItem> files;
+	assert(left.LoadDeferredFiles(_T("C:\\Temp\\0.7z0"), &files) == 2);
+	assert(files[0].filename == _T("a.txt") && files[1].filename == _T("empty"));
+	assert(left.LoadDeferredFiles(_T("C:\\Temp\\0.7z0\\dir"), &files) == 1);
+	assert(files[2].filename == _T("b.txt") && files[2].size.int64 == 5);
+	assert(left.LoadDeferredFiles(_T("C:\\Temp\\0.7z0\\dir\\sub"), &files) == 1);
+	// Materializing a folder extracts the deferred entries below it
+	assert(left.Materialize(NULL, _T("C:\\Temp\\0.7z0\\dir")));
+	assert(left.numExtracted == 2);
+	assert(left.FindDeferred(_T("C:\\Temp\\0.7z0\\dir\\b.txt")) == NULL);
+	assert(left.Materialize(NULL, _T("C:\\Temp\\0.7z0\\dir\\b.txt")));
+	assert(left.numExtracted == 2);
+	assert(left.HasDeferred());
+	assert(left.Materialize(NULL, _T("C:\\Temp\\0.7z0")));
+	assert(left.numExtracted == 4);
+	assert(!left.HasDeferred());
+	return 0;
+}
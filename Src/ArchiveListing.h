@@ -0,0 +1,61 @@
+/**
+ *  @file ArchiveListing.h
+ *
+ *  @brief Declaration of class ArchiveListing
+ */
+#pragma once
+
+struct DirItem;
+
+/**
+ * @brief Entries of an archive as told by the archive's metadata.
+ * When two archives are compared, entries which exist on both sides with
+ * equal size and equal stored CRC are identical without reading them. Such
+ * entries are deferred: They are not extracted along with the others, but
+ * listed to the folder compare from their metadata, and extracted only once
+ * something wants to read them.
+ * The class does not depend on any particular archiver. Subclasses tell how
+ * to extract items.
+ */
+class ArchiveListing
+{
+public:
+	struct Entry
+	{
+		String path; /**< Path relative to archive root, backslash separated */
+		UINT32 index; /**< Index of item in archive */
+		UINT64 size; /**< Uncompressed size */
+		FILETIME mtime; /**< Time of last modify */
+		DWORD attributes; /**< File attributes */
+		DWORD crc; /**< Stored CRC, if bHasCrc */
+		bool bHasCrc; /**< Archive stores a CRC for the entry */
+		bool bFolder; /**< Entry is a folder */
+		bool bDeferred; /**< Entry is not (yet) extracted */
+	};
+
+	explicit ArchiveListing(LPCTSTR folder);
+	virtual ~ArchiveListing();
+	void Add(const Entry &);
+	void Sort();
+	static bool IsIdentical(const Entry &, const Entry &);
+	static UINT DeferIdentical(ArchiveListing &, ArchiveListing &);
+	HRESULT Extract(HWND);
+	bool Materialize(HWND, LPCTSTR path);
+	const Entry *FindDeferred(LPCTSTR path) const;
+	UINT LoadDeferredFiles(LPCTSTR dir, std::vector<DirItem> *) const;
+	bool HasDeferred() const { return m_nDeferred != 0; }
+
+protected:
+	virtual HRESULT ExtractItems(HWND, LPCTSTR folder, const UINT32 *indices, UINT32 numItems) = 0;
+
+private:
+	class Less;
+	LPCTSTR GetRelativePath(LPCTSTR) const;
+	std::vector<Entry> m_rgEntries; /**< Sorted by folder, then by name */
+	String const m_strFolder; /**< Folder to extract to, with trailing backslash */
+	UINT m_nDeferred; /**< Number of deferred entries */
+	mutable CRITICAL_SECTION m_cs; /**< Guards deferred states, serializes Materialize() calls */
+
+	ArchiveListing(const ArchiveListing &); // disallow copy construction
+	void operator=(const ArchiveListing &); // disallow assignment
+};
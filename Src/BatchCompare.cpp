@@ -0,0 +1,523 @@
+/**
+ * @file  BatchCompare.cpp
+ *
+ * @brief Implementation of BatchCompare class.
+ *
+ */
+#include "StdAfx.h"
+#include "Merge.h"
+#include "LogFile.h"
+#include "BatchCompare.h"
+#include "PatchTool.h"
+#include "CompareStats.h"
+#include "FileFilterHelper.h"
+#include "LineFiltersList.h"
+#include "Common/DllProxies.h"
+#include "paths.h"
+#include "OptionsMgr.h"
+
+/** @brief Names of the fields in a record, in order of appearance. */
+static LPCTSTR const FieldNames[] =
+{
+	_T("left"),
+	_T("right"),
+	_T("type"),
+	_T("result"),
+	_T("diffcode"),
+	_T("leftsize"),
+	_T("rightsize"),
+	_T("lefttime"),
+	_T("righttime"),
+	_T("nsdiffs"),
+	_T("nidiffs"),
+	_T("leftencoding"),
+	_T("rightencoding"),
+};
+
+BatchCompare *BatchCompare::m_pRunning = NULL;
+
+/**
+ * @brief Return a short name for the compare result of an item.
+ */
+static LPCTSTR GetResultName(const DIFFITEM *di)
+{
+	if (di->isResultFiltered())
+		return _T("skipped");
+	if (di->isSideLeftOnly())
+		return _T("leftonly");
+	if (di->isSideRightOnly())
+		return _T("rightonly");
+	switch (di->diffcode & DIFFCODE::COMPAREFLAGS)
+	{
+	case DIFFCODE::SAME:
+		return _T("identical");
+	case DIFFCODE::DIFF:
+		return _T("different");
+	case DIFFCODE::CMPERR:
+		return _T("error");
+	case DIFFCODE::CMPABORT:
+		return _T("aborted");
+	}
+	return _T("unknown");
+}
+
+BatchCompare::BatchCompare(const MergeCmdLineInfo &cmdInfo)
+	: m_cmdInfo(cmdInfo)
+	, m_hDone(CreateEvent(NULL, TRUE, FALSE, NULL))
+{
+	InitializeCriticalSection(&m_csOutput);
+}
+
+BatchCompare::~BatchCompare()
+{
+	delete m_pCtxt;
+	delete m_pCompareStats;
+	if (m_bCloseOutput)
+		CloseHandle(m_hOutput);
+	CloseHandle(m_hDone);
+	DeleteCriticalSection(&m_csOutput);
+}
+
+/**
+ * @brief Compare the folders given on the command line.
+ * @return Process exit code.
+ */
+int BatchCompare::Run()
+{
+	if (m_cmdInfo.m_Files.size() < 2)
+	{
+		Report(_T("Batch compare needs two folders to compare"));
+		return ExitError;
+	}
+	const String &sLeft = m_cmdInfo.m_Files[0];
+	const String &sRight = m_cmdInfo.m_Files[1];
+	if (paths_DoesPathExist(sLeft.c_str()) != IS_EXISTING_DIR)
+	{
+		Report(string_format(_T("Not a folder: %s"), sLeft.c_str()).c_str());
+		return ExitError;
+	}
+	if (paths_DoesPathExist(sRight.c_str()) != IS_EXISTING_DIR)
+	{
+		Report(string_format(_T("Not a folder: %s"), sRight.c_str()).c_str());
+		return ExitError;
+	}
+	if (!m_cmdInfo.m_sBatchOutput.empty() && !OpenOutput())
+		return ExitError;
+
+	// Set up filters and codepages as the main frame would
+	globalLineFilters.LoadFilters();
+	globalFileFilter.LoadAllFileFilters();
+	globalFileFilter.SetFilter(COptionsMgr::Get(OPT_FILEFILTER_CURRENT));
+	if (!m_cmdInfo.m_sFileFilter.empty())
+		globalFileFilter.SetFilter(m_cmdInfo.m_sFileFilter);
+	FileTextEncoding::UpdateDefaultCodepage(COptionsMgr::Get(OPT_CP_DEFAULT_MODE), COptionsMgr::Get(OPT_CP_DEFAULT_CUSTOM));
+	if (m_cmdInfo.m_nCodepage)
+		FileTextEncoding::UpdateDefaultCodepage(2, m_cmdInfo.m_nCodepage);
+
+	m_pCompareStats = new CompareStats;
+	m_pCtxt = new CDiffContext(m_pCompareStats, NULL,
+		sLeft.c_str(), sRight.c_str(), m_cmdInfo.m_nRecursive, 0);
+
+	m_pCtxt->m_options.nIgnoreWhitespace = COptionsMgr::Get(OPT_CMP_IGNORE_WHITESPACE);
+	m_pCtxt->m_options.bIgnoreBlankLines = COptionsMgr::Get(OPT_CMP_IGNORE_BLANKLINES);
+	m_pCtxt->m_options.bFilterCommentsLines = COptionsMgr::Get(OPT_CMP_FILTER_COMMENTLINES);
+	m_pCtxt->m_options.bIgnoreCase = COptionsMgr::Get(OPT_CMP_IGNORE_CASE);
+	m_pCtxt->m_options.bIgnoreEol = COptionsMgr::Get(OPT_CMP_IGNORE_EOL);
+	m_pCtxt->m_options.bApplyLineFilters = COptionsMgr::Get(OPT_LINEFILTER_ENABLED);
+	m_pCtxt->m_nCompMethod = m_cmdInfo.m_nCompMethod != -1 ? m_cmdInfo.m_nCompMethod : COptionsMgr::Get(OPT_CMP_METHOD);
+	m_pCtxt->m_bGuessEncoding = COptionsMgr::Get(OPT_CP_DETECT);
+	m_pCtxt->m_bIgnoreSmallTimeDiff = COptionsMgr::Get(OPT_IGNORE_SMALL_FILETIME);
+	m_pCtxt->m_bStopAfterFirstDiff = COptionsMgr::Get(OPT_CMP_STOP_AFTER_FIRST);
+	m_pCtxt->m_nQuickCompareLimit = COptionsMgr::Get(OPT_CMP_QUICK_LIMIT);
+	m_pCtxt->m_nBinaryCompareLimit = COptionsMgr::Get(OPT_CMP_BINARY_LIMIT);
+	m_pCtxt->m_bSelfCompare = COptionsMgr::Get(OPT_CMP_SELF_COMPARE);
+	m_pCtxt->m_bWalkUniques = COptionsMgr::Get(OPT_CMP_WALK_UNIQUES);
+	m_pCtxt->m_piFilterGlobal = &globalFileFilter;
+	m_pCtxt->m_piItemSink = this;
+
+	if (m_hOutput && m_cmdInfo.m_nBatchFormat == MergeCmdLineInfo::BatchFormatCsv)
+	{
+		String header;
+		for (int i = 0; i < _countof(FieldNames); ++i)
+		{
+			if (i != 0)
+				header.push_back(_T(','));
+			header += FieldNames[i];
+		}
+		Emit(header);
+	}
+
+	LogFile.Write(CLogFile::LNOTICE, _T("Starting batch compare:\n\tLeft: %s\n\tRight: %s\n"),
+		m_pCtxt->GetLeftPath().c_str(), m_pCtxt->GetRightPath().c_str());
+
+	m_pRunning = this;
+	SetConsoleCtrlHandler(ConsoleCtrlHandler, TRUE);
+	m_pCtxt->CompareDirectories(false);
+	// Plugins may want to show UI, so keep serving the message queue
+	while (MsgWaitForMultipleObjects(1, &m_hDone, FALSE, INFINITE, QS_ALLINPUT) == WAIT_OBJECT_0 + 1)
+	{
+		MSG msg;
+		while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		{
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+	}
+	SetConsoleCtrlHandler(ConsoleCtrlHandler, FALSE);
+	m_pRunning = NULL;
+
+	EnterCriticalSection(&m_csOutput);
+	Flush();
+	LeaveCriticalSection(&m_csOutput);
+
+	if (m_pCtxt->IsAborting())
+		return ExitError;
+	if (!m_cmdInfo.m_sPatchOutput.empty() && !CreatePatch())
+		return ExitError;
+	if (m_nErrors != 0)
+		return ExitError;
+	return m_nDifferent != 0 ? ExitDifferent : ExitIdentical;
+}
+
+/**
+ * @brief Open the output file, or stdout if the path is "-".
+ */
+bool BatchCompare::OpenOutput()
+{
+	const String &path = m_cmdInfo.m_sBatchOutput;
+	if (path == _T("-"))
+	{
+		m_hOutput = GetStdHandle(STD_OUTPUT_HANDLE);
+		if (m_hOutput == NULL || m_hOutput == INVALID_HANDLE_VALUE)
+		{
+			// We have no stdout unless redirected, so write to the console
+			// of our parent process, if there is one.
+			if (struct KERNEL32V51 *KERNEL32V51 = ::KERNEL32V51)
+				KERNEL32V51->AttachConsole(ATTACH_PARENT_PROCESS);
+			m_hOutput = CreateFile(_T("CONOUT$"), GENERIC_WRITE,
+				FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+			m_bCloseOutput = true;
+			SetConsoleOutputCP(CP_UTF8);
+		}
+	}
+	else
+	{
+		m_hOutput = CreateFile(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+			NULL, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		m_bCloseOutput = true;
+	}
+	if (m_hOutput == INVALID_HANDLE_VALUE)
+	{
+		m_hOutput = NULL;
+		m_bCloseOutput = false;
+		Report(OException(GetLastError()).msg);
+		return false;
+	}
+	// Pipe readers want to see records as they come
+	m_bFlushEachRecord = GetFileType(m_hOutput) != FILE_TYPE_DISK;
+	return true;
+}
+
+/**
+ * @brief Append the name of the next field, or a separator for CSV.
+ */
+void BatchCompare::AppendName(String &s, int i) const
+{
+	if (m_cmdInfo.m_nBatchFormat == MergeCmdLineInfo::BatchFormatCsv)
+	{
+		// Only the header line carries the names
+		if (i != 0)
+			s.push_back(_T(','));
+	}
+	else
+	{
+		s += i != 0 ? _T(",\"") : _T("{\"");
+		s += FieldNames[i];
+		s += _T("\":");
+	}
+}
+
+/**
+ * @brief Append a string value, quoted as the output format requires.
+ */
+void BatchCompare::AppendField(String &s, const String &value) const
+{
+	if (m_cmdInfo.m_nBatchFormat == MergeCmdLineInfo::BatchFormatCsv)
+	{
+		s.push_back(_T('"'));
+		for (String::const_iterator p = value.begin(); p != value.end(); ++p)
+		{
+			if (*p == _T('"'))
+				s.push_back(_T('"'));
+			s.push_back(*p);
+		}
+		s.push_back(_T('"'));
+	}
+	else
+	{
+		s.push_back(_T('"'));
+		for (String::const_iterator p = value.begin(); p != value.end(); ++p)
+		{
+			TCHAR c = *p;
+			if (c == _T('"') || c == _T('\\'))
+			{
+				s.push_back(_T('\\'));
+				s.push_back(c);
+			}
+			else if (c < _T(' '))
+			{
+				s.append_sprintf(_T("\\u%04x"), c);
+			}
+			else
+			{
+				s.push_back(c);
+			}
+		}
+		s.push_back(_T('"'));
+	}
+}
+
+/**
+ * @brief Append a numeric value, or null if negative.
+ */
+void BatchCompare::AppendField(String &s, LONGLONG value) const
+{
+	if (value >= 0)
+		s.append_sprintf(_T("%I64d"), value);
+	else
+		AppendNull(s);
+}
+
+/**
+ * @brief Append a file time in ISO 8601 format, or null if not set.
+ */
+void BatchCompare::AppendField(String &s, const FileTime &value) const
+{
+	SYSTEMTIME st;
+	if (value != 0 && FileTimeToSystemTime(&value, &st))
+	{
+		s.append_sprintf(_T("\"%04u-%02u-%02uT%02u:%02u:%02u.%03uZ\""),
+			st.wYear, st.wMonth, st.wDay,
+			st.wHour, st.wMinute, st.wSecond, st.wMilliseconds);
+	}
+	else
+	{
+		AppendNull(s);
+	}
+}
+
+/**
+ * @brief Append a missing value, which is an empty field in CSV.
+ */
+void BatchCompare::AppendNull(String &s) const
+{
+	if (m_cmdInfo.m_nBatchFormat != MergeCmdLineInfo::BatchFormatCsv)
+		s += _T("null");
+}
+
+/**
+ * @brief Write one record for an item whose compare has completed.
+ * Called concurrently on compare threads.
+ */
+void BatchCompare::OnDiffItem(const CDiffContext *, const DIFFITEM *di)
+{
+	// The result of a folder which exists on both sides is not final until
+	// all of its contents have been compared, so leave it to its contents.
+	if (di->isDirectory() && di->isSideBoth())
+		return;
+
+	if (!di->isResultFiltered())
+	{
+		if (di->isResultError() || di->isResultAbort())
+			InterlockedIncrement(&m_nErrors);
+		else if (di->isResultDiff() || !di->isSideBoth())
+		{
+			InterlockedIncrement(&m_nDifferent);
+			if (!di->isDirectory() && !m_cmdInfo.m_sPatchOutput.empty())
+				AddPatchItem(di);
+		}
+	}
+
+	if (m_hOutput == NULL)
+		return;
+
+	bool const bLeft = di->isSideLeftOrBoth();
+	bool const bRight = di->isSideRightOrBoth();
+	bool const bFile = !di->isDirectory();
+	int i = 0;
+	String s;
+	AppendName(s, i++);
+	if (bLeft)
+		AppendField(s, paths_ConcatPath(di->left.path, di->left.filename));
+	else
+		AppendNull(s);
+	AppendName(s, i++);
+	if (bRight)
+		AppendField(s, paths_ConcatPath(di->right.path, di->right.filename));
+	else
+		AppendNull(s);
+	AppendName(s, i++);
+	AppendField(s, String(bFile ? _T("file") : _T("dir")));
+	AppendName(s, i++);
+	AppendField(s, String(GetResultName(di)));
+	AppendName(s, i++);
+	AppendField(s, static_cast<LONGLONG>(di->diffcode));
+	AppendName(s, i++);
+	AppendField(s, bLeft && bFile ? di->left.size.int64 : -1);
+	AppendName(s, i++);
+	AppendField(s, bRight && bFile ? di->right.size.int64 : -1);
+	AppendName(s, i++);
+	AppendField(s, bLeft ? di->left.mtime : FileTime());
+	AppendName(s, i++);
+	AppendField(s, bRight ? di->right.mtime : FileTime());
+	AppendName(s, i++);
+	AppendField(s, static_cast<LONGLONG>(di->nsdiffs));
+	AppendName(s, i++);
+	AppendField(s, static_cast<LONGLONG>(di->nidiffs));
+	AppendName(s, i++);
+	if (bLeft && bFile && di->left.encoding.m_codepage != -1)
+		AppendField(s, di->left.encoding.GetName());
+	else
+		AppendNull(s);
+	AppendName(s, i++);
+	if (bRight && bFile && di->right.encoding.m_codepage != -1)
+		AppendField(s, di->right.encoding.GetName());
+	else
+		AppendNull(s);
+	ASSERT(i == _countof(FieldNames));
+	if (m_cmdInfo.m_nBatchFormat != MergeCmdLineInfo::BatchFormatCsv)
+		s.push_back(_T('}'));
+	Emit(s);
+}
+
+/**
+ * @brief Remember a differing or unique file to include in the patch.
+ * Called concurrently on compare threads.
+ */
+void BatchCompare::AddPatchItem(const DIFFITEM *di)
+{
+	const DiffFileInfo &side = di->isSideLeftOrBoth() ? di->left : di->right;
+	String path = paths_ConcatPath(side.path, side.filename);
+	if (di->isBin())
+	{
+		Report(string_format(_T("Cannot include binary file in patch: %s"), path.c_str()).c_str());
+		return;
+	}
+	EnterCriticalSection(&m_csOutput);
+	m_rgPatchItems.push_back(std::make_pair(path, di));
+	LeaveCriticalSection(&m_csOutput);
+}
+
+/**
+ * @brief Write a patch of the remembered files, in order of their paths.
+ * Files are given as they would be from the folder compare window.
+ */
+bool BatchCompare::CreatePatch()
+{
+	std::sort(m_rgPatchItems.begin(), m_rgPatchItems.end());
+	CPatchTool patcher;
+	std::vector<std::pair<String, const DIFFITEM *> >::const_iterator it = m_rgPatchItems.begin();
+	while (it != m_rgPatchItems.end())
+	{
+		const DIFFITEM *di = it->second;
+		PATCHFILES files;
+		if (di->isSideLeftOrBoth())
+		{
+			files.lfile = paths_ConcatPath(m_pCtxt->GetLeftFilepath(di), di->left.filename);
+			files.pathLeft = paths_ConcatPath(di->left.path, di->left.filename);
+			string_replace(files.pathLeft, _T('\\'), _T('/'));
+		}
+		if (di->isSideRightOrBoth())
+		{
+			files.rfile = paths_ConcatPath(m_pCtxt->GetRightFilepath(di), di->right.filename);
+			files.pathRight = paths_ConcatPath(di->right.path, di->right.filename);
+			string_replace(files.pathRight, _T('\\'), _T('/'));
+		}
+		patcher.AddFiles(files);
+		++it;
+	}
+	String msg = patcher.RunHeadless(m_cmdInfo.m_sPatchOutput.c_str());
+	if (msg.empty())
+		return true;
+	Report(msg.c_str());
+	return false;
+}
+
+/**
+ * @brief Report an error which prevented items from being collected.
+ */
+void BatchCompare::OnError(const CDiffContext *, LPCTSTR msg)
+{
+	InterlockedIncrement(&m_nErrors);
+	Report(msg);
+}
+
+/**
+ * @brief Let Run() know that the compare threads have finished.
+ */
+void BatchCompare::OnCompareDone(const CDiffContext *)
+{
+	SetEvent(m_hDone);
+}
+
+/**
+ * @brief Append a record to the output buffer, and flush it if appropriate.
+ */
+void BatchCompare::Emit(const String &record)
+{
+	int const cb = WideCharToMultiByte(CP_UTF8, 0,
+		record.c_str(), static_cast<int>(record.length()), NULL, 0, NULL, NULL);
+	EnterCriticalSection(&m_csOutput);
+	size_t const cbOld = m_buffer.size();
+	m_buffer.resize(cbOld + cb + 2);
+	WideCharToMultiByte(CP_UTF8, 0,
+		record.c_str(), static_cast<int>(record.length()), &m_buffer[cbOld], cb, NULL, NULL);
+	m_buffer[cbOld + cb] = '\r';
+	m_buffer[cbOld + cb + 1] = '\n';
+	if (m_bFlushEachRecord || m_buffer.size() >= FlushThreshold)
+		Flush();
+	LeaveCriticalSection(&m_csOutput);
+}
+
+/**
+ * @brief Write out the output buffer. Caller must hold m_csOutput.
+ */
+void BatchCompare::Flush()
+{
+	if (m_buffer.empty())
+		return;
+	DWORD cb = 0;
+	if (!WriteFile(m_hOutput, m_buffer.c_str(), static_cast<DWORD>(m_buffer.size()), &cb, NULL))
+	{
+		// Reader went away, so there is no point in comparing any further
+		InterlockedIncrement(&m_nErrors);
+		if (m_pCtxt)
+			m_pCtxt->Abort();
+	}
+	m_buffer.clear();
+}
+
+/**
+ * @brief Report an error message on stderr and in the log.
+ */
+void BatchCompare::Report(LPCTSTR msg)
+{
+	LogFile.Write(CLogFile::LERROR, _T("%s"), msg);
+	HANDLE const hError = GetStdHandle(STD_ERROR_HANDLE);
+	if (hError == NULL || hError == INVALID_HANDLE_VALUE)
+		return;
+	OString text = HString::Uni(msg)->Oct(CP_UTF8);
+	DWORD cb = 0;
+	WriteFile(hError, text.A, lstrlenA(text.A), &cb, NULL);
+	WriteFile(hError, "\r\n", 2, &cb, NULL);
+}
+
+/**
+ * @brief Abort the compare on Ctrl+C or Ctrl+Break.
+ */
+BOOL WINAPI BatchCompare::ConsoleCtrlHandler(DWORD)
+{
+	if (BatchCompare *const pRunning = m_pRunning)
+		pRunning->m_pCtxt->Abort();
+	return TRUE;
+}
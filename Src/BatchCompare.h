@@ -0,0 +1,73 @@
+/**
+ * @file  BatchCompare.h
+ *
+ * @brief Declaration of BatchCompare class.
+ *
+ */
+#pragma once
+
+#include "DiffContext.h"
+#include "MergeCmdLineInfo.h"
+
+/**
+ * @brief Headless folder compare.
+ * Runs a CDiffContext without any windows, and streams one record per
+ * compared item to a file or to stdout, as JSON Lines or as CSV. Records
+ * are written in the order in which the compare threads complete them.
+ * Optionally writes a patch of the differing files, in order of their paths.
+ */
+class BatchCompare
+	: ZeroInit<BatchCompare>
+	, public IDiffItemSink
+{
+public:
+	/** @brief Process exit codes. */
+	enum
+	{
+		ExitIdentical = 0, /**< No differences found. */
+		ExitDifferent = 1, /**< Differences or unique items found. */
+		ExitError = 2 /**< Compare failed for at least one item. */
+	};
+
+	BatchCompare(const MergeCmdLineInfo &);
+	~BatchCompare();
+	int Run();
+
+private:
+	virtual void OnDiffItem(const CDiffContext *, const DIFFITEM *);
+	virtual void OnError(const CDiffContext *, LPCTSTR);
+	virtual void OnCompareDone(const CDiffContext *);
+
+	bool OpenOutput();
+	void AddPatchItem(const DIFFITEM *);
+	bool CreatePatch();
+	void AppendName(String &, int) const;
+	void AppendField(String &, const String &) const;
+	void AppendField(String &, LONGLONG) const;
+	void AppendField(String &, const FileTime &) const;
+	void AppendNull(String &) const;
+	void Emit(const String &);
+	void Flush();
+	void Report(LPCTSTR);
+
+	static BOOL WINAPI ConsoleCtrlHandler(DWORD);
+	static BatchCompare *m_pRunning; /**< Instance to abort on Ctrl+C. */
+
+	const MergeCmdLineInfo &m_cmdInfo;
+	CDiffContext *m_pCtxt;
+	CompareStats *m_pCompareStats;
+	HANDLE m_hOutput; /**< Where records go. */
+	HANDLE m_hDone; /**< Signaled when compare threads have finished. */
+	bool m_bCloseOutput; /**< m_hOutput is ours to close. */
+	bool m_bFlushEachRecord; /**< Output is a pipe or console. */
+	CRITICAL_SECTION m_csOutput;
+	std::string m_buffer; /**< UTF-8 encoded records not yet written. */
+	/** @brief Items to include in patch, keyed by relative path. */
+	std::vector<std::pair<String, const DIFFITEM *> > m_rgPatchItems;
+	LONG m_nDifferent; /**< Number of items which differ or are unique. */
+	LONG m_nErrors; /**< Number of items which failed to compare. */
+	static const size_t FlushThreshold = 64 * 1024;
+
+	BatchCompare(const BatchCompare &); // disallow copy construction
+	void operator=(const BatchCompare &); // disallow assignment
+};
@@ -0,0 +1,125 @@
+/**
+ * @file  ChunkedIndex.cpp
+ *
+ * @brief Self-test of ChunkedIndex class template.
+ */
+#include "StdAfx.h"
+#include "ChunkedIndex.h"
+
+/**
+ * @brief Traits of entries with two fields, and small chunks to split often.
+ */
+struct TestTraits
+{
+	struct Entry
+	{
+		int a, b;
+	};
+	enum { SUMS = 2, CHUNK_SIZE = 4 };
+	static void Measure(const Entry &entry, int *aSums)
+	{
+		aSums[1] += entry.a;
+		aSums[2] += entry.b;
+	}
+};
+
+TESTCASE
+{
+	// Compare against a plain array
+	typedef ChunkedIndex<TestTraits> Index;
+	typedef TestTraits::Entry Entry;
+	Index index;
+	std::vector<Entry> entries;
+	unsigned seed = 1;
+	for (int n = 0; n < 400; ++n)
+	{
+		seed = seed * 1103515245 + 12345;
+		int const nOp = (seed >> 16) % 4;
+		seed = seed * 1103515245 + 12345;
+		int const nIndex = static_cast<int>((seed >> 16) % (entries.size() + 1));
+		seed = seed * 1103515245 + 12345;
+		// now and then overflow a chunk by far
+		int nCount = (seed >> 16) % (n % 50 == 0 ? 100 : 12);
+		if (nOp == 0 && nIndex < static_cast<int>(entries.size()))
+		{
+			// change an entry in place
+			int nOffset = nIndex;
+			int aBefore[Index::SUMS];
+			int const nChunk = index.Locate(nOffset, aBefore);
+			Entry &entry = index.GetEntries(nChunk)[nOffset];
+			index.Adjust(nChunk, 1, nCount - entry.a);
+			entry.a = nCount;
+			entries[nIndex].a = nCount;
+		}
+		else if (nOp == 1)
+		{
+			nCount = min(nCount, static_cast<int>(entries.size()) - nIndex);
+			index.Erase(nIndex, nCount);
+			entries.erase(entries.begin() + nIndex, entries.begin() + nIndex + nCount);
+		}
+		else if (nOp == 2)
+		{
+			// insert value initialized entries
+			index.Insert(nIndex, NULL, nCount);
+			Entry const entry = { 0, 0 };
+			entries.insert(entries.begin() + nIndex, nCount, entry);
+		}
+		else
+		{
+			std::vector<Entry> aNew(nCount);
+			for (int i = 0; i < nCount; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				aNew[i].a = (seed >> 16) % 4;
+				aNew[i].b = (seed >> 20) % 4;
+			}
+			index.Insert(nIndex, aNew.data(), nCount);
+			entries.insert(entries.begin() + nIndex, aNew.begin(), aNew.end());
+		}
+		// walk the chunks along the plain array
+		int const nChunks = index.GetChunkCount();
+		std::vector<int> starts;
+		int aSums[Index::SUMS] = { 0, 0, 0 };
+		for (int nChunk = 0; nChunk < nChunks; ++nChunk)
+		{
+			starts.insert(starts.end(), aSums, aSums + Index::SUMS);
+			int const nSize = index.GetChunkSize(nChunk);
+			assert(nSize > 0 && nSize <= Index::CHUNK_CAPACITY);
+			const Entry *const pEntries = index.GetEntries(nChunk);
+			for (int i = 0; i < nSize; ++i)
+			{
+				const Entry &expected = entries[aSums[0]];
+				assert(pEntries[i].a == expected.a && pEntries[i].b == expected.b);
+				++aSums[0];
+				aSums[1] += expected.a;
+				aSums[2] += expected.b;
+			}
+		}
+		starts.insert(starts.end(), aSums, aSums + Index::SUMS);
+		assert(aSums[0] == static_cast<int>(entries.size()));
+		for (int k = 0; k < Index::SUMS; ++k)
+			assert(index.GetTotal(k) == aSums[k]);
+		// look up only some of the keys to keep the test quick
+		for (int nKey = n % 3; nKey <= aSums[0] + 1; nKey += 3)
+		{
+			int aBefore[Index::SUMS];
+			for (int k = 0; k < Index::SUMS; ++k)
+			{
+				int const nChunk = index.FindChunk(k, nKey, aBefore);
+				assert(nChunk >= 0 && nChunk <= nChunks);
+				for (int j = 0; j < Index::SUMS; ++j)
+					assert(aBefore[j] == starts[nChunk * Index::SUMS + j]);
+				assert(aBefore[k] <= nKey);
+				assert(nChunk == nChunks || nKey < starts[(nChunk + 1) * Index::SUMS + k]);
+			}
+			if (nKey <= aSums[0])
+			{
+				int nOffset = nKey;
+				int const nChunk = index.Locate(nOffset, aBefore);
+				assert(aBefore[0] + nOffset == nKey);
+				assert(nChunk == (nKey < aSums[0] ? index.FindChunk(0, nKey, aBefore) : max(nChunks - 1, 0)));
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file ChunkedIndex.h
+ *
+ * @brief Declaration and implementation of ChunkedIndex class template.
+ *
+ */
+#pragma once
+
+/**
+ * @brief Sequence of entries, with running sums over some of their fields.
+ * Entries are stored in chunks, and Fenwick trees over the chunks sum up
+ * their entries and fields. Entries are inserted or removed within their
+ * chunk, so that an edit moves at most a chunk's worth of entries and updates
+ * the trees in logarithmic time. Only chunks which fill up or run empty cause
+ * the trees to be rebuilt, which takes time linear in the number of chunks.
+ * Traits define the Entry type, which must be copyable by memcpy(), the
+ * number of SUMS and the CHUNK_SIZE, and Measure(entry, aSums), which adds
+ * the fields of an entry to aSums[1] to aSums[SUMS]. Sum 0 counts entries.
+ */
+template<class Traits>
+class ChunkedIndex
+{
+public:
+	typedef typename Traits::Entry Entry;
+	enum
+	{
+		COUNT, /**< Sum which counts entries. */
+		SUMS = 1 + Traits::SUMS, /**< Number of sums. */
+		/** @brief Number of entries a chunk is given when it is made. */
+		CHUNK_SIZE = Traits::CHUNK_SIZE,
+		/** @brief Number of entries a chunk can hold. */
+		CHUNK_CAPACITY = 2 * CHUNK_SIZE
+	};
+
+	ChunkedIndex()
+	{
+		ClearSums(m_aTotals);
+	}
+	~ChunkedIndex()
+	{
+		Clear();
+	}
+	/**
+	 * @brief Remove all entries.
+	 */
+	void Clear()
+	{
+		typename std::vector<Chunk>::iterator it = m_aChunks.begin();
+		while (it != m_aChunks.end())
+			delete[] it++->pEntries;
+		m_aChunks.clear();
+		for (int k = 0; k < SUMS; ++k)
+			m_aTrees[k].clear();
+		ClearSums(m_aTotals);
+	}
+	/** @brief Return the sum over all entries. */
+	int GetTotal(int nSum) const { return m_aTotals[nSum]; }
+	/** @brief Return the number of chunks. */
+	int GetChunkCount() const { return static_cast<int>(m_aChunks.size()); }
+	/** @brief Return the number of entries in a chunk. */
+	int GetChunkSize(int nChunk) const { return m_aChunks[nChunk].aSums[COUNT]; }
+	/** @brief Return the entries in a chunk. */
+	Entry *GetEntries(int nChunk) const { return m_aChunks[nChunk].pEntries; }
+
+	/**
+	 * @brief Find the first chunk whose sums up to and including it exceed a key.
+	 * @param [in] nSum The sum to which the key refers.
+	 * @param [in] nKey The key to look for.
+	 * @param [out] aBefore Sums over the entries before the chunk.
+	 * @return The index of the chunk, or the number of chunks if there is none.
+	 */
+	int FindChunk(int nSum, int nKey, int *aBefore) const
+	{
+		int const n = GetChunkCount();
+		int nMask = 1;
+		while (nMask <= n / 2)
+			nMask <<= 1;
+		int nChunk = 0;
+		ClearSums(aBefore);
+		for (; nMask != 0; nMask >>= 1)
+		{
+			int const i = nChunk + nMask;
+			if (i <= n && m_aTrees[nSum][i] <= nKey)
+			{
+				nChunk = i;
+				nKey -= m_aTrees[nSum][i];
+				for (int k = 0; k < SUMS; ++k)
+					aBefore[k] += m_aTrees[k][i];
+			}
+		}
+		return nChunk;
+	}
+
+	/**
+	 * @brief Find the chunk which holds the given entry.
+	 * @param [in,out] nIndex The index of the entry on input, the index within
+	 *  the chunk on output. The end of the last chunk counts as part of it.
+	 * @param [out] aBefore Sums over the entries before the chunk.
+	 * @return The index of the chunk.
+	 */
+	int Locate(int &nIndex, int *aBefore) const
+	{
+		int nChunk = FindChunk(COUNT, nIndex, aBefore);
+		if (nChunk == GetChunkCount() && nChunk != 0)
+		{
+			const Chunk &chunk = m_aChunks[--nChunk];
+			for (int k = 0; k < SUMS; ++k)
+				aBefore[k] -= chunk.aSums[k];
+		}
+		nIndex -= aBefore[COUNT];
+		return nChunk;
+	}
+
+	/**
+	 * @brief Account for a change to the fields of entries in a chunk.
+	 * @param [in] nChunk Index of the chunk.
+	 * @param [in] nSum The sum which has changed.
+	 * @param [in] nDelta The change to the sum.
+	 */
+	void Adjust(int nChunk, int nSum, int nDelta)
+	{
+		m_aChunks[nChunk].aSums[nSum] += nDelta;
+		m_aTotals[nSum] += nDelta;
+		int const n = GetChunkCount();
+		for (int i = nChunk + 1; i <= n; i += i & -i)
+			m_aTrees[nSum][i] += nDelta;
+	}
+
+	/**
+	 * @brief Insert entries before the given entry.
+	 * @param [in] nIndex Index of the first inserted entry.
+	 * @param [in] pEntries The entries to insert, or NULL for value
+	 *  initialized entries.
+	 * @param [in] nCount Number of entries to insert.
+	 */
+	void Insert(int nIndex, const Entry *pEntries, int nCount)
+	{
+		if (nCount <= 0)
+			return;
+		if (m_aChunks.empty())
+		{
+			Chunk chunk;
+			chunk.pEntries = new Entry[CHUNK_CAPACITY];
+			ClearSums(chunk.aSums);
+			m_aChunks.push_back(chunk);
+			BuildTrees();
+		}
+		int aSums[SUMS];
+		int const nChunk = Locate(nIndex, aSums);
+		Chunk &chunk = m_aChunks[nChunk];
+		ClearSums(aSums);
+		aSums[COUNT] = nCount;
+		for (int i = 0; i < nCount; ++i)
+			Traits::Measure(pEntries ? pEntries[i] : Entry(), aSums);
+		int const nSize = chunk.aSums[COUNT];
+		if (nSize + nCount <= CHUNK_CAPACITY)
+		{
+			memmove(chunk.pEntries + nIndex + nCount, chunk.pEntries + nIndex,
+				(nSize - nIndex) * sizeof *chunk.pEntries);
+			if (pEntries)
+				memcpy(chunk.pEntries + nIndex, pEntries, nCount * sizeof *pEntries);
+			else
+				std::fill_n(chunk.pEntries + nIndex, nCount, Entry());
+			for (int k = 0; k < SUMS; ++k)
+				Adjust(nChunk, k, aSums[k]);
+			return;
+		}
+		for (int k = 0; k < SUMS; ++k)
+			m_aTotals[k] += aSums[k];
+		// Spread the entries of the overflowing chunk over as many chunks as needed
+		int const nTotal = nSize + nCount;
+		std::vector<Chunk> aChunks((nTotal + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		int nSource = 0;
+		typename std::vector<Chunk>::iterator it = aChunks.begin();
+		while (it != aChunks.end())
+		{
+			Chunk &target = *it++;
+			target.pEntries = new Entry[CHUNK_CAPACITY];
+			int const nRemaining = nTotal - nSource;
+			ClearSums(target.aSums);
+			target.aSums[COUNT] = nRemaining < CHUNK_SIZE ? nRemaining : CHUNK_SIZE;
+			for (int i = 0; i < target.aSums[COUNT]; ++i, ++nSource)
+			{
+				Entry const entry =
+					nSource < nIndex ? chunk.pEntries[nSource] :
+					nSource >= nIndex + nCount ? chunk.pEntries[nSource - nCount] :
+					pEntries ? pEntries[nSource - nIndex] : Entry();
+				target.pEntries[i] = entry;
+				Traits::Measure(entry, target.aSums);
+			}
+		}
+		delete[] chunk.pEntries;
+		m_aChunks.erase(m_aChunks.begin() + nChunk);
+		m_aChunks.insert(m_aChunks.begin() + nChunk, aChunks.begin(), aChunks.end());
+		BuildTrees();
+	}
+
+	/**
+	 * @brief Remove entries.
+	 * @param [in] nIndex Index of the first removed entry.
+	 * @param [in] nCount Number of entries to remove.
+	 */
+	void Erase(int nIndex, int nCount)
+	{
+		if (nCount <= 0)
+			return;
+		int aSums[SUMS];
+		int nChunk = Locate(nIndex, aSums);
+		bool bEmptied = false;
+		while (nCount > 0)
+		{
+			Chunk &chunk = m_aChunks[nChunk];
+			int const nSize = chunk.aSums[COUNT];
+			int const nErased = min(nCount, nSize - nIndex);
+			ClearSums(aSums);
+			for (int i = nIndex; i < nIndex + nErased; ++i)
+				Traits::Measure(chunk.pEntries[i], aSums);
+			aSums[COUNT] = nErased;
+			memmove(chunk.pEntries + nIndex, chunk.pEntries + nIndex + nErased,
+				(nSize - nIndex - nErased) * sizeof *chunk.pEntries);
+			for (int k = 0; k < SUMS; ++k)
+				Adjust(nChunk, k, -aSums[k]);
+			if (chunk.aSums[COUNT] == 0)
+				bEmptied = true;
+			nCount -= nErased;
+			nIndex = 0;
+			++nChunk;
+		}
+		if (bEmptied)
+		{
+			// Drop the chunks which have run empty
+			typename std::vector<Chunk>::iterator p = m_aChunks.begin();
+			typename std::vector<Chunk>::iterator q = p;
+			while (p != m_aChunks.end())
+			{
+				if (p->aSums[COUNT] != 0)
+					*q++ = *p;
+				else
+					delete[] p->pEntries;
+				++p;
+			}
+			m_aChunks.erase(q, m_aChunks.end());
+			BuildTrees();
+		}
+	}
+
+private:
+	struct Chunk
+	{
+		Entry *pEntries; /**< Entries in the chunk. */
+		int aSums[SUMS]; /**< Sums over the entries. */
+	};
+
+	static void ClearSums(int *aSums)
+	{
+		for (int k = 0; k < SUMS; ++k)
+			aSums[k] = 0;
+	}
+
+	/**
+	 * @brief Build the Fenwick trees over the chunks in linear time.
+	 */
+	void BuildTrees()
+	{
+		int const n = GetChunkCount();
+		for (int k = 0; k < SUMS; ++k)
+		{
+			std::vector<int> &aTree = m_aTrees[k];
+			aTree.resize(n + 1);
+			aTree[0] = 0;
+			for (int i = 1; i <= n; ++i)
+				aTree[i] = m_aChunks[i - 1].aSums[k];
+			for (int i = 1; i <= n; ++i)
+			{
+				int const j = i + (i & -i);
+				if (j <= n)
+					aTree[j] += aTree[i];
+			}
+		}
+	}
+
+	std::vector<Chunk> m_aChunks;
+	std::vector<int> m_aTrees[SUMS]; /**< Fenwick trees over the sums per chunk. */
+	int m_aTotals[SUMS]; /**< Sums over all entries. */
+
+	ChunkedIndex(const ChunkedIndex &); // disallow copy construction
+	void operator=(const ChunkedIndex &); // disallow assignment
+};
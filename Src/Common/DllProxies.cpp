@@ -105,6 +105,18 @@ DllProxy::Instance<struct KERNEL32V51> KERNEL32V51 =
 	(HMODULE)0
 };
 
+/**
+ * @brief NTDLL dll proxy
+ */
+DllProxy::Instance<struct NTDLL> NTDLL =
+{
+	"NTDLL.DLL",
+	"RtlGetCompressionWorkSpaceSize",
+	"RtlCompressBuffer",
+	"RtlDecompressBuffer",
+	(HMODULE)0
+};
+
 /**
  * @brief heksedit dll proxy
  */
@@ -79,6 +79,17 @@ struct KERNEL32V51
 
 extern DllProxy::Instance<struct KERNEL32V51> KERNEL32V51;
 
+// NTDLL dll proxy
+struct NTDLL
+{
+	LONG(NTAPI*RtlGetCompressionWorkSpaceSize)(USHORT, PULONG, PULONG);
+	LONG(NTAPI*RtlCompressBuffer)(USHORT, PUCHAR, ULONG, PUCHAR, ULONG, ULONG, PULONG, PVOID);
+	LONG(NTAPI*RtlDecompressBuffer)(USHORT, PUCHAR, ULONG, PUCHAR, ULONG, PULONG);
+	HMODULE H;
+};
+
+extern DllProxy::Instance<struct NTDLL> NTDLL;
+
 // heksedit dll proxy
 struct hekseditU
 {
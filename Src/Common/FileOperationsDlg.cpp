@@ -22,7 +22,9 @@
 #include "resource.h"
 #include "paths.h"
 #include "LanguageSelect.h"
+#include "ShellFileOperations.h"
 #include "FileOperationsDlg.h"
+#include "LogFile.h"
 #include <process.h>
 
 /** @brief ID for timer updating UI. */
@@ -108,9 +110,13 @@ static void ShrinkPath(String &shrinked, LPCWSTR complete)
 	}
 }
 
-FileOperationsDlg::FileOperationsDlg(SHFILEOPSTRUCT &fos)
+FileOperationsDlg::FileOperationsDlg(SHFILEOPSTRUCT &fos, ShellFileOperations::Sink *pSink)
 	: ODialog(IDD_FILE_OPERATIONS)
 	, m_fos(fos)
+	, m_pSink(pSink)
+	, m_bReporting(false)
+	, m_nDeferredCommand(-1)
+	, m_nFailures(0)
 	, m_count(0)
 	, m_hThread(NULL)
 	, m_hContinue(NULL)
@@ -126,13 +132,28 @@ FileOperationsDlg::FileOperationsDlg(SHFILEOPSTRUCT &fos)
 	, m_dwCopyFlags(LOBYTE(m_dwOSVersion) >= 6 ? COPY_FILE_NO_BUFFERING : 0)
 	, m_src(NULL)
 	, m_dst(NULL)
+	, m_nWorkers(0)
+	, m_nHead(0)
+	, m_nQueued(0)
+	, m_nPending(0)
+	, m_hSlots(NULL)
+	, m_hJobs(NULL)
+	, m_hIdle(NULL)
 {
+	m_self.pDlg = this;
+	InitializeCriticalSection(&m_csQueue);
+	InitializeCriticalSection(&m_csPrompt);
 }
 
 FileOperationsDlg::~FileOperationsDlg()
 {
 	SysFreeString(m_src);
 	SysFreeString(m_dst);
+	SysFreeString(m_self.path);
+	for (int i = 0; i < MaxWorkers; ++i)
+		SysFreeString(m_workers[i].path);
+	DeleteCriticalSection(&m_csQueue);
+	DeleteCriticalSection(&m_csPrompt);
 }
 
 LRESULT FileOperationsDlg::WindowProc(UINT message, WPARAM wParam, LPARAM lParam)
@@ -168,6 +189,12 @@ LRESULT FileOperationsDlg::WindowProc(UINT message, WPARAM wParam, LPARAM lParam
 		case IDCANCEL: // user canceled
 			if (!IsWindowEnabled())
 				break; // UI thread appears to be in WM_APP_MESSAGE_BOX_DIALOG.
+			if (m_bReporting)
+			{
+				// Come back when the sink is done with the current batch
+				m_nDeferredCommand = static_cast<int>(wParam);
+				break;
+			}
 			if (m_hThread)
 			{
 				m_bCancel = TRUE;
@@ -192,6 +219,8 @@ LRESULT FileOperationsDlg::WindowProc(UINT message, WPARAM wParam, LPARAM lParam
 				CloseHandle(m_hCancel);
 				m_hCancel = NULL;
 			}
+			// Report the items which have been done since the last batch
+			ReportDone();
 			EndDialog(wParam);
 			break;
 		case IDC_PAUSE_CONTINUE:
@@ -202,6 +231,7 @@ LRESULT FileOperationsDlg::WindowProc(UINT message, WPARAM wParam, LPARAM lParam
 		break;
 	case WM_TIMER:
 		UpdateProgress();
+		ReportDone();
 		break;
 	case WM_CTLCOLORSTATIC:
 		switch (reinterpret_cast<HWindow *>(lParam)->GetDlgCtrlID())
@@ -270,6 +300,34 @@ void FileOperationsDlg::UpdateProgress()
 	}
 }
 
+/**
+ * @brief Report the items which have been done to the sink, in one batch.
+ */
+void FileOperationsDlg::ReportDone()
+{
+	if (m_pSink == NULL || m_bReporting)
+		return;
+	std::vector<int> done;
+	{
+		AutoLock lock(m_progress);
+		done.swap(m_progress.Done);
+	}
+	if (done.empty())
+		return;
+	// The sink may prompt the user, so keep timer ticks from reentering
+	m_bReporting = true;
+	std::vector<int>::const_iterator it = done.begin();
+	while (it != done.end())
+		m_pSink->ItemDone(*it++);
+	m_pSink->BatchDone();
+	m_bReporting = false;
+	if (m_nDeferredCommand != -1)
+	{
+		PostMessage(WM_COMMAND, m_nDeferredCommand);
+		m_nDeferredCommand = -1;
+	}
+}
+
 BOOL FileOperationsDlg::OnInitDialog()
 {
 	ODialog::OnInitDialog();
@@ -356,9 +414,13 @@ int FileOperationsDlg::Invoke(CMessageBoxDialog &dlg)
 
 BOOL FileOperationsDlg::WantRetry(int &choice, UINT fmt, LPCWSTR src, LPCWSTR dst)
 {
+	DWORD const error = GetLastError();
+	AutoLock lock(&m_csPrompt);
+	if (m_bCancel)
+		return FALSE;
 	if (choice != IDIGNOREALL)
 	{
-		OException what = GetLastError();
+		OException what = error;
 		src = paths_UndoMagic(wcsdupa(src));
 		dst = paths_UndoMagic(wcsdupa(dst));
 		CMessageBoxDialog dlg(
@@ -372,12 +434,13 @@ BOOL FileOperationsDlg::WantRetry(int &choice, UINT fmt, LPCWSTR src, LPCWSTR ds
 	}
 	if (choice == IDRETRY)
 		return TRUE;
-	m_fos.fAnyOperationsAborted = TRUE;
+	Fail();
 	return FALSE;
 }
 
 BOOL FileOperationsDlg::WantTrash(int &choice, UINT fmt, LPCWSTR src, LPCWSTR dst)
 {
+	AutoLock lock(&m_csPrompt);
 	if (m_bCancel)
 		return FALSE;
 	if (choice != IDYESTOALL && choice != IDNOTOALL)
@@ -396,10 +459,19 @@ BOOL FileOperationsDlg::WantTrash(int &choice, UINT fmt, LPCWSTR src, LPCWSTR ds
 	}
 	if (choice == IDYES || choice == IDYESTOALL)
 		return TRUE;
-	m_fos.fAnyOperationsAborted = TRUE;
+	Fail();
 	return FALSE;
 }
 
+/**
+ * @brief Record that an operation has failed or been declined.
+ */
+void FileOperationsDlg::Fail()
+{
+	m_fos.fAnyOperationsAborted = TRUE;
+	InterlockedIncrement(&m_nFailures);
+}
+
 LPWSTR FileOperationsDlg::AssignPath(BSTR &p, LPCWSTR q)
 {
 	if (!SysReAllocStringLen(&p, NULL, SHRT_MAX))
@@ -414,7 +486,13 @@ DWORD FileOperationsDlg::ProgressRoutine(
 	LARGE_INTEGER StreamSize, LARGE_INTEGER StreamBytesTransferred,
 	DWORD, DWORD dwCallbackReason, HANDLE, HANDLE, LPVOID pv)
 {
-	FileOperationsDlg *const p = static_cast<FileOperationsDlg *>(pv);
+	Worker *const w = static_cast<Worker *>(pv);
+	if (dwCallbackReason == CALLBACK_CHUNK_FINISHED &&
+		TotalBytesTransferred.QuadPart == TotalFileSize.QuadPart)
+	{
+		w->nBytes += TotalFileSize.QuadPart;
+	}
+	FileOperationsDlg *const p = w->pDlg;
 	AutoWait wait(p->m_hContinue);
 	AutoLock lock(p->m_progress);
 	p->m_progress.TotalFileSize.QuadPart = TotalFileSize.QuadPart;
@@ -423,11 +501,13 @@ DWORD FileOperationsDlg::ProgressRoutine(
 	return PROGRESS_CONTINUE;
 }
 
-void FileOperationsDlg::Item(int nItem)
+void FileOperationsDlg::ItemDone(int nItem, bool bDone)
 {
 	AutoLock lock(m_progress);
-	m_progress.Item = nItem;
+	++m_progress.Item;
 	m_progress.ItemChanged = true;
+	if (bDone && m_pSink)
+		m_progress.Done.push_back(nItem);
 }
 
 void FileOperationsDlg::FromTo(LPCWSTR src, LPCWSTR dst)
@@ -515,7 +595,7 @@ LPVOID FileOperationsDlg::ClearTarget(LPCWSTR src, LPWSTR dst)
 	return dst;
 }
 
-void FileOperationsDlg::MoveItem(LPCWSTR src, LPCWSTR dst)
+bool FileOperationsDlg::MoveItem(LPCWSTR src, LPCWSTR dst)
 {
 	do
 	{
@@ -525,7 +605,7 @@ void FileOperationsDlg::MoveItem(LPCWSTR src, LPCWSTR dst)
 			if (attr & FILE_ATTRIBUTE_DIRECTORY)
 			{
 				if (!ClearTarget(src, AssignPath(m_dst, dst)))
-					return;
+					return false;
 				if (attr & ProtectiveFileAttributes)
 					SetFileAttributesW(dst, FILE_ATTRIBUTE_DIRECTORY);
 				RemoveDirectoryW(dst);
@@ -534,18 +614,19 @@ void FileOperationsDlg::MoveItem(LPCWSTR src, LPCWSTR dst)
 			else
 			{
 				if (!WantTrash(m_trash_file, IDS_TRASH_FILE, src, dst))
-					return;
+					return false;
 				if (attr & ProtectiveFileAttributes)
 					SetFileAttributesW(dst, FILE_ATTRIBUTE_NORMAL);
 				DeleteFileW(dst);
 			}
 		}
-		if (MoveFileWithProgressW(src, dst, &ProgressRoutine, this, MOVEFILE_COPY_ALLOWED))
-			return;
+		if (MoveFileWithProgressW(src, dst, &ProgressRoutine, &m_self, MOVEFILE_COPY_ALLOWED))
+			return true;
 	} while (!m_bCancel && WantRetry(m_retry, IDS_ERROR_FILEMOVE, src, dst));
+	return false;
 }
 
-void FileOperationsDlg::CopyLeaf(LPCWSTR src, LPCWSTR dst)
+bool FileOperationsDlg::CopyLeaf(Worker &w, LPCWSTR src, LPCWSTR dst, DWORD dwCopyFlags)
 {
 	do
 	{
@@ -554,8 +635,8 @@ void FileOperationsDlg::CopyLeaf(LPCWSTR src, LPCWSTR dst)
 		{
 			if (attr & FILE_ATTRIBUTE_DIRECTORY)
 			{
-				if (!ClearTarget(src, AssignPath(m_dst, dst)))
-					return;
+				if (!ClearTarget(src, AssignPath(w.path, dst)))
+					return false;
 				if (attr & ProtectiveFileAttributes)
 					SetFileAttributesW(dst, FILE_ATTRIBUTE_DIRECTORY);
 				RemoveDirectoryW(dst);
@@ -564,13 +645,14 @@ void FileOperationsDlg::CopyLeaf(LPCWSTR src, LPCWSTR dst)
 			else if (attr & ProtectiveFileAttributes)
 			{
 				if (!WantTrash(m_trash_file_attentive, IDS_TRASH_FILE_ATTENTIVE, src, dst))
-					return;
+					return false;
 				SetFileAttributesW(dst, FILE_ATTRIBUTE_NORMAL);
 			}
 		}
-		if (CopyFileExW(src, dst, &ProgressRoutine, this, const_cast<BOOL *>(&m_bCancel), m_dwCopyFlags))
-			return;
+		if (CopyFileExW(src, dst, &ProgressRoutine, &w, const_cast<BOOL *>(&m_bCancel), dwCopyFlags))
+			return true;
 	} while (!m_bCancel && WantRetry(m_retry, IDS_ERROR_FILECOPY, src, dst));
+	return false;
 }
 
 void FileOperationsDlg::CopyTree(LPWSTR src, LPWSTR dst)
@@ -609,11 +691,15 @@ void FileOperationsDlg::CopyTree(LPWSTR src, LPWSTR dst)
 					{
 						if (LPWSTR dstname = AppendNameToPath(dst, fd.cFileName))
 						{
-							FromTo(src, dst);
 							if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+							{
+								FromTo(src, dst);
 								CopyTree(src, dst);
+							}
 							else
-								CopyLeaf(src, dst);
+							{
+								Enqueue(src, dst, GetCopyFlags(fd.nFileSizeHigh, fd.nFileSizeLow), -1);
+							}
 							*--dstname = L'\0';
 						}
 						*--srcname = L'\0';
@@ -625,7 +711,7 @@ void FileOperationsDlg::CopyTree(LPWSTR src, LPWSTR dst)
 	}
 }
 
-void FileOperationsDlg::DeleteItem(LPCWSTR src)
+bool FileOperationsDlg::DeleteItem(Worker &w, LPCWSTR src)
 {
 	do
 	{
@@ -635,8 +721,8 @@ void FileOperationsDlg::DeleteItem(LPCWSTR src)
 		{
 			if (attr & FILE_ATTRIBUTE_DIRECTORY)
 			{
-				if (!ClearTarget(src, AssignPath(m_src, src)))
-					return;
+				if (!ClearTarget(src, AssignPath(w.path, src)))
+					return false;
 				if (attr & ProtectiveFileAttributes)
 					SetFileAttributesW(src, FILE_ATTRIBUTE_DIRECTORY);
 				bDone = RemoveDirectoryW(src);
@@ -647,43 +733,217 @@ void FileOperationsDlg::DeleteItem(LPCWSTR src)
 				if (attr & ProtectiveFileAttributes)
 				{
 					if (!WantTrash(m_trash_file_attentive, IDS_TRASH_FILE_ATTENTIVE, src, src))
-						return;
+						return false;
 					SetFileAttributesW(src, FILE_ATTRIBUTE_NORMAL);
 				}
 				else
 				{
 					if (!WantTrash(m_trash_file, IDS_TRASH_FILE, src, src))
-						return;
+						return false;
 				}
 				bDone = DeleteFileW(src);
 			}
 		}
 		if (bDone)
-			return;
+			return true;
 	} while (!m_bCancel && WantRetry(m_retry, IDS_ERROR_FILEDELETE, src, src));
+	return false;
+}
+
+/**
+ * @brief Tell which flags to copy a file of given size with.
+ * Unbuffered copying moves data in larger chunks and keeps the cache from
+ * being flushed, but only pays off for large files.
+ */
+DWORD FileOperationsDlg::GetCopyFlags(DWORD nFileSizeHigh, DWORD nFileSizeLow) const
+{
+	return nFileSizeHigh != 0 || nFileSizeLow >= NoBufferingMinSize ? m_dwCopyFlags : 0;
+}
+
+/**
+ * @brief Start worker threads to take jobs from the queue.
+ * If none can start, the dispatcher thread does the jobs on its own.
+ */
+void FileOperationsDlg::StartWorkers()
+{
+	m_hSlots = CreateSemaphore(NULL, QueueSize, QueueSize, NULL);
+	m_hJobs = CreateSemaphore(NULL, 0, QueueSize + MaxWorkers, NULL);
+	m_hIdle = CreateEvent(NULL, TRUE, TRUE, NULL);
+	if (m_hSlots == NULL || m_hJobs == NULL || m_hIdle == NULL)
+		return;
+	while (m_nWorkers < MaxWorkers)
+	{
+		Worker &w = m_workers[m_nWorkers];
+		w.pDlg = this;
+		w.hThread = BeginThreadEx(NULL, 0,
+			OException::ThreadProc<Worker, &Worker::ThreadProc>, &w, 0, NULL);
+		if (w.hThread == NULL)
+			break;
+		++m_nWorkers;
+	}
+}
+
+/**
+ * @brief Let worker threads finish the queued jobs, and wait for them.
+ */
+void FileOperationsDlg::StopWorkers()
+{
+	if (m_nWorkers != 0)
+	{
+		// Workers which find the queue empty take this as a sign to stop
+		ReleaseSemaphore(m_hJobs, m_nWorkers, NULL);
+		for (int i = 0; i < m_nWorkers; ++i)
+		{
+			WaitForSingleObject(m_workers[i].hThread, INFINITE);
+			CloseHandle(m_workers[i].hThread);
+			m_workers[i].hThread = NULL;
+		}
+	}
+	if (m_hSlots)
+		CloseHandle(m_hSlots);
+	if (m_hJobs)
+		CloseHandle(m_hJobs);
+	if (m_hIdle)
+		CloseHandle(m_hIdle);
+	m_hSlots = m_hJobs = m_hIdle = NULL;
+}
+
+/**
+ * @brief Queue a job for the worker threads.
+ * Waits while the queue is full, so that the dispatcher thread does not run
+ * arbitrarily far ahead of the workers.
+ * @param [in] src File to copy or delete.
+ * @param [in] dst Where to copy the file to, or NULL to delete it.
+ * @param [in] dwCopyFlags Flags for CopyFileEx().
+ * @param [in] nItem Index of the item, or -1 if the job is part of one.
+ */
+void FileOperationsDlg::Enqueue(LPCWSTR src, LPCWSTR dst, DWORD dwCopyFlags, int nItem)
+{
+	Job job;
+	job.src = src;
+	if (dst)
+		job.dst = dst;
+	job.dwCopyFlags = dwCopyFlags;
+	job.nItem = nItem;
+	if (m_nWorkers == 0)
+	{
+		RunJob(m_self, job);
+		return;
+	}
+	HANDLE const handles[] = { m_hSlots, m_hCancel };
+	if (WaitForMultipleObjects(_countof(handles), handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+		return;
+	{
+		AutoLock lock(&m_csQueue);
+		m_queue[(m_nHead + m_nQueued++) % QueueSize] = job;
+		if (m_nPending++ == 0)
+			ResetEvent(m_hIdle);
+	}
+	ReleaseSemaphore(m_hJobs, 1, NULL);
+}
+
+/**
+ * @brief Wait for the worker threads to finish all queued jobs.
+ * The dispatcher thread drains the queue before and after working on a
+ * folder, so that jobs of different items can not get in each other's way.
+ */
+void FileOperationsDlg::Drain()
+{
+	if (m_nWorkers == 0)
+		return;
+	HANDLE const handles[] = { m_hIdle, m_hCancel };
+	WaitForMultipleObjects(_countof(handles), handles, FALSE, INFINITE);
+}
+
+void FileOperationsDlg::RunJob(Worker &w, const Job &job)
+{
+	bool bDone = false;
+	if (!m_bCancel)
+	{
+		if (job.dst.empty())
+		{
+			bDone = DeleteItem(w, job.src.c_str());
+		}
+		else
+		{
+			FromTo(job.src.c_str(), job.dst.c_str());
+			bDone = CopyLeaf(w, job.src.c_str(), job.dst.c_str(), job.dwCopyFlags);
+		}
+	}
+	if (job.nItem != -1)
+		ItemDone(job.nItem, bDone);
+}
+
+void FileOperationsDlg::LogThroughput(LPCTSTR what, DWORD dwTicks) const
+{
+	UINT64 nBytes = m_self.nBytes;
+	for (int i = 0; i < m_nWorkers; ++i)
+		nBytes += m_workers[i].nBytes;
+	LogFile.Write(CLogFile::LNOTICE,
+		_T("%s %d items, %I64u bytes in %u ms, %I64u KiB/s, %d worker threads"),
+		what, m_progress.Item, nBytes, dwTicks,
+		nBytes / max<DWORD>(dwTicks, 1) * 1000 / 1024, m_nWorkers);
+}
+
+DWORD FileOperationsDlg::WorkerThread(Worker &w)
+{
+	HANDLE const handles[] = { m_hJobs, m_hCancel };
+	while (WaitForMultipleObjects(_countof(handles), handles, FALSE, INFINITE) == WAIT_OBJECT_0)
+	{
+		Job job;
+		{
+			AutoLock lock(&m_csQueue);
+			if (m_nQueued == 0)
+				break;
+			job = m_queue[m_nHead];
+			m_nHead = (m_nHead + 1) % QueueSize;
+			--m_nQueued;
+		}
+		ReleaseSemaphore(m_hSlots, 1, NULL);
+		// Keep going, or else the dispatcher would wait forever for the job
+		try
+		{
+			RunJob(w, job);
+		}
+		catch (OException *e)
+		{
+			e->ReportError(NULL, MB_ICONSTOP | MB_TOPMOST);
+			delete e;
+			Fail();
+			// The job's item is not done
+			if (job.nItem != -1)
+				ItemDone(job.nItem, false);
+		}
+		AutoLock lock(&m_csQueue);
+		if (--m_nPending == 0)
+			SetEvent(m_hIdle);
+	}
+	return 0;
 }
 
 DWORD FileOperationsDlg::MoveThread()
 {
+	DWORD const dwStart = GetTickCount();
 	LPCWSTR pFrom = m_fos.pFrom;
 	LPCWSTR pTo = m_fos.pTo;
 	if (pFrom && pTo)
 	{
-		int nItem = 0;
-		while (!m_bCancel && *pFrom)
+		for (int nItem = 0; !m_bCancel && *pFrom; ++nItem)
 		{
 			FromTo(pFrom, pTo);
+			bool bDone = false;
 			if (LPCWSTR pToWhere = ToWhere(pFrom, pTo))
 			{
 				CreateDirectoryPath(pToWhere);
-				MoveItem(pFrom, pToWhere);
+				bDone = MoveItem(pFrom, pToWhere);
 			}
-			Item(++nItem);
+			ItemDone(nItem, bDone);
 			pFrom += lstrlenW(pFrom) + 1;
 			if (m_fos.fFlags & FOF_MULTIDESTFILES)
 				pTo += lstrlenW(pTo) + 1;
 		}
 	}
+	LogThroughput(_T("Moved"), GetTickCount() - dwStart);
 	if (!m_bCancel)
 		PostMessage(WM_COMMAND);
 	return 0;
@@ -691,33 +951,58 @@ DWORD FileOperationsDlg::MoveThread()
 
 DWORD FileOperationsDlg::CopyThread()
 {
-	LPCWSTR pFrom = m_fos.pFrom;
-	LPCWSTR pTo = m_fos.pTo;
-	if (pFrom && pTo)
+	DWORD const dwStart = GetTickCount();
+	StartWorkers();
+	try
 	{
-		int nItem = 0;
-		while (!m_bCancel && *pFrom)
+		LPCWSTR pFrom = m_fos.pFrom;
+		LPCWSTR pTo = m_fos.pTo;
+		if (pFrom && pTo)
 		{
-			FromTo(pFrom, pTo);
-			if (LPCWSTR pToWhere = ToWhere(pFrom, pTo))
+			for (int nItem = 0; !m_bCancel && *pFrom; ++nItem)
 			{
-				DWORD attr = GetFileAttributesW(pFrom);
-				if ((attr & ExclusiveFileAttributes) == FILE_ATTRIBUTE_DIRECTORY)
-				{
-					CopyTree(AssignPath(m_src, pFrom), AssignPath(m_dst, pToWhere));
-				}
-				else
+				FromTo(pFrom, pTo);
+				bool bQueued = false;
+				bool bDone = false;
+				if (LPCWSTR pToWhere = ToWhere(pFrom, pTo))
 				{
-					CreateDirectoryPath(pToWhere);
-					CopyLeaf(pFrom, pToWhere);
+					WIN32_FILE_ATTRIBUTE_DATA fad;
+					if (!GetFileAttributesExW(pFrom, GetFileExInfoStandard, &fad))
+					{
+						fad.dwFileAttributes = INVALID_FILE_ATTRIBUTES;
+						fad.nFileSizeHigh = fad.nFileSizeLow = 0;
+					}
+					if ((fad.dwFileAttributes & ExclusiveFileAttributes) == FILE_ATTRIBUTE_DIRECTORY)
+					{
+						Drain();
+						// Only jobs of this item fail while it is between drains
+						LONG const nFailures = m_nFailures;
+						CopyTree(AssignPath(m_src, pFrom), AssignPath(m_dst, pToWhere));
+						Drain();
+						bDone = !m_bCancel && m_nFailures == nFailures;
+					}
+					else
+					{
+						CreateDirectoryPath(pToWhere);
+						Enqueue(pFrom, pToWhere, GetCopyFlags(fad.nFileSizeHigh, fad.nFileSizeLow), nItem);
+						bQueued = true;
+					}
 				}
+				if (!bQueued)
+					ItemDone(nItem, bDone);
+				pFrom += lstrlenW(pFrom) + 1;
+				if (m_fos.fFlags & FOF_MULTIDESTFILES)
+					pTo += lstrlenW(pTo) + 1;
 			}
-			Item(++nItem);
-			pFrom += lstrlenW(pFrom) + 1;
-			if (m_fos.fFlags & FOF_MULTIDESTFILES)
-				pTo += lstrlenW(pTo) + 1;
 		}
 	}
+	catch (OException *)
+	{
+		StopWorkers();
+		throw;
+	}
+	StopWorkers();
+	LogThroughput(_T("Copied"), GetTickCount() - dwStart);
 	if (!m_bCancel)
 		PostMessage(WM_COMMAND);
 	return 0;
@@ -725,17 +1010,36 @@ DWORD FileOperationsDlg::CopyThread()
 
 DWORD FileOperationsDlg::DeleteThread()
 {
-	LPCWSTR pFrom = m_fos.pFrom;
-	if (pFrom)
+	DWORD const dwStart = GetTickCount();
+	StartWorkers();
+	try
 	{
-		int nItem = 0;
-		while (!m_bCancel && *pFrom)
+		LPCWSTR pFrom = m_fos.pFrom;
+		if (pFrom)
 		{
-			DeleteItem(pFrom);
-			Item(++nItem);
-			pFrom += lstrlenW(pFrom) + 1;
+			for (int nItem = 0; !m_bCancel && *pFrom; ++nItem)
+			{
+				DWORD const attr = GetFileAttributesW(pFrom);
+				if (attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY))
+				{
+					Drain();
+					ItemDone(nItem, DeleteItem(m_self, pFrom));
+				}
+				else
+				{
+					Enqueue(pFrom, NULL, 0, nItem);
+				}
+				pFrom += lstrlenW(pFrom) + 1;
+			}
 		}
 	}
+	catch (OException *)
+	{
+		StopWorkers();
+		throw;
+	}
+	StopWorkers();
+	LogThroughput(_T("Deleted"), GetTickCount() - dwStart);
 	if (!m_bCancel)
 		PostMessage(WM_COMMAND);
 	return 0;
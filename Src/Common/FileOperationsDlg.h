@@ -20,14 +20,52 @@
  */
 #pragma once
 
+/**
+ * @brief Dialog which copies, moves, or deletes files without the shell.
+ * A dispatcher thread walks the items in order, and hands the copying and
+ * deleting of individual files through a bounded queue to worker threads,
+ * so that reading folders overlaps with transferring file contents, and
+ * several transfers overlap with each other. Items which have been done
+ * successfully are reported to the sink, if any, along with progress.
+ */
 class FileOperationsDlg : public ODialog
 {
 public:
-	explicit FileOperationsDlg(SHFILEOPSTRUCT &);
+	FileOperationsDlg(SHFILEOPSTRUCT &, ShellFileOperations::Sink * = NULL);
 	~FileOperationsDlg();
 
 private:
+	/** @brief Upper bound for number of worker threads. */
+	static const int MaxWorkers = 4;
+	/** @brief Number of jobs which can wait for a worker. */
+	static const int QueueSize = 256;
+	/** @brief Files of at least this size are copied without buffering. */
+	static const DWORD NoBufferingMinSize = 8 * 1024 * 1024;
+
+	/** @brief Copying or deleting of a single file. */
+	struct Job
+	{
+		String src;
+		String dst; /**< Empty for deleting */
+		DWORD dwCopyFlags;
+		int nItem; /**< Index of the item, or -1 if the job is part of one */
+	};
+
+	/** @brief State of a thread which does file operations. */
+	struct Worker : ZeroInit<Worker>
+	{
+		FileOperationsDlg *pDlg;
+		HANDLE hThread;
+		BSTR path; /**< Scratch path for clearing targets */
+		UINT64 nBytes; /**< Bytes transferred */
+		DWORD ThreadProc() { return pDlg->WorkerThread(*this); }
+	};
+
 	SHFILEOPSTRUCT &m_fos;
+	ShellFileOperations::Sink *const m_pSink;
+	bool m_bReporting; // whether the sink is busy with a batch
+	int m_nDeferredCommand; // command to repeat when done with the batch
+	LONG volatile m_nFailures; // failed or declined operations so far
 	int m_count;
 	String m_strPauseContinue;
 	BOOL m_bContinue;
@@ -49,6 +87,18 @@ private:
 	DWORD const m_dwCopyFlags;
 	BSTR m_src;
 	BSTR m_dst;
+	Worker m_self; /**< State of the dispatcher thread */
+	Worker m_workers[MaxWorkers];
+	int m_nWorkers;
+	Job m_queue[QueueSize]; /**< Ring buffer of jobs */
+	int m_nHead; /**< Next job to take */
+	int m_nQueued; /**< Jobs in the ring buffer */
+	int m_nPending; /**< Jobs queued or in progress */
+	CRITICAL_SECTION m_csQueue; /**< Guards the queue */
+	CRITICAL_SECTION m_csPrompt; /**< Lets one thread at a time ask the user */
+	HANDLE m_hSlots; /**< Counts free queue entries */
+	HANDLE m_hJobs; /**< Counts queued jobs */
+	HANDLE m_hIdle; /**< Set while no jobs are pending */
 
 	class Progress
 		: ZeroInit<Progress>
@@ -65,6 +115,7 @@ private:
 		String dst;
 		String rem;
 		int Item;
+		std::vector<int> Done; /**< Items done but not yet reported */
 		LARGE_INTEGER TotalFileSize;
 		LARGE_INTEGER TotalBytesTransferred;
 	} m_progress;
@@ -89,23 +140,33 @@ private:
 	virtual LRESULT WindowProc(UINT, WPARAM, LPARAM);
 	void SetContinue(BOOL);
 	void UpdateProgress();
+	void ReportDone();
+	void Fail();
 	int Invoke(CMessageBoxDialog &);
 	BOOL WantRetry(int &, UINT, LPCWSTR, LPCWSTR);
 	BOOL WantTrash(int &, UINT, LPCWSTR, LPCWSTR);
 	static LPWSTR AssignPath(BSTR &, LPCWSTR);
 	LPVOID ClearTarget(LPCWSTR, LPWSTR);
-	void MoveItem(LPCWSTR, LPCWSTR);
-	void CopyLeaf(LPCWSTR, LPCWSTR);
+	bool MoveItem(LPCWSTR, LPCWSTR);
+	bool CopyLeaf(Worker &, LPCWSTR, LPCWSTR, DWORD);
 	void CopyTree(LPWSTR, LPWSTR);
-	void DeleteItem(LPCWSTR);
-	void Item(int);
+	bool DeleteItem(Worker &, LPCWSTR);
+	DWORD GetCopyFlags(DWORD nFileSizeHigh, DWORD nFileSizeLow) const;
+	void StartWorkers();
+	void StopWorkers();
+	void Enqueue(LPCWSTR, LPCWSTR, DWORD, int);
+	void Drain();
+	void RunJob(Worker &, const Job &);
+	void ItemDone(int, bool);
 	void FromTo(LPCWSTR, LPCWSTR);
 	void Removing(LPCWSTR);
 	LPCWSTR ToWhere(LPCWSTR, LPCWSTR);
 	static DWORD WINAPI ProgressRoutine(LARGE_INTEGER, LARGE_INTEGER,
 		LARGE_INTEGER, LARGE_INTEGER, DWORD, DWORD, HANDLE, HANDLE, LPVOID)
 		throw();
+	void LogThroughput(LPCTSTR, DWORD) const;
 	DWORD MoveThread();
 	DWORD CopyThread();
 	DWORD DeleteThread();
+	DWORD WorkerThread(Worker &);
 };
@@ -4535,6 +4535,7 @@ namespace H2O
 		NMLVDISPINFO LVDISPINFO;
 		NMLVKEYDOWN LVKEYDOWN;
 		NMLVCUSTOMDRAW LVCUSTOMDRAW;
+		NMLVFINDITEM LVFINDITEM;
 		NMCOMBOBOXEX COMBOBOXEX;
 		NMCBEDRAGBEGIN CBEDRAGBEGIN;
 		NMHEADER HEADER;
@@ -31,6 +31,12 @@ CLogFile::CLogFile()
 	, m_bEnabled(FALSE)
 	, m_nDefaultLevel(LMSG)
 	, m_nMaskLevel(LALL)
+	, m_dwTlsIndex(TlsAlloc())
+	, m_pRings(NULL)
+	, m_hWriterThread(NULL)
+	, m_hWake(CreateEvent(NULL, FALSE, FALSE, NULL))
+	, m_bStopping(false)
+	, m_pFile(NULL)
 {
 	m_hLogMutex = CreateMutex(NULL, FALSE, MutexName);
 }
@@ -41,6 +47,16 @@ CLogFile::CLogFile()
 CLogFile::~CLogFile()
 {
 	EnableLogging(FALSE);
+	StopWriter();
+	while (Ring *pRing = m_pRings)
+	{
+		m_pRings = pRing->m_pNext;
+		if (pRing->m_hThread)
+			CloseHandle(pRing->m_hThread);
+		delete pRing;
+	}
+	TlsFree(m_dwTlsIndex);
+	CloseHandle(m_hWake);
 	CloseHandle(m_hLogMutex);
 }
 
@@ -72,6 +88,7 @@ void CLogFile::EnableLogging(BOOL bEnable)
 
 	if (bEnable)
 	{
+		StartWriter();
 		m_bEnabled = TRUE;
 		Write(0, _T("\n*******\nLog Started: %s"), s);
 		Write(0, _T("Path: %s\n*******\n"), m_strLogPath.c_str());
@@ -81,6 +98,212 @@ void CLogFile::EnableLogging(BOOL bEnable)
 		m_bEnabled = FALSE;
 		Write(0, _T("\n*******\nLog Stopped: %s\n"), s);
 		Write(0, _T("*******\n"));
+		// Get pending messages out before returning
+		StopWriter();
+	}
+}
+
+/**
+ * @brief Start the thread which drains the rings into the log file.
+ */
+void CLogFile::StartWriter()
+{
+	if (m_hWriterThread == NULL)
+	{
+		m_bStopping = false;
+		m_hWriterThread = BeginThreadEx(NULL, 0,
+			OException::ThreadProc<CLogFile, &CLogFile::WriterThread>,
+			this, 0, NULL);
+	}
+}
+
+/**
+ * @brief Stop the writer thread after it has drained the rings.
+ */
+void CLogFile::StopWriter()
+{
+	if (HANDLE hThread = m_hWriterThread)
+	{
+		m_bStopping = true;
+		SetEvent(m_hWake);
+		WaitForSingleObject(hThread, INFINITE);
+		CloseHandle(hThread);
+		m_hWriterThread = NULL;
+	}
+}
+
+/**
+ * @brief Writer thread function.
+ * Drains the rings whenever a producer runs short of space, and otherwise
+ * at regular intervals.
+ */
+DWORD CLogFile::WriterThread()
+{
+	do
+	{
+		WaitForSingleObject(m_hWake, DRAIN_INTERVAL);
+		Drain();
+	} while (!m_bStopping);
+	// Catch what came in while draining the last time
+	Drain();
+	if (m_pFile)
+	{
+		fclose(m_pFile);
+		m_pFile = NULL;
+	}
+	return 0;
+}
+
+/**
+ * @brief Return the calling thread's ring, claiming one if necessary.
+ * Rings of threads which have exited are reused once they are drained.
+ */
+CLogFile::Ring *CLogFile::GetRing()
+{
+	Ring *pRing = static_cast<Ring *>(TlsGetValue(m_dwTlsIndex));
+	if (pRing == NULL)
+	{
+		LONG const nThreadId = static_cast<LONG>(GetCurrentThreadId());
+		pRing = m_pRings;
+		while (pRing && InterlockedCompareExchange(&pRing->m_nOwner, nThreadId, 0) != 0)
+			pRing = pRing->m_pNext;
+		if (pRing == NULL)
+		{
+			pRing = new Ring;
+			pRing->m_nOwner = nThreadId;
+			pRing->m_nHead = 0;
+			pRing->m_nTail = 0;
+			pRing->m_nWrite = 0;
+			Ring *pNext;
+			do
+			{
+				pRing->m_pNext = pNext = m_pRings;
+			} while (InterlockedCompareExchangePointer(
+				reinterpret_cast<PVOID volatile *>(&m_pRings), pRing, pNext) != pNext);
+		}
+		pRing->m_nWrite = pRing->m_nHead;
+		if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(),
+			GetCurrentProcess(), &pRing->m_hThread, SYNCHRONIZE, FALSE, 0))
+		{
+			pRing->m_hThread = NULL;
+		}
+		TlsSetValue(m_dwTlsIndex, pRing);
+	}
+	return pRing;
+}
+
+/**
+ * @brief Make room in a ring for a whole record.
+ * Waits for the writer thread to drain the ring as far as needed, so that
+ * records are neither cut short nor published in parts. A record which does
+ * not fit into the ring at all has to take the slow path, but only after
+ * the ring has run empty, so that records stay in order.
+ * @param [in] pRing The calling thread's ring.
+ * @param [in] len Number of characters in the record.
+ * @return false if the record has to take the slow path.
+ */
+bool CLogFile::Reserve(Ring *pRing, size_t len)
+{
+	while (m_hWriterThread)
+	{
+		LONG const nUsed = pRing->m_nWrite - pRing->m_nTail;
+		if (len > RING_SIZE)
+		{
+			if (nUsed == 0)
+				break;
+		}
+		else if (static_cast<size_t>(RING_SIZE - nUsed) >= len)
+		{
+			return true;
+		}
+		SetEvent(m_hWake);
+		Sleep(1);
+	}
+	return false;
+}
+
+/**
+ * @brief Append text to a ring without publishing it yet.
+ * Caller must have reserved room for the text.
+ * @param [in] pRing The calling thread's ring.
+ * @param [in] text Text to append.
+ * @param [in] len Number of characters to append.
+ */
+void CLogFile::Post(Ring *pRing, LPCTSTR text, size_t len)
+{
+	LONG const nWrite = pRing->m_nWrite;
+	LONG const nPos = nWrite & (RING_SIZE - 1);
+	LONG const nChunk = min(static_cast<LONG>(len), RING_SIZE - nPos);
+	memcpy(pRing->m_buffer + nPos, text, nChunk * sizeof(TCHAR));
+	memcpy(pRing->m_buffer, text + nChunk, (len - nChunk) * sizeof(TCHAR));
+	pRing->m_nWrite = nWrite + static_cast<LONG>(len);
+}
+
+/**
+ * @brief Hand what has been appended to a ring over to the writer thread.
+ */
+void CLogFile::Publish(Ring *pRing)
+{
+	InterlockedExchange(&pRing->m_nHead, pRing->m_nWrite);
+}
+
+/**
+ * @brief Move everything the rings hold into the log file.
+ * The file is kept open as long as messages keep coming in.
+ */
+void CLogFile::Drain()
+{
+	String batch;
+	for (Ring *pRing = m_pRings; pRing; pRing = pRing->m_pNext)
+	{
+		LONG const nHead = pRing->m_nHead;
+		LONG const nTail = pRing->m_nTail;
+		if (nHead != nTail)
+		{
+			LONG const nPos = nTail & (RING_SIZE - 1);
+			LONG const nChunk = min(nHead - nTail, RING_SIZE - nPos);
+			batch.append(pRing->m_buffer + nPos, nChunk);
+			batch.append(pRing->m_buffer, nHead - nTail - nChunk);
+			InterlockedExchange(&pRing->m_nTail, nHead);
+		}
+		else if (pRing->m_hThread && WaitForSingleObject(pRing->m_hThread, 0) == WAIT_OBJECT_0)
+		{
+			// Owning thread has exited, so set the ring free for reuse
+			CloseHandle(pRing->m_hThread);
+			pRing->m_hThread = NULL;
+			InterlockedExchange(&pRing->m_nOwner, 0);
+		}
+	}
+	if (batch.empty())
+	{
+		// Quiet for now, so let others at the file
+		if (m_pFile)
+		{
+			fclose(m_pFile);
+			m_pFile = NULL;
+		}
+		return;
+	}
+	DWORD dwWaitRes = WaitForSingleObject(m_hLogMutex, 10000);
+	if (dwWaitRes == WAIT_OBJECT_0)
+	{
+		if (m_pFile == NULL)
+			m_pFile = _tfopen(m_strLogPath.c_str(), _T("a"));
+		if (FILE *f = m_pFile)
+		{
+			_fputts(batch.c_str(), f);
+			// prune the log if it gets too big
+			if (ftell(f) >= static_cast<long>(m_nMaxSize))
+			{
+				Prune(f);
+				m_pFile = NULL;
+			}
+			else
+			{
+				fflush(f);
+			}
+		}
+		ReleaseMutex(m_hLogMutex);
 	}
 }
 
@@ -136,14 +359,49 @@ UINT CLogFile::Write(UINT level, LPCTSTR text)
 			level = m_nDefaultLevel;
 		if (level & m_nMaskLevel)
 		{
-			String msg = GetPrefix(level);
-			msg += text;
+			LPCTSTR const prefix = GetPrefix(level);
+			String error;
 			if (level & LOSERROR)
-				msg += GetSysError(GetLastError());
+				error = GetSysError(GetLastError());
+			else
+			{
+				// Trailing line breaks are replaced with a single one
+				size_t len = _tcslen(text);
+				while (len != 0 && (text[len - 1] == _T('\r') || text[len - 1] == _T('\n')))
+					--len;
+				if ((m_nMaskLevel & (LFILE | LDEBUG)) == LFILE && m_hWriterThread)
+				{
+					// Spare the common case a heap allocation
+					Ring *const pRing = GetRing();
+					size_t const prefixlen = _tcslen(prefix);
+					if (Reserve(pRing, prefixlen + len + 1))
+					{
+						Post(pRing, prefix, prefixlen);
+						Post(pRing, text, len);
+						Post(pRing, _T("\n"), 1);
+						Publish(pRing);
+						return m_nMaskLevel & LSILENTVERIFY;
+					}
+				}
+			}
+			String msg = prefix;
+			msg += text;
+			msg += error;
 			msg.erase(msg.find_last_not_of(_T("\r\n")) + 1);
 			msg += _T("\n");
 			if (m_nMaskLevel & LFILE)
-				WriteRaw(msg.c_str());
+			{
+				Ring *pRing;
+				if (m_hWriterThread && Reserve(pRing = GetRing(), msg.length()))
+				{
+					Post(pRing, msg.c_str(), msg.length());
+					Publish(pRing);
+				}
+				else
+				{
+					WriteRaw(msg.c_str());
+				}
+			}
 			if (m_nMaskLevel & LDEBUG)
 				OutputDebugString(msg.c_str());
 		}
@@ -22,6 +22,11 @@
  * Written messages are given using printf() -style messageformat specifiers.
  * See MSDN documentation about printf() function for more information.
  *
+ * Messages headed for the file are not written by the calling thread. Each
+ * thread appends its messages to a ring buffer of its own, and a background
+ * thread drains the ring buffers into the file in batches. Messages from
+ * different threads may therefore appear slightly out of order.
+ *
  * @note User can easily define more levels, just add new constant to
  * struct LOGLEVEL above, and possibly prefix to GetPrefix(UINT level).
  */
@@ -69,10 +74,24 @@ public:
 			{
 				va_list args;
 				va_start(args, fmt);
-				String s;
-				s.append_sprintf_va_list(fmt, args);
-				Write(level, s.c_str());
+				// Format into a stack buffer unless the message is too long
+				TCHAR buf[1024];
+				int const len = _vsntprintf(buf, _countof(buf), fmt, args);
 				va_end(args);
+				if (len >= 0 && len < static_cast<int>(_countof(buf)))
+				{
+					buf[len] = _T('\0');
+					Write(level, buf);
+				}
+				else
+				{
+					// The first pass has used up the arguments, so start over
+					String s;
+					va_start(args, fmt);
+					s.append_sprintf_va_list(fmt, args);
+					va_end(args);
+					Write(level, s.c_str());
+				}
 			}
 		}
 		return m_nMaskLevel & LSILENTVERIFY;
@@ -90,7 +109,42 @@ private:
 	CLogFile(const CLogFile &); // disallow copy construction
 	CLogFile &operator=(const CLogFile &); // disallow assignment
 
+	/** @brief Capacity of a ring buffer in characters (power of two). */
+	static const LONG RING_SIZE = 16 * 1024;
+	/** @brief Milliseconds the writer thread waits before draining anyway. */
+	static const DWORD DRAIN_INTERVAL = 200;
+
+	/**
+	 * @brief Single-producer single-consumer buffer of pending output.
+	 * The owning thread advances m_nHead, the writer thread m_nTail.
+	 */
+	struct Ring
+	{
+		Ring *m_pNext; /**< Next ring in list (never unlinked) */
+		LONG volatile m_nOwner; /**< Id of owning thread, or 0 if free */
+		HANDLE m_hThread; /**< Handle of owning thread */
+		LONG volatile m_nHead; /**< Count of characters ever published */
+		LONG volatile m_nTail; /**< Count of characters ever drained */
+		LONG m_nWrite; /**< Count of characters ever written */
+		TCHAR m_buffer[RING_SIZE];
+	};
+
+	void StartWriter();
+	void StopWriter();
+	Ring *GetRing();
+	bool Reserve(Ring *, size_t);
+	static void Post(Ring *, LPCTSTR, size_t);
+	static void Publish(Ring *);
+	void Drain();
+	DWORD WriterThread();
+
 	HANDLE    m_hLogMutex; /**< Mutex protecting log writing */
+	DWORD     m_dwTlsIndex; /**< TLS slot holding calling thread's ring */
+	Ring *volatile m_pRings; /**< List of all rings */
+	HANDLE    m_hWriterThread; /**< Thread draining the rings */
+	HANDLE    m_hWake; /**< Event waking up the writer thread */
+	bool volatile m_bStopping; /**< Writer thread is asked to quit */
+	FILE     *m_pFile; /**< Log file while kept open by writer thread */
 	DWORD     m_nMaxSize; /**< Max size of the log file */
 	BOOL      m_bEnabled; /**< Is logging enabled? */
 	String    m_strLogPath; /**< Full path to log file */
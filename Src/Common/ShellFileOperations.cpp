@@ -50,7 +50,7 @@ bool ShellFileOperations::Run()
 	{
 		if (dwFlags & UseLowLevelFunctions)
 		{
-			FileOperationsDlg dlg(*this);
+			FileOperationsDlg dlg(*this, pSink);
 			result = LanguageSelect.DoModal(dlg, hwnd);
 		}
 		else
@@ -32,11 +32,28 @@ class ShellFileOperations
 public:
 	static const DWORD UseLowLevelFunctions = 0x10000;
 
+	/**
+	 * @brief Learns which items have been done while the operation runs.
+	 * Items come in batches on the thread which called Run(). Only the low
+	 * level functions report items this way.
+	 */
+	class Sink
+	{
+	public:
+		virtual void ItemDone(int nItem) = 0;
+		virtual void BatchDone() = 0;
+	};
+
 	ShellFileOperations(HWND, UINT, DWORD, size_t fromMax, size_t toMax);
 	~ShellFileOperations();
 
 	bool Run();
 
+	void SetSink(Sink *sink)
+	{
+		pSink = sink;
+	}
+
 	void AddSource(LPCTSTR source)
 	{
 		pFrom = AddPath(pFrom, source);
@@ -51,4 +68,5 @@ private:
 	DWORD const dwFlags;
 	TCHAR *pFrom;
 	TCHAR *pTo;
+	Sink *pSink;
 };
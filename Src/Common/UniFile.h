@@ -130,6 +130,11 @@ public:
 	virtual void ReadBom();
 	virtual bool ReadString(String &line, String &eol, bool *lossy);
 
+	/** @brief Raw bytes of the file, or NULL if the file is empty. */
+	const BYTE *GetBase() const { return m_base; }
+	/** @brief Size of the file in bytes. */
+	size_t GetSize() const { return static_cast<size_t>(m_filesize.int64); }
+
 // Implementation methods
 protected:
 	bool DoOpen(LPCTSTR filename, DWORD dwOpenAccess, DWORD dwOpenShareMode, DWORD dwOpenCreationDispostion, DWORD dwMappingProtect, DWORD dwMapViewAccess);
@@ -25,15 +25,62 @@
 // TortoiseMerge - a Diff/Patch program
 // Copyright (C) 2007 - TortoiseSVN
 
+/** @brief A machine word with the high bit of each byte set. */
+static const UINT_PTR HighBits = ~static_cast<UINT_PTR>(0) / 0xFF * 0x80;
+
 /**
  * @brief Check for invalid UTF-8 bytes in buffer.
  * This function checks if there are invalid UTF-8 bytes in the given buffer.
  * If such bytes are found, caller knows this buffer is not valid UTF-8 file.
+ * The buffer is read once, and runs of ASCII a machine word at a time.
  * @param [in] pBuffer Pointer to begin of the buffer.
  * @param [in] size Size of the buffer in bytes.
  * @return true if invalid bytes found, false otherwise.
  */
 bool CheckForInvalidUtf8(LPBYTE pBuffer, size_t size)
+{
+	const UINT8 *const q = pBuffer + size;
+	const UINT8 *p = pBuffer;
+	bool bUTF8 = false;
+	while (p < q)
+	{
+		if ((reinterpret_cast<UINT_PTR>(p) & (sizeof(UINT_PTR) - 1)) == 0)
+		{
+			while (static_cast<size_t>(q - p) >= sizeof(UINT_PTR) &&
+				(*reinterpret_cast<const UINT_PTR *>(p) & HighBits) == 0)
+			{
+				p += sizeof(UINT_PTR);
+			}
+			if (p == q)
+				break;
+		}
+		UINT8 c = *p++;
+		if ((c & 0x80) != 0x00)
+		{
+			// Neither trail bytes nor 0xC0, 0xC1, or anything from 0xF5 on
+			// can start a sequence. The latter are invalid even as trail
+			// bytes, so they need not be checked for anywhere else.
+			if (c < 0xC2 || c >= 0xF5)
+				return true;
+			int n = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+			do
+			{
+				// A sequence which is cut off at the end of buffer is fine
+				if (p == q)
+					return !bUTF8;
+				if ((*p++ & 0xC0) != 0x80)
+					return true;
+			} while (--n);
+			bUTF8 = true;
+		}
+	}
+	return !bUTF8;
+}
+
+/**
+ * @brief The former implementation, which reads the buffer twice.
+ */
+static bool ScalarCheckForInvalidUtf8(LPBYTE pBuffer, size_t size)
 {
 	const UINT8 *const q = pBuffer + size;
 	const UINT8 *p = q;
@@ -74,3 +121,59 @@ bool CheckForInvalidUtf8(LPBYTE pBuffer, size_t size)
 	}
 	return !bUTF8;
 }
+
+TESTCASE
+{
+	static const BYTE Bytes[] =
+	{
+		'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 0x00, 0x7F, 0x80, 0xBF,
+		0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF
+	};
+	BYTE buffer[64];
+	unsigned seed = 1;
+	for (int i = 0; i < 100000; ++i)
+	{
+		size_t const offset = i % 8;
+		size_t const size = i % (sizeof buffer - offset);
+		for (size_t j = offset; j < offset + size; ++j)
+		{
+			seed = seed * 1103515245 + 12345;
+			buffer[j] = Bytes[(seed >> 16) % _countof(Bytes)];
+		}
+		assert(CheckForInvalidUtf8(buffer + offset, size) ==
+			ScalarCheckForInvalidUtf8(buffer + offset, size));
+	}
+	// Mostly ASCII text, long enough to take the bulk path
+	std::vector<BYTE> text(64 << 10, 'a');
+	for (size_t j = 0; j + 2 < text.size(); j += 1000)
+	{
+		text[j] = 0xC3;
+		text[j + 1] = 0xA4;
+	}
+	assert(!CheckForInvalidUtf8(&text.front(), text.size()));
+	assert(!ScalarCheckForInvalidUtf8(&text.front(), text.size()));
+	return 0;
+}
+
+BENCHMARK
+{
+	// Throughput on mostly ASCII text
+	std::vector<BYTE> text(16 << 20, 'a');
+	for (size_t j = 0; j + 2 < text.size(); j += 1000)
+	{
+		text[j] = 0xC3;
+		text[j + 1] = 0xA4;
+	}
+	LARGE_INTEGER freq, t0, t1, t2;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&t0);
+	bool const bInvalid = CheckForInvalidUtf8(&text.front(), text.size());
+	QueryPerformanceCounter(&t1);
+	bool const bScalarInvalid = ScalarCheckForInvalidUtf8(&text.front(), text.size());
+	QueryPerformanceCounter(&t2);
+	assert(!bInvalid && !bScalarInvalid);
+	TRACE("CheckForInvalidUtf8: %u MB/s, scalar: %u MB/s\n",
+		static_cast<UINT>(16 * freq.QuadPart / max<LONGLONG>(t1.QuadPart - t0.QuadPart, 1)),
+		static_cast<UINT>(16 * freq.QuadPart / max<LONGLONG>(t2.QuadPart - t1.QuadPart, 1)));
+	return 0;
+}
@@ -11,2440 +11,2568 @@ BOOL CommonKeywords::IsNumeric(LPCTSTR pszChars, int nLength)
 	return _istdigit(pszChars[nLength > 1 && *pszChars == '.']);
 }
 
-BOOL HtmlKeywords::IsHtmlTagName(LPCTSTR pszChars, int nLength)
+/**
+ * @brief Build the hash index by the hash, displace, and compress method.
+ * @note Falls back to binary search in the keyword list should the keywords
+ * turn out to not be distinct, or to contain non-ASCII characters.
+ */
+KeywordHashBase::KeywordHashBase(LPCTSTR const *lower, LPCTSTR const *upper, bool fold)
+	: m_lower(lower), m_upper(upper), m_fold(fold)
+{
+	UINT const n = static_cast<UINT>(upper - lower);
+	if (n == 0)
+		return;
+	std::vector<Slot> keys(n);
+	std::vector<UINT> h2(n);
+	std::vector<std::vector<UINT> > buckets(n);
+	UINT maxBucketSize = 0;
+	UINT i;
+	for (i = 0; i < n; ++i)
+	{
+		Slot &key = keys[i];
+		key.key = lower[i];
+		// Keywords may be followed by control characters to convey flags
+		key.len = 0;
+		while (static_cast<UINT>(key.key[key.len]) >= 0x20)
+			++key.len;
+		key.value = key.key[key.len] ? key.key[key.len] : TRUE;
+		UINT h1;
+		if (!Hash(key.key, key.len, fold, h1, h2[i]))
+			return;
+		std::vector<UINT> &bucket = buckets[h1 % n];
+		bucket.push_back(i);
+		if (maxBucketSize < bucket.size())
+			maxBucketSize = static_cast<UINT>(bucket.size());
+	}
+	m_displace.resize(n);
+	Slot const unused = { NULL, UINT_MAX, FALSE };
+	m_slots.resize(n, unused);
+	// Find a displacement for each bucket with colliding keywords, largest first
+	std::vector<UINT> slots;
+	for (UINT size = maxBucketSize; size > 1; --size)
+	{
+		for (UINT b = 0; b < n; ++b)
+		{
+			std::vector<UINT> const &bucket = buckets[b];
+			if (bucket.size() != size)
+				continue;
+			int d = 0;
+			do
+			{
+				if (++d > 0xFFFF)
+				{
+					// Keywords are not distinct, so give up
+					m_displace.clear();
+					m_slots.clear();
+					return;
+				}
+				slots.clear();
+				for (i = 0; i < size; ++i)
+				{
+					UINT const slot = Mix(h2[bucket[i]], d) % n;
+					if (m_slots[slot].key || std::find(slots.begin(), slots.end(), slot) != slots.end())
+						break;
+					slots.push_back(slot);
+				}
+			} while (i < size);
+			m_displace[b] = d;
+			for (i = 0; i < size; ++i)
+				m_slots[slots[i]] = keys[bucket[i]];
+		}
+	}
+	// Assign the remaining slots directly to buckets with a single keyword
+	UINT slot = 0;
+	for (UINT b = 0; b < n; ++b)
+	{
+		std::vector<UINT> const &bucket = buckets[b];
+		if (bucket.size() != 1)
+			continue;
+		while (m_slots[slot].key)
+			++slot;
+		m_displace[b] = ~static_cast<int>(slot);
+		m_slots[slot] = keys[bucket.front()];
+	}
+}
+
+TESTCASE
 {
-	static LPCTSTR const s_apszHtmlKeywordList[] =
+	static LPCTSTR const s_apszKeywordList[] =
 	{
-		_T("A"),
 		_T("ABBR"),
 		_T("ACRONYM") HTML4_LEXIS_ONLY,
-		_T("ADDRESS"),
-		_T("APPLET") HTML4_LEXIS_ONLY,
-		_T("AREA"),
 		_T("ARTICLE") HTML5_LEXIS_ONLY,
-		_T("ASIDE") HTML5_LEXIS_ONLY,
-		_T("AUDIO") HTML5_LEXIS_ONLY,
 		_T("B"),
 		_T("BASE"),
-		_T("BASEFONT"),
-		_T("BDI") HTML5_LEXIS_ONLY,
-		_T("BDO"),
-		_T("BIG") HTML4_LEXIS_ONLY,
-		_T("BLOCKQUOTE"),
-		_T("BODY"),
-		_T("BR"),
-		_T("BUTTON"),
-		_T("CANVAS") HTML5_LEXIS_ONLY,
-		_T("CAPTION"),
-		_T("CENTER") HTML4_LEXIS_ONLY,
-		_T("CITE"),
-		_T("CODE"),
-		_T("COL"),
-		_T("COLGROUP"),
-		_T("DATA") HTML5_LEXIS_ONLY,
-		_T("DATALIST") HTML5_LEXIS_ONLY,
-		_T("DD"),
-		_T("DEL"),
-		_T("DETAILS") HTML5_LEXIS_ONLY,
-		_T("DFN"),
-		_T("DIALOG") HTML5_LEXIS_ONLY,
-		_T("DIR") HTML4_LEXIS_ONLY,
-		_T("DIV"),
-		_T("DL"),
-		_T("DT"),
-		_T("EM"),
-		_T("FIELDSET"),
-		_T("FIGCAPTION") HTML5_LEXIS_ONLY,
-		_T("FIGURE") HTML5_LEXIS_ONLY,
-		_T("FONT") HTML4_LEXIS_ONLY,
-		_T("FOOTER") HTML5_LEXIS_ONLY,
-		_T("FORM"),
-		_T("FRAME") HTML4_LEXIS_ONLY,
-		_T("FRAMESET") HTML4_LEXIS_ONLY,
-		_T("H1"),
-		_T("H2"),
-		_T("H3"),
-		_T("H4"),
-		_T("H5"),
-		_T("H6"),
-		_T("HEAD"),
-		_T("HEADER") HTML5_LEXIS_ONLY,
-		_T("HR"),
-		_T("HTML"),
-		_T("I"),
-		_T("IFRAME"),
-		_T("IMG"),
-		_T("INPUT"),
-		_T("INS"),
-		_T("ISINDEX"),
-		_T("KBD"),
-		_T("LABEL"),
-		_T("LEGEND"),
-		_T("LI"),
-		_T("LINK"),
-		_T("MAIN") HTML5_LEXIS_ONLY,
-		_T("MAP"),
-		_T("MARK") HTML5_LEXIS_ONLY,
-		_T("MENU"),
-		_T("MENUITEM") HTML5_LEXIS_ONLY,
-		_T("META"),
-		_T("METER") HTML5_LEXIS_ONLY,
-		_T("NAV") HTML5_LEXIS_ONLY,
-		_T("NOFRAMES"),
-		_T("NOSCRIPT"),
-		_T("OBJECT"),
-		_T("OL"),
-		_T("OPTGROUP"),
-		_T("OPTION"),
-		_T("OUTPUT") HTML5_LEXIS_ONLY,
-		_T("P"),
-		_T("PARAM"),
-		_T("PICTURE") HTML5_LEXIS_ONLY,
-		_T("PRE"),
-		_T("PROGRESS") HTML5_LEXIS_ONLY,
-		_T("PUBLIC"),
-		_T("Q"),
-		_T("RP") HTML5_LEXIS_ONLY,
-		_T("RT") HTML5_LEXIS_ONLY,
-		_T("RUBY") HTML5_LEXIS_ONLY,
-		_T("S"),
-		_T("SAMP"),
-		_T("SCRIPT"),
-		_T("SECTION") HTML5_LEXIS_ONLY,
-		_T("SELECT"),
-		_T("SMALL"),
-		_T("SOURCE") HTML5_LEXIS_ONLY,
-		_T("SPAN"),
-		_T("STRIKE") HTML4_LEXIS_ONLY,
-		_T("STRONG"),
-		_T("STYLE"),
-		_T("SUB"),
-		_T("SUMMARY") HTML5_LEXIS_ONLY,
-		_T("SUP"),
-		_T("TABLE"),
-		_T("TBODY"),
-		_T("TD"),
-		_T("TEMPLATE") HTML5_LEXIS_ONLY,
-		_T("TEXTAREA"),
-		_T("TFOOT"),
-		_T("TH"),
-		_T("THEAD"),
-		_T("TIME") HTML5_LEXIS_ONLY,
-		_T("TITLE"),
-		_T("TR"),
-		_T("TRACK") HTML5_LEXIS_ONLY,
-		_T("TT") HTML4_LEXIS_ONLY,
-		_T("U"),
-		_T("UL"),
-		_T("VAR"),
-		_T("VIDEO") HTML5_LEXIS_ONLY,
-		_T("WBR") HTML5_LEXIS_ONLY,
 	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszHtmlKeywordList);
+	KeywordHash<_tcsnicmp> const hash(s_apszKeywordList);
+	LPCTSTR const keys[] =
+	{
+		_T("abbr"), _T("Acronym"), _T("ARTICLE"), _T("b"), _T("Base"),
+		_T("ab"), _T("abbrev"), _T("bases"), _T("article2"), _T("\xE4") _T("bbr")
+	};
+	int count = 0;
+	for (size_t i = 0; i < _countof(keys); ++i)
+	{
+		LPCTSTR const key = keys[i];
+		UINT const len = static_cast<UINT>(_tcslen(key));
+		BOOL const value = xiskeyword<_tcsnicmp>(key, len, s_apszKeywordList);
+		assert(hash.Find(key, len) == value);
+		if (value)
+			++count;
+	}
+	assert(count == 5);
+	return count;
+}
+
+static LPCTSTR const s_apszHtmlKeywordList[] =
+{
+	_T("A"),
+	_T("ABBR"),
+	_T("ACRONYM") HTML4_LEXIS_ONLY,
+	_T("ADDRESS"),
+	_T("APPLET") HTML4_LEXIS_ONLY,
+	_T("AREA"),
+	_T("ARTICLE") HTML5_LEXIS_ONLY,
+	_T("ASIDE") HTML5_LEXIS_ONLY,
+	_T("AUDIO") HTML5_LEXIS_ONLY,
+	_T("B"),
+	_T("BASE"),
+	_T("BASEFONT"),
+	_T("BDI") HTML5_LEXIS_ONLY,
+	_T("BDO"),
+	_T("BIG") HTML4_LEXIS_ONLY,
+	_T("BLOCKQUOTE"),
+	_T("BODY"),
+	_T("BR"),
+	_T("BUTTON"),
+	_T("CANVAS") HTML5_LEXIS_ONLY,
+	_T("CAPTION"),
+	_T("CENTER") HTML4_LEXIS_ONLY,
+	_T("CITE"),
+	_T("CODE"),
+	_T("COL"),
+	_T("COLGROUP"),
+	_T("DATA") HTML5_LEXIS_ONLY,
+	_T("DATALIST") HTML5_LEXIS_ONLY,
+	_T("DD"),
+	_T("DEL"),
+	_T("DETAILS") HTML5_LEXIS_ONLY,
+	_T("DFN"),
+	_T("DIALOG") HTML5_LEXIS_ONLY,
+	_T("DIR") HTML4_LEXIS_ONLY,
+	_T("DIV"),
+	_T("DL"),
+	_T("DT"),
+	_T("EM"),
+	_T("FIELDSET"),
+	_T("FIGCAPTION") HTML5_LEXIS_ONLY,
+	_T("FIGURE") HTML5_LEXIS_ONLY,
+	_T("FONT") HTML4_LEXIS_ONLY,
+	_T("FOOTER") HTML5_LEXIS_ONLY,
+	_T("FORM"),
+	_T("FRAME") HTML4_LEXIS_ONLY,
+	_T("FRAMESET") HTML4_LEXIS_ONLY,
+	_T("H1"),
+	_T("H2"),
+	_T("H3"),
+	_T("H4"),
+	_T("H5"),
+	_T("H6"),
+	_T("HEAD"),
+	_T("HEADER") HTML5_LEXIS_ONLY,
+	_T("HR"),
+	_T("HTML"),
+	_T("I"),
+	_T("IFRAME"),
+	_T("IMG"),
+	_T("INPUT"),
+	_T("INS"),
+	_T("ISINDEX"),
+	_T("KBD"),
+	_T("LABEL"),
+	_T("LEGEND"),
+	_T("LI"),
+	_T("LINK"),
+	_T("MAIN") HTML5_LEXIS_ONLY,
+	_T("MAP"),
+	_T("MARK") HTML5_LEXIS_ONLY,
+	_T("MENU"),
+	_T("MENUITEM") HTML5_LEXIS_ONLY,
+	_T("META"),
+	_T("METER") HTML5_LEXIS_ONLY,
+	_T("NAV") HTML5_LEXIS_ONLY,
+	_T("NOFRAMES"),
+	_T("NOSCRIPT"),
+	_T("OBJECT"),
+	_T("OL"),
+	_T("OPTGROUP"),
+	_T("OPTION"),
+	_T("OUTPUT") HTML5_LEXIS_ONLY,
+	_T("P"),
+	_T("PARAM"),
+	_T("PICTURE") HTML5_LEXIS_ONLY,
+	_T("PRE"),
+	_T("PROGRESS") HTML5_LEXIS_ONLY,
+	_T("PUBLIC"),
+	_T("Q"),
+	_T("RP") HTML5_LEXIS_ONLY,
+	_T("RT") HTML5_LEXIS_ONLY,
+	_T("RUBY") HTML5_LEXIS_ONLY,
+	_T("S"),
+	_T("SAMP"),
+	_T("SCRIPT"),
+	_T("SECTION") HTML5_LEXIS_ONLY,
+	_T("SELECT"),
+	_T("SMALL"),
+	_T("SOURCE") HTML5_LEXIS_ONLY,
+	_T("SPAN"),
+	_T("STRIKE") HTML4_LEXIS_ONLY,
+	_T("STRONG"),
+	_T("STYLE"),
+	_T("SUB"),
+	_T("SUMMARY") HTML5_LEXIS_ONLY,
+	_T("SUP"),
+	_T("TABLE"),
+	_T("TBODY"),
+	_T("TD"),
+	_T("TEMPLATE") HTML5_LEXIS_ONLY,
+	_T("TEXTAREA"),
+	_T("TFOOT"),
+	_T("TH"),
+	_T("THEAD"),
+	_T("TIME") HTML5_LEXIS_ONLY,
+	_T("TITLE"),
+	_T("TR"),
+	_T("TRACK") HTML5_LEXIS_ONLY,
+	_T("TT") HTML4_LEXIS_ONLY,
+	_T("U"),
+	_T("UL"),
+	_T("VAR"),
+	_T("VIDEO") HTML5_LEXIS_ONLY,
+	_T("WBR") HTML5_LEXIS_ONLY,
+};
+
+static KeywordHash<_tcsnicmp> const s_HtmlKeywordHash(s_apszHtmlKeywordList);
+
+BOOL HtmlKeywords::IsHtmlTagName(LPCTSTR pszChars, int nLength)
+{
+	return s_HtmlKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("ABBR"),
+	_T("ACCEPT"),
+	_T("ACCEPT-CHARSET"),
+	_T("ACCESSKEY"),
+	_T("ACTION"),
+	_T("ALIGN"),
+	_T("ALINK"),
+	_T("ALT"),
+	_T("ARCHIVE"),
+	_T("AXIS"),
+	_T("BACKGROUND"),
+	_T("BGCOLOR"),
+	_T("BORDER"),
+	_T("CELLPADDING"),
+	_T("CELLSPACING"),
+	_T("CHAR"),
+	_T("CHAROFF"),
+	_T("CHARSET"),
+	_T("CHECKED"),
+	_T("CITE"),
+	_T("CLASS"),
+	_T("CLASSID"),
+	_T("CLEAR"),
+	_T("CODE"),
+	_T("CODEBASE"),
+	_T("CODETYPE"),
+	_T("COLOR"),
+	_T("COLS"),
+	_T("COLSPAN"),
+	_T("COMPACT"),
+	_T("CONTENT"),
+	_T("COORDS"),
+	_T("DATA"),
+	_T("DATAFLD"),
+	_T("DATAFORMATAS"),
+	_T("DATASRC"),
+	_T("DATETIME"),
+	_T("DECLARE"),
+	_T("DEFER"),
+	_T("DIR"),
+	_T("DISABLED"),
+	_T("ENCTYPE"),
+	_T("EVENT"),
+	_T("FACE"),
+	_T("FOR"),
+	_T("FRAME"),
+	_T("FRAMEBORDER"),
+	_T("HEADERS"),
+	_T("HEIGHT"),
+	_T("HREF"),
+	_T("HREFLANG"),
+	_T("HSPACE"),
+	_T("HTTP-EQUIV"),
+	_T("ID"),
+	_T("ISMAP"),
+	_T("LABEL"),
+	_T("LANG"),
+	_T("LANGUAGE"),
+	_T("LINK"),
+	_T("LONGDESC"),
+	_T("MARGINHEIGHT"),
+	_T("MARGINWIDTH"),
+	_T("MAXLENGTH"),
+	_T("MEDIA"),
+	_T("METHOD"),
+	_T("MULTIPLE"),
+	_T("NAME"),
+	_T("NOHREF"),
+	_T("NORESIZE"),
+	_T("NOSHADE"),
+	_T("NOWRAP"),
+	_T("ONBLUR"),
+	_T("ONCHANGE"),
+	_T("ONCLICK"),
+	_T("ONDBLCLICK"),
+	_T("ONFOCUS"),
+	_T("ONKEYDOWN"),
+	_T("ONKEYPRESS"),
+	_T("ONKEYUP"),
+	_T("ONLOAD"),
+	_T("ONMOUSEDOWN"),
+	_T("ONMOUSEMOVE"),
+	_T("ONMOUSEOUT"),
+	_T("ONMOUSEOVER"),
+	_T("ONMOUSEUP"),
+	_T("ONRESET"),
+	_T("ONSELECT"),
+	_T("ONSUBMIT"),
+	_T("ONUNLOAD"),
+	_T("PROFILE"),
+	_T("PROMPT"),
+	_T("READONLY"),
+	_T("REL"),
+	_T("REV"),
+	_T("ROWS"),
+	_T("ROWSPAN"),
+	_T("RULES"),
+	_T("RUNAT"),
+	_T("SCHEME"),
+	_T("SCOPE"),
+	_T("SCROLLING"),
+	_T("SELECTED"),
+	_T("SHAPE"),
+	_T("SIZE"),
+	_T("SPAN"),
+	_T("SRC"),
+	_T("STANDBY"),
+	_T("START"),
+	_T("STYLE"),
+	_T("SUMMARY"),
+	_T("TABINDEX"),
+	_T("TARGET"),
+	_T("TEXT"),
+	_T("TITLE"),
+	_T("TYPE"),
+	_T("USEMAP"),
+	_T("VALIGN"),
+	_T("VALUE"),
+	_T("VALUETYPE"),
+	_T("VERSION"),
+	_T("VLINK"),
+	_T("VSPACE"),
+	_T("WIDTH"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 BOOL HtmlKeywords::IsHtmlAttrName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("ABBR"),
-		_T("ACCEPT"),
-		_T("ACCEPT-CHARSET"),
-		_T("ACCESSKEY"),
-		_T("ACTION"),
-		_T("ALIGN"),
-		_T("ALINK"),
-		_T("ALT"),
-		_T("ARCHIVE"),
-		_T("AXIS"),
-		_T("BACKGROUND"),
-		_T("BGCOLOR"),
-		_T("BORDER"),
-		_T("CELLPADDING"),
-		_T("CELLSPACING"),
-		_T("CHAR"),
-		_T("CHAROFF"),
-		_T("CHARSET"),
-		_T("CHECKED"),
-		_T("CITE"),
-		_T("CLASS"),
-		_T("CLASSID"),
-		_T("CLEAR"),
-		_T("CODE"),
-		_T("CODEBASE"),
-		_T("CODETYPE"),
-		_T("COLOR"),
-		_T("COLS"),
-		_T("COLSPAN"),
-		_T("COMPACT"),
-		_T("CONTENT"),
-		_T("COORDS"),
-		_T("DATA"),
-		_T("DATAFLD"),
-		_T("DATAFORMATAS"),
-		_T("DATASRC"),
-		_T("DATETIME"),
-		_T("DECLARE"),
-		_T("DEFER"),
-		_T("DIR"),
-		_T("DISABLED"),
-		_T("ENCTYPE"),
-		_T("EVENT"),
-		_T("FACE"),
-		_T("FOR"),
-		_T("FRAME"),
-		_T("FRAMEBORDER"),
-		_T("HEADERS"),
-		_T("HEIGHT"),
-		_T("HREF"),
-		_T("HREFLANG"),
-		_T("HSPACE"),
-		_T("HTTP-EQUIV"),
-		_T("ID"),
-		_T("ISMAP"),
-		_T("LABEL"),
-		_T("LANG"),
-		_T("LANGUAGE"),
-		_T("LINK"),
-		_T("LONGDESC"),
-		_T("MARGINHEIGHT"),
-		_T("MARGINWIDTH"),
-		_T("MAXLENGTH"),
-		_T("MEDIA"),
-		_T("METHOD"),
-		_T("MULTIPLE"),
-		_T("NAME"),
-		_T("NOHREF"),
-		_T("NORESIZE"),
-		_T("NOSHADE"),
-		_T("NOWRAP"),
-		_T("ONBLUR"),
-		_T("ONCHANGE"),
-		_T("ONCLICK"),
-		_T("ONDBLCLICK"),
-		_T("ONFOCUS"),
-		_T("ONKEYDOWN"),
-		_T("ONKEYPRESS"),
-		_T("ONKEYUP"),
-		_T("ONLOAD"),
-		_T("ONMOUSEDOWN"),
-		_T("ONMOUSEMOVE"),
-		_T("ONMOUSEOUT"),
-		_T("ONMOUSEOVER"),
-		_T("ONMOUSEUP"),
-		_T("ONRESET"),
-		_T("ONSELECT"),
-		_T("ONSUBMIT"),
-		_T("ONUNLOAD"),
-		_T("PROFILE"),
-		_T("PROMPT"),
-		_T("READONLY"),
-		_T("REL"),
-		_T("REV"),
-		_T("ROWS"),
-		_T("ROWSPAN"),
-		_T("RULES"),
-		_T("RUNAT"),
-		_T("SCHEME"),
-		_T("SCOPE"),
-		_T("SCROLLING"),
-		_T("SELECTED"),
-		_T("SHAPE"),
-		_T("SIZE"),
-		_T("SPAN"),
-		_T("SRC"),
-		_T("STANDBY"),
-		_T("START"),
-		_T("STYLE"),
-		_T("SUMMARY"),
-		_T("TABINDEX"),
-		_T("TARGET"),
-		_T("TEXT"),
-		_T("TITLE"),
-		_T("TYPE"),
-		_T("USEMAP"),
-		_T("VALIGN"),
-		_T("VALUE"),
-		_T("VALUETYPE"),
-		_T("VERSION"),
-		_T("VLINK"),
-		_T("VSPACE"),
-		_T("WIDTH"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszDtdTagNameList[] =
+{
+	_T("!ATTLIST"),
+	_T("!DOCTYPE"),
+	_T("!ELEMENT"),
+	_T("!ENTITY"),
+	_T("!NOTATION"),
+};
+
+static KeywordHash<_tcsnicmp> const s_DtdTagNameHash(s_apszDtdTagNameList);
+
 BOOL HtmlKeywords::IsDtdTagName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszDtdTagNameList[] =
-	{
-		_T("!ATTLIST"),
-		_T("!DOCTYPE"),
-		_T("!ELEMENT"),
-		_T("!ENTITY"),
-		_T("!NOTATION"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszDtdTagNameList);
+	return s_DtdTagNameHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszDtdAttrNameList[] =
+{
+	_T("#FIXED"),
+	_T("#IMPLIED"),
+	_T("#REQUIRED"),
+	_T("ANY"),
+	_T("CDATA"),
+	_T("EMPTY"),
+	_T("ENTITIES"),
+	_T("ENTITY"),
+	_T("ID"),
+	_T("IDREF"),
+	_T("IDREFS"),
+	_T("IGNORE"),
+	_T("INCLUDE"),
+	_T("NDATA"),
+	_T("NMTOKEN"),
+	_T("NMTOKENS"),
+	_T("PCDATA"),
+	_T("PUBLIC"),
+	_T("SYSTEM"),
+};
+
+static KeywordHash<_tcsnicmp> const s_DtdAttrNameHash(s_apszDtdAttrNameList);
+
 BOOL HtmlKeywords::IsDtdAttrName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszDtdAttrNameList[] =
-	{
-		_T("#FIXED"),
-		_T("#IMPLIED"),
-		_T("#REQUIRED"),
-		_T("ANY"),
-		_T("CDATA"),
-		_T("EMPTY"),
-		_T("ENTITIES"),
-		_T("ENTITY"),
-		_T("ID"),
-		_T("IDREF"),
-		_T("IDREFS"),
-		_T("IGNORE"),
-		_T("INCLUDE"),
-		_T("NDATA"),
-		_T("NMTOKEN"),
-		_T("NMTOKENS"),
-		_T("PCDATA"),
-		_T("PUBLIC"),
-		_T("SYSTEM"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszDtdAttrNameList);
+	return s_DtdAttrNameHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszHtmlEntityNameList[] =
+{
+	_T("AElig"),
+	_T("AMP"),
+	_T("Aacute"),
+	_T("Abreve"),
+	_T("Acirc"),
+	_T("Acy"),
+	_T("Afr"),
+	_T("Agrave"),
+	_T("Alpha"),
+	_T("Amacr"),
+	_T("And"),
+	_T("Aogon"),
+	_T("Aopf"),
+	_T("ApplyFunction"),
+	_T("Aring"),
+	_T("Ascr"),
+	_T("Assign"),
+	_T("Atilde"),
+	_T("Auml"),
+	_T("Backslash"),
+	_T("Barv"),
+	_T("Barwed"),
+	_T("Bcy"),
+	_T("Because"),
+	_T("Bernoullis"),
+	_T("Beta"),
+	_T("Bfr"),
+	_T("Bopf"),
+	_T("Breve"),
+	_T("Bscr"),
+	_T("Bumpeq"),
+	_T("CHcy"),
+	_T("COPY"),
+	_T("Cacute"),
+	_T("Cap"),
+	_T("CapitalDifferentialD"),
+	_T("Cayleys"),
+	_T("Ccaron"),
+	_T("Ccedil"),
+	_T("Ccirc"),
+	_T("Cconint"),
+	_T("Cdot"),
+	_T("Cedilla"),
+	_T("CenterDot"),
+	_T("Cfr"),
+	_T("Chi"),
+	_T("CircleDot"),
+	_T("CircleMinus"),
+	_T("CirclePlus"),
+	_T("CircleTimes"),
+	_T("ClockwiseContourIntegral"),
+	_T("CloseCurlyDoubleQuote"),
+	_T("CloseCurlyQuote"),
+	_T("Colon"),
+	_T("Colone"),
+	_T("Congruent"),
+	_T("Conint"),
+	_T("ContourIntegral"),
+	_T("Copf"),
+	_T("Coproduct"),
+	_T("CounterClockwiseContourIntegral"),
+	_T("Cross"),
+	_T("Cscr"),
+	_T("Cup"),
+	_T("CupCap"),
+	_T("DD"),
+	_T("DDotrahd"),
+	_T("DJcy"),
+	_T("DScy"),
+	_T("DZcy"),
+	_T("Dagger"),
+	_T("Darr"),
+	_T("Dashv"),
+	_T("Dcaron"),
+	_T("Dcy"),
+	_T("Del"),
+	_T("Delta"),
+	_T("Dfr"),
+	_T("DiacriticalAcute"),
+	_T("DiacriticalDot"),
+	_T("DiacriticalDoubleAcute"),
+	_T("DiacriticalGrave"),
+	_T("DiacriticalTilde"),
+	_T("Diamond"),
+	_T("DifferentialD"),
+	_T("Dopf"),
+	_T("Dot"),
+	_T("DotDot"),
+	_T("DotEqual"),
+	_T("DoubleContourIntegral"),
+	_T("DoubleDot"),
+	_T("DoubleDownArrow"),
+	_T("DoubleLeftArrow"),
+	_T("DoubleLeftRightArrow"),
+	_T("DoubleLeftTee"),
+	_T("DoubleLongLeftArrow"),
+	_T("DoubleLongLeftRightArrow"),
+	_T("DoubleLongRightArrow"),
+	_T("DoubleRightArrow"),
+	_T("DoubleRightTee"),
+	_T("DoubleUpArrow"),
+	_T("DoubleUpDownArrow"),
+	_T("DoubleVerticalBar"),
+	_T("DownArrow"),
+	_T("DownArrowBar"),
+	_T("DownArrowUpArrow"),
+	_T("DownBreve"),
+	_T("DownLeftRightVector"),
+	_T("DownLeftTeeVector"),
+	_T("DownLeftVector"),
+	_T("DownLeftVectorBar"),
+	_T("DownRightTeeVector"),
+	_T("DownRightVector"),
+	_T("DownRightVectorBar"),
+	_T("DownTee"),
+	_T("DownTeeArrow"),
+	_T("Downarrow"),
+	_T("Dscr"),
+	_T("Dstrok"),
+	_T("ENG"),
+	_T("ETH"),
+	_T("Eacute"),
+	_T("Ecaron"),
+	_T("Ecirc"),
+	_T("Ecy"),
+	_T("Edot"),
+	_T("Efr"),
+	_T("Egrave"),
+	_T("Element"),
+	_T("Emacr"),
+	_T("EmptySmallSquare"),
+	_T("EmptyVerySmallSquare"),
+	_T("Eogon"),
+	_T("Eopf"),
+	_T("Epsilon"),
+	_T("Equal"),
+	_T("EqualTilde"),
+	_T("Equilibrium"),
+	_T("Escr"),
+	_T("Esim"),
+	_T("Eta"),
+	_T("Euml"),
+	_T("Exists"),
+	_T("ExponentialE"),
+	_T("Fcy"),
+	_T("Ffr"),
+	_T("FilledSmallSquare"),
+	_T("FilledVerySmallSquare"),
+	_T("Fopf"),
+	_T("ForAll"),
+	_T("Fouriertrf"),
+	_T("Fscr"),
+	_T("GJcy"),
+	_T("GT"),
+	_T("Gamma"),
+	_T("Gammad"),
+	_T("Gbreve"),
+	_T("Gcedil"),
+	_T("Gcirc"),
+	_T("Gcy"),
+	_T("Gdot"),
+	_T("Gfr"),
+	_T("Gg"),
+	_T("Gopf"),
+	_T("GreaterEqual"),
+	_T("GreaterEqualLess"),
+	_T("GreaterFullEqual"),
+	_T("GreaterGreater"),
+	_T("GreaterLess"),
+	_T("GreaterSlantEqual"),
+	_T("GreaterTilde"),
+	_T("Gscr"),
+	_T("Gt"),
+	_T("HARDcy"),
+	_T("Hacek"),
+	_T("Hat"),
+	_T("Hcirc"),
+	_T("Hfr"),
+	_T("HilbertSpace"),
+	_T("Hopf"),
+	_T("HorizontalLine"),
+	_T("Hscr"),
+	_T("Hstrok"),
+	_T("HumpDownHump"),
+	_T("HumpEqual"),
+	_T("IEcy"),
+	_T("IJlig"),
+	_T("IOcy"),
+	_T("Iacute"),
+	_T("Icirc"),
+	_T("Icy"),
+	_T("Idot"),
+	_T("Ifr"),
+	_T("Igrave"),
+	_T("Im"),
+	_T("Imacr"),
+	_T("ImaginaryI"),
+	_T("Implies"),
+	_T("Int"),
+	_T("Integral"),
+	_T("Intersection"),
+	_T("InvisibleComma"),
+	_T("InvisibleTimes"),
+	_T("Iogon"),
+	_T("Iopf"),
+	_T("Iota"),
+	_T("Iscr"),
+	_T("Itilde"),
+	_T("Iukcy"),
+	_T("Iuml"),
+	_T("Jcirc"),
+	_T("Jcy"),
+	_T("Jfr"),
+	_T("Jopf"),
+	_T("Jscr"),
+	_T("Jsercy"),
+	_T("Jukcy"),
+	_T("KHcy"),
+	_T("KJcy"),
+	_T("Kappa"),
+	_T("Kcedil"),
+	_T("Kcy"),
+	_T("Kfr"),
+	_T("Kopf"),
+	_T("Kscr"),
+	_T("LJcy"),
+	_T("LT"),
+	_T("Lacute"),
+	_T("Lambda"),
+	_T("Lang"),
+	_T("Laplacetrf"),
+	_T("Larr"),
+	_T("Lcaron"),
+	_T("Lcedil"),
+	_T("Lcy"),
+	_T("LeftAngleBracket"),
+	_T("LeftArrow"),
+	_T("LeftArrowBar"),
+	_T("LeftArrowRightArrow"),
+	_T("LeftCeiling"),
+	_T("LeftDoubleBracket"),
+	_T("LeftDownTeeVector"),
+	_T("LeftDownVector"),
+	_T("LeftDownVectorBar"),
+	_T("LeftFloor"),
+	_T("LeftRightArrow"),
+	_T("LeftRightVector"),
+	_T("LeftTee"),
+	_T("LeftTeeArrow"),
+	_T("LeftTeeVector"),
+	_T("LeftTriangle"),
+	_T("LeftTriangleBar"),
+	_T("LeftTriangleEqual"),
+	_T("LeftUpDownVector"),
+	_T("LeftUpTeeVector"),
+	_T("LeftUpVector"),
+	_T("LeftUpVectorBar"),
+	_T("LeftVector"),
+	_T("LeftVectorBar"),
+	_T("Leftarrow"),
+	_T("Leftrightarrow"),
+	_T("LessEqualGreater"),
+	_T("LessFullEqual"),
+	_T("LessGreater"),
+	_T("LessLess"),
+	_T("LessSlantEqual"),
+	_T("LessTilde"),
+	_T("Lfr"),
+	_T("Ll"),
+	_T("Lleftarrow"),
+	_T("Lmidot"),
+	_T("LongLeftArrow"),
+	_T("LongLeftRightArrow"),
+	_T("LongRightArrow"),
+	_T("Longleftarrow"),
+	_T("Longleftrightarrow"),
+	_T("Longrightarrow"),
+	_T("Lopf"),
+	_T("LowerLeftArrow"),
+	_T("LowerRightArrow"),
+	_T("Lscr"),
+	_T("Lsh"),
+	_T("Lstrok"),
+	_T("Lt"),
+	_T("Map"),
+	_T("Mcy"),
+	_T("MediumSpace"),
+	_T("Mellintrf"),
+	_T("Mfr"),
+	_T("MinusPlus"),
+	_T("Mopf"),
+	_T("Mscr"),
+	_T("Mu"),
+	_T("NJcy"),
+	_T("Nacute"),
+	_T("Ncaron"),
+	_T("Ncedil"),
+	_T("Ncy"),
+	_T("NegativeMediumSpace"),
+	_T("NegativeThickSpace"),
+	_T("NegativeThinSpace"),
+	_T("NegativeVeryThinSpace"),
+	_T("NestedGreaterGreater"),
+	_T("NestedLessLess"),
+	_T("NewLine"),
+	_T("Nfr"),
+	_T("NoBreak"),
+	_T("NonBreakingSpace"),
+	_T("Nopf"),
+	_T("Not"),
+	_T("NotCongruent"),
+	_T("NotCupCap"),
+	_T("NotDoubleVerticalBar"),
+	_T("NotElement"),
+	_T("NotEqual"),
+	_T("NotEqualTilde"),
+	_T("NotExists"),
+	_T("NotGreater"),
+	_T("NotGreaterEqual"),
+	_T("NotGreaterFullEqual"),
+	_T("NotGreaterGreater"),
+	_T("NotGreaterLess"),
+	_T("NotGreaterSlantEqual"),
+	_T("NotGreaterTilde"),
+	_T("NotHumpDownHump"),
+	_T("NotHumpEqual"),
+	_T("NotLeftTriangle"),
+	_T("NotLeftTriangleBar"),
+	_T("NotLeftTriangleEqual"),
+	_T("NotLess"),
+	_T("NotLessEqual"),
+	_T("NotLessGreater"),
+	_T("NotLessLess"),
+	_T("NotLessSlantEqual"),
+	_T("NotLessTilde"),
+	_T("NotNestedGreaterGreater"),
+	_T("NotNestedLessLess"),
+	_T("NotPrecedes"),
+	_T("NotPrecedesEqual"),
+	_T("NotPrecedesSlantEqual"),
+	_T("NotReverseElement"),
+	_T("NotRightTriangle"),
+	_T("NotRightTriangleBar"),
+	_T("NotRightTriangleEqual"),
+	_T("NotSquareSubset"),
+	_T("NotSquareSubsetEqual"),
+	_T("NotSquareSuperset"),
+	_T("NotSquareSupersetEqual"),
+	_T("NotSubset"),
+	_T("NotSubsetEqual"),
+	_T("NotSucceeds"),
+	_T("NotSucceedsEqual"),
+	_T("NotSucceedsSlantEqual"),
+	_T("NotSucceedsTilde"),
+	_T("NotSuperset"),
+	_T("NotSupersetEqual"),
+	_T("NotTilde"),
+	_T("NotTildeEqual"),
+	_T("NotTildeFullEqual"),
+	_T("NotTildeTilde"),
+	_T("NotVerticalBar"),
+	_T("Nscr"),
+	_T("Ntilde"),
+	_T("Nu"),
+	_T("OElig"),
+	_T("Oacute"),
+	_T("Ocirc"),
+	_T("Ocy"),
+	_T("Odblac"),
+	_T("Ofr"),
+	_T("Ograve"),
+	_T("Omacr"),
+	_T("Omega"),
+	_T("Omicron"),
+	_T("Oopf"),
+	_T("OpenCurlyDoubleQuote"),
+	_T("OpenCurlyQuote"),
+	_T("Or"),
+	_T("Oscr"),
+	_T("Oslash"),
+	_T("Otilde"),
+	_T("Otimes"),
+	_T("Ouml"),
+	_T("OverBar"),
+	_T("OverBrace"),
+	_T("OverBracket"),
+	_T("OverParenthesis"),
+	_T("PartialD"),
+	_T("Pcy"),
+	_T("Pfr"),
+	_T("Phi"),
+	_T("Pi"),
+	_T("PlusMinus"),
+	_T("Poincareplane"),
+	_T("Popf"),
+	_T("Pr"),
+	_T("Precedes"),
+	_T("PrecedesEqual"),
+	_T("PrecedesSlantEqual"),
+	_T("PrecedesTilde"),
+	_T("Prime"),
+	_T("Product"),
+	_T("Proportion"),
+	_T("Proportional"),
+	_T("Pscr"),
+	_T("Psi"),
+	_T("QUOT"),
+	_T("Qfr"),
+	_T("Qopf"),
+	_T("Qscr"),
+	_T("RBarr"),
+	_T("REG"),
+	_T("Racute"),
+	_T("Rang"),
+	_T("Rarr"),
+	_T("Rarrtl"),
+	_T("Rcaron"),
+	_T("Rcedil"),
+	_T("Rcy"),
+	_T("Re"),
+	_T("ReverseElement"),
+	_T("ReverseEquilibrium"),
+	_T("ReverseUpEquilibrium"),
+	_T("Rfr"),
+	_T("Rho"),
+	_T("RightAngleBracket"),
+	_T("RightArrow"),
+	_T("RightArrowBar"),
+	_T("RightArrowLeftArrow"),
+	_T("RightCeiling"),
+	_T("RightDoubleBracket"),
+	_T("RightDownTeeVector"),
+	_T("RightDownVector"),
+	_T("RightDownVectorBar"),
+	_T("RightFloor"),
+	_T("RightTee"),
+	_T("RightTeeArrow"),
+	_T("RightTeeVector"),
+	_T("RightTriangle"),
+	_T("RightTriangleBar"),
+	_T("RightTriangleEqual"),
+	_T("RightUpDownVector"),
+	_T("RightUpTeeVector"),
+	_T("RightUpVector"),
+	_T("RightUpVectorBar"),
+	_T("RightVector"),
+	_T("RightVectorBar"),
+	_T("Rightarrow"),
+	_T("Ropf"),
+	_T("RoundImplies"),
+	_T("Rrightarrow"),
+	_T("Rscr"),
+	_T("Rsh"),
+	_T("RuleDelayed"),
+	_T("SHCHcy"),
+	_T("SHcy"),
+	_T("SOFTcy"),
+	_T("Sacute"),
+	_T("Sc"),
+	_T("Scaron"),
+	_T("Scedil"),
+	_T("Scirc"),
+	_T("Scy"),
+	_T("Sfr"),
+	_T("ShortDownArrow"),
+	_T("ShortLeftArrow"),
+	_T("ShortRightArrow"),
+	_T("ShortUpArrow"),
+	_T("Sigma"),
+	_T("SmallCircle"),
+	_T("Sopf"),
+	_T("Sqrt"),
+	_T("Square"),
+	_T("SquareIntersection"),
+	_T("SquareSubset"),
+	_T("SquareSubsetEqual"),
+	_T("SquareSuperset"),
+	_T("SquareSupersetEqual"),
+	_T("SquareUnion"),
+	_T("Sscr"),
+	_T("Star"),
+	_T("Sub"),
+	_T("Subset"),
+	_T("SubsetEqual"),
+	_T("Succeeds"),
+	_T("SucceedsEqual"),
+	_T("SucceedsSlantEqual"),
+	_T("SucceedsTilde"),
+	_T("SuchThat"),
+	_T("Sum"),
+	_T("Sup"),
+	_T("Superset"),
+	_T("SupersetEqual"),
+	_T("Supset"),
+	_T("THORN"),
+	_T("TRADE"),
+	_T("TSHcy"),
+	_T("TScy"),
+	_T("Tab"),
+	_T("Tau"),
+	_T("Tcaron"),
+	_T("Tcedil"),
+	_T("Tcy"),
+	_T("Tfr"),
+	_T("Therefore"),
+	_T("Theta"),
+	_T("ThickSpace"),
+	_T("ThinSpace"),
+	_T("Tilde"),
+	_T("TildeEqual"),
+	_T("TildeFullEqual"),
+	_T("TildeTilde"),
+	_T("Topf"),
+	_T("TripleDot"),
+	_T("Tscr"),
+	_T("Tstrok"),
+	_T("Uacute"),
+	_T("Uarr"),
+	_T("Uarrocir"),
+	_T("Ubrcy"),
+	_T("Ubreve"),
+	_T("Ucirc"),
+	_T("Ucy"),
+	_T("Udblac"),
+	_T("Ufr"),
+	_T("Ugrave"),
+	_T("Umacr"),
+	_T("UnderBar"),
+	_T("UnderBrace"),
+	_T("UnderBracket"),
+	_T("UnderParenthesis"),
+	_T("Union"),
+	_T("UnionPlus"),
+	_T("Uogon"),
+	_T("Uopf"),
+	_T("UpArrow"),
+	_T("UpArrowBar"),
+	_T("UpArrowDownArrow"),
+	_T("UpDownArrow"),
+	_T("UpEquilibrium"),
+	_T("UpTee"),
+	_T("UpTeeArrow"),
+	_T("Uparrow"),
+	_T("Updownarrow"),
+	_T("UpperLeftArrow"),
+	_T("UpperRightArrow"),
+	_T("Upsi"),
+	_T("Upsilon"),
+	_T("Uring"),
+	_T("Uscr"),
+	_T("Utilde"),
+	_T("Uuml"),
+	_T("VDash"),
+	_T("Vbar"),
+	_T("Vcy"),
+	_T("Vdash"),
+	_T("Vdashl"),
+	_T("Vee"),
+	_T("Verbar"),
+	_T("Vert"),
+	_T("VerticalBar"),
+	_T("VerticalLine"),
+	_T("VerticalSeparator"),
+	_T("VerticalTilde"),
+	_T("VeryThinSpace"),
+	_T("Vfr"),
+	_T("Vopf"),
+	_T("Vscr"),
+	_T("Vvdash"),
+	_T("Wcirc"),
+	_T("Wedge"),
+	_T("Wfr"),
+	_T("Wopf"),
+	_T("Wscr"),
+	_T("Xfr"),
+	_T("Xi"),
+	_T("Xopf"),
+	_T("Xscr"),
+	_T("YAcy"),
+	_T("YIcy"),
+	_T("YUcy"),
+	_T("Yacute"),
+	_T("Ycirc"),
+	_T("Ycy"),
+	_T("Yfr"),
+	_T("Yopf"),
+	_T("Yscr"),
+	_T("Yuml"),
+	_T("ZHcy"),
+	_T("Zacute"),
+	_T("Zcaron"),
+	_T("Zcy"),
+	_T("Zdot"),
+	_T("ZeroWidthSpace"),
+	_T("Zeta"),
+	_T("Zfr"),
+	_T("Zopf"),
+	_T("Zscr"),
+	_T("aacute"),
+	_T("abreve"),
+	_T("ac"),
+	_T("acE"),
+	_T("acd"),
+	_T("acirc"),
+	_T("acute"),
+	_T("acy"),
+	_T("aelig"),
+	_T("af"),
+	_T("afr"),
+	_T("agrave"),
+	_T("alefsym"),
+	_T("aleph"),
+	_T("alpha"),
+	_T("amacr"),
+	_T("amalg"),
+	_T("amp"),
+	_T("and"),
+	_T("andand"),
+	_T("andd"),
+	_T("andslope"),
+	_T("andv"),
+	_T("ang"),
+	_T("ange"),
+	_T("angle"),
+	_T("angmsd"),
+	_T("angmsdaa"),
+	_T("angmsdab"),
+	_T("angmsdac"),
+	_T("angmsdad"),
+	_T("angmsdae"),
+	_T("angmsdaf"),
+	_T("angmsdag"),
+	_T("angmsdah"),
+	_T("angrt"),
+	_T("angrtvb"),
+	_T("angrtvbd"),
+	_T("angsph"),
+	_T("angst"),
+	_T("angzarr"),
+	_T("aogon"),
+	_T("aopf"),
+	_T("ap"),
+	_T("apE"),
+	_T("apacir"),
+	_T("ape"),
+	_T("apid"),
+	_T("apos"),
+	_T("approx"),
+	_T("approxeq"),
+	_T("aring"),
+	_T("ascr"),
+	_T("ast"),
+	_T("asymp"),
+	_T("asympeq"),
+	_T("atilde"),
+	_T("auml"),
+	_T("awconint"),
+	_T("awint"),
+	_T("bNot"),
+	_T("backcong"),
+	_T("backepsilon"),
+	_T("backprime"),
+	_T("backsim"),
+	_T("backsimeq"),
+	_T("barvee"),
+	_T("barwed"),
+	_T("barwedge"),
+	_T("bbrk"),
+	_T("bbrktbrk"),
+	_T("bcong"),
+	_T("bcy"),
+	_T("bdquo"),
+	_T("becaus"),
+	_T("because"),
+	_T("bemptyv"),
+	_T("bepsi"),
+	_T("bernou"),
+	_T("beta"),
+	_T("beth"),
+	_T("between"),
+	_T("bfr"),
+	_T("bigcap"),
+	_T("bigcirc"),
+	_T("bigcup"),
+	_T("bigodot"),
+	_T("bigoplus"),
+	_T("bigotimes"),
+	_T("bigsqcup"),
+	_T("bigstar"),
+	_T("bigtriangledown"),
+	_T("bigtriangleup"),
+	_T("biguplus"),
+	_T("bigvee"),
+	_T("bigwedge"),
+	_T("bkarow"),
+	_T("blacklozenge"),
+	_T("blacksquare"),
+	_T("blacktriangle"),
+	_T("blacktriangledown"),
+	_T("blacktriangleleft"),
+	_T("blacktriangleright"),
+	_T("blank"),
+	_T("blk12"),
+	_T("blk14"),
+	_T("blk34"),
+	_T("block"),
+	_T("bne"),
+	_T("bnequiv"),
+	_T("bnot"),
+	_T("bopf"),
+	_T("bot"),
+	_T("bottom"),
+	_T("bowtie"),
+	_T("boxDL"),
+	_T("boxDR"),
+	_T("boxDl"),
+	_T("boxDr"),
+	_T("boxH"),
+	_T("boxHD"),
+	_T("boxHU"),
+	_T("boxHd"),
+	_T("boxHu"),
+	_T("boxUL"),
+	_T("boxUR"),
+	_T("boxUl"),
+	_T("boxUr"),
+	_T("boxV"),
+	_T("boxVH"),
+	_T("boxVL"),
+	_T("boxVR"),
+	_T("boxVh"),
+	_T("boxVl"),
+	_T("boxVr"),
+	_T("boxbox"),
+	_T("boxdL"),
+	_T("boxdR"),
+	_T("boxdl"),
+	_T("boxdr"),
+	_T("boxh"),
+	_T("boxhD"),
+	_T("boxhU"),
+	_T("boxhd"),
+	_T("boxhu"),
+	_T("boxminus"),
+	_T("boxplus"),
+	_T("boxtimes"),
+	_T("boxuL"),
+	_T("boxuR"),
+	_T("boxul"),
+	_T("boxur"),
+	_T("boxv"),
+	_T("boxvH"),
+	_T("boxvL"),
+	_T("boxvR"),
+	_T("boxvh"),
+	_T("boxvl"),
+	_T("boxvr"),
+	_T("bprime"),
+	_T("breve"),
+	_T("brvbar"),
+	_T("bscr"),
+	_T("bsemi"),
+	_T("bsim"),
+	_T("bsime"),
+	_T("bsol"),
+	_T("bsolb"),
+	_T("bsolhsub"),
+	_T("bull"),
+	_T("bullet"),
+	_T("bump"),
+	_T("bumpE"),
+	_T("bumpe"),
+	_T("bumpeq"),
+	_T("cacute"),
+	_T("cap"),
+	_T("capand"),
+	_T("capbrcup"),
+	_T("capcap"),
+	_T("capcup"),
+	_T("capdot"),
+	_T("caps"),
+	_T("caret"),
+	_T("caron"),
+	_T("ccaps"),
+	_T("ccaron"),
+	_T("ccedil"),
+	_T("ccirc"),
+	_T("ccups"),
+	_T("ccupssm"),
+	_T("cdot"),
+	_T("cedil"),
+	_T("cemptyv"),
+	_T("cent"),
+	_T("centerdot"),
+	_T("cfr"),
+	_T("chcy"),
+	_T("check"),
+	_T("checkmark"),
+	_T("chi"),
+	_T("cir"),
+	_T("cirE"),
+	_T("circ"),
+	_T("circeq"),
+	_T("circlearrowleft"),
+	_T("circlearrowright"),
+	_T("circledR"),
+	_T("circledS"),
+	_T("circledast"),
+	_T("circledcirc"),
+	_T("circleddash"),
+	_T("cire"),
+	_T("cirfnint"),
+	_T("cirmid"),
+	_T("cirscir"),
+	_T("clubs"),
+	_T("clubsuit"),
+	_T("colon"),
+	_T("colone"),
+	_T("coloneq"),
+	_T("comma"),
+	_T("commat"),
+	_T("comp"),
+	_T("compfn"),
+	_T("complement"),
+	_T("complexes"),
+	_T("cong"),
+	_T("congdot"),
+	_T("conint"),
+	_T("copf"),
+	_T("coprod"),
+	_T("copy"),
+	_T("copysr"),
+	_T("crarr"),
+	_T("cross"),
+	_T("cscr"),
+	_T("csub"),
+	_T("csube"),
+	_T("csup"),
+	_T("csupe"),
+	_T("ctdot"),
+	_T("cudarrl"),
+	_T("cudarrr"),
+	_T("cuepr"),
+	_T("cuesc"),
+	_T("cularr"),
+	_T("cularrp"),
+	_T("cup"),
+	_T("cupbrcap"),
+	_T("cupcap"),
+	_T("cupcup"),
+	_T("cupdot"),
+	_T("cupor"),
+	_T("cups"),
+	_T("curarr"),
+	_T("curarrm"),
+	_T("curlyeqprec"),
+	_T("curlyeqsucc"),
+	_T("curlyvee"),
+	_T("curlywedge"),
+	_T("curren"),
+	_T("curvearrowleft"),
+	_T("curvearrowright"),
+	_T("cuvee"),
+	_T("cuwed"),
+	_T("cwconint"),
+	_T("cwint"),
+	_T("cylcty"),
+	_T("dArr"),
+	_T("dHar"),
+	_T("dagger"),
+	_T("daleth"),
+	_T("darr"),
+	_T("dash"),
+	_T("dashv"),
+	_T("dbkarow"),
+	_T("dblac"),
+	_T("dcaron"),
+	_T("dcy"),
+	_T("dd"),
+	_T("ddagger"),
+	_T("ddarr"),
+	_T("ddotseq"),
+	_T("deg"),
+	_T("delta"),
+	_T("demptyv"),
+	_T("dfisht"),
+	_T("dfr"),
+	_T("dharl"),
+	_T("dharr"),
+	_T("diam"),
+	_T("diamond"),
+	_T("diamondsuit"),
+	_T("diams"),
+	_T("die"),
+	_T("digamma"),
+	_T("disin"),
+	_T("div"),
+	_T("divide"),
+	_T("divideontimes"),
+	_T("divonx"),
+	_T("djcy"),
+	_T("dlcorn"),
+	_T("dlcrop"),
+	_T("dollar"),
+	_T("dopf"),
+	_T("dot"),
+	_T("doteq"),
+	_T("doteqdot"),
+	_T("dotminus"),
+	_T("dotplus"),
+	_T("dotsquare"),
+	_T("doublebarwedge"),
+	_T("downarrow"),
+	_T("downdownarrows"),
+	_T("downharpoonleft"),
+	_T("downharpoonright"),
+	_T("drbkarow"),
+	_T("drcorn"),
+	_T("drcrop"),
+	_T("dscr"),
+	_T("dscy"),
+	_T("dsol"),
+	_T("dstrok"),
+	_T("dtdot"),
+	_T("dtri"),
+	_T("dtrif"),
+	_T("duarr"),
+	_T("duhar"),
+	_T("dwangle"),
+	_T("dzcy"),
+	_T("dzigrarr"),
+	_T("eDDot"),
+	_T("eDot"),
+	_T("eacute"),
+	_T("easter"),
+	_T("ecaron"),
+	_T("ecir"),
+	_T("ecirc"),
+	_T("ecolon"),
+	_T("ecy"),
+	_T("edot"),
+	_T("ee"),
+	_T("efDot"),
+	_T("efr"),
+	_T("eg"),
+	_T("egrave"),
+	_T("egs"),
+	_T("egsdot"),
+	_T("el"),
+	_T("elinters"),
+	_T("ell"),
+	_T("els"),
+	_T("elsdot"),
+	_T("emacr"),
+	_T("empty"),
+	_T("emptyset"),
+	_T("emptyv"),
+	_T("emsp"),
+	_T("emsp13"),
+	_T("emsp14"),
+	_T("eng"),
+	_T("ensp"),
+	_T("eogon"),
+	_T("eopf"),
+	_T("epar"),
+	_T("eparsl"),
+	_T("eplus"),
+	_T("epsi"),
+	_T("epsilon"),
+	_T("epsiv"),
+	_T("eqcirc"),
+	_T("eqcolon"),
+	_T("eqsim"),
+	_T("eqslantgtr"),
+	_T("eqslantless"),
+	_T("equals"),
+	_T("equest"),
+	_T("equiv"),
+	_T("equivDD"),
+	_T("eqvparsl"),
+	_T("erDot"),
+	_T("erarr"),
+	_T("escr"),
+	_T("esdot"),
+	_T("esim"),
+	_T("eta"),
+	_T("eth"),
+	_T("euml"),
+	_T("euro"),
+	_T("excl"),
+	_T("exist"),
+	_T("expectation"),
+	_T("exponentiale"),
+	_T("fallingdotseq"),
+	_T("fcy"),
+	_T("female"),
+	_T("ffilig"),
+	_T("fflig"),
+	_T("ffllig"),
+	_T("ffr"),
+	_T("filig"),
+	_T("fjlig"),
+	_T("flat"),
+	_T("fllig"),
+	_T("fltns"),
+	_T("fnof"),
+	_T("fopf"),
+	_T("forall"),
+	_T("fork"),
+	_T("forkv"),
+	_T("fpartint"),
+	_T("frac12"),
+	_T("frac13"),
+	_T("frac14"),
+	_T("frac15"),
+	_T("frac16"),
+	_T("frac18"),
+	_T("frac23"),
+	_T("frac25"),
+	_T("frac34"),
+	_T("frac35"),
+	_T("frac38"),
+	_T("frac45"),
+	_T("frac56"),
+	_T("frac58"),
+	_T("frac78"),
+	_T("frasl"),
+	_T("frown"),
+	_T("fscr"),
+	_T("gE"),
+	_T("gEl"),
+	_T("gacute"),
+	_T("gamma"),
+	_T("gammad"),
+	_T("gap"),
+	_T("gbreve"),
+	_T("gcirc"),
+	_T("gcy"),
+	_T("gdot"),
+	_T("ge"),
+	_T("gel"),
+	_T("geq"),
+	_T("geqq"),
+	_T("geqslant"),
+	_T("ges"),
+	_T("gescc"),
+	_T("gesdot"),
+	_T("gesdoto"),
+	_T("gesdotol"),
+	_T("gesl"),
+	_T("gesles"),
+	_T("gfr"),
+	_T("gg"),
+	_T("ggg"),
+	_T("gimel"),
+	_T("gjcy"),
+	_T("gl"),
+	_T("glE"),
+	_T("gla"),
+	_T("glj"),
+	_T("gnE"),
+	_T("gnap"),
+	_T("gnapprox"),
+	_T("gne"),
+	_T("gneq"),
+	_T("gneqq"),
+	_T("gnsim"),
+	_T("gopf"),
+	_T("grave"),
+	_T("gscr"),
+	_T("gsim"),
+	_T("gsime"),
+	_T("gsiml"),
+	_T("gt"),
+	_T("gtcc"),
+	_T("gtcir"),
+	_T("gtdot"),
+	_T("gtlPar"),
+	_T("gtquest"),
+	_T("gtrapprox"),
+	_T("gtrarr"),
+	_T("gtrdot"),
+	_T("gtreqless"),
+	_T("gtreqqless"),
+	_T("gtrless"),
+	_T("gtrsim"),
+	_T("gvertneqq"),
+	_T("gvnE"),
+	_T("hArr"),
+	_T("hairsp"),
+	_T("half"),
+	_T("hamilt"),
+	_T("hardcy"),
+	_T("harr"),
+	_T("harrcir"),
+	_T("harrw"),
+	_T("hbar"),
+	_T("hcirc"),
+	_T("hearts"),
+	_T("heartsuit"),
+	_T("hellip"),
+	_T("hercon"),
+	_T("hfr"),
+	_T("hksearow"),
+	_T("hkswarow"),
+	_T("hoarr"),
+	_T("homtht"),
+	_T("hookleftarrow"),
+	_T("hookrightarrow"),
+	_T("hopf"),
+	_T("horbar"),
+	_T("hscr"),
+	_T("hslash"),
+	_T("hstrok"),
+	_T("hybull"),
+	_T("hyphen"),
+	_T("iacute"),
+	_T("ic"),
+	_T("icirc"),
+	_T("icy"),
+	_T("iecy"),
+	_T("iexcl"),
+	_T("iff"),
+	_T("ifr"),
+	_T("igrave"),
+	_T("ii"),
+	_T("iiiint"),
+	_T("iiint"),
+	_T("iinfin"),
+	_T("iiota"),
+	_T("ijlig"),
+	_T("imacr"),
+	_T("image"),
+	_T("imagline"),
+	_T("imagpart"),
+	_T("imath"),
+	_T("imof"),
+	_T("imped"),
+	_T("in"),
+	_T("incare"),
+	_T("infin"),
+	_T("infintie"),
+	_T("inodot"),
+	_T("int"),
+	_T("intcal"),
+	_T("integers"),
+	_T("intercal"),
+	_T("intlarhk"),
+	_T("intprod"),
+	_T("iocy"),
+	_T("iogon"),
+	_T("iopf"),
+	_T("iota"),
+	_T("iprod"),
+	_T("iquest"),
+	_T("iscr"),
+	_T("isin"),
+	_T("isinE"),
+	_T("isindot"),
+	_T("isins"),
+	_T("isinsv"),
+	_T("isinv"),
+	_T("it"),
+	_T("itilde"),
+	_T("iukcy"),
+	_T("iuml"),
+	_T("jcirc"),
+	_T("jcy"),
+	_T("jfr"),
+	_T("jmath"),
+	_T("jopf"),
+	_T("jscr"),
+	_T("jsercy"),
+	_T("jukcy"),
+	_T("kappa"),
+	_T("kappav"),
+	_T("kcedil"),
+	_T("kcy"),
+	_T("kfr"),
+	_T("kgreen"),
+	_T("khcy"),
+	_T("kjcy"),
+	_T("kopf"),
+	_T("kscr"),
+	_T("lAarr"),
+	_T("lArr"),
+	_T("lAtail"),
+	_T("lBarr"),
+	_T("lE"),
+	_T("lEg"),
+	_T("lHar"),
+	_T("lacute"),
+	_T("laemptyv"),
+	_T("lagran"),
+	_T("lambda"),
+	_T("lang"),
+	_T("langd"),
+	_T("langle"),
+	_T("lap"),
+	_T("laquo"),
+	_T("larr"),
+	_T("larrb"),
+	_T("larrbfs"),
+	_T("larrfs"),
+	_T("larrhk"),
+	_T("larrlp"),
+	_T("larrpl"),
+	_T("larrsim"),
+	_T("larrtl"),
+	_T("lat"),
+	_T("latail"),
+	_T("late"),
+	_T("lates"),
+	_T("lbarr"),
+	_T("lbbrk"),
+	_T("lbrace"),
+	_T("lbrack"),
+	_T("lbrke"),
+	_T("lbrksld"),
+	_T("lbrkslu"),
+	_T("lcaron"),
+	_T("lcedil"),
+	_T("lceil"),
+	_T("lcub"),
+	_T("lcy"),
+	_T("ldca"),
+	_T("ldquo"),
+	_T("ldquor"),
+	_T("ldrdhar"),
+	_T("ldrushar"),
+	_T("ldsh"),
+	_T("le"),
+	_T("leftarrow"),
+	_T("leftarrowtail"),
+	_T("leftharpoondown"),
+	_T("leftharpoonup"),
+	_T("leftleftarrows"),
+	_T("leftrightarrow"),
+	_T("leftrightarrows"),
+	_T("leftrightharpoons"),
+	_T("leftrightsquigarrow"),
+	_T("leftthreetimes"),
+	_T("leg"),
+	_T("leq"),
+	_T("leqq"),
+	_T("leqslant"),
+	_T("les"),
+	_T("lescc"),
+	_T("lesdot"),
+	_T("lesdoto"),
+	_T("lesdotor"),
+	_T("lesg"),
+	_T("lesges"),
+	_T("lessapprox"),
+	_T("lessdot"),
+	_T("lesseqgtr"),
+	_T("lesseqqgtr"),
+	_T("lessgtr"),
+	_T("lesssim"),
+	_T("lfisht"),
+	_T("lfloor"),
+	_T("lfr"),
+	_T("lg"),
+	_T("lgE"),
+	_T("lhard"),
+	_T("lharu"),
+	_T("lharul"),
+	_T("lhblk"),
+	_T("ljcy"),
+	_T("ll"),
+	_T("llarr"),
+	_T("llcorner"),
+	_T("llhard"),
+	_T("lltri"),
+	_T("lmidot"),
+	_T("lmoust"),
+	_T("lmoustache"),
+	_T("lnE"),
+	_T("lnap"),
+	_T("lnapprox"),
+	_T("lne"),
+	_T("lneq"),
+	_T("lneqq"),
+	_T("lnsim"),
+	_T("loang"),
+	_T("loarr"),
+	_T("lobrk"),
+	_T("longleftarrow"),
+	_T("longleftrightarrow"),
+	_T("longmapsto"),
+	_T("longrightarrow"),
+	_T("looparrowleft"),
+	_T("looparrowright"),
+	_T("lopar"),
+	_T("lopf"),
+	_T("loplus"),
+	_T("lotimes"),
+	_T("lowast"),
+	_T("lowbar"),
+	_T("loz"),
+	_T("lozenge"),
+	_T("lozf"),
+	_T("lpar"),
+	_T("lparlt"),
+	_T("lrarr"),
+	_T("lrcorner"),
+	_T("lrhar"),
+	_T("lrhard"),
+	_T("lrm"),
+	_T("lrtri"),
+	_T("lsaquo"),
+	_T("lscr"),
+	_T("lsh"),
+	_T("lsim"),
+	_T("lsime"),
+	_T("lsimg"),
+	_T("lsqb"),
+	_T("lsquo"),
+	_T("lsquor"),
+	_T("lstrok"),
+	_T("lt"),
+	_T("ltcc"),
+	_T("ltcir"),
+	_T("ltdot"),
+	_T("lthree"),
+	_T("ltimes"),
+	_T("ltlarr"),
+	_T("ltquest"),
+	_T("ltrPar"),
+	_T("ltri"),
+	_T("ltrie"),
+	_T("ltrif"),
+	_T("lurdshar"),
+	_T("luruhar"),
+	_T("lvertneqq"),
+	_T("lvnE"),
+	_T("mDDot"),
+	_T("macr"),
+	_T("male"),
+	_T("malt"),
+	_T("maltese"),
+	_T("map"),
+	_T("mapsto"),
+	_T("mapstodown"),
+	_T("mapstoleft"),
+	_T("mapstoup"),
+	_T("marker"),
+	_T("mcomma"),
+	_T("mcy"),
+	_T("mdash"),
+	_T("measuredangle"),
+	_T("mfr"),
+	_T("mho"),
+	_T("micro"),
+	_T("mid"),
+	_T("midast"),
+	_T("midcir"),
+	_T("middot"),
+	_T("minus"),
+	_T("minusb"),
+	_T("minusd"),
+	_T("minusdu"),
+	_T("mlcp"),
+	_T("mldr"),
+	_T("mnplus"),
+	_T("models"),
+	_T("mopf"),
+	_T("mp"),
+	_T("mscr"),
+	_T("mstpos"),
+	_T("mu"),
+	_T("multimap"),
+	_T("mumap"),
+	_T("nGg"),
+	_T("nGt"),
+	_T("nGtv"),
+	_T("nLeftarrow"),
+	_T("nLeftrightarrow"),
+	_T("nLl"),
+	_T("nLt"),
+	_T("nLtv"),
+	_T("nRightarrow"),
+	_T("nVDash"),
+	_T("nVdash"),
+	_T("nabla"),
+	_T("nacute"),
+	_T("nang"),
+	_T("nap"),
+	_T("napE"),
+	_T("napid"),
+	_T("napos"),
+	_T("napprox"),
+	_T("natur"),
+	_T("natural"),
+	_T("naturals"),
+	_T("nbsp"),
+	_T("nbump"),
+	_T("nbumpe"),
+	_T("ncap"),
+	_T("ncaron"),
+	_T("ncedil"),
+	_T("ncong"),
+	_T("ncongdot"),
+	_T("ncup"),
+	_T("ncy"),
+	_T("ndash"),
+	_T("ne"),
+	_T("neArr"),
+	_T("nearhk"),
+	_T("nearr"),
+	_T("nearrow"),
+	_T("nedot"),
+	_T("nequiv"),
+	_T("nesear"),
+	_T("nesim"),
+	_T("nexist"),
+	_T("nexists"),
+	_T("nfr"),
+	_T("ngE"),
+	_T("nge"),
+	_T("ngeq"),
+	_T("ngeqq"),
+	_T("ngeqslant"),
+	_T("nges"),
+	_T("ngsim"),
+	_T("ngt"),
+	_T("ngtr"),
+	_T("nhArr"),
+	_T("nharr"),
+	_T("nhpar"),
+	_T("ni"),
+	_T("nis"),
+	_T("nisd"),
+	_T("niv"),
+	_T("njcy"),
+	_T("nlArr"),
+	_T("nlE"),
+	_T("nlarr"),
+	_T("nldr"),
+	_T("nle"),
+	_T("nleftarrow"),
+	_T("nleftrightarrow"),
+	_T("nleq"),
+	_T("nleqq"),
+	_T("nleqslant"),
+	_T("nles"),
+	_T("nless"),
+	_T("nlsim"),
+	_T("nlt"),
+	_T("nltri"),
+	_T("nltrie"),
+	_T("nmid"),
+	_T("nopf"),
+	_T("not"),
+	_T("notin"),
+	_T("notinE"),
+	_T("notindot"),
+	_T("notinva"),
+	_T("notinvb"),
+	_T("notinvc"),
+	_T("notni"),
+	_T("notniva"),
+	_T("notnivb"),
+	_T("notnivc"),
+	_T("npar"),
+	_T("nparallel"),
+	_T("nparsl"),
+	_T("npart"),
+	_T("npolint"),
+	_T("npr"),
+	_T("nprcue"),
+	_T("npre"),
+	_T("nprec"),
+	_T("npreceq"),
+	_T("nrArr"),
+	_T("nrarr"),
+	_T("nrarrc"),
+	_T("nrarrw"),
+	_T("nrightarrow"),
+	_T("nrtri"),
+	_T("nrtrie"),
+	_T("nsc"),
+	_T("nsccue"),
+	_T("nsce"),
+	_T("nscr"),
+	_T("nshortmid"),
+	_T("nshortparallel"),
+	_T("nsim"),
+	_T("nsime"),
+	_T("nsimeq"),
+	_T("nsmid"),
+	_T("nspar"),
+	_T("nsqsube"),
+	_T("nsqsupe"),
+	_T("nsub"),
+	_T("nsubE"),
+	_T("nsube"),
+	_T("nsubset"),
+	_T("nsubseteq"),
+	_T("nsubseteqq"),
+	_T("nsucc"),
+	_T("nsucceq"),
+	_T("nsup"),
+	_T("nsupE"),
+	_T("nsupe"),
+	_T("nsupset"),
+	_T("nsupseteq"),
+	_T("nsupseteqq"),
+	_T("ntgl"),
+	_T("ntilde"),
+	_T("ntlg"),
+	_T("ntriangleleft"),
+	_T("ntrianglelefteq"),
+	_T("ntriangleright"),
+	_T("ntrianglerighteq"),
+	_T("nu"),
+	_T("num"),
+	_T("numero"),
+	_T("numsp"),
+	_T("nvDash"),
+	_T("nvHarr"),
+	_T("nvap"),
+	_T("nvdash"),
+	_T("nvge"),
+	_T("nvgt"),
+	_T("nvinfin"),
+	_T("nvlArr"),
+	_T("nvle"),
+	_T("nvlt"),
+	_T("nvltrie"),
+	_T("nvrArr"),
+	_T("nvrtrie"),
+	_T("nvsim"),
+	_T("nwArr"),
+	_T("nwarhk"),
+	_T("nwarr"),
+	_T("nwarrow"),
+	_T("nwnear"),
+	_T("oS"),
+	_T("oacute"),
+	_T("oast"),
+	_T("ocir"),
+	_T("ocirc"),
+	_T("ocy"),
+	_T("odash"),
+	_T("odblac"),
+	_T("odiv"),
+	_T("odot"),
+	_T("odsold"),
+	_T("oelig"),
+	_T("ofcir"),
+	_T("ofr"),
+	_T("ogon"),
+	_T("ograve"),
+	_T("ogt"),
+	_T("ohbar"),
+	_T("ohm"),
+	_T("oint"),
+	_T("olarr"),
+	_T("olcir"),
+	_T("olcross"),
+	_T("oline"),
+	_T("olt"),
+	_T("omacr"),
+	_T("omega"),
+	_T("omicron"),
+	_T("omid"),
+	_T("ominus"),
+	_T("oopf"),
+	_T("opar"),
+	_T("operp"),
+	_T("oplus"),
+	_T("or"),
+	_T("orarr"),
+	_T("ord"),
+	_T("order"),
+	_T("orderof"),
+	_T("ordf"),
+	_T("ordm"),
+	_T("origof"),
+	_T("oror"),
+	_T("orslope"),
+	_T("orv"),
+	_T("oscr"),
+	_T("oslash"),
+	_T("osol"),
+	_T("otilde"),
+	_T("otimes"),
+	_T("otimesas"),
+	_T("ouml"),
+	_T("ovbar"),
+	_T("par"),
+	_T("para"),
+	_T("parallel"),
+	_T("parsim"),
+	_T("parsl"),
+	_T("part"),
+	_T("pcy"),
+	_T("percnt"),
+	_T("period"),
+	_T("permil"),
+	_T("perp"),
+	_T("pertenk"),
+	_T("pfr"),
+	_T("phi"),
+	_T("phiv"),
+	_T("phmmat"),
+	_T("phone"),
+	_T("pi"),
+	_T("pitchfork"),
+	_T("piv"),
+	_T("planck"),
+	_T("planckh"),
+	_T("plankv"),
+	_T("plus"),
+	_T("plusacir"),
+	_T("plusb"),
+	_T("pluscir"),
+	_T("plusdo"),
+	_T("plusdu"),
+	_T("pluse"),
+	_T("plusmn"),
+	_T("plussim"),
+	_T("plustwo"),
+	_T("pm"),
+	_T("pointint"),
+	_T("popf"),
+	_T("pound"),
+	_T("pr"),
+	_T("prE"),
+	_T("prap"),
+	_T("prcue"),
+	_T("pre"),
+	_T("prec"),
+	_T("precapprox"),
+	_T("preccurlyeq"),
+	_T("preceq"),
+	_T("precnapprox"),
+	_T("precneqq"),
+	_T("precnsim"),
+	_T("precsim"),
+	_T("prime"),
+	_T("primes"),
+	_T("prnE"),
+	_T("prnap"),
+	_T("prnsim"),
+	_T("prod"),
+	_T("profalar"),
+	_T("profline"),
+	_T("profsurf"),
+	_T("prop"),
+	_T("propto"),
+	_T("prsim"),
+	_T("prurel"),
+	_T("pscr"),
+	_T("psi"),
+	_T("puncsp"),
+	_T("qfr"),
+	_T("qint"),
+	_T("qopf"),
+	_T("qprime"),
+	_T("qscr"),
+	_T("quaternions"),
+	_T("quatint"),
+	_T("quest"),
+	_T("questeq"),
+	_T("quot"),
+	_T("rAarr"),
+	_T("rArr"),
+	_T("rAtail"),
+	_T("rBarr"),
+	_T("rHar"),
+	_T("race"),
+	_T("racute"),
+	_T("radic"),
+	_T("raemptyv"),
+	_T("rang"),
+	_T("rangd"),
+	_T("range"),
+	_T("rangle"),
+	_T("raquo"),
+	_T("rarr"),
+	_T("rarrap"),
+	_T("rarrb"),
+	_T("rarrbfs"),
+	_T("rarrc"),
+	_T("rarrfs"),
+	_T("rarrhk"),
+	_T("rarrlp"),
+	_T("rarrpl"),
+	_T("rarrsim"),
+	_T("rarrtl"),
+	_T("rarrw"),
+	_T("ratail"),
+	_T("ratio"),
+	_T("rationals"),
+	_T("rbarr"),
+	_T("rbbrk"),
+	_T("rbrace"),
+	_T("rbrack"),
+	_T("rbrke"),
+	_T("rbrksld"),
+	_T("rbrkslu"),
+	_T("rcaron"),
+	_T("rcedil"),
+	_T("rceil"),
+	_T("rcub"),
+	_T("rcy"),
+	_T("rdca"),
+	_T("rdldhar"),
+	_T("rdquo"),
+	_T("rdquor"),
+	_T("rdsh"),
+	_T("real"),
+	_T("realine"),
+	_T("realpart"),
+	_T("reals"),
+	_T("rect"),
+	_T("reg"),
+	_T("rfisht"),
+	_T("rfloor"),
+	_T("rfr"),
+	_T("rhard"),
+	_T("rharu"),
+	_T("rharul"),
+	_T("rho"),
+	_T("rhov"),
+	_T("rightarrow"),
+	_T("rightarrowtail"),
+	_T("rightharpoondown"),
+	_T("rightharpoonup"),
+	_T("rightleftarrows"),
+	_T("rightleftharpoons"),
+	_T("rightrightarrows"),
+	_T("rightsquigarrow"),
+	_T("rightthreetimes"),
+	_T("ring"),
+	_T("risingdotseq"),
+	_T("rlarr"),
+	_T("rlhar"),
+	_T("rlm"),
+	_T("rmoust"),
+	_T("rmoustache"),
+	_T("rnmid"),
+	_T("roang"),
+	_T("roarr"),
+	_T("robrk"),
+	_T("ropar"),
+	_T("ropf"),
+	_T("roplus"),
+	_T("rotimes"),
+	_T("rpar"),
+	_T("rpargt"),
+	_T("rppolint"),
+	_T("rrarr"),
+	_T("rsaquo"),
+	_T("rscr"),
+	_T("rsh"),
+	_T("rsqb"),
+	_T("rsquo"),
+	_T("rsquor"),
+	_T("rthree"),
+	_T("rtimes"),
+	_T("rtri"),
+	_T("rtrie"),
+	_T("rtrif"),
+	_T("rtriltri"),
+	_T("ruluhar"),
+	_T("rx"),
+	_T("sacute"),
+	_T("sbquo"),
+	_T("sc"),
+	_T("scE"),
+	_T("scap"),
+	_T("scaron"),
+	_T("sccue"),
+	_T("sce"),
+	_T("scedil"),
+	_T("scirc"),
+	_T("scnE"),
+	_T("scnap"),
+	_T("scnsim"),
+	_T("scpolint"),
+	_T("scsim"),
+	_T("scy"),
+	_T("sdot"),
+	_T("sdotb"),
+	_T("sdote"),
+	_T("seArr"),
+	_T("searhk"),
+	_T("searr"),
+	_T("searrow"),
+	_T("sect"),
+	_T("semi"),
+	_T("seswar"),
+	_T("setminus"),
+	_T("setmn"),
+	_T("sext"),
+	_T("sfr"),
+	_T("sfrown"),
+	_T("sharp"),
+	_T("shchcy"),
+	_T("shcy"),
+	_T("shortmid"),
+	_T("shortparallel"),
+	_T("shy"),
+	_T("sigma"),
+	_T("sigmaf"),
+	_T("sigmav"),
+	_T("sim"),
+	_T("simdot"),
+	_T("sime"),
+	_T("simeq"),
+	_T("simg"),
+	_T("simgE"),
+	_T("siml"),
+	_T("simlE"),
+	_T("simne"),
+	_T("simplus"),
+	_T("simrarr"),
+	_T("slarr"),
+	_T("smallsetminus"),
+	_T("smashp"),
+	_T("smeparsl"),
+	_T("smid"),
+	_T("smile"),
+	_T("smt"),
+	_T("smte"),
+	_T("smtes"),
+	_T("softcy"),
+	_T("sol"),
+	_T("solb"),
+	_T("solbar"),
+	_T("sopf"),
+	_T("spades"),
+	_T("spadesuit"),
+	_T("spar"),
+	_T("sqcap"),
+	_T("sqcaps"),
+	_T("sqcup"),
+	_T("sqcups"),
+	_T("sqsub"),
+	_T("sqsube"),
+	_T("sqsubset"),
+	_T("sqsubseteq"),
+	_T("sqsup"),
+	_T("sqsupe"),
+	_T("sqsupset"),
+	_T("sqsupseteq"),
+	_T("squ"),
+	_T("square"),
+	_T("squarf"),
+	_T("squf"),
+	_T("srarr"),
+	_T("sscr"),
+	_T("ssetmn"),
+	_T("ssmile"),
+	_T("sstarf"),
+	_T("star"),
+	_T("starf"),
+	_T("straightepsilon"),
+	_T("straightphi"),
+	_T("strns"),
+	_T("sub"),
+	_T("subE"),
+	_T("subdot"),
+	_T("sube"),
+	_T("subedot"),
+	_T("submult"),
+	_T("subnE"),
+	_T("subne"),
+	_T("subplus"),
+	_T("subrarr"),
+	_T("subset"),
+	_T("subseteq"),
+	_T("subseteqq"),
+	_T("subsetneq"),
+	_T("subsetneqq"),
+	_T("subsim"),
+	_T("subsub"),
+	_T("subsup"),
+	_T("succ"),
+	_T("succapprox"),
+	_T("succcurlyeq"),
+	_T("succeq"),
+	_T("succnapprox"),
+	_T("succneqq"),
+	_T("succnsim"),
+	_T("succsim"),
+	_T("sum"),
+	_T("sung"),
+	_T("sup"),
+	_T("sup1"),
+	_T("sup2"),
+	_T("sup3"),
+	_T("supE"),
+	_T("supdot"),
+	_T("supdsub"),
+	_T("supe"),
+	_T("supedot"),
+	_T("suphsol"),
+	_T("suphsub"),
+	_T("suplarr"),
+	_T("supmult"),
+	_T("supnE"),
+	_T("supne"),
+	_T("supplus"),
+	_T("supset"),
+	_T("supseteq"),
+	_T("supseteqq"),
+	_T("supsetneq"),
+	_T("supsetneqq"),
+	_T("supsim"),
+	_T("supsub"),
+	_T("supsup"),
+	_T("swArr"),
+	_T("swarhk"),
+	_T("swarr"),
+	_T("swarrow"),
+	_T("swnwar"),
+	_T("szlig"),
+	_T("target"),
+	_T("tau"),
+	_T("tbrk"),
+	_T("tcaron"),
+	_T("tcedil"),
+	_T("tcy"),
+	_T("tdot"),
+	_T("telrec"),
+	_T("tfr"),
+	_T("there4"),
+	_T("therefore"),
+	_T("theta"),
+	_T("thetasym"),
+	_T("thetav"),
+	_T("thickapprox"),
+	_T("thicksim"),
+	_T("thinsp"),
+	_T("thkap"),
+	_T("thksim"),
+	_T("thorn"),
+	_T("tilde"),
+	_T("times"),
+	_T("timesb"),
+	_T("timesbar"),
+	_T("timesd"),
+	_T("tint"),
+	_T("toea"),
+	_T("top"),
+	_T("topbot"),
+	_T("topcir"),
+	_T("topf"),
+	_T("topfork"),
+	_T("tosa"),
+	_T("tprime"),
+	_T("trade"),
+	_T("triangle"),
+	_T("triangledown"),
+	_T("triangleleft"),
+	_T("trianglelefteq"),
+	_T("triangleq"),
+	_T("triangleright"),
+	_T("trianglerighteq"),
+	_T("tridot"),
+	_T("trie"),
+	_T("triminus"),
+	_T("triplus"),
+	_T("trisb"),
+	_T("tritime"),
+	_T("trpezium"),
+	_T("tscr"),
+	_T("tscy"),
+	_T("tshcy"),
+	_T("tstrok"),
+	_T("twixt"),
+	_T("twoheadleftarrow"),
+	_T("twoheadrightarrow"),
+	_T("uArr"),
+	_T("uHar"),
+	_T("uacute"),
+	_T("uarr"),
+	_T("ubrcy"),
+	_T("ubreve"),
+	_T("ucirc"),
+	_T("ucy"),
+	_T("udarr"),
+	_T("udblac"),
+	_T("udhar"),
+	_T("ufisht"),
+	_T("ufr"),
+	_T("ugrave"),
+	_T("uharl"),
+	_T("uharr"),
+	_T("uhblk"),
+	_T("ulcorn"),
+	_T("ulcorner"),
+	_T("ulcrop"),
+	_T("ultri"),
+	_T("umacr"),
+	_T("uml"),
+	_T("uogon"),
+	_T("uopf"),
+	_T("uparrow"),
+	_T("updownarrow"),
+	_T("upharpoonleft"),
+	_T("upharpoonright"),
+	_T("uplus"),
+	_T("upsi"),
+	_T("upsih"),
+	_T("upsilon"),
+	_T("upuparrows"),
+	_T("urcorn"),
+	_T("urcorner"),
+	_T("urcrop"),
+	_T("uring"),
+	_T("urtri"),
+	_T("uscr"),
+	_T("utdot"),
+	_T("utilde"),
+	_T("utri"),
+	_T("utrif"),
+	_T("uuarr"),
+	_T("uuml"),
+	_T("uwangle"),
+	_T("vArr"),
+	_T("vBar"),
+	_T("vBarv"),
+	_T("vDash"),
+	_T("vangrt"),
+	_T("varepsilon"),
+	_T("varkappa"),
+	_T("varnothing"),
+	_T("varphi"),
+	_T("varpi"),
+	_T("varpropto"),
+	_T("varr"),
+	_T("varrho"),
+	_T("varsigma"),
+	_T("varsubsetneq"),
+	_T("varsubsetneqq"),
+	_T("varsupsetneq"),
+	_T("varsupsetneqq"),
+	_T("vartheta"),
+	_T("vartriangleleft"),
+	_T("vartriangleright"),
+	_T("vcy"),
+	_T("vdash"),
+	_T("vee"),
+	_T("veebar"),
+	_T("veeeq"),
+	_T("vellip"),
+	_T("verbar"),
+	_T("vert"),
+	_T("vfr"),
+	_T("vltri"),
+	_T("vnsub"),
+	_T("vnsup"),
+	_T("vopf"),
+	_T("vprop"),
+	_T("vrtri"),
+	_T("vscr"),
+	_T("vsubnE"),
+	_T("vsubne"),
+	_T("vsupnE"),
+	_T("vsupne"),
+	_T("vzigzag"),
+	_T("wcirc"),
+	_T("wedbar"),
+	_T("wedge"),
+	_T("wedgeq"),
+	_T("weierp"),
+	_T("wfr"),
+	_T("wopf"),
+	_T("wp"),
+	_T("wr"),
+	_T("wreath"),
+	_T("wscr"),
+	_T("xcap"),
+	_T("xcirc"),
+	_T("xcup"),
+	_T("xdtri"),
+	_T("xfr"),
+	_T("xhArr"),
+	_T("xharr"),
+	_T("xi"),
+	_T("xlArr"),
+	_T("xlarr"),
+	_T("xmap"),
+	_T("xnis"),
+	_T("xodot"),
+	_T("xopf"),
+	_T("xoplus"),
+	_T("xotime"),
+	_T("xrArr"),
+	_T("xrarr"),
+	_T("xscr"),
+	_T("xsqcup"),
+	_T("xuplus"),
+	_T("xutri"),
+	_T("xvee"),
+	_T("xwedge"),
+	_T("yacute"),
+	_T("yacy"),
+	_T("ycirc"),
+	_T("ycy"),
+	_T("yen"),
+	_T("yfr"),
+	_T("yicy"),
+	_T("yopf"),
+	_T("yscr"),
+	_T("yucy"),
+	_T("yuml"),
+	_T("zacute"),
+	_T("zcaron"),
+	_T("zcy"),
+	_T("zdot"),
+	_T("zeetrf"),
+	_T("zeta"),
+	_T("zfr"),
+	_T("zhcy"),
+	_T("zigrarr"),
+	_T("zopf"),
+	_T("zscr"),
+	_T("zwj"),
+	_T("zwnj"),
+};
+
+static KeywordHash<_tcsncmp> const s_HtmlEntityNameHash(s_apszHtmlEntityNameList);
+
 BOOL HtmlKeywords::IsEntityName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszHtmlEntityNameList[] =
-	{
-		_T("AElig"),
-		_T("AMP"),
-		_T("Aacute"),
-		_T("Abreve"),
-		_T("Acirc"),
-		_T("Acy"),
-		_T("Afr"),
-		_T("Agrave"),
-		_T("Alpha"),
-		_T("Amacr"),
-		_T("And"),
-		_T("Aogon"),
-		_T("Aopf"),
-		_T("ApplyFunction"),
-		_T("Aring"),
-		_T("Ascr"),
-		_T("Assign"),
-		_T("Atilde"),
-		_T("Auml"),
-		_T("Backslash"),
-		_T("Barv"),
-		_T("Barwed"),
-		_T("Bcy"),
-		_T("Because"),
-		_T("Bernoullis"),
-		_T("Beta"),
-		_T("Bfr"),
-		_T("Bopf"),
-		_T("Breve"),
-		_T("Bscr"),
-		_T("Bumpeq"),
-		_T("CHcy"),
-		_T("COPY"),
-		_T("Cacute"),
-		_T("Cap"),
-		_T("CapitalDifferentialD"),
-		_T("Cayleys"),
-		_T("Ccaron"),
-		_T("Ccedil"),
-		_T("Ccirc"),
-		_T("Cconint"),
-		_T("Cdot"),
-		_T("Cedilla"),
-		_T("CenterDot"),
-		_T("Cfr"),
-		_T("Chi"),
-		_T("CircleDot"),
-		_T("CircleMinus"),
-		_T("CirclePlus"),
-		_T("CircleTimes"),
-		_T("ClockwiseContourIntegral"),
-		_T("CloseCurlyDoubleQuote"),
-		_T("CloseCurlyQuote"),
-		_T("Colon"),
-		_T("Colone"),
-		_T("Congruent"),
-		_T("Conint"),
-		_T("ContourIntegral"),
-		_T("Copf"),
-		_T("Coproduct"),
-		_T("CounterClockwiseContourIntegral"),
-		_T("Cross"),
-		_T("Cscr"),
-		_T("Cup"),
-		_T("CupCap"),
-		_T("DD"),
-		_T("DDotrahd"),
-		_T("DJcy"),
-		_T("DScy"),
-		_T("DZcy"),
-		_T("Dagger"),
-		_T("Darr"),
-		_T("Dashv"),
-		_T("Dcaron"),
-		_T("Dcy"),
-		_T("Del"),
-		_T("Delta"),
-		_T("Dfr"),
-		_T("DiacriticalAcute"),
-		_T("DiacriticalDot"),
-		_T("DiacriticalDoubleAcute"),
-		_T("DiacriticalGrave"),
-		_T("DiacriticalTilde"),
-		_T("Diamond"),
-		_T("DifferentialD"),
-		_T("Dopf"),
-		_T("Dot"),
-		_T("DotDot"),
-		_T("DotEqual"),
-		_T("DoubleContourIntegral"),
-		_T("DoubleDot"),
-		_T("DoubleDownArrow"),
-		_T("DoubleLeftArrow"),
-		_T("DoubleLeftRightArrow"),
-		_T("DoubleLeftTee"),
-		_T("DoubleLongLeftArrow"),
-		_T("DoubleLongLeftRightArrow"),
-		_T("DoubleLongRightArrow"),
-		_T("DoubleRightArrow"),
-		_T("DoubleRightTee"),
-		_T("DoubleUpArrow"),
-		_T("DoubleUpDownArrow"),
-		_T("DoubleVerticalBar"),
-		_T("DownArrow"),
-		_T("DownArrowBar"),
-		_T("DownArrowUpArrow"),
-		_T("DownBreve"),
-		_T("DownLeftRightVector"),
-		_T("DownLeftTeeVector"),
-		_T("DownLeftVector"),
-		_T("DownLeftVectorBar"),
-		_T("DownRightTeeVector"),
-		_T("DownRightVector"),
-		_T("DownRightVectorBar"),
-		_T("DownTee"),
-		_T("DownTeeArrow"),
-		_T("Downarrow"),
-		_T("Dscr"),
-		_T("Dstrok"),
-		_T("ENG"),
-		_T("ETH"),
-		_T("Eacute"),
-		_T("Ecaron"),
-		_T("Ecirc"),
-		_T("Ecy"),
-		_T("Edot"),
-		_T("Efr"),
-		_T("Egrave"),
-		_T("Element"),
-		_T("Emacr"),
-		_T("EmptySmallSquare"),
-		_T("EmptyVerySmallSquare"),
-		_T("Eogon"),
-		_T("Eopf"),
-		_T("Epsilon"),
-		_T("Equal"),
-		_T("EqualTilde"),
-		_T("Equilibrium"),
-		_T("Escr"),
-		_T("Esim"),
-		_T("Eta"),
-		_T("Euml"),
-		_T("Exists"),
-		_T("ExponentialE"),
-		_T("Fcy"),
-		_T("Ffr"),
-		_T("FilledSmallSquare"),
-		_T("FilledVerySmallSquare"),
-		_T("Fopf"),
-		_T("ForAll"),
-		_T("Fouriertrf"),
-		_T("Fscr"),
-		_T("GJcy"),
-		_T("GT"),
-		_T("Gamma"),
-		_T("Gammad"),
-		_T("Gbreve"),
-		_T("Gcedil"),
-		_T("Gcirc"),
-		_T("Gcy"),
-		_T("Gdot"),
-		_T("Gfr"),
-		_T("Gg"),
-		_T("Gopf"),
-		_T("GreaterEqual"),
-		_T("GreaterEqualLess"),
-		_T("GreaterFullEqual"),
-		_T("GreaterGreater"),
-		_T("GreaterLess"),
-		_T("GreaterSlantEqual"),
-		_T("GreaterTilde"),
-		_T("Gscr"),
-		_T("Gt"),
-		_T("HARDcy"),
-		_T("Hacek"),
-		_T("Hat"),
-		_T("Hcirc"),
-		_T("Hfr"),
-		_T("HilbertSpace"),
-		_T("Hopf"),
-		_T("HorizontalLine"),
-		_T("Hscr"),
-		_T("Hstrok"),
-		_T("HumpDownHump"),
-		_T("HumpEqual"),
-		_T("IEcy"),
-		_T("IJlig"),
-		_T("IOcy"),
-		_T("Iacute"),
-		_T("Icirc"),
-		_T("Icy"),
-		_T("Idot"),
-		_T("Ifr"),
-		_T("Igrave"),
-		_T("Im"),
-		_T("Imacr"),
-		_T("ImaginaryI"),
-		_T("Implies"),
-		_T("Int"),
-		_T("Integral"),
-		_T("Intersection"),
-		_T("InvisibleComma"),
-		_T("InvisibleTimes"),
-		_T("Iogon"),
-		_T("Iopf"),
-		_T("Iota"),
-		_T("Iscr"),
-		_T("Itilde"),
-		_T("Iukcy"),
-		_T("Iuml"),
-		_T("Jcirc"),
-		_T("Jcy"),
-		_T("Jfr"),
-		_T("Jopf"),
-		_T("Jscr"),
-		_T("Jsercy"),
-		_T("Jukcy"),
-		_T("KHcy"),
-		_T("KJcy"),
-		_T("Kappa"),
-		_T("Kcedil"),
-		_T("Kcy"),
-		_T("Kfr"),
-		_T("Kopf"),
-		_T("Kscr"),
-		_T("LJcy"),
-		_T("LT"),
-		_T("Lacute"),
-		_T("Lambda"),
-		_T("Lang"),
-		_T("Laplacetrf"),
-		_T("Larr"),
-		_T("Lcaron"),
-		_T("Lcedil"),
-		_T("Lcy"),
-		_T("LeftAngleBracket"),
-		_T("LeftArrow"),
-		_T("LeftArrowBar"),
-		_T("LeftArrowRightArrow"),
-		_T("LeftCeiling"),
-		_T("LeftDoubleBracket"),
-		_T("LeftDownTeeVector"),
-		_T("LeftDownVector"),
-		_T("LeftDownVectorBar"),
-		_T("LeftFloor"),
-		_T("LeftRightArrow"),
-		_T("LeftRightVector"),
-		_T("LeftTee"),
-		_T("LeftTeeArrow"),
-		_T("LeftTeeVector"),
-		_T("LeftTriangle"),
-		_T("LeftTriangleBar"),
-		_T("LeftTriangleEqual"),
-		_T("LeftUpDownVector"),
-		_T("LeftUpTeeVector"),
-		_T("LeftUpVector"),
-		_T("LeftUpVectorBar"),
-		_T("LeftVector"),
-		_T("LeftVectorBar"),
-		_T("Leftarrow"),
-		_T("Leftrightarrow"),
-		_T("LessEqualGreater"),
-		_T("LessFullEqual"),
-		_T("LessGreater"),
-		_T("LessLess"),
-		_T("LessSlantEqual"),
-		_T("LessTilde"),
-		_T("Lfr"),
-		_T("Ll"),
-		_T("Lleftarrow"),
-		_T("Lmidot"),
-		_T("LongLeftArrow"),
-		_T("LongLeftRightArrow"),
-		_T("LongRightArrow"),
-		_T("Longleftarrow"),
-		_T("Longleftrightarrow"),
-		_T("Longrightarrow"),
-		_T("Lopf"),
-		_T("LowerLeftArrow"),
-		_T("LowerRightArrow"),
-		_T("Lscr"),
-		_T("Lsh"),
-		_T("Lstrok"),
-		_T("Lt"),
-		_T("Map"),
-		_T("Mcy"),
-		_T("MediumSpace"),
-		_T("Mellintrf"),
-		_T("Mfr"),
-		_T("MinusPlus"),
-		_T("Mopf"),
-		_T("Mscr"),
-		_T("Mu"),
-		_T("NJcy"),
-		_T("Nacute"),
-		_T("Ncaron"),
-		_T("Ncedil"),
-		_T("Ncy"),
-		_T("NegativeMediumSpace"),
-		_T("NegativeThickSpace"),
-		_T("NegativeThinSpace"),
-		_T("NegativeVeryThinSpace"),
-		_T("NestedGreaterGreater"),
-		_T("NestedLessLess"),
-		_T("NewLine"),
-		_T("Nfr"),
-		_T("NoBreak"),
-		_T("NonBreakingSpace"),
-		_T("Nopf"),
-		_T("Not"),
-		_T("NotCongruent"),
-		_T("NotCupCap"),
-		_T("NotDoubleVerticalBar"),
-		_T("NotElement"),
-		_T("NotEqual"),
-		_T("NotEqualTilde"),
-		_T("NotExists"),
-		_T("NotGreater"),
-		_T("NotGreaterEqual"),
-		_T("NotGreaterFullEqual"),
-		_T("NotGreaterGreater"),
-		_T("NotGreaterLess"),
-		_T("NotGreaterSlantEqual"),
-		_T("NotGreaterTilde"),
-		_T("NotHumpDownHump"),
-		_T("NotHumpEqual"),
-		_T("NotLeftTriangle"),
-		_T("NotLeftTriangleBar"),
-		_T("NotLeftTriangleEqual"),
-		_T("NotLess"),
-		_T("NotLessEqual"),
-		_T("NotLessGreater"),
-		_T("NotLessLess"),
-		_T("NotLessSlantEqual"),
-		_T("NotLessTilde"),
-		_T("NotNestedGreaterGreater"),
-		_T("NotNestedLessLess"),
-		_T("NotPrecedes"),
-		_T("NotPrecedesEqual"),
-		_T("NotPrecedesSlantEqual"),
-		_T("NotReverseElement"),
-		_T("NotRightTriangle"),
-		_T("NotRightTriangleBar"),
-		_T("NotRightTriangleEqual"),
-		_T("NotSquareSubset"),
-		_T("NotSquareSubsetEqual"),
-		_T("NotSquareSuperset"),
-		_T("NotSquareSupersetEqual"),
-		_T("NotSubset"),
-		_T("NotSubsetEqual"),
-		_T("NotSucceeds"),
-		_T("NotSucceedsEqual"),
-		_T("NotSucceedsSlantEqual"),
-		_T("NotSucceedsTilde"),
-		_T("NotSuperset"),
-		_T("NotSupersetEqual"),
-		_T("NotTilde"),
-		_T("NotTildeEqual"),
-		_T("NotTildeFullEqual"),
-		_T("NotTildeTilde"),
-		_T("NotVerticalBar"),
-		_T("Nscr"),
-		_T("Ntilde"),
-		_T("Nu"),
-		_T("OElig"),
-		_T("Oacute"),
-		_T("Ocirc"),
-		_T("Ocy"),
-		_T("Odblac"),
-		_T("Ofr"),
-		_T("Ograve"),
-		_T("Omacr"),
-		_T("Omega"),
-		_T("Omicron"),
-		_T("Oopf"),
-		_T("OpenCurlyDoubleQuote"),
-		_T("OpenCurlyQuote"),
-		_T("Or"),
-		_T("Oscr"),
-		_T("Oslash"),
-		_T("Otilde"),
-		_T("Otimes"),
-		_T("Ouml"),
-		_T("OverBar"),
-		_T("OverBrace"),
-		_T("OverBracket"),
-		_T("OverParenthesis"),
-		_T("PartialD"),
-		_T("Pcy"),
-		_T("Pfr"),
-		_T("Phi"),
-		_T("Pi"),
-		_T("PlusMinus"),
-		_T("Poincareplane"),
-		_T("Popf"),
-		_T("Pr"),
-		_T("Precedes"),
-		_T("PrecedesEqual"),
-		_T("PrecedesSlantEqual"),
-		_T("PrecedesTilde"),
-		_T("Prime"),
-		_T("Product"),
-		_T("Proportion"),
-		_T("Proportional"),
-		_T("Pscr"),
-		_T("Psi"),
-		_T("QUOT"),
-		_T("Qfr"),
-		_T("Qopf"),
-		_T("Qscr"),
-		_T("RBarr"),
-		_T("REG"),
-		_T("Racute"),
-		_T("Rang"),
-		_T("Rarr"),
-		_T("Rarrtl"),
-		_T("Rcaron"),
-		_T("Rcedil"),
-		_T("Rcy"),
-		_T("Re"),
-		_T("ReverseElement"),
-		_T("ReverseEquilibrium"),
-		_T("ReverseUpEquilibrium"),
-		_T("Rfr"),
-		_T("Rho"),
-		_T("RightAngleBracket"),
-		_T("RightArrow"),
-		_T("RightArrowBar"),
-		_T("RightArrowLeftArrow"),
-		_T("RightCeiling"),
-		_T("RightDoubleBracket"),
-		_T("RightDownTeeVector"),
-		_T("RightDownVector"),
-		_T("RightDownVectorBar"),
-		_T("RightFloor"),
-		_T("RightTee"),
-		_T("RightTeeArrow"),
-		_T("RightTeeVector"),
-		_T("RightTriangle"),
-		_T("RightTriangleBar"),
-		_T("RightTriangleEqual"),
-		_T("RightUpDownVector"),
-		_T("RightUpTeeVector"),
-		_T("RightUpVector"),
-		_T("RightUpVectorBar"),
-		_T("RightVector"),
-		_T("RightVectorBar"),
-		_T("Rightarrow"),
-		_T("Ropf"),
-		_T("RoundImplies"),
-		_T("Rrightarrow"),
-		_T("Rscr"),
-		_T("Rsh"),
-		_T("RuleDelayed"),
-		_T("SHCHcy"),
-		_T("SHcy"),
-		_T("SOFTcy"),
-		_T("Sacute"),
-		_T("Sc"),
-		_T("Scaron"),
-		_T("Scedil"),
-		_T("Scirc"),
-		_T("Scy"),
-		_T("Sfr"),
-		_T("ShortDownArrow"),
-		_T("ShortLeftArrow"),
-		_T("ShortRightArrow"),
-		_T("ShortUpArrow"),
-		_T("Sigma"),
-		_T("SmallCircle"),
-		_T("Sopf"),
-		_T("Sqrt"),
-		_T("Square"),
-		_T("SquareIntersection"),
-		_T("SquareSubset"),
-		_T("SquareSubsetEqual"),
-		_T("SquareSuperset"),
-		_T("SquareSupersetEqual"),
-		_T("SquareUnion"),
-		_T("Sscr"),
-		_T("Star"),
-		_T("Sub"),
-		_T("Subset"),
-		_T("SubsetEqual"),
-		_T("Succeeds"),
-		_T("SucceedsEqual"),
-		_T("SucceedsSlantEqual"),
-		_T("SucceedsTilde"),
-		_T("SuchThat"),
-		_T("Sum"),
-		_T("Sup"),
-		_T("Superset"),
-		_T("SupersetEqual"),
-		_T("Supset"),
-		_T("THORN"),
-		_T("TRADE"),
-		_T("TSHcy"),
-		_T("TScy"),
-		_T("Tab"),
-		_T("Tau"),
-		_T("Tcaron"),
-		_T("Tcedil"),
-		_T("Tcy"),
-		_T("Tfr"),
-		_T("Therefore"),
-		_T("Theta"),
-		_T("ThickSpace"),
-		_T("ThinSpace"),
-		_T("Tilde"),
-		_T("TildeEqual"),
-		_T("TildeFullEqual"),
-		_T("TildeTilde"),
-		_T("Topf"),
-		_T("TripleDot"),
-		_T("Tscr"),
-		_T("Tstrok"),
-		_T("Uacute"),
-		_T("Uarr"),
-		_T("Uarrocir"),
-		_T("Ubrcy"),
-		_T("Ubreve"),
-		_T("Ucirc"),
-		_T("Ucy"),
-		_T("Udblac"),
-		_T("Ufr"),
-		_T("Ugrave"),
-		_T("Umacr"),
-		_T("UnderBar"),
-		_T("UnderBrace"),
-		_T("UnderBracket"),
-		_T("UnderParenthesis"),
-		_T("Union"),
-		_T("UnionPlus"),
-		_T("Uogon"),
-		_T("Uopf"),
-		_T("UpArrow"),
-		_T("UpArrowBar"),
-		_T("UpArrowDownArrow"),
-		_T("UpDownArrow"),
-		_T("UpEquilibrium"),
-		_T("UpTee"),
-		_T("UpTeeArrow"),
-		_T("Uparrow"),
-		_T("Updownarrow"),
-		_T("UpperLeftArrow"),
-		_T("UpperRightArrow"),
-		_T("Upsi"),
-		_T("Upsilon"),
-		_T("Uring"),
-		_T("Uscr"),
-		_T("Utilde"),
-		_T("Uuml"),
-		_T("VDash"),
-		_T("Vbar"),
-		_T("Vcy"),
-		_T("Vdash"),
-		_T("Vdashl"),
-		_T("Vee"),
-		_T("Verbar"),
-		_T("Vert"),
-		_T("VerticalBar"),
-		_T("VerticalLine"),
-		_T("VerticalSeparator"),
-		_T("VerticalTilde"),
-		_T("VeryThinSpace"),
-		_T("Vfr"),
-		_T("Vopf"),
-		_T("Vscr"),
-		_T("Vvdash"),
-		_T("Wcirc"),
-		_T("Wedge"),
-		_T("Wfr"),
-		_T("Wopf"),
-		_T("Wscr"),
-		_T("Xfr"),
-		_T("Xi"),
-		_T("Xopf"),
-		_T("Xscr"),
-		_T("YAcy"),
-		_T("YIcy"),
-		_T("YUcy"),
-		_T("Yacute"),
-		_T("Ycirc"),
-		_T("Ycy"),
-		_T("Yfr"),
-		_T("Yopf"),
-		_T("Yscr"),
-		_T("Yuml"),
-		_T("ZHcy"),
-		_T("Zacute"),
-		_T("Zcaron"),
-		_T("Zcy"),
-		_T("Zdot"),
-		_T("ZeroWidthSpace"),
-		_T("Zeta"),
-		_T("Zfr"),
-		_T("Zopf"),
-		_T("Zscr"),
-		_T("aacute"),
-		_T("abreve"),
-		_T("ac"),
-		_T("acE"),
-		_T("acd"),
-		_T("acirc"),
-		_T("acute"),
-		_T("acy"),
-		_T("aelig"),
-		_T("af"),
-		_T("afr"),
-		_T("agrave"),
-		_T("alefsym"),
-		_T("aleph"),
-		_T("alpha"),
-		_T("amacr"),
-		_T("amalg"),
-		_T("amp"),
-		_T("and"),
-		_T("andand"),
-		_T("andd"),
-		_T("andslope"),
-		_T("andv"),
-		_T("ang"),
-		_T("ange"),
-		_T("angle"),
-		_T("angmsd"),
-		_T("angmsdaa"),
-		_T("angmsdab"),
-		_T("angmsdac"),
-		_T("angmsdad"),
-		_T("angmsdae"),
-		_T("angmsdaf"),
-		_T("angmsdag"),
-		_T("angmsdah"),
-		_T("angrt"),
-		_T("angrtvb"),
-		_T("angrtvbd"),
-		_T("angsph"),
-		_T("angst"),
-		_T("angzarr"),
-		_T("aogon"),
-		_T("aopf"),
-		_T("ap"),
-		_T("apE"),
-		_T("apacir"),
-		_T("ape"),
-		_T("apid"),
-		_T("apos"),
-		_T("approx"),
-		_T("approxeq"),
-		_T("aring"),
-		_T("ascr"),
-		_T("ast"),
-		_T("asymp"),
-		_T("asympeq"),
-		_T("atilde"),
-		_T("auml"),
-		_T("awconint"),
-		_T("awint"),
-		_T("bNot"),
-		_T("backcong"),
-		_T("backepsilon"),
-		_T("backprime"),
-		_T("backsim"),
-		_T("backsimeq"),
-		_T("barvee"),
-		_T("barwed"),
-		_T("barwedge"),
-		_T("bbrk"),
-		_T("bbrktbrk"),
-		_T("bcong"),
-		_T("bcy"),
-		_T("bdquo"),
-		_T("becaus"),
-		_T("because"),
-		_T("bemptyv"),
-		_T("bepsi"),
-		_T("bernou"),
-		_T("beta"),
-		_T("beth"),
-		_T("between"),
-		_T("bfr"),
-		_T("bigcap"),
-		_T("bigcirc"),
-		_T("bigcup"),
-		_T("bigodot"),
-		_T("bigoplus"),
-		_T("bigotimes"),
-		_T("bigsqcup"),
-		_T("bigstar"),
-		_T("bigtriangledown"),
-		_T("bigtriangleup"),
-		_T("biguplus"),
-		_T("bigvee"),
-		_T("bigwedge"),
-		_T("bkarow"),
-		_T("blacklozenge"),
-		_T("blacksquare"),
-		_T("blacktriangle"),
-		_T("blacktriangledown"),
-		_T("blacktriangleleft"),
-		_T("blacktriangleright"),
-		_T("blank"),
-		_T("blk12"),
-		_T("blk14"),
-		_T("blk34"),
-		_T("block"),
-		_T("bne"),
-		_T("bnequiv"),
-		_T("bnot"),
-		_T("bopf"),
-		_T("bot"),
-		_T("bottom"),
-		_T("bowtie"),
-		_T("boxDL"),
-		_T("boxDR"),
-		_T("boxDl"),
-		_T("boxDr"),
-		_T("boxH"),
-		_T("boxHD"),
-		_T("boxHU"),
-		_T("boxHd"),
-		_T("boxHu"),
-		_T("boxUL"),
-		_T("boxUR"),
-		_T("boxUl"),
-		_T("boxUr"),
-		_T("boxV"),
-		_T("boxVH"),
-		_T("boxVL"),
-		_T("boxVR"),
-		_T("boxVh"),
-		_T("boxVl"),
-		_T("boxVr"),
-		_T("boxbox"),
-		_T("boxdL"),
-		_T("boxdR"),
-		_T("boxdl"),
-		_T("boxdr"),
-		_T("boxh"),
-		_T("boxhD"),
-		_T("boxhU"),
-		_T("boxhd"),
-		_T("boxhu"),
-		_T("boxminus"),
-		_T("boxplus"),
-		_T("boxtimes"),
-		_T("boxuL"),
-		_T("boxuR"),
-		_T("boxul"),
-		_T("boxur"),
-		_T("boxv"),
-		_T("boxvH"),
-		_T("boxvL"),
-		_T("boxvR"),
-		_T("boxvh"),
-		_T("boxvl"),
-		_T("boxvr"),
-		_T("bprime"),
-		_T("breve"),
-		_T("brvbar"),
-		_T("bscr"),
-		_T("bsemi"),
-		_T("bsim"),
-		_T("bsime"),
-		_T("bsol"),
-		_T("bsolb"),
-		_T("bsolhsub"),
-		_T("bull"),
-		_T("bullet"),
-		_T("bump"),
-		_T("bumpE"),
-		_T("bumpe"),
-		_T("bumpeq"),
-		_T("cacute"),
-		_T("cap"),
-		_T("capand"),
-		_T("capbrcup"),
-		_T("capcap"),
-		_T("capcup"),
-		_T("capdot"),
-		_T("caps"),
-		_T("caret"),
-		_T("caron"),
-		_T("ccaps"),
-		_T("ccaron"),
-		_T("ccedil"),
-		_T("ccirc"),
-		_T("ccups"),
-		_T("ccupssm"),
-		_T("cdot"),
-		_T("cedil"),
-		_T("cemptyv"),
-		_T("cent"),
-		_T("centerdot"),
-		_T("cfr"),
-		_T("chcy"),
-		_T("check"),
-		_T("checkmark"),
-		_T("chi"),
-		_T("cir"),
-		_T("cirE"),
-		_T("circ"),
-		_T("circeq"),
-		_T("circlearrowleft"),
-		_T("circlearrowright"),
-		_T("circledR"),
-		_T("circledS"),
-		_T("circledast"),
-		_T("circledcirc"),
-		_T("circleddash"),
-		_T("cire"),
-		_T("cirfnint"),
-		_T("cirmid"),
-		_T("cirscir"),
-		_T("clubs"),
-		_T("clubsuit"),
-		_T("colon"),
-		_T("colone"),
-		_T("coloneq"),
-		_T("comma"),
-		_T("commat"),
-		_T("comp"),
-		_T("compfn"),
-		_T("complement"),
-		_T("complexes"),
-		_T("cong"),
-		_T("congdot"),
-		_T("conint"),
-		_T("copf"),
-		_T("coprod"),
-		_T("copy"),
-		_T("copysr"),
-		_T("crarr"),
-		_T("cross"),
-		_T("cscr"),
-		_T("csub"),
-		_T("csube"),
-		_T("csup"),
-		_T("csupe"),
-		_T("ctdot"),
-		_T("cudarrl"),
-		_T("cudarrr"),
-		_T("cuepr"),
-		_T("cuesc"),
-		_T("cularr"),
-		_T("cularrp"),
-		_T("cup"),
-		_T("cupbrcap"),
-		_T("cupcap"),
-		_T("cupcup"),
-		_T("cupdot"),
-		_T("cupor"),
-		_T("cups"),
-		_T("curarr"),
-		_T("curarrm"),
-		_T("curlyeqprec"),
-		_T("curlyeqsucc"),
-		_T("curlyvee"),
-		_T("curlywedge"),
-		_T("curren"),
-		_T("curvearrowleft"),
-		_T("curvearrowright"),
-		_T("cuvee"),
-		_T("cuwed"),
-		_T("cwconint"),
-		_T("cwint"),
-		_T("cylcty"),
-		_T("dArr"),
-		_T("dHar"),
-		_T("dagger"),
-		_T("daleth"),
-		_T("darr"),
-		_T("dash"),
-		_T("dashv"),
-		_T("dbkarow"),
-		_T("dblac"),
-		_T("dcaron"),
-		_T("dcy"),
-		_T("dd"),
-		_T("ddagger"),
-		_T("ddarr"),
-		_T("ddotseq"),
-		_T("deg"),
-		_T("delta"),
-		_T("demptyv"),
-		_T("dfisht"),
-		_T("dfr"),
-		_T("dharl"),
-		_T("dharr"),
-		_T("diam"),
-		_T("diamond"),
-		_T("diamondsuit"),
-		_T("diams"),
-		_T("die"),
-		_T("digamma"),
-		_T("disin"),
-		_T("div"),
-		_T("divide"),
-		_T("divideontimes"),
-		_T("divonx"),
-		_T("djcy"),
-		_T("dlcorn"),
-		_T("dlcrop"),
-		_T("dollar"),
-		_T("dopf"),
-		_T("dot"),
-		_T("doteq"),
-		_T("doteqdot"),
-		_T("dotminus"),
-		_T("dotplus"),
-		_T("dotsquare"),
-		_T("doublebarwedge"),
-		_T("downarrow"),
-		_T("downdownarrows"),
-		_T("downharpoonleft"),
-		_T("downharpoonright"),
-		_T("drbkarow"),
-		_T("drcorn"),
-		_T("drcrop"),
-		_T("dscr"),
-		_T("dscy"),
-		_T("dsol"),
-		_T("dstrok"),
-		_T("dtdot"),
-		_T("dtri"),
-		_T("dtrif"),
-		_T("duarr"),
-		_T("duhar"),
-		_T("dwangle"),
-		_T("dzcy"),
-		_T("dzigrarr"),
-		_T("eDDot"),
-		_T("eDot"),
-		_T("eacute"),
-		_T("easter"),
-		_T("ecaron"),
-		_T("ecir"),
-		_T("ecirc"),
-		_T("ecolon"),
-		_T("ecy"),
-		_T("edot"),
-		_T("ee"),
-		_T("efDot"),
-		_T("efr"),
-		_T("eg"),
-		_T("egrave"),
-		_T("egs"),
-		_T("egsdot"),
-		_T("el"),
-		_T("elinters"),
-		_T("ell"),
-		_T("els"),
-		_T("elsdot"),
-		_T("emacr"),
-		_T("empty"),
-		_T("emptyset"),
-		_T("emptyv"),
-		_T("emsp"),
-		_T("emsp13"),
-		_T("emsp14"),
-		_T("eng"),
-		_T("ensp"),
-		_T("eogon"),
-		_T("eopf"),
-		_T("epar"),
-		_T("eparsl"),
-		_T("eplus"),
-		_T("epsi"),
-		_T("epsilon"),
-		_T("epsiv"),
-		_T("eqcirc"),
-		_T("eqcolon"),
-		_T("eqsim"),
-		_T("eqslantgtr"),
-		_T("eqslantless"),
-		_T("equals"),
-		_T("equest"),
-		_T("equiv"),
-		_T("equivDD"),
-		_T("eqvparsl"),
-		_T("erDot"),
-		_T("erarr"),
-		_T("escr"),
-		_T("esdot"),
-		_T("esim"),
-		_T("eta"),
-		_T("eth"),
-		_T("euml"),
-		_T("euro"),
-		_T("excl"),
-		_T("exist"),
-		_T("expectation"),
-		_T("exponentiale"),
-		_T("fallingdotseq"),
-		_T("fcy"),
-		_T("female"),
-		_T("ffilig"),
-		_T("fflig"),
-		_T("ffllig"),
-		_T("ffr"),
-		_T("filig"),
-		_T("fjlig"),
-		_T("flat"),
-		_T("fllig"),
-		_T("fltns"),
-		_T("fnof"),
-		_T("fopf"),
-		_T("forall"),
-		_T("fork"),
-		_T("forkv"),
-		_T("fpartint"),
-		_T("frac12"),
-		_T("frac13"),
-		_T("frac14"),
-		_T("frac15"),
-		_T("frac16"),
-		_T("frac18"),
-		_T("frac23"),
-		_T("frac25"),
-		_T("frac34"),
-		_T("frac35"),
-		_T("frac38"),
-		_T("frac45"),
-		_T("frac56"),
-		_T("frac58"),
-		_T("frac78"),
-		_T("frasl"),
-		_T("frown"),
-		_T("fscr"),
-		_T("gE"),
-		_T("gEl"),
-		_T("gacute"),
-		_T("gamma"),
-		_T("gammad"),
-		_T("gap"),
-		_T("gbreve"),
-		_T("gcirc"),
-		_T("gcy"),
-		_T("gdot"),
-		_T("ge"),
-		_T("gel"),
-		_T("geq"),
-		_T("geqq"),
-		_T("geqslant"),
-		_T("ges"),
-		_T("gescc"),
-		_T("gesdot"),
-		_T("gesdoto"),
-		_T("gesdotol"),
-		_T("gesl"),
-		_T("gesles"),
-		_T("gfr"),
-		_T("gg"),
-		_T("ggg"),
-		_T("gimel"),
-		_T("gjcy"),
-		_T("gl"),
-		_T("glE"),
-		_T("gla"),
-		_T("glj"),
-		_T("gnE"),
-		_T("gnap"),
-		_T("gnapprox"),
-		_T("gne"),
-		_T("gneq"),
-		_T("gneqq"),
-		_T("gnsim"),
-		_T("gopf"),
-		_T("grave"),
-		_T("gscr"),
-		_T("gsim"),
-		_T("gsime"),
-		_T("gsiml"),
-		_T("gt"),
-		_T("gtcc"),
-		_T("gtcir"),
-		_T("gtdot"),
-		_T("gtlPar"),
-		_T("gtquest"),
-		_T("gtrapprox"),
-		_T("gtrarr"),
-		_T("gtrdot"),
-		_T("gtreqless"),
-		_T("gtreqqless"),
-		_T("gtrless"),
-		_T("gtrsim"),
-		_T("gvertneqq"),
-		_T("gvnE"),
-		_T("hArr"),
-		_T("hairsp"),
-		_T("half"),
-		_T("hamilt"),
-		_T("hardcy"),
-		_T("harr"),
-		_T("harrcir"),
-		_T("harrw"),
-		_T("hbar"),
-		_T("hcirc"),
-		_T("hearts"),
-		_T("heartsuit"),
-		_T("hellip"),
-		_T("hercon"),
-		_T("hfr"),
-		_T("hksearow"),
-		_T("hkswarow"),
-		_T("hoarr"),
-		_T("homtht"),
-		_T("hookleftarrow"),
-		_T("hookrightarrow"),
-		_T("hopf"),
-		_T("horbar"),
-		_T("hscr"),
-		_T("hslash"),
-		_T("hstrok"),
-		_T("hybull"),
-		_T("hyphen"),
-		_T("iacute"),
-		_T("ic"),
-		_T("icirc"),
-		_T("icy"),
-		_T("iecy"),
-		_T("iexcl"),
-		_T("iff"),
-		_T("ifr"),
-		_T("igrave"),
-		_T("ii"),
-		_T("iiiint"),
-		_T("iiint"),
-		_T("iinfin"),
-		_T("iiota"),
-		_T("ijlig"),
-		_T("imacr"),
-		_T("image"),
-		_T("imagline"),
-		_T("imagpart"),
-		_T("imath"),
-		_T("imof"),
-		_T("imped"),
-		_T("in"),
-		_T("incare"),
-		_T("infin"),
-		_T("infintie"),
-		_T("inodot"),
-		_T("int"),
-		_T("intcal"),
-		_T("integers"),
-		_T("intercal"),
-		_T("intlarhk"),
-		_T("intprod"),
-		_T("iocy"),
-		_T("iogon"),
-		_T("iopf"),
-		_T("iota"),
-		_T("iprod"),
-		_T("iquest"),
-		_T("iscr"),
-		_T("isin"),
-		_T("isinE"),
-		_T("isindot"),
-		_T("isins"),
-		_T("isinsv"),
-		_T("isinv"),
-		_T("it"),
-		_T("itilde"),
-		_T("iukcy"),
-		_T("iuml"),
-		_T("jcirc"),
-		_T("jcy"),
-		_T("jfr"),
-		_T("jmath"),
-		_T("jopf"),
-		_T("jscr"),
-		_T("jsercy"),
-		_T("jukcy"),
-		_T("kappa"),
-		_T("kappav"),
-		_T("kcedil"),
-		_T("kcy"),
-		_T("kfr"),
-		_T("kgreen"),
-		_T("khcy"),
-		_T("kjcy"),
-		_T("kopf"),
-		_T("kscr"),
-		_T("lAarr"),
-		_T("lArr"),
-		_T("lAtail"),
-		_T("lBarr"),
-		_T("lE"),
-		_T("lEg"),
-		_T("lHar"),
-		_T("lacute"),
-		_T("laemptyv"),
-		_T("lagran"),
-		_T("lambda"),
-		_T("lang"),
-		_T("langd"),
-		_T("langle"),
-		_T("lap"),
-		_T("laquo"),
-		_T("larr"),
-		_T("larrb"),
-		_T("larrbfs"),
-		_T("larrfs"),
-		_T("larrhk"),
-		_T("larrlp"),
-		_T("larrpl"),
-		_T("larrsim"),
-		_T("larrtl"),
-		_T("lat"),
-		_T("latail"),
-		_T("late"),
-		_T("lates"),
-		_T("lbarr"),
-		_T("lbbrk"),
-		_T("lbrace"),
-		_T("lbrack"),
-		_T("lbrke"),
-		_T("lbrksld"),
-		_T("lbrkslu"),
-		_T("lcaron"),
-		_T("lcedil"),
-		_T("lceil"),
-		_T("lcub"),
-		_T("lcy"),
-		_T("ldca"),
-		_T("ldquo"),
-		_T("ldquor"),
-		_T("ldrdhar"),
-		_T("ldrushar"),
-		_T("ldsh"),
-		_T("le"),
-		_T("leftarrow"),
-		_T("leftarrowtail"),
-		_T("leftharpoondown"),
-		_T("leftharpoonup"),
-		_T("leftleftarrows"),
-		_T("leftrightarrow"),
-		_T("leftrightarrows"),
-		_T("leftrightharpoons"),
-		_T("leftrightsquigarrow"),
-		_T("leftthreetimes"),
-		_T("leg"),
-		_T("leq"),
-		_T("leqq"),
-		_T("leqslant"),
-		_T("les"),
-		_T("lescc"),
-		_T("lesdot"),
-		_T("lesdoto"),
-		_T("lesdotor"),
-		_T("lesg"),
-		_T("lesges"),
-		_T("lessapprox"),
-		_T("lessdot"),
-		_T("lesseqgtr"),
-		_T("lesseqqgtr"),
-		_T("lessgtr"),
-		_T("lesssim"),
-		_T("lfisht"),
-		_T("lfloor"),
-		_T("lfr"),
-		_T("lg"),
-		_T("lgE"),
-		_T("lhard"),
-		_T("lharu"),
-		_T("lharul"),
-		_T("lhblk"),
-		_T("ljcy"),
-		_T("ll"),
-		_T("llarr"),
-		_T("llcorner"),
-		_T("llhard"),
-		_T("lltri"),
-		_T("lmidot"),
-		_T("lmoust"),
-		_T("lmoustache"),
-		_T("lnE"),
-		_T("lnap"),
-		_T("lnapprox"),
-		_T("lne"),
-		_T("lneq"),
-		_T("lneqq"),
-		_T("lnsim"),
-		_T("loang"),
-		_T("loarr"),
-		_T("lobrk"),
-		_T("longleftarrow"),
-		_T("longleftrightarrow"),
-		_T("longmapsto"),
-		_T("longrightarrow"),
-		_T("looparrowleft"),
-		_T("looparrowright"),
-		_T("lopar"),
-		_T("lopf"),
-		_T("loplus"),
-		_T("lotimes"),
-		_T("lowast"),
-		_T("lowbar"),
-		_T("loz"),
-		_T("lozenge"),
-		_T("lozf"),
-		_T("lpar"),
-		_T("lparlt"),
-		_T("lrarr"),
-		_T("lrcorner"),
-		_T("lrhar"),
-		_T("lrhard"),
-		_T("lrm"),
-		_T("lrtri"),
-		_T("lsaquo"),
-		_T("lscr"),
-		_T("lsh"),
-		_T("lsim"),
-		_T("lsime"),
-		_T("lsimg"),
-		_T("lsqb"),
-		_T("lsquo"),
-		_T("lsquor"),
-		_T("lstrok"),
-		_T("lt"),
-		_T("ltcc"),
-		_T("ltcir"),
-		_T("ltdot"),
-		_T("lthree"),
-		_T("ltimes"),
-		_T("ltlarr"),
-		_T("ltquest"),
-		_T("ltrPar"),
-		_T("ltri"),
-		_T("ltrie"),
-		_T("ltrif"),
-		_T("lurdshar"),
-		_T("luruhar"),
-		_T("lvertneqq"),
-		_T("lvnE"),
-		_T("mDDot"),
-		_T("macr"),
-		_T("male"),
-		_T("malt"),
-		_T("maltese"),
-		_T("map"),
-		_T("mapsto"),
-		_T("mapstodown"),
-		_T("mapstoleft"),
-		_T("mapstoup"),
-		_T("marker"),
-		_T("mcomma"),
-		_T("mcy"),
-		_T("mdash"),
-		_T("measuredangle"),
-		_T("mfr"),
-		_T("mho"),
-		_T("micro"),
-		_T("mid"),
-		_T("midast"),
-		_T("midcir"),
-		_T("middot"),
-		_T("minus"),
-		_T("minusb"),
-		_T("minusd"),
-		_T("minusdu"),
-		_T("mlcp"),
-		_T("mldr"),
-		_T("mnplus"),
-		_T("models"),
-		_T("mopf"),
-		_T("mp"),
-		_T("mscr"),
-		_T("mstpos"),
-		_T("mu"),
-		_T("multimap"),
-		_T("mumap"),
-		_T("nGg"),
-		_T("nGt"),
-		_T("nGtv"),
-		_T("nLeftarrow"),
-		_T("nLeftrightarrow"),
-		_T("nLl"),
-		_T("nLt"),
-		_T("nLtv"),
-		_T("nRightarrow"),
-		_T("nVDash"),
-		_T("nVdash"),
-		_T("nabla"),
-		_T("nacute"),
-		_T("nang"),
-		_T("nap"),
-		_T("napE"),
-		_T("napid"),
-		_T("napos"),
-		_T("napprox"),
-		_T("natur"),
-		_T("natural"),
-		_T("naturals"),
-		_T("nbsp"),
-		_T("nbump"),
-		_T("nbumpe"),
-		_T("ncap"),
-		_T("ncaron"),
-		_T("ncedil"),
-		_T("ncong"),
-		_T("ncongdot"),
-		_T("ncup"),
-		_T("ncy"),
-		_T("ndash"),
-		_T("ne"),
-		_T("neArr"),
-		_T("nearhk"),
-		_T("nearr"),
-		_T("nearrow"),
-		_T("nedot"),
-		_T("nequiv"),
-		_T("nesear"),
-		_T("nesim"),
-		_T("nexist"),
-		_T("nexists"),
-		_T("nfr"),
-		_T("ngE"),
-		_T("nge"),
-		_T("ngeq"),
-		_T("ngeqq"),
-		_T("ngeqslant"),
-		_T("nges"),
-		_T("ngsim"),
-		_T("ngt"),
-		_T("ngtr"),
-		_T("nhArr"),
-		_T("nharr"),
-		_T("nhpar"),
-		_T("ni"),
-		_T("nis"),
-		_T("nisd"),
-		_T("niv"),
-		_T("njcy"),
-		_T("nlArr"),
-		_T("nlE"),
-		_T("nlarr"),
-		_T("nldr"),
-		_T("nle"),
-		_T("nleftarrow"),
-		_T("nleftrightarrow"),
-		_T("nleq"),
-		_T("nleqq"),
-		_T("nleqslant"),
-		_T("nles"),
-		_T("nless"),
-		_T("nlsim"),
-		_T("nlt"),
-		_T("nltri"),
-		_T("nltrie"),
-		_T("nmid"),
-		_T("nopf"),
-		_T("not"),
-		_T("notin"),
-		_T("notinE"),
-		_T("notindot"),
-		_T("notinva"),
-		_T("notinvb"),
-		_T("notinvc"),
-		_T("notni"),
-		_T("notniva"),
-		_T("notnivb"),
-		_T("notnivc"),
-		_T("npar"),
-		_T("nparallel"),
-		_T("nparsl"),
-		_T("npart"),
-		_T("npolint"),
-		_T("npr"),
-		_T("nprcue"),
-		_T("npre"),
-		_T("nprec"),
-		_T("npreceq"),
-		_T("nrArr"),
-		_T("nrarr"),
-		_T("nrarrc"),
-		_T("nrarrw"),
-		_T("nrightarrow"),
-		_T("nrtri"),
-		_T("nrtrie"),
-		_T("nsc"),
-		_T("nsccue"),
-		_T("nsce"),
-		_T("nscr"),
-		_T("nshortmid"),
-		_T("nshortparallel"),
-		_T("nsim"),
-		_T("nsime"),
-		_T("nsimeq"),
-		_T("nsmid"),
-		_T("nspar"),
-		_T("nsqsube"),
-		_T("nsqsupe"),
-		_T("nsub"),
-		_T("nsubE"),
-		_T("nsube"),
-		_T("nsubset"),
-		_T("nsubseteq"),
-		_T("nsubseteqq"),
-		_T("nsucc"),
-		_T("nsucceq"),
-		_T("nsup"),
-		_T("nsupE"),
-		_T("nsupe"),
-		_T("nsupset"),
-		_T("nsupseteq"),
-		_T("nsupseteqq"),
-		_T("ntgl"),
-		_T("ntilde"),
-		_T("ntlg"),
-		_T("ntriangleleft"),
-		_T("ntrianglelefteq"),
-		_T("ntriangleright"),
-		_T("ntrianglerighteq"),
-		_T("nu"),
-		_T("num"),
-		_T("numero"),
-		_T("numsp"),
-		_T("nvDash"),
-		_T("nvHarr"),
-		_T("nvap"),
-		_T("nvdash"),
-		_T("nvge"),
-		_T("nvgt"),
-		_T("nvinfin"),
-		_T("nvlArr"),
-		_T("nvle"),
-		_T("nvlt"),
-		_T("nvltrie"),
-		_T("nvrArr"),
-		_T("nvrtrie"),
-		_T("nvsim"),
-		_T("nwArr"),
-		_T("nwarhk"),
-		_T("nwarr"),
-		_T("nwarrow"),
-		_T("nwnear"),
-		_T("oS"),
-		_T("oacute"),
-		_T("oast"),
-		_T("ocir"),
-		_T("ocirc"),
-		_T("ocy"),
-		_T("odash"),
-		_T("odblac"),
-		_T("odiv"),
-		_T("odot"),
-		_T("odsold"),
-		_T("oelig"),
-		_T("ofcir"),
-		_T("ofr"),
-		_T("ogon"),
-		_T("ograve"),
-		_T("ogt"),
-		_T("ohbar"),
-		_T("ohm"),
-		_T("oint"),
-		_T("olarr"),
-		_T("olcir"),
-		_T("olcross"),
-		_T("oline"),
-		_T("olt"),
-		_T("omacr"),
-		_T("omega"),
-		_T("omicron"),
-		_T("omid"),
-		_T("ominus"),
-		_T("oopf"),
-		_T("opar"),
-		_T("operp"),
-		_T("oplus"),
-		_T("or"),
-		_T("orarr"),
-		_T("ord"),
-		_T("order"),
-		_T("orderof"),
-		_T("ordf"),
-		_T("ordm"),
-		_T("origof"),
-		_T("oror"),
-		_T("orslope"),
-		_T("orv"),
-		_T("oscr"),
-		_T("oslash"),
-		_T("osol"),
-		_T("otilde"),
-		_T("otimes"),
-		_T("otimesas"),
-		_T("ouml"),
-		_T("ovbar"),
-		_T("par"),
-		_T("para"),
-		_T("parallel"),
-		_T("parsim"),
-		_T("parsl"),
-		_T("part"),
-		_T("pcy"),
-		_T("percnt"),
-		_T("period"),
-		_T("permil"),
-		_T("perp"),
-		_T("pertenk"),
-		_T("pfr"),
-		_T("phi"),
-		_T("phiv"),
-		_T("phmmat"),
-		_T("phone"),
-		_T("pi"),
-		_T("pitchfork"),
-		_T("piv"),
-		_T("planck"),
-		_T("planckh"),
-		_T("plankv"),
-		_T("plus"),
-		_T("plusacir"),
-		_T("plusb"),
-		_T("pluscir"),
-		_T("plusdo"),
-		_T("plusdu"),
-		_T("pluse"),
-		_T("plusmn"),
-		_T("plussim"),
-		_T("plustwo"),
-		_T("pm"),
-		_T("pointint"),
-		_T("popf"),
-		_T("pound"),
-		_T("pr"),
-		_T("prE"),
-		_T("prap"),
-		_T("prcue"),
-		_T("pre"),
-		_T("prec"),
-		_T("precapprox"),
-		_T("preccurlyeq"),
-		_T("preceq"),
-		_T("precnapprox"),
-		_T("precneqq"),
-		_T("precnsim"),
-		_T("precsim"),
-		_T("prime"),
-		_T("primes"),
-		_T("prnE"),
-		_T("prnap"),
-		_T("prnsim"),
-		_T("prod"),
-		_T("profalar"),
-		_T("profline"),
-		_T("profsurf"),
-		_T("prop"),
-		_T("propto"),
-		_T("prsim"),
-		_T("prurel"),
-		_T("pscr"),
-		_T("psi"),
-		_T("puncsp"),
-		_T("qfr"),
-		_T("qint"),
-		_T("qopf"),
-		_T("qprime"),
-		_T("qscr"),
-		_T("quaternions"),
-		_T("quatint"),
-		_T("quest"),
-		_T("questeq"),
-		_T("quot"),
-		_T("rAarr"),
-		_T("rArr"),
-		_T("rAtail"),
-		_T("rBarr"),
-		_T("rHar"),
-		_T("race"),
-		_T("racute"),
-		_T("radic"),
-		_T("raemptyv"),
-		_T("rang"),
-		_T("rangd"),
-		_T("range"),
-		_T("rangle"),
-		_T("raquo"),
-		_T("rarr"),
-		_T("rarrap"),
-		_T("rarrb"),
-		_T("rarrbfs"),
-		_T("rarrc"),
-		_T("rarrfs"),
-		_T("rarrhk"),
-		_T("rarrlp"),
-		_T("rarrpl"),
-		_T("rarrsim"),
-		_T("rarrtl"),
-		_T("rarrw"),
-		_T("ratail"),
-		_T("ratio"),
-		_T("rationals"),
-		_T("rbarr"),
-		_T("rbbrk"),
-		_T("rbrace"),
-		_T("rbrack"),
-		_T("rbrke"),
-		_T("rbrksld"),
-		_T("rbrkslu"),
-		_T("rcaron"),
-		_T("rcedil"),
-		_T("rceil"),
-		_T("rcub"),
-		_T("rcy"),
-		_T("rdca"),
-		_T("rdldhar"),
-		_T("rdquo"),
-		_T("rdquor"),
-		_T("rdsh"),
-		_T("real"),
-		_T("realine"),
-		_T("realpart"),
-		_T("reals"),
-		_T("rect"),
-		_T("reg"),
-		_T("rfisht"),
-		_T("rfloor"),
-		_T("rfr"),
-		_T("rhard"),
-		_T("rharu"),
-		_T("rharul"),
-		_T("rho"),
-		_T("rhov"),
-		_T("rightarrow"),
-		_T("rightarrowtail"),
-		_T("rightharpoondown"),
-		_T("rightharpoonup"),
-		_T("rightleftarrows"),
-		_T("rightleftharpoons"),
-		_T("rightrightarrows"),
-		_T("rightsquigarrow"),
-		_T("rightthreetimes"),
-		_T("ring"),
-		_T("risingdotseq"),
-		_T("rlarr"),
-		_T("rlhar"),
-		_T("rlm"),
-		_T("rmoust"),
-		_T("rmoustache"),
-		_T("rnmid"),
-		_T("roang"),
-		_T("roarr"),
-		_T("robrk"),
-		_T("ropar"),
-		_T("ropf"),
-		_T("roplus"),
-		_T("rotimes"),
-		_T("rpar"),
-		_T("rpargt"),
-		_T("rppolint"),
-		_T("rrarr"),
-		_T("rsaquo"),
-		_T("rscr"),
-		_T("rsh"),
-		_T("rsqb"),
-		_T("rsquo"),
-		_T("rsquor"),
-		_T("rthree"),
-		_T("rtimes"),
-		_T("rtri"),
-		_T("rtrie"),
-		_T("rtrif"),
-		_T("rtriltri"),
-		_T("ruluhar"),
-		_T("rx"),
-		_T("sacute"),
-		_T("sbquo"),
-		_T("sc"),
-		_T("scE"),
-		_T("scap"),
-		_T("scaron"),
-		_T("sccue"),
-		_T("sce"),
-		_T("scedil"),
-		_T("scirc"),
-		_T("scnE"),
-		_T("scnap"),
-		_T("scnsim"),
-		_T("scpolint"),
-		_T("scsim"),
-		_T("scy"),
-		_T("sdot"),
-		_T("sdotb"),
-		_T("sdote"),
-		_T("seArr"),
-		_T("searhk"),
-		_T("searr"),
-		_T("searrow"),
-		_T("sect"),
-		_T("semi"),
-		_T("seswar"),
-		_T("setminus"),
-		_T("setmn"),
-		_T("sext"),
-		_T("sfr"),
-		_T("sfrown"),
-		_T("sharp"),
-		_T("shchcy"),
-		_T("shcy"),
-		_T("shortmid"),
-		_T("shortparallel"),
-		_T("shy"),
-		_T("sigma"),
-		_T("sigmaf"),
-		_T("sigmav"),
-		_T("sim"),
-		_T("simdot"),
-		_T("sime"),
-		_T("simeq"),
-		_T("simg"),
-		_T("simgE"),
-		_T("siml"),
-		_T("simlE"),
-		_T("simne"),
-		_T("simplus"),
-		_T("simrarr"),
-		_T("slarr"),
-		_T("smallsetminus"),
-		_T("smashp"),
-		_T("smeparsl"),
-		_T("smid"),
-		_T("smile"),
-		_T("smt"),
-		_T("smte"),
-		_T("smtes"),
-		_T("softcy"),
-		_T("sol"),
-		_T("solb"),
-		_T("solbar"),
-		_T("sopf"),
-		_T("spades"),
-		_T("spadesuit"),
-		_T("spar"),
-		_T("sqcap"),
-		_T("sqcaps"),
-		_T("sqcup"),
-		_T("sqcups"),
-		_T("sqsub"),
-		_T("sqsube"),
-		_T("sqsubset"),
-		_T("sqsubseteq"),
-		_T("sqsup"),
-		_T("sqsupe"),
-		_T("sqsupset"),
-		_T("sqsupseteq"),
-		_T("squ"),
-		_T("square"),
-		_T("squarf"),
-		_T("squf"),
-		_T("srarr"),
-		_T("sscr"),
-		_T("ssetmn"),
-		_T("ssmile"),
-		_T("sstarf"),
-		_T("star"),
-		_T("starf"),
-		_T("straightepsilon"),
-		_T("straightphi"),
-		_T("strns"),
-		_T("sub"),
-		_T("subE"),
-		_T("subdot"),
-		_T("sube"),
-		_T("subedot"),
-		_T("submult"),
-		_T("subnE"),
-		_T("subne"),
-		_T("subplus"),
-		_T("subrarr"),
-		_T("subset"),
-		_T("subseteq"),
-		_T("subseteqq"),
-		_T("subsetneq"),
-		_T("subsetneqq"),
-		_T("subsim"),
-		_T("subsub"),
-		_T("subsup"),
-		_T("succ"),
-		_T("succapprox"),
-		_T("succcurlyeq"),
-		_T("succeq"),
-		_T("succnapprox"),
-		_T("succneqq"),
-		_T("succnsim"),
-		_T("succsim"),
-		_T("sum"),
-		_T("sung"),
-		_T("sup"),
-		_T("sup1"),
-		_T("sup2"),
-		_T("sup3"),
-		_T("supE"),
-		_T("supdot"),
-		_T("supdsub"),
-		_T("supe"),
-		_T("supedot"),
-		_T("suphsol"),
-		_T("suphsub"),
-		_T("suplarr"),
-		_T("supmult"),
-		_T("supnE"),
-		_T("supne"),
-		_T("supplus"),
-		_T("supset"),
-		_T("supseteq"),
-		_T("supseteqq"),
-		_T("supsetneq"),
-		_T("supsetneqq"),
-		_T("supsim"),
-		_T("supsub"),
-		_T("supsup"),
-		_T("swArr"),
-		_T("swarhk"),
-		_T("swarr"),
-		_T("swarrow"),
-		_T("swnwar"),
-		_T("szlig"),
-		_T("target"),
-		_T("tau"),
-		_T("tbrk"),
-		_T("tcaron"),
-		_T("tcedil"),
-		_T("tcy"),
-		_T("tdot"),
-		_T("telrec"),
-		_T("tfr"),
-		_T("there4"),
-		_T("therefore"),
-		_T("theta"),
-		_T("thetasym"),
-		_T("thetav"),
-		_T("thickapprox"),
-		_T("thicksim"),
-		_T("thinsp"),
-		_T("thkap"),
-		_T("thksim"),
-		_T("thorn"),
-		_T("tilde"),
-		_T("times"),
-		_T("timesb"),
-		_T("timesbar"),
-		_T("timesd"),
-		_T("tint"),
-		_T("toea"),
-		_T("top"),
-		_T("topbot"),
-		_T("topcir"),
-		_T("topf"),
-		_T("topfork"),
-		_T("tosa"),
-		_T("tprime"),
-		_T("trade"),
-		_T("triangle"),
-		_T("triangledown"),
-		_T("triangleleft"),
-		_T("trianglelefteq"),
-		_T("triangleq"),
-		_T("triangleright"),
-		_T("trianglerighteq"),
-		_T("tridot"),
-		_T("trie"),
-		_T("triminus"),
-		_T("triplus"),
-		_T("trisb"),
-		_T("tritime"),
-		_T("trpezium"),
-		_T("tscr"),
-		_T("tscy"),
-		_T("tshcy"),
-		_T("tstrok"),
-		_T("twixt"),
-		_T("twoheadleftarrow"),
-		_T("twoheadrightarrow"),
-		_T("uArr"),
-		_T("uHar"),
-		_T("uacute"),
-		_T("uarr"),
-		_T("ubrcy"),
-		_T("ubreve"),
-		_T("ucirc"),
-		_T("ucy"),
-		_T("udarr"),
-		_T("udblac"),
-		_T("udhar"),
-		_T("ufisht"),
-		_T("ufr"),
-		_T("ugrave"),
-		_T("uharl"),
-		_T("uharr"),
-		_T("uhblk"),
-		_T("ulcorn"),
-		_T("ulcorner"),
-		_T("ulcrop"),
-		_T("ultri"),
-		_T("umacr"),
-		_T("uml"),
-		_T("uogon"),
-		_T("uopf"),
-		_T("uparrow"),
-		_T("updownarrow"),
-		_T("upharpoonleft"),
-		_T("upharpoonright"),
-		_T("uplus"),
-		_T("upsi"),
-		_T("upsih"),
-		_T("upsilon"),
-		_T("upuparrows"),
-		_T("urcorn"),
-		_T("urcorner"),
-		_T("urcrop"),
-		_T("uring"),
-		_T("urtri"),
-		_T("uscr"),
-		_T("utdot"),
-		_T("utilde"),
-		_T("utri"),
-		_T("utrif"),
-		_T("uuarr"),
-		_T("uuml"),
-		_T("uwangle"),
-		_T("vArr"),
-		_T("vBar"),
-		_T("vBarv"),
-		_T("vDash"),
-		_T("vangrt"),
-		_T("varepsilon"),
-		_T("varkappa"),
-		_T("varnothing"),
-		_T("varphi"),
-		_T("varpi"),
-		_T("varpropto"),
-		_T("varr"),
-		_T("varrho"),
-		_T("varsigma"),
-		_T("varsubsetneq"),
-		_T("varsubsetneqq"),
-		_T("varsupsetneq"),
-		_T("varsupsetneqq"),
-		_T("vartheta"),
-		_T("vartriangleleft"),
-		_T("vartriangleright"),
-		_T("vcy"),
-		_T("vdash"),
-		_T("vee"),
-		_T("veebar"),
-		_T("veeeq"),
-		_T("vellip"),
-		_T("verbar"),
-		_T("vert"),
-		_T("vfr"),
-		_T("vltri"),
-		_T("vnsub"),
-		_T("vnsup"),
-		_T("vopf"),
-		_T("vprop"),
-		_T("vrtri"),
-		_T("vscr"),
-		_T("vsubnE"),
-		_T("vsubne"),
-		_T("vsupnE"),
-		_T("vsupne"),
-		_T("vzigzag"),
-		_T("wcirc"),
-		_T("wedbar"),
-		_T("wedge"),
-		_T("wedgeq"),
-		_T("weierp"),
-		_T("wfr"),
-		_T("wopf"),
-		_T("wp"),
-		_T("wr"),
-		_T("wreath"),
-		_T("wscr"),
-		_T("xcap"),
-		_T("xcirc"),
-		_T("xcup"),
-		_T("xdtri"),
-		_T("xfr"),
-		_T("xhArr"),
-		_T("xharr"),
-		_T("xi"),
-		_T("xlArr"),
-		_T("xlarr"),
-		_T("xmap"),
-		_T("xnis"),
-		_T("xodot"),
-		_T("xopf"),
-		_T("xoplus"),
-		_T("xotime"),
-		_T("xrArr"),
-		_T("xrarr"),
-		_T("xscr"),
-		_T("xsqcup"),
-		_T("xuplus"),
-		_T("xutri"),
-		_T("xvee"),
-		_T("xwedge"),
-		_T("yacute"),
-		_T("yacy"),
-		_T("ycirc"),
-		_T("ycy"),
-		_T("yen"),
-		_T("yfr"),
-		_T("yicy"),
-		_T("yopf"),
-		_T("yscr"),
-		_T("yucy"),
-		_T("yuml"),
-		_T("zacute"),
-		_T("zcaron"),
-		_T("zcy"),
-		_T("zdot"),
-		_T("zeetrf"),
-		_T("zeta"),
-		_T("zfr"),
-		_T("zhcy"),
-		_T("zigrarr"),
-		_T("zopf"),
-		_T("zscr"),
-		_T("zwj"),
-		_T("zwnj"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszHtmlEntityNameList);
+	return s_HtmlEntityNameHash.Find(pszChars, nLength);
 }
 
 TESTCASE
@@ -104,6 +104,82 @@ BOOL xiskeyword(LPCTSTR key, UINT len, T (&r)[N])
 	return xiskeyword<compare>(key, len, eastl::begin(r), eastl::end(r));
 }
 
+/**
+ * @brief Minimal perfect hash index over a keyword list as accepted by xiskeyword().
+ * Classifies an identifier by a single hash computation and one string comparison.
+ * Case folding for case-insensitive lists is applied to the keywords upfront.
+ * Instances live at namespace scope, so that they are built before any compare
+ * threads come to look up keywords.
+ */
+class KeywordHashBase
+{
+protected:
+	struct Slot
+	{
+		LPCTSTR key;
+		UINT len;
+		BOOL value;
+	};
+	LPCTSTR const *const m_lower;
+	LPCTSTR const *const m_upper;
+	bool const m_fold;
+	std::vector<int> m_displace; /**< Displacement or slot per bucket. */
+	std::vector<Slot> m_slots; /**< One slot per keyword. */
+	KeywordHashBase(LPCTSTR const *lower, LPCTSTR const *upper, bool fold);
+	static bool Hash(LPCTSTR key, UINT len, bool fold, UINT &h1, UINT &h2)
+	{
+		h1 = 2166136261U;
+		h2 = len;
+		for (UINT i = 0; i < len; ++i)
+		{
+			UINT c = key[i];
+			// Leave non-ASCII identifiers to the locale aware comparison
+			if (c > 0x7F)
+				return false;
+			if (fold && c - 'A' < 26)
+				c |= 0x20;
+			h1 = (h1 ^ c) * 16777619U;
+			h2 = (h2 + c) * 0x9E3779B1U;
+		}
+		return true;
+	}
+	static UINT Mix(UINT h, int d)
+	{
+		h += d * 0x85EBCA6BU;
+		h ^= h >> 16;
+		h *= 0x85EBCA6BU;
+		h ^= h >> 13;
+		h *= 0xC2B2AE35U;
+		h ^= h >> 16;
+		return h;
+	}
+	Slot const &Probe(UINT h1, UINT h2) const
+	{
+		UINT const n = static_cast<UINT>(m_slots.size());
+		int const d = m_displace[h1 % n];
+		return m_slots[d < 0 ? ~d : Mix(h2, d) % n];
+	}
+};
+
+template<int (*compare)(LPCTSTR, LPCTSTR, size_t)>
+class KeywordHash : KeywordHashBase
+{
+public:
+	template<size_t N>
+	explicit KeywordHash(LPCTSTR const (&r)[N])
+		: KeywordHashBase(eastl::begin(r), eastl::end(r), compare != _tcsncmp)
+	{
+	}
+	BOOL Find(LPCTSTR key, UINT len) const
+	{
+		UINT h1, h2;
+		if (m_slots.empty() || !Hash(key, len, m_fold, h1, h2))
+			return xiskeyword<compare>(key, len, m_lower, m_upper);
+		Slot const &slot = Probe(h1, h2);
+		return slot.len == len && compare(slot.key, key, len) == 0 ? slot.value : FALSE;
+	}
+};
+
 template<int (*compare)(LPCTSTR, LPCTSTR, size_t), size_t N>
 BOOL xisequal(LPCTSTR key, size_t len, TCHAR const (&r)[N])
 {
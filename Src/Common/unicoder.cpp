@@ -169,6 +169,182 @@ void buffer::resize(unsigned int newSize)
 	}
 }
 
+/** @brief A machine word with the high bit of each byte set. */
+static const UINT_PTR HighBits = ~static_cast<UINT_PTR>(0) / 0xFF * 0x80;
+
+/**
+ * @brief Swap the bytes of each UCS-2 character, a machine word at a time.
+ * @param [out] dst Output, which may be the same as src.
+ * @param [in] src Input.
+ * @param [in] bytes Size of input in bytes.
+ */
+static void SwapBytes(unsigned char *dst, const unsigned char *src, size_t bytes)
+{
+	UINT_PTR const LowBytes = ~static_cast<UINT_PTR>(0) / 0xFFFF * 0xFF;
+	size_t i = 0;
+	for (; i + sizeof(UINT_PTR) <= bytes; i += sizeof(UINT_PTR))
+	{
+		UINT_PTR w;
+		memcpy(&w, src + i, sizeof w);
+		w = (w & LowBytes) << 8 | (w >> 8) & LowBytes;
+		memcpy(dst + i, &w, sizeof w);
+	}
+	for (; i + 1 < bytes; i += 2)
+	{
+		unsigned char const c = src[i];
+		dst[i] = src[i + 1];
+		dst[i + 1] = c;
+	}
+	if (i < bytes)
+		dst[i] = src[i];
+}
+
+/**
+ * @brief Convert between native and UCS-2 character of given byte order.
+ * @param [in] u The character.
+ * @param [in] shift 8 to swap bytes, or 0 to keep them as they are.
+ */
+static inline unsigned Unit(unsigned u, int shift)
+{
+	return static_cast<WCHAR>(u << shift | u >> (16 - shift));
+}
+
+/**
+ * @brief Convert well-formed UTF-8 to UCS-2 (UTF-16).
+ * Stops at the first sequence which is ill-formed or cut off by the end of
+ * input, so that the caller can leave the rest to the system.
+ * @param [in] src UTF-8 input.
+ * @param [in] srcbytes Size of input in bytes.
+ * @param [out] dst Output, with room for srcbytes characters.
+ * @param [in] shift 8 for UCS-2BE output, or 0 for UCS-2LE output.
+ * @param [out] wchars Number of characters written.
+ * @return Number of bytes converted.
+ */
+static size_t Utf8ToUcs2(const unsigned char *src, size_t srcbytes,
+	WCHAR *dst, int shift, size_t &wchars)
+{
+	const unsigned char *p = src;
+	const unsigned char *const q = src + srcbytes;
+	WCHAR *d = dst;
+	while (p < q)
+	{
+		// Widen runs of ASCII a machine word at a time
+		UINT_PTR w;
+		while (static_cast<size_t>(q - p) >= sizeof w &&
+			(memcpy(&w, p, sizeof w), w & HighBits) == 0)
+		{
+			for (size_t i = 0; i < sizeof w; ++i)
+				d[i] = static_cast<WCHAR>(p[i] << shift);
+			p += sizeof w;
+			d += sizeof w;
+		}
+		if (p == q)
+			break;
+		unsigned cp = *p;
+		// Number of bytes in sequence, as told by its lead byte
+		size_t const n = cp < 0x80 ? 1 : cp < 0xC2 ? 0 : cp < 0xE0 ? 2 : cp < 0xF0 ? 3 : cp < 0xF5 ? 4 : 0;
+		if (n == 0)
+			break;
+		// Bits of code point in lead byte
+		cp &= 0x7F >> n - (n == 1);
+		if (static_cast<size_t>(q - p) < n)
+			break;
+		size_t i = 1;
+		while (i < n && (p[i] & 0xC0) == 0x80)
+			cp = cp << 6 | p[i++] & 0x3F;
+		if (i < n)
+			break;
+		// Reject overlong forms, surrogates, and anything beyond U+10FFFF
+		if (n == 3 ? cp < 0x800 || cp - 0xD800 < 0x800 :
+			n == 4 ? cp < 0x10000 || cp > 0x10FFFF : false)
+		{
+			break;
+		}
+		p += n;
+		if (cp < 0x10000)
+		{
+			*d++ = static_cast<WCHAR>(Unit(cp, shift));
+		}
+		else
+		{
+			cp -= 0x10000;
+			*d++ = static_cast<WCHAR>(Unit(0xD800 | cp >> 10, shift));
+			*d++ = static_cast<WCHAR>(Unit(0xDC00 | cp & 0x3FF, shift));
+		}
+	}
+	wchars = d - dst;
+	return p - src;
+}
+
+/**
+ * @brief Convert well-formed UCS-2 (UTF-16) to UTF-8.
+ * Stops at the first unpaired surrogate, so that the caller can leave the
+ * rest to the system.
+ * @param [in] src UCS-2 input.
+ * @param [in] srcwchars Size of input in characters.
+ * @param [in] shift 8 for UCS-2BE input, or 0 for UCS-2LE input.
+ * @param [out] dst Output, with room for 3 * srcwchars bytes.
+ * @param [out] bytes Number of bytes written.
+ * @return Number of characters converted.
+ */
+static size_t Ucs2ToUtf8(const WCHAR *src, size_t srcwchars,
+	int shift, unsigned char *dst, size_t &bytes)
+{
+	// Bits which are clear in each UCS-2 character of a word of ASCII
+	UINT_PTR const NonAscii = ~static_cast<UINT_PTR>(0) / 0xFFFF * Unit(0xFF80, shift);
+	const WCHAR *p = src;
+	const WCHAR *const q = src + srcwchars;
+	unsigned char *d = dst;
+	while (p < q)
+	{
+		// Narrow runs of ASCII a machine word at a time
+		UINT_PTR w;
+		while (static_cast<size_t>(q - p) >= sizeof w / 2 &&
+			(memcpy(&w, p, sizeof w), w & NonAscii) == 0)
+		{
+			for (size_t i = 0; i < sizeof w / 2; ++i)
+				d[i] = static_cast<unsigned char>(Unit(p[i], shift));
+			p += sizeof w / 2;
+			d += sizeof w / 2;
+		}
+		if (p == q)
+			break;
+		unsigned cp = Unit(*p, shift);
+		if (cp < 0x80)
+		{
+			*d++ = static_cast<unsigned char>(cp);
+		}
+		else if (cp < 0x800)
+		{
+			*d++ = static_cast<unsigned char>(0xC0 | cp >> 6);
+			*d++ = static_cast<unsigned char>(0x80 | cp & 0x3F);
+		}
+		else if (cp - 0xD800 >= 0x800)
+		{
+			*d++ = static_cast<unsigned char>(0xE0 | cp >> 12);
+			*d++ = static_cast<unsigned char>(0x80 | cp >> 6 & 0x3F);
+			*d++ = static_cast<unsigned char>(0x80 | cp & 0x3F);
+		}
+		else
+		{
+			if (cp >= 0xDC00 || q - p < 2)
+				break;
+			unsigned const lo = Unit(p[1], shift);
+			if (lo - 0xDC00 >= 0x400)
+				break;
+			cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+			*d++ = static_cast<unsigned char>(0xF0 | cp >> 18);
+			*d++ = static_cast<unsigned char>(0x80 | cp >> 12 & 0x3F);
+			*d++ = static_cast<unsigned char>(0x80 | cp >> 6 & 0x3F);
+			*d++ = static_cast<unsigned char>(0x80 | cp & 0x3F);
+			++p;
+		}
+		++p;
+	}
+	bytes = d - dst;
+	return p - src;
+}
+
 /**
  * @brief Convert from one text encoding to another; return false if any lossing conversions
  */
@@ -186,38 +362,101 @@ void convert(UNICODESET unicoding1, int codepage1, const unsigned char * src, in
 	{
 		// simple byte swap
 		dest->resize(srcbytes);
-		for (int i = 0; i < srcbytes; i += 2)
+		SwapBytes(dest->ptr, src, srcbytes);
+		dest->size = srcbytes;
+	}
+	else if (unicoding1 == UTF8 && (unicoding2 == UCS2LE || unicoding2 == UCS2BE))
+	{
+		// From UTF-8 to UCS-2, of either byte order, in one pass
+		// Each byte yields at most one character, also if ill-formed
+		int const shift = unicoding2 == UCS2BE ? 8 : 0;
+		dest->resize(srcbytes * 2);
+		WCHAR *const wbuff = reinterpret_cast<WCHAR *>(dest->ptr);
+		size_t wchars;
+		int const done = static_cast<int>(Utf8ToUcs2(src, srcbytes, wbuff, shift, wchars));
+		if (done < srcbytes)
 		{
-			// Byte-swap into destination
-			dest->ptr[i] = src[i+1];
-			dest->ptr[i+1] = src[i];
+			// Leave ill-formed input to the system, to replace it as usual
+			WCHAR *const rest = wbuff + wchars;
+			int const n = MultiByteToWideChar(CP_UTF8, 0,
+				reinterpret_cast<const char *>(src) + done, srcbytes - done,
+				rest, srcbytes - done);
+			if (shift)
+				SwapBytes(reinterpret_cast<unsigned char *>(rest), reinterpret_cast<unsigned char *>(rest), n * 2);
+			wchars += n;
 		}
-		dest->size = srcbytes;
+		dest->size = static_cast<unsigned int>(wchars * 2);
+	}
+	else if ((unicoding1 == UCS2LE || unicoding1 == UCS2BE) && unicoding2 == UTF8)
+	{
+		// From UCS-2, of either byte order, to UTF-8 in one pass
+		// Each character yields at most three bytes, also if unpaired
+		int const shift = unicoding1 == UCS2BE ? 8 : 0;
+		int const srcwchars = srcbytes / 2;
+		dest->resize(srcwchars * 3);
+		const WCHAR *rest = reinterpret_cast<const WCHAR *>(src);
+		size_t bytes;
+		int const done = static_cast<int>(Ucs2ToUtf8(rest, srcwchars, shift, dest->ptr, bytes));
+		if (done < srcwchars)
+		{
+			// Leave unpaired surrogates to the system, to replace them as usual
+			rest += done;
+			buffer swapped(0);
+			if (shift)
+			{
+				swapped.resize((srcwchars - done) * 2);
+				SwapBytes(swapped.ptr, reinterpret_cast<const unsigned char *>(rest), (srcwchars - done) * 2);
+				rest = reinterpret_cast<const WCHAR *>(swapped.ptr);
+			}
+			bytes += WideCharToMultiByte(CP_UTF8, 0, rest, srcwchars - done,
+				reinterpret_cast<char *>(dest->ptr) + bytes,
+				static_cast<int>(dest->capacity - bytes), NULL, NULL);
+		}
+		dest->size = static_cast<unsigned int>(bytes);
 	}
 	else if (unicoding1 == UCS2LE)
 	{
-		// From UCS-2LE to 8-bit (or UTF-8)
+		// From UCS-2LE to 8-bit
 
 		// WideCharToMultiByte: lpDefaultChar & lpUsedDefaultChar must be NULL when using UTF-8
 
-		int destcp = (unicoding2 == UTF8 ? CP_UTF8 : codepage2);
+		int destcp = codepage2;
 		DWORD flags = 0;
-		int bytes = WideCharToMultiByte(destcp, flags, (const wchar_t*)src, srcbytes / 2, 0, 0, NULL, NULL);
-		dest->resize(bytes);
-		bytes = WideCharToMultiByte(destcp, flags,
+		// Most codepages take at most two bytes per character, so try with
+		// that much room, and ask for the size only if it does not suffice
+		dest->resize(srcbytes);
+		int bytes = WideCharToMultiByte(destcp, flags,
 			(const wchar_t*)src, srcbytes / 2,
 			(char *)dest->ptr, dest->capacity,
 			NULL, destcp != CP_UTF8 ? loss : NULL);
+		if (bytes == 0 && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+		{
+			bytes = WideCharToMultiByte(destcp, flags, (const wchar_t*)src, srcbytes / 2, 0, 0, NULL, NULL);
+			dest->resize(bytes);
+			bytes = WideCharToMultiByte(destcp, flags,
+				(const wchar_t*)src, srcbytes / 2,
+				(char *)dest->ptr, dest->capacity,
+				NULL, destcp != CP_UTF8 ? loss : NULL);
+		}
 		dest->size = bytes;
 	}
-	else if (unicoding2 == UCS2LE)
+	else if (unicoding2 == UCS2LE || unicoding2 == UCS2BE)
 	{
-		// From 8-bit (or UTF-8) to UCS-2LE
-		int srccp = (unicoding1 == UTF8 ? CP_UTF8 : codepage1);
+		// From 8-bit to UCS-2LE, and then swap bytes in place for UCS-2BE
+		int srccp = codepage1;
 		DWORD flags = 0;
-		int wchars = MultiByteToWideChar(srccp, flags, (const char*)src, srcbytes, 0, 0);
-		dest->resize(wchars*2);
-		wchars = MultiByteToWideChar(srccp, flags, (const char*)src, srcbytes, (LPWSTR)dest->ptr, dest->capacity / 2);
+		// Codepages yield at most one character per byte, so try with that
+		// much room, and ask for the size only if it does not suffice
+		dest->resize(srcbytes * 2);
+		int wchars = MultiByteToWideChar(srccp, flags, (const char*)src, srcbytes, (LPWSTR)dest->ptr, dest->capacity / 2);
+		if (wchars == 0 && GetLastError() == ERROR_INSUFFICIENT_BUFFER)
+		{
+			wchars = MultiByteToWideChar(srccp, flags, (const char*)src, srcbytes, 0, 0);
+			dest->resize(wchars*2);
+			wchars = MultiByteToWideChar(srccp, flags, (const char*)src, srcbytes, (LPWSTR)dest->ptr, dest->capacity / 2);
+		}
+		if (unicoding2 == UCS2BE)
+			SwapBytes(dest->ptr, dest->ptr, wchars * 2);
 		dest->size = wchars * 2;
 	}
 	else
@@ -229,6 +468,104 @@ void convert(UNICODESET unicoding1, int codepage1, const unsigned char * src, in
 	}
 }
 
+TESTCASE
+{
+	// Compare against the system, and against the former byte by byte swap
+	static const unsigned char Bytes[] =
+	{
+		'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 0x00, 0x7F, 0x80, 0x8F,
+		0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xE1, 0xED,
+		0xEF, 0xF0, 0xF4, 0xF5, 0xFF, 0xD8, 0xDB, 0xDC, 0xDF
+	};
+	unsigned char input[64];
+	buffer output(0), expected(0);
+	unsigned seed = 1;
+	for (int i = 0; i < 100000; ++i)
+	{
+		int const offset = i % 8;
+		int const size = i % (sizeof input - offset);
+		unsigned char *const p = input + offset;
+		for (int j = 0; j < size; ++j)
+		{
+			seed = seed * 1103515245 + 12345;
+			p[j] = Bytes[(seed >> 16) % _countof(Bytes)];
+		}
+		// UTF-8 to UCS-2
+		int wchars = MultiByteToWideChar(CP_UTF8, 0, reinterpret_cast<const char *>(p), size, NULL, 0);
+		expected.resize(wchars * 2);
+		expected.size = MultiByteToWideChar(CP_UTF8, 0, reinterpret_cast<const char *>(p), size,
+			reinterpret_cast<LPWSTR>(expected.ptr), wchars) * 2;
+		convert(UTF8, 0, p, size, UCS2LE, 0, &output);
+		assert(output.size == expected.size && memcmp(output.ptr, expected.ptr, expected.size) == 0);
+		for (unsigned j = 0; j < expected.size; j += 2)
+			std::swap(expected.ptr[j], expected.ptr[j + 1]);
+		convert(UTF8, 0, p, size, UCS2BE, 0, &output);
+		assert(output.size == expected.size && memcmp(output.ptr, expected.ptr, expected.size) == 0);
+		// UCS-2BE to UCS-2LE
+		convert(UCS2BE, 0, expected.ptr, expected.size, UCS2LE, 0, &output);
+		for (unsigned j = 0; j < expected.size; j += 2)
+			std::swap(expected.ptr[j], expected.ptr[j + 1]);
+		assert(output.size == expected.size && memcmp(output.ptr, expected.ptr, expected.size) == 0);
+		// UCS-2 to UTF-8, with random bytes taken as UCS-2LE characters
+		const WCHAR *const w = reinterpret_cast<const WCHAR *>(p);
+		int const bytes = WideCharToMultiByte(CP_UTF8, 0, w, size / 2, NULL, 0, NULL, NULL);
+		expected.resize(bytes);
+		expected.size = WideCharToMultiByte(CP_UTF8, 0, w, size / 2,
+			reinterpret_cast<char *>(expected.ptr), bytes, NULL, NULL);
+		convert(UCS2LE, 0, p, size, UTF8, 0, &output);
+		assert(output.size == expected.size && memcmp(output.ptr, expected.ptr, expected.size) == 0);
+		convert(UCS2LE, 0, p, size & ~1, UCS2BE, 0, &output);
+		buffer swapped(output.size);
+		memcpy(swapped.ptr, output.ptr, swapped.size = output.size);
+		convert(UCS2BE, 0, swapped.ptr, swapped.size, UTF8, 0, &output);
+		assert(output.size == expected.size && memcmp(output.ptr, expected.ptr, expected.size) == 0);
+	}
+	// Round trip of mostly ASCII text, long enough to take the bulk paths
+	buffer text(64 << 10), ucs2(0), swapped(0), result(0);
+	text.size = text.capacity;
+	memset(text.ptr, 'a', text.size);
+	for (unsigned j = 0; j + 2 < text.size; j += 1000)
+	{
+		text.ptr[j] = 0xC3;
+		text.ptr[j + 1] = 0xA4;
+	}
+	convert(UTF8, 0, text.ptr, text.size, UCS2BE, 0, &ucs2);
+	convert(UCS2BE, 0, ucs2.ptr, ucs2.size, UCS2LE, 0, &swapped);
+	convert(UCS2LE, 0, swapped.ptr, swapped.size, UTF8, 0, &result);
+	assert(result.size == text.size && memcmp(result.ptr, text.ptr, text.size) == 0);
+	convert(UCS2BE, 0, ucs2.ptr, ucs2.size, UTF8, 0, &result);
+	assert(result.size == text.size && memcmp(result.ptr, text.ptr, text.size) == 0);
+	return 0;
+}
+
+BENCHMARK
+{
+	// Throughput on mostly ASCII text
+	buffer text(16 << 20), ucs2(0), result(0);
+	text.size = text.capacity;
+	memset(text.ptr, 'a', text.size);
+	for (unsigned j = 0; j + 2 < text.size; j += 1000)
+	{
+		text.ptr[j] = 0xC3;
+		text.ptr[j + 1] = 0xA4;
+	}
+	LARGE_INTEGER freq, t0, t1, t2, t3;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&t0);
+	convert(UTF8, 0, text.ptr, text.size, UCS2BE, 0, &ucs2);
+	QueryPerformanceCounter(&t1);
+	convert(UCS2BE, 0, ucs2.ptr, ucs2.size, UCS2LE, 0, &result);
+	QueryPerformanceCounter(&t2);
+	convert(UCS2BE, 0, ucs2.ptr, ucs2.size, UTF8, 0, &result);
+	QueryPerformanceCounter(&t3);
+	assert(result.size == text.size && memcmp(result.ptr, text.ptr, text.size) == 0);
+	TRACE("UTF-8 to UCS-2BE: %u MB/s, UCS-2 swap: %u MB/s, UCS-2BE to UTF-8: %u MB/s\n",
+		static_cast<UINT>(16 * freq.QuadPart / max<LONGLONG>(t1.QuadPart - t0.QuadPart, 1)),
+		static_cast<UINT>(32 * freq.QuadPart / max<LONGLONG>(t2.QuadPart - t1.QuadPart, 1)),
+		static_cast<UINT>(16 * freq.QuadPart / max<LONGLONG>(t3.QuadPart - t2.QuadPart, 1)));
+	return 0;
+}
+
 } // namespace ucr
 
 inline int CoincidenceOf(int mask) { return mask & mask - 1; }
@@ -37,6 +37,7 @@ enum DiffAlgorithm
 	DIFF_ALGORITHM_XDF_MYERS = 1,
 	DIFF_ALGORITHM_XDF_PATIENCE = 2,
 	DIFF_ALGORITHM_XDF_HISTOGRAM = 3,
+	DIFF_ALGORITHM_AUTO = 4, /**< Choose per file from line statistics */
 };
 
 /**
@@ -7,6 +7,7 @@
 #include "resource.h"
 #include "DiffContext.h"
 #include "CompareStats.h"
+#include "LogFile.h"
 
 const WORD CompareStats::m_rgIDI[N_DIFFIMG] =
 {
@@ -38,6 +39,9 @@ const WORD CompareStats::m_rgIDI[N_DIFFIMG] =
 CompareStats::CompareStats()
 	: m_hEvent(CreateEvent(NULL, TRUE, FALSE, NULL))
 {
+	LARGE_INTEGER li;
+	QueryPerformanceFrequency(&li);
+	m_nFrequency = li.QuadPart;
 	Reset();
 }
 
@@ -51,14 +55,45 @@ CompareStats::~CompareStats()
 
 /**
  * @brief Add compared item.
- * @param [in] code Resultcode to add.
+ * @param [in] di Item whose result to add.
+ * @param [in] iCompareThread Index of the calling compare thread.
  */
-void CompareStats::AddItem(const DIFFITEM *di)
+void CompareStats::AddItem(const DIFFITEM *di, LONG iCompareThread)
 {
+	ThreadState &rThreadState = m_rgThreadState[iCompareThread];
 	RESULT res = GetColImage(di);
-	InterlockedIncrement(&m_counts[res]);
-	InterlockedIncrement(&m_nComparedItems);
-	assert(m_nComparedItems <= m_nTotalItems);
+	++rThreadState.m_counts[res];
+	++rThreadState.m_nComparedItems;
+}
+
+/**
+ * @brief Add what it took to compare one pair of files.
+ * @param [in] metrics Metrics gathered by the compare.
+ * @param [in] nSize Size of the larger file.
+ * @param [in] iCompareThread Index of the calling compare thread.
+ */
+void CompareStats::AddFileMetrics(const FileMetrics &metrics, UINT64 nSize, LONG iCompareThread)
+{
+	ThreadState &rThreadState = m_rgThreadState[iCompareThread];
+	LONGLONG nTicks = 0;
+	for (int i = PHASE_OPEN; i < N_PHASES; ++i)
+	{
+		rThreadState.m_rgPhaseTicks[i] += metrics.rgPhaseTicks[i];
+		nTicks += metrics.rgPhaseTicks[i];
+	}
+	if (metrics.nEngine != ENGINE_NONE)
+	{
+		++rThreadState.m_rgEngineFiles[metrics.nEngine];
+		rThreadState.m_rgEngineBytes[metrics.nEngine] += metrics.nBytesRead;
+		rThreadState.m_rgEngineTicks[metrics.nEngine] += metrics.rgPhaseTicks[PHASE_COMPARE];
+	}
+	if (metrics.nEngine == ENGINE_DIFFUTILS && metrics.nDiffAlgorithm < N_DIFF_ALGORITHMS)
+	{
+		++rThreadState.m_rgAlgorithmFiles[metrics.nDiffAlgorithm];
+		if (metrics.bCostCapped)
+			++rThreadState.m_nCostCappedFiles;
+	}
+	++rThreadState.m_rgLatency[GetSizeBucket(nSize)][GetLatencyBucket(nTicks)];
 }
 
 /**
@@ -68,7 +103,157 @@ void CompareStats::AddItem(const DIFFITEM *di)
  */
 int CompareStats::GetCount(CompareStats::RESULT result) const
 {
-	return m_counts[result];
+	int count = 0;
+	std::vector<ThreadState>::const_iterator it = m_rgThreadState.begin();
+	while (it != m_rgThreadState.end())
+	{
+		count += it->m_counts[result];
+		++it;
+	}
+	return count;
+}
+
+/**
+ * @brief Return count of items compared so far.
+ */
+int CompareStats::GetComparedItems() const
+{
+	int count = 0;
+	std::vector<ThreadState>::const_iterator it = m_rgThreadState.begin();
+	while (it != m_rgThreadState.end())
+	{
+		count += it->m_nComparedItems;
+		++it;
+	}
+	return count;
+}
+
+/**
+ * @brief Return index of bucket for given file size.
+ */
+int CompareStats::GetSizeBucket(UINT64 nSize)
+{
+	int i = 0;
+	UINT64 nLimit = 4 * 1024;
+	while (i < N_SIZE_BUCKETS - 1 && nSize >= nLimit)
+	{
+		nLimit *= 16;
+		++i;
+	}
+	return i;
+}
+
+/**
+ * @brief Return index of bucket for given duration.
+ */
+int CompareStats::GetLatencyBucket(LONGLONG nTicks) const
+{
+	int i = 0;
+	LONGLONG nLimit = m_nFrequency / 1000;
+	while (i < N_LATENCY_BUCKETS - 1 && nTicks >= nLimit)
+	{
+		nLimit *= 10;
+		++i;
+	}
+	return i;
+}
+
+/**
+ * @brief Write the gathered metrics to the log file.
+ * Called once all compare threads are done.
+ */
+void CompareStats::LogMetrics() const
+{
+	static const LPCTSTR rgEngineName[N_ENGINES] =
+	{
+		_T("DiffUtils"),
+		_T("ByteCompare"),
+		_T("BinaryCompare"),
+		_T("TimeSizeCompare"),
+	};
+	static const LPCTSTR rgDiffAlgorithmName[N_DIFF_ALGORITHMS] =
+	{
+		_T("gnu"),
+		_T("myers"),
+		_T("patience"),
+		_T("histogram"),
+	};
+	C_ASSERT(N_DIFF_ALGORITHMS == DIFF_ALGORITHM_AUTO);
+	static const LPCTSTR rgPhaseName[N_PHASES] =
+	{
+		_T("filter"),
+		_T("open"),
+		_T("encoding guess"),
+		_T("compare"),
+	};
+	static const LPCTSTR rgSizeName[N_SIZE_BUCKETS] =
+	{
+		_T("< 4 KiB"),
+		_T("< 64 KiB"),
+		_T("< 1 MiB"),
+		_T("< 16 MiB"),
+		_T("< 256 MiB"),
+		_T(">= 256 MiB"),
+	};
+	// Sum up the shards
+	ThreadState total;
+	std::vector<ThreadState>::const_iterator it = m_rgThreadState.begin();
+	while (it != m_rgThreadState.end())
+	{
+		int i;
+		for (i = 0; i < N_ENGINES; ++i)
+		{
+			total.m_rgEngineFiles[i] += it->m_rgEngineFiles[i];
+			total.m_rgEngineBytes[i] += it->m_rgEngineBytes[i];
+			total.m_rgEngineTicks[i] += it->m_rgEngineTicks[i];
+		}
+		for (i = 0; i < N_DIFF_ALGORITHMS; ++i)
+			total.m_rgAlgorithmFiles[i] += it->m_rgAlgorithmFiles[i];
+		total.m_nCostCappedFiles += it->m_nCostCappedFiles;
+		for (i = 0; i < N_PHASES; ++i)
+			total.m_rgPhaseTicks[i] += it->m_rgPhaseTicks[i];
+		for (i = 0; i < N_SIZE_BUCKETS; ++i)
+			for (int j = 0; j < N_LATENCY_BUCKETS; ++j)
+				total.m_rgLatency[i][j] += it->m_rgLatency[i][j];
+		++it;
+	}
+	LONGLONG const nTicksPerMs = max<LONGLONG>(m_nFrequency / 1000, 1);
+	String s = _T("Compare metrics:");
+	s.append_sprintf(_T("\n\t%u compare threads, %I64d ms collect"),
+		static_cast<UINT>(m_rgThreadState.size()), m_nCollectTicks / nTicksPerMs);
+	int i;
+	for (i = 0; i < N_PHASES; ++i)
+	{
+		s.append_sprintf(_T("\n\t%I64d ms %s"),
+			total.m_rgPhaseTicks[i] / nTicksPerMs, rgPhaseName[i]);
+	}
+	for (i = 0; i < N_ENGINES; ++i)
+	{
+		if (total.m_rgEngineFiles[i] == 0)
+			continue;
+		LONGLONG const nMs = total.m_rgEngineTicks[i] / nTicksPerMs;
+		s.append_sprintf(_T("\n\t%s: %ld files, %I64u bytes, %I64d ms, %I64u KiB/s"),
+			rgEngineName[i], total.m_rgEngineFiles[i], total.m_rgEngineBytes[i], nMs,
+			total.m_rgEngineBytes[i] / max<LONGLONG>(nMs, 1) * 1000 / 1024);
+	}
+	if (total.m_rgEngineFiles[ENGINE_DIFFUTILS] != 0)
+	{
+		s += _T("\n\tDiff algorithms:");
+		for (i = 0; i < N_DIFF_ALGORITHMS; ++i)
+		{
+			if (total.m_rgAlgorithmFiles[i] != 0)
+				s.append_sprintf(_T(" %ld %s,"), total.m_rgAlgorithmFiles[i], rgDiffAlgorithmName[i]);
+		}
+		s.append_sprintf(_T(" %ld cost capped"), total.m_nCostCappedFiles);
+	}
+	s += _T("\n\tLatency histogram (< 1 ms, < 10 ms, < 100 ms, < 1 s, < 10 s, >= 10 s):");
+	for (i = 0; i < N_SIZE_BUCKETS; ++i)
+	{
+		s.append_sprintf(_T("\n\t%-10s"), rgSizeName[i]);
+		for (int j = 0; j < N_LATENCY_BUCKETS; ++j)
+			s.append_sprintf(_T(" %8ld"), total.m_rgLatency[i][j]);
+	}
+	LogFile.Write(CLogFile::LNOTICE, s.c_str());
 }
 
 /**
@@ -103,8 +288,7 @@ const DIFFITEM *CompareStats::GetCurDiffItem()
 void CompareStats::Reset()
 {
 	m_nTotalItems = 0;
-	m_nComparedItems = 0;
-	ZeroMemory(m_counts, sizeof m_counts);
+	m_nCollectTicks = 0;
 	m_rgThreadState.clear();
 	Continue();
 }
@@ -114,8 +298,13 @@ void CompareStats::Reset()
  */
 void CompareStats::SwapSides()
 {
-	eastl::swap(m_counts[DIFFIMG_LUNIQUE], m_counts[DIFFIMG_RUNIQUE]);
-	eastl::swap(m_counts[DIFFIMG_LDIRUNIQUE], m_counts[DIFFIMG_RDIRUNIQUE]);
+	std::vector<ThreadState>::iterator it = m_rgThreadState.begin();
+	while (it != m_rgThreadState.end())
+	{
+		eastl::swap(it->m_counts[DIFFIMG_LUNIQUE], it->m_counts[DIFFIMG_RUNIQUE]);
+		eastl::swap(it->m_counts[DIFFIMG_LDIRUNIQUE], it->m_counts[DIFFIMG_RDIRUNIQUE]);
+		++it;
+	}
 }
 
 /**
@@ -49,6 +49,44 @@ public:
 		N_DIFFIMG
 	};
 
+	/** @brief Compare engines for which metrics are gathered. */
+	enum ENGINE
+	{
+		ENGINE_NONE = -1,
+		ENGINE_DIFFUTILS,
+		ENGINE_BYTECOMPARE,
+		ENGINE_BINARYCOMPARE,
+		ENGINE_TIMESIZECOMPARE,
+		N_ENGINES
+	};
+
+	/** @brief Phases of a folder compare for which times are gathered. */
+	enum PHASE
+	{
+		PHASE_FILTER,
+		PHASE_OPEN,
+		PHASE_ENCODING,
+		PHASE_COMPARE,
+		N_PHASES
+	};
+
+	/** @brief Number of diff algorithms which can run (DiffAlgorithm up to but excluding AUTO). */
+	static const int N_DIFF_ALGORITHMS = 4;
+	/** @brief Number of file size buckets (< 4 KiB, < 64 KiB, ... >= 256 MiB). */
+	static const int N_SIZE_BUCKETS = 6;
+	/** @brief Number of latency buckets (< 1 ms, < 10 ms, ... >= 10 s). */
+	static const int N_LATENCY_BUCKETS = 6;
+
+	/** @brief What it took to compare one pair of files. */
+	struct FileMetrics
+	{
+		ENGINE nEngine; /**< Engine which did the compare */
+		UINT64 nBytesRead; /**< Bytes read from both files */
+		int nDiffAlgorithm; /**< DiffAlgorithm which ran, if nEngine is ENGINE_DIFFUTILS */
+		bool bCostCapped; /**< Minimal diff was given up as too expensive */
+		LONGLONG rgPhaseTicks[N_PHASES]; /**< Performance counter ticks spent per phase */
+	};
+
 	static const WORD m_rgIDI[N_DIFFIMG];
 
 	CompareStats();
@@ -63,10 +101,27 @@ public:
 		rThreadState.m_nHitCount = 0;
 		rThreadState.m_pDiffItem = di;
 	}
-	void AddItem(const DIFFITEM *);
+	void AddItem(const DIFFITEM *, LONG iCompareThread);
+	void AddPhaseTime(PHASE phase, LONGLONG nTicks, LONG iCompareThread)
+	{
+		m_rgThreadState[iCompareThread].m_rgPhaseTicks[phase] += nTicks;
+	}
+	void AddFileMetrics(const FileMetrics &, UINT64 nSize, LONG iCompareThread);
+	void SetCollectTime(LONGLONG nTicks)
+	{
+		m_nCollectTicks = nTicks;
+	}
+	static LONGLONG GetTicks()
+	{
+		LARGE_INTEGER li;
+		QueryPerformanceCounter(&li);
+		return li.QuadPart;
+	}
+	void LogMetrics() const;
 	void IncreaseTotalItems()
 	{
-		InterlockedIncrement(&m_nTotalItems);
+		// Only the collect thread gets here, so don't bother with interlocks
+		++m_nTotalItems;
 	}
 	void SetTotalItems(long nTotalItems)
 	{
@@ -77,7 +132,7 @@ public:
 		return m_nTotalItems;
 	}
 	int GetCount(CompareStats::RESULT result) const;
-	int GetComparedItems() const { return m_nComparedItems; }
+	int GetComparedItems() const;
 	const DIFFITEM *GetCurDiffItem();
 	void Reset();
 	void SwapSides();
@@ -106,20 +161,36 @@ public:
 		SetEvent(m_hEvent);
 	}
 private:
+	static int GetSizeBucket(UINT64 nSize);
+	int GetLatencyBucket(LONGLONG nTicks) const;
+
 	HANDLE m_hEvent;
 	bool paused;
-	long m_counts[N_DIFFIMG]; /**< Table storing result counts */
-	long m_nTotalItems; /**< Total items found to compare */
-	long m_nComparedItems; /**< Compared items so far */
-	struct ThreadState
+	LONGLONG m_nFrequency; /**< Performance counter ticks per second */
+	LONGLONG m_nCollectTicks; /**< Ticks spent on collecting items */
+	/**
+	 * @brief Counters owned by one compare thread.
+	 * Each thread writes only its own shard, so no interlocks are needed.
+	 * Readers sum up the shards.
+	 */
+	struct ThreadState : ZeroInit<ThreadState>
 	{
 		LONG m_nHitCount;
 		const DIFFITEM *m_pDiffItem;
-		ThreadState()
-			: m_nHitCount(0)
-			, m_pDiffItem(NULL)
-		{
-		}
+		long m_counts[N_DIFFIMG]; /**< Table storing result counts */
+		long m_nComparedItems; /**< Compared items so far */
+		long m_rgEngineFiles[N_ENGINES];
+		UINT64 m_rgEngineBytes[N_ENGINES];
+		LONGLONG m_rgEngineTicks[N_ENGINES];
+		long m_rgAlgorithmFiles[N_DIFF_ALGORITHMS];
+		long m_nCostCappedFiles;
+		LONGLONG m_rgPhaseTicks[N_PHASES];
+		long m_rgLatency[N_SIZE_BUCKETS][N_LATENCY_BUCKETS];
+		/** @brief Keep shards of adjacent threads out of each other's cache lines */
+		BYTE m_padding[64];
 	};
 	std::vector<ThreadState> m_rgThreadState;
+	/** @brief Keep m_nTotalItems out of the cache line of m_rgThreadState */
+	BYTE m_padding[64];
+	long m_nTotalItems; /**< Total items found to compare */
 };
@@ -31,231 +31,461 @@
 
 // Note: keep these strings in "wrong" order so we can resolve this file :)
 /** @brief String separating Mine and Theirs blocks. */
-static const TCHAR Separator[] = _T("=======");
+static const char Separator[] = "=======";
 /** @brief String ending Theirs block (and conflict). */
-static const TCHAR TheirsEnd[] = _T(">>>>>>> ");
+static const char TheirsEnd[] = ">>>>>>> ";
 /** @brief String starting Mine block (and conflict). */
-static const TCHAR MineBegin[] = _T("<<<<<<< ");
+static const char MineBegin[] = "<<<<<<< ";
+
+/** @brief Every marker holds a run of this many equal characters. */
+static const int MarkerRun = 7;
 
 /**
- * @brief Check if the file is a conflict file.
- * This function checks if the conflict file marker is found from given file.
- * This is faster than trying to parse a file that is not conflict file.
- * @param [in] conflictFileName Full path to file to check.
- * @return true if given file is a conflict file, false otherwise.
+ * @brief A line in a conflict file.
+ * Lines end with CR, LF, or CR+LF, as with UniMemFile::ReadString().
  */
-bool IsConflictFile(LPCTSTR conflictFileName)
+struct ConflictLine
 {
-	UniMemFile conflictFile;
-	bool startFound = false;
+	const BYTE *begin; /**< First byte of line */
+	const BYTE *end; /**< End of line, excluding EOL */
+	const BYTE *next; /**< Start of next line, after EOL */
 
-	// Search for a conflict marker
-	bool linesToRead = conflictFile.OpenReadOnly(conflictFileName);
-	while (linesToRead && !startFound)
+	bool StartsWith(const char *s, size_t n) const
+	{
+		return static_cast<size_t>(end - begin) >= n && memcmp(begin, s, n) == 0;
+	}
+	const BYTE *Find(const char *s, size_t n) const
 	{
-		String line;
-		bool lossy;
-		String eol;
-		linesToRead = conflictFile.ReadString(line, eol, &lossy);
+		const BYTE *p = begin;
+		while (static_cast<size_t>(end - p) >= n)
+		{
+			p = static_cast<const BYTE *>(memchr(p, s[0], end - p - n + 1));
+			if (p == NULL)
+				break;
+			if (memcmp(p, s, n) == 0)
+				return p;
+			++p;
+		}
+		return NULL;
+	}
+};
 
-		String::size_type pos;
-		pos = line.find(MineBegin);
-		if (pos == 0)
-			startFound = true;
+/**
+ * @brief Find the next line which may hold a conflict marker.
+ * Any such line holds a run of MarkerRun equal marker characters, and any
+ * such run covers one of every MarkerRun bytes. So the search looks at only
+ * every MarkerRun-th byte until it hits a marker character, and only then
+ * looks around it.
+ * @param [in] p Start of a line.
+ * @param [in] end End of file.
+ * @param [out] line The line found.
+ * @return false if no line from p on may hold a marker.
+ */
+static bool FindMarkerLine(const BYTE *p, const BYTE *end, ConflictLine &line)
+{
+	const BYTE *run = p;
+	for (;;)
+	{
+		if (end - run < MarkerRun)
+			return false;
+		BYTE const c = run[MarkerRun - 1];
+		if (c == '<' || c == '=' || c == '>')
+		{
+			const BYTE *q = run + MarkerRun - 1;
+			while (q > run && q[-1] == c)
+				--q;
+			const BYTE *r = q;
+			while (r < end && *r == c && r - q < MarkerRun)
+				++r;
+			if (r - q == MarkerRun)
+			{
+				run = q;
+				break;
+			}
+		}
+		run += MarkerRun;
 	}
+	line.begin = run;
+	while (line.begin > p && line.begin[-1] != '\r' && line.begin[-1] != '\n')
+		--line.begin;
+	line.end = run + MarkerRun;
+	while (line.end < end && *line.end != '\r' && *line.end != '\n')
+		++line.end;
+	line.next = line.end;
+	if (line.next < end)
+	{
+		if (*line.next++ == '\r' && line.next < end && *line.next == '\n')
+			++line.next;
+	}
+	return true;
+}
 
-	return startFound;
+/** @brief Outputs to which a ConflictRange belongs. */
+enum
+{
+	WorkingCopy = 1,
+	NewRevision = 2
+};
+
+/**
+ * @brief A range of bytes to write to the outputs given by sides.
+ */
+struct ConflictRange
+{
+	const BYTE *begin;
+	const BYTE *end;
+	int sides;
+};
+
+/**
+ * @brief Append a range of bytes, joining it with the previous one if possible.
+ */
+static void AddRange(std::vector<ConflictRange> &ranges,
+	const BYTE *begin, const BYTE *end, int sides)
+{
+	if (begin == end)
+		return;
+	if (!ranges.empty())
+	{
+		ConflictRange &last = ranges.back();
+		if (last.end == begin && last.sides == sides)
+		{
+			last.end = end;
+			return;
+		}
+	}
+	ConflictRange range = { begin, end, sides };
+	ranges.push_back(range);
 }
 
 /**
- * @brief Parse a conflict file to separate files.
- * This function parses a conflict file to two different files which can be
- * opened into WinMerge's file compare.
- * @param [in] conflictFileName Full path to conflict file.
- * @param [in] workingCopyFileName Full path for user's modified file in
- *  working copy/working folder.
- * @param [in] newRevisionFileName Full path for revision control file.
+ * @brief Split the bytes of a conflict file into ranges for the two outputs.
+ * Only lines which may hold a marker are looked at. All lines in between
+ * them go to the outputs of the current section as one range.
+ * @param [in] p Start of file.
+ * @param [in] end End of file.
+ * @param [out] ranges Ranges to write, in order of file.
  * @param [out] bNestedConflicts returned as true if nested conflicts found.
- * @return true if conflict file was successfully parsed, false otherwise.
+ * @return true if file holds conflicts.
  */
-bool ParseConflictFile(LPCTSTR conflictFileName,
-		LPCTSTR workingCopyFileName, LPCTSTR newRevisionFileName,
-		bool &bNestedConflicts)
+static bool SplitConflictFile(const BYTE *p, const BYTE *end,
+		std::vector<ConflictRange> &ranges, bool &bNestedConflicts)
 {
-	UniMemFile conflictFile;
-	UniStdioFile workingCopy;
-	UniStdioFile newRevision;
-	String line;
-	String::size_type pos;
-	int state;
+	// Outputs of the lines in each state
+	static const int Sides[] =
+	{
+		WorkingCopy | NewRevision, WorkingCopy, NewRevision, WorkingCopy, NewRevision
+	};
+	int state = 0;
 	int iNestingLevel = 0;
 	bool bResult = false;
-	String revision = _T("none");
 	bNestedConflicts = false;
 
-	// open input file
-	VERIFY(conflictFile.OpenReadOnly(conflictFileName));
-
-	// Create output files
-	VERIFY(workingCopy.Open(workingCopyFileName, _T("wb")));
-	VERIFY(newRevision.Open(newRevisionFileName, _T("wb")));
-
-	state = 0;
-	bool linesToRead = true;
-	do
+	const BYTE *pending = p; // start of lines not yet added to ranges
+	ConflictLine line;
+	while (FindMarkerLine(p, end, line))
 	{
-		bool lossy;
-		String eol;
-		linesToRead = conflictFile.ReadString(line, eol, &lossy);
+		const BYTE *pos;
 		switch (state)
 		{
 			// in common section
 		case 0:
 			// search beginning of conflict section
-			pos = line.find(MineBegin);
-			if (pos == 0)
+			if (line.StartsWith(MineBegin, 8))
 			{
+				AddRange(ranges, pending, line.begin, Sides[state]);
+				pending = line.next;
 				// working copy section starts
 				state = 1;
 				bResult = true;
 			}
-			else
-			{
-				// we're in the common section, so write to both files
-				newRevision.WriteString(line);
-				newRevision.WriteString(eol);
-
-				workingCopy.WriteString(line);
-				workingCopy.WriteString(eol);
-			}
 			break;
 
 			// in working copy section
 		case 1:
 			// search beginning of conflict section
-			pos = line.find(MineBegin);
-			if (pos == 0)
+			if (line.StartsWith(MineBegin, 8))
 			{
-				// nested conflict section starts
+				// nested conflict section starts, and so does the line
+				// after this one, if any, even if it is empty
 				state = 3;
-				workingCopy.WriteString(line);
-				workingCopy.WriteString(eol);
+				if (line.next != line.end)
+					bNestedConflicts = true;
 			}
-			else
+			else if ((pos = line.Find(Separator, 7)) != NULL && pos == line.end - 7)
 			{
-				pos = line.find(Separator);
-				if ((pos != String::npos) && (pos == (line.length() - 7)))
-				{
-					line = line.substr(0, pos);
-					if (!line.empty())
-					{
-						workingCopy.WriteString(line);
-						workingCopy.WriteString(eol);
-					}
-
-					//  new revision section
-					state = 2;
-				}
-				else
-				{
-					workingCopy.WriteString(line);
-					workingCopy.WriteString(eol);
-				}
+				AddRange(ranges, pending, pos, Sides[state]);
+				if (pos != line.begin)
+					AddRange(ranges, line.end, line.next, Sides[state]);
+				pending = line.next;
+				//  new revision section
+				state = 2;
 			}
 			break;
 
 			// in new revision section
 		case 2:
 			// search beginning of nested conflict section
-			pos = line.find(MineBegin);
-			if (pos == 0)
+			if (line.StartsWith(MineBegin, 8))
 			{
 				// nested conflict section starts
 				state = 4;
-				newRevision.WriteString(line);
-				newRevision.WriteString(eol);
 			}
-			else
+			else if ((pos = line.Find(TheirsEnd, 8)) != NULL)
 			{
-				pos = line.find(TheirsEnd);
-				if (pos != String::npos)
-				{
-					revision = line.substr(pos + 8);
-					line = line.substr(0, pos);
-					if (!line.empty())
-					{
-						newRevision.WriteString(line);
-						newRevision.WriteString(eol);
-					}
-
-					//  common section
-					state = 0;
-				}
-				else
-				{
-					newRevision.WriteString(line);
-					newRevision.WriteString(eol);
-				}
+				AddRange(ranges, pending, pos, Sides[state]);
+				if (pos != line.begin)
+					AddRange(ranges, line.end, line.next, Sides[state]);
+				pending = line.next;
+				//  common section
+				state = 0;
 			}
 			break;
 
-
 			// in nested section in working copy section
 		case 3:
+			// in nested section in new revision section
+		case 4:
 			// search beginning of nested conflict section
-			bNestedConflicts = true;
-			pos = line.find(MineBegin);
-			if (pos == 0)
+			if (line.StartsWith(MineBegin, 8))
 			{
 				iNestingLevel++;
 			}
-			else
+			else if (line.Find(TheirsEnd, 8) != NULL)
 			{
-				pos = line.find(TheirsEnd);
-				if (pos != String::npos)
+				if (iNestingLevel == 0)
 				{
-					if (iNestingLevel == 0)
-					{
-						state = 1;
-					}
-					else
-					{
-						iNestingLevel--;
-					}
+					state -= 2;
+				}
+				else
+				{
+					iNestingLevel--;
 				}
 			}
-			workingCopy.WriteString(line);
-			workingCopy.WriteString(eol);
 			break;
+		}
+		p = line.next;
+	}
+	AddRange(ranges, pending, end, Sides[state]);
 
-			// in nested section in new revision section
-		case 4:
-			// search beginning of nested conflict section
-			pos = line.find(MineBegin);
-			if (pos == 0)
+	return bResult;
+}
+
+/**
+ * @brief Write those ranges which belong to the given output.
+ * @return true on success, false on failure.
+ */
+static bool WriteRanges(LPCTSTR fileName,
+		const std::vector<ConflictRange> &ranges, int side)
+{
+	FILE *fp = _tfopen(fileName, _T("wb"));
+	if (fp == NULL)
+		return false;
+	std::vector<ConflictRange>::const_iterator it = ranges.begin();
+	while (it != ranges.end())
+	{
+		if (it->sides & side)
+			fwrite(it->begin, 1, it->end - it->begin, fp);
+		++it;
+	}
+	bool const bFailed = ferror(fp) != 0;
+	return fclose(fp) == 0 && !bFailed;
+}
+
+/**
+ * @brief Check if the file is a conflict file.
+ * This function checks if the conflict file marker is found from given file.
+ * This is faster than trying to parse a file that is not conflict file.
+ * @param [in] conflictFileName Full path to file to check.
+ * @return true if given file is a conflict file, false otherwise.
+ */
+bool IsConflictFile(LPCTSTR conflictFileName)
+{
+	UniMemFile conflictFile;
+	if (!conflictFile.OpenReadOnly(conflictFileName))
+		return false;
+
+	// Search for a conflict marker
+	const BYTE *p = conflictFile.GetBase();
+	const BYTE *const end = p + conflictFile.GetSize();
+	ConflictLine line;
+	while (FindMarkerLine(p, end, line))
+	{
+		if (line.StartsWith(MineBegin, 8))
+			return true;
+		p = line.next;
+	}
+	return false;
+}
+
+/**
+ * @brief Parse a conflict file to separate files.
+ * This function parses a conflict file to two different files which can be
+ * opened into WinMerge's file compare. The bytes of the file are copied to
+ * the outputs as they are, without decoding them.
+ * @param [in] conflictFileName Full path to conflict file.
+ * @param [in] workingCopyFileName Full path for user's modified file in
+ *  working copy/working folder.
+ * @param [in] newRevisionFileName Full path for revision control file.
+ * @param [out] bNestedConflicts returned as true if nested conflicts found.
+ * @return true if conflict file was successfully parsed, false otherwise.
+ */
+bool ParseConflictFile(LPCTSTR conflictFileName,
+		LPCTSTR workingCopyFileName, LPCTSTR newRevisionFileName,
+		bool &bNestedConflicts)
+{
+	UniMemFile conflictFile;
+	bNestedConflicts = false;
+
+	// open input file
+	if (!conflictFile.OpenReadOnly(conflictFileName))
+		return false;
+
+	const BYTE *const base = conflictFile.GetBase();
+	std::vector<ConflictRange> ranges;
+	bool bResult = SplitConflictFile(base, base + conflictFile.GetSize(),
+		ranges, bNestedConflicts);
+
+	// Create output files
+	if (!WriteRanges(workingCopyFileName, ranges, WorkingCopy))
+		bResult = false;
+	if (!WriteRanges(newRevisionFileName, ranges, NewRevision))
+		bResult = false;
+
+	return bResult;
+}
+
+TESTCASE
+{
+	// Compare against the former line by line parser, on a generated corpus
+	static const char *const Lines[] =
+	{
+		"", "common", "<<<<<<< .mine", "<<<<<<<", "x<<<<<<< y", "<<<<<<<<<",
+		"=======", "abc=======", "========", "=======x", "a=======b=======",
+		">>>>>>> .r42", "text>>>>>>> .r1", ">>>>>>>", "a >>>>>>>> b",
+	};
+	static const char *const Eols[] = { "\n", "\r\n", "\r", "" };
+	unsigned seed = 1;
+	for (int i = 0; i < 5000; ++i)
+	{
+		std::string text;
+		int const nLines = i % 16;
+		for (int j = 0; j < nLines; ++j)
+		{
+			seed = seed * 1103515245 + 12345;
+			text += Lines[(seed >> 16) % _countof(Lines)];
+			seed = seed * 1103515245 + 12345;
+			text += Eols[(seed >> 16) % (j + 1 < nLines ? 3 : 4)];
+		}
+
+		std::string workingCopy, newRevision;
+		int state = 0;
+		int iNestingLevel = 0;
+		bool bResult = false;
+		bool bNestedConflicts = false;
+		std::string::size_type k = 0;
+		bool linesToRead;
+		do
+		{
+			std::string::size_type n = k;
+			while (n < text.length() && text[n] != '\r' && text[n] != '\n')
+				++n;
+			std::string line = text.substr(k, n - k);
+			std::string eol;
+			linesToRead = n < text.length();
+			if (linesToRead)
 			{
-				iNestingLevel++;
+				eol = text.substr(n, text[n] == '\r' && text[n + 1] == '\n' ? 2 : 1);
 			}
-			else
+			k = n + eol.length();
+			std::string::size_type pos;
+			switch (state)
 			{
-				pos = line.find(TheirsEnd);
-				if (pos != String::npos)
+			case 0:
+				if (line.find(MineBegin) == 0)
+				{
+					state = 1;
+					bResult = true;
+				}
+				else
+				{
+					newRevision += line + eol;
+					workingCopy += line + eol;
+				}
+				break;
+			case 1:
+				if (line.find(MineBegin) == 0)
+				{
+					state = 3;
+					workingCopy += line + eol;
+				}
+				else if ((pos = line.find(Separator)) != std::string::npos && pos == line.length() - 7)
+				{
+					if (pos != 0)
+						workingCopy += line.substr(0, pos) + eol;
+					state = 2;
+				}
+				else
+				{
+					workingCopy += line + eol;
+				}
+				break;
+			case 2:
+				if (line.find(MineBegin) == 0)
+				{
+					state = 4;
+					newRevision += line + eol;
+				}
+				else if ((pos = line.find(TheirsEnd)) != std::string::npos)
+				{
+					if (pos != 0)
+						newRevision += line.substr(0, pos) + eol;
+					state = 0;
+				}
+				else
+				{
+					newRevision += line + eol;
+				}
+				break;
+			case 3:
+				bNestedConflicts = true;
+				// fall through
+			case 4:
+				if (line.find(MineBegin) == 0)
+				{
+					iNestingLevel++;
+				}
+				else if (line.find(TheirsEnd) != std::string::npos)
 				{
 					if (iNestingLevel == 0)
-					{
-						state = 2;
-					}
+						state -= 2;
 					else
-					{
 						iNestingLevel--;
-					}
 				}
+				(state == 1 || state == 3 ? workingCopy : newRevision) += line + eol;
+				break;
 			}
-			newRevision.WriteString(line);
-			newRevision.WriteString(eol);
-			break;
-		}
-	} while (linesToRead);
+		} while (linesToRead);
 
-	return bResult;
+		const BYTE *const base = reinterpret_cast<const BYTE *>(text.c_str());
+		std::vector<ConflictRange> ranges;
+		bool bNested;
+		bool const bSplit = SplitConflictFile(base, base + text.length(), ranges, bNested);
+		assert(bSplit == bResult);
+		assert(bNested == bNestedConflicts);
+		std::string splitWorkingCopy, splitNewRevision;
+		std::vector<ConflictRange>::const_iterator it = ranges.begin();
+		while (it != ranges.end())
+		{
+			std::string const s(reinterpret_cast<const char *>(it->begin), it->end - it->begin);
+			if (it->sides & WorkingCopy)
+				splitWorkingCopy += s;
+			if (it->sides & NewRevision)
+				splitNewRevision += s;
+			++it;
+		}
+		assert(splitWorkingCopy == workingCopy);
+		assert(splitNewRevision == newRevision);
+	}
+	return 0;
 }
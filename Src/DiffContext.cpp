@@ -26,9 +26,10 @@
 #include "Merge.h"
 #include "FileFilterHelper.h"
 #include "DiffContext.h"
+#include "ArchiveListing.h"
 #include "paths.h"
 #include "codepage_detect.h"
-#include "Common/version.h"
+#include "markdown.h"
 
 /**
  * @brief Force compare to be single-threaded.
@@ -55,7 +56,9 @@ String CDiffContext::GetRightFilepathAndName(const DIFFITEM *di) const
 
 void CDiffContext::SwapSides()
 {
+	StopExtraction();
 	eastl::swap(m_paths[0], m_paths[1]);
+	eastl::swap(m_pArchiveListing[0], m_pArchiveListing[1]);
 }
 
 /**
@@ -68,6 +71,8 @@ void CDiffContext::SwapSides()
  */
 void CDiffContext::UpdateStatusFromDisk(DIFFITEM *di, bool bLeft, bool bRight, bool bMakeWritable, bool bPreserveInfo)
 {
+	bool const bExtracting = !m_rgExtractThreads.empty();
+	StopExtraction();
 	if (bLeft)
 	{
 		if (bPreserveInfo)
@@ -86,6 +91,9 @@ void CDiffContext::UpdateStatusFromDisk(DIFFITEM *di, bool bLeft, bool bRight, b
 		if (!di->isSideLeftOnly())
 			UpdateInfoFromDiskHalf(di, false, bMakeWritable);
 	}
+	// Resume reading properties, including those just cleared
+	if (bExtracting)
+		ExtractProperties();
 }
 
 /**
@@ -93,6 +101,9 @@ void CDiffContext::UpdateStatusFromDisk(DIFFITEM *di, bool bLeft, bool bRight, b
  */
 void CDiffContext::UpdateDiffItemEx(DIFFITEM *di)
 {
+	// Keep extraction off the item until the compare is done with it
+	bool const bExtracting = !m_rgExtractThreads.empty();
+	StopExtraction();
 	UpdateDiffItem(di);
 	// 1. Clear flags
 	di->diffcode &= ~(DIFFCODE::TEXTFLAGS | DIFFCODE::COMPAREFLAGS);
@@ -119,12 +130,15 @@ void CDiffContext::UpdateDiffItemEx(DIFFITEM *di)
 		FolderCmp folderCmp(this);
 		di->diffcode |= folderCmp.prepAndCompareTwoFiles(di);
 	}
+	if (bExtracting)
+		ExtractProperties();
 }
 
 /**
  * @brief Update file information from disk for DIFFITEM.
  * This function updates DIFFITEM's file information from actual file in
- * the disk. This updates info like date, size and attributes.
+ * the disk. This updates info like date, size and attributes. Version and
+ * encoding are left to UpdateProperties().
  * @param [in, out] di DIFFITEM to update (selected side, see bLeft param).
  * @param [in] bLeft If TRUE left side information is updated,
  *  right side otherwise.
@@ -142,16 +156,75 @@ bool CDiffContext::UpdateInfoFromDiskHalf(DIFFITEM *di, bool bLeft, bool bMakeWr
 			SetFileAttributes(filepath.c_str(), attr & ~FILE_ATTRIBUTE_READONLY);
 	}
 
-	if (!dfi.Update(filepath.c_str()))
-		return false;
+	if (dfi.Update(filepath.c_str()))
+		return true;
 
-	if (!di->isDirectory())
+	// Deferred archive entries exist by their stored metadata only
+	if (const ArchiveListing *pListing = m_pArchiveListing[bLeft ? 0 : 1])
 	{
-		UpdateVersion(di, bLeft);
-		GuessCodepageEncoding(filepath.c_str(), &dfi.encoding, m_bGuessEncoding);
+		if (const ArchiveListing::Entry *entry = pListing->FindDeferred(filepath.c_str()))
+		{
+			dfi.mtime = entry->mtime;
+			dfi.size.int64 = entry->size;
+			dfi.flags.attributes = entry->attributes | FILE_ATTRIBUTE_NORMAL;
+			return true;
+		}
 	}
+	return false;
+}
 
-	return true;
+/**
+ * @brief Check if any archive entries are still deferred from extraction.
+ */
+bool CDiffContext::HasDeferredItems() const
+{
+	return m_pArchiveListing[0] && m_pArchiveListing[0]->HasDeferred()
+		|| m_pArchiveListing[1] && m_pArchiveListing[1]->HasDeferred();
+}
+
+/**
+ * @brief Extract deferred archive entries at or below given item.
+ * @param [in] di Item to extract.
+ * @param [in] hwnd Window to own any UI, or NULL.
+ * @return false if extraction failed on either side.
+ */
+bool CDiffContext::ExtractDeferredItem(const DIFFITEM *di, HWND hwnd) const
+{
+	bool bSuccess = true;
+	if (m_pArchiveListing[0] && di->isSideLeftOrBoth())
+	{
+		if (!m_pArchiveListing[0]->Materialize(hwnd, GetLeftFilepathAndName(di).c_str()))
+			bSuccess = false;
+	}
+	if (m_pArchiveListing[1] && di->isSideRightOrBoth())
+	{
+		if (!m_pArchiveListing[1]->Materialize(hwnd, GetRightFilepathAndName(di).c_str()))
+			bSuccess = false;
+	}
+	return bSuccess;
+}
+
+/**
+ * @brief Prepare a file item for being compared.
+ * @return true if stored size and CRC tell the deferred entries on both
+ * sides identical. Otherwise, any deferred side gets extracted, so the item
+ * can be compared from disk.
+ */
+bool CDiffContext::ResolveDeferredItem(const DIFFITEM *di) const
+{
+	if (!HasDeferredItems())
+		return false;
+	const ArchiveListing::Entry *left = NULL;
+	const ArchiveListing::Entry *right = NULL;
+	if (m_pArchiveListing[0] && di->isSideLeftOrBoth())
+		left = m_pArchiveListing[0]->FindDeferred(GetLeftFilepathAndName(di).c_str());
+	if (m_pArchiveListing[1] && di->isSideRightOrBoth())
+		right = m_pArchiveListing[1]->FindDeferred(GetRightFilepathAndName(di).c_str());
+	if (left && right && ArchiveListing::IsIdentical(*left, *right))
+		return true;
+	if (left || right)
+		ExtractDeferredItem(di, NULL);
+	return false;
 }
 
 /**
@@ -169,47 +242,160 @@ static bool CheckFileForVersion(LPCTSTR ext)
 }
 
 /**
- * @brief Load file version from disk.
- * Update fileversion for given item and side from disk. Note that versions
- * are read from only some filetypes. See CheckFileForVersion() function
- * for list of files to check versions.
+ * @brief Load file properties from disk.
+ * Update file version and, unless already known, encoding for given item and
+ * side from disk. Note that versions are read from only some filetypes. See
+ * CheckFileForVersion() function for list of files to check versions.
+ * Does nothing unless properties are invalid, so that concurrent callers
+ * read every file only once.
  * @param [in,out] di DIFFITEM to update.
- * @param [in] bLeft If TRUE left-side file is updated, right-side otherwise.
+ * @param [in] bLeft If true left-side file is updated, right-side otherwise.
  */
-void CDiffContext::UpdateVersion(DIFFITEM *di, BOOL bLeft) const
+void CDiffContext::UpdateProperties(DIFFITEM *di, bool bLeft) const
 {
 	DiffFileInfo &dfi = bLeft ? di->left : di->right;
-	// Check only binary files
+	if (InterlockedCompareExchange(&dfi.versionChecked,
+		DiffFileInfo::VersionBusy, DiffFileInfo::VersionInvalid) != DiffFileInfo::VersionInvalid)
+	{
+		return;
+	}
+	LONG versionChecked = DiffFileInfo::VersionMissing;
 	dfi.version.Clear();
-	dfi.versionChecked = DiffFileInfo::VersionMissing;
+	if (!di->isDirectory() && (bLeft ? !di->isSideRightOnly() : !di->isSideLeftOnly()))
+	{
+		bool const bVersion = CheckFileForVersion(PathFindExtension(dfi.filename.c_str()));
+		bool const bEncoding = !dfi.encoding.IsKnown();
+		if (bVersion || bEncoding)
+		{
+			String const spath = bLeft ? GetLeftFilepathAndName(di) : GetRightFilepathAndName(di);
+			HANDLE const hFile = CreateFile(spath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+			if (hFile != INVALID_HANDLE_VALUE)
+			{
+				if (bVersion)
+				{
+					// Parse the resources directly rather than have the
+					// loader map the file through GetFileVersionInfo()
+					CMarkdown::FileImage fi(reinterpret_cast<LPCTSTR>(hFile), 0, CMarkdown::FileImage::Handle);
+					if (dfi.version.ReadFromImage(fi.pvImage, fi.cbImage))
+						versionChecked = DiffFileInfo::VersionPresent;
+				}
+				if (bEncoding)
+				{
+					GuessCodepageEncoding(spath.c_str(), &dfi.encoding, m_bGuessEncoding, hFile);
+				}
+				CloseHandle(hFile);
+			}
+		}
+	}
+	InterlockedExchange(&dfi.versionChecked, versionChecked);
+}
 
-	if (di->isDirectory())
-		return;
+/**
+ * @brief Copy file properties from one side to the other.
+ * Used when a file has been copied over, so its properties are known.
+ * @param [in,out] di DIFFITEM to update.
+ * @param [in] bToLeft If true right-side properties are copied to left side.
+ */
+void CDiffContext::CopyProperties(DIFFITEM *di, bool bToLeft) const
+{
+	const DiffFileInfo &src = bToLeft ? di->right : di->left;
+	DiffFileInfo &dst = bToLeft ? di->left : di->right;
+	dst.versionChecked = src.HasProperties() ? src.versionChecked : DiffFileInfo::VersionInvalid;
+	dst.version = src.version;
+	dst.encoding = src.encoding;
+	dst.m_textStats = src.m_textStats;
+}
 
-	String spath;
-	if (bLeft)
+/**
+ * @brief Read properties of all items on background threads.
+ * Properties thus become available for sorting without file access on the
+ * UI thread. The window receives MSG_PROPERTIES_READY when all is done.
+ * Called on main thread.
+ */
+void CDiffContext::ExtractProperties()
+{
+	StopExtraction();
+	SYSTEM_INFO sysinfo;
+	GetSystemInfo(&sysinfo);
+	int const nThreads = min<int>(sysinfo.dwNumberOfProcessors, MAX_EXTRACT_THREADS);
+	InitializeCriticalSection(&m_csExtractThread);
+	m_diExtractThread = NULL;
+	m_bStopExtraction = false;
+	m_nExtractThreads = nThreads;
+	for (int i = 0; i < nThreads; ++i)
 	{
-		if (di->isSideRightOnly())
-			return;
-		LPCTSTR ext = PathFindExtension(di->left.filename.c_str());
-		if (!CheckFileForVersion(ext))
-			return;
-		spath = GetLeftFilepathAndName(di);
+		if (HANDLE const hThread = BeginThreadEx(NULL, 0,
+			OException::ThreadProc<CDiffContext, &CDiffContext::ExtractThread>,
+			this, 0, NULL))
+		{
+			SetThreadPriority(hThread, THREAD_PRIORITY_BELOW_NORMAL);
+			m_rgExtractThreads.push_back(hThread);
+		}
+		else
+		{
+			InterlockedDecrement(&m_nExtractThreads);
+		}
 	}
-	else
+	if (m_rgExtractThreads.empty())
+		DeleteCriticalSection(&m_csExtractThread);
+}
+
+/**
+ * @brief Stop reading properties on background threads.
+ * Must be called before items are modified or removed. Items not yet
+ * visited keep their properties invalid.
+ * Called on main thread. Also safe to call while nothing is running.
+ * @return Whether extraction has been running.
+ */
+bool CDiffContext::StopExtraction()
+{
+	if (m_rgExtractThreads.empty())
+		return false;
+	m_bStopExtraction = true;
+	WaitForMultipleObjects(static_cast<DWORD>(m_rgExtractThreads.size()),
+		m_rgExtractThreads.begin(), TRUE, INFINITE);
+	std::vector<HANDLE>::iterator it = m_rgExtractThreads.begin();
+	while (it != m_rgExtractThreads.end())
+		CloseHandle(*it++);
+	m_rgExtractThreads.clear();
+	DeleteCriticalSection(&m_csExtractThread);
+	return true;
+}
+
+/**
+ * @brief Property extraction thread function.
+ * Threads take turns in picking the next item from the list.
+ */
+DWORD CDiffContext::ExtractThread()
+{
+	for (;;)
 	{
-		if (di->isSideLeftOnly())
-			return;
-		LPCTSTR ext = PathFindExtension(di->right.filename.c_str());
-		if (!CheckFileForVersion(ext))
-			return;
-		spath = GetRightFilepathAndName(di);
-	}
+		DIFFITEM *di = NULL;
+		EnterCriticalSection(&m_csExtractThread);
+		if (!m_bStopExtraction)
+		{
+			if (DIFFITEM *p = GetNextDiff(m_diExtractThread))
+				di = m_diExtractThread = p;
+		}
+		LeaveCriticalSection(&m_csExtractThread);
+
+		if (di == NULL)
+			break;
 
-	// Get version info if it exists
-	CVersionInfo ver(spath.c_str());
-	if (ver.GetFixedFileVersion(dfi.version.m_versionMS, dfi.version.m_versionLS))
-		dfi.versionChecked = DiffFileInfo::VersionPresent;
+		if (di->isDirectory() || di->isResultFiltered())
+			continue;
+
+		if (!di->isSideRightOnly())
+			UpdateProperties(di, true);
+		if (!di->isSideLeftOnly())
+			UpdateProperties(di, false);
+	}
+	if (InterlockedDecrement(&m_nExtractThreads) == 0 && !m_bStopExtraction)
+	{
+		if (m_pWindow)
+			m_pWindow->PostMessage(MSG_PROPERTIES_READY);
+	}
+	return 0;
 }
 
 /**
@@ -242,6 +428,7 @@ CDiffContext::CDiffContext
 CDiffContext::~CDiffContext()
 {
 	ASSERT(m_hSemaphore == NULL);
+	StopExtraction();
 }
 
 /**
@@ -274,32 +461,38 @@ bool CDiffContext::ShouldAbort() const
 void CDiffContext::CompareDirectories(bool bOnlyRequested)
 {
 	ASSERT(m_hSemaphore == NULL);
+	StopExtraction();
 
 	m_bAborting = false;
 	m_bOnlyRequested = bOnlyRequested;
+	// A full compare makes up for any refresh
+	if (!m_bOnlyRequested)
+		m_rgRefreshFolders.clear();
 
 	m_hSemaphore = CreateSemaphore(0, 0, LONG_MAX, 0);
 	InitializeCriticalSection(&m_csCompareThread);
 	m_diCompareThread = NULL;
 
+	SYSTEM_INFO sysinfo;
+	GetSystemInfo(&sysinfo);
 	m_nCompareThreads = COptionsMgr::Get(OPT_CMP_COMPARE_THREADS);
 	m_iCompareThread = -1;
 	if (m_nCompareThreads < 0)
 	{
-		SYSTEM_INFO sysinfo;
-		GetSystemInfo(&sysinfo);
 		m_nCompareThreads += sysinfo.dwNumberOfProcessors;
 		if (m_nCompareThreads < 0)
 			m_nCompareThreads = 0;
 	}
+	m_nDiffThreads = max<LONG>(static_cast<LONG>(sysinfo.dwNumberOfProcessors) /
+		max<LONG>(m_nCompareThreads, 1), 1);
 	if (m_nCompareThreads == 0)
 	{
 		m_pCompareStats->SetCompareThreadCount(1);
 		if (!m_bOnlyRequested)
-		{
 			DiffThreadCollect();
-			ReleaseSemaphore(m_hSemaphore, 1, 0);
-		}
+		else if (!m_rgRefreshFolders.empty())
+			DiffThreadRefresh();
+		ReleaseSemaphore(m_hSemaphore, 1, 0);
 		DiffThreadCompare();
 	}
 	else
@@ -314,6 +507,20 @@ void CDiffContext::CompareDirectories(bool bOnlyRequested)
 				CloseHandle(hThread);
 			}
 		}
+		else
+		{
+			HANDLE hThread = NULL;
+			if (!m_rgRefreshFolders.empty())
+			{
+				hThread = BeginThreadEx(NULL, 0,
+					OException::ThreadProc<CDiffContext, &CDiffContext::DiffThreadRefresh>,
+					this, 0, NULL);
+			}
+			if (hThread)
+				CloseHandle(hThread);
+			else
+				ReleaseSemaphore(m_hSemaphore, m_nCompareThreads, 0);
+		}
 		int nThreads = m_nCompareThreads;
 		do
 		{
@@ -356,7 +563,9 @@ DWORD CDiffContext::DiffThreadCollect()
 #endif
 
 		// Build results list (except delaying file comparisons until below)
+		LONGLONG const nCollectStart = CompareStats::GetTicks();
 		DirScan_GetItems(subdir, false, subdir, false, depth, NULL);
+		m_pCompareStats->SetCollectTime(CompareStats::GetTicks() - nCollectStart);
 
 #ifdef _DEBUG
 		_CrtMemCheckpoint(&memStateAfter);
@@ -366,7 +575,10 @@ DWORD CDiffContext::DiffThreadCollect()
 	}
 	catch (OException *e)
 	{
-		e->ReportError(NULL, MB_ICONSTOP | MB_TOPMOST);
+		if (m_piItemSink)
+			m_piItemSink->OnError(this, e->msg);
+		else
+			e->ReportError(NULL, MB_ICONSTOP | MB_TOPMOST);
 		delete e;
 	}
 
@@ -375,6 +587,59 @@ DWORD CDiffContext::DiffThreadCollect()
 	return 0;
 }
 
+/**
+ * @brief Folder refresh thread function.
+ *
+ * Refreshes the folders in m_rgRefreshFolders before compare threads look
+ * for requested items. Compare threads wait for the refresh as a whole,
+ * since it inserts and removes items all over the list.
+ * @return Thread's return value.
+ */
+DWORD CDiffContext::DiffThreadRefresh()
+{
+	try
+	{
+		ASSERT(m_bOnlyRequested);
+
+		LONGLONG const nCollectStart = CompareStats::GetTicks();
+		m_bRefreshed = true;
+		std::vector<String>::const_iterator it = m_rgRefreshFolders.begin();
+		while (it != m_rgRefreshFolders.end())
+		{
+			const String &folder = *it++;
+			DIFFITEM *parent = NULL;
+			// Folders may have gone along with their parents
+			if (!folder.empty() && (parent = FindFolderItem(folder)) == NULL)
+				continue;
+			if (DirScan_RefreshItems(parent) == -1)
+				break;
+		}
+		// Items found unchanged are not compared, so count the others
+		long nTotalItems = 0;
+		DIFFITEM *di = NULL;
+		while ((di = GetNextDiff(di)) != NULL)
+		{
+			if (di->isScanNeeded())
+				++nTotalItems;
+		}
+		m_pCompareStats->SetTotalItems(nTotalItems);
+		m_pCompareStats->SetCollectTime(CompareStats::GetTicks() - nCollectStart);
+	}
+	catch (OException *e)
+	{
+		if (m_piItemSink)
+			m_piItemSink->OnError(this, e->msg);
+		else
+			e->ReportError(NULL, MB_ICONSTOP | MB_TOPMOST);
+		delete e;
+	}
+	m_rgRefreshFolders.clear();
+
+	// Let compare threads start looking for requested items
+	ReleaseSemaphore(m_hSemaphore, m_nCompareThreads, 0);
+	return 0;
+}
+
 /**
  * @brief Folder compare thread function.
  *
@@ -392,11 +657,22 @@ DWORD CDiffContext::DiffThreadCompare()
 		DirScan_CompareItems();
 	if (InterlockedDecrement(&m_nCompareThreads) <= 0)
 	{
+		// Folders may have lost what they told about their contents
+		if (m_bRefreshed)
+		{
+			m_bRefreshed = false;
+			DirScan_UpdateFolderFlags(NULL);
+		}
 		CloseHandle(m_hSemaphore);
 		m_hSemaphore = NULL;
 		DeleteCriticalSection(&m_csCompareThread);
+		m_pCompareStats->LogMetrics();
 		// Send message to UI to update
-		m_pWindow->PostMessage(MSG_UI_UPDATE);
+		if (m_pWindow)
+			m_pWindow->PostMessage(MSG_UI_UPDATE);
+		// Sink may delete the context, so this must come last
+		if (m_piItemSink)
+			m_piItemSink->OnCompareDone(this);
 	}
 	if (SUCCEEDED(hrMultiThreaded))
 		CoUninitialize();
@@ -13,6 +13,20 @@
 
 class IDiffFilter;
 class CompareStats;
+class ArchiveListing;
+class CDiffContext;
+
+/**
+ * @brief Interface for receiving folder compare results as they arrive.
+ * All methods are called on compare threads.
+ */
+class IDiffItemSink
+{
+public:
+	virtual void OnDiffItem(const CDiffContext *, const DIFFITEM *) = 0;
+	virtual void OnError(const CDiffContext *, LPCTSTR) = 0;
+	virtual void OnCompareDone(const CDiffContext *) = 0;
+};
 
 /**
  * The folder compare context.
@@ -43,7 +57,10 @@ public:
 		LPCTSTR pszLeft, LPCTSTR pszRight, int nRecursive, DWORD dwContext);
 	~CDiffContext();
 
-	void UpdateVersion(DIFFITEM *, BOOL bLeft) const;
+	void UpdateProperties(DIFFITEM *, bool bLeft) const;
+	void CopyProperties(DIFFITEM *, bool bToLeft) const;
+	void ExtractProperties();
+	bool StopExtraction();
 
 	//@{
 	/**
@@ -77,7 +94,14 @@ public:
 	bool UpdateInfoFromDiskHalf(DIFFITEM *, bool bLeft, bool bMakeWritable = false);
 	void UpdateStatusFromDisk(DIFFITEM *, bool bLeft, bool bRight, bool bMakeWritable = false, bool bPreserveInfo = false);
 
+	// archive entries which are not extracted
+	bool HasDeferredItems() const;
+	bool ExtractDeferredItem(const DIFFITEM *, HWND) const;
+	bool ResolveDeferredItem(const DIFFITEM *) const;
+
 	IDiffFilter *m_piFilterGlobal; /**< Interface for file filtering. */
+	IDiffItemSink *m_piItemSink; /**< Optional receiver of compare results. */
+	ArchiveListing *m_pArchiveListing[2]; /**< Listings of compared archives, if any. */
 
 	DIFFOPTIONS m_options; /**< Generalized compare options. */
 
@@ -128,8 +152,24 @@ public:
 	 */
 	int m_nCompMethod;
 
+	/**
+	 * Number of threads each file compare may use to diff in parallel.
+	 * Set when the compare starts, so that the compare threads and their
+	 * diff workers together do not outnumber the processors.
+	 */
+	LONG m_nDiffThreads;
+
 	const DWORD m_dwContext; /**< Context code used with CLearCase mrgman files */
 
+	/**
+	 * Folders to refresh when only requested items get compared.
+	 * Folders are relative to the roots, empty for the roots themselves, and
+	 * sorted so that each folder comes before its subfolders. Refreshing a
+	 * folder brings its items in line with what is on disk, and requests the
+	 * items which are new or have changed to be compared.
+	 */
+	std::vector<String> m_rgRefreshFolders;
+
 	bool UpdateDiffItem(DIFFITEM *);
 	void UpdateDiffItemEx(DIFFITEM *);
 // creation and use, called on main thread
@@ -154,20 +194,33 @@ private:
 	LONG m_iCompareThread;
 	bool m_bAborting; /**< Is compare aborting? */
 	bool m_bOnlyRequested; /**< Compare only requested items? */
+	bool m_bRefreshed; /**< Have folders been refreshed? */
 	const int m_nRecursive; /**< Do we include subfolders to compare? */
 	const String empty;
+	/** @brief Upper bound for number of property extraction threads. */
+	static const int MAX_EXTRACT_THREADS = 4;
+	std::vector<HANDLE> m_rgExtractThreads;
+	DIFFITEM *m_diExtractThread;
+	CRITICAL_SECTION m_csExtractThread;
+	LONG m_nExtractThreads;
+	bool m_bStopExtraction;
 // Thread functions
 	DWORD DiffThreadCollect();
+	DWORD DiffThreadRefresh();
 	DWORD DiffThreadCompare();
+	DWORD ExtractThread();
 	int DirScan_GetItems(
 		const String &leftsubdir, bool bLeftUniq,
 		const String &rightsubdir, bool bRightUniq,
 		int depth, DIFFITEM *parent);
+	int DirScan_RefreshItems(DIFFITEM *parent);
+	void DirScan_UpdateFolderFlags(DIFFITEM *parent);
+	DIFFITEM *FindFolderItem(const String &folder) const;
 	DIFFITEM *AddToList(const String &sLeftDir, const String &sRightDir,
 		const DirItem *lent, const DirItem *rent, UINT code, DIFFITEM *parent);
 	void CompareDiffItem(FolderCmp &, DIFFITEM *);
 	void SetDiffItemStats(const FolderCmp &, DIFFITEM *);
-	void StoreDiffData(const DIFFITEM *);
+	void StoreDiffData(const DIFFITEM *, LONG iCompareThread);
 	void DirScan_CompareItems();
 	void DirScan_CompareRequestedItems();
 
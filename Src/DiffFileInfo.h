@@ -34,12 +34,20 @@
 struct DiffFileInfo : public DirItem
 {
 // data
+	/**
+	 * @brief States of properties read by CDiffContext::UpdateProperties().
+	 * Properties are the version, and the encoding unless the compare has
+	 * already determined it. Fields are stable once the state is below
+	 * VersionInvalid.
+	 */
 	enum VersionChecked
 	{
 		VersionMissing,
 		VersionPresent,
-		VersionInvalid
-	} versionChecked;
+		VersionInvalid, /**< Properties have not been read yet. */
+		VersionBusy /**< Properties are being read on some thread. */
+	};
+	LONG versionChecked; /**< One of VersionChecked. */
 	FileVersion version; /**< string of fixed file version, eg, 1.2.3.4 */
 	FileTextEncoding encoding; /**< unicode or codepage info */
 	FileTextStats m_textStats; /**< EOL, zero-byte etc counts */
@@ -49,4 +57,6 @@ struct DiffFileInfo : public DirItem
 	DiffFileInfo(): versionChecked(VersionInvalid) { }
 	void ClearPartial();
 	bool IsEditableEncoding() const;
+	/** @brief Whether version and encoding fields can be relied upon. */
+	bool HasProperties() const { return versionChecked < VersionInvalid; }
 };
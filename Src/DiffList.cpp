@@ -39,7 +39,8 @@ void DIFFRANGE::swap_sides()
  * @brief Default constructor, initialises difflist to 64 items.
  */
 DiffList::DiffList()
-: m_firstSignificant(-1)
+: m_nSignificants(0)
+, m_firstSignificant(-1)
 , m_lastSignificant(-1)
 {
 	m_diffs.reserve(64); // Reserve some initial space to avoid allocations.
@@ -51,6 +52,8 @@ DiffList::DiffList()
 void DiffList::Clear()
 {
 	m_diffs.clear();
+	m_significants.clear();
+	m_nSignificants = 0;
 	m_firstSignificant = -1;
 	m_lastSignificant = -1;
 }
@@ -74,17 +77,7 @@ int DiffList::GetSize() const
  */
 int DiffList::GetSignificantDiffs() const
 {
-	int nSignificants = 0;
-	const int nDiffCount = GetSize();
-
-	for (int i = 0; i < nDiffCount; i++)
-	{
-		if (m_diffs[i].diffrange.op != OP_TRIVIAL)
-		{
-			++nSignificants;
-		}
-	}
-	return nSignificants;
+	return m_nSignificants;
 }
 
 /**
@@ -98,6 +91,8 @@ void DiffList::AddDiff(const DIFFRANGE & di)
 	if (m_diffs.size() == m_diffs.capacity())
 		m_diffs.reserve(m_diffs.size() * 2); // 0x7FFF0000
 	m_diffs.push_back(di);
+	if (di.op != OP_TRIVIAL)
+		++m_nSignificants;
 }
 
 /**
@@ -119,16 +114,7 @@ bool DiffList::IsDiffSignificant(int nDiff) const
  */
 int DiffList::GetSignificantIndex(int nDiff) const
 {
-	int significants = -1;
-
-	for (int i = 0; i <= nDiff; i++)
-	{
-		if (m_diffs[i].diffrange.op != OP_TRIVIAL)
-		{
-			++significants;
-		}
-	}
-	return significants;
+	return m_diffs[nDiff].rank - (IsDiffSignificant(nDiff) ? 0 : 1);
 }
 
 /**
@@ -193,20 +179,18 @@ int DiffList::LineToDiff(UINT nLine) const
  */
 int DiffList::PrevSignificantDiffFromLine(UINT nLine) const
 {
-	int nDiff = -1;
-	const int nDiffCount = GetSize();
-	int i = nDiffCount;
-	while (i > 0)
+	// Use binary search to count the significant diffs which end before line
+	int left = 0; // Left limit
+	int right = static_cast<int>(m_significants.size()); // Right limit
+	while (left < right)
 	{
-		--i;
-		const DIFFRANGE &dr = m_diffs[i].diffrange;
-		if (dr.op != OP_TRIVIAL && dr.dend0 < nLine)
-		{
-			nDiff = i;
-			break;
-		}
+		int middle = (left + right) / 2;
+		if (m_diffs[m_significants[middle]].diffrange.dend0 < nLine)
+			left = middle + 1;
+		else
+			right = middle;
 	}
-	return nDiff;
+	return left > 0 ? m_significants[left - 1] : -1;
 }
 
 /**
@@ -216,35 +200,39 @@ int DiffList::PrevSignificantDiffFromLine(UINT nLine) const
  */
 int DiffList::NextSignificantDiffFromLine(UINT nLine) const
 {
-	int nDiff = -1;
-	const int nDiffCount = GetSize();
-	int i = 0;
-	while (i < nDiffCount)
+	// Use binary search to count the significant diffs which begin at or
+	// before line
+	int left = 0; // Left limit
+	int right = static_cast<int>(m_significants.size()); // Right limit
+	while (left < right)
 	{
-		const DIFFRANGE &dr = m_diffs[i].diffrange;
-		if (dr.op != OP_TRIVIAL && dr.dbegin0 > nLine)
-		{
-			nDiff = i;
-			break;
-		}
-		++i;
+		int middle = (left + right) / 2;
+		if (m_diffs[m_significants[middle]].diffrange.dbegin0 <= nLine)
+			left = middle + 1;
+		else
+			right = middle;
 	}
-	return nDiff;
+	return left < static_cast<int>(m_significants.size()) ? m_significants[left] : -1;
 }
 
 /**
  * @brief Construct the doubly-linked chain of significant differences
+ * Also counts the significant differences before each difference, and
+ * indexes the significant differences.
  */
 void DiffList::ConstructSignificantChain()
 {
 	m_firstSignificant = -1;
 	m_lastSignificant = -1;
+	m_significants.clear();
+	m_significants.reserve(m_nSignificants);
 	int prev = -1;
 	const int nDiffCount = GetSize();
 
 	// must be called after diff list is entirely populated
     for (int i = 0; i < nDiffCount; ++i)
 	{
+		m_diffs[i].rank = static_cast<int>(m_significants.size());
 		if (m_diffs[i].diffrange.op == OP_TRIVIAL)
 		{
 			m_diffs[i].prev = -1;
@@ -253,14 +241,17 @@ void DiffList::ConstructSignificantChain()
 		else
 		{
 			m_diffs[i].prev = prev;
+			m_diffs[i].next = -1;
 			if (prev != -1)
 				m_diffs[prev].next = i;
 			prev = i;
 			if (m_firstSignificant == -1)
 				m_firstSignificant = i;
 			m_lastSignificant = i;
+			m_significants.push_back(i);
 		}
 	}
+	m_nSignificants = static_cast<int>(m_significants.size());
 }
 
 /**
@@ -423,7 +414,58 @@ int DiffList::FinishSyncPoint(int nDiff, int nRealStartLine[])
 
 void DiffList::swap(DiffList &other)
 {
+	eastl::swap(m_nSignificants, other.m_nSignificants);
 	eastl::swap(m_firstSignificant, other.m_firstSignificant);
 	eastl::swap(m_lastSignificant, other.m_lastSignificant);
 	m_diffs.swap(other.m_diffs);
+	m_significants.swap(other.m_significants);
+}
+
+TESTCASE
+{
+	// Compare queries against linear scans of diff lists without views
+	static const OP_TYPE Ops[] = { OP_LEFTONLY, OP_DIFF, OP_RIGHTONLY, OP_TRIVIAL, OP_TRIVIAL };
+	unsigned seed = 1;
+	for (int n = 0; n < 200; ++n)
+	{
+		DiffList list;
+		UINT line = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			DIFFRANGE dr;
+			seed = seed * 1103515245 + 12345;
+			dr.op = Ops[(seed >> 16) % _countof(Ops)];
+			seed = seed * 1103515245 + 12345;
+			dr.dbegin0 = dr.dbegin1 = line += (seed >> 16) % 3;
+			seed = seed * 1103515245 + 12345;
+			dr.dend0 = dr.dend1 = line += (seed >> 16) % 3;
+			++line;
+			list.AddDiff(dr);
+		}
+		list.ConstructSignificantChain();
+		int nSignificants = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			if (list.IsDiffSignificant(i))
+				++nSignificants;
+			assert(list.GetSignificantIndex(i) == nSignificants - 1);
+		}
+		assert(list.GetSignificantDiffs() == nSignificants);
+		for (UINT nLine = 0; nLine <= line + 1; ++nLine)
+		{
+			int nPrev = -1;
+			int nNext = -1;
+			for (int i = 0; i < n; ++i)
+			{
+				const DIFFRANGE *dr = list.DiffRangeAt(i);
+				if (dr->op != OP_TRIVIAL && dr->dend0 < nLine)
+					nPrev = i;
+				if (dr->op != OP_TRIVIAL && dr->dbegin0 > nLine && nNext == -1)
+					nNext = i;
+			}
+			assert(list.PrevSignificantDiffFromLine(nLine) == nPrev);
+			assert(list.NextSignificantDiffFromLine(nLine) == nNext);
+		}
+	}
+	return 0;
 }
@@ -73,7 +73,8 @@ struct DiffRangeInfo
 	DIFFRANGE diffrange;
 	int next; /**< link (array index) for doubly-linked chain of non-trivial DIFFRANGEs */
 	int prev; /**< link (array index) for doubly-linked chain of non-trivial DIFFRANGEs */
-	DiffRangeInfo(const DIFFRANGE & di) : diffrange(di), next(-1), prev(-1) { }
+	int rank; /**< count of non-trivial DIFFRANGEs before this one */
+	DiffRangeInfo(const DIFFRANGE & di) : diffrange(di), next(-1), prev(-1), rank(0) { }
 };
 
 /**
@@ -88,6 +89,9 @@ struct DiffRangeInfo
  *
  * The code assumes diff lists don't grow bigger than 32-bit int type's
  * range. And what a trouble we'd have if we have so many diffs...
+ *
+ * ConstructSignificantChain() also indexes the significant diffs, so that
+ * queries about them take constant or logarithmic time.
  */
 class DiffList
 {
@@ -119,6 +123,14 @@ public:
 
 private:
 	std::vector<DiffRangeInfo> m_diffs; /**< Difference list. */
+	/**
+	 * @brief Indices of significant diffs in m_diffs, in order of lines.
+	 * Diffs do not overlap, so both their first and last lines ascend along
+	 * this index. This holds in either pane's line space, since ghost lines
+	 * make those coincide.
+	 */
+	std::vector<int> m_significants;
+	int m_nSignificants; /**< Count of significant diffs in m_diffs */
 	int m_firstSignificant; /**< Index of first significant diff in m_diffs */
 	int m_lastSignificant; /**< Index of last significant diff in m_diffs */
 };
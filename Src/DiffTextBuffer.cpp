@@ -79,6 +79,7 @@ CDiffTextBuffer::CDiffTextBuffer(CChildFrame *pDoc, int pane)
 , m_unpackerSubcode(0)
 , m_bMixedEOL(false)
 {
+	m_UndoJournal.SetMemoryLimit(COptionsMgr::Get(OPT_UNDO_MEMORY_LIMIT));
 	InitNew();
 }
 
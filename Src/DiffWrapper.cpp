@@ -53,9 +53,15 @@ PATCHOPTIONS::PATCHOPTIONS()
 CDiffWrapper::CDiffWrapper(DiffList *pDiffList)
 : DIFFOPTIONS(NULL)
 , m_codepage(0)
+, m_nDiffThreads(0)
 , m_pDiffList(pDiffList)
 , m_pMovedLines(NULL)
+, m_pPatchStream(NULL)
 {
+	// Callers which run on compare threads of their own lower this
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	m_nDiffThreads = si.dwNumberOfProcessors;
 }
 
 /**
@@ -149,6 +155,17 @@ void CDiffWrapper::SetCreatePatchFile(const String &filename)
 	string_replace(m_sPatchFile, _T('/'), _T('\\'));
 }
 
+/**
+ * @brief Enables/disables patch creation into an already open stream.
+ * The stream is written to, but neither opened nor closed, which lets
+ * callers collect the patch of each file pair before putting it in place.
+ * @param [in] stream Stream to write patch to, or NULL.
+ */
+void CDiffWrapper::SetCreatePatchFile(FILE *stream)
+{
+	m_pPatchStream = stream;
+}
+
 /**
  * @brief Enables/disables moved block detection.
  * @param [in] bDetectMovedBlocks If TRUE moved blocks are detected.
@@ -431,7 +448,7 @@ bool CDiffWrapper::RunFileDiff(DiffFileData &diffdata, TextDefinition const *pTe
 	m_status.bRightMissingNL = diffdata.file[1].missing_newline;
 
 	// Create patch file
-	if (!m_status.bBinaries && !m_sPatchFile.empty())
+	if (!m_status.bBinaries && (!m_sPatchFile.empty() || m_pPatchStream))
 	{
 		WritePatchFile(script, &diffdata);
 	}
@@ -488,7 +505,7 @@ bool CDiffWrapper::AddDiffRange(UINT begin0, UINT end0, UINT begin1, UINT end1,
 	}
 	catch (OException *e)
 	{
-		e->ReportError(theApp.m_pMainWnd->m_hWnd, MB_ICONSTOP);
+		e->ReportError(theApp.m_pMainWnd ? theApp.m_pMainWnd->m_hWnd : NULL, MB_ICONSTOP);
 		delete e;
 	}
 	TRACE("left=%d,%d   right=%d,%d   op=%d\n",
@@ -620,10 +637,13 @@ bool CDiffWrapper::Diff2Files(struct change **diffs, struct comparison *cmp, int
 	try
 	{
 		// Diff files.
+		m_status.nAlgorithmUsed = nDiffAlgorithm;
+		m_status.bCostCapped = false;
 		if (nDiffAlgorithm == DIFF_ALGORITHM_GNU)
 			*diffs = diff_2_files(cmp, bin_status, m_pMovedLines != NULL, bin_file);
 		else
-			*diffs = diff_2_files_xdiff(cmp, m_pMovedLines != NULL, bin_file, nDiffAlgorithm);
+			*diffs = diff_2_files_xdiff(cmp, m_pMovedLines != NULL, bin_file,
+				&m_status.nAlgorithmUsed, &m_status.bCostCapped, m_nDiffThreads);
 	}
 	catch (OException *e)
 	{
@@ -829,8 +849,8 @@ void CDiffWrapper::WritePatchFile(struct change *script, struct comparison *cmp)
 	_tstati64(m_s1File.c_str(), &cmp_patch.file[0].stat);
 	_tstati64(m_s2File.c_str(), &cmp_patch.file[1].stat);
 
-	cmp_patch.outfile = NULL;
-	if (!m_sPatchFile.empty())
+	cmp_patch.outfile = m_pPatchStream;
+	if (cmp_patch.outfile == NULL && !m_sPatchFile.empty())
 	{
 		LPCTSTR mode = bAppendFiles ? _T("a+") : _T("w+");
 		cmp_patch.outfile = _tfopen(m_sPatchFile.c_str(), mode);
@@ -869,7 +889,10 @@ void CDiffWrapper::WritePatchFile(struct change *script, struct comparison *cmp)
 		break;
 	}
 
-	fclose(cmp_patch.outfile);
+	if (cmp_patch.outfile != m_pPatchStream)
+		fclose(cmp_patch.outfile);
+	else if (ferror(cmp_patch.outfile))
+		m_status.bPatchFileFailed = true;
 	cmp_patch.outfile = NULL;
 }
 
@@ -62,6 +62,8 @@ struct DIFFSTATUS
 	bool bBinaries; /**< Files are binaries */
 	bool bIdentical; /**< diffutils said files are identical */
 	bool bPatchFileFailed; /**< Creating patch file failed */
+	bool bCostCapped; /**< Minimal diff was given up as too expensive */
+	int nAlgorithmUsed; /**< DiffAlgorithm which actually ran */
 
 	DIFFSTATUS() { memset(this, 0, sizeof *this); } // start out with all flags clear
 };
@@ -86,10 +88,12 @@ public:
 	void RefreshFilters();
 	void RefreshOptions();
 	void SetCreatePatchFile(const String &filename);
+	void SetCreatePatchFile(FILE *stream);
 	void SetDetectMovedBlocks(bool bDetectMovedBlocks);
 	void SetPaths(const String &filepath1, const String &filepath2);
 	void SetAlternativePaths(const String &altPath1, const String &altPath2, bool bAddCommonSuffix = false);
 	void SetCodepage(int codepage) { m_codepage = codepage; }
+	void SetDiffThreads(long nDiffThreads) { m_nDiffThreads = nDiffThreads; }
 	bool RunFileDiff();
 	bool RunFileDiff(DiffFileData &, TextDefinition const * = NULL);
 	bool AddDiffRange(UINT begin0, UINT end0, UINT begin1, UINT end1, OP_TYPE op);
@@ -120,6 +124,7 @@ protected:
 	int RegExpFilter(struct comparison *, int StartPos, int EndPos, int FileNo, bool BreakCondition);
 
 	int m_codepage; /**< Codepage used in line filter */
+	long m_nDiffThreads; /**< Threads to diff in parallel, 0 or 1 is serial */
 
 private:
 	String m_s1File; /**< Full path to first diff'ed file. */
@@ -131,4 +136,5 @@ private:
 	String m_sPatchFile; /**< Full path to created patch file. */
 	DiffList *const m_pDiffList; /**< Pointer to external DiffList */
 	MovedLines *m_pMovedLines;
+	FILE *m_pPatchStream; /**< Stream to write patch to instead of m_sPatchFile */
 };
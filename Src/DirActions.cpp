@@ -593,58 +593,237 @@ void CDirView::PerformActionList(FileActionScript &actionScript)
 	m_pFrame->m_pMDIFrame->m_bVssSuppressPathCheck = FALSE;
 
 	theApp.AddOperation();
+	// Items are referred to by their rows, so keep extraction from sorting
+	// the rows while the file operations report their items
+	FileScriptUpdater updater(this, actionScript.m_bMakeTargetItemWritable);
 	try
 	{
 		const FILEOP_FLAGS operFlags = COptionsMgr::Get(OPT_USE_RECYCLE_BIN) ? FOF_ALLOWUNDO : 0;
-		if (actionScript.Run(static_cast<HListView *>(m_pWnd), operFlags))
-			UpdateAfterFileScript(actionScript);
+		if (actionScript.Run(static_cast<HListView *>(m_pWnd), operFlags, &updater))
+			UpdateAfterFileScript(actionScript, updater);
 	}
 	catch (OException *e)
 	{
 		e->ReportError(m_hWnd);
 		delete e;
 	}
+	updater.Finish();
 	theApp.RemoveOperation();
 }
 
 /**
- * @brief Update results after running FileActionScript.
- * This functions is called after script is finished to update
- * results (including UI).
- * @param [in] actionlist Script that was run.
+ * @brief Map the original index of a row to its current index.
+ * @param [in] removed Original indexes of removed rows, ascending.
+ * @param [in] nOriginal Original index of the row.
+ * @return Current index of the row, or -1 if the row has been removed.
  */
-void CDirView::UpdateAfterFileScript(FileActionScript &actionList)
+static int GetCurrentRow(const std::vector<int> &removed, int nOriginal)
 {
-	bool bDetachments = false;
-	int curSel = GetNextItem(-1, LVNI_SELECTED);
-	while (actionList.GetActionItemCount() > 0)
+	std::vector<int>::const_iterator it =
+		std::lower_bound(removed.begin(), removed.end(), nOriginal);
+	if (it != removed.end() && *it == nOriginal)
+		return -1;
+	return nOriginal - static_cast<int>(it - removed.begin());
+}
+
+/**
+ * @brief Add rows which are about to be removed to those already removed.
+ * @param [in,out] removed Original indexes of removed rows, ascending.
+ * @param [in] rows Current indexes of the rows, ascending.
+ */
+static void AddRemovedRows(std::vector<int> &removed, const std::vector<int> &rows)
+{
+	std::vector<int> merged;
+	merged.reserve(removed.size() + rows.size());
+	std::vector<int>::iterator p = removed.begin();
+	std::vector<int>::const_iterator q = rows.begin();
+	while (q != rows.end())
 	{
-		// Start handling from tail of list, so removing items
-		// doesn't invalidate our item indexes.
-		FileActionItem act = actionList.RemoveTailActionItem();
-		// Update item
-		if (m_pFrame->UpdateDiffAfterOperation(act, actionList.m_bMakeTargetItemWritable))
-			bDetachments = true;
+		// Skip the removed rows up to the original index of the row
+		int nOriginal = *q++ + static_cast<int>(p - removed.begin());
+		while (p != removed.end() && *p <= nOriginal)
+		{
+			merged.push_back(*p++);
+			++nOriginal;
+		}
+		merged.push_back(nOriginal);
 	}
+	merged.insert(merged.end(), p, removed.end());
+	removed.swap(merged);
+}
 
-	// Remove any detached items from the view
-	if (bDetachments)
+TESTCASE
+{
+	// Remove random rows in batches, and map all original rows after each
+	unsigned seed = 1;
+	for (int n = 0; n < 50; ++n)
 	{
-		int i = GetItemCount();
-		SetRedraw(FALSE);
-		while (i > m_nSpecialItems)
+		std::vector<int> rows; // original index per current row
+		seed = seed * 1103515245 + 12345;
+		int const nRows = (seed >> 16) % 60;
+		for (int i = 0; i < nRows; ++i)
+			rows.push_back(i);
+		std::vector<int> removed;
+		while (!rows.empty())
 		{
-			if (GetItemData(--i) == 0)
+			std::vector<int> batch;
+			std::vector<int> kept;
+			for (int i = 0; i < static_cast<int>(rows.size()); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				if ((seed >> 16) % 4 == 0)
+					batch.push_back(i);
+				else
+					kept.push_back(rows[i]);
+			}
+			AddRemovedRows(removed, batch);
+			rows.swap(kept);
+			assert(static_cast<int>(removed.size() + rows.size()) == nRows);
+			int nRow = 0;
+			for (int i = 0; i < nRows; ++i)
 			{
-				if (i <= curSel)
-					--curSel;
-				DeleteItem(i);
+				int const nCurrent = GetCurrentRow(removed, i);
+				if (nRow < static_cast<int>(rows.size()) && rows[nRow] == i)
+					assert(nCurrent == nRow++);
+				else
+					assert(nCurrent == -1);
 			}
 		}
-		if (++curSel < GetItemCount() || --curSel >= 0)
-			MoveFocus(0, curSel);
-		SetRedraw(TRUE);
 	}
+	return 0;
+}
+
+/**
+ * @brief Updates results for the items of a FileActionScript.
+ * Items come in batches as their file operations complete, so results catch
+ * up with the file system while the script runs. Each batch repaints the
+ * list once, and removes the rows of the items it has deleted. Items keep
+ * their original indexes, which are mapped past the removed rows. Property
+ * extraction is held off meanwhile, since it may sort the rows when done.
+ */
+class CDirView::FileScriptUpdater : public FileActionScript::Sink
+{
+public:
+	FileScriptUpdater(CDirView *pView, bool bMakeTargetItemWritable)
+		: m_pView(pView)
+		, m_bMakeTargetItemWritable(bMakeTargetItemWritable)
+		, m_bExtracting(pView->m_pFrame->GetDiffContext()->StopExtraction())
+		, m_bBatch(false)
+		, m_bDetachments(false)
+		, m_bUpdated(false)
+	{
+		pView->m_pFileScriptUpdater = this;
+	}
+	virtual void ActionItemDone(const FileActionItem &);
+	virtual void ActionItemsDone();
+	void Finish();
+private:
+	void RemoveDetachedRows();
+	CDirView *const m_pView;
+	bool const m_bMakeTargetItemWritable;
+	bool const m_bExtracting; /**< Whether extraction has been running */
+	bool m_bBatch; /**< Whether a batch is in progress */
+	bool m_bDetachments; /**< Whether the batch has detached items */
+	bool m_bUpdated; /**< Whether any items have been updated */
+	std::vector<int> m_removed; /**< Original indexes of removed rows, ascending */
+};
+
+/**
+ * @brief Update the item of an action which has been done.
+ * @param [in] act Action that was done.
+ */
+void CDirView::FileScriptUpdater::ActionItemDone(const FileActionItem &act)
+{
+	if (!m_bBatch)
+	{
+		// Repaint the list once for all items of the batch
+		m_pView->SetRedraw(FALSE);
+		m_bBatch = true;
+	}
+	// Skip the item if an earlier batch has removed its row along with
+	// the row of its parent folder
+	FileActionItem item = act;
+	item.context = GetCurrentRow(m_removed, act.context);
+	if (item.context == -1)
+		return;
+	if (m_pView->m_pFrame->UpdateDiffAfterOperation(item, m_bMakeTargetItemWritable))
+		m_bDetachments = true;
+	m_bUpdated = true;
+}
+
+/**
+ * @brief Finish a batch of items.
+ */
+void CDirView::FileScriptUpdater::ActionItemsDone()
+{
+	if (!m_bBatch)
+		return;
+	if (m_bDetachments)
+	{
+		RemoveDetachedRows();
+		m_bDetachments = false;
+	}
+	m_pView->SetRedraw(TRUE);
+	m_bBatch = false;
+}
+
+/**
+ * @brief Remove detached items from the view, and remember their rows.
+ */
+void CDirView::FileScriptUpdater::RemoveDetachedRows()
+{
+	CDirView *const pView = m_pView;
+	int const nCount = pView->GetItemCount();
+	std::vector<int> rows;
+	for (int i = pView->m_nSpecialItems; i < nCount; ++i)
+	{
+		if (pView->GetDiffItem(i) == NULL)
+			rows.push_back(i);
+	}
+	AddRemovedRows(m_removed, rows);
+
+	int curSel = pView->GetNextItem(-1, LVNI_SELECTED);
+	int i = curSel;
+	while (i >= pView->m_nSpecialItems)
+	{
+		if (pView->GetDiffItem(i--) == NULL)
+			--curSel;
+	}
+	pView->RemoveDetachedItems();
+	if (++curSel < pView->GetItemCount() || --curSel >= 0)
+		pView->MoveFocus(0, curSel);
+}
+
+/**
+ * @brief Finish the last batch, and resume reading properties.
+ */
+void CDirView::FileScriptUpdater::Finish()
+{
+	ActionItemsDone();
+	m_pView->m_pFileScriptUpdater = NULL;
+	// Resume reading properties, including those of the updated items
+	if (m_bExtracting || m_bUpdated)
+		m_pView->m_pFrame->GetDiffContext()->ExtractProperties();
+}
+
+/**
+ * @brief Update results after running FileActionScript.
+ * This functions is called after script is finished to update results
+ * (including UI) for the items which have not been updated along the way.
+ * That is all of them unless the low level file operations are in use.
+ * @param [in] actionlist Script that was run.
+ * @param [in] updater Updater which takes the items.
+ */
+void CDirView::UpdateAfterFileScript(FileActionScript &actionList, FileScriptUpdater &updater)
+{
+	while (actionList.GetActionItemCount() > 0)
+	{
+		// Start handling from tail of list, so that child items
+		// are handled before their parent folders.
+		FileActionItem act = actionList.RemoveTailActionItem();
+		updater.ActionItemDone(act);
+	}
+	updater.ActionItemsDone();
 }
 
 /**
@@ -820,6 +999,27 @@ int CDirView::MarkSelectedForRescan()
 	return items;
 }
 
+/**
+ * @brief Extract selected archive entries which are deferred from extraction.
+ * Such entries are known by their stored metadata only, so they need to be
+ * extracted before they get opened, copied, or otherwise acted upon.
+ */
+void CDirView::ExtractDeferredSelection()
+{
+	const CDiffContext *const ctxt = m_pFrame->GetDiffContext();
+	if (ctxt == NULL || !ctxt->HasDeferredItems())
+		return;
+	int sel = -1;
+	while ((sel = GetNextItem(sel, LVNI_SELECTED)) != -1)
+	{
+		const DIFFITEM *const di = GetDiffItem(sel);
+		// Special items have nothing to extract
+		if (di == NULL)
+			continue;
+		ctxt->ExtractDeferredItem(di, m_hWnd);
+	}
+}
+
 /**
  * @brief Return string such as "15 of 30 Files Affected" or "30 Files Affected"
  */
@@ -854,10 +1054,13 @@ void CDirView::FormatEncodingDialogDisplays(CLoadSaveCodepageDlg &dlg)
 {
 	IntToIntMap currentCodepages;
 	int nLeft=0, nLeftAffected=0, nRight=0, nRightAffected=0;
+	CDiffContext *const ctxt = m_pFrame->GetDiffContext();
+	// Encodings are about to change
+	ctxt->StopExtraction();
 	int i = -1;
 	while ((i = GetNextItem(i, LVNI_SELECTED)) != -1)
 	{
-		const DIFFITEM *const di = GetDiffItem(i);
+		DIFFITEM *const di = GetDiffItem(i);
 		if (di == NULL) // Invalid value, this must be special item
 			continue;
 		if (di->isDirectory())
@@ -866,6 +1069,7 @@ void CDirView::FormatEncodingDialogDisplays(CLoadSaveCodepageDlg &dlg)
 		if (di->isSideLeftOrBoth())
 		{
 			// exists on left
+			ctxt->UpdateProperties(di, true);
 			++nLeft;
 			if (di->left.IsEditableEncoding())
 				++nLeftAffected;
@@ -874,6 +1078,7 @@ void CDirView::FormatEncodingDialogDisplays(CLoadSaveCodepageDlg &dlg)
 		}
 		if (di->isSideRightOrBoth())
 		{
+			ctxt->UpdateProperties(di, false);
 			++nRight;
 			if (di->right.IsEditableEncoding())
 				++nRightAffected;
@@ -904,7 +1109,10 @@ void CDirView::DoFileEncodingDialog()
 
 	// Invoke dialog
 	if (LanguageSelect.DoModal(dlg) != IDOK)
+	{
+		m_pFrame->GetDiffContext()->ExtractProperties();
 		return;
+	}
 
 	int i = -1;
 	while ((i = GetNextItem(i, LVNI_SELECTED)) != -1)
@@ -926,6 +1134,7 @@ void CDirView::DoFileEncodingDialog()
 			di->right.encoding.SetCodepage(dlg.m_nLoadCodepage);
 		}
 	}
+	m_pFrame->GetDiffContext()->ExtractProperties();
 	InvalidateRect(NULL);
 	UpdateWindow();
 
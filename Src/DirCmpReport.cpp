@@ -38,16 +38,46 @@ static DWORD MakeHtmlColor(COLORREF cr)
 	return (cr & 0x0000FF) << 16 | (cr & 0x00FF00) | (cr & 0xFF0000) >> 16;
 }
 
+/**
+ * @brief Append text to buffer while turning special chars to entities.
+ * Same entities as CMarkdown::Entitify(), but without an intermediate BSTR.
+ */
+static void AppendEntityAware(String &buffer, LPCTSTR text)
+{
+	while (TCHAR c = *text++)
+	{
+		switch (c)
+		{
+		case _T('&'): buffer += _T("&amp;"); break;
+		case _T('"'): buffer += _T("&quot;"); break;
+		case _T('\''): buffer += _T("&apos;"); break;
+		case _T('<'): buffer += _T("&lt;"); break;
+		case _T('>'): buffer += _T("&gt;"); break;
+		default: buffer += c; break;
+		}
+	}
+}
+
 /**
  * @brief Constructor.
  */
 DirCmpReport::DirCmpReport(CDirView *pList)
 	: m_pList(pList), m_pFile(NULL), m_pFileW(NULL)
 	, m_sSeparator(_T(",")), m_rootPaths(2)
+	, m_nRowType(REPORT_TYPE_COMMALIST)
 {
 	CDirFrame *const pDoc = pList->m_pFrame;
 	const CDiffContext *ctxt = pDoc->GetDiffContext();
 	m_nColumns = pList->GetHeaderCtrl()->GetItemCount();
+	m_colorder.resize(m_nColumns);
+	m_colnames.resize(m_nColumns);
+	for (int currCol = 0; currCol < m_nColumns; currCol++)
+	{
+		int logcol = pList->ColPhysToLog(currCol);
+		m_colorder[currCol] = logcol;
+		m_colnames[currCol] = pList->GetColDisplayName(logcol);
+	}
+	pList->GetReportItems(m_items, false);
 	m_rootPaths[0] = ctxt->GetLeftPath();
 	m_rootPaths[1] = ctxt->GetRightPath();
 	// If inside archive, convert paths
@@ -268,13 +298,7 @@ void DirCmpReport::GenerateHeader()
 	WriteString(_T("\n"));
 	for (int currCol = 0; currCol < m_nColumns; currCol++)
 	{
-		TCHAR columnName[160]; // Assuming max col header will never be > 160
-		LVCOLUMN lvc;
-		lvc.mask = LVCF_TEXT;
-		lvc.pszText = columnName;
-		lvc.cchTextMax = _countof(columnName);
-		if (m_pList->GetColumn(currCol, &lvc))
-			WriteString(lvc.pszText);
+		WriteString(m_colnames[currCol].c_str());
 		// Add col-separator, but not after last column
 		if (currCol < m_nColumns - 1)
 			WriteString(m_sSeparator.c_str());
@@ -286,30 +310,9 @@ void DirCmpReport::GenerateHeader()
  */
 void DirCmpReport::GenerateContent()
 {
-	int nRows = m_pList->GetItemCount();
-
 	// Report:Detail. All currently displayed columns will be added
-	for (int currRow = 0; currRow < nRows; currRow++)
-	{
-		WriteString(_T("\n"));
-		for (int currCol = 0; currCol < m_nColumns; currCol++)
-		{
-			String value = m_pList->GetItemText(currRow, currCol);
-			if (value.find(m_sSeparator) != String::npos)
-			{
-				WriteString(_T("\""));
-				WriteString(value.c_str());
-				WriteString(_T("\""));
-			}
-			else
-			{
-				WriteString(value.c_str());
-			}
-			// Add col-separator, but not after last column
-			if (currCol < m_nColumns - 1)
-				WriteString(m_sSeparator.c_str());
-		}
-	}
+	m_nRowType = REPORT_TYPE_COMMALIST;
+	FormatRows(m_items.size());
 }
 
 /**
@@ -380,17 +383,9 @@ void DirCmpReport::GenerateHTMLHeaderBodyPortion()
 
 	for (int currCol = 0; currCol < m_nColumns; currCol++)
 	{
-		TCHAR columnName[160]; // Assuming max col header will never be > 160
-		LVCOLUMN lvc;
-		lvc.mask = LVCF_TEXT;
-		lvc.pszText = columnName;
-		lvc.cchTextMax = _countof(columnName);
-		if (m_pList->GetColumn(currCol, &lvc))
-		{
-			WriteString(_T("<th>"));
-			WriteStringEntityAware(lvc.pszText);
-			WriteString(_T("</th>"));
-		}
+		WriteString(_T("<th>"));
+		WriteStringEntityAware(m_colnames[currCol].c_str());
+		WriteString(_T("</th>"));
 	}
 	WriteString(_T("</tr>\n"));
 }
@@ -416,19 +411,10 @@ void DirCmpReport::GenerateXmlHeader()
 	WriteString(_T("<column_name>"));
 	for (int currCol = 0; currCol < m_nColumns; currCol++)
 	{
-		TCHAR columnName[160]; // Assuming max col header will never be > 160
-		LVCOLUMN lvc;
-		lvc.mask = LVCF_TEXT;
-		lvc.pszText = columnName;
-		lvc.cchTextMax = _countof(columnName);
-		int logcol = m_pList->ColPhysToLog(currCol);
-		LPCTSTR colEl = CDirView::f_cols[logcol].regName;
-		if (m_pList->GetColumn(currCol, &lvc))
-		{
-			WriteString(_T("<%s>"), colEl);
-			WriteStringEntityAware(lvc.pszText);
-			WriteString(_T("</%s>"), colEl);
-		}
+		LPCTSTR colEl = CDirView::f_cols[m_colorder[currCol]].regName;
+		WriteString(_T("<%s>"), colEl);
+		WriteStringEntityAware(m_colnames[currCol].c_str());
+		WriteString(_T("</%s>"), colEl);
 	}
 	WriteString(_T("</column_name>\n"));
 }
@@ -438,47 +424,84 @@ void DirCmpReport::GenerateXmlHeader()
  */
 void DirCmpReport::GenerateXmlHtmlContent(bool xml)
 {
-	int nRows = m_pList->GetItemCount();
 	// Report:Detail. All currently displayed columns will be added
-	for (int currRow = 0; currRow < nRows; currRow++)
+	m_nRowType = xml ? REPORT_TYPE_SIMPLEXML : REPORT_TYPE_SIMPLEHTML;
+	FormatRows(m_items.size());
+	if (!xml)
+		WriteString(_T("</table>\n"));
+}
+
+/**
+ * @brief Format one row of report content.
+ * Runs on worker threads, so reads from compare results rather than from UI.
+ * @param [in] iRow Index of row in m_items.
+ * @param [in,out] buffer Buffer to append the row to.
+ */
+void DirCmpReport::FormatRow(stl_size_t iRow, String &buffer)
+{
+	const DIFFITEM *di = m_items[iRow];
+	if (m_nRowType != REPORT_TYPE_SIMPLEXML && m_nRowType != REPORT_TYPE_SIMPLEHTML)
 	{
-		LPCTSTR tr = _T("<tr>");
-		if (DIFFITEM *di = m_pList->GetDiffItem(currRow))
+		buffer += _T('\n');
+		for (int currCol = 0; currCol < m_nColumns; currCol++)
 		{
-			switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
+			String value = m_pList->GetCellText(m_colorder[currCol], di);
+			if (value.find(m_sSeparator) != String::npos)
 			{
-			case DIFFCODE::BOTH | DIFFCODE::NOCMP:
-			case DIFFCODE::BOTH | DIFFCODE::SAME:
-				// either identical or irrelevant
-				break;
-			case DIFFCODE::LEFT:
-				// left-only
-				tr = _T("<tr class='leftonly'>");
-				break;
-			case DIFFCODE::RIGHT:
-				// right-only
-				tr = _T("<tr class='rightonly'>");
-				break;
-			default:
-				// otherwise suspicious
-				tr = _T("<tr class='suspicious'>");
-				break;
+				buffer += _T('"');
+				buffer += value;
+				buffer += _T('"');
 			}
+			else
+			{
+				buffer += value;
+			}
+			// Add col-separator, but not after last column
+			if (currCol < m_nColumns - 1)
+				buffer += m_sSeparator;
 		}
-		WriteString(xml ? _T("<filediff>") : tr);
-		for (int currCol = 0; currCol < m_nColumns; currCol++)
-		{
-			int logcol = m_pList->ColPhysToLog(currCol);
-			LPCTSTR const colEl = xml ? CDirView::f_cols[logcol].regName : _T("td");
-			WriteString(_T("<%s>"), colEl);
-			WriteStringEntityAware(m_pList->GetItemText(currRow, currCol).c_str());
-			WriteString(_T("</%s>"), colEl);
-		}
-		WriteString(xml ? _T("</filediff>") : _T("</tr>"));
-		WriteString(_T("\n"));
+		return;
 	}
-	if (!xml)
-		WriteString(_T("</table>\n"));
+	bool const xml = m_nRowType == REPORT_TYPE_SIMPLEXML;
+	LPCTSTR tr = _T("<tr>");
+	switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
+	{
+	case DIFFCODE::BOTH | DIFFCODE::NOCMP:
+	case DIFFCODE::BOTH | DIFFCODE::SAME:
+		// either identical or irrelevant
+		break;
+	case DIFFCODE::LEFT:
+		// left-only
+		tr = _T("<tr class='leftonly'>");
+		break;
+	case DIFFCODE::RIGHT:
+		// right-only
+		tr = _T("<tr class='rightonly'>");
+		break;
+	default:
+		// otherwise suspicious
+		tr = _T("<tr class='suspicious'>");
+		break;
+	}
+	buffer += xml ? _T("<filediff>") : tr;
+	for (int currCol = 0; currCol < m_nColumns; currCol++)
+	{
+		int logcol = m_colorder[currCol];
+		LPCTSTR const colEl = xml ? CDirView::f_cols[logcol].regName : _T("td");
+		buffer.append_sprintf(_T("<%s>"), colEl);
+		AppendEntityAware(buffer, m_pList->GetCellText(logcol, di).c_str());
+		buffer.append_sprintf(_T("</%s>"), colEl);
+	}
+	buffer += xml ? _T("</filediff>") : _T("</tr>");
+	buffer += _T('\n');
+}
+
+/**
+ * @brief Write a block of formatted rows to report file.
+ */
+void DirCmpReport::WriteRows(stl_size_t, stl_size_t, String &buffer)
+{
+	WriteString(buffer.c_str());
 }
 
 /**
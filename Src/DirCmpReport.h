@@ -7,20 +7,17 @@
 #pragma once
 
 #include "DirReportTypes.h"
+#include "ReportRowFormatter.h"
 
 /**
  * @brief This class creates directory compare reports.
  *
- * This class creates a directory compare report. To make things easier
- * we read data from view's listview. Reading from listview avoids
- * re-formatting data and complex GUI for selecting what info to show in
- * reports. Downside is we only have data that is visible in GUI.
- *
- * @todo We should read DIFFITEMs from CDirDoc and format data to better
- * fit for reporting. Duplicating formatting and sorting code should be
- * avoided.
+ * This class creates a directory compare report. Rows are read from the
+ * compare results in the order in which the view shows them, and formatted
+ * by the same code which formats the view's columns. Reports thus show the
+ * columns visible in GUI, but do not need to query the list for each cell.
  */
-class DirCmpReport
+class DirCmpReport : private ReportRowFormatter
 {
 public:
 
@@ -52,10 +49,16 @@ protected:
 	void GenerateXmlFooter();
 
 private:
+	virtual void FormatRow(stl_size_t iRow, String &);
+	virtual void WriteRows(stl_size_t iRow, stl_size_t nRows, String &);
 	CDirView *const m_pList; /**< Pointer to UI-list */
 	std::vector<String> m_rootPaths; /**< Root paths, printed to report */
 	String m_sTitle; /**< Report title, built from root paths */
 	int m_nColumns; /**< Columns in UI */
+	std::vector<int> m_colorder; /**< Logical columns in display order */
+	std::vector<String> m_colnames; /**< Column names in display order */
+	std::vector<DIFFITEM *> m_items; /**< Items to report, in display order */
+	REPORT_TYPE m_nRowType; /**< How FormatRow() formats rows */
 	String m_sSeparator; /**< Column separator for report */
 	IStream *m_pFile; /**< UTF-8 encoded output stream */
 	IStream *m_pFileW; /**< UTF-16 encoded output stream */
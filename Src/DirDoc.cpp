@@ -39,6 +39,7 @@
 #include "LogFile.h"
 #include "paths.h"
 #include "FileActionScript.h"
+#include "DirWatch.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -115,6 +116,18 @@ bool CDirFrame::InitCompare(LPCTSTR pszLeft, LPCTSTR pszRight, int nRecursive, c
 		m_pTempPathContext->m_strRightRoot = m_pCtxt->GetRightPath();
 	}
 
+	// Let the context see archive entries which are deferred from extraction
+	for (CTempPathContext *p = m_pTempPathContext; p != NULL; p = p->m_pParent)
+	{
+		if (m_pCtxt->GetLeftPath().find(p->m_strLeftRoot) == 0 &&
+			m_pCtxt->GetRightPath().find(p->m_strRightRoot) == 0)
+		{
+			m_pCtxt->m_pArchiveListing[0] = p->m_pLeftListing;
+			m_pCtxt->m_pArchiveListing[1] = p->m_pRightListing;
+			break;
+		}
+	}
+
 	m_nRecursive = nRecursive;
 
 	if (cmdInfo)
@@ -122,6 +135,8 @@ bool CDirFrame::InitCompare(LPCTSTR pszLeft, LPCTSTR pszRight, int nRecursive, c
 		m_nCompMethod = cmdInfo->m_nCompMethod;
 	}
 
+	WatchFolders();
+
 	return bNeedCompare;
 }
 
@@ -185,6 +200,7 @@ void CDirFrame::InitMrgmanCompare()
 			root += view_root.W;
 			bNeedCompare = InitContext(root.c_str(), root.c_str(), 0, MAKELONG(idLeftContent, idRightContent));
 			m_pCtxt->m_piFilterGlobal = &transparentFileFilter;
+			WatchFolders();
 			if (bNeedCompare && xml.Move("files") && xml.Pull())
 			{
 				while (xml.Move("file") && xml.Pull())
@@ -345,6 +361,56 @@ CDirFrame::AllowUpwardDirectory(String &leftParent, String &rightParent)
 void CDirFrame::RefreshOptions()
 {
 	m_nCompMethod = -1;
+	WatchFolders();
+}
+
+/**
+ * @brief Start or stop watching compared folders, as options tell.
+ * Only plain folder compares are watched. Archives and ClearCase sessions
+ * do not change under the compare, and flat compares of whole trees would
+ * rather have a full rescan. Keeps an existing watch on the same folders,
+ * so that changes which are pending survive.
+ */
+void CDirFrame::WatchFolders()
+{
+	bool bWatch = m_pCtxt != NULL && COptionsMgr::Get(OPT_CMP_WATCH_FOLDERS) &&
+		(m_nRecursive == 0 || m_nRecursive == 1) &&
+		m_pTempPathContext == NULL && m_pCtxt->m_dwContext == 0;
+	if (bWatch && m_pDirWatch && m_pDirWatch->IsWatching(
+		m_pCtxt->GetLeftPath(), m_pCtxt->GetRightPath(), m_nRecursive != 0))
+	{
+		return;
+	}
+	delete m_pDirWatch;
+	m_pDirWatch = bWatch ? new DirWatch(m_pDirView->m_pWnd,
+		m_pCtxt->GetLeftPath().c_str(), m_pCtxt->GetRightPath().c_str(),
+		m_nRecursive != 0) : NULL;
+}
+
+/**
+ * @brief Bring compare results in line with changes on disk.
+ * Called in response to MSG_FOLDERS_CHANGED. Refreshes only the folders
+ * which have changed, and compares only their new or modified items. While
+ * a compare is running or a modal dialog is up, changes stay pending, and
+ * the watch tells again later.
+ */
+void CDirFrame::RescanChanges()
+{
+	if (!m_pDirWatch || !m_pCtxt || m_pCtxt->IsBusy())
+		return;
+	if (!m_pMDIFrame->IsWindowEnabled())
+		return;
+	std::vector<String> folders;
+	if (!m_pDirWatch->GetChanges(folders))
+	{
+		Rescan();
+	}
+	else if (int const nFolders = static_cast<int>(folders.size()))
+	{
+		m_pDirView->DeleteAllItems();
+		folders.swap(m_pCtxt->m_rgRefreshFolders);
+		Rescan(nFolders);
+	}
 }
 
 /**
@@ -393,7 +459,14 @@ void CDirFrame::Rescan(int nCompareSelected)
 	}
 	else
 	{
+		// A full rescan covers changes which are pending
+		if (m_pDirWatch)
+		{
+			std::vector<String> folders;
+			m_pDirWatch->GetChanges(folders);
+		}
 		m_pDirView->DeleteAllItems();
+		m_pCtxt->StopExtraction();
 		m_pCtxt->RemoveAll();
 		if (m_pTempPathContext != NULL)
 			bDisableFilter = true;
@@ -819,6 +892,7 @@ void CDirFrame::CompareReady()
 	LogFile.Write(CLogFile::LNOTICE, _T("Directory scan complete\n"));
 	waitStatusCursor.End();
 	UpdateCmdUI<ID_REFRESH>();
+	m_pCtxt->ExtractProperties();
 }
 
 /**
@@ -978,6 +1052,8 @@ bool CDirFrame::UpdateDiffAfterOperation(const FileActionItem &act, bool bMakeTa
 	DIFFITEM *di = m_pDirView->GetDiffItem(act.context);
 	if (di == NULL)
 		return false;
+	// Items are about to change or go away
+	m_pCtxt->StopExtraction();
 	bool bUpdateLeft = false;
 	bool bUpdateRight = false;
 	bool bDetachments = false;
@@ -1007,19 +1083,13 @@ bool CDirFrame::UpdateDiffAfterOperation(const FileActionItem &act, bool bMakeTa
 		case FileActionItem::UI_LEFT:
 			bUpdateLeft = true;
 			bPreserveInfo = true;
-			di->left.versionChecked = di->right.versionChecked;
-			di->left.version = di->right.version;
-			di->left.encoding = di->right.encoding;
-			di->left.m_textStats = di->right.m_textStats;
+			m_pCtxt->CopyProperties(di, true);
 			break;
 
 		case FileActionItem::UI_RIGHT:
 			bUpdateRight = true;
 			bPreserveInfo = true;
-			di->right.versionChecked = di->left.versionChecked;
-			di->right.version = di->left.version;
-			di->right.encoding = di->left.encoding;
-			di->right.m_textStats = di->left.m_textStats;
+			m_pCtxt->CopyProperties(di, false);
 			break;
 		}
 		break;
@@ -83,6 +83,7 @@ CDirFrame::CDirFrame(CMainFrame *pMDIFrame)
 , m_pDirView(new CDirView(this))
 #pragma warning(default:warning_this_used_in_base_member_initializer_list)
 , m_pCtxt(NULL)
+, m_pDirWatch(NULL)
 , m_pCompareStats(new CompareStats)
 , m_nRecursive(0)
 , m_nCompMethod(-1)
@@ -114,6 +115,7 @@ void CDirFrame::Unconstruct()
 
 CDirFrame::~CDirFrame()
 {
+	delete m_pDirWatch;
 	DeleteContext();
 	// Inform all of our merge docs that we're closing
 	MergeDocPtrList::iterator ppMergeDoc = m_MergeDocs.begin();
@@ -295,7 +297,42 @@ void CDirFrame::UpdateCmdUI<ID_MERGE_DELETE>()
 template<>
 LRESULT CDirFrame::OnWndMsg<WM_COMMAND>(WPARAM wParam, LPARAM lParam)
 {
-	switch (UINT id = lParam ? static_cast<UINT>(wParam) : LOWORD(wParam))
+	UINT const id = lParam ? static_cast<UINT>(wParam) : LOWORD(wParam);
+	switch (id)
+	{
+	case ID_EDIT_COPY:
+	case ID_EDIT_CUT:
+	case ID_DIR_DEL_LEFT:
+	case ID_DIR_DEL_RIGHT:
+	case ID_DIR_DEL_BOTH:
+	case ID_MERGE_DELETE:
+	case ID_DIR_OPEN_LEFT:
+	case ID_DIR_OPEN_RIGHT:
+	case ID_DIR_OPEN_LEFT_WITH:
+	case ID_DIR_OPEN_RIGHT_WITH:
+	case ID_DIR_OPEN_LEFT_WITHEDITOR:
+	case ID_DIR_OPEN_RIGHT_WITHEDITOR:
+	case ID_DIR_OPEN_LEFT_FOLDER:
+	case ID_DIR_OPEN_RIGHT_FOLDER:
+	case ID_L2R:
+	case ID_R2L:
+	case ID_DIR_COPY_LEFT_TO_RIGHT:
+	case ID_DIR_COPY_RIGHT_TO_LEFT:
+	case ID_DIR_COPY_LEFT_TO_BROWSE:
+	case ID_DIR_COPY_RIGHT_TO_BROWSE:
+	case ID_DIR_MOVE_LEFT_TO_BROWSE:
+	case ID_DIR_MOVE_RIGHT_TO_BROWSE:
+	case ID_FILE_ENCODING:
+	case ID_DIR_ZIP_LEFT:
+	case ID_DIR_ZIP_RIGHT:
+	case ID_DIR_ZIP_BOTH:
+	case ID_DIR_ZIP_BOTH_DIFFS_ONLY:
+	case ID_DIR_ITEM_RENAME:
+		// Commands which act on files need the selected ones to exist on disk
+		m_pDirView->ExtractDeferredSelection();
+		break;
+	}
+	switch (id)
 	{
 	case ID_FILE_LEFT_READONLY:
 		// Change left-side readonly-status
@@ -608,7 +645,7 @@ void CDirFrame::CreateClient()
 	// focus is elsewhere (ie, on file edit window)
 	HListView *pLv = HListView::Create(
 		WS_CHILD | WS_VISIBLE | WS_TABSTOP |
-		LVS_REPORT | LVS_SHOWSELALWAYS | LVS_EDITLABELS | LVS_SHAREIMAGELISTS,
+		LVS_REPORT | LVS_SHOWSELALWAYS | LVS_EDITLABELS | LVS_SHAREIMAGELISTS | LVS_OWNERDATA,
 		0, rect.bottom, rect.right, rect.top - rect.bottom, m_pWnd, 0x1000);
 	pLv->SetParent(m_wndFilePathBar.m_pWnd);
 	m_pDirView->Subclass(pLv);
@@ -748,7 +785,7 @@ bool CDirFrame::AddToCollection(FileLocation &filelocLeft, FileLocation &fileloc
 		di->left.filename = PathFindFileName(lname);
 		di->right.path = paths_GetParentPath(rname);
 		di->right.filename = PathFindFileName(rname);
-		i = m_pDirView->AddNewItem(m_pDirView->GetItemCount(), di, I_IMAGECALLBACK, 0);
+		i = m_pDirView->AddNewItem(di);
 		Rescan(1);
 	}
 	if (i != -1)
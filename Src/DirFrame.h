@@ -27,6 +27,7 @@
 // CDirFrame frame
 
 #include "DiffContext.h"
+#include "DirListModel.h"
 
 class CDirView;
 class CHexMergeFrame;
@@ -39,13 +40,17 @@ typedef std::list<CImgMergeFrame *> ImgMergeDocPtrList;
 typedef std::list<CSQLiteMergeFrame *> SQLiteMergeDocPtrList;
 typedef std::list<CReoGridMergeFrame *> ReoGridMergeDocPtrList;
 class CTempPathContext;
+class DirWatch;
 struct FileActionItem;
 class MergeCmdLineInfo;
 
 /**
  * @brief Frame window for Directory Compare window
  */
-class CDirFrame : public CDocFrame, private CFloatFlags
+class CDirFrame
+	: public CDocFrame
+	, private CFloatFlags
+	, public DirListModel::Filter
 {
 // Attributes
 public:
@@ -107,6 +112,8 @@ public:
 	void InitMrgmanCompare();
 	void RefreshOptions();
 	void Rescan(int nCompareSelected = 0);
+	void WatchFolders();
+	void RescanChanges();
 	int GetRecursive() const { return m_nRecursive; }
 	void CompareReady();
 	void UpdateChangedItem(const CChildFrame *);
@@ -132,7 +139,7 @@ public:
 	void ApplyLeftDisplayRoot(String &);
 	void ApplyRightDisplayRoot(String &);
 
-	bool IsShowable(const DIFFITEM *) const;
+	virtual bool IsShowable(const DIFFITEM *) const;
 
 	CDiffContext *GetDiffContext() { return m_pCtxt; }
 	struct AllowUpwardDirectory
@@ -157,6 +164,7 @@ private:
 
 	// Implementation data
 	CDiffContext *m_pCtxt; /**< Pointer to compare results-data */
+	DirWatch *m_pDirWatch; /**< Watches compared folders for changes */
 	ListEntry m_root;
 	CompareStats *const m_pCompareStats; /**< Compare statistics */
 	MergeDocPtrList m_MergeDocs; /**< List of file compares opened from this compare */
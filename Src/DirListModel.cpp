@@ -0,0 +1,389 @@
+/**
+ *  @file DirListModel.cpp
+ *
+ *  @brief Implementation of class DirListModel
+ */
+#include "StdAfx.h"
+#include "DiffItemList.h"
+#include "DirListModel.h"
+
+/**
+ * @brief Orders spans by their sort keys.
+ * Spans which compare equal keep their original order.
+ */
+class DirListModel::SpanLess
+{
+public:
+	explicit SpanLess(const DirListModel *pModel) : m_pModel(pModel) { }
+	bool operator()(const Span &a, const Span &b) const
+	{
+		int cmp = 0;
+		if (a.arg == NULL || b.arg == NULL)
+			cmp = (a.arg != NULL) - (b.arg != NULL);
+		else if (SortFncPtrType fnc = m_pModel->m_sortfnc)
+			cmp = (*fnc)(m_pModel->m_pCtxt, a.arg, b.arg);
+		else if (m_pModel->m_getfnc)
+			cmp = lstrcmpi(a.text.c_str(), b.text.c_str());
+		if (!m_pModel->m_bAscending)
+			cmp = -cmp;
+		return cmp != 0 ? cmp < 0 : a.begin < b.begin;
+	}
+private:
+	const DirListModel *const m_pModel;
+};
+
+/**
+ * @brief Part of a span array which is sorted on a thread of its own.
+ */
+class DirListModel::SortPart
+{
+public:
+	Span *first;
+	Span *last;
+	const SpanLess *less;
+	DWORD Run()
+	{
+		std::sort(first, last, *less);
+		return 0;
+	}
+};
+
+DirListModel::DirListModel()
+	: m_pList(NULL), m_pFilter(NULL), m_bTreeMode(false), m_bRecursive(false)
+	, m_pCtxt(NULL), m_offset(0), m_getfnc(NULL), m_sortfnc(NULL)
+	, m_bAscending(true), m_bSorted(false)
+{
+}
+
+/**
+ * @brief Set where rows come from.
+ * @param [in] pList Compare results.
+ * @param [in] pFilter Decides which items get a row.
+ * @param [in] bTreeMode Whether to show items as a tree.
+ * @param [in] bRecursive Whether compare included subfolders.
+ */
+void DirListModel::SetSource(const DiffItemList *pList, const Filter *pFilter, bool bTreeMode, bool bRecursive)
+{
+	m_pList = pList;
+	m_pFilter = pFilter;
+	m_bTreeMode = bTreeMode;
+	m_bRecursive = bRecursive;
+}
+
+/**
+ * @brief Set order in which Sort() and InsertChildren() put rows.
+ * @param [in] pCtxt Context to pass to column functions.
+ * @param [in] offset Offset of column's field within DIFFITEM.
+ * @param [in] getfnc Function giving column's display text.
+ * @param [in] sortfnc Function comparing column's fields, or NULL to
+ * compare display texts.
+ * @param [in] bAscending Whether to sort in ascending order.
+ */
+void DirListModel::SetOrder(const CDiffContext *pCtxt, size_t offset, GetFncPtrType getfnc, SortFncPtrType sortfnc, bool bAscending)
+{
+	m_pCtxt = pCtxt;
+	m_offset = offset;
+	m_getfnc = getfnc;
+	m_sortfnc = sortfnc;
+	m_bAscending = bAscending;
+	m_bSorted = true;
+}
+
+void DirListModel::Clear()
+{
+	m_rows.clear();
+}
+
+/**
+ * @brief Add a row at the end.
+ */
+void DirListModel::Append(DIFFITEM *di, int level, int image)
+{
+	Row row = { di, level, image };
+	m_rows.push_back(row);
+}
+
+/**
+ * @brief Add rows for showable descendants of given item at the end.
+ * @param [in] di Item whose descendants to add, or NULL for all items.
+ */
+void DirListModel::AppendChildren(const DIFFITEM *di)
+{
+	CollectChildren(m_rows, di, 0);
+}
+
+/**
+ * @brief Insert rows for children of an expanded folder after its row.
+ * @param [in] i Index of folder's row.
+ * @return Number of rows inserted.
+ */
+stl_size_t DirListModel::InsertChildren(stl_size_t i)
+{
+	std::vector<Row> rows;
+	CollectChildren(rows, m_rows[i].di, m_rows[i].level + 1);
+	if (m_bSorted)
+		SortRows(rows, 0, rows.size());
+	m_rows.insert(m_rows.begin() + i + 1, rows.begin(), rows.end());
+	return rows.size();
+}
+
+/**
+ * @brief Remove the rows which follow a folder's row as its children.
+ * @param [in] i Index of folder's row.
+ * @return Number of rows removed.
+ */
+stl_size_t DirListModel::RemoveChildren(stl_size_t i)
+{
+	int const level = m_rows[i].level;
+	stl_size_t const first = i + 1;
+	stl_size_t last = first;
+	while (last < m_rows.size() && m_rows[last].level > level)
+		++last;
+	m_rows.erase(m_rows.begin() + first, m_rows.begin() + last);
+	return last - first;
+}
+
+/**
+ * @brief Remove rows whose item has been set to NULL.
+ * @param [in] i Index of first row to consider.
+ * @return Number of rows removed.
+ */
+stl_size_t DirListModel::RemoveDetached(stl_size_t i)
+{
+	stl_size_t const count = m_rows.size();
+	stl_size_t j = i;
+	for ( ; i < count ; ++i)
+	{
+		if (m_rows[i].di != NULL)
+			m_rows[j++] = m_rows[i];
+	}
+	m_rows.resize(j);
+	return count - j;
+}
+
+/**
+ * @brief Sort rows according to order given through SetOrder().
+ * In tree mode, siblings are sorted among themselves, so no comparison ever
+ * needs to look at parent items.
+ * @param [in] i Index of first row to sort.
+ */
+void DirListModel::Sort(stl_size_t i)
+{
+	if (m_bSorted)
+		SortRows(m_rows, i, m_rows.size());
+}
+
+/**
+ * @brief Find row of given item.
+ * @return Index of row, or -1 if item has no row.
+ */
+int DirListModel::Find(const DIFFITEM *di) const
+{
+	stl_size_t const count = m_rows.size();
+	for (stl_size_t i = 0 ; i < count ; ++i)
+	{
+		if (m_rows[i].di == di)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+/**
+ * @brief Add rows for showable descendants of given item.
+ * @param [in,out] rows Receives the rows.
+ * @param [in] di Item whose descendants to add, or NULL for all items.
+ * @param [in] level Indent level of children.
+ */
+void DirListModel::CollectChildren(std::vector<Row> &rows, const DIFFITEM *di, int level) const
+{
+	for (di = m_pList->GetFirstChildDiff(di) ; di != NULL ; di = m_pList->GetNextSiblingDiff(di))
+	{
+		if (!m_pFilter->IsShowable(di))
+			continue;
+		Row row = { const_cast<DIFFITEM *>(di), 0, I_IMAGECALLBACK };
+		if (m_bTreeMode)
+		{
+			row.level = level;
+			rows.push_back(row);
+			if (di->HasChildren() && (di->customFlags1 & ViewCustomFlags::EXPANDED))
+				CollectChildren(rows, di, level + 1);
+		}
+		else
+		{
+			if (!m_bRecursive ||
+				!di->isDirectory() ||
+				di->isSideLeftOnly() ||
+				di->isSideRightOnly())
+			{
+				rows.push_back(row);
+			}
+			if (di->HasChildren())
+				CollectChildren(rows, di, level + 1);
+		}
+	}
+}
+
+/**
+ * @brief Sort given range of rows.
+ * The range starts with a row of lowest level. Each row of that level heads
+ * a span which extends over its children. Spans are sorted as a whole, and
+ * the children inside each span are sorted recursively.
+ */
+void DirListModel::SortRows(std::vector<Row> &rows, stl_size_t first, stl_size_t last) const
+{
+	if (first >= last)
+		return;
+	int const level = rows[first].level;
+	std::vector<Span> spans;
+	stl_size_t i = first;
+	while (i < last)
+	{
+		spans.push_back(Span());
+		Span &span = spans.back();
+		span.begin = i;
+		while (++i < last && rows[i].level > level)
+			continue;
+		span.end = i;
+		span.arg = NULL;
+		if (const DIFFITEM *di = rows[span.begin].di)
+		{
+			span.arg = reinterpret_cast<const char *>(di) + m_offset;
+			// Extract display text once rather than on each comparison
+			if (m_sortfnc == NULL && m_getfnc != NULL)
+				span.text = (*m_getfnc)(m_pCtxt, span.arg);
+		}
+		if (span.end - span.begin > 1)
+			SortRows(rows, span.begin + 1, span.end);
+	}
+	if (spans.size() < 2)
+		return;
+	SortSpans(spans);
+	std::vector<Row> sorted;
+	sorted.reserve(last - first);
+	std::vector<Span>::const_iterator it = spans.begin();
+	while (it != spans.end())
+	{
+		sorted.insert(sorted.end(), rows.begin() + it->begin, rows.begin() + it->end);
+		++it;
+	}
+	std::copy(sorted.begin(), sorted.end(), rows.begin() + first);
+}
+
+/**
+ * @brief Sort spans, using multiple threads if there are many of them.
+ */
+void DirListModel::SortSpans(std::vector<Span> &spans) const
+{
+	SpanLess const less(this);
+	stl_size_t const count = spans.size();
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	UINT const nParts = min<UINT>(si.dwNumberOfProcessors, MAX_THREADS);
+	if (count < PARALLEL_SORT_MIN || nParts < 2)
+	{
+		std::sort(spans.begin(), spans.end(), less);
+		return;
+	}
+	// Sort equal sized parts on separate threads
+	stl_size_t bounds[MAX_THREADS + 1];
+	SortPart parts[MAX_THREADS];
+	HANDLE rgThreads[MAX_THREADS];
+	DWORD nThreads = 0;
+	UINT k;
+	for (k = 0 ; k <= nParts ; ++k)
+		bounds[k] = count * k / nParts;
+	for (k = 0 ; k < nParts ; ++k)
+	{
+		parts[k].first = &spans[0] + bounds[k];
+		parts[k].last = &spans[0] + bounds[k + 1];
+		parts[k].less = &less;
+	}
+	for (k = 1 ; k < nParts ; ++k)
+	{
+		if (HANDLE const hThread = BeginThreadEx(NULL, 0,
+			OException::ThreadProc<SortPart, &SortPart::Run>, &parts[k], 0, NULL))
+		{
+			rgThreads[nThreads++] = hThread;
+		}
+		else
+		{
+			parts[k].Run();
+		}
+	}
+	parts[0].Run();
+	WaitForMultipleObjects(nThreads, rgThreads, TRUE, INFINITE);
+	while (nThreads != 0)
+		CloseHandle(rgThreads[--nThreads]);
+	// Merge sorted parts pairwise
+	std::vector<Span> merged(count);
+	for (UINT width = 1 ; width < nParts ; width *= 2)
+	{
+		Span *const src = &spans[0];
+		Span *const dst = &merged[0];
+		for (k = 0 ; k < nParts ; k += 2 * width)
+		{
+			stl_size_t const lo = bounds[k];
+			stl_size_t const mid = bounds[min(k + width, nParts)];
+			stl_size_t const hi = bounds[min(k + 2 * width, nParts)];
+			std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);
+		}
+		spans.swap(merged);
+	}
+}
+
+TESTCASE
+{
+	class ShowAll : public DirListModel::Filter
+	{
+	public:
+		virtual bool IsShowable(const DIFFITEM *) const { return true; }
+	} filter;
+	struct Helper
+	{
+		static int Compare(const CDiffContext *, const void *p, const void *q)
+		{
+			return *static_cast<const int *>(p) - *static_cast<const int *>(q);
+		}
+	};
+	DiffItemList list;
+	// Folder 1 with files 3, 2; file 0; folder 4 with file 5
+	DIFFITEM *const dir1 = list.AddDiff(NULL);
+	dir1->diffcode = DIFFCODE::DIR | DIFFCODE::BOTH;
+	dir1->nsdiffs = 1;
+	list.AddDiff(dir1)->nsdiffs = 3;
+	list.AddDiff(dir1)->nsdiffs = 2;
+	list.AddDiff(NULL)->nsdiffs = 0;
+	DIFFITEM *const dir4 = list.AddDiff(NULL);
+	dir4->diffcode = DIFFCODE::DIR | DIFFCODE::BOTH;
+	dir4->nsdiffs = 4;
+	list.AddDiff(dir4)->nsdiffs = 5;
+	DirListModel model;
+	model.SetOrder(NULL, offsetof(DIFFITEM, nsdiffs), NULL, &Helper::Compare, true);
+	// Flat mode shows files only, sorted across folders
+	model.SetSource(&list, &filter, false, true);
+	model.AppendChildren(NULL);
+	model.Sort(0);
+	assert(model.GetRowCount() == 4);
+	assert(model.GetItem(0)->nsdiffs == 0);
+	assert(model.GetItem(1)->nsdiffs == 2);
+	assert(model.GetItem(3)->nsdiffs == 5);
+	// Tree mode keeps children behind their parents
+	model.Clear();
+	model.SetSource(&list, &filter, true, true);
+	model.AppendChildren(NULL);
+	assert(model.GetRowCount() == 3);
+	dir1->customFlags1 |= ViewCustomFlags::EXPANDED;
+	assert(model.InsertChildren(model.Find(dir1)) == 2);
+	model.Sort(0);
+	assert(model.GetItem(0)->nsdiffs == 0);
+	assert(model.GetItem(1) == dir1);
+	assert(model.GetItem(2)->nsdiffs == 2);
+	assert(model.GetRow(2).level == 1);
+	assert(model.GetItem(3)->nsdiffs == 3);
+	assert(model.GetItem(4) == dir4);
+	model.SetItem(0, NULL);
+	assert(model.RemoveDetached(0) == 1);
+	assert(model.RemoveChildren(model.Find(dir1)) == 2);
+	assert(model.GetRowCount() == 2);
+	return 0;
+}
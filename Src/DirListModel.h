@@ -0,0 +1,96 @@
+/**
+ *  @file DirListModel.h
+ *
+ *  @brief Declaration of class DirListModel
+ */
+#pragma once
+
+struct DIFFITEM;
+class DiffItemList;
+class CDiffContext;
+
+struct ViewCustomFlags
+{
+	enum
+	{
+		// We use extra bits so that no valid values are 0
+		// and each set of flags is in a different hex digit
+		// to make debugging easier
+		// These can always be packed down in the future
+		VISIBILITY = 0x3, VISIBLE = 0x1, HIDDEN = 0x2, EXPANDED = 0x4
+	};
+};
+
+/**
+ * @brief Rows of the folder compare list.
+ * The list view runs in owner-data mode, so this class is where its rows
+ * live. Rows are kept in display order. In tree mode, a row's children
+ * follow it as a contiguous range of rows with greater level, which lets
+ * expand and collapse splice ranges instead of rebuilding all rows.
+ * The class does not depend on any windows.
+ */
+class DirListModel
+{
+public:
+	/** @brief Decides which items get a row. */
+	class Filter
+	{
+	public:
+		virtual bool IsShowable(const DIFFITEM *) const = 0;
+	};
+	typedef String (*GetFncPtrType)(const CDiffContext *, const void *);
+	typedef int (*SortFncPtrType)(const CDiffContext *, const void *, const void *);
+
+	struct Row
+	{
+		DIFFITEM *di; /**< Item, or NULL for a special item like ".." */
+		int level; /**< Indent level */
+		int image; /**< Image index, or I_IMAGECALLBACK */
+	};
+
+	DirListModel();
+	void SetSource(const DiffItemList *, const Filter *, bool bTreeMode, bool bRecursive);
+	void SetOrder(const CDiffContext *, size_t offset, GetFncPtrType, SortFncPtrType, bool bAscending);
+	void Clear();
+	void Append(DIFFITEM *, int level = 0, int image = I_IMAGECALLBACK);
+	void AppendChildren(const DIFFITEM *);
+	stl_size_t InsertChildren(stl_size_t i);
+	stl_size_t RemoveChildren(stl_size_t i);
+	stl_size_t RemoveDetached(stl_size_t i);
+	void Sort(stl_size_t i);
+	stl_size_t GetRowCount() const { return m_rows.size(); }
+	const Row &GetRow(stl_size_t i) const { return m_rows[i]; }
+	DIFFITEM *GetItem(stl_size_t i) const { return i < m_rows.size() ? m_rows[i].di : NULL; }
+	void SetItem(stl_size_t i, DIFFITEM *di) { m_rows[i].di = di; }
+	int Find(const DIFFITEM *) const;
+
+private:
+	/** @brief Row which heads a range of rows, with its sort key. */
+	struct Span
+	{
+		stl_size_t begin; /**< Index of heading row */
+		stl_size_t end; /**< End of heading row's children */
+		const void *arg; /**< Argument for sort function */
+		String text; /**< Display text if column has no sort function */
+	};
+	class SpanLess;
+	class SortPart;
+	/** @brief Item count below which sorting does not use extra threads. */
+	static stl_size_t const PARALLEL_SORT_MIN = 16384;
+	static UINT const MAX_THREADS = 8;
+	void CollectChildren(std::vector<Row> &, const DIFFITEM *, int level) const;
+	void SortRows(std::vector<Row> &, stl_size_t first, stl_size_t last) const;
+	void SortSpans(std::vector<Span> &) const;
+	std::vector<Row> m_rows;
+	const DiffItemList *m_pList;
+	const Filter *m_pFilter;
+	bool m_bTreeMode;
+	bool m_bRecursive;
+	// Current sort order
+	const CDiffContext *m_pCtxt;
+	size_t m_offset;
+	GetFncPtrType m_getfnc;
+	SortFncPtrType m_sortfnc;
+	bool m_bAscending;
+	bool m_bSorted; /**< Whether an order is set */
+};
@@ -261,6 +261,247 @@ int CDiffContext::DirScan_GetItems(
 	return 1;
 }
 
+/**
+ * @brief Order items of a folder by type and names.
+ */
+static bool IsItemBefore(const DIFFITEM *p, const DIFFITEM *q)
+{
+	UINT const ptype = p->diffcode & DIFFCODE::TYPEFLAGS;
+	UINT const qtype = q->diffcode & DIFFCODE::TYPEFLAGS;
+	if (ptype != qtype)
+		return ptype < qtype;
+	if (int const cmp = p->left.filename.compare(q->left.filename))
+		return cmp < 0;
+	return p->right.filename.compare(q->right.filename) < 0;
+}
+
+/**
+ * @brief Tell if a file has changed between two listings.
+ * Attributes which the listing and FileInfo::Update() may disagree upon,
+ * like the archive bit, do not count.
+ */
+static bool HasChanged(const DirItem &before, const DirItem &after)
+{
+	static const DWORD attributes =
+		FILE_ATTRIBUTE_READONLY | FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_SYSTEM;
+	return before.mtime != after.mtime
+		|| before.size.int64 != after.size.int64
+		|| ((before.flags.attributes ^ after.flags.attributes) & attributes) != 0;
+}
+
+/**
+ * @brief Bring the items of a folder in line with what is on disk.
+ * The folder is listed again, without walking into subfolders. Entries new
+ * to the folder are added along with their contents, and items whose
+ * entries have gone are removed. Items which still exist stay as they are,
+ * and are marked for rescan only if their size, time or attributes have
+ * changed. Contents of subfolders which still exist are left to refreshes
+ * of these subfolders.
+ * @param [in] parent Folder item to refresh, or NULL for the root folders.
+ * @return 1 normally, -1 if compare was aborted
+ */
+int CDiffContext::DirScan_RefreshItems(DIFFITEM *parent)
+{
+	static const TCHAR backslash[] = _T("\\");
+	String leftsubdir;
+	String rightsubdir;
+	String leftsubprefix;
+	String rightsubprefix;
+	bool bLeftUniq = false;
+	bool bRightUniq = false;
+	if (parent)
+	{
+		if (parent->isResultFiltered())
+			return 1;
+		bLeftUniq = parent->isSideLeftOnly();
+		bRightUniq = parent->isSideRightOnly();
+		// Unique folders have contents only if walked into
+		if ((bLeftUniq || bRightUniq) && !m_bWalkUniques)
+			return 1;
+		leftsubdir = paths_ConcatPath(parent->left.path, parent->left.filename);
+		rightsubdir = paths_ConcatPath(parent->right.path, parent->right.filename);
+		leftsubprefix = leftsubdir + backslash;
+		rightsubprefix = rightsubdir + backslash;
+	}
+	const int depth = m_nRecursive ? -1 : 0;
+
+	// Remember the items as they are, ordered for lookup
+	std::vector<DIFFITEM *> items;
+	DIFFITEM *last = NULL;
+	for (DIFFITEM *di = GetFirstChildDiff(parent); di != NULL; di = GetNextSiblingDiff(di))
+		items.push_back(last = di);
+	std::sort(items.begin(), items.end(), IsItemBefore);
+	std::vector<bool> found(items.size(), false);
+
+	// List the folder again, and match the new items against the old ones
+	int result = DirScan_GetItems(leftsubdir, bLeftUniq, rightsubdir, bRightUniq, 0, parent);
+	DIFFITEM *di = last ? GetNextSiblingDiff(last) : GetFirstChildDiff(parent);
+	while (result != -1 && di != NULL)
+	{
+		DIFFITEM *const next = GetNextSiblingDiff(di);
+		std::vector<DIFFITEM *>::iterator const it =
+			std::lower_bound(items.begin(), items.end(), di, IsItemBefore);
+		DIFFITEM *const old = it != items.end() && !IsItemBefore(di, *it) ? *it : NULL;
+		if (old && (old->diffcode & DIFFCODE::SIDEFLAGS) == (di->diffcode & DIFFCODE::SIDEFLAGS))
+		{
+			found[it - items.begin()] = true;
+			if (!old->isDirectory() && (HasChanged(old->left, di->left) || HasChanged(old->right, di->right)))
+			{
+				old->diffcode &= DIFFCODE::TYPEFLAGS | DIFFCODE::FILTERFLAGS;
+				old->diffcode |= DIFFCODE::NEEDSCAN;
+			}
+			RemoveDiff(di);
+		}
+		else
+		{
+			// Item is new, or replaces one which existed on other sides
+			if (depth != 0 && di->isDirectory() && (di->isSideBoth() || m_bWalkUniques))
+			{
+				String leftnewsub = leftsubprefix + di->left.filename;
+				String rightnewsub = rightsubprefix + di->right.filename;
+				if (!m_piFilterGlobal->includeDir(
+						_T(""), di->isSideRightOnly() ? _T("") : leftnewsub.c_str(),
+						_T(""), di->isSideLeftOnly() ? _T("") : rightnewsub.c_str()))
+				{
+					di->diffcode |= DIFFCODE::SKIPPED;
+				}
+				else
+				{
+					result = DirScan_GetItems(leftnewsub, di->isSideLeftOnly(),
+						rightnewsub, di->isSideRightOnly(), depth - 1, di);
+				}
+			}
+			DIFFITEM *p = di;
+			do
+			{
+				p->diffcode |= DIFFCODE::NEEDSCAN;
+			} while ((p = di->DeepGetNextItem(p)) != di);
+		}
+		di = next;
+	}
+
+	if (result == -1)
+	{
+		// Leave the folder as it was
+		while ((di = last ? GetNextSiblingDiff(last) : GetFirstChildDiff(parent)) != NULL)
+			RemoveDiff(di);
+		return -1;
+	}
+
+	// Remove items whose entries have gone
+	for (std::vector<DIFFITEM *>::size_type i = 0; i < items.size(); ++i)
+	{
+		if (!found[i])
+			RemoveDiff(items[i]);
+	}
+	return 1;
+}
+
+/**
+ * @brief Find the item of a folder below the roots.
+ * @param [in] folder Folder relative to the roots, not empty. Names in the
+ * path may match the folder item's name on either side.
+ * @return The folder item, or NULL if there is none.
+ */
+DIFFITEM *CDiffContext::FindFolderItem(const String &folder) const
+{
+	DIFFITEM *parent = NULL;
+	String::size_type i = 0;
+	for (;;)
+	{
+		String::size_type j = folder.find(_T('\\'), i);
+		if (j == String::npos)
+			j = folder.length();
+		String const name = folder.substr(i, j - i);
+		DIFFITEM *di = GetFirstChildDiff(parent);
+		while (di != NULL && !(di->isDirectory() &&
+			(lstrcmpi(di->left.filename.c_str(), name.c_str()) == 0 ||
+			lstrcmpi(di->right.filename.c_str(), name.c_str()) == 0)))
+		{
+			di = GetNextSiblingDiff(di);
+		}
+		if (di == NULL || j == folder.length())
+			return di;
+		parent = di;
+		i = j + 1;
+	}
+}
+
+/**
+ * @brief Tell what an item passes on to the folders above it.
+ * @param [in] diffcode Compare result of the item.
+ * @param [out] mask Flags of the folders to replace.
+ * @param [out] flag Flags to replace them with.
+ */
+static void GetParentFlags(UINT diffcode, UINT &mask, UINT &flag)
+{
+	switch (diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
+	{
+	case DIFFCODE::BOTH | DIFFCODE::SAME:
+		mask = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::SAME;
+		break;
+	case DIFFCODE::LEFT:
+		mask = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::DIFF;
+		break;
+	case DIFFCODE::RIGHT:
+		mask = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::DIFF;
+		break;
+	case DIFFCODE::BOTH | DIFFCODE::DIFF:
+		mask = DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::DIFF;
+		break;
+	case DIFFCODE::BOTH | DIFFCODE::CMPERR:
+		mask = DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::CMPERR;
+		break;
+	case DIFFCODE::BOTH | DIFFCODE::CMPABORT:
+		mask = DIFFCODE::COMPAREFLAGS;
+		flag = DIFFCODE::CMPABORT;
+		break;
+	}
+}
+
+/**
+ * @brief Recompute what folders tell about their contents.
+ * Compare threads only ever add to the flags of the folders above the items
+ * they compare. Once a refresh has removed or replaced items, this brings
+ * the flags of folders back in line with their contents, bottom-up.
+ * @param [in] parent Folder whose subfolders to recompute, or NULL for all.
+ */
+void CDiffContext::DirScan_UpdateFolderFlags(DIFFITEM *parent)
+{
+	static const UINT contains = DIFFCODE::CONTAINSIDENTICAL |
+		DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::CONTAINSRIGHTONLY;
+	for (DIFFITEM *di = GetFirstChildDiff(parent); di != NULL; di = GetNextSiblingDiff(di))
+	{
+		if (!di->isDirectory() || di->isResultFiltered())
+			continue;
+		DirScan_UpdateFolderFlags(di);
+		UINT code = di->diffcode & ~(contains | DIFFCODE::COMPAREFLAGS);
+		// See CompareDiffItem()
+		if (m_nRecursive != 0 && di->isSideBoth())
+			code |= DIFFCODE::SAME;
+		for (DIFFITEM *child = GetFirstChildDiff(di); child != NULL; child = GetNextSiblingDiff(child))
+		{
+			if (child->isResultFiltered())
+				continue;
+			UINT mask = 0;
+			UINT flag = 0;
+			GetParentFlags(child->diffcode, mask, flag);
+			flag |= child->diffcode & contains;
+			if (!di->isSideBoth() || (code & DIFFCODE::COMPAREFLAGS) > (flag & DIFFCODE::COMPAREFLAGS))
+				flag &= ~DIFFCODE::COMPAREFLAGS;
+			else
+				code &= ~DIFFCODE::COMPAREFLAGS;
+			code |= flag;
+		}
+		di->diffcode = code;
+	}
+}
+
 /**
  * @brief Compare DiffItems in list and add results to compare context.
  */
@@ -288,33 +529,7 @@ void CDiffContext::DirScan_CompareItems()
 
 		UINT mask = 0;
 		UINT flag = 0;
-		switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
-		{
-		case DIFFCODE::BOTH | DIFFCODE::SAME:
-			mask = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::SAME;
-			break;
-		case DIFFCODE::LEFT:
-			mask = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::RIGHT:
-			mask = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::DIFF:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::CMPERR:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CMPERR;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::CMPABORT:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CMPABORT;
-			break;
-		}
+		GetParentFlags(di->diffcode, mask, flag);
 		while (DIFFITEM *parent = di->parent)
 		{
 			EnterCriticalSection(&m_csCompareThread);
@@ -338,6 +553,8 @@ void CDiffContext::DirScan_CompareItems()
 void CDiffContext::DirScan_CompareRequestedItems()
 {
 	FolderCmp folderCmp(this, InterlockedIncrement(&m_iCompareThread));
+	// Wait for folders to be refreshed, if any
+	WaitForSingleObject(m_hSemaphore, INFINITE);
 	for (;;)
 	{
 		DIFFITEM *di;
@@ -367,33 +584,7 @@ void CDiffContext::DirScan_CompareRequestedItems()
 
 		UINT mask = 0;
 		UINT flag = 0;
-		switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
-		{
-		case DIFFCODE::BOTH | DIFFCODE::SAME:
-			mask = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSIDENTICAL | DIFFCODE::SAME;
-			break;
-		case DIFFCODE::LEFT:
-			mask = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSLEFTONLY | DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::RIGHT:
-			mask = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CONTAINSRIGHTONLY | DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::DIFF:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::DIFF;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::CMPERR:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CMPERR;
-			break;
-		case DIFFCODE::BOTH | DIFFCODE::CMPABORT:
-			mask = DIFFCODE::COMPAREFLAGS;
-			flag = DIFFCODE::CMPABORT;
-			break;
-		}
+		GetParentFlags(di->diffcode, mask, flag);
 		while (DIFFITEM *parent = di->parent)
 		{
 			EnterCriticalSection(&m_csCompareThread);
@@ -430,6 +621,10 @@ void CDiffContext::DirScan_CompareRequestedItems()
  */
 bool CDiffContext::UpdateDiffItem(DIFFITEM *di)
 {
+	// Compare threads never find extraction running, so only the main
+	// thread gets to restart it
+	bool const bExtracting = !m_rgExtractThreads.empty();
+	StopExtraction();
 	bool bExists = false;
 	// Clear side-info and file-infos
 	di->left.ClearPartial();
@@ -443,6 +638,9 @@ bool CDiffContext::UpdateDiffItem(DIFFITEM *di)
 		bExists = true;
 	else
 		di->diffcode &= ~DIFFCODE::RIGHT;
+	// Resume reading properties, including those just cleared
+	if (bExtracting)
+		ExtractProperties();
 	return bExists;
 }
 
@@ -463,6 +661,7 @@ bool CDiffContext::UpdateDiffItem(DIFFITEM *di)
  */
 void CDiffContext::CompareDiffItem(FolderCmp &fc, DIFFITEM *di)
 {
+	LONGLONG const nFilterStart = CompareStats::GetTicks();
 	// Is it a directory?
 	if (di->isDirectory())
 	{
@@ -471,6 +670,8 @@ void CDiffContext::CompareDiffItem(FolderCmp &fc, DIFFITEM *di)
 			di->left.path.c_str(), di->left.filename.c_str(),
 			di->right.path.c_str(), di->right.filename.c_str()) ?
 			DIFFCODE::INCLUDED : DIFFCODE::SKIPPED;
+		m_pCompareStats->AddPhaseTime(CompareStats::PHASE_FILTER,
+			CompareStats::GetTicks() - nFilterStart, fc.m_iCompareThread);
 		EnterCriticalSection(&m_csCompareThread);
 		di->diffcode |= flag;
 		// Beware race conditions. Set DIFFCODE::SAME only if not yet assigned
@@ -487,9 +688,12 @@ void CDiffContext::CompareDiffItem(FolderCmp &fc, DIFFITEM *di)
 	else
 	{
 		// 1. Test against filters
-		if (m_piFilterGlobal->includeFile(
+		bool const bIncluded = m_piFilterGlobal->includeFile(
 			di->left.path.c_str(), di->left.filename.c_str(),
-			di->right.path.c_str(), di->right.filename.c_str()))
+			di->right.path.c_str(), di->right.filename.c_str());
+		m_pCompareStats->AddPhaseTime(CompareStats::PHASE_FILTER,
+			CompareStats::GetTicks() - nFilterStart, fc.m_iCompareThread);
+		if (bIncluded)
 		{
 			di->diffcode |= DIFFCODE::INCLUDED;
 			// 2. Compare two files
@@ -517,7 +721,7 @@ void CDiffContext::CompareDiffItem(FolderCmp &fc, DIFFITEM *di)
 			di->diffcode |= DIFFCODE::SKIPPED;
 		}
 	}
-	StoreDiffData(di);
+	StoreDiffData(di, fc.m_iCompareThread);
 }
 
 /**
@@ -537,6 +741,9 @@ void CDiffContext::SetDiffItemStats(const FolderCmp &fc, DIFFITEM *di)
 	di->nsdiffs = fc.m_ndiffs;
 	di->nidiffs = fc.m_ntrivialdiffs;
 
+	m_pCompareStats->AddFileMetrics(fc.m_metrics,
+		max(di->left.size.int64, di->right.size.int64), fc.m_iCompareThread);
+
 	if (!di->isSideLeftOnly())
 	{
 		di->right.encoding = fc.m_diffFileData.m_FileLocation[1].encoding;
@@ -548,14 +755,16 @@ void CDiffContext::SetDiffItemStats(const FolderCmp &fc, DIFFITEM *di)
 	}
 }
 
-void CDiffContext::StoreDiffData(const DIFFITEM *di)
+void CDiffContext::StoreDiffData(const DIFFITEM *di, LONG iCompareThread)
 {
 	LogFile.Write
 	(
 		CLogFile::LCOMPAREDATA, _T("name=<%s>, leftdir=<%s>, rightdir=<%s>, code=%d"),
 		di->left.filename.c_str(), di->left.path.c_str(), di->right.path.c_str(), di->diffcode
 	);
-	m_pCompareStats->AddItem(di);
+	m_pCompareStats->AddItem(di, iCompareThread);
+	if (m_piItemSink)
+		m_piItemSink->OnDiffItem(this, di);
 }
 
 /**
@@ -638,6 +847,8 @@ DIFFITEM *CDiffContext::AddToList(
 		di->left.filename.c_str(), di->left.path.c_str(), di->right.path.c_str(), code
 	);
 	m_pCompareStats->IncreaseTotalItems();
-	ReleaseSemaphore(m_hSemaphore, 1, 0);
+	// Compare threads wait for a refresh as a whole, see DiffThreadRefresh()
+	if (!m_bOnlyRequested)
+		ReleaseSemaphore(m_hSemaphore, 1, 0);
 	return di;
 }
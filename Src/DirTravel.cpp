@@ -11,6 +11,7 @@
 #include "Common/defer.h"
 #include "Common/stream_util.h"
 #include "DiffContext.h"
+#include "ArchiveListing.h"
 #include "FileFilterHelper.h"
 #include "DirItem.h"
 #include "CompareStats.h"
@@ -230,6 +231,17 @@ void CDiffContext::LoadFiles(LPCTSTR sDir, DirItemArray *dirs, DirItemArray *fil
 				}
 			} while (FindNextFile(h, &ff));
 		}
+		// Add files which are deferred from extraction
+		if (const ArchiveListing *pListing = m_pArchiveListing[side])
+		{
+			UINT n = pListing->LoadDeferredFiles(sDir, files);
+			// If recursing the flat way, increment total count of items
+			if (m_nRecursive == 2)
+			{
+				while (n--)
+					m_pCompareStats->IncreaseTotalItems();
+			}
+		}
 	}
 }
 
@@ -81,6 +81,7 @@ CDirView::CDirView(CDirFrame *pFrame)
 	, m_pCmpProgressDlg(NULL)
 	, m_compareStart(0)
 	, m_bTreeMode(COptionsMgr::Get(OPT_TREE_MODE))
+	, m_pFileScriptUpdater(NULL)
 	, m_pShellContextMenuLeft(new CShellContextMenu(LeftCmdFirst, LeftCmdLast))
 	, m_hShellContextMenuLeft(NULL)
 	, m_pShellContextMenuRight(new CShellContextMenu(RightCmdFirst, RightCmdLast))
@@ -126,6 +127,12 @@ LRESULT CDirView::WindowProc(UINT uMsg, WPARAM wParam, LPARAM lParam)
 	case MSG_UI_UPDATE:
 		OnUpdateUIMessage();
 		return 0;
+	case MSG_PROPERTIES_READY:
+		OnPropertiesReady();
+		return 0;
+	case MSG_FOLDERS_CHANGED:
+		m_pFrame->RescanChanges();
+		return 0;
 	case WM_DRAWITEM:
 		if (reinterpret_cast<DRAWITEMSTRUCT *>(lParam)->CtlType == ODT_HEADER)
 			return m_ctlSortHeader.DrawItem(reinterpret_cast<DRAWITEMSTRUCT *>(lParam));
@@ -209,6 +216,9 @@ void CDirView::OnInitialUpdate()
 	// Also enable infotips.
 	DWORD exstyle = LVS_EX_FULLROWSELECT | LVS_EX_HEADERDRAGDROP | LVS_EX_INFOTIP;
 	SetExtendedStyle(exstyle);
+
+	// Expand/collapse state of tree mode folders comes through LVN_GETDISPINFO
+	SetCallbackMask(LVIS_STATEIMAGEMASK);
 }
 
 /**
@@ -252,51 +262,33 @@ void CDirView::ReloadColumns()
 }
 
 /**
- * @brief Redisplay items in subfolder
- * @param [in] diffpos First item position in subfolder.
- * @param [in] level Indent level
- * @param [in,out] index Index of the item to be inserted.
- * @param [in,out] alldiffs Number of different items
+ * @brief Collect items to report, in the order in which the list shows them.
+ * Unless only selected items are requested, this reads the rows from the
+ * model rather than from the list control.
+ * Special items like ".." are not included.
+ * @param [out] items Receives the items.
+ * @param [in] bSelectedOnly Whether to collect only the selected items.
  */
-void CDirView::RedisplayChildren(DIFFITEM *di, int level, int &index, int &alldiffs)
+void CDirView::GetReportItems(std::vector<DIFFITEM *> &items, bool bSelectedOnly)
 {
-	const CDiffContext *const ctxt = m_pFrame->GetDiffContext();
-	di = ctxt->GetFirstChildDiff(di);
-	while (di != NULL)
+	items.clear();
+	if (bSelectedOnly)
 	{
-		if (!di->isResultSame())
-			++alldiffs;
-
-		if (m_pFrame->IsShowable(di))
+		// Selection state lives in the list only
+		int i = -1;
+		while ((i = GetNextItem(i, LVNI_SELECTED)) != -1)
 		{
-			if (m_bTreeMode)
-			{
-				AddNewItem(index, di, I_IMAGECALLBACK, level);
-				index++;
-				if (di->HasChildren())
-				{
-					SetItemState(index - 1, INDEXTOSTATEIMAGEMASK((di->customFlags1 & ViewCustomFlags::EXPANDED) ? 2 : 1), LVIS_STATEIMAGEMASK);
-					if (di->customFlags1 & ViewCustomFlags::EXPANDED)
-						RedisplayChildren(di, level + 1, index, alldiffs);
-				}
-			}
-			else
-			{
-				if (m_pFrame->GetRecursive() == 0 ||
-					!di->isDirectory() ||
-					di->isSideLeftOnly() ||
-					di->isSideRightOnly())
-				{
-					AddNewItem(index, di, I_IMAGECALLBACK, 0);
-					index++;
-				}
-				if (di->HasChildren())
-				{
-					RedisplayChildren(di, level + 1, index, alldiffs);
-				}
-			}
+			if (DIFFITEM *di = GetDiffItem(i))
+				items.push_back(di);
 		}
-		di = ctxt->GetNextSiblingDiff(di);
+		return;
+	}
+	stl_size_t const count = m_rows.GetRowCount();
+	items.reserve(count);
+	for (stl_size_t i = m_nSpecialItems; i < count; ++i)
+	{
+		if (DIFFITEM *di = m_rows.GetItem(i))
+			items.push_back(di);
 	}
 }
 
@@ -307,7 +299,6 @@ void CDirView::RedisplayChildren(DIFFITEM *di, int level, int &index, int &alldi
  */
 void CDirView::Redisplay()
 {
-	int cnt = 0;
 	// Disable redrawing while adding new items
 	SetRedraw(FALSE);
 
@@ -324,13 +315,15 @@ void CDirView::Redisplay()
 		if (m_pFrame->GetRecursive() == 0 ||
 			m_pFrame->AllowUpwardDirectory(leftParent, rightParent) == CDirFrame::AllowUpwardDirectory::ParentIsTempPath)
 		{
-			cnt += m_nSpecialItems = AddSpecialItems();
+			m_nSpecialItems = AddSpecialItems();
 		}
 	}
 
-	int alldiffs = 0;
-	RedisplayChildren(NULL, 0, cnt, alldiffs);
+	m_rows.SetSource(m_pFrame->GetDiffContext(), m_pFrame,
+		m_bTreeMode, m_pFrame->GetRecursive() != 0);
+	m_rows.AppendChildren(NULL);
 	SortColumnsAppropriately();
+	SetItemCount(static_cast<int>(m_rows.GetRowCount()));
 	SetRedraw(TRUE);
 
 	if (DIFFITEM *di = m_pFrame->FindItemFromPaths(m_lastLeftPath.c_str(), m_lastRightPath.c_str()))
@@ -394,6 +387,9 @@ void CDirView::ListContextMenu(POINT point)
 {
 	CMainFrame *const pMDIFrame = m_pFrame->m_pMDIFrame;
 
+	// Shell context menus need the files to exist
+	ExtractDeferredSelection();
+
 	const BOOL leftRO = m_pFrame->GetLeftReadOnly();
 	const BOOL rightRO = m_pFrame->GetRightReadOnly();
 	// TODO: It would be more efficient to set
@@ -685,9 +681,108 @@ void CDirView::SortColumnsAppropriately()
 
 	bool bSortAscending = COptionsMgr::Get(OPT_DIRVIEW_SORT_ASCENDING);
 	m_ctlSortHeader.SetSortImage(ColLogToPhys(sortCol), bSortAscending);
-	//sort using static CompareFunc comparison function
-	CompareState cs(this, sortCol, bSortAscending);
-	SortItems(cs.CompareFunc, reinterpret_cast<DWORD_PTR>(&cs));
+	const DirColInfo &colInfo = f_cols[sortCol];
+	m_rows.SetOrder(m_pFrame->GetDiffContext(), colInfo.offset,
+		colInfo.getfnc, colInfo.sortfnc, bSortAscending);
+	std::vector<DIFFITEM *> selection;
+	DIFFITEM *const focus = DetachSelection(selection);
+	m_rows.Sort(m_nSpecialItems);
+	RestoreSelection(selection, focus);
+	Invalidate();
+}
+
+/**
+ * @brief Deselect items and remember them, before rows are reordered.
+ * The list runs in owner-data mode, where selection sticks to indexes
+ * rather than to rows.
+ * @param [out] selection Receives the selected items, sorted by address.
+ * @return The focused item, or NULL if none.
+ */
+DIFFITEM *CDirView::DetachSelection(std::vector<DIFFITEM *> &selection)
+{
+	DIFFITEM *const focus = GetDiffItem(GetFocusedItem());
+	int i = m_nSpecialItems - 1;
+	while ((i = GetNextItem(i, LVNI_SELECTED)) != -1)
+	{
+		if (DIFFITEM *di = GetDiffItem(i))
+			selection.push_back(di);
+		SetItemState(i, 0, LVIS_SELECTED);
+	}
+	std::sort(selection.begin(), selection.end());
+	return focus;
+}
+
+/**
+ * @brief Reselect items remembered by DetachSelection().
+ */
+void CDirView::RestoreSelection(const std::vector<DIFFITEM *> &selection, DIFFITEM *focus)
+{
+	if (!selection.empty())
+	{
+		int const count = static_cast<int>(m_rows.GetRowCount());
+		for (int i = m_nSpecialItems; i < count; ++i)
+		{
+			if (std::binary_search(selection.begin(), selection.end(), GetDiffItem(i)))
+				SetItemState(i, LVIS_SELECTED, LVIS_SELECTED);
+		}
+	}
+	if (focus != NULL)
+	{
+		int const i = GetItemIndex(focus);
+		if (i != -1)
+			SetItemState(i, LVIS_FOCUSED, LVIS_FOCUSED);
+	}
+}
+
+/**
+ * @brief Update list after rows have been inserted or removed at given index.
+ * Selection and focus behind the splice point move along with their rows.
+ * @param [in] i Index of first row inserted or removed.
+ * @param [in] nRemoved Number of rows removed.
+ * @param [in] nInserted Number of rows inserted.
+ */
+void CDirView::SpliceRows(int i, int nRemoved, int nInserted)
+{
+	std::vector<int> selection;
+	int j = i - 1;
+	while ((j = GetNextItem(j, LVNI_SELECTED)) != -1)
+	{
+		selection.push_back(j);
+		SetItemState(j, 0, LVIS_SELECTED);
+	}
+	int const focus = GetFocusedItem();
+	SetItemCountEx(static_cast<int>(m_rows.GetRowCount()), LVSICF_NOSCROLL);
+	int const shift = nInserted - nRemoved;
+	std::vector<int>::const_iterator it = selection.begin();
+	while (it != selection.end())
+	{
+		j = *it++;
+		if (j >= i + nRemoved)
+			SetItemState(j + shift, LVIS_SELECTED, LVIS_SELECTED);
+	}
+	if (focus >= i + nRemoved)
+		SetItemState(focus + shift, LVIS_FOCUSED, LVIS_FOCUSED);
+}
+
+/**
+ * @brief Remove all rows.
+ */
+void CDirView::DeleteAllItems()
+{
+	m_rows.Clear();
+	OListView::DeleteAllItems();
+}
+
+/**
+ * @brief Remove rows whose item has been detached.
+ */
+void CDirView::RemoveDetachedItems()
+{
+	std::vector<DIFFITEM *> selection;
+	DIFFITEM *const focus = DetachSelection(selection);
+	m_rows.RemoveDetached(m_nSpecialItems);
+	SetItemCountEx(static_cast<int>(m_rows.GetRowCount()), LVSICF_NOSCROLL);
+	RestoreSelection(selection, focus);
 }
 
 /// Do any last minute work as view closes
@@ -732,24 +827,6 @@ void CDirView::ReflectClick(NMITEMACTIVATE *pNM)
 		ReflectItemActivate(pNM);
 }
 
-/**
- * @brief Delete children
- * @param [in] dpi Ancestor item.
- * @param [in] i First child item index in listview.
- */
-void CDirView::DeleteChildren(const DIFFITEM *dip, int i)
-{
-	int count = GetItemCount();
-	while (count > i)
-	{
-		const DIFFITEM *di = GetDiffItem(i);
-		if (!di->IsAncestor(dip))
-			break;
-		DeleteItem(i);
-		--count;
-	}
-}
-
 /**
  * @brief Detach item and all its children but leave ListView lines in place
  */
@@ -757,15 +834,15 @@ void CDirView::DetachItem(int i)
 {
 	if (const DIFFITEM *dip = GetDiffItem(i))
 	{
-		SetItemData(i, 0);
+		m_rows.SetItem(i, NULL);
 		if (dip->HasChildren())
 		{
-			i = GetItemCount();
+			i = static_cast<int>(m_rows.GetRowCount());
 			while (i > m_nSpecialItems)
 			{
 				const DIFFITEM *di = GetDiffItem(--i);
 				if (di && di->IsAncestor(dip))
-					SetItemData(i, 0);
+					m_rows.SetItem(i, NULL);
 			}
 		}
 	}
@@ -785,8 +862,8 @@ int CDirView::CollapseSubdir(int i)
 		}
 		SetRedraw(FALSE);	// Turn off updating (better performance)
 		dip->customFlags1 &= ~ViewCustomFlags::EXPANDED;
-		SetItemState(i, INDEXTOSTATEIMAGEMASK(1), LVIS_STATEIMAGEMASK);
-		DeleteChildren(dip, ++i);
+		int const nRemoved = static_cast<int>(m_rows.RemoveChildren(i));
+		SpliceRows(i + 1, nRemoved, 0);
 		SetRedraw(TRUE);	// Turn updating back on
 	}
 	return -1;
@@ -810,11 +887,8 @@ int CDirView::ExpandSubdir(int i)
 		{
 			SetRedraw(FALSE);	// Turn off updating (better performance)
 			dip->customFlags1 |= ViewCustomFlags::EXPANDED;
-			SetItemState(i, INDEXTOSTATEIMAGEMASK(2), LVIS_STATEIMAGEMASK);
-			++i;
-			int alldiffs;
-			RedisplayChildren(dip, dip->GetDepth() + 1, i, alldiffs);
-			SortColumnsAppropriately();
+			int const nInserted = static_cast<int>(m_rows.InsertChildren(i));
+			SpliceRows(i + 1, 0, nInserted);
 			SetRedraw(TRUE);	// Turn updating back on
 		}
 	}
@@ -834,7 +908,6 @@ void CDirView::DeepExpandSubdir(int i)
 		{
 			SetRedraw(FALSE);	// Turn off updating (better performance)
 			dip->customFlags1 |= ViewCustomFlags::EXPANDED;
-			SetItemState(i, INDEXTOSTATEIMAGEMASK(2), LVIS_STATEIMAGEMASK);
 			while (di)
 			{
 				if (!di->IsAncestor(dip))
@@ -843,10 +916,9 @@ void CDirView::DeepExpandSubdir(int i)
 					di->customFlags1 |= ViewCustomFlags::EXPANDED;
 				di = ctxt->GetNextDiff(di);
 			}
-			DeleteChildren(dip, ++i);
-			int alldiffs;
-			RedisplayChildren(dip, dip->GetDepth() + 1, i, alldiffs);
-			SortColumnsAppropriately();
+			int const nRemoved = static_cast<int>(m_rows.RemoveChildren(i));
+			int const nInserted = static_cast<int>(m_rows.InsertChildren(i));
+			SpliceRows(i + 1, nRemoved, nInserted);
 			SetRedraw(TRUE);	// Turn updating back on
 		}
 	}
@@ -1000,6 +1072,7 @@ bool CDirView::OpenTwoItems(const DIFFITEM *di1, const DIFFITEM *di2, String &pa
 void CDirView::OpenSelection(LPCTSTR szCompareAs, UINT idCompareAs)
 {
 	WaitStatusCursor waitstatus(IDS_STATUS_OPENING_SELECTION);
+	ExtractDeferredSelection();
 	// First, figure out what was selected (store into di[])
 	const DIFFITEM *di[] = { NULL, NULL };
 	FileLocation filelocLeft, filelocRight;
@@ -1060,19 +1133,15 @@ void CDirView::OpenSelection(LPCTSTR szCompareAs, UINT idCompareAs)
  */
 DIFFITEM *CDirView::GetDiffItem(int sel)
 {
-	return reinterpret_cast<DIFFITEM *>(GetItemData(sel));
+	return m_rows.GetItem(sel);
 }
 
 /**
  * @brief Given key, get index of item which has it stored.
- * This function searches from list in UI.
  */
 int CDirView::GetItemIndex(DIFFITEM *di)
 {
-	LVFINDINFO findInfo;
-	findInfo.flags = LVFI_PARAM;  // Search for itemdata
-	findInfo.lParam = reinterpret_cast<LPARAM>(di);
-	return FindItem(&findInfo);
+	return m_rows.Find(di);
 }
 
 // Go to first diff
@@ -1347,6 +1416,23 @@ void CDirView::OnUpdateUIMessage()
 	theApp.m_pMainWnd->StartFlashing();
 }
 
+/**
+ * @brief Show properties which background threads have finished reading.
+ * Re-sorts if the list is sorted by such properties.
+ */
+void CDirView::OnPropertiesReady()
+{
+	// A running file script refers to items by their rows, and restarts
+	// extraction when done
+	if (m_pFileScriptUpdater)
+		return;
+	int const sortCol = COptionsMgr::Get(OPT_DIRVIEW_SORT_COLUMN);
+	if (sortCol >= 0 && sortCol < g_ncols && ColumnShowsProperties(sortCol))
+		SortColumnsAppropriately();
+	else
+		Invalidate();
+}
+
 LRESULT CDirView::ReflectNotify(UNotify *pNM)
 {
 	if (pNM->HDR.hwndFrom == m_pFrame->m_wndStatusBar->m_hWnd)
@@ -1367,6 +1453,8 @@ LRESULT CDirView::ReflectNotify(UNotify *pNM)
 	case LVN_GETDISPINFO:
 		ReflectGetdispinfo(&pNM->LVDISPINFO);
 		break;
+	case LVN_ODFINDITEM:
+		return ReflectOdFindItem(&pNM->LVFINDITEM);
 	case LVN_KEYDOWN:
 		return ReflectKeydown(&pNM->LVKEYDOWN);
 	case LVN_BEGINLABELEDIT:
@@ -1494,7 +1582,7 @@ void CDirView::OnToolsSaveToXLS(LPCTSTR verb, int flags)
 		string_replace(exp.sHeader, _T("<right>"), tmp.c_str());
 		string_replace(exp.sFooter, _T("<right>"), tmp.c_str());
 		// Write the workbook
-		exp.WriteWorkbook(static_cast<HListView *>(m_pWnd), flags);
+		exp.WriteWorkbook(this, flags);
 		// Close the file, and optionally launch Excel Viewer
 		exp.Close(verb);
 	}
@@ -1521,7 +1609,7 @@ int CDirView::AddSpecialItems()
 		// fall through
 	default:
 		// Add "Parent folder" ("..") item to directory view
-		AddNewItem(0, NULL, iImgDirUp, 0);
+		m_rows.Append(NULL, 0, iImgDirUp);
 		retVal = 1;
 		// fall through
 	case CDirFrame::AllowUpwardDirectory::Never:
@@ -1596,13 +1684,10 @@ void CDirView::OnSelectAll()
 	}
 	else
 	{
-		int n = GetItemCount();
-		for (int i = 0; i < n; i++)
-		{
-			// Don't select special items (SPECIAL_ITEM_POS)
-			if (GetDiffItem(i) != NULL)
-				SetItemState(i, LVIS_SELECTED, LVIS_SELECTED);
-		}
+		SetItemState(-1, LVIS_SELECTED, LVIS_SELECTED);
+		// Don't select special items (SPECIAL_ITEM_POS)
+		for (int i = 0; i < m_nSpecialItems; i++)
+			SetItemState(i, 0, LVIS_SELECTED);
 	}
 }
 
@@ -1793,15 +1878,15 @@ void CDirView::OnHideFilenames()
 			for (int i = sel + 1; i < count; i++)
 			{
 				const DIFFITEM *dic = GetDiffItem(i);
-				if (!dic->IsAncestor(di))
+				if (dic == NULL || !dic->IsAncestor(di))
 					break;
-				DeleteItem(i--);
-				count--;
+				m_rows.SetItem(i, NULL);
 			}
 		}
-		DeleteItem(sel--);
+		m_rows.SetItem(sel, NULL);
 		m_nHiddenItems++;
 	}
+	RemoveDetachedItems();
 	SetRedraw(TRUE);	// Turn updating back on
 }
 
@@ -1815,7 +1900,7 @@ LRESULT CDirView::ReflectCustomDraw(NMLVCUSTOMDRAW *pNM)
 	case CDDS_ITEMPREPAINT:
 		return CDRF_NOTIFYITEMDRAW;
 	case CDDS_ITEMPREPAINT | CDDS_SUBITEM:
-		if (DIFFITEM *di = reinterpret_cast<DIFFITEM *>(pNM->nmcd.lItemlParam))
+		if (DIFFITEM *di = GetDiffItem(static_cast<int>(pNM->nmcd.dwItemSpec)))
 		{
 			COLORREF const clrText = ::GetSysColor(COLOR_WINDOWTEXT);
 			COLORREF const clrTextBk = ::GetSysColor(COLOR_WINDOW);
@@ -1905,7 +1990,7 @@ LRESULT CDirView::ReflectCustomDraw(NMLVCUSTOMDRAW *pNM)
  */
 LRESULT CDirView::ReflectBeginLabelEdit(NMLVDISPINFO *pdi)
 {
-	if ((GetSelectedCount() != 1) || (pdi->item.lParam == NULL))
+	if ((GetSelectedCount() != 1) || (GetDiffItem(pdi->item.iItem) == NULL))
 		return 1;
 	// If label edit is allowed.
 	// Locate the edit box on the right column in case the user changed the
@@ -2219,6 +2304,7 @@ LRESULT CDirView::HandleMenuMessage(UINT message, WPARAM wParam, LPARAM lParam)
  */
 void CDirView::PrepareDragData(UniStdioFile &file)
 {
+	ExtractDeferredSelection();
 	const CDiffContext *const ctxt = m_pFrame->GetDiffContext();
 	int i = -1;
 	while ((i = GetNextItem(i, LVNI_SELECTED)) != -1)
@@ -26,6 +26,7 @@
 // CDirView view
 #include "Constants.h"
 #include "SortHeaderCtrl.h"
+#include "DirListModel.h"
 
 class FileActionScript;
 
@@ -39,6 +40,7 @@ class CDirFrame;
 class PackingInfo;
 class PathContext;
 class DirCmpReport;
+class CExcelExport;
 class CDiffContext;
 class DirCompProgressDlg;
 struct DirColInfo;
@@ -46,18 +48,6 @@ class CLoadSaveCodepageDlg;
 class CShellContextMenu;
 class UniStdioFile;
 
-struct ViewCustomFlags
-{
-	enum
-	{
-		// We use extra bits so that no valid values are 0
-		// and each set of flags is in a different hex digit
-		// to make debugging easier
-		// These can always be packed down in the future
-		VISIBILITY = 0x3, VISIBLE = 0x1, HIDDEN = 0x2, EXPANDED = 0x4
-	};
-};
-
 /** Default column width in directory compare */
 const UINT DefColumnWidth = 150;
 
@@ -79,8 +69,11 @@ class CDirView
 {
 	class DirItemEnumerator;
 	friend DirItemEnumerator;
+	class FileScriptUpdater;
+	friend FileScriptUpdater;
 	friend CDirFrame;
 	friend DirCmpReport;
+	friend CExcelExport;
 public:
 	explicit CDirView(CDirFrame *);
 	virtual ~CDirView();
@@ -109,11 +102,13 @@ public:
 
 	void StartCompare();
 	void Redisplay();
-	void RedisplayChildren(DIFFITEM *diffpos, int level, int &index, int &alldiffs);
+	void DeleteAllItems();
 	void UpdateResources();
 	int GetItemIndex(DIFFITEM *);
 	void SortColumnsAppropriately();
 	DIFFITEM *GetDiffItem(int sel);
+	void GetReportItems(std::vector<DIFFITEM *> &, bool bSelectedOnly);
+	String GetCellText(int col, const DIFFITEM *) const;
 
 	static bool IsShellMenuCmdID(UINT);
 	LRESULT HandleMenuMessage(UINT message, WPARAM wParam, LPARAM lParam);
@@ -149,13 +144,15 @@ private:
 	void DoOpenFolder(SIDE_TYPE);
 	bool ConfirmActionList(FileActionScript &);
 	void PerformActionList(FileActionScript &);
-	void UpdateAfterFileScript(FileActionScript &);
+	void UpdateAfterFileScript(FileActionScript &, FileScriptUpdater &);
 	int MarkSelectedForRescan();
+	void ExtractDeferredSelection();
 	void DoFileEncodingDialog();
 	bool DoItemRename(int iItem, LPCTSTR szNewItemName);
 	bool RenameOnSameDir(LPCTSTR szOldFileName, LPCTSTR szNewFileName);
 // End DirActions.cpp
 	void ReflectGetdispinfo(NMLVDISPINFO *);
+	int ReflectOdFindItem(NMLVFINDITEM *);
 	LRESULT ReflectKeydown(NMLVKEYDOWN *);
 	LRESULT ReflectBeginLabelEdit(NMLVDISPINFO *);
 	LRESULT ReflectEndLabelEdit(NMLVDISPINFO *);
@@ -166,21 +163,10 @@ private:
 	void ReflectBeginDrag();
 // Implementation in DirViewColHandler.cpp
 public:
-	// class CompareState is used to pass parameters to the PFNLVCOMPARE callback function.
-	class CompareState
-	{
-	private:
-		const CDirView *const pView;
-		const int sortCol;
-		const bool bSortAscending;
-	public:
-		CompareState(const CDirView *, int sortCol, bool bSortAscending);
-		static int CALLBACK CompareFunc(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort);
-	} friend;
 	void UpdateDiffItemStatus(UINT nIdx);
 private:
 	void UpdateColumns(UINT lvcf);
-	int AddNewItem(int i, const DIFFITEM *di, int iImage, int iIndent);
+	int AddNewItem(DIFFITEM *di);
 	int ColPhysToLog(int i) const { return m_invcolorder[i]; }
 	int ColLogToPhys(int i) const { return m_colorder[i]; } /**< -1 if not displayed */
 	String GetColDisplayName(int col) const;
@@ -190,8 +176,7 @@ private:
 	void ClearColumnOrders();
 	void ResetColumnOrdering();
 	void MoveColumn(int psrc, int pdest);
-	String ColGetTextToDisplay(int col, const DIFFITEM *di);
-	int ColSort(int col, const DIFFITEM *ldi, const DIFFITEM *rdi) const;
+	String ColGetTextToDisplay(int col, const DIFFITEM *di) const;
 // End DirViewCols.cpp
 
 // Implementation in DirViewColItems.cpp
@@ -214,6 +199,7 @@ private:
 	};
 	static const DirColInfo f_cols[];
 	static const int g_ncols;
+	static bool ColumnShowsProperties(int col);
 // End DirViewColItems.cpp
 
 public:
@@ -231,6 +217,10 @@ protected:
 	int GetFirstDifferentItem();
 	int GetLastDifferentItem();
 	int AddSpecialItems();
+	DIFFITEM *DetachSelection(std::vector<DIFFITEM *> &);
+	void RestoreSelection(const std::vector<DIFFITEM *> &, DIFFITEM *focus);
+	void SpliceRows(int i, int nRemoved, int nInserted);
+	void RemoveDetachedItems();
 	bool OpenOneItem(const DIFFITEM *, String &path1, String &path2);
 	bool OpenTwoItems(const DIFFITEM *, const DIFFITEM *, String &path1, String &path2);
 
@@ -249,7 +239,9 @@ protected:
 	int m_cxExtraSpacing;
 	int m_nHiddenItems; /**< Count of items we have hidden */
 	int m_nSpecialItems; /**< Count of special items */
+	DirListModel m_rows; /**< Rows shown in the owner-data list */
 	bool m_bTreeMode; /**< TRUE if tree mode is on*/
+	FileScriptUpdater *m_pFileScriptUpdater; /**< Updater of a running file script */
 	DirCompProgressDlg *m_pCmpProgressDlg;
 	clock_t m_compareStart; /**< Starting process time of the compare */
 	String m_lastCopyFolder; /**< Last Copy To -target folder. */
@@ -271,6 +263,7 @@ protected:
 	void OnPrevdiff();
 	void OnCurdiff();
 	void OnUpdateUIMessage();
+	void OnPropertiesReady();
 	void OnEditColumns();
 	void OnCustomizeColumns();
 	void OnToolsGenerateReport();
@@ -312,7 +305,6 @@ private:
 	HMENU ListShellContextMenu(SIDE_TYPE);
 	void ReloadColumns();
 	void ResetColumnWidths();
-	void DeleteChildren(const DIFFITEM *, int);
 	void DetachItem(int);
 	int CollapseSubdir(int);
 	int ExpandSubdir(int);
@@ -29,7 +29,7 @@
  * @param [in] di Difference data.
  * @return Text for the specified column.
  */
-String CDirView::ColGetTextToDisplay(int col, const DIFFITEM *di)
+String CDirView::ColGetTextToDisplay(int col, const DIFFITEM *di) const
 {
 	CDiffContext const *const pCtxt = m_pFrame->GetDiffContext();
 	// Custom properties have custom get functions
@@ -37,66 +37,6 @@ String CDirView::ColGetTextToDisplay(int col, const DIFFITEM *di)
 	return (*colInfo.getfnc)(pCtxt, reinterpret_cast<const char *>(di) + colInfo.offset);
 }
 
-/**
- * @brief Sort two items on specified column.
- * This function determines order of two items in specified column. Order
- * is determined by column-specific functions.
- * @param [in] pCtxt Compare context.
- * @param [in] col Column number to sort.
- * @param [in] ldi Left difference item data.
- * @param [in] rdi Right difference item data.
- * @return Order of items.
- */
-int CDirView::ColSort(int col, const DIFFITEM *ldi, const DIFFITEM *rdi) const
-{
-	CDiffContext const *const pCtxt = m_pFrame->GetDiffContext();
-	// Custom properties have custom sort functions
-	const DirColInfo &colInfo = f_cols[col];
-	const size_t offset = colInfo.offset;
-	const void *arg1;
-	const void *arg2;
-	if (m_bTreeMode)
-	{
-		const DIFFITEM *lcur = ldi;
-		const DIFFITEM *rcur = rdi;
-		int lLevel = lcur->GetDepth();
-		int rLevel = rcur->GetDepth();
-		while (lLevel < rLevel)
-		{
-			--rLevel;
-			rcur = rcur->parent;
-		}
-		while (lLevel > rLevel)
-		{
-			--lLevel;
-			lcur = lcur->parent;
-		}
-		while (lcur->parent != rcur->parent)
-		{
-			lcur = lcur->parent;
-			rcur = rcur->parent;
-		}
-		arg1 = reinterpret_cast<const char *>(lcur) + offset;
-		arg2 = reinterpret_cast<const char *>(rcur) + offset;
-	}
-	else
-	{
-		arg1 = reinterpret_cast<const char *>(ldi) + offset;
-		arg2 = reinterpret_cast<const char *>(rdi) + offset;
-	}
-	if (ColSortFncPtrType fnc = colInfo.sortfnc)
-	{
-		return (*fnc)(pCtxt, arg1, arg2);
-	}
-	if (ColGetFncPtrType fnc = colInfo.getfnc)
-	{
-		String p = (*fnc)(pCtxt, arg1);
-		String q = (*fnc)(pCtxt, arg2);
-		return lstrcmpi(p.c_str(), q.c_str());
-	}
-	return 0;
-}
-
 /// Update column names (as per selected UI language) / width / alignment
 void CDirView::UpdateColumns(UINT lvcf)
 {
@@ -130,43 +70,13 @@ void CDirView::UpdateColumns(UINT lvcf)
 	Invalidate();
 }
 
-CDirView::CompareState::CompareState(const CDirView *pView, int sortCol, bool bSortAscending)
-: pView(pView)
-, sortCol(sortCol)
-, bSortAscending(bSortAscending)
-{
-}
-
-/// Compare two specified rows during a sort operation (windows callback)
-int CALLBACK CDirView::CompareState::CompareFunc(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort)
-{
-	CompareState *pThis = reinterpret_cast<CompareState*>(lParamSort);
-	// Sort special items always first in dir view
-	if (lParam1 == 0)
-		return -1;
-	if (lParam2 == 0)
-		return 1;
-
-	const DIFFITEM *ldi = reinterpret_cast<DIFFITEM *>(lParam1);
-	const DIFFITEM *rdi = reinterpret_cast<DIFFITEM *>(lParam2);
-	// compare 'left' and 'right' parameters as appropriate
-	int retVal = pThis->pView->ColSort(pThis->sortCol, ldi, rdi);
-	// return compare result, considering sort direction
-	return pThis->bSortAscending ? retVal : -retVal;
-}
-
-/// Add new item to list view
-int CDirView::AddNewItem(int i, const DIFFITEM *di, int iImage, int iIndent)
+/// Add new item to the end of the list
+int CDirView::AddNewItem(DIFFITEM *di)
 {
-	LV_ITEM lvItem;
-	lvItem.mask = LVIF_TEXT | LVIF_PARAM | LVIF_IMAGE | LVIF_INDENT;
-	lvItem.iItem = i;
-	lvItem.iIndent = iIndent;
-	lvItem.iSubItem = 0;
-	lvItem.pszText = LPSTR_TEXTCALLBACK;
-	lvItem.lParam = reinterpret_cast<LPARAM>(di);
-	lvItem.iImage = iImage;
-	return InsertItem(&lvItem);
+	int const i = static_cast<int>(m_rows.GetRowCount());
+	m_rows.Append(di);
+	SetItemCountEx(i + 1, LVSICF_NOSCROLL);
+	return i;
 }
 
 /**
@@ -178,6 +88,29 @@ void CDirView::UpdateDiffItemStatus(UINT nIdx)
 	RedrawItems(nIdx, nIdx);
 }
 
+/**
+ * @brief Get text for specified column as shown in the list.
+ * Safe to call from any thread, so reports can format rows in parallel.
+ * @param [in] col Logical column number.
+ * @param [in] di Difference data.
+ * @return Text for the specified column.
+ */
+String CDirView::GetCellText(int col, const DIFFITEM *di) const
+{
+	String s = ColGetTextToDisplay(col, di);
+	// Add '*' to newer time field
+	switch (f_cols[col].idName)
+	{
+	case IDS_COLHDR_LTIMEM:
+		s.insert(0, di->left.mtime > di->right.mtime ? _T("* ") : _T("  "));
+		break;
+	case IDS_COLHDR_RTIMEM:
+		s.insert(0, di->left.mtime < di->right.mtime ? _T("* ") : _T("  "));
+		break;
+	}
+	return s;
+}
+
 /**
  * @brief Respond to LVN_GETDISPINFO message
  */
@@ -186,34 +119,73 @@ void CDirView::ReflectGetdispinfo(NMLVDISPINFO *pParam)
 	int const nIdx = pParam->item.iItem;
 	int const i = ColPhysToLog(pParam->item.iSubItem);
 	WORD const idName = f_cols[i].idName;
-	DIFFITEM const *const di = GetDiffItem(nIdx);
+	const DirListModel::Row &row = m_rows.GetRow(nIdx);
+	DIFFITEM const *const di = row.di;
+	if (pParam->item.mask & LVIF_INDENT)
+	{
+		pParam->item.iIndent = row.level;
+	}
 	if (di == NULL)
 	{
 		if (idName == IDS_COLHDR_FILENAME)
 		{
 			pParam->item.pszText = _T("..");
 		}
+		if ((pParam->item.mask & LVIF_IMAGE) && row.image != I_IMAGECALLBACK)
+		{
+			pParam->item.iImage = row.image;
+		}
 		return;
 	}
 	if (pParam->item.mask & LVIF_TEXT)
 	{
-		String s = ColGetTextToDisplay(i, di);
-		// Add '*' to newer time field
-		switch (idName)
-		{
-		case IDS_COLHDR_LTIMEM:
-			s.insert(0, di->left.mtime > di->right.mtime ? _T("* ") : _T("  "));
-			break;
-		case IDS_COLHDR_RTIMEM:
-			s.insert(0, di->left.mtime < di->right.mtime ? _T("* ") : _T("  "));
-			break;
-		}
-		pParam->item.pszText = H2O::AllocDispinfoText(s);
+		pParam->item.pszText = H2O::AllocDispinfoText(GetCellText(i, di));
 	}
 	if (pParam->item.mask & LVIF_IMAGE)
 	{
 		pParam->item.iImage = CompareStats::GetColImage(di);
 	}
+	if ((pParam->item.mask & LVIF_STATE) && (pParam->item.stateMask & LVIS_STATEIMAGEMASK))
+	{
+		pParam->item.state &= ~LVIS_STATEIMAGEMASK;
+		if (m_bTreeMode && di->HasChildren())
+		{
+			pParam->item.state |= INDEXTOSTATEIMAGEMASK(
+				(di->customFlags1 & ViewCustomFlags::EXPANDED) ? 2 : 1);
+		}
+	}
+}
+
+/**
+ * @brief Respond to LVN_ODFINDITEM message
+ * Finds the next item whose name starts with typed text.
+ */
+int CDirView::ReflectOdFindItem(NMLVFINDITEM *pParam)
+{
+	if (!(pParam->lvfi.flags & (LVFI_STRING | LVFI_PARTIAL)))
+		return -1;
+	int const count = static_cast<int>(m_rows.GetRowCount());
+	if (count == 0)
+		return -1;
+	size_t const len = _tcslen(pParam->lvfi.psz);
+	int i = pParam->iStart < count ? pParam->iStart : 0;
+	int const iStart = i;
+	do
+	{
+		if (const DIFFITEM *di = GetDiffItem(i))
+		{
+			String s = ColGetTextToDisplay(0, di);
+			if (_tcsnicmp(s.c_str(), pParam->lvfi.psz, len) == 0)
+				return i;
+		}
+		if (++i == count)
+		{
+			if (!(pParam->lvfi.flags & LVFI_WRAP))
+				break;
+			i = 0;
+		}
+	} while (i != iStart);
+	return -1;
 }
 
 /// store current column orders into registry
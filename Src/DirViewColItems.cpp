@@ -255,21 +255,36 @@ static String ColNewerGet(const CDiffContext *, const void *p)
 }
 
 /**
- * @brief Format Version info to string.
+ * @brief Get file information with properties read.
+ * Properties not yet read by the extraction threads are read here.
  * @param [in] pCtxt Pointer to compare context.
  * @param [in] pdi Pointer to DIFFITEM.
  * @param [in] bLeft Is the item left-size item?
- * @return String proper to show in the GUI.
+ * @return File information, or NULL if properties are not available yet.
  */
-static String GetVersion(const CDiffContext *pCtxt, const DIFFITEM *pdi, BOOL bLeft)
+static const DiffFileInfo *GetProperties(const CDiffContext *pCtxt, const DIFFITEM *pdi, BOOL bLeft)
 {
 	DIFFITEM *di = const_cast<DIFFITEM *>(pdi);
-	DiffFileInfo &dfi = bLeft ? di->left : di->right;
+	const DiffFileInfo &dfi = bLeft ? di->left : di->right;
 	if (dfi.versionChecked == DiffFileInfo::VersionInvalid)
 	{
-		pCtxt->UpdateVersion(di, bLeft);
+		pCtxt->UpdateProperties(di, bLeft != FALSE);
 	}
-	return dfi.versionChecked ? dfi.version.GetVersionString() : String();
+	return dfi.HasProperties() ? &dfi : NULL;
+}
+
+/**
+ * @brief Format Version info to string.
+ * @param [in] pCtxt Pointer to compare context.
+ * @param [in] pdi Pointer to DIFFITEM.
+ * @param [in] bLeft Is the item left-size item?
+ * @return String proper to show in the GUI.
+ */
+static String GetVersion(const CDiffContext *pCtxt, const DIFFITEM *pdi, BOOL bLeft)
+{
+	const DiffFileInfo *pdfi = GetProperties(pCtxt, pdi, bLeft);
+	return pdfi && pdfi->versionChecked == DiffFileInfo::VersionPresent ?
+		pdfi->version.GetVersionString() : String();
 }
 
 /**
@@ -358,13 +373,15 @@ static String ColAttrGet(const CDiffContext *, const void *p)
 
 /**
  * @brief Format File Encoding column data.
- * @param [in] p Pointer to file information.
+ * @param [in] pCtxt Pointer to compare context.
+ * @param [in] p Pointer to DIFFITEM.
  * @return String to show in the column.
  */
-static String ColEncodingGet(const CDiffContext *, const void *p)
+template<BOOL bLeft>
+static String ColEncodingGet(const CDiffContext *pCtxt, const void *p)
 {
-	const DiffFileInfo &r = *static_cast<const DiffFileInfo *>(p);
-	return r.encoding.GetName();
+	const DiffFileInfo *pdfi = GetProperties(pCtxt, static_cast<const DIFFITEM *>(p), bLeft);
+	return pdfi ? pdfi->encoding.GetName() : String();
 }
 
 /**
@@ -378,28 +395,23 @@ static String ColEOLTypeGet(const CDiffContext *, const void *p)
 	const DiffFileInfo &dfi = *static_cast<const DiffFileInfo *>(p);
 	const FileTextStats &stats = dfi.m_textStats;
 	int id = 0;
-	if (stats.nzeros > 0)
+	switch (stats.GetEolStyle())
 	{
+	case FileTextStats::EolBinary:
 		id = IDS_EOL_BIN;
-	}
-	else if (stats.ncrlfs > 0 && stats.ncrs == 0 && stats.nlfs == 0)
-	{
+		break;
+	case FileTextStats::EolDos:
 		id = IDS_EOL_DOS;
-	}
-	else if (stats.ncrlfs == 0 && stats.ncrs > 0 && stats.nlfs == 0)
-	{
+		break;
+	case FileTextStats::EolMac:
 		id = IDS_EOL_MAC;
-	}
-	else if (stats.ncrlfs == 0 && stats.ncrs == 0 && stats.nlfs > 0)
-	{
+		break;
+	case FileTextStats::EolUnix:
 		id = IDS_EOL_UNIX;
-	}
-	else if (stats.ncrlfs == 0 && stats.ncrs == 0 && stats.nlfs == 0)
-	{
+		break;
+	case FileTextStats::EolNone:
 		return String();
-	}
-	else
-	{
+	default:
 		String s = LanguageSelect.LoadString(IDS_EOL_MIXED);
 		TCHAR strstats[40];
 		_sntprintf(strstats, _countof(strstats), _T(":%u/%u/%u"), stats.ncrlfs, stats.ncrs, stats.nlfs);
@@ -534,15 +546,22 @@ static int ColNewerSort(const CDiffContext *pCtxt, const void *p, const void *q)
 
 /**
  * @brief Compare file versions.
- * @param [in] pCtxt Pointer to compare context.
+ * Items without a version sort first. Items whose properties have not been
+ * read yet count as having no version, so that sorting never reads files.
  * @param [in] p Pointer to DIFFITEM having first version to compare.
  * @param [in] q Pointer to DIFFITEM having second version to compare.
  * @return Compare result.
  */
 template<BOOL bLeft>
-static int ColVersionSort(const CDiffContext *pCtxt, const void *p, const void *q)
+static int ColVersionSort(const CDiffContext *, const void *p, const void *q)
 {
-	return ColVersionGet<bLeft>(pCtxt, p).compare(ColVersionGet<bLeft>(pCtxt, q));
+	const DiffFileInfo &r = bLeft ? static_cast<const DIFFITEM *>(p)->left : static_cast<const DIFFITEM *>(p)->right;
+	const DiffFileInfo &s = bLeft ? static_cast<const DIFFITEM *>(q)->left : static_cast<const DIFFITEM *>(q)->right;
+	bool const bPresentR = r.versionChecked == DiffFileInfo::VersionPresent;
+	bool const bPresentS = s.versionChecked == DiffFileInfo::VersionPresent;
+	if (bPresentR != bPresentS)
+		return bPresentR ? 1 : -1;
+	return bPresentR ? cmp(r.version.GetSortKey(), s.version.GetSortKey()) : 0;
 }
 
 /**
@@ -577,15 +596,32 @@ static int ColAttrSort(const CDiffContext *, const void *p, const void *q)
 
 /**
  * @brief Compare file encodings.
+ * Items whose properties have not been read yet sort first.
+ * @param [in] p Pointer to DIFFITEM having first encoding to compare.
+ * @param [in] q Pointer to DIFFITEM having second encoding to compare.
+ * @return Compare result.
+ */
+template<BOOL bLeft>
+static int ColEncodingSort(const CDiffContext *, const void *p, const void *q)
+{
+	const DiffFileInfo &r = bLeft ? static_cast<const DIFFITEM *>(p)->left : static_cast<const DIFFITEM *>(p)->right;
+	const DiffFileInfo &s = bLeft ? static_cast<const DIFFITEM *>(q)->left : static_cast<const DIFFITEM *>(q)->right;
+	return cmp(
+		r.HasProperties() ? r.encoding.GetSortKey() + 1 : 0,
+		s.HasProperties() ? s.encoding.GetSortKey() + 1 : 0);
+}
+
+/**
+ * @brief Compare EOL types.
  * @param [in] p Pointer to first structure to compare.
  * @param [in] q Pointer to second structure to compare.
  * @return Compare result.
  */
-static int ColEncodingSort(const CDiffContext *, const void *p, const void *q)
+static int ColEOLTypeSort(const CDiffContext *, const void *p, const void *q)
 {
 	const DiffFileInfo &r = *static_cast<const DiffFileInfo *>(p);
 	const DiffFileInfo &s = *static_cast<const DiffFileInfo *>(q);
-	return FileTextEncoding::Collate(r.encoding, s.encoding);
+	return r.m_textStats.GetEolStyle() - s.m_textStats.GetEolStyle();
 }
 /* @} */
 
@@ -625,14 +661,29 @@ const CDirView::DirColInfo CDirView::f_cols[] =
 	{ _T("Binary"), IDS_COLHDR_BINARY, IDS_COLDESC_BINARY, &ColBinGet, &ColBinSort, 0, -1, true, LVCFMT_LEFT },
 	{ _T("Lattr"), IDS_COLHDR_LATTRIBUTES, IDS_COLDESC_LATTRIBUTES, &ColAttrGet, &ColAttrSort, FIELD_OFFSET(DIFFITEM, left), -1, true, LVCFMT_LEFT },
 	{ _T("Rattr"), IDS_COLHDR_RATTRIBUTES, IDS_COLDESC_RATTRIBUTES, &ColAttrGet, &ColAttrSort, FIELD_OFFSET(DIFFITEM, right), -1, true, LVCFMT_LEFT },
-	{ _T("Lencoding"), IDS_COLHDR_LENCODING, IDS_COLDESC_LENCODING, &ColEncodingGet, &ColEncodingSort, FIELD_OFFSET(DIFFITEM, left), -1, true, LVCFMT_LEFT },
-	{ _T("Rencoding"), IDS_COLHDR_RENCODING, IDS_COLDESC_RENCODING, &ColEncodingGet, &ColEncodingSort, FIELD_OFFSET(DIFFITEM, right), -1, true, LVCFMT_LEFT },
+	{ _T("Lencoding"), IDS_COLHDR_LENCODING, IDS_COLDESC_LENCODING, &ColEncodingGet<TRUE>, &ColEncodingSort<TRUE>, 0, -1, true, LVCFMT_LEFT },
+	{ _T("Rencoding"), IDS_COLHDR_RENCODING, IDS_COLDESC_RENCODING, &ColEncodingGet<FALSE>, &ColEncodingSort<FALSE>, 0, -1, true, LVCFMT_LEFT },
 	{ _T("Snsdiffs"), IDS_COLHDR_NSDIFFS, IDS_COLDESC_NSDIFFS, ColDiffsGet, ColDiffsSort, FIELD_OFFSET(DIFFITEM, nsdiffs), -1, false, LVCFMT_RIGHT },
 	{ _T("Snidiffs"), IDS_COLHDR_NIDIFFS, IDS_COLDESC_NIDIFFS, ColDiffsGet, ColDiffsSort, FIELD_OFFSET(DIFFITEM, nidiffs), -1, false, LVCFMT_RIGHT },
-	{ _T("Leoltype"), IDS_COLHDR_LEOL_TYPE, IDS_COLDESC_LEOL_TYPE, &ColEOLTypeGet, 0, FIELD_OFFSET(DIFFITEM, left), -1, true, LVCFMT_LEFT },
-	{ _T("Reoltype"), IDS_COLHDR_REOL_TYPE, IDS_COLDESC_REOL_TYPE, &ColEOLTypeGet, 0, FIELD_OFFSET(DIFFITEM, right), -1, true, LVCFMT_LEFT },
+	{ _T("Leoltype"), IDS_COLHDR_LEOL_TYPE, IDS_COLDESC_LEOL_TYPE, &ColEOLTypeGet, &ColEOLTypeSort, FIELD_OFFSET(DIFFITEM, left), -1, true, LVCFMT_LEFT },
+	{ _T("Reoltype"), IDS_COLHDR_REOL_TYPE, IDS_COLDESC_REOL_TYPE, &ColEOLTypeGet, &ColEOLTypeSort, FIELD_OFFSET(DIFFITEM, right), -1, true, LVCFMT_LEFT },
 };
 
+/**
+ * @brief Whether given column shows properties read by
+ * CDiffContext::ExtractProperties().
+ * @param [in] col Column to check.
+ */
+bool CDirView::ColumnShowsProperties(int col)
+{
+	ColGetFncPtrType const getfnc = f_cols[col].getfnc;
+	return
+		getfnc == &ColVersionGet<TRUE> ||
+		getfnc == &ColVersionGet<FALSE> ||
+		getfnc == &ColEncodingGet<TRUE> ||
+		getfnc == &ColEncodingGet<FALSE>;
+}
+
 /**
  * @brief Count of all known columns
  */
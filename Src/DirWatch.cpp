@@ -0,0 +1,233 @@
+/**
+ *  @file DirWatch.cpp
+ *
+ *  @brief Implementation of class DirWatch
+ */
+#include "StdAfx.h"
+#include "DirWatch.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+/**
+ * @brief Changes which may alter what a folder compare shows.
+ */
+static const DWORD NotifyFilter =
+	FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+	FILE_NOTIFY_CHANGE_ATTRIBUTES | FILE_NOTIFY_CHANGE_SIZE |
+	FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+/**
+ * @brief Start watching given folders.
+ * @param [in] pWindow Window to receive MSG_FOLDERS_CHANGED.
+ * @param [in] pszLeft Left folder.
+ * @param [in] pszRight Right folder.
+ * @param [in] bSubtree Whether to watch subfolders, too.
+ */
+DirWatch::DirWatch(HWindow *pWindow, LPCTSTR pszLeft, LPCTSTR pszRight, bool bSubtree)
+	: m_pWindow(pWindow)
+	, m_bSubtree(bSubtree)
+	, m_hStop(CreateEvent(NULL, TRUE, FALSE, NULL))
+	, m_hThread(NULL)
+	, m_bOverflow(false)
+{
+	m_paths[0] = pszLeft;
+	m_paths[1] = pszRight;
+	InitializeCriticalSection(&m_cs);
+	m_hThread = BeginThreadEx(NULL, 0,
+		OException::ThreadProc<DirWatch, &DirWatch::WatchThread>,
+		this, 0, NULL);
+}
+
+/**
+ * @brief Stop watching.
+ */
+DirWatch::~DirWatch()
+{
+	SetEvent(m_hStop);
+	if (m_hThread)
+	{
+		WaitForSingleObject(m_hThread, INFINITE);
+		CloseHandle(m_hThread);
+	}
+	CloseHandle(m_hStop);
+	DeleteCriticalSection(&m_cs);
+}
+
+/**
+ * @brief Tell if given folders are the ones being watched.
+ */
+bool DirWatch::IsWatching(const String &left, const String &right, bool bSubtree) const
+{
+	return m_paths[0] == left && m_paths[1] == right && m_bSubtree == bSubtree;
+}
+
+/**
+ * @brief Take the folders which have changed since last call.
+ * Called on main thread in response to MSG_FOLDERS_CHANGED.
+ * @param [out] folders Receives changed folders, sorted so that each folder
+ * comes before its subfolders. Empty string stands for the root folders.
+ * @return false if notifications got lost, so changes are not known.
+ */
+bool DirWatch::GetChanges(std::vector<String> &folders)
+{
+	folders.clear();
+	EnterCriticalSection(&m_cs);
+	folders.swap(m_rgFolders);
+	bool const bOverflow = m_bOverflow;
+	m_bOverflow = false;
+	LeaveCriticalSection(&m_cs);
+	return !bOverflow;
+}
+
+/**
+ * @brief Tell the window about changes it has not yet taken.
+ * @return Whether there are such changes.
+ */
+bool DirWatch::Post()
+{
+	EnterCriticalSection(&m_cs);
+	bool const bChanged = m_bOverflow || !m_rgFolders.empty();
+	if (bChanged)
+		m_pWindow->PostMessage(MSG_FOLDERS_CHANGED);
+	LeaveCriticalSection(&m_cs);
+	return bChanged;
+}
+
+/**
+ * @brief Add a folder to the sorted list of changed folders.
+ * Caller must hold m_cs.
+ */
+void DirWatch::AddFolder(const String &folder)
+{
+	std::vector<String>::iterator const it =
+		std::lower_bound(m_rgFolders.begin(), m_rgFolders.end(), folder);
+	if (it == m_rgFolders.end() || *it != folder)
+		m_rgFolders.insert(it, folder);
+}
+
+/**
+ * @brief Collect changed folders from a completed read.
+ * An entry which has been added, removed, renamed or modified changes what
+ * its containing folder lists, so it is that folder which is recorded.
+ */
+void DirWatch::Collect(const Side &side)
+{
+	const BYTE *p = reinterpret_cast<const BYTE *>(side.buffer);
+	EnterCriticalSection(&m_cs);
+	for (;;)
+	{
+		const FILE_NOTIFY_INFORMATION *const pfni =
+			reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(p);
+		LPCWSTR const name = pfni->FileName;
+		DWORD len = pfni->FileNameLength / sizeof *name;
+		while (len != 0 && name[len - 1] != L'\\')
+			--len;
+		AddFolder(String(name, len != 0 ? len - 1 : 0));
+		if (pfni->NextEntryOffset == 0)
+			break;
+		p += pfni->NextEntryOffset;
+	}
+	LeaveCriticalSection(&m_cs);
+}
+
+/**
+ * @brief Issue an asynchronous read of changes for one side.
+ */
+bool DirWatch::Read(Side &side) const
+{
+	ResetEvent(side.ov.hEvent);
+	return ReadDirectoryChangesW(side.hDir, side.buffer, sizeof side.buffer,
+		m_bSubtree, NotifyFilter, NULL, &side.ov, NULL) != FALSE;
+}
+
+/**
+ * @brief Watch thread function.
+ * The thread waits for reads on both sides to complete, and tells the
+ * window about changes only once no more have arrived for SettleTime, so
+ * that a burst of changes like from a build or a checkout ends up in a
+ * single refresh. While the window is busy with other things, and leaves
+ * the changes where they are, the thread tells it again after RetryTime.
+ */
+DWORD DirWatch::WatchThread()
+{
+	HANDLE handles[3];
+	Side *sides[3];
+	DWORD n = 0;
+	handles[n] = m_hStop;
+	sides[n++] = NULL;
+	for (int i = 0; i < 2; ++i)
+	{
+		Side &side = m_sides[i];
+		ZeroMemory(&side.ov, sizeof side.ov);
+		side.hDir = CreateFile(m_paths[i].c_str(), FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+			OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+		if (side.hDir == INVALID_HANDLE_VALUE)
+			continue;
+		side.ov.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (side.ov.hEvent && Read(side))
+		{
+			handles[n] = side.ov.hEvent;
+			sides[n++] = &side;
+		}
+	}
+	bool bPending = false;
+	bool bPosted = false;
+	for (;;)
+	{
+		DWORD const dw = WaitForMultipleObjects(n, handles, FALSE,
+			bPending ? SettleTime : bPosted ? RetryTime : INFINITE);
+		if (dw == WAIT_TIMEOUT)
+		{
+			bPosted = Post();
+			bPending = false;
+			continue;
+		}
+		DWORD const i = dw - WAIT_OBJECT_0;
+		if (i >= n || sides[i] == NULL)
+			break;
+		Side &side = *sides[i];
+		DWORD cb = 0;
+		// No bytes means the buffer overflowed, and a failure that the
+		// folder has gone away
+		if (GetOverlappedResult(side.hDir, &side.ov, &cb, FALSE) && cb != 0)
+		{
+			Collect(side);
+		}
+		else
+		{
+			EnterCriticalSection(&m_cs);
+			m_bOverflow = true;
+			LeaveCriticalSection(&m_cs);
+		}
+		bPending = true;
+		if (!Read(side))
+		{
+			EnterCriticalSection(&m_cs);
+			m_bOverflow = true;
+			LeaveCriticalSection(&m_cs);
+			--n;
+			handles[i] = handles[n];
+			sides[i] = sides[n];
+		}
+	}
+	// Let pending reads complete before their buffers go away
+	while (n > 1)
+	{
+		Side &side = *sides[--n];
+		CancelIo(side.hDir);
+		DWORD cb = 0;
+		GetOverlappedResult(side.hDir, &side.ov, &cb, TRUE);
+	}
+	for (int i = 0; i < 2; ++i)
+	{
+		Side &side = m_sides[i];
+		if (side.ov.hEvent)
+			CloseHandle(side.ov.hEvent);
+		if (side.hDir != INVALID_HANDLE_VALUE)
+			CloseHandle(side.hDir);
+	}
+	return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ *  @file DirWatch.h
+ *
+ *  @brief Declaration of class DirWatch
+ */
+#pragma once
+
+/**
+ * @brief Watches the two folders of a folder compare for changes.
+ * A background thread reads change notifications through
+ * ReadDirectoryChangesW(), and collects the folders whose entries have been
+ * added, removed, renamed or modified. Once changes have settled, the window
+ * gets MSG_FOLDERS_CHANGED, and can then refresh just these folders. The
+ * message comes again every RetryTime until the window takes the changes.
+ * Folders are relative to the compare roots, and are the same for both
+ * sides. When the system drops notifications, GetChanges() tells so, and
+ * only a full rescan will do.
+ */
+class DirWatch
+{
+public:
+	DirWatch(HWindow *, LPCTSTR pszLeft, LPCTSTR pszRight, bool bSubtree);
+	~DirWatch();
+	bool IsWatching(const String &left, const String &right, bool bSubtree) const;
+	bool GetChanges(std::vector<String> &folders);
+
+private:
+	/** @brief Milliseconds without notifications before the window is told. */
+	static const DWORD SettleTime = 250;
+	/** @brief Milliseconds after which to tell the window again. */
+	static const DWORD RetryTime = 1000;
+	/** @brief Size of a notification buffer, the maximum for network shares. */
+	static const DWORD BufferSize = 64 * 1024;
+	struct Side
+	{
+		HANDLE hDir;
+		OVERLAPPED ov;
+		DWORD buffer[BufferSize / sizeof(DWORD)]; /**< DWORD aligned, as needed */
+	};
+	DWORD WatchThread();
+	bool Read(Side &) const;
+	void Collect(const Side &);
+	void AddFolder(const String &);
+	bool Post();
+	HWindow *const m_pWindow;
+	String m_paths[2];
+	bool const m_bSubtree;
+	HANDLE const m_hStop; /**< Tells the thread to finish */
+	HANDLE m_hThread;
+	Side m_sides[2];
+	CRITICAL_SECTION m_cs; /**< Guards the members below */
+	std::vector<String> m_rgFolders; /**< Changed folders, sorted */
+	bool m_bOverflow; /**< Notifications got lost */
+
+	DirWatch(const DirWatch &); // disallow copy construction
+	void operator=(const DirWatch &); // disallow assignment
+};
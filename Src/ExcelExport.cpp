@@ -30,6 +30,7 @@ SOFTWARE.
 #include "stdafx.h"
 #include "DiffItem.h"
 #include "OptionsMgr.h"
+#include "DirView.h"
 #include "ExcelExport.h"
 
 #undef EOF
@@ -114,6 +115,7 @@ CExcelExport::CExcelExport()
 	, crBorderColor(RGB(192,192,192))
 	, sSheetName("Sheet1")
 	, nShowViewer(0)
+	, pView(NULL)
 {
 }
 
@@ -229,11 +231,14 @@ void CExcelExport::ApplyProfile(LPCTSTR app, LPCTSTR ini, bool fWriteDefaults)
 	}
 }
 
-void CExcelExport::WriteWorkbook(HListView *pLv, int flags)
+void CExcelExport::WriteWorkbook(CDirView *pLv, int flags)
 {
 	HHeaderCtrl *const pHd = pLv->GetHeaderCtrl();
 	int const nCols = pHd->GetItemCount();
-	std::vector<WORD> rgFormatIndex;
+	pView = pLv;
+	pLv->GetReportItems(rgItems, flags == LVNI_SELECTED);
+	rgColumns.resize(nCols);
+	rgFormatIndex.clear();
 	rgFormatIndex.resize(nCols);
 	int cxChar = pLv->GetStringWidth(_T("0"));
 	TCHAR szText[INFOTIPSIZE];
@@ -339,6 +344,7 @@ void CExcelExport::WriteWorkbook(HListView *pLv, int flags)
 		LVCOLUMN lvc;
 		lvc.mask = LVCF_FMT;
 		pLv->GetColumn(item.iSubItem, &lvc);
+		rgColumns[item.iSubItem] = pLv->ColPhysToLog(item.iSubItem);
 		if ((lvc.fmt & LVCFMT_JUSTIFYMASK) == LVCFMT_RIGHT)
 		{
 			rgFormatIndex[item.iSubItem] = 19;
@@ -698,57 +704,80 @@ void CExcelExport::WriteWorkbook(HListView *pLv, int flags)
 			.WriteTo(pstm);
 	}
 
-	item.iItem = -1;
-	while ((item.iItem = pLv->GetNextItem(item.iItem, flags)) != -1)
+	// Rows come from the compare results, so cells need not be read from UI
+	FormatRows(rgItems.size());
+	rgItems.clear();
+
+	BiffRecord(BiffRecord::EOF).WriteTo(pstm);
+}
+
+/**
+ * Runs on worker threads. Appends the row's cells as zero-terminated strings.
+ */
+void CExcelExport::FormatRow(stl_size_t iRow, String &text)
+{
+	const DIFFITEM *di = rgItems[iRow];
+	std::vector<int>::const_iterator it = rgColumns.begin();
+	while (it != rgColumns.end())
+	{
+		String cell = pView->GetCellText(*it++, di);
+		// Keep LABEL records within BiffRecord::data
+		if (cell.length() > 1000)
+			cell.resize(1000);
+		text += cell;
+		text += _T('\0');
+	}
+}
+
+/**
+ * Runs on the caller's thread. Writes LABEL records for a block of rows.
+ */
+void CExcelExport::WriteRows(stl_size_t iRow, stl_size_t nRows, String &text)
+{
+	LPCTSTR pch = text.c_str();
+	WORD const nCols = static_cast<WORD>(rgColumns.size());
+	while (nRows != 0)
 	{
+		const DIFFITEM *di = rgItems[iRow];
 		++iRow;
-		item.mask = LVIF_TEXT | LVIF_PARAM;
-		for (item.iSubItem = 0 ; item.iSubItem < nCols ; ++item.iSubItem)
+		--nRows;
+		WORD wRowFormatIndex = 0;
+		if (!COptionsMgr::Get(OPT_CLR_DEFAULT_LIST_COLORING))
 		{
-			item.pszText = szText;
-			item.cchTextMax = _countof(szText);
-			if (pLv->GetItem(&item))
+			switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
 			{
-				WORD wFormatIndex = 0;
-				if (!COptionsMgr::Get(OPT_CLR_DEFAULT_LIST_COLORING))
-				{
-					if (DIFFITEM *di = reinterpret_cast<DIFFITEM *>(item.lParam))
-					{
-						switch (di->diffcode & (DIFFCODE::SIDEFLAGS | DIFFCODE::COMPAREFLAGS))
-						{
-						case DIFFCODE::BOTH | DIFFCODE::NOCMP:
-						case DIFFCODE::BOTH | DIFFCODE::SAME:
-							// either identical or irrelevant
-							break;
-						case DIFFCODE::LEFT:
-							// left-only
-							wFormatIndex = 20;
-							break;
-						case DIFFCODE::RIGHT:
-							// right-only
-							wFormatIndex = 22;
-							break;
-						default:
-							// otherwise suspicious
-							wFormatIndex = 24;
-							break;
-						}
-					}
-				}
-				if (WORD wDefFormatIndex = rgFormatIndex[item.iSubItem])
-				{
-					wFormatIndex = wFormatIndex ? wFormatIndex + 1 : wDefFormatIndex;
-				}
-				BiffRecord(BiffRecord::LABEL)
-					.Append<WORD>(iRow)
-					.Append<WORD>(item.iSubItem)
-					.Append<WORD>(wFormatIndex)
-					.AppendString<WORD>(item.pszText)
-					.WriteTo(pstm);
+			case DIFFCODE::BOTH | DIFFCODE::NOCMP:
+			case DIFFCODE::BOTH | DIFFCODE::SAME:
+				// either identical or irrelevant
+				break;
+			case DIFFCODE::LEFT:
+				// left-only
+				wRowFormatIndex = 20;
+				break;
+			case DIFFCODE::RIGHT:
+				// right-only
+				wRowFormatIndex = 22;
+				break;
+			default:
+				// otherwise suspicious
+				wRowFormatIndex = 24;
+				break;
+			}
+		}
+		for (WORD iCol = 0 ; iCol < nCols ; ++iCol)
+		{
+			WORD wFormatIndex = wRowFormatIndex;
+			if (WORD wDefFormatIndex = rgFormatIndex[iCol])
+			{
+				wFormatIndex = wFormatIndex ? wFormatIndex + 1 : wDefFormatIndex;
 			}
-			item.mask = LVIF_TEXT;
+			BiffRecord(BiffRecord::LABEL)
+				.Append<WORD>(static_cast<WORD>(iRow)) // row 0 holds the headers
+				.Append<WORD>(iCol)
+				.Append<WORD>(wFormatIndex)
+				.AppendString<WORD>(pch)
+				.WriteTo(pstm);
+			pch += _tcslen(pch) + 1;
 		}
 	}
-
-	BiffRecord(BiffRecord::EOF).WriteTo(pstm);
 }
@@ -1,4 +1,8 @@
-class CExcelExport
+#include "ReportRowFormatter.h"
+
+class CDirView;
+
+class CExcelExport : private ReportRowFormatter
 {
 public:
 	struct BorderStyle
@@ -27,7 +31,7 @@ public:
 	bool Open(LPCWSTR);
 	void Close(LPCTSTR lpVerb = NULL);
 	void ApplyProfile(LPCTSTR app, LPCTSTR ini, bool fWriteDefaults = false);
-	void WriteWorkbook(HListView *, int flags);
+	void WriteWorkbook(CDirView *, int flags);
 	BOOL fPrintGrid : 1;
 	BorderStyle::WORD_BorderStyle wBorderStyle : 16;
 	COLORREF crBorderColor;
@@ -38,7 +42,13 @@ public:
 	std::string sSheetName;
 private:
 	struct BiffRecord;
+	virtual void FormatRow(stl_size_t, String &);
+	virtual void WriteRows(stl_size_t, stl_size_t, String &);
 	HRESULT hr;
 	IStorage *pstg;
 	IStream *pstm;
+	CDirView *pView;
+	std::vector<DIFFITEM *> rgItems;
+	std::vector<int> rgColumns;
+	std::vector<WORD> rgFormatIndex;
 };
@@ -136,7 +136,67 @@ FileActionItem FileActionScript::RemoveTailActionItem()
 	return item;
 }
 
-bool FileActionScript::Run(HListView *pLv, DWORD flags)
+/**
+ * @brief Passes on the items whose operations ShellFileOperations reports.
+ * An item may add more than one source to an operation, and is passed on
+ * once all of them have been done.
+ */
+class FileActionScript::Tracker : public ShellFileOperations::Sink
+{
+public:
+	/** @brief Marks items which have been passed on. */
+	static const int Done = -1;
+
+	Tracker(FileActionScript &script, vector<int> &pending, FileActionScript::Sink *pSink)
+		: m_script(script), m_pending(pending), m_pSink(pSink)
+	{
+	}
+	/**
+	 * @brief Add a source of an item to an operation.
+	 * @param [in] op Operation to add the source to.
+	 * @param [in] nAction Index of the item.
+	 * @param [in] source Source to add.
+	 */
+	void AddSource(ShellFileOperations &op, int nAction, LPCTSTR source)
+	{
+		op.AddSource(source);
+		if (m_pSink)
+		{
+			op.SetSink(this);
+			m_sources.push_back(nAction);
+			++m_pending[nAction];
+		}
+	}
+	virtual void ItemDone(int nItem)
+	{
+		int const nAction = m_sources[nItem];
+		if (--m_pending[nAction] == 0)
+		{
+			m_pending[nAction] = Done;
+			m_pSink->ActionItemDone(m_script.m_actions[nAction]);
+		}
+	}
+	virtual void BatchDone()
+	{
+		m_pSink->ActionItemsDone();
+	}
+private:
+	FileActionScript &m_script;
+	vector<int> &m_pending; /**< Sources not yet done per item */
+	FileActionScript::Sink *const m_pSink;
+	vector<int> m_sources; /**< Item per source of the operation */
+};
+
+/**
+ * @brief Run the script.
+ * @param [in] pLv List view which the items belong to.
+ * @param [in] flags Flags for the file operations.
+ * @param [in] pSink Sink to pass items on to as they are done, or NULL.
+ * @return true if all items have been done, false otherwise.
+ * @note Items which have been passed on to the sink are removed from the
+ * script, so that the remaining ones can be updated after the fact.
+ */
+bool FileActionScript::Run(HListView *pLv, DWORD flags, Sink *pSink)
 {
 	if (!COptionsMgr::Get(OPT_USE_SHELL_FILE_OPERATIONS))
 	{
@@ -186,9 +246,15 @@ bool FileActionScript::Run(HListView *pLv, DWORD flags)
 		MoveOperations.AddDestination(destination);
 	}
 
+	vector<int> pending(m_actions.size(), 0);
+	Tracker CopyTracker(*this, pending, pSink);
+	Tracker MoveTracker(*this, pending, pSink);
+	Tracker DelTracker(*this, pending, pSink);
+
 	int choice = IDYES;
 	for (iter = m_actions.begin() ; iter != m_actions.end() ; ++iter)
 	{
+		int const nAction = static_cast<int>(iter - m_actions.begin());
 		if (iter->atype == FileAction::ACT_COPY)
 		{
 			if (iter->dirflag)
@@ -223,29 +289,93 @@ bool FileActionScript::Run(HListView *pLv, DWORD flags)
 					break;
 				}
 			}
-			CopyOperations.AddSource(iter->src.c_str());
+			CopyTracker.AddSource(CopyOperations, nAction, iter->src.c_str());
 			if (!m_bIgnoreFolderStructure)
 				CopyOperations.AddDestination(iter->dest.c_str());
 		}
 		else if (iter->atype == FileAction::ACT_MOVE)
 		{
-			MoveOperations.AddSource(iter->src.c_str());
+			MoveTracker.AddSource(MoveOperations, nAction, iter->src.c_str());
 			if (!m_bIgnoreFolderStructure)
 				MoveOperations.AddDestination(iter->dest.c_str());
 		}
 		else if (iter->atype == FileAction::ACT_DEL)
 		{
-			DelOperations.AddSource(iter->src.c_str());
+			DelTracker.AddSource(DelOperations, nAction, iter->src.c_str());
 			if (!iter->dest.empty())
-				DelOperations.AddSource(iter->dest.c_str());
+				DelTracker.AddSource(DelOperations, nAction, iter->dest.c_str());
 		}
 	}
 
-	return
+	bool const bSuccess =
 	(
 		iter == m_actions.end() // if above loop did not terminate prematurely
 	&&	CopyOperations.Run()
 	&&	MoveOperations.Run()
 	&&	DelOperations.Run()
 	);
+
+	// Remove the items which have been passed on to the sink
+	stl_size_t j = 0;
+	for (stl_size_t i = 0; i < m_actions.size(); ++i)
+	{
+		if (pending[i] == Tracker::Done)
+			continue;
+		if (j != i)
+			m_actions[j] = m_actions[i];
+		++j;
+	}
+	m_actions.erase(m_actions.begin() + j, m_actions.end());
+	return bSuccess;
+}
+
+TESTCASE
+{
+	// Sink which records the items passed on to it
+	class Recorder : public FileActionScript::Sink
+	{
+	public:
+		vector<int> contexts;
+		int batches;
+		Recorder() : batches(0) { }
+		virtual void ActionItemDone(const FileActionItem &act)
+		{
+			contexts.push_back(act.context);
+		}
+		virtual void ActionItemsDone()
+		{
+			++batches;
+		}
+	} recorder;
+	FileActionScript script;
+	for (int i = 0; i < 4; ++i)
+	{
+		FileActionItem act;
+		act.context = 10 + i;
+		script.AddActionItem(act);
+	}
+	vector<int> pending(script.GetActionItemCount(), 0);
+	FileActionScript::Tracker tracker(script, pending, &recorder);
+	ShellFileOperations op(NULL, FO_DELETE,
+		ShellFileOperations::UseLowLevelFunctions, 16, 0);
+	// item 1 deletes both of its sides, item 2 has nothing to do
+	tracker.AddSource(op, 0, _T("a"));
+	tracker.AddSource(op, 1, _T("b"));
+	tracker.AddSource(op, 1, _T("c"));
+	tracker.AddSource(op, 3, _T("d"));
+	assert(pending[0] == 1 && pending[1] == 2 && pending[2] == 0 && pending[3] == 1);
+	// items are passed on once all of their sources are done
+	tracker.ItemDone(2);
+	assert(recorder.contexts.empty() && pending[1] == 1);
+	tracker.ItemDone(3);
+	tracker.ItemDone(1);
+	tracker.BatchDone();
+	assert(recorder.contexts.size() == 2 && recorder.batches == 1);
+	assert(recorder.contexts[0] == 13 && recorder.contexts[1] == 11);
+	assert(pending[0] == 1 && pending[2] == 0);
+	assert(pending[1] == FileActionScript::Tracker::Done && pending[3] == FileActionScript::Tracker::Done);
+	tracker.ItemDone(0);
+	tracker.BatchDone();
+	assert(recorder.contexts.size() == 3 && recorder.contexts[2] == 10 && recorder.batches == 2);
+	return 0;
 }
@@ -98,6 +98,19 @@ struct FileActionItem : public FileAction
 class FileActionScript
 {
 public:
+	class Tracker;
+	friend Tracker;
+	/**
+	 * @brief Learns which items have been done while the script runs.
+	 * Items come in batches, and are removed from the script as they come.
+	 */
+	class Sink
+	{
+	public:
+		virtual void ActionItemDone(const FileActionItem &) = 0;
+		virtual void ActionItemsDone() = 0;
+	};
+
 	FileActionScript(LPCTSTR destBase = NULL);
 	~FileActionScript();
 
@@ -114,7 +127,7 @@ public:
 		int origin, int destination,
 		LPCTSTR src, LPCTSTR dest);
 
-	bool Run(HListView *, DWORD flags);
+	bool Run(HListView *, DWORD flags, Sink * = NULL);
 
 	// Manipulate the FileActionList
 	int GetActionItemCount() const { return m_actions.size(); }
@@ -32,6 +32,14 @@ void FileTextEncoding::Clear()
 	m_sqlite = false;
 }
 
+/**
+ * @brief Whether an encoding has been found, as opposed to being cleared
+ */
+bool FileTextEncoding::IsKnown() const
+{
+	return m_codepage != -1 || m_unicoding != NONE;
+}
+
 /**
  * @brief Set codepage
  */
@@ -80,21 +88,23 @@ String FileTextEncoding::GetName() const
 	return str;
 }
 
+/**
+ * @brief Pack unicoding, BOM, and codepage into a single sort key.
+ * Unknown codepage (-1) sorts before all others.
+ */
+UINT64 FileTextEncoding::GetSortKey() const
+{
+	return
+		static_cast<UINT64>(m_unicoding) << 40 |
+		static_cast<UINT64>(m_bom) << 32 |
+		static_cast<UINT>(m_codepage + 1);
+}
+
 int FileTextEncoding::Collate(FileTextEncoding const &fte1, FileTextEncoding const &fte2)
 {
-	if (fte1.m_unicoding > fte2.m_unicoding)
-		return 1;
-	if (fte1.m_unicoding < fte2.m_unicoding)
-		return -1;
-	if (fte1.m_bom > fte2.m_bom)
-		return 1;
-	if (fte1.m_bom < fte2.m_bom)
-		return -1;
-	if (fte1.m_codepage > fte2.m_codepage)
-		return 1;
-	if (fte1.m_codepage < fte2.m_codepage)
-		return -1;
-	return 0;
+	UINT64 const key1 = fte1.GetSortKey();
+	UINT64 const key2 = fte2.GetSortKey();
+	return key1 > key2 ? 1 : key1 < key2 ? -1 : 0;
 }
 
 /**
@@ -22,10 +22,12 @@ public:
 
 	FileTextEncoding();
 	void Clear();
+	bool IsKnown() const;
 	void SetCodepage(int codepage);
 	void SetUnicoding(UNICODESET unicoding);
 	String GetName() const;
 
+	UINT64 GetSortKey() const;
 	static int Collate(FileTextEncoding const &, FileTextEncoding const &);
 
 	static void UpdateDefaultCodepage(int cpDefaultMode, int customCodepage);
@@ -18,6 +18,28 @@ struct FileTextStats
 	unsigned int ncrlfs; /**< Count of DOS (CR+LF-bytes) EOLs. */
 	unsigned int nzeros; /**< Count of zero-bytes. */
 	unsigned int nlosses;
+	/** @brief Styles of line endings, in sort order. */
+	enum EolStyle
+	{
+		EolNone,
+		EolDos,
+		EolMac,
+		EolUnix,
+		EolMixed,
+		EolBinary
+	};
 	FileTextStats() { clear(); }
 	void clear() { ncrs = nlfs = ncrlfs = nzeros = nlosses = 0; }
+	EolStyle GetEolStyle() const
+	{
+		if (nzeros > 0)
+			return EolBinary;
+		if (ncrs == 0 && nlfs == 0)
+			return ncrlfs > 0 ? EolDos : EolNone;
+		if (ncrlfs == 0 && nlfs == 0)
+			return EolMac;
+		if (ncrlfs == 0 && ncrs == 0)
+			return EolUnix;
+		return EolMixed;
+	}
 };
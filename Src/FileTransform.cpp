@@ -5,14 +5,125 @@
 #include "FileTransform.h"
 #include "UniMarkdownFile.h"
 #include "codepage_detect.h"
+#include "Environment.h"
+
+/**
+ * @brief Return a string which changes whenever the given file changes.
+ * @return Size and time of last write, or empty string if file is missing.
+ */
+static String GetFileStamp(LPCTSTR path)
+{
+	String stamp;
+	WIN32_FILE_ATTRIBUTE_DATA fad;
+	if (GetFileAttributesEx(path, GetFileExInfoStandard, &fad))
+	{
+		stamp.append_sprintf(_T("%08lX%08lX-%08lX%08lX"),
+			fad.nFileSizeHigh, fad.nFileSizeLow,
+			fad.ftLastWriteTime.dwHighDateTime, fad.ftLastWriteTime.dwLowDateTime);
+	}
+	return stamp;
+}
+
+/**
+ * @brief Unpacked plugin output, keyed by input file identity and plugin
+ * version. The output lives in files inside the temporary folder, which
+ * goes away when WinMerge exits.
+ */
+static class PluginResultCache
+{
+public:
+	PluginResultCache() { InitializeCriticalSection(&m_cs); }
+	~PluginResultCache() { DeleteCriticalSection(&m_cs); }
+	bool Lookup(const String &key, String &path);
+	void Store(const String &key, const String &path);
+private:
+	/** @brief Number of results to keep around. */
+	static const stl_size_t MAX_ENTRIES = 32;
+	struct Entry
+	{
+		String key;
+		String path;
+	};
+	std::vector<Entry> m_entries; /**< Entries in order of last use */
+	CRITICAL_SECTION m_cs;
+} PluginResultCache;
+
+/**
+ * @brief Look up the output file for given key.
+ * @param [in] key Key built from input file identity and plugin version.
+ * @param [out] path Path of output file.
+ * @return Whether the output file is present.
+ */
+bool PluginResultCache::Lookup(const String &key, String &path)
+{
+	bool found = false;
+	EnterCriticalSection(&m_cs);
+	std::vector<Entry>::iterator it = m_entries.begin();
+	while (it != m_entries.end())
+	{
+		if (it->key == key)
+		{
+			Entry entry = *it;
+			m_entries.erase(it);
+			if (PathFileExists(entry.path.c_str()))
+			{
+				path = entry.path;
+				m_entries.push_back(entry);
+				found = true;
+			}
+			break;
+		}
+		++it;
+	}
+	LeaveCriticalSection(&m_cs);
+	return found;
+}
+
+/**
+ * @brief Remember the output file for given key.
+ * Evicts the least recently used entry when the cache is full.
+ * @param [in] key Key built from input file identity and plugin version.
+ * @param [in] path Path of output file, whose ownership passes to the cache.
+ */
+void PluginResultCache::Store(const String &key, const String &path)
+{
+	EnterCriticalSection(&m_cs);
+	std::vector<Entry>::iterator it = m_entries.begin();
+	while (it != m_entries.end())
+	{
+		if (it->key == key || m_entries.size() >= MAX_ENTRIES && it == m_entries.begin())
+		{
+			DeleteFile(it->path.c_str());
+			it = m_entries.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	Entry entry;
+	entry.key = key;
+	entry.path = path;
+	m_entries.push_back(entry);
+	LeaveCriticalSection(&m_cs);
+}
 
 /**
  * @brief Plugin file reader class.
+ *
+ * Streams which offer a Read(Characters) method, like Scripting.TextStream
+ * does, are read in blocks, and the lines are split apart on this side. Other
+ * streams are read line by line through AtEndOfStream and ReadLine.
  */
 class UniPluginFile : public UniLocalFile
 {
 public:
 	UniPluginFile(PackingInfo *packingInfo)
+		: m_nBufferPos(0)
+		, m_bEndOfStream(false)
+		, m_bBlockMode(false)
+		, m_pCachedFile(NULL)
+		, m_pCacheWriter(NULL)
 	{
 		LPCTSTR moniker = packingInfo->pluginMoniker.c_str();
 		OException::Check(
@@ -96,45 +207,72 @@ public:
 			m_OpenTextFile.Init(m_spFactoryDispatch, L"OpenTextFile"));
 		if (SUCCEEDED(m_CreateTextFile.Init(m_spFactoryDispatch, L"CreateTextFile")))
 			packingInfo->canWrite = true;
+		// Output can be cached unless it depends on options
+		if (packingInfo->pluginOptions == NULL)
+		{
+			if (SUCCEEDED(DispId.Init(m_spFactoryDispatch, L"Version")))
+			{
+				CMyVariant var;
+				OException::Check(DispId.Call(m_spFactoryDispatch,
+					CMyDispParams<0>().Unnamed, DISPATCH_PROPERTYGET, &var));
+				OException::Check(var.ChangeType(VT_BSTR));
+				m_sVersion = V_BSTR(&var);
+			}
+			else
+			{
+				// Version the plugin by its script file
+				String::size_type i = packingInfo->pluginMoniker.find(_T(':'), 2) + 1;
+				String path = packingInfo->pluginMoniker.substr(i);
+				String::size_type const j = path.find(_T('?'));
+				if (j != String::npos)
+					path.resize(j);
+				m_sVersion = GetFileStamp(path.c_str());
+			}
+			if (!m_sVersion.empty())
+				m_sVersion.insert(0, packingInfo->pluginMoniker + _T("|"));
+		}
+	}
+	virtual ~UniPluginFile()
+	{
+		UniPluginFile::Close();
 	}
 	virtual bool ReadString(String &line, String &eol, bool *lossy)
 	{
-		CMyVariant var;
-		OException::Check(m_AtEndOfStream.Call(m_spStreamDispatch,
-			CMyDispParams<0>().Unnamed, DISPATCH_PROPERTYGET, &var));
-		OException::Check(var.ChangeType(VT_BOOL));
-		if (V_BOOL(&var) != VARIANT_FALSE)
-		{
-			line.clear();
-			eol.clear();
-			return false;
-		}
-		OException::Check(m_ReadLine.Call(m_spStreamDispatch,
-			CMyDispParams<0>().Unnamed, DISPATCH_METHOD, &var));
-		OException::Check(var.ChangeType(VT_BSTR));
-		// Convert BSTR to String
-		if (m_unicoding == NEITHER)
+		if (m_pCachedFile)
 		{
-			V_BSTR(&var) = reinterpret_cast<HString *>(V_BSTR(&var))->Oct()->B;
-			UINT const len = SysStringByteLen(V_BSTR(&var));
-			ucr::maketstring(line, reinterpret_cast<char *>(V_BSTR(&var)), len, m_codepage, lossy);
-		}
-		else
-		{
-			line.assign(V_BSTR(&var), SysStringLen(V_BSTR(&var)));
-		}
-		// Don't let EOL chars exist in the midst of lines and cause crashes
-		String::iterator p = line.begin();
-		String::iterator const q = line.end();
-		if ((p = std::remove_if(p, q, LineInfo::IsEol)) != q)
-		{
-			line.erase(p, q);
-			*lossy = true;
+			bool const ok = m_pCachedFile->ReadString(line, eol, lossy);
+			m_txtstats = m_pCachedFile->GetTxtStats();
+			return ok;
 		}
+		bool const ok = m_bBlockMode ?
+			ReadBlockString(line, eol, lossy) : ReadLineString(line, eol, lossy);
 		if (*lossy)
 			++m_txtstats.nlosses;
-		eol = _T("\r\n");
-		return true;
+		if (eol.length() == 2)
+			++m_txtstats.ncrlfs;
+		else if (eol.length() == 1)
+			++(eol[0] == _T('\r') ? m_txtstats.ncrs : m_txtstats.nlfs);
+		if (m_pCacheWriter)
+		{
+			if (*lossy)
+			{
+				// Replaying the output would not reproduce the losses
+				DiscardCache();
+			}
+			else if (ok)
+			{
+				m_pCacheWriter->WriteString(line.c_str(), line.length());
+				m_pCacheWriter->WriteString(eol.c_str(), eol.length());
+			}
+			else
+			{
+				m_pCacheWriter->Close();
+				delete m_pCacheWriter;
+				m_pCacheWriter = NULL;
+				PluginResultCache.Store(m_sCacheKey, m_sCachePath);
+			}
+		}
+		return ok;
 	}
 	virtual bool WriteString(LPCTSTR line, stl_size_t length)
 	{
@@ -145,13 +283,40 @@ public:
 	virtual void Close()
 	{
 		m_spStreamDispatch.Release();
+		m_buffer.clear();
+		m_nBufferPos = 0;
+		m_bEndOfStream = false;
+		DiscardCache();
+		delete m_pCachedFile;
+		m_pCachedFile = NULL;
 	}
 	virtual bool IsOpen() const
 	{
-		return m_spStreamDispatch != NULL;
+		return m_spStreamDispatch != NULL || m_pCachedFile != NULL;
 	}
 	virtual bool OpenReadOnly(LPCTSTR filename)
 	{
+		if (!m_sVersion.empty())
+		{
+			String stamp = GetFileStamp(filename);
+			if (!stamp.empty())
+			{
+				m_sCacheKey = m_sVersion + _T("|") + filename + _T("|") + stamp;
+				String path;
+				if (PluginResultCache.Lookup(m_sCacheKey, path))
+				{
+					UniMemFile *pCachedFile = new UniMemFile;
+					if (pCachedFile->OpenReadOnly(path.c_str()))
+					{
+						pCachedFile->ReadBom();
+						m_pCachedFile = pCachedFile;
+						return true;
+					}
+					delete pCachedFile;
+				}
+				OpenCache();
+			}
+		}
 		CMyVariant var;
 		OException::Check(
 			m_OpenTextFile.Call(m_spFactoryDispatch,
@@ -159,11 +324,19 @@ public:
 		OException::Check(var.ChangeType(VT_DISPATCH));
 		m_spStreamDispatch = V_DISPATCH(&var);
 		if (m_spStreamDispatch == NULL)
+		{
+			DiscardCache();
 			return false;
-		OException::Check(
-			m_ReadLine.Init(m_spStreamDispatch, L"ReadLine"));
+		}
 		OException::Check(
 			m_AtEndOfStream.Init(m_spStreamDispatch, L"AtEndOfStream"));
+		// Prefer reading in blocks if the stream supports it
+		m_bBlockMode = SUCCEEDED(m_Read.Init(m_spStreamDispatch, L"Read"));
+		if (!m_bBlockMode)
+		{
+			OException::Check(
+				m_ReadLine.Init(m_spStreamDispatch, L"ReadLine"));
+		}
 		return true;
 	}
 	virtual bool OpenCreate(LPCTSTR filename)
@@ -182,13 +355,185 @@ public:
 	}
 
 private:
+	/** @brief Number of characters to request per Read() call. */
+	static const long BLOCK_SIZE = 64 * 1024;
+
+	bool AtEndOfStream()
+	{
+		CMyVariant var;
+		OException::Check(m_AtEndOfStream.Call(m_spStreamDispatch,
+			CMyDispParams<0>().Unnamed, DISPATCH_PROPERTYGET, &var));
+		OException::Check(var.ChangeType(VT_BOOL));
+		return V_BOOL(&var) != VARIANT_FALSE;
+	}
+	/**
+	 * @brief Convert a piece of text as returned by the plugin.
+	 */
+	void ConvertText(String &line, LPCWSTR text, UINT len, bool *lossy)
+	{
+		if (m_unicoding == NEITHER)
+		{
+			HString *str = HString::Uni(text, len)->Oct();
+			UINT const cb = SysStringByteLen(str->B);
+			ucr::maketstring(line, str->A, cb, m_codepage, lossy);
+			str->Free();
+		}
+		else
+		{
+			line.assign(text, len);
+		}
+	}
+	/**
+	 * @brief Append the next block from the stream to the buffer.
+	 * @return false if the stream is exhausted.
+	 */
+	bool FillBuffer()
+	{
+		if (m_bEndOfStream || AtEndOfStream())
+		{
+			m_bEndOfStream = true;
+			return false;
+		}
+		CMyVariant var;
+		OException::Check(m_Read.Call(m_spStreamDispatch,
+			CMyDispParams<1>().Unnamed(static_cast<long>(BLOCK_SIZE)), DISPATCH_METHOD, &var));
+		OException::Check(var.ChangeType(VT_BSTR));
+		m_buffer.erase(0, m_nBufferPos);
+		m_nBufferPos = 0;
+		m_buffer.append(V_BSTR(&var), SysStringLen(V_BSTR(&var)));
+		return true;
+	}
+	/**
+	 * @brief Read a line from the block buffer, along with its actual EOL.
+	 */
+	bool ReadBlockString(String &line, String &eol, bool *lossy)
+	{
+		String::size_type nScanPos = m_nBufferPos;
+		for (;;)
+		{
+			String::size_type const i = m_buffer.find_first_of(_T("\r\n"), nScanPos);
+			if (i != String::npos)
+			{
+				// A CR at the end of the buffer may be the first half of a CRLF
+				if (m_buffer[i] == _T('\r') && i + 1 == m_buffer.length())
+				{
+					String::size_type const nOffset = i - m_nBufferPos;
+					if (FillBuffer())
+					{
+						nScanPos = m_nBufferPos + nOffset;
+						continue;
+					}
+				}
+				String::size_type const nEolLen =
+					m_buffer[i] == _T('\r') && i + 1 < m_buffer.length() &&
+					m_buffer[i + 1] == _T('\n') ? 2 : 1;
+				ConvertText(line, m_buffer.c_str() + m_nBufferPos,
+					static_cast<UINT>(i - m_nBufferPos), lossy);
+				eol.assign(m_buffer.c_str() + i, nEolLen);
+				m_nBufferPos = i + nEolLen;
+				return true;
+			}
+			String::size_type const nOffset = m_buffer.length() - m_nBufferPos;
+			if (!FillBuffer())
+				break;
+			nScanPos = m_nBufferPos + nOffset;
+		}
+		eol.clear();
+		if (m_nBufferPos == m_buffer.length())
+		{
+			line.clear();
+			return false;
+		}
+		ConvertText(line, m_buffer.c_str() + m_nBufferPos,
+			static_cast<UINT>(m_buffer.length() - m_nBufferPos), lossy);
+		m_nBufferPos = m_buffer.length();
+		return true;
+	}
+	/**
+	 * @brief Read a line through the line-based interface.
+	 * Such lines come without EOL, so CRLF is assumed.
+	 */
+	bool ReadLineString(String &line, String &eol, bool *lossy)
+	{
+		if (AtEndOfStream())
+		{
+			line.clear();
+			eol.clear();
+			return false;
+		}
+		CMyVariant var;
+		OException::Check(m_ReadLine.Call(m_spStreamDispatch,
+			CMyDispParams<0>().Unnamed, DISPATCH_METHOD, &var));
+		OException::Check(var.ChangeType(VT_BSTR));
+		// Convert BSTR to String
+		if (m_unicoding == NEITHER)
+		{
+			V_BSTR(&var) = reinterpret_cast<HString *>(V_BSTR(&var))->Oct()->B;
+			UINT const len = SysStringByteLen(V_BSTR(&var));
+			ucr::maketstring(line, reinterpret_cast<char *>(V_BSTR(&var)), len, m_codepage, lossy);
+		}
+		else
+		{
+			line.assign(V_BSTR(&var), SysStringLen(V_BSTR(&var)));
+		}
+		// Don't let EOL chars exist in the midst of lines and cause crashes
+		String::iterator p = line.begin();
+		String::iterator const q = line.end();
+		if ((p = std::remove_if(p, q, LineInfo::IsEol)) != q)
+		{
+			line.erase(p, q);
+			*lossy = true;
+		}
+		eol = _T("\r\n");
+		return true;
+	}
+	/**
+	 * @brief Start writing the output to a file for the cache.
+	 */
+	void OpenCache()
+	{
+		m_sCachePath = env_GetTempFileName(env_GetTempPath(), _T("PLG"));
+		if (m_sCachePath.empty())
+			return;
+		m_pCacheWriter = new UniStdioFile;
+		m_pCacheWriter->SetUnicoding(UCS2LE);
+		m_pCacheWriter->SetBom(true);
+		if (m_pCacheWriter->OpenCreate(m_sCachePath.c_str()))
+			m_pCacheWriter->WriteBom();
+		else
+			DiscardCache();
+	}
+	/**
+	 * @brief Abandon an incomplete output file for the cache.
+	 */
+	void DiscardCache()
+	{
+		if (m_pCacheWriter)
+		{
+			m_pCacheWriter->Close();
+			delete m_pCacheWriter;
+			m_pCacheWriter = NULL;
+			DeleteFile(m_sCachePath.c_str());
+		}
+	}
+
 	CMyComPtr<IDispatch> m_spFactoryDispatch;
 	CMyDispId m_OpenTextFile;
 	CMyDispId m_CreateTextFile;
 	CMyComPtr<IDispatch> m_spStreamDispatch;
 	CMyDispId m_ReadLine;
+	CMyDispId m_Read;
 	CMyDispId m_Write;
 	CMyDispId m_AtEndOfStream;
+	String m_buffer; /**< Characters read ahead in block mode */
+	String::size_type m_nBufferPos; /**< Start of unconsumed characters */
+	bool m_bEndOfStream;
+	bool m_bBlockMode; /**< Stream is read through Read() */
+	String m_sVersion; /**< Plugin identity, or empty if not cacheable */
+	String m_sCacheKey;
+	String m_sCachePath;
+	UniMemFile *m_pCachedFile; /**< Output replayed from the cache */
+	UniStdioFile *m_pCacheWriter; /**< Output being recorded for the cache */
 };
 
 UniFile *PackingInfo::Default(PackingInfo *)
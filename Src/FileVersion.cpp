@@ -17,3 +17,212 @@ String FileVersion::GetVersionString() const
 		HIWORD(m_versionLS), LOWORD(m_versionLS));
 	return ver;
 }
+
+/**
+ * @brief Bounds checked little-endian reads from a file image.
+ */
+class FileVersionImageReader
+{
+public:
+	FileVersionImageReader(const void *pv, size_t cb)
+		: pb(static_cast<const BYTE *>(pv)), cb(cb) { }
+	bool Has(size_t offset, size_t size) const
+	{
+		return offset <= cb && size <= cb - offset;
+	}
+	WORD Word(size_t offset) const
+	{
+		return static_cast<WORD>(pb[offset] | pb[offset + 1] << 8);
+	}
+	DWORD Dword(size_t offset) const
+	{
+		return Word(offset) | static_cast<DWORD>(Word(offset + 2)) << 16;
+	}
+	/**
+	 * @brief Translate a relative virtual address to a file offset.
+	 * @param [in] sections File offset of the section table.
+	 * @param [in] nSections Number of sections.
+	 * @param [in] rva Relative virtual address to translate.
+	 * @param [out] offset Receives the file offset.
+	 * @return Whether some section contains the address.
+	 */
+	bool RvaToOffset(size_t sections, size_t nSections, DWORD rva, size_t &offset) const
+	{
+		for (size_t i = 0; i < nSections; ++i)
+		{
+			size_t const section = sections + i * 40;
+			if (!Has(section, 40))
+				break;
+			DWORD const va = Dword(section + 12);
+			DWORD size = Dword(section + 8);
+			if (size == 0)
+				size = Dword(section + 16);
+			if (rva >= va && rva - va < size)
+			{
+				offset = Dword(section + 20) + (rva - va);
+				return true;
+			}
+		}
+		return false;
+	}
+private:
+	const BYTE *const pb;
+	size_t const cb;
+};
+
+/**
+ * @brief Read the fixed file version from the image of a PE file.
+ * This walks the resource directory of the image to the first RT_VERSION
+ * resource, and takes the version numbers from its VS_FIXEDFILEINFO. All
+ * reads are bounds checked, so damaged or foreign files are safe to pass.
+ * @param [in] pv Pointer to file image.
+ * @param [in] cb Size of file image.
+ * @return Whether a version was found.
+ */
+bool FileVersion::ReadFromImage(const void *pv, size_t cb)
+{
+	const FileVersionImageReader image(pv, cb);
+	// DOS header, with offset of NT headers at 0x3C
+	if (!image.Has(0, 0x40) || image.Word(0) != 0x5A4D)
+		return false;
+	size_t const nt = image.Dword(0x3C);
+	// NT headers: "PE\0\0", file header, optional header
+	if (!image.Has(nt, 26) || image.Dword(nt) != 0x00004550)
+		return false;
+	size_t const nSections = image.Word(nt + 6);
+	size_t const opt = nt + 24;
+	size_t const sections = opt + image.Word(nt + 20);
+	size_t dirs;
+	switch (image.Word(opt))
+	{
+	case 0x10B: // PE32
+		dirs = opt + 96;
+		break;
+	case 0x20B: // PE32+
+		dirs = opt + 112;
+		break;
+	default:
+		return false;
+	}
+	// Resource table is the third data directory
+	if (dirs + 24 > sections || !image.Has(dirs - 4, 28) || image.Dword(dirs - 4) <= 2)
+		return false;
+	size_t root;
+	if (!image.RvaToOffset(sections, nSections, image.Dword(dirs + 16), root))
+		return false;
+	// Walk down type, name, and language levels
+	size_t offset = root;
+	for (int level = 0; level < 3; ++level)
+	{
+		if (!image.Has(offset, 16))
+			return false;
+		size_t const nNamed = image.Word(offset + 12);
+		size_t const nIds = image.Word(offset + 14);
+		size_t entry = offset + 16;
+		if (level == 0)
+		{
+			// Look for RT_VERSION among the entries identified by number
+			entry += nNamed * 8;
+			size_t i = 0;
+			while (i < nIds && image.Has(entry, 8) && image.Dword(entry) != 16)
+			{
+				entry += 8;
+				++i;
+			}
+			if (i == nIds)
+				return false;
+		}
+		else if (nNamed + nIds == 0)
+		{
+			return false;
+		}
+		if (!image.Has(entry, 8))
+			return false;
+		DWORD const child = image.Dword(entry + 4);
+		// Subdirectories have the high bit set, data entries have not
+		if (((child & 0x80000000) != 0) != (level < 2))
+			return false;
+		offset = root + (child & 0x7FFFFFFF);
+	}
+	// Data entry holds address and size of the VS_VERSIONINFO block
+	if (!image.Has(offset, 8))
+		return false;
+	DWORD const cbBlock = image.Dword(offset + 4);
+	size_t block;
+	if (!image.RvaToOffset(sections, nSections, image.Dword(offset), block) ||
+		!image.Has(block, cbBlock))
+	{
+		return false;
+	}
+	// VS_FIXEDFILEINFO follows the key at a DWORD aligned position
+	for (size_t i = 0; i + 52 <= cbBlock; i += 4)
+	{
+		if (image.Dword(block + i) == 0xFEEF04BD)
+		{
+			m_versionMS = image.Dword(block + i + 8);
+			m_versionLS = image.Dword(block + i + 12);
+			return true;
+		}
+	}
+	return false;
+}
+
+TESTCASE
+{
+	struct Image
+	{
+		BYTE data[0x300];
+		void Put(size_t offset, DWORD value, size_t size = 4)
+		{
+			while (size--)
+			{
+				data[offset++] = static_cast<BYTE>(value);
+				value >>= 8;
+			}
+		}
+	} image;
+	memset(image.data, 0, sizeof image.data);
+	image.Put(0x00, 0x5A4D, 2);
+	image.Put(0x3C, 0x40);
+	// NT headers with one section, and a PE32 optional header
+	image.Put(0x40, 0x00004550);
+	image.Put(0x46, 1, 2);
+	image.Put(0x54, 0xE0, 2);
+	image.Put(0x58, 0x10B, 2);
+	image.Put(0x58 + 92, 16);
+	image.Put(0x58 + 96 + 16, 0x1000);
+	image.Put(0x58 + 96 + 20, 0x100);
+	// Section at RVA 0x1000, stored at file offset 0x200
+	image.Put(0x138 + 8, 0x200);
+	image.Put(0x138 + 12, 0x1000);
+	image.Put(0x138 + 16, 0x200);
+	image.Put(0x138 + 20, 0x200);
+	// Resource tree: RT_VERSION / 1 / 0x409
+	image.Put(0x20E, 1, 2);
+	image.Put(0x210, 16);
+	image.Put(0x214, 0x80000018);
+	image.Put(0x226, 1, 2);
+	image.Put(0x228, 1);
+	image.Put(0x22C, 0x80000030);
+	image.Put(0x23E, 1, 2);
+	image.Put(0x240, 0x409);
+	image.Put(0x244, 0x48);
+	image.Put(0x248, 0x1060);
+	image.Put(0x24C, 0x5C);
+	// VS_FIXEDFILEINFO of version 1.2.3.4
+	image.Put(0x260 + 40, 0xFEEF04BD);
+	image.Put(0x260 + 48, 0x00010002);
+	image.Put(0x260 + 52, 0x00030004);
+	FileVersion version;
+	assert(version.ReadFromImage(image.data, sizeof image.data));
+	assert(version.m_versionMS == 0x00010002 && version.m_versionLS == 0x00030004);
+	// Truncated images are rejected
+	FileVersion truncated;
+	assert(!truncated.ReadFromImage(image.data, 0x2A0));
+	assert(truncated.GetSortKey() == 0);
+	// Sort keys compare numerically, unlike version strings
+	FileVersion later;
+	later.m_versionMS = 0x0001000A;
+	assert(later.GetSortKey() > version.GetSortKey());
+	return 0;
+}
@@ -18,4 +18,7 @@ public:
 	FileVersion(): m_versionMS(0), m_versionLS(0) { }
 	void Clear() { m_versionMS = m_versionLS = 0; }
 	String GetVersionString() const;
+	bool ReadFromImage(const void *, size_t);
+	/** @brief Key which sorts versions in numeric order. */
+	UINT64 GetSortKey() const { return static_cast<UINT64>(m_versionMS) << 32 | m_versionLS; }
 };
@@ -25,6 +25,23 @@ static void CopyTextStats(const file_data * inf, FileTextStats * myTextStats)
 	myTextStats->nzeros = inf->count_zeros;
 }
 
+/**
+ * @brief Return how far the compare engine has read into a file.
+ */
+static UINT64 GetBytesRead(HANDLE h)
+{
+	LARGE_INTEGER li;
+	li.QuadPart = 0;
+	if (h != NULL && h != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER zero;
+		zero.QuadPart = 0;
+		if (!SetFilePointerEx(h, zero, &li, FILE_CURRENT))
+			li.QuadPart = 0;
+	}
+	return li.QuadPart;
+}
+
 FolderCmp::FolderCmp(CDiffContext *pCtxt, LONG iCompareThread)
 : m_pDiffUtilsEngine(NULL)
 , m_pByteCompare(NULL)
@@ -60,6 +77,10 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 
 	UINT code = DIFFCODE::FILE | DIFFCODE::CMPERR; // yields a warning icon
 
+	ZeroMemory(&m_metrics, sizeof m_metrics);
+	m_metrics.nEngine = CompareStats::ENGINE_NONE;
+	LONGLONG nTicks = CompareStats::GetTicks();
+
 	if (nCompMethod == CMP_CONTENT ||
 		nCompMethod == CMP_QUICK_CONTENT ||
 		nCompMethod == CMP_BINARY_CONTENT)
@@ -68,6 +89,14 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 		m_diffFileData.m_textStats[0].clear();
 		m_diffFileData.m_textStats[1].clear();
 
+		// Archive entries with equal stored size and CRC need not be read
+		if (m_pCtx->ResolveDeferredItem(di))
+		{
+			m_ndiffs = 0;
+			m_ntrivialdiffs = 0;
+			return DIFFCODE::FILE | DIFFCODE::SAME;
+		}
+
 		String origFileName1;
 		String origFileName2;
 		GetComparePaths(di, origFileName1, origFileName2);
@@ -77,7 +106,9 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 			// store true names for diff utils patch file
 			m_diffFileData.SetDisplayFilepaths(origFileName1.c_str(), origFileName2.c_str());
 
-			if (!m_diffFileData.OpenFiles(origFileName1.c_str(), origFileName2.c_str()))
+			bool const bOpened = m_diffFileData.OpenFiles(origFileName1.c_str(), origFileName2.c_str());
+			m_metrics.rgPhaseTicks[CompareStats::PHASE_OPEN] = CompareStats::GetTicks() - nTicks;
+			if (!bOpened)
 			{
 				return 0; // yields an error icon
 			}
@@ -87,11 +118,13 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 				m_diffFileData.GetFileHandle(0), m_diffFileData.GetFileHandle(1)
 			};
 
+			nTicks = CompareStats::GetTicks();
 			GuessCodepageEncoding(origFileName1.c_str(), &m_diffFileData.m_FileLocation[0].encoding, m_pCtx->m_bGuessEncoding, osfhandle[0]);
 			if (osfhandle[1] != osfhandle[0])
 				GuessCodepageEncoding(origFileName2.c_str(), &m_diffFileData.m_FileLocation[1].encoding, m_pCtx->m_bGuessEncoding, osfhandle[1]);
 			else
 				m_diffFileData.m_FileLocation[1].encoding = m_diffFileData.m_FileLocation[0].encoding;
+			m_metrics.rgPhaseTicks[CompareStats::PHASE_ENCODING] = CompareStats::GetTicks() - nTicks;
 
 			// If either file is larger than limit fall back to cheaper method
 			// This allows us to (faster) compare big binary files
@@ -114,14 +147,18 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 		}
 	}
 
+	nTicks = CompareStats::GetTicks();
+
 	if (nCompMethod == CMP_CONTENT)
 	{
+		m_metrics.nEngine = CompareStats::ENGINE_DIFFUTILS;
 		if (m_pDiffUtilsEngine == NULL)
 			m_pDiffUtilsEngine = new CompareEngines::DiffUtils(m_pCtx);
 
 		m_pDiffUtilsEngine->SetCodepage(
 			m_diffFileData.m_FileLocation[0].encoding.m_unicoding ?
 				CP_UTF8 : m_diffFileData.m_FileLocation[0].encoding.m_codepage);
+		m_pDiffUtilsEngine->SetDiffThreads(m_pCtx->m_nDiffThreads);
 		m_pDiffUtilsEngine->SetCompareFiles(
 			m_diffFileData.m_FileLocation[0].filepath,
 			m_diffFileData.m_FileLocation[1].filepath);
@@ -129,6 +166,8 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 		code = m_pDiffUtilsEngine->diffutils_compare_files(&m_diffFileData);
 		m_ndiffs = m_pDiffUtilsEngine->m_ndiffs;
 		m_ntrivialdiffs = m_pDiffUtilsEngine->m_ntrivialdiffs;
+		m_metrics.nDiffAlgorithm = m_pDiffUtilsEngine->m_status.nAlgorithmUsed;
+		m_metrics.bCostCapped = m_pDiffUtilsEngine->m_status.bCostCapped;
 		CopyTextStats(&m_diffFileData.file[0], &m_diffFileData.m_textStats[0]);
 		CopyTextStats(&m_diffFileData.file[1], &m_diffFileData.m_textStats[1]);
 
@@ -142,6 +181,7 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 	}
 	else if (nCompMethod == CMP_QUICK_CONTENT)
 	{
+		m_metrics.nEngine = CompareStats::ENGINE_BYTECOMPARE;
 		if (m_pByteCompare == NULL)
 			m_pByteCompare = new CompareEngines::ByteCompare(m_pCtx);
 
@@ -160,6 +200,7 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 	}
 	else if (nCompMethod == CMP_BINARY_CONTENT)
 	{
+		m_metrics.nEngine = CompareStats::ENGINE_BINARYCOMPARE;
 		if (m_pBinaryCompare == NULL)
 			m_pBinaryCompare = new CompareEngines::BinaryCompare(m_pCtx);
 
@@ -175,6 +216,7 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 	}
 	else if (nCompMethod == CMP_DATE || nCompMethod == CMP_DATE_SIZE || nCompMethod == CMP_SIZE)
 	{
+		m_metrics.nEngine = CompareStats::ENGINE_TIMESIZECOMPARE;
 		if (m_pTimeSizeCompare == NULL)
 			m_pTimeSizeCompare = new CompareEngines::TimeSizeCompare(m_pCtx);
 
@@ -201,6 +243,13 @@ UINT FolderCmp::prepAndCompareTwoFiles(DIFFITEM *di)
 		code ^= DIFFCODE::TEXT; // revert reverse logic
 	}
 
+	m_metrics.rgPhaseTicks[CompareStats::PHASE_COMPARE] = CompareStats::GetTicks() - nTicks;
+	HANDLE const h0 = m_diffFileData.GetFileHandle(0);
+	HANDLE const h1 = m_diffFileData.GetFileHandle(1);
+	m_metrics.nBytesRead = GetBytesRead(h0);
+	if (h1 != h0)
+		m_metrics.nBytesRead += GetBytesRead(h1);
+
 	m_diffFileData.Reset();
 
 	return code;
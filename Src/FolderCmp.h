@@ -10,6 +10,7 @@
 #include "ByteCompare.h"
 #include "BinaryCompare.h"
 #include "TimeSizeCompare.h"
+#include "CompareStats.h"
 
 class CDiffContext;
 class PackingInfo;
@@ -30,6 +31,7 @@ public:
 	int m_ndiffs;
 	int m_ntrivialdiffs;
 	const LONG m_iCompareThread;
+	CompareStats::FileMetrics m_metrics; /**< What it took to compare the files */
 
 	DiffFileData m_diffFileData;
 
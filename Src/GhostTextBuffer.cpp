@@ -54,6 +54,7 @@ BOOL CGhostTextBuffer::InitNew(CRLFSTYLE nCrlfStyle)
 void CGhostTextBuffer::FreeAll()
 {
 	m_aUndoBuf.clear();
+	m_UndoJournal.Clear();
 	CCrystalTextBuffer::FreeAll();
 }
 
@@ -117,7 +118,7 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 			{
 				GetText(apparent_ptStartPos.y, apparent_ptStartPos.x,
 					apparent_ptEndPos.y, apparent_ptEndPos.x, text, _T("\n"));
-				if (ur.VerifyText(text))
+				if (ur.VerifyText(m_UndoJournal, text))
 				{
 					InternalDeleteText(NULL,
 						apparent_ptStartPos.y, apparent_ptStartPos.x,
@@ -166,8 +167,7 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 			else
 				ASSERT(0);
 
-			// it is not easy to know when Recompute so we do it always
-			RecomputeRealityMapping();
+			UpdateRealityMapping(apparent_ptStartPos.y, apparent_ptEndPos.y, apparent_ptStartPos.y);
 
 			RecomputeEOL(apparent_ptStartPos.y, apparent_ptStartPos.y);
 		}
@@ -175,7 +175,7 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 		{
 			ptCursorPos = InternalInsertText(NULL,
 				apparent_ptStartPos.y, apparent_ptStartPos.x,
-				ur.GetText(), ur.GetTextLength());
+				ur.GetText(m_UndoJournal), ur.GetTextLength());
 			m_dwCurrentRevisionNumber++;
 
 			// for the flags, the logic is nearly the same as in insertText
@@ -201,8 +201,7 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 				li.m_nSkippedLines = 0;
 			}
 
-			// it is not easy to know when Recompute so we do it always
-			RecomputeRealityMapping();
+			UpdateRealityMapping(apparent_ptStartPos.y, apparent_ptStartPos.y, ptCursorPos.y);
 
 			RecomputeEOL(apparent_ptStartPos.y, ptCursorPos.y);
 		}
@@ -222,9 +221,10 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 		}
 
 		// restore line revision numbers
-		stl_size_t naSavedRevisonNumbersSize = ur.m_paSavedRevisonNumbers.size();
-		for (stl_size_t i = 0; i < naSavedRevisonNumbersSize; i++)
-			m_aLines[apparent_ptStartPos.y + i].m_dwRevisionNumber = ur.m_paSavedRevisonNumbers[i];
+		int const nSavedRevisonNumbersSize = ur.GetRevisionCount();
+		DWORD const *const paSavedRevisonNumbers = ur.GetRevisionNumbers(m_UndoJournal);
+		for (int i = 0; i < nSavedRevisonNumbersSize; i++)
+			m_aLines[apparent_ptStartPos.y + i].m_dwRevisionNumber = paSavedRevisonNumbers[i];
 
 	} while ((dwFlags & UNDO_BEGINGROUP) == 0);
 	SetModified(m_nSyncPosition != m_nUndoPosition);
@@ -235,6 +235,7 @@ bool CGhostTextBuffer::Undo(POINT &ptCursorPos)
 	// may have partially completed (if in a group)
 	m_nUndoPosition = 0;
 	m_aUndoBuf.clear();
+	m_UndoJournal.Clear();
 	return false;
 }
 
@@ -275,7 +276,7 @@ bool CGhostTextBuffer::Redo(POINT &ptCursorPos)
 		if (ur.m_dwFlags & UNDO_INSERT)
 		{
 			ptCursorPos = InsertText(NULL, apparent_ptStartPos.y, apparent_ptStartPos.x,
-				ur.GetText(), ur.GetTextLength(), 0, FALSE);
+				ur.GetText(m_UndoJournal), ur.GetTextLength(), 0, FALSE);
 		}
 		else
 		{
@@ -283,7 +284,7 @@ bool CGhostTextBuffer::Redo(POINT &ptCursorPos)
 			String text;
 			GetText(apparent_ptStartPos.y, apparent_ptStartPos.x,
 				apparent_ptEndPos.y, apparent_ptEndPos.x, text, _T("\n"));
-			ASSERT(ur.VerifyText(text));
+			ASSERT(ur.VerifyText(m_UndoJournal, text));
 #endif
 			DeleteText(NULL, apparent_ptStartPos.y, apparent_ptStartPos.x,
 				apparent_ptEndPos.y, apparent_ptEndPos.x, 0, FALSE);
@@ -312,6 +313,7 @@ UndoRecord &CGhostTextBuffer::AddUndoRecord(BOOL bInsert, const POINT &ptStartPo
 	// Strip unnecessary undo records (edit after undo wipes all potential redo records)
 	if (m_nUndoPosition < m_aUndoBuf.size())
 	{
+		m_UndoJournal.Truncate(m_aUndoBuf[m_nUndoPosition].GetJournalEntry());
 		m_aUndoBuf.resize(m_nUndoPosition);
 		if (m_nSyncPosition > m_nUndoPosition)
 			m_nSyncPosition = m_aUndoBuf.npos;
@@ -334,7 +336,7 @@ UndoRecord &CGhostTextBuffer::AddUndoRecord(BOOL bInsert, const POINT &ptStartPo
 		ur.m_nRealLinesCreated = nRealLinesChanged;
 	else
 		ur.m_nRealLinesInDeletedBlock = nRealLinesChanged;
-	ur.SetText(pszText, cchText);
+	ur.SetText(m_UndoJournal, pszText, cchText);
 
 	// Optimize memory allocation
 	if (m_aUndoBuf.capacity() == m_aUndoBuf.size())
@@ -431,8 +433,7 @@ POINT CGhostTextBuffer::InsertText(CCrystalTextView *pSource,
 	// now we can recompute
 	if ((ptCursorPos.y > nLine) || bFirstLineGhost)
 	{
-		// TODO: Be smarter, and don't recompute if it is easy to see what changed
-		RecomputeRealityMapping();
+		UpdateRealityMapping(nLine, nLine, ptCursorPos.y);
 	}
 
 	RecomputeEOL(nLine, ptCursorPos.y);
@@ -442,7 +443,7 @@ POINT CGhostTextBuffer::InsertText(CCrystalTextView *pSource,
 		POINT ptStartPos = { nPos, nLine };
 		UndoRecord &ur = AddUndoRecord(TRUE, ptStartPos, ptCursorPos,
 			pszText, cchText, nRealLinesCreated, nAction);
-		ur.m_paSavedRevisonNumbers.swap(paSavedRevisonNumbers);
+		ur.SetRevisionNumbers(m_UndoJournal, paSavedRevisonNumbers);
 
 		if (bGroupFlag)
 			FlushUndoGroup(pSource);
@@ -542,8 +543,7 @@ void CGhostTextBuffer::DeleteText(CCrystalTextView *pSource,
 	// now we can recompute
 	if (nStartLine != nEndLine)
 	{
-		// TODO: Be smarter, and don't recompute if it is easy to see what changed
-		RecomputeRealityMapping();
+		UpdateRealityMapping(nStartLine, nEndLine, nStartLine);
 	}
 
 	RecomputeEOL(nStartLine, nStartLine);
@@ -555,7 +555,7 @@ void CGhostTextBuffer::DeleteText(CCrystalTextView *pSource,
 		UndoRecord &ur = AddUndoRecord(FALSE, ptStartPos, ptEndPos,
 			sTextToDelete.c_str(), sTextToDelete.length(),
 			nRealLinesInDeletedBlock, nAction);
-		ur.m_paSavedRevisonNumbers.swap(paSavedRevisonNumbers);
+		ur.SetRevisionNumbers(m_UndoJournal, paSavedRevisonNumbers);
 
 		if (bGroupFlag)
 			FlushUndoGroup(pSource);
@@ -574,7 +574,9 @@ void CGhostTextBuffer::InsertGhostLine(int nLine)
 	CCrystalTextBuffer::InsertLine(NULL, 0, nLine);
 	// Set WinMerge flags
 	m_aLines[nLine].m_dwFlags |= LF_GHOST;
-	RecomputeRealityMapping();
+	// Shifted lines break the chain of cookies which are candidates for reuse
+	m_nParseCookieHint = m_nParseCookieCount;
+	UpdateRealityMapping(nLine, nLine - 1, nLine);
 	// Don't need to recompute EOL as real lines are unchanged.
 	// Never AddUndoRecord as Rescan clears the ghost lines.
 }
@@ -604,6 +606,7 @@ void CGhostTextBuffer::RemoveAllGhostLines(DWORD dwMask)
 	}
 	// Discard unused entries in one shot
 	m_aLines.resize(j);
+	m_nParseCookieHint = m_nParseCookieCount;
 	RecomputeRealityMapping();
 }
 
@@ -616,11 +619,7 @@ void CGhostTextBuffer::RemoveAllGhostLines(DWORD dwMask)
  */
 int CGhostTextBuffer::ApparentLastRealLine() const
 {
-	stl_size_t const size = m_RealityBlocks.size();
-	if (size == 0)
-		return -1;
-	RealityBlock const &block = m_RealityBlocks.back();
-	return block.nStartApparent + block.nCount - 1;
+	return m_RealityBlocks.GetApparentEnd() - 1;
 }
 
 /**
@@ -634,32 +633,22 @@ int CGhostTextBuffer::ApparentLastRealLine() const
  */
 int CGhostTextBuffer::ComputeRealLine(int nApparentLine) const
 {
-	RealityBlock const *blo = m_RealityBlocks.begin();
-	RealityBlock const *bhi = m_RealityBlocks.end();
-	if (blo == bhi)
+	int const nBlocks = m_RealityBlocks.GetCount();
+	if (nBlocks == 0)
 		return 0;
 
 	// after last apparent line ?
 	ASSERT(nApparentLine < GetLineCount());
 
-	// after last block ?
-	RealityBlock const &maxblock = m_RealityBlocks.back();
-	if (nApparentLine >= maxblock.nStartApparent + maxblock.nCount)
-		return maxblock.nStartReal + maxblock.nCount;
-
-	// binary search to find correct (or nearest block)
-	while (blo < bhi)
-	{
-		RealityBlock const *const b = blo + ((bhi - blo) >> 1);
-		if (nApparentLine < b->nStartApparent + b->nCount)
-			bhi = b;
-		if (nApparentLine >= b->nStartApparent)
-			blo = b + 1;
-	}
-	if (bhi < blo) // found it inside this block
-		return (nApparentLine - bhi->nStartApparent) + bhi->nStartReal;
-	// it is a ghost line just before block bhi
-	return bhi->nStartReal;
+	// find correct (or nearest block)
+	RealityBlock block;
+	if (m_RealityBlocks.FindApparent(nApparentLine, block) == nBlocks)
+		// after last block
+		return m_RealityBlocks.GetRealEnd();
+	if (nApparentLine >= block.nStartApparent) // found it inside this block
+		return (nApparentLine - block.nStartApparent) + block.nStartReal;
+	// it is a ghost line just before the block
+	return block.nStartReal;
 }
 
 /**
@@ -670,27 +659,17 @@ int CGhostTextBuffer::ComputeRealLine(int nApparentLine) const
  */
 int CGhostTextBuffer::ComputeApparentLine(int nRealLine) const
 {
-	RealityBlock const *blo = m_RealityBlocks.begin();
-	RealityBlock const *bhi = m_RealityBlocks.end();
-	if (blo == bhi)
+	int const nBlocks = m_RealityBlocks.GetCount();
+	if (nBlocks == 0)
 		return 0;
 
-	// after last block ?
-	RealityBlock const &maxblock = m_RealityBlocks.back();
-	if (nRealLine >= maxblock.nStartReal + maxblock.nCount)
+	// find correct (or nearest block)
+	RealityBlock block;
+	if (m_RealityBlocks.FindReal(nRealLine, block) == nBlocks)
+		// after last block
 		return GetLineCount();
-
-	// binary search to find correct (or nearest block)
-	while (blo < bhi)
-	{
-		RealityBlock const *const b = blo + ((bhi - blo) >> 1);
-		if (nRealLine < b->nStartReal + b->nCount)
-			bhi = b;
-		if (nRealLine >= b->nStartReal)
-			blo = b + 1;
-	}
-	if (bhi < blo)
-		return (nRealLine - bhi->nStartReal) + bhi->nStartApparent;
+	if (nRealLine >= block.nStartReal)
+		return (nRealLine - block.nStartReal) + block.nStartApparent;
 	// Should have found it; all real lines should be in a block
 	ASSERT(0);
 	return -1;
@@ -708,9 +687,8 @@ int CGhostTextBuffer::ComputeApparentLine(int nRealLine) const
  */
 int CGhostTextBuffer::ComputeRealLineAndGhostAdjustment(int nApparentLine, int &decToReal) const
 {
-	RealityBlock const *blo = m_RealityBlocks.begin();
-	RealityBlock const *bhi = m_RealityBlocks.end();
-	if (blo == bhi)
+	int const nBlocks = m_RealityBlocks.GetCount();
+	if (nBlocks == 0)
 	{
 		decToReal = 0;
 		return 0;
@@ -719,31 +697,22 @@ int CGhostTextBuffer::ComputeRealLineAndGhostAdjustment(int nApparentLine, int &
 	// after last apparent line ?
 	ASSERT(nApparentLine < GetLineCount());
 
-	// after last block ?
-	RealityBlock const &maxblock = m_RealityBlocks.back();
-	if (nApparentLine >= maxblock.nStartApparent + maxblock.nCount)
+	// find correct (or nearest block)
+	RealityBlock block;
+	if (m_RealityBlocks.FindApparent(nApparentLine, block) == nBlocks)
 	{
+		// after last block
 		decToReal = GetLineCount() - nApparentLine;
-		return maxblock.nStartReal + maxblock.nCount;
-	}
-
-	// binary search to find correct (or nearest block)
-	while (blo < bhi)
-	{
-		RealityBlock const *const b = blo + ((bhi - blo) >> 1);
-		if (nApparentLine < b->nStartApparent + b->nCount)
-			bhi = b;
-		if (nApparentLine >= b->nStartApparent)
-			blo = b + 1;
+		return m_RealityBlocks.GetRealEnd();
 	}
-	if (bhi < blo) // found it inside this block
+	if (nApparentLine >= block.nStartApparent) // found it inside this block
 	{
 		decToReal = 0;
-		return (nApparentLine - bhi->nStartApparent) + bhi->nStartReal;
+		return (nApparentLine - block.nStartApparent) + block.nStartReal;
 	}
-	// it is a ghost line just before block blo
-	decToReal = bhi->nStartApparent - nApparentLine;
-	return bhi->nStartReal;
+	// it is a ghost line just before the block
+	decToReal = block.nStartApparent - nApparentLine;
+	return block.nStartReal;
 }
 
 /**
@@ -757,42 +726,33 @@ int CGhostTextBuffer::ComputeApparentLine(int nRealLine, int decToReal) const
 {
 	int nApparent = GetLineCount();
 
-	RealityBlock const *blo = m_RealityBlocks.begin();
-	RealityBlock const *bhi = m_RealityBlocks.end();
-	if (blo == bhi)
+	int const nBlocks = m_RealityBlocks.GetCount();
+	if (nBlocks == 0)
 		return 0;
 
-	// after last block ?
-	RealityBlock const &maxblock = m_RealityBlocks.back();
-	if (nRealLine < maxblock.nStartReal + maxblock.nCount)
+	// find correct (or nearest block)
+	RealityBlock block;
+	int const nBlock = m_RealityBlocks.FindReal(nRealLine, block);
+	if (nBlock < nBlocks)
 	{
-		// binary search to find correct (or nearest block)
-		while (blo < bhi)
-		{
-			RealityBlock const *const b = blo + ((bhi - blo) >> 1);
-			if (nRealLine < b->nStartReal + b->nCount)
-				bhi = b;
-			if (nRealLine >= b->nStartReal)
-				blo = b + 1;
-		}
-		if (bhi == blo) // not found
+		if (nRealLine < block.nStartReal) // not found
 		{
 			// Should have found it; all real lines should be in a block
 			ASSERT(0);
 			return -1;
 		}
 		// found it inside this block
-		nApparent = (nRealLine - bhi->nStartReal) + bhi->nStartApparent;
-		if (nRealLine > bhi->nStartReal)
+		nApparent = (nRealLine - block.nStartReal) + block.nStartApparent;
+		if (nRealLine > block.nStartReal)
 			// limited by the previous line in this block
 			return nApparent;
 	}
 
 	// we must not go below the value nextApparentAfterPreviousBlock
 	int nextApparentAfterPreviousBlock = 0;
-	if (bhi > m_RealityBlocks.begin())
+	if (nBlock > 0)
 	{
-		RealityBlock const &previousBlock = *--bhi;
+		RealityBlock const previousBlock = m_RealityBlocks.Get(nBlock - 1);
 		nextApparentAfterPreviousBlock = previousBlock.nStartApparent + previousBlock.nCount;
 	}
 	nApparent -= decToReal;
@@ -809,7 +769,7 @@ void CGhostTextBuffer::FinishLoading()
 /** Recompute the reality mapping (this is fairly naive) */
 void CGhostTextBuffer::RecomputeRealityMapping()
 {
-	m_RealityBlocks.clear();
+	vector<RealityBlock> aBlocks;
 	stl_size_t reality = 0; // last encountered real line
 	stl_size_t i = 0; // current line
 	stl_size_t const n = m_aLines.size();
@@ -843,13 +803,115 @@ void CGhostTextBuffer::RecomputeRealityMapping()
 			ASSERT(block.nCount > 0);
 			ASSERT(reality - block.nStartReal == block.nCount);
 			// Optimize memory allocation
-			if (m_RealityBlocks.capacity() == m_RealityBlocks.size())
+			if (aBlocks.capacity() == aBlocks.size())
 			{
-				m_RealityBlocks.reserve(m_RealityBlocks.size() ? m_RealityBlocks.size() * 2 : 16);
+				aBlocks.reserve(aBlocks.size() ? aBlocks.size() * 2 : 16);
 			}
-			m_RealityBlocks.push_back(block);
+			aBlocks.push_back(block);
+		}
+	}
+	m_RealityBlocks.Clear();
+	m_RealityBlocks.Replace(0, 0, aBlocks.data(), static_cast<int>(aBlocks.size()));
+}
+
+/**
+ * @brief Update the reality mapping after an edit.
+ * Apparent lines nLine to nOldEndLine have been replaced with apparent lines
+ * nLine to nNewEndLine. Either range may be empty (end line is nLine - 1).
+ * Only the lines of the edit and the ghost lines around them are rescanned.
+ * The blocks behind the edit are stored relative to the blocks before them,
+ * so they follow the change in line counts without being touched.
+ */
+void CGhostTextBuffer::UpdateRealityMapping(int nLine, int nOldEndLine, int nNewEndLine)
+{
+	int const nDelta = nNewEndLine - nOldEndLine;
+	int const nBlocks = m_RealityBlocks.GetCount();
+	vector<RealityBlock> aBlocks; // replacement for blocks nFirst to nLast - 1
+	// find where to start the rescan
+	RealityBlock block;
+	int nFirst = m_RealityBlocks.FindApparent(nLine, block);
+	int i = 0;
+	int nReal = 0;
+	if (nFirst < nBlocks && block.nStartApparent <= nLine)
+	{
+		// edit starts inside a block, so keep the part of it before nLine
+		i = nLine;
+		nReal = block.nStartReal + (nLine - block.nStartApparent);
+		if (block.nStartApparent < nLine)
+		{
+			block.nCount = nLine - block.nStartApparent;
+			aBlocks.push_back(block);
+		}
+	}
+	else if (nFirst > 0)
+	{
+		// edit starts among ghost lines, so rescan from the previous block
+		block = m_RealityBlocks.Get(--nFirst);
+		aBlocks.push_back(block);
+		i = block.nStartApparent + block.nCount;
+		nReal = block.nStartReal + block.nCount;
+	}
+	// find where to stop the rescan
+	RealityBlock tail;
+	int nLast = m_RealityBlocks.FindApparent(nOldEndLine + 1, tail);
+	int nEnd = GetLineCount();
+	if (nLast < nBlocks)
+	{
+		// keep the part of the block after nOldEndLine
+		++nLast;
+		int const nSkip = nOldEndLine + 1 - tail.nStartApparent;
+		if (nSkip > 0)
+		{
+			tail.nStartApparent += nSkip;
+			tail.nStartReal += nSkip;
+			tail.nCount -= nSkip;
+		}
+		nEnd = tail.nStartApparent + nDelta;
+	}
+	// rescan the lines in between, same as RecomputeRealityMapping()
+	while (i < nEnd)
+	{
+		LineInfo const &li = m_aLines[i];
+		if (li.m_dwFlags & LF_GHOST)
+		{
+			nReal += li.m_nSkippedLines;
+		}
+		else if (!aBlocks.empty() &&
+			aBlocks.back().nStartApparent + aBlocks.back().nCount == i &&
+			aBlocks.back().nStartReal + aBlocks.back().nCount == nReal)
+		{
+			++aBlocks.back().nCount;
+			++nReal;
+		}
+		else
+		{
+			block.nStartReal = nReal++;
+			block.nStartApparent = i;
+			block.nCount = 1;
+			aBlocks.push_back(block);
+		}
+		++i;
+	}
+	if (nEnd < GetLineCount())
+	{
+		// attach the tail
+		tail.nStartApparent = nEnd;
+		tail.nStartReal = nReal;
+		if (!aBlocks.empty() &&
+			aBlocks.back().nStartApparent + aBlocks.back().nCount == nEnd &&
+			aBlocks.back().nStartReal + aBlocks.back().nCount == nReal)
+		{
+			aBlocks.back().nCount += tail.nCount;
+		}
+		else
+		{
+			aBlocks.push_back(tail);
 		}
 	}
+	m_RealityBlocks.Replace(nFirst, nLast, aBlocks.data(), static_cast<int>(aBlocks.size()));
+#ifdef _ADVANCED_BUGCHECK
+	checkFlagsFromReality();
+#endif
 }
 
 /** we recompute EOL from the real line before nStartLine to nEndLine */
@@ -897,11 +959,12 @@ void CGhostTextBuffer::RecomputeEOL(int nStartLine, int nEndLine)
 void CGhostTextBuffer::checkFlagsFromReality() const
 {
 	int i = 0;
-	for (RealityBlock const *b = m_RealityBlocks.begin(); b != m_RealityBlocks.end(); ++b)
+	for (int n = 0; n < m_RealityBlocks.GetCount(); ++n)
 	{
-		for (; i < b->nStartApparent; i++)
+		RealityBlock const b = m_RealityBlocks.Get(n);
+		for (; i < b.nStartApparent; i++)
 			ASSERT((GetLineFlags(i) & LF_GHOST) != 0);
-		for (; i < b->nStartApparent + b->nCount; i++)
+		for (; i < b.nStartApparent + b.nCount; i++)
 			ASSERT((GetLineFlags(i) & LF_GHOST) == 0);
 	}
 
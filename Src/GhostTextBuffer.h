@@ -7,6 +7,7 @@
 
 #include "ccrystaltextbuffer.h"
 #include "GhostUndoRecord.h"
+#include "RealityIndex.h"
 
 /////////////////////////////////////////////////////////////////////////////
 
@@ -84,19 +85,7 @@ protected:
                               LPCTSTR pszText, int cchText, int nRealLinesChanged, int nActionType = CE_ACTION_UNKNOWN);
 
 private:
-	/**
-	 * @brief A struct mapping real lines and apparent (screen) lines.
-	 * This struct maps lines between real lines and apparent (screen) lines.
-	 * The mapping records for each text block an apparent line and matching
-	 * real line.
-	 */
-	struct RealityBlock
-	{
-		int nStartReal; /**< Start line of real block. */
-		int nStartApparent; /**< Start line of apparent block. */
-		int nCount; /**< Lines in the block. */
-	};
-	std::vector<RealityBlock> m_RealityBlocks; /**< Mapping of real and apparent lines. */
+	RealityIndex m_RealityBlocks; /**< Mapping of real and apparent lines. */
 
 	// Operations
 public:
@@ -145,6 +134,7 @@ public:
 
 private:
 	void RecomputeRealityMapping();
+	void UpdateRealityMapping(int nLine, int nOldEndLine, int nNewEndLine);
 	/**
 	Code to set EOL, if the status ghost/real of the line changes
 
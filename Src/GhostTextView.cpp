@@ -257,6 +257,42 @@ void CGhostTextView::GetAdditionalTextBlocks(int nLineIndex, TextBlock::Array &r
 	rpBuf.m_nBack = nWordDiffs * 2;
 }
 
+/**
+ * @brief Update the view, and drop what the other pane has cached about the
+ * changed lines, as its word diff highlights depend on the text of this pane.
+ */
+void CGhostTextView::UpdateView(CCrystalTextView *pSource, CUpdateContext *pContext, DWORD dwFlags, int nLineIndex)
+{
+	CCrystalEditView::UpdateView(pSource, pContext, dwFlags, nLineIndex);
+	int nLineIndex2 = nLineIndex;
+	if ((dwFlags & UPDATE_RESET) || nLineIndex == -1)
+	{
+		nLineIndex = 0;
+		nLineIndex2 = -1;
+	}
+	else if (!(dwFlags & UPDATE_SINGLELINE))
+	{
+		nLineIndex2 = -1;
+	}
+	int const nOtherPane = 1 - m_nThisPane;
+	if (CGhostTextView *const pView = m_pDocument->GetView(nOtherPane))
+		pView->InvalidateRenderCache(nLineIndex, nLineIndex2);
+	if (CGhostTextView *const pView = m_pDocument->GetDetailView(nOtherPane))
+		pView->InvalidateRenderCache(nLineIndex, nLineIndex2);
+}
+
+/**
+ * @brief Return a render cache key for the word diff highlights of a line.
+ * Highlights look different while the line belongs to the current diff.
+ */
+DWORD CGhostTextView::GetAdditionalTextBlocksKey(int nLineIndex)
+{
+	DWORD const dwLineFlags = GetLineFlags(nLineIndex);
+	if ((dwLineFlags & LF_DIFF) != LF_DIFF)
+		return 0;
+	return IsLineInCurrentDiff(nLineIndex);
+}
+
 /**
  * @brief Draw selection margin.
  * @param [in] pdc         Pointer to draw context.
@@ -112,9 +112,12 @@ public:
 
 	virtual COLORREF GetColor(int nColorIndex);
 
+	virtual void UpdateView(CCrystalTextView *pSource, CUpdateContext *pContext, DWORD dwFlags, int nLineIndex = -1) override;
+
 protected:
 	virtual bool IsLineInCurrentDiff(int) = 0;
 	virtual void GetAdditionalTextBlocks(int nLineIndex, TextBlock::Array &pBuf);
+	virtual DWORD GetAdditionalTextBlocksKey(int nLineIndex);
 	virtual bool DrawSingleLine(HSurface *, const RECT &, int nLineIndex);
 	virtual void DrawMargin(HSurface *, const RECT &, int nLineIndex, int nLineNumber);
 	BOOL OnMouseWheel(WPARAM, LPARAM);
@@ -0,0 +1,322 @@
+/////////////////////////////////////////////////////////////////////////////
+//    License (GPLv3+):
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful, but
+//    WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////////
+/**
+ * @file  HexDiffIndex.cpp
+ *
+ * @brief Implementation file for HexDiffIndex class
+ */
+#include "StdAfx.h"
+#include "HexDiffIndex.h"
+
+HexDiffIndex::HexDiffIndex()
+	: m_bValid(false)
+{
+	m_pData[0] = m_pData[1] = NULL;
+	m_nLength[0] = m_nLength[1] = 0;
+}
+
+/**
+ * @brief Build the index from scratch.
+ */
+void HexDiffIndex::Build(const BYTE *p0, int n0, const BYTE *p1, int n1)
+{
+	m_pData[0] = p0;
+	m_pData[1] = p1;
+	m_nLength[0] = n0;
+	m_nLength[1] = n1;
+	m_aRanges.clear();
+	m_aDirtyPages.clear();
+	Scan(m_aRanges, 0, max(n0, n1));
+	m_bValid = true;
+}
+
+/**
+ * @brief Bring the index up to date.
+ * Only the pages passed to InvalidateRange() are rescanned, unless the
+ * buffers have moved or changed in length, which calls for a full rebuild.
+ * @return Whether the buffers differ.
+ */
+bool HexDiffIndex::Update(const BYTE *p0, int n0, const BYTE *p1, int n1)
+{
+	if (!m_bValid || p0 != m_pData[0] || p1 != m_pData[1] ||
+		n0 != m_nLength[0] || n1 != m_nLength[1])
+	{
+		Build(p0, n0, p1, n1);
+	}
+	else
+	{
+		std::sort(m_aDirtyPages.begin(), m_aDirtyPages.end());
+		int nPrevPage = -1;
+		std::vector<int>::const_iterator it = m_aDirtyPages.begin();
+		while (it != m_aDirtyPages.end())
+		{
+			int const nPage = *it++;
+			if (nPage != nPrevPage)
+				Rescan(nPage);
+			nPrevPage = nPage;
+		}
+		m_aDirtyPages.clear();
+	}
+	return !m_aRanges.empty();
+}
+
+/**
+ * @brief Mark the index as out of date as a whole.
+ */
+void HexDiffIndex::Invalidate()
+{
+	m_bValid = false;
+}
+
+/**
+ * @brief Mark the pages which hold the given range of bytes as out of date.
+ * @param [in] nBegin Offset of first changed byte.
+ * @param [in] nEnd Offset just beyond last changed byte.
+ */
+void HexDiffIndex::InvalidateRange(int nBegin, int nEnd)
+{
+	if (!m_bValid)
+		return;
+	// compare page numbers rather than offsets, which overflow near INT_MAX
+	int const nLastPage = nEnd > 0 ? (nEnd - 1) / PAGE_SIZE : -1;
+	for (int nPage = nBegin / PAGE_SIZE; nPage <= nLastPage; ++nPage)
+	{
+		// successive keystrokes tend to hit the same page
+		if (m_aDirtyPages.empty() || m_aDirtyPages.back() != nPage)
+			m_aDirtyPages.push_back(nPage);
+	}
+}
+
+/**
+ * @brief Find the first range which begins after the given offset.
+ * @return Pointer to the range, or NULL if there is none.
+ */
+const HexDiffIndex::Range *HexDiffIndex::FindNext(int nOffset) const
+{
+	const Range *lo = m_aRanges.begin();
+	const Range *hi = m_aRanges.end();
+	while (lo < hi)
+	{
+		const Range *const mid = lo + ((hi - lo) >> 1);
+		if (mid->begin > nOffset)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return lo != m_aRanges.end() ? lo : NULL;
+}
+
+/**
+ * @brief Find the last range which begins before the given offset.
+ * @return Pointer to the range, or NULL if there is none.
+ */
+const HexDiffIndex::Range *HexDiffIndex::FindPrev(int nOffset) const
+{
+	const Range *lo = m_aRanges.begin();
+	const Range *hi = m_aRanges.end();
+	while (lo < hi)
+	{
+		const Range *const mid = lo + ((hi - lo) >> 1);
+		if (mid->begin >= nOffset)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return lo != m_aRanges.begin() ? lo - 1 : NULL;
+}
+
+/**
+ * @brief Append the ranges of differing bytes within the given span.
+ * A range which touches the last range in the list extends it.
+ * @param [in,out] aRanges List to append to.
+ * @param [in] nBegin Offset at which to start the scan.
+ * @param [in] nEnd Offset at which to stop the scan.
+ */
+void HexDiffIndex::Scan(std::vector<Range> &aRanges, int nBegin, int nEnd) const
+{
+	const BYTE *const p0 = m_pData[0];
+	const BYTE *const p1 = m_pData[1];
+	int const nCommon = min(nEnd, min(m_nLength[0], m_nLength[1]));
+	int i = nBegin;
+	while (i < nEnd)
+	{
+		// skip over equal blocks in bulk
+		if (nCommon - i >= BLOCK_SIZE && memcmp(p0 + i, p1 + i, BLOCK_SIZE) == 0)
+		{
+			i += BLOCK_SIZE;
+			continue;
+		}
+		int const nBlockEnd = nEnd - i > BLOCK_SIZE ? i + BLOCK_SIZE : nEnd;
+		while (i < nBlockEnd)
+		{
+			if (i < nCommon && p0[i] == p1[i])
+			{
+				++i;
+				continue;
+			}
+			int j = i + 1;
+			while (j < nCommon && p0[j] != p1[j])
+				++j;
+			// bytes beyond the end of the shorter buffer all differ
+			if (j >= nCommon)
+				j = nEnd;
+			if (!aRanges.empty() && aRanges.back().end == i)
+			{
+				aRanges.back().end = j;
+			}
+			else
+			{
+				Range range = { i, j };
+				aRanges.push_back(range);
+			}
+			i = j;
+		}
+	}
+}
+
+/**
+ * @brief Rescan one page, and splice the result into the list.
+ * Ranges which touch the page are taken apart and joined again with what
+ * the scan finds, so that the list keeps holding maximal runs.
+ */
+void HexDiffIndex::Rescan(int nPage)
+{
+	int const nLength = max(m_nLength[0], m_nLength[1]);
+	int const nBegin = nPage * PAGE_SIZE;
+	if (nBegin >= nLength)
+		return;
+	int const nEnd = nLength - nBegin > PAGE_SIZE ? nBegin + PAGE_SIZE : nLength;
+	// find the ranges which overlap or touch the page
+	Range *first = m_aRanges.begin();
+	Range *hi = m_aRanges.end();
+	while (first < hi)
+	{
+		Range *const mid = first + ((hi - first) >> 1);
+		if (mid->end >= nBegin)
+			hi = mid;
+		else
+			first = mid + 1;
+	}
+	Range *last = first;
+	while (last != m_aRanges.end() && last->begin <= nEnd)
+		++last;
+	std::vector<Range> aRanges;
+	if (first != last && first->begin < nBegin)
+	{
+		Range range = { first->begin, nBegin };
+		aRanges.push_back(range);
+	}
+	Scan(aRanges, nBegin, nEnd);
+	if (first != last && last[-1].end > nEnd)
+	{
+		Range range = { nEnd, last[-1].end };
+		if (!aRanges.empty() && aRanges.back().end == nEnd)
+			aRanges.back().end = range.end;
+		else
+			aRanges.push_back(range);
+	}
+	stl_size_t const nFirst = first - m_aRanges.begin();
+	m_aRanges.erase(first, last);
+	m_aRanges.insert(m_aRanges.begin() + nFirst, aRanges.begin(), aRanges.end());
+}
+
+/**
+ * @brief Check whether two indexes hold the same ranges.
+ */
+static bool SameRanges(const HexDiffIndex &a, const HexDiffIndex &b)
+{
+	if (a.GetCount() != b.GetCount())
+		return false;
+	const HexDiffIndex::Range *p = a.FindNext(-1);
+	const HexDiffIndex::Range *q = b.FindNext(-1);
+	while (p && q)
+	{
+		if (p->begin != q->begin || p->end != q->end)
+			return false;
+		p = a.FindNext(p->begin);
+		q = b.FindNext(q->begin);
+	}
+	return p == q;
+}
+
+TESTCASE
+{
+	int const nPageSize = 64 * 1024;
+	// Edit bytes around page boundaries, and compare with a full rebuild
+	std::vector<BYTE> data[2];
+	data[0].resize(3 * nPageSize + 100);
+	data[1].resize(3 * nPageSize - 50);
+	int const n0 = static_cast<int>(data[0].size());
+	int const n1 = static_cast<int>(data[1].size());
+	HexDiffIndex index, check;
+	index.Build(&data[0].front(), n0, &data[1].front(), n1);
+	// Grow a range across a page boundary from either side
+	static const int Offsets[] = { nPageSize, nPageSize - 1, 2 * nPageSize - 1, 2 * nPageSize };
+	for (int k = 0; k < _countof(Offsets); ++k)
+	{
+		data[k % 2][Offsets[k]] = 1;
+		index.InvalidateRange(Offsets[k], Offsets[k] + 1);
+		index.Update(&data[0].front(), n0, &data[1].front(), n1);
+		check.Build(&data[0].front(), n0, &data[1].front(), n1);
+		assert(SameRanges(index, check));
+	}
+	assert(index.GetCount() == 3);
+	unsigned seed = 1;
+	for (int n = 0; n < 300; ++n)
+	{
+		seed = seed * 1103515245 + 12345;
+		int const nEdits = 1 + (seed >> 16) % 3;
+		for (int k = 0; k < nEdits; ++k)
+		{
+			seed = seed * 1103515245 + 12345;
+			int const nSide = (seed >> 16) % 2;
+			std::vector<BYTE> &side = data[nSide];
+			int const nSize = static_cast<int>(side.size());
+			seed = seed * 1103515245 + 12345;
+			int nBegin = (1 + (seed >> 16) % 3) * nPageSize - 8;
+			seed = seed * 1103515245 + 12345;
+			nBegin += (seed >> 16) % 16;
+			seed = seed * 1103515245 + 12345;
+			int const nEnd = min(nBegin + 1 + static_cast<int>((seed >> 16) % 8), nSize);
+			for (int i = nBegin; i < nEnd; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				side[i] = (seed >> 16) % 4 == 0;
+			}
+			if (nBegin < nEnd)
+				index.InvalidateRange(nBegin, nEnd);
+		}
+		bool const bDiffer = index.Update(&data[0].front(), n0, &data[1].front(), n1);
+		check.Build(&data[0].front(), n0, &data[1].front(), n1);
+		assert(SameRanges(index, check));
+		assert(bDiffer == (check.GetCount() != 0));
+	}
+	// A buffer which ends at INT_MAX, of which only the bytes in common with
+	// the shorter buffer are ever read
+	BYTE a[300] = { 0 }, b[300] = { 0 };
+	b[100] = 1;
+	index.Build(a, _countof(a), b, INT_MAX);
+	assert(index.GetCount() == 2 && index.FindPrev(INT_MAX)->end == INT_MAX);
+	index.InvalidateRange(INT_MAX - 10, INT_MAX);
+	index.InvalidateRange(0, INT_MAX);
+	a[100] = 1;
+	a[200] = 1;
+	index.Update(a, _countof(a), b, INT_MAX);
+	check.Build(a, _countof(a), b, INT_MAX);
+	assert(SameRanges(index, check) && index.GetCount() == 2);
+	assert(index.FindNext(0)->begin == 200 && index.FindNext(200)->begin == 300);
+	return 0;
+}
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////
+//    License (GPLv3+):
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful, but
+//    WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//    General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+/////////////////////////////////////////////////////////////////////////////
+/**
+ * @file  HexDiffIndex.h
+ *
+ * @brief Declaration file for HexDiffIndex class
+ */
+#pragma once
+
+/**
+ * @brief Sorted list of the byte ranges in which two buffers differ.
+ * Bytes beyond the end of the shorter buffer count as differing. The index
+ * is built page by page, and pages known to have changed can be rescanned
+ * without touching the rest of the buffers.
+ */
+class HexDiffIndex
+{
+public:
+	/** @brief A maximal run of differing bytes. */
+	struct Range
+	{
+		int begin; /**< Offset of first differing byte. */
+		int end; /**< Offset just beyond last differing byte. */
+	};
+
+	HexDiffIndex();
+	void Build(const BYTE *, int, const BYTE *, int);
+	bool Update(const BYTE *, int, const BYTE *, int);
+	void Invalidate();
+	void InvalidateRange(int, int);
+	bool IsValid() const { return m_bValid; }
+	int GetCount() const { return static_cast<int>(m_aRanges.size()); }
+	const Range *FindNext(int) const;
+	const Range *FindPrev(int) const;
+
+private:
+	/** @brief Granularity of rescans. */
+	static const int PAGE_SIZE = 64 * 1024;
+	/** @brief Granularity of the memcmp() fast path. */
+	static const int BLOCK_SIZE = 256;
+
+	void Scan(std::vector<Range> &, int, int) const;
+	void Rescan(int nPage);
+
+	const BYTE *m_pData[2];
+	int m_nLength[2];
+	bool m_bValid;
+	std::vector<Range> m_aRanges;
+	std::vector<int> m_aDirtyPages;
+};
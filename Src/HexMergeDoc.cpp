@@ -58,6 +58,23 @@ CHexMergeView *CHexMergeFrame::GetActiveView() const
 	return m_pView[::GetFocus() == m_pView[1]->m_hWnd];
 }
 
+/**
+ * @brief Bring the index of differing bytes up to date
+ */
+const HexDiffIndex &CHexMergeFrame::UpdateDiffIndex()
+{
+	int lengthLeft = m_pView[0]->GetLength();
+	const BYTE *bufferLeft = m_pView[0]->GetBuffer(lengthLeft);
+	if (bufferLeft == NULL)
+		lengthLeft = 0;
+	int lengthRight = m_pView[1]->GetLength();
+	const BYTE *bufferRight = m_pView[1]->GetBuffer(lengthRight);
+	if (bufferRight == NULL)
+		lengthRight = 0;
+	m_diffIndex.Update(bufferLeft, lengthLeft, bufferRight, lengthRight);
+	return m_diffIndex;
+}
+
 /**
  * @brief Update associated diff item
  */
@@ -73,12 +90,9 @@ int CHexMergeFrame::UpdateDiffItem(CDirFrame *pDirDoc)
 			pDirDoc->GetDiffContext()->UpdateDiffItemEx(di);
 		}
 	}
-	int lengthLeft = m_pView[0]->GetLength();
-	void *bufferLeft = m_pView[0]->GetBuffer(lengthLeft);
-	int lengthRight = m_pView[1]->GetLength();
-	void *bufferRight = m_pView[1]->GetBuffer(lengthRight);
-	int nResult = lengthLeft != lengthRight ||
-		bufferLeft && bufferRight && memcmp(bufferLeft, bufferRight, lengthLeft);
+	// The files on disk may have changed, so rebuild the index from scratch
+	m_diffIndex.Invalidate();
+	int nResult = UpdateDiffIndex().GetCount() != 0;
 	SetLastCompareResult(nResult);
 	return nResult;
 }
@@ -346,6 +360,7 @@ void CHexMergeFrame::CopySel(CHexMergeView *pViewSrc, CHexMergeView *pViewDst)
 	if (pStatSrc->bSelected)
 	{
 		pViewDst->GetInterface()->copy_sel_from(pViewSrc->GetInterface());
+		m_diffIndex.InvalidateRange(i, j + 1);
 		HWND hwndFocus = ::GetFocus();
 		if (hwndFocus != pViewSrc->m_hWnd)
 			pViewDst->RepaintRange(i, j);
@@ -363,6 +378,7 @@ void CHexMergeFrame::CopyAll(CHexMergeView *pViewSrc, CHexMergeView *pViewDst)
 	if (int const i = pViewSrc->GetLength())
 	{
 		pViewDst->GetInterface()->copy_all_from(pViewSrc->GetInterface());
+		m_diffIndex.Invalidate();
 		HWND hwndFocus = ::GetFocus();
 		if (hwndFocus != pViewSrc->m_hWnd)
 			pViewDst->RepaintRange(0, i);
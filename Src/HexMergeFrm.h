@@ -23,6 +23,7 @@
  */
 #define HEKSEDIT_INTERFACE_VERSION 4
 #include "heksedit.h"
+#include "HexDiffIndex.h"
 
 class CHexMergeView;
 
@@ -46,6 +47,9 @@ public:
 	bool SaveModified();
 	void SetTitle();
 	HMenu *GetBookmarkMenu() const { return m_pBookmarkMenu; }
+	const HexDiffIndex &UpdateDiffIndex();
+	void InvalidateDiffIndex() { m_diffIndex.Invalidate(); }
+	void InvalidateDiffRange(int i, int j) { m_diffIndex.InvalidateRange(i, j); }
 
 private:
 	virtual ~CHexMergeFrame();
@@ -59,8 +63,8 @@ private:
 	int UpdateDiffItem(CDirFrame *);
 	CHexMergeView *GetActiveView() const;
 	void UpdateHeaderPath(int pane);
-	static void CopySel(CHexMergeView *pViewSrc, CHexMergeView *pViewDst);
-	static void CopyAll(CHexMergeView *pViewSrc, CHexMergeView *pViewDst);
+	void CopySel(CHexMergeView *pViewSrc, CHexMergeView *pViewDst);
+	void CopyAll(CHexMergeView *pViewSrc, CHexMergeView *pViewDst);
 	HRESULT LoadOneFile(int index, const FileLocation &fileinfo, BOOL readOnly);
 	void OnRefresh();
 	void OnFileSave();
@@ -80,4 +84,5 @@ private:
 	static const LONG FloatScript[];
 	static const LONG SplitScript[];
 	CHexMergeView *m_pView[MERGE_VIEW_COUNT]; /**< Pointer to left/right view */
+	HexDiffIndex m_diffIndex; /**< Ranges in which the views differ */
 };
@@ -61,6 +61,14 @@ static void NTAPI SetLastWriteTime(HANDLE h, UINT64 ft)
 	::SetFileTime(h, 0, 0, reinterpret_cast<FILETIME *>(&ft));
 }
 
+static BOOL NTAPI GetFileSize64(HANDLE h, UINT64 &size)
+{
+	return ::GetFileSizeEx(h, reinterpret_cast<LARGE_INTEGER *>(&size));
+}
+
+/** @brief Maximum number of bytes to transfer in one ReadFile() or WriteFile() */
+static const DWORD MAX_CHUNK = 16 * 1024 * 1024;
+
 static int nCBCodeLast = SB_ENDSCROLL;
 
 static void SynchronizeScrollPos(HWindow *pSender, int nBar)
@@ -111,6 +119,11 @@ LRESULT CHexMergeView::WindowProc(UINT uMsg, WPARAM wParam, LPARAM lParam)
 	case WM_LBUTTONDOWN:
 		SetFocus();
 		break;
+	case WM_CHAR:
+	case WM_KEYDOWN:
+		if (!GetReadOnly())
+			return OnEditKey(uMsg, wParam, lParam);
+		break;
 	case WM_WINDOWPOSCHANGED:
 		if ((reinterpret_cast<WINDOWPOS *>(lParam)->flags & SWP_NOSIZE) == 0)
 			OnSize();
@@ -243,7 +256,8 @@ BOOL CHexMergeView::IsFileChangedOnDisk(LPCTSTR path)
 		UINT64 upper = max(mtime, m_mtime);
 		bool bIgnoreSmallDiff = COptionsMgr::Get(OPT_IGNORE_SMALL_FILETIME);
 		UINT64 tolerance = bIgnoreSmallDiff ? SmallTimeDiff * FileTime::TicksPerSecond : 0;
-		bChanged = upper - lower > tolerance || m_size != GetFileSize(h, 0);
+		UINT64 size = 0;
+		bChanged = upper - lower > tolerance || !GetFileSize64(h, size) || m_size != size;
 		CloseHandle(h);
 	}
 	return bChanged;
@@ -256,19 +270,30 @@ HRESULT CHexMergeView::LoadFile(LPCTSTR path)
 {
 	HANDLE h = CreateFile(path, GENERIC_READ,
 		FILE_SHARE_READ | FILE_SHARE_WRITE,
-		0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+		0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
 	HRESULT hr = SE(h != INVALID_HANDLE_VALUE);
 	if (hr != S_OK)
 		return hr;
 	m_mtime = GetLastWriteTime(h);
-	DWORD length = m_size = GetFileSize(h, 0);
-	hr = SE(length != INVALID_FILE_SIZE);
+	hr = SE(GetFileSize64(h, m_size));
+	// The control keeps the content in one buffer with an int-sized length
+	if (hr == S_OK && m_size > INT_MAX)
+		hr = HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
 	if (hr == S_OK)
 	{
-		if (void *buffer = GetBuffer(length))
+		int const length = static_cast<int>(m_size);
+		if (BYTE *buffer = GetBuffer(length))
 		{
-			DWORD cb = 0;
-			hr = SE(ReadFile(h, buffer, length, &cb, 0) && cb == length);
+			// Read in chunks, as huge single reads may fail for lack of
+			// system resources on some file systems
+			int offset = 0;
+			while (hr == S_OK && offset < length)
+			{
+				DWORD const chunk = static_cast<DWORD>(min<int>(length - offset, MAX_CHUNK));
+				DWORD cb = 0;
+				hr = SE(ReadFile(h, buffer + offset, chunk, &cb, 0) && cb == chunk);
+				offset += chunk;
+			}
 			if (hr != S_OK)
 				GetBuffer(0);
 		}
@@ -312,12 +337,18 @@ HRESULT CHexMergeView::SaveFile(LPCTSTR path)
 	HRESULT hr = SE(h != INVALID_HANDLE_VALUE);
 	if (hr != S_OK)
 		return hr;
-	DWORD length = GetLength();
-	void *buffer = GetBuffer(length);
+	int const length = GetLength();
+	BYTE *const buffer = GetBuffer(length);
 	if (buffer == 0)
 		return E_POINTER;
-	DWORD cb = 0;
-	hr = SE(WriteFile(h, buffer, length, &cb, 0) && cb == length);
+	int offset = 0;
+	while (hr == S_OK && offset < length)
+	{
+		DWORD const chunk = static_cast<DWORD>(min<int>(length - offset, MAX_CHUNK));
+		DWORD cb = 0;
+		hr = SE(WriteFile(h, buffer + offset, chunk, &cb, 0) && cb == chunk);
+		offset += chunk;
+	}
 	UINT64 mtime = GetLastWriteTime(h);
 	CloseHandle(h);
 	if (hr != S_OK)
@@ -417,6 +448,7 @@ void CHexMergeView::OnEditFind()
 void CHexMergeView::OnEditReplace()
 {
 	m_pif->CMD_replace();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 /**
@@ -436,6 +468,7 @@ void CHexMergeView::OnEditRepeat()
 void CHexMergeView::OnEditCut()
 {
 	m_pif->CMD_edit_cut();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 /**
@@ -452,6 +485,7 @@ void CHexMergeView::OnEditCopy()
 void CHexMergeView::OnEditPaste()
 {
 	m_pif->CMD_edit_paste();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 /**
@@ -460,6 +494,7 @@ void CHexMergeView::OnEditPaste()
 void CHexMergeView::OnEditClear()
 {
 	m_pif->CMD_edit_clear();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 /**
@@ -473,11 +508,13 @@ void CHexMergeView::OnEditSelectAll()
 void CHexMergeView::OnEditUndo()
 {
 	m_pif->CMD_edit_undo();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 void CHexMergeView::OnEditRedo()
 {
 	m_pif->CMD_edit_redo();
+	m_pDocument->InvalidateDiffIndex();
 }
 
 void CHexMergeView::OnEditGoto()
@@ -516,14 +553,60 @@ BOOL CHexMergeView::PreTranslateMessage(MSG* pMsg)
 		return FALSE;
 	if (length != m_pif->get_length())
 		m_pif->resize_window();
+	// Accelerators may have edited the buffer in any way
+	m_pDocument->InvalidateDiffIndex();
 	return TRUE;
 }
 
+/**
+ * @brief Let the control handle a keystroke, and tell the frame which
+ * bytes it may have changed.
+ */
+LRESULT CHexMergeView::OnEditKey(UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	IHexEditorWindow::Status const *const pStatus = GetStatus();
+	const int length = m_pif->get_length();
+	int i = pStatus->iCurByte;
+	int j = i;
+	if (pStatus->bSelected)
+	{
+		i = min(i, min(pStatus->iStartOfSelection, pStatus->iEndOfSelection));
+		j = max(j, max(pStatus->iStartOfSelection, pStatus->iEndOfSelection));
+	}
+	LRESULT lResult = OWindow::WindowProc(uMsg, wParam, lParam);
+	if (length != m_pif->get_length())
+	{
+		m_pDocument->InvalidateDiffIndex();
+	}
+	else
+	{
+		i = min(i, pStatus->iCurByte);
+		j = max(j, pStatus->iCurByte);
+		m_pDocument->InvalidateDiffRange(i, j + 1);
+	}
+	return lResult;
+}
+
+/**
+ * @brief Return the offset from which to search for differences.
+ */
+int CHexMergeView::GetDiffSearchOffset()
+{
+	IHexEditorWindow::Status const *const pStatus = GetStatus();
+	int offset = pStatus->iCurByte;
+	if (pStatus->bSelected)
+		offset = min(pStatus->iStartOfSelection, pStatus->iEndOfSelection);
+	return offset;
+}
+
 /**
  * @brief Go to first diff
  */
 void CHexMergeView::OnFirstdiff()
 {
+	// Spare the control a scan through identical buffers
+	if (m_pDocument->UpdateDiffIndex().GetCount() == 0)
+		return;
 	m_pif->select_next_diff(TRUE);
 }
 
@@ -532,6 +615,8 @@ void CHexMergeView::OnFirstdiff()
  */
 void CHexMergeView::OnLastdiff()
 {
+	if (m_pDocument->UpdateDiffIndex().GetCount() == 0)
+		return;
 	m_pif->select_prev_diff(TRUE);
 }
 
@@ -540,6 +625,10 @@ void CHexMergeView::OnLastdiff()
  */
 void CHexMergeView::OnNextdiff()
 {
+	// Spare the control a scan through the remainder of the buffers
+	// when the index tells that no difference lies ahead
+	if (m_pDocument->UpdateDiffIndex().FindNext(GetDiffSearchOffset()) == NULL)
+		return;
 	m_pif->select_next_diff(FALSE);
 }
 
@@ -548,6 +637,8 @@ void CHexMergeView::OnNextdiff()
  */
 void CHexMergeView::OnPrevdiff()
 {
+	if (m_pDocument->UpdateDiffIndex().FindPrev(GetDiffSearchOffset()) == NULL)
+		return;
 	m_pif->select_prev_diff(FALSE);
 }
 
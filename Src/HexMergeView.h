@@ -36,7 +36,7 @@ public:
 	int m_nThisPane;
 	CHexMergeFrame *const m_pDocument;
 	UINT64 m_mtime;
-	DWORD m_size;
+	UINT64 m_size;
 	HStatusBar *m_pStatusBar;
 public:
 	CHexMergeView(CHexMergeFrame *, int);
@@ -62,6 +62,7 @@ public:
 	void RepaintRange(int, int);
     void UpdateBookmarkMenu();
 	BOOL IsFileChangedOnDisk(LPCTSTR);
+	int GetDiffSearchOffset();
 	void ZoomText(int amount);
 	// Overrides
 protected:
@@ -73,6 +74,7 @@ protected:
 // Message handlers
     void OnEraseBkgnd();
 	void OnSize();
+	LRESULT OnEditKey(UINT, WPARAM, LPARAM);
 
 public:
 	void OnEditFind();
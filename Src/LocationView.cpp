@@ -70,6 +70,7 @@ CLocationView::CLocationView(CChildFrame *pMergeDoc)
 	, m_visibleTop(-1)
 	, m_visibleBottom(-1)
 	, m_pSavedBackgroundBitmap(NULL)
+	, m_blocksLineInPix(0.0)
 	, m_bRecalculateBlocks(true) // calculate for the first time
 	, m_displayMovedBlocks(COptionsMgr::Get(OPT_CONNECT_MOVED_BLOCKS))
 {
@@ -205,7 +206,6 @@ void CLocationView::DrawBackground(HSurface *pDC)
 {
 	CMergeEditView *const pLeftView = m_pMergeDoc->GetLeftView();
 	CMergeEditView *const pRightView = m_pMergeDoc->GetRightView();
-	CMergeEditView *const pView = pLeftView;
 	if (pLeftView == NULL || pRightView == NULL)
 	{
 		assert(false);
@@ -217,10 +217,6 @@ void CLocationView::DrawBackground(HSurface *pDC)
 	pDC->SetBkColor(RGB(0xe8, 0xe8, 0xf4));
 	pDC->ExtTextOut(0, 0, ETO_OPAQUE, &rect, NULL, 0);
 
-	COLORREF cr0 = CLR_NONE; // Left side color
-	COLORREF cr1 = CLR_NONE; // Right side color
-	COLORREF crt = CLR_NONE; // Text color
-
 	m_movedLines.clear();
 
 	CalculateBars();
@@ -238,10 +234,9 @@ void CLocationView::DrawBackground(HSurface *pDC)
 
 	// Don't recalculate blocks if we earlier determined it is not needed
 	// This may save lots of processing
-	if (m_bRecalculateBlocks)
+	if (m_bRecalculateBlocks || m_blocksLineInPix != m_lineInPix)
 		CalculateBlocks();
 
-	int nPrevEndY = -1;
 	const int nCurDiff = m_pMergeDoc->GetCurrentDiff();
 
 	// Protect against out of bound accesses after line deletions
@@ -250,88 +245,25 @@ void CLocationView::DrawBackground(HSurface *pDC)
 	vector<DiffBlock>::const_iterator iter = m_diffBlocks.begin();
 	while (iter != m_diffBlocks.end() && iter->top_line < safe_line_count)
 	{
-		const bool bInsideDiff = nCurDiff == iter->diff_index;
-
-		if ((nPrevEndY != iter->bottom_coord) || bInsideDiff)
-		{
-			// Draw left side block
-			pLeftView->GetLineColors(iter->top_line, cr0, crt);
-			RECT r0 = { m_leftBar.left, iter->top_coord, m_leftBar.right, iter->bottom_coord };
-			DrawRect(pDC, r0, cr0, bInsideDiff);
-
-			// Draw right side block
-			pRightView->GetLineColors(iter->top_line, cr1, crt);
-			RECT r1 = { m_rightBar.left, iter->top_coord, m_rightBar.right, iter->bottom_coord };
-			DrawRect(pDC, r1, cr1, bInsideDiff);
-		}
-		nPrevEndY = iter->bottom_coord;
-
-		// Test if we draw a connector
-		BOOL bDisplayConnectorFromLeft = FALSE;
-		BOOL bDisplayConnectorFromRight = FALSE;
+		DrawDiffBlock(pDC, *iter, FALSE);
+		// we display all moved blocks, so once direction is enough
+		if (m_displayMovedBlocks == DISPLAY_MOVED_ALL)
+			AddMovedLine(*iter, TRUE, FALSE);
+		++iter;
+	}
 
-		switch (m_displayMovedBlocks)
+	// Draw the current difference on top, along with its marker
+	if (nCurDiff != -1 && m_pMergeDoc->m_diffList.IsDiffSignificant(nCurDiff))
+	{
+		DiffBlock blocks[2];
+		const int nBlocks = CalculateDiffBlocks(nCurDiff, blocks);
+		for (int i = 0; i < nBlocks && blocks[i].top_line < safe_line_count; ++i)
 		{
-		case DISPLAY_MOVED_FOLLOW_DIFF:
-			// display moved block only for current diff
-			if (!bInsideDiff)
-				break;
+			DrawDiffBlock(pDC, blocks[i], TRUE);
 			// two sides may be linked to a block somewhere else
-			bDisplayConnectorFromLeft = TRUE;
-			bDisplayConnectorFromRight = TRUE;
-			break;
-		case DISPLAY_MOVED_ALL:
-			// we display all moved blocks, so once direction is enough
-			bDisplayConnectorFromLeft = TRUE;
-			break;
-		default:
-			break;
-		}
-
-		if (bDisplayConnectorFromLeft)
-		{
-			int apparent0 = iter->top_line;
-			int apparent1 = m_pMergeDoc->RightLineInMovedBlock(apparent0);
-			const int nBlockHeight = iter->bottom_line - iter->top_line;
-			if (apparent1 != -1)
-			{
-				MovedLine line;
-				apparent0 = pView->GetSubLineIndex(apparent0);
-				apparent1 = pView->GetSubLineIndex(apparent1);
-				line.ptLeft.x = m_leftBar.right;
-				int leftUpper = (int) (apparent0 * m_lineInPix + Y_OFFSET);
-				int leftLower = (int) ((nBlockHeight + apparent0) * m_lineInPix + Y_OFFSET);
-				line.ptLeft.y = leftUpper + (leftLower - leftUpper) / 2;
-				line.ptRight.x = m_rightBar.left;
-				int rightUpper = (int) (apparent1 * m_lineInPix + Y_OFFSET);
-				int rightLower = (int) ((nBlockHeight + apparent1) * m_lineInPix + Y_OFFSET);
-				line.ptRight.y = rightUpper + (rightLower - rightUpper) / 2;
-				m_movedLines.push_back(line);
-			}
-		}
-
-		if (bDisplayConnectorFromRight)
-		{
-			int apparent1 = iter->top_line;
-			int apparent0 = m_pMergeDoc->LeftLineInMovedBlock(apparent1);
-			const int nBlockHeight = iter->bottom_line - iter->top_line;
-			if (apparent0 != -1)
-			{
-				MovedLine line;
-				apparent0 = pView->GetSubLineIndex(apparent0);
-				apparent1 = pView->GetSubLineIndex(apparent1);
-				line.ptLeft.x = m_leftBar.right;
-				int leftUpper = (int) (apparent0 * m_lineInPix + Y_OFFSET);
-				int leftLower = (int) ((nBlockHeight + apparent0) * m_lineInPix + Y_OFFSET);
-				line.ptLeft.y = leftUpper + (leftLower - leftUpper) / 2;
-				line.ptRight.x = m_rightBar.left;
-				int rightUpper = (int) (apparent1 * m_lineInPix + Y_OFFSET);
-				int rightLower = (int) ((nBlockHeight + apparent1) * m_lineInPix + Y_OFFSET);
-				line.ptRight.y = rightUpper + (rightLower - rightUpper) / 2;
-				m_movedLines.push_back(line);
-			}
+			if (m_displayMovedBlocks == DISPLAY_MOVED_FOLLOW_DIFF)
+				AddMovedLine(blocks[i], TRUE, TRUE);
 		}
-		++iter;
 	}
 
 	if (m_displayMovedBlocks != DISPLAY_MOVED_NONE)
@@ -343,6 +275,74 @@ void CLocationView::DrawBackground(HSurface *pDC)
 	m_visibleBottom = -1;
 }
 
+/**
+ * @brief Draw a block on both bars.
+ * @param [in] pDC Pointer to draw context.
+ * @param [in] block Block to draw.
+ * @param [in] bSelected Is block for selected difference?
+ */
+void CLocationView::DrawDiffBlock(HSurface *pDC, const DiffBlock &block, BOOL bSelected)
+{
+	COLORREF cr0 = CLR_NONE; // Left side color
+	COLORREF cr1 = CLR_NONE; // Right side color
+	COLORREF crt = CLR_NONE; // Text color
+
+	// Draw left side block
+	m_pMergeDoc->GetLeftView()->GetLineColors(block.top_line, cr0, crt);
+	RECT r0 = { m_leftBar.left, block.top_coord, m_leftBar.right, block.bottom_coord };
+	DrawRect(pDC, r0, cr0, bSelected);
+
+	// Draw right side block
+	m_pMergeDoc->GetRightView()->GetLineColors(block.top_line, cr1, crt);
+	RECT r1 = { m_rightBar.left, block.top_coord, m_rightBar.right, block.bottom_coord };
+	DrawRect(pDC, r1, cr1, bSelected);
+}
+
+/**
+ * @brief Add lines connecting a block to the blocks it has been moved from or to.
+ * @param [in] block Block for which to add connecting lines.
+ * @param [in] bFromLeft Connect the left side to a block on the right side.
+ * @param [in] bFromRight Connect the right side to a block on the left side.
+ */
+void CLocationView::AddMovedLine(const DiffBlock &block, BOOL bFromLeft, BOOL bFromRight)
+{
+	CMergeEditView *const pView = m_pMergeDoc->GetLeftView();
+	const int nBlockHeight = block.bottom_line - block.top_line;
+	for (int nSide = 0; nSide < 2; ++nSide)
+	{
+		int apparent0 = block.top_line;
+		int apparent1 = block.top_line;
+		if (nSide == 0)
+		{
+			if (!bFromLeft)
+				continue;
+			apparent1 = m_pMergeDoc->RightLineInMovedBlock(apparent0);
+			if (apparent1 == -1)
+				continue;
+		}
+		else
+		{
+			if (!bFromRight)
+				continue;
+			apparent0 = m_pMergeDoc->LeftLineInMovedBlock(apparent1);
+			if (apparent0 == -1)
+				continue;
+		}
+		MovedLine line;
+		apparent0 = pView->GetSubLineIndex(apparent0);
+		apparent1 = pView->GetSubLineIndex(apparent1);
+		line.ptLeft.x = m_leftBar.right;
+		int leftUpper = (int) (apparent0 * m_lineInPix + Y_OFFSET);
+		int leftLower = (int) ((nBlockHeight + apparent0) * m_lineInPix + Y_OFFSET);
+		line.ptLeft.y = leftUpper + (leftLower - leftUpper) / 2;
+		line.ptRight.x = m_rightBar.left;
+		int rightUpper = (int) (apparent1 * m_lineInPix + Y_OFFSET);
+		int rightLower = (int) ((nBlockHeight + apparent1) * m_lineInPix + Y_OFFSET);
+		line.ptRight.y = rightUpper + (rightLower - rightUpper) / 2;
+		m_movedLines.push_back(line);
+	}
+}
+
 /**
  * @brief Calculate bar coordinates and scaling factors.
  */
@@ -378,112 +378,100 @@ void CLocationView::CalculateBars()
  * is enabled. Otherwise the value from original difflist is used. Line
  * numbers are also converted to coordinates in the window. All calculated
  * (and not ignored) differences are added to the new list.
+ * Blocks which end on the same pixel row as the preceding block would be
+ * painted over by it, so they are left out. The list therefore holds no more
+ * blocks than the bars have pixel rows, however many differences there are.
  */
 void CLocationView::CalculateBlocks()
 {
-	// lineposition in pixels.
-	int nBeginY;
-	int nEndY;
-
 	m_diffBlocks.clear();
 
-	const int nDiffs = m_pMergeDoc->m_diffList.GetSize();
-	if (nDiffs > 0)
-		m_diffBlocks.reserve(nDiffs); // Pre-allocate space for the list.
-
 	int nDiff = m_pMergeDoc->m_diffList.FirstSignificantDiff();
 	while (nDiff != -1)
 	{
-		const DIFFRANGE *diff = m_pMergeDoc->m_diffList.DiffRangeAt(nDiff);
-
-		CMergeEditView *pView = m_pMergeDoc->GetLeftView();
-
-		DiffBlock block;
-		//there are no blanks on both side
-		if ((diff->blank0 == 0) && (diff->blank1 == 0))
+		DiffBlock blocks[2];
+		const int nBlocks = CalculateDiffBlocks(nDiff, blocks);
+		for (int i = 0; i < nBlocks; ++i)
 		{
-			CalculateBlocksPixel(
-				pView->GetSubLineIndex(diff->dbegin0),
-				pView->GetSubLineIndex(diff->dend0),
-				pView->GetSubLines(diff->dend0), nBeginY, nEndY);
-
-			block.top_line = diff->dbegin0;
-			block.bottom_line = diff->dend0;
-			block.top_coord = nBeginY;
-			block.bottom_coord = nEndY;
-			block.diff_index = nDiff;
-			m_diffBlocks.push_back(block);
-		}
-		//side0 has blank lines?
-		else if (diff->blank0 > 0)
-		{
-			//Is there a common block on side0?
-			if ((int)diff->dbegin0 < diff->blank0)
-			{
-				CalculateBlocksPixel(
-					pView->GetSubLineIndex(diff->dbegin0),
-					pView->GetSubLineIndex(diff->blank0 - 1),
-					pView->GetSubLines(diff->blank0 - 1), nBeginY, nEndY);
-
-				block.top_line = diff->dbegin0;
-				block.bottom_line = diff->blank0 - 1;
-				block.top_coord = nBeginY;
-				block.bottom_coord = nEndY;
-				block.diff_index = nDiff;
-				m_diffBlocks.push_back(block);
-			}
-
-			// Now the block for blank lines side0!
-			CalculateBlocksPixel(
-				pView->GetSubLineIndex(diff->blank0),
-				pView->GetSubLineIndex(diff->dend1),
-				pView->GetSubLines(diff->dend1), nBeginY, nEndY);
-
-			block.top_line = diff->blank0;
-			block.bottom_line = diff->dend1;
-			block.top_coord = nBeginY;
-			block.bottom_coord = nEndY;
-			block.diff_index = nDiff;
-			m_diffBlocks.push_back(block);
-		}
-		//side1 has blank lines?
-		else
-		{
-			// Is there a common block on side1?
-			if ((int)diff->dbegin0 < diff->blank1)
+			const DiffBlock &block = blocks[i];
+			if (m_diffBlocks.empty() || m_diffBlocks.back().bottom_coord != block.bottom_coord)
 			{
-				CalculateBlocksPixel(
-					pView->GetSubLineIndex(diff->dbegin0),
-					pView->GetSubLineIndex(diff->blank1 - 1),
-					pView->GetSubLines(diff->blank1 - 1), nBeginY, nEndY);
-
-				block.top_line = diff->dbegin0;
-				block.bottom_line = diff->blank1 - 1;
-				block.top_coord = nBeginY;
-				block.bottom_coord = nEndY;
-				block.diff_index = nDiff;
+				// Optimize memory allocation
+				if (m_diffBlocks.capacity() == m_diffBlocks.size())
+					m_diffBlocks.reserve(m_diffBlocks.size() ? m_diffBlocks.size() * 2 : 256);
 				m_diffBlocks.push_back(block);
 			}
-
-			// Now the block for blank lines side1!
-			CalculateBlocksPixel(
-				pView->GetSubLineIndex(diff->blank1),
-				pView->GetSubLineIndex(diff->dend0),
-				pView->GetSubLines(diff->dend0), nBeginY, nEndY);
-
-			block.top_line = diff->blank1;
-			block.bottom_line = diff->dend0;
-			block.top_coord = nBeginY;
-			block.bottom_coord = nEndY;
-			block.diff_index = nDiff;
-			m_diffBlocks.push_back(block);
 		}
-
 		nDiff = m_pMergeDoc->m_diffList.NextSignificantDiff(nDiff);
 	}
+	m_blocksLineInPix = m_lineInPix;
 	m_bRecalculateBlocks = false;
 }
 
+/**
+ * @brief Calculate the blocks which depict a difference.
+ * A difference with blank lines on one side takes two blocks, one for the
+ * lines common to both sides and one for the blank lines.
+ * @param [in] nDiff Index of the difference in the difference list.
+ * @param [out] blocks Receives the blocks.
+ * @return Number of blocks.
+ */
+int CLocationView::CalculateDiffBlocks(int nDiff, DiffBlock blocks[2])
+{
+	const DIFFRANGE *diff = m_pMergeDoc->m_diffList.DiffRangeAt(nDiff);
+	//there are no blanks on both side
+	if ((diff->blank0 == 0) && (diff->blank1 == 0))
+	{
+		CalculateDiffBlock(blocks[0], diff->dbegin0, diff->dend0, nDiff);
+		return 1;
+	}
+	int nBlank;
+	int nEnd;
+	//side0 has blank lines?
+	if (diff->blank0 > 0)
+	{
+		nBlank = diff->blank0;
+		nEnd = diff->dend1;
+	}
+	//side1 has blank lines?
+	else
+	{
+		nBlank = diff->blank1;
+		nEnd = diff->dend0;
+	}
+	int nBlocks = 0;
+	//Is there a common block?
+	if ((int)diff->dbegin0 < nBlank)
+		CalculateDiffBlock(blocks[nBlocks++], diff->dbegin0, nBlank - 1, nDiff);
+	// Now the block for blank lines!
+	CalculateDiffBlock(blocks[nBlocks++], nBlank, nEnd, nDiff);
+	return nBlocks;
+}
+
+/**
+ * @brief Calculate the coordinates of a block.
+ * @param [out] block Receives the block.
+ * @param [in] nTopLine First line of the block.
+ * @param [in] nBottomLine Last line of the block.
+ * @param [in] nDiff Index of the difference in the difference list.
+ */
+void CLocationView::CalculateDiffBlock(DiffBlock &block, int nTopLine, int nBottomLine, int nDiff)
+{
+	CMergeEditView *const pView = m_pMergeDoc->GetLeftView();
+	// lineposition in pixels.
+	int nBeginY;
+	int nEndY;
+	CalculateBlocksPixel(
+		pView->GetSubLineIndex(nTopLine),
+		pView->GetSubLineIndex(nBottomLine),
+		pView->GetSubLines(nBottomLine), nBeginY, nEndY);
+	block.top_line = nTopLine;
+	block.bottom_line = nBottomLine;
+	block.top_coord = nBeginY;
+	block.bottom_coord = nEndY;
+	block.diff_index = nDiff;
+}
+
 /**
  * @brief Calculate Blocksize to pixel.
  * @param [in] nBlockStart line where block starts
@@ -90,8 +90,12 @@ protected:
 	void DrawDiffMarker(HSurface *, int yCoord);
 	void CalculateBars();
 	void CalculateBlocks();
+	int CalculateDiffBlocks(int nDiff, DiffBlock blocks[2]);
+	void CalculateDiffBlock(DiffBlock &, int nTopLine, int nBottomLine, int nDiff);
 	void CalculateBlocksPixel(int nBlockStart, int nBlockEnd, int nBlockLength,
 			int &nBeginY, int &nEndY);
+	void DrawDiffBlock(HSurface *, const DiffBlock &, BOOL bSelected);
+	void AddMovedLine(const DiffBlock &, BOOL bFromLeft, BOOL bFromRight);
 	void DrawBackground(HSurface *);
 
 private:
@@ -106,6 +110,7 @@ private:
 	MOVEDLINE_LIST m_movedLines; //*< List of moved block connecting lines */
 	HBitmap *m_pSavedBackgroundBitmap; //*< Saved background */
 	std::vector<DiffBlock> m_diffBlocks; //*< List of pre-calculated diff blocks.
+	double m_blocksLineInPix; //*< Value of m_lineInPix for m_diffBlocks.
 	bool m_bRecalculateBlocks; //*< Recalculate diff blocks in next repaint.
 
 	// Generated message map functions
@@ -2078,7 +2078,13 @@ bool CMainFrame::DoFileOpen(
 			// Handle archives using 7-zip
 			if (dwLeftFlags & dwRightFlags & FFILEOPEN_DETECTZIP)
 			{
-				if (Merge7z::Format *piHandler = ArchiveGuessFormat(filelocLeft.filepath.c_str()))
+				// Try to extract only the entries which differ by their stored
+				// metadata, so that entries which are identical remain deferred
+				pTempPathContext = CTempPathContext::ExtractDifferences(
+					m_hWnd, filelocLeft.filepath, filelocRight.filepath);
+				Merge7z::Format *piHandler;
+				if (pTempPathContext == NULL &&
+					(piHandler = ArchiveGuessFormat(filelocLeft.filepath.c_str())) != NULL)
 				{
 					pTempPathContext = new CTempPathContext;
 					String path = GetClearTempPath(pTempPathContext, _T("0"));
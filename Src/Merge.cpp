@@ -34,6 +34,7 @@
 #include "coretools.h"
 #include "paths.h"
 #include "LanguageSelect.h"
+#include "BatchCompare.h"
 #include "editlib/modeline-parser.h"
 
 // For shutdown cleanup
@@ -120,6 +121,7 @@ CMergeApp::CMergeApp()
 : m_hInstance(NULL)
 , m_pMainWnd(NULL)
 , m_bNonInteractive(false)
+, m_nExitCode(0)
 , m_nActiveOperations(0)
 {
 	_set_new_handler(reinterpret_cast<_PNH>(die));
@@ -185,8 +187,8 @@ HRESULT CMergeApp::InitInstance()
 	const HANDLE hMutex = CreateMutex(NULL, FALSE, szMutexName);
 	const DWORD dwMutex = GetLastError();
 
-	if (hMutex)
-		WaitForSingleObject(hMutex, INFINITE);
+	bool bOwnMutex = hMutex != NULL &&
+		WaitForSingleObject(hMutex, INFINITE) != WAIT_FAILED;
 
 	HRESULT hr = E_FAIL;
 	try
@@ -222,7 +224,27 @@ HRESULT CMergeApp::InitInstance()
 		// If cmdInfo.m_invocationMode equals InvocationModeMergeTool, then
 		// ClearCase waits for the process to produce an output file and
 		// terminate, in which case single instance logic is not applicable.
-		if (dwMutex == ERROR_ALREADY_EXISTS && cmdInfo.m_nSingleInstance != 0 &&
+		if (!cmdInfo.m_sBatchOutput.empty() || !cmdInfo.m_sPatchOutput.empty())
+		{
+			// Compare folders without UI, and exit with the result.
+			// Other instances need not wait for this to complete.
+			if (bOwnMutex)
+				ReleaseMutex(hMutex);
+			bOwnMutex = false;
+			m_bNonInteractive = true;
+			// Should anything throw from here on, exit with ExitError,
+			// since the 1 of a failure would read as ExitDifferent.
+			m_nExitCode = BatchCompare::ExitError;
+			CleanupWMtemp();
+			hCharsets = LoadLibraryEx(_T("character-sets.dll"), NULL, LOAD_LIBRARY_AS_DATAFILE);
+			InitializeSupplements();
+			BatchCompare batch(cmdInfo);
+			int const nExitCode = batch.Run();
+			ClearTempfolder(env_GetTempPath());
+			m_nExitCode = nExitCode;
+			hr = S_FALSE;
+		}
+		else if (dwMutex == ERROR_ALREADY_EXISTS && cmdInfo.m_nSingleInstance != 0 &&
 			(cmdInfo.m_nSingleInstance == 1 || COptionsMgr::Get(OPT_SINGLE_INSTANCE)))
 		{
 			// Send commandline to previous instance
@@ -295,7 +317,7 @@ HRESULT CMergeApp::InitInstance()
 		delete e;
 	}
 
-	if (hMutex)
+	if (bOwnMutex)
 		ReleaseMutex(hMutex);
 
 	return hr;
@@ -325,7 +347,8 @@ int CMergeApp::ExitInstance(HRESULT hr)
 	// Stay balanced
 	OleUninitialize();
 	CoUninitialize();
-	return FAILED(hr);
+	// A batch compare leaves ExitError in m_nExitCode when it fails
+	return m_nExitCode != 0 ? m_nExitCode : FAILED(hr);
 }
 
 int CMergeApp::DoMessageBox(LPCTSTR lpszPrompt, UINT nType, UINT nIDPrompt)
@@ -62,6 +62,7 @@ public:
 	HINSTANCE m_hInstance;
 	CMainFrame *m_pMainWnd;
 	bool m_bNonInteractive;
+	int m_nExitCode; /**< Exit code when not running the message loop. */
 
 	static String GetDefaultEditor();
 	static String GetDefaultSupplementFolder();
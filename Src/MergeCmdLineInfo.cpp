@@ -110,6 +110,7 @@ MergeCmdLineInfo::MergeCmdLineInfo(LPCTSTR q):
 	m_nRecursive(0),
 	m_nCompMethod(-1),
 	m_bNonInteractive(false),
+	m_nBatchFormat(BatchFormatJsonLines),
 	m_nSingleInstance(-1),
 	m_bShowUsage(false),
 	m_nCodepage(0),
@@ -245,6 +246,12 @@ static const TCHAR WordListYesNo[]
 	_T("1;yes;true\0")
 );
 
+static const TCHAR WordListBatchFormat[]
+(
+	_T("0;jsonl;json\0")
+	_T("1;csv\0")
+);
+
 static LPCTSTR FindInWordList(LPCTSTR p, LPCTSTR q)
 {
 	while (int n = lstrlen(q))
@@ -382,6 +389,28 @@ void MergeCmdLineInfo::ParseWinMergeCmdLine(LPCTSTR q)
 			// -noninteractive to suppress message boxes & close with result code
 			m_bNonInteractive = true;
 		}
+		else if (param == _T("batch"))
+		{
+			// -batch[:jsonl|:csv] "path" to compare folders without UI and
+			// stream results to path ("-" for stdout)
+			if (*q == ':')
+			{
+				q = EatParam(q, param);
+				if (LPCTSTR match = FindInWordList(param.c_str() + 1, WordListBatchFormat))
+				{
+					m_nBatchFormat = static_cast<BatchFormat>(_ttol(match));
+				}
+			}
+			q = EatParam(q, m_sBatchOutput);
+			m_bNonInteractive = true;
+		}
+		else if (param == _T("patch"))
+		{
+			// -patch "path" to compare folders without UI and write a patch
+			// of the differing files to path
+			q = EatParam(q, m_sPatchOutput);
+			m_bNonInteractive = true;
+		}
 		else if (param == _T("noprefs"))
 		{
 			// -noprefs means do not load or remember options (preferences)
@@ -52,6 +52,12 @@ public:
 		InvocationModeMergeTool /**< WinMerge is executed as an external Rational ClearCase merge tool. */
 	} m_invocationMode;
 
+	enum BatchFormat
+	{
+		BatchFormatJsonLines, /**< One JSON object per line. */
+		BatchFormatCsv /**< Comma separated values with a header line. */
+	} m_nBatchFormat; /**< Format of headless folder compare results. */
+
 	int m_nSingleInstance; /**< Allow only one instance of WinMerge executable. */
 	int m_nCmdShow; /**< Initial state of the application's window. */
 	int m_nRecursive; /**< Include sub folder in directories compare. */
@@ -70,6 +76,8 @@ public:
 	String m_sContentType; /**< Content type. */
 	String m_sRunScript; /**< Run this script in the context of the document. */
 	String m_sOptionChars; /**< Set of accepted option indicators. */
+	String m_sBatchOutput; /**< Where to stream headless folder compare results ("-" for stdout). */
+	String m_sPatchOutput; /**< Where to write a patch of differing files found by headless folder compare. */
 	String m_sConfigFileName; /**< Where to persist application settings when not using the registry. */
 
 	std::vector<String> m_Files; /**< Files (or directories) to compare. */
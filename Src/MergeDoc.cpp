@@ -1223,6 +1223,12 @@ void CChildFrame::FlushAndRescan()
 	m_pDetailView[0]->SetViewLineNumbers(bLineNumberDigits);
 	m_pDetailView[1]->SetViewLineNumbers(bLineNumberDigits);
 
+	// Word diff highlights depend on both panes, so drop all cached color runs
+	m_pView[0]->InvalidateRenderCache();
+	m_pView[1]->InvalidateRenderCache();
+	m_pDetailView[0]->InvalidateRenderCache();
+	m_pDetailView[1]->InvalidateRenderCache();
+
 	// Refresh display
 	UpdateAllViews();
 	UpdateCmdUI();
@@ -2070,6 +2076,11 @@ void CChildFrame::RefreshOptions()
 	m_pView[1]->RefreshOptions();
 	m_pDetailView[0]->RefreshOptions();
 	m_pDetailView[1]->RefreshOptions();
+	// Word diff highlights depend on options, so drop all cached color runs
+	m_pView[0]->InvalidateRenderCache();
+	m_pView[1]->InvalidateRenderCache();
+	m_pDetailView[0]->InvalidateRenderCache();
+	m_pDetailView[1]->InvalidateRenderCache();
 }
 
 /**
@@ -1052,16 +1052,50 @@ int CMergeEditView::GetEmptySubLines(int nLineIndex)
 }
 
 /**
- * @brief Invalidate sub line index cache from the specified index to the end of file.
- * @param [in] nLineIndex Index of the first line to invalidate
+ * @brief Estimate the number of sublines of a line, including empty ones.
+ * Both panes take the larger of their estimates, so that they agree on the
+ * sublines of lines which have not been wrapped yet.
  */
-void CMergeEditView::InvalidateSubLineIndexCache(int nLineIndex)
+int CMergeEditView::EstimateSubLines(int nLineIndex)
+{
+	int nSubLines = 1;
+	for (int nPane = 0; nPane < 2; nPane++)
+	{
+		CMergeEditView *const pView = m_pDocument->GetView(nPane);
+		if (pView && nLineIndex < pView->GetLineCount())
+			nSubLines = max(nSubLines, pView->CGhostTextView::EstimateSubLines(nLineIndex));
+	}
+	return nSubLines;
+}
+
+/**
+ * @brief Record the exact number of sublines of a line in both panes, as
+ * the empty sublines make them the same.
+ */
+int CMergeEditView::UpdateSubLineCount(int nLineIndex, int nSubLines)
+{
+	if (CMergeEditView *const pView = m_pDocument->GetView(1 - m_nThisPane))
+	{
+		int const nDelta = pView->CGhostTextView::UpdateSubLineCount(nLineIndex, nSubLines);
+		// keep the same line at the top of the other pane
+		if (nLineIndex < pView->m_nTopLine)
+			pView->m_nTopSubLine += nDelta;
+	}
+	return CGhostTextView::UpdateSubLineCount(nLineIndex, nSubLines);
+}
+
+/**
+ * @brief Invalidate sub line counts of the specified range of lines.
+ * @param [in] nLineIndex1 Index of the first line to invalidate
+ * @param [in] nLineIndex2 Index of the last line to invalidate, or -1
+ */
+void CMergeEditView::InvalidateSubLineIndexCache(int nLineIndex1, int nLineIndex2)
 {
     // We have to invalidate sub line index cache on both panes.
 	for (int nPane = 0; nPane < 2; nPane++)
 	{
 		if (CMergeEditView *pView = m_pDocument->GetView(nPane))
-			pView->CCrystalTextView::InvalidateSubLineIndexCache(nLineIndex);
+			pView->CCrystalTextView::InvalidateSubLineIndexCache(nLineIndex1, nLineIndex2);
 	}
 }
 
@@ -101,7 +101,9 @@ public:
 	int GetTopLine() const { return m_nTopLine; }
 	int GetTopSubLine() const { return m_nTopSubLine; }
 	virtual int GetEmptySubLines(int nLineIndex);
-	virtual void InvalidateSubLineIndexCache(int nLineIndex);
+	virtual int EstimateSubLines(int nLineIndex);
+	virtual int UpdateSubLineCount(int nLineIndex, int nSubLines);
+	virtual void InvalidateSubLineIndexCache(int nLineIndex1, int nLineIndex2);
 	void DocumentsLoaded();
 
 	void OnCurdiff();
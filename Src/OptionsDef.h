@@ -211,6 +211,8 @@ extern COptionDef
 <bool> OPT_VIEW_RULER inline((_T("Settings/ViewRuler"), false));
 extern COptionDef
 <bool> OPT_MERGEEDITVIEW_ENABLE_SHELL_CONTEXT_MENU inline((_T("Settings/MergeEditViewEnableShellContextMenu"), false));
+extern COptionDef
+<UINT> OPT_UNDO_MEMORY_LIMIT inline((_T("Settings/UndoMemoryLimit"), 64 * 1024 * 1024));
 
 extern COptionDef
 <bool> OPT_AUTOMATIC_BPL inline((_T("Settings/AutomaticBPL"), true));
@@ -382,6 +384,8 @@ extern COptionDef
 extern COptionDef
 <bool> OPT_CMP_CACHE_RESULTS inline((_T("Settings/CacheResults"), true));
 extern COptionDef
+<bool> OPT_CMP_WATCH_FOLDERS inline((_T("Settings/WatchFolders"), false));
+extern COptionDef
 <int> OPT_CMP_DIFF_ALGORITHM inline((_T("Settings/DiffAlgorithm"), 0));
 extern COptionDef
 <bool> OPT_CMP_INDENT_HEURISTIC inline((_T("Settings/IndentHeuristic"), true));
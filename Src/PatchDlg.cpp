@@ -488,11 +488,6 @@ void CPatchDlg::ClearItems()
  */
 void CPatchDlg::UpdateSettings()
 {
-	// Check value ranges
-	if (m_outputStyle < OUTPUT_NORMAL || m_outputStyle > OUTPUT_UNIFIED)
-		m_outputStyle = OUTPUT_NORMAL;
-	if (m_contextLines < 0 || m_contextLines > 50)
-		m_contextLines = 3;
 	m_ignoreTabExpansion = (m_whitespaceCompare & WHITESPACE_IGNORE_TAB_EXPANSION) != 0;
 	m_ignoreTrailingSpace = (m_whitespaceCompare & WHITESPACE_IGNORE_TRAILING_SPACE) != 0;
 	m_whitespaceCompare &= WHITESPACE_RADIO_OPTIONS_MASK;
@@ -507,9 +502,10 @@ void CPatchDlg::UpdateSettings()
 }
 
 /**
- * @brief Loads patch dialog settings from registry.
+ * @brief Reads patch settings from registry without touching any controls.
+ * Headless patch creation uses the settings as they were last confirmed.
  */
-void CPatchDlg::LoadSettings()
+void CPatchDlg::ReadSettings()
 {
 	if (CRegKeyEx key = SettingStore.GetSectionKey(_T("PatchCreator")))
 	{
@@ -523,6 +519,19 @@ void CPatchDlg::LoadSettings()
 		m_includeCmdLine = key.ReadDword(_T("IncludeCmdLine"), FALSE);
 		m_useGenericPaths = key.ReadDword(_T("UseGenericPaths"), FALSE);
 	}
+	// Check value ranges
+	if (m_outputStyle < OUTPUT_NORMAL || m_outputStyle > OUTPUT_UNIFIED)
+		m_outputStyle = OUTPUT_NORMAL;
+	if (m_contextLines < 0 || m_contextLines > 50)
+		m_contextLines = 3;
+}
+
+/**
+ * @brief Loads patch dialog settings from registry.
+ */
+void CPatchDlg::LoadSettings()
+{
+	ReadSettings();
 	UpdateSettings();
 }
 
@@ -45,6 +45,7 @@ public:
 	int GetItemCount();
 	const PATCHFILES& GetItemAt(int position);
 	void ClearItems();
+	void ReadSettings();
 
 // Dialog Data
 	BOOL m_ignoreCase;
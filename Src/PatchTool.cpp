@@ -19,6 +19,7 @@
  * @brief Code file routines
  */
 #include "StdAfx.h"
+#include <io.h>
 #include "Merge.h"
 #include "MainFrm.h"
 #include "LanguageSelect.h"
@@ -26,6 +27,7 @@
 #include "common/coretools.h"
 #include "PatchTool.h"
 #include "paths.h"
+#include "Environment.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -65,6 +67,33 @@ void CPatchTool::AddFiles(const PATCHFILES &files)
 	m_dlgPatch.AddItem(files);
 }
 
+/**
+ * @brief Set up options from the dialog's settings.
+ */
+void CPatchTool::InitDiffWrapper()
+{
+	// Initialize from global settings, then refine from user input
+	m_diffWrapper.RefreshOptions();
+
+	// These two are from dropdown list - can't be wrong
+	m_diffWrapper.outputStyle = m_dlgPatch.m_outputStyle;
+	m_diffWrapper.nContext = m_dlgPatch.m_contextLines;
+	// Checkbox - can't be wrong
+	m_diffWrapper.bAddCommandline = m_dlgPatch.m_includeCmdLine != FALSE;
+	m_diffWrapper.bOmitTimestamps = m_dlgPatch.m_useGenericPaths == BST_INDETERMINATE;
+	m_diffWrapper.bAppendFiles = m_dlgPatch.m_appendFile != FALSE;
+
+	// These are from checkboxes and radiobuttons - can't be wrong
+	m_diffWrapper.nIgnoreWhitespace = m_dlgPatch.m_whitespaceCompare;
+	m_diffWrapper.bIgnoreBlankLines = m_dlgPatch.m_ignoreBlankLines != FALSE;
+	// Use this because non-sensitive setting can't write
+	// patch file EOLs correctly
+	m_diffWrapper.bIgnoreEol = false;
+	m_diffWrapper.bIgnoreCase = m_dlgPatch.m_ignoreCase != FALSE;
+	m_diffWrapper.bFilterCommentsLines = false;
+	m_diffWrapper.bApplyLineFilters = m_dlgPatch.m_applyLineFilters != FALSE;
+}
+
 /**
  * @brief Create a patch from files given.
  * @note Files can be given using AddFiles() or selecting using CPatchDlg.
@@ -73,27 +102,7 @@ void CPatchTool::Run()
 {
 	if (LanguageSelect.DoModal(m_dlgPatch) == IDOK)
 	{
-		// Initialize from global settings, then refine from user input
-		m_diffWrapper.RefreshOptions();
-
-		// These two are from dropdown list - can't be wrong
-		m_diffWrapper.outputStyle = m_dlgPatch.m_outputStyle;
-		m_diffWrapper.nContext = m_dlgPatch.m_contextLines;
-		// Checkbox - can't be wrong
-		m_diffWrapper.bAddCommandline = m_dlgPatch.m_includeCmdLine != FALSE;
-		m_diffWrapper.bOmitTimestamps = m_dlgPatch.m_useGenericPaths == BST_INDETERMINATE;
-		m_diffWrapper.bAppendFiles = m_dlgPatch.m_appendFile != FALSE;
-
-		// These are from checkboxes and radiobuttons - can't be wrong
-		m_diffWrapper.nIgnoreWhitespace = m_dlgPatch.m_whitespaceCompare;
-		m_diffWrapper.bIgnoreBlankLines = m_dlgPatch.m_ignoreBlankLines != FALSE;
-		// Use this because non-sensitive setting can't write
-		// patch file EOLs correctly
-		m_diffWrapper.bIgnoreEol = false;
-		m_diffWrapper.bIgnoreCase = m_dlgPatch.m_ignoreCase != FALSE;
-		m_diffWrapper.bFilterCommentsLines = false;
-		m_diffWrapper.bApplyLineFilters = m_dlgPatch.m_applyLineFilters != FALSE;;
-		m_diffWrapper.RefreshFilters();
+		InitDiffWrapper();
 
 		if (!paths_CreateIfNeeded(m_dlgPatch.m_fileResult.c_str(), true))
 		{
@@ -101,52 +110,238 @@ void CPatchTool::Run()
 			return;
 		}
 
-		// Select patch create -mode
-		m_diffWrapper.SetCreatePatchFile(m_dlgPatch.m_fileResult);
-
-		String const altPath1 = &_T("a")[m_dlgPatch.m_useGenericPaths == BST_UNCHECKED];
-		String const altPath2 = &_T("b")[m_dlgPatch.m_useGenericPaths == BST_UNCHECKED];
-		int const fileCount = m_dlgPatch.GetItemCount();
-		int index = 0;
-		while (index < fileCount)
+		switch (UINT const idsError = CreatePatch())
 		{
-			PATCHFILES const &files = m_dlgPatch.GetItemAt(index);
-			// Set up DiffWrapper
-			m_diffWrapper.SetPaths(files.lfile, files.rfile);
-			if (m_dlgPatch.m_useGenericPaths != BST_UNCHECKED)
-				m_diffWrapper.SetAlternativePaths(altPath1, altPath2, true);
-			else
-				m_diffWrapper.SetAlternativePaths(files.pathLeft, files.pathRight);
-			m_diffWrapper.SetCompareFiles(files.lfile, files.rfile);
-			if (!m_diffWrapper.RunFileDiff())
+		case 0:
+			LanguageSelect.MsgBox(IDS_DIFF_SUCCEEDED, MB_ICONINFORMATION|MB_DONT_DISPLAY_AGAIN);
+			if (m_dlgPatch.m_openToEditor)
 			{
-				LanguageSelect.MsgBox(IDS_FILEERROR, MB_ICONSTOP);
-				break;
+				CMainFrame::OpenFileToExternalEditor(m_dlgPatch.m_fileResult.c_str());
 			}
-			if (m_diffWrapper.m_status.bBinaries)
+			break;
+		case IDS_FILEWRITE_ERROR:
+			LanguageSelect.FormatStrings(
+				IDS_FILEWRITE_ERROR, m_dlgPatch.m_fileResult.c_str()
+			).MsgBox(MB_ICONSTOP);
+			break;
+		default:
+			LanguageSelect.MsgBox(idsError, MB_ICONSTOP);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Create a patch from files given, without any UI.
+ * Uses the settings which were last confirmed in the dialog.
+ * @param [in] patchfile Path to the patch file to create.
+ * @return Error message, or empty string on success.
+ */
+String CPatchTool::RunHeadless(LPCTSTR patchfile)
+{
+	m_dlgPatch.ReadSettings();
+	m_dlgPatch.m_fileResult = patchfile;
+	m_dlgPatch.m_appendFile = FALSE;
+	InitDiffWrapper();
+
+	if (!paths_CreateIfNeeded(patchfile, true))
+		return LanguageSelect.LoadString(IDS_FOLDER_NOTEXIST);
+
+	String msg;
+	switch (UINT const idsError = CreatePatch())
+	{
+	case 0:
+		break;
+	case IDS_FILEWRITE_ERROR:
+		msg = LanguageSelect.FormatStrings(IDS_FILEWRITE_ERROR, patchfile);
+		break;
+	default:
+		msg = LanguageSelect.LoadString(idsError);
+		if (m_iFailedItem < m_nItems)
+		{
+			const PATCHFILES &files = m_dlgPatch.GetItemAt(m_iFailedItem);
+			msg += string_format(_T("\n%s\n%s"), files.lfile.c_str(), files.rfile.c_str());
+		}
+		break;
+	}
+	return msg;
+}
+
+/**
+ * @brief Diff all items, and write their patches in order.
+ * Stops at the first item which fails, like a serial run would.
+ * @return 0 on success, or ID of message telling what went wrong.
+ */
+UINT CPatchTool::CreatePatch()
+{
+	m_pOutput = NULL;
+	m_lcid = GetThreadLocale();
+	m_nItems = m_dlgPatch.GetItemCount();
+	m_nNextItem = -1;
+	m_nWrittenItems = 0;
+	m_iFailedItem = m_nItems;
+	m_idsError = 0;
+	m_rgTurnEvents.clear();
+	m_rgTurnEvents.resize(m_nItems);
+
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	UINT const nThreads = max<UINT>(min<UINT>(si.dwNumberOfProcessors, MAX_THREADS), 1);
+	// Caller's thread takes part, so start helpers only for extra items
+	HANDLE rgThreads[MAX_THREADS];
+	DWORD nHelpers = 0;
+	while (nHelpers + 1 < nThreads && static_cast<LONG>(nHelpers + 1) < m_nItems)
+	{
+		HANDLE const hThread = BeginThreadEx(NULL, 0,
+			OException::ThreadProc<CPatchTool, &CPatchTool::PatchThread>,
+			this, 0, NULL);
+		if (hThread == NULL)
+			break;
+		rgThreads[nHelpers++] = hThread;
+	}
+	DiffItems();
+	if (nHelpers != 0)
+	{
+		WaitForMultipleObjects(nHelpers, rgThreads, TRUE, INFINITE);
+		do
+		{
+			CloseHandle(rgThreads[--nHelpers]);
+		} while (nHelpers != 0);
+	}
+
+	if (m_pOutput != NULL)
+	{
+		bool const bFailed = ferror(m_pOutput) != 0;
+		if ((fclose(m_pOutput) != 0 || bFailed) && m_idsError == 0)
+			m_idsError = IDS_FILEWRITE_ERROR;
+		m_pOutput = NULL;
+	}
+	return m_idsError;
+}
+
+/**
+ * @brief Helper thread function.
+ */
+DWORD CPatchTool::PatchThread()
+{
+	SetThreadLocale(m_lcid);
+	DiffItems();
+	return 0;
+}
+
+/**
+ * @brief Diff items until none are left, and write each one on its turn.
+ */
+void CPatchTool::DiffItems()
+{
+	CDiffWrapper diffWrapper;
+	static_cast<DIFFOPTIONS &>(diffWrapper) = m_diffWrapper;
+	static_cast<PATCHOPTIONS &>(diffWrapper) = m_diffWrapper;
+	diffWrapper.RefreshFilters();
+	// The patch threads already keep the processors busy
+	diffWrapper.SetDiffThreads(1);
+	// Write in binary mode, so that EOLs get translated only once, when
+	// copying to the patch file, which is opened in text mode as it was
+	// when the patch was written to it directly.
+	String const path = env_GetTempFileName(env_GetTempPath().c_str(), _T("PT"));
+	FILE *const stream = path.empty() ? NULL : _tfopen(path.c_str(), _T("w+bTD"));
+	diffWrapper.SetCreatePatchFile(stream);
+	HANDLE const hTurn = CreateEvent(NULL, FALSE, FALSE, NULL);
+	LONG i;
+	while (m_iFailedItem == m_nItems && (i = InterlockedIncrement(&m_nNextItem)) < m_nItems)
+	{
+		// Publish the event before reading m_nWrittenItems below
+		InterlockedExchangePointer(&m_rgTurnEvents[i], hTurn);
+		UINT idsError = IDS_FILEWRITE_ERROR;
+		if (stream != NULL && hTurn != NULL)
+		{
+			try
 			{
-				LanguageSelect.MsgBox(IDS_CANNOT_CREATE_BINARYPATCH, MB_ICONSTOP);
-				break;
+				idsError = DiffItem(diffWrapper, m_dlgPatch.GetItemAt(i));
 			}
-			if (m_diffWrapper.m_status.bPatchFileFailed)
+			catch (OException *e)
 			{
-				LanguageSelect.FormatStrings(
-					IDS_FILEWRITE_ERROR, m_dlgPatch.m_fileResult.c_str()
-				).MsgBox(MB_ICONSTOP);
-				break;
+				delete e;
+				idsError = IDS_FILEERROR;
 			}
-			// Append next files...
-			m_diffWrapper.bAppendFiles = true;
-			++index;
 		}
+		while (m_nWrittenItems != i)
+			WaitForSingleObject(hTurn, INFINITE);
+		WriteItem(i, idsError, stream);
+	}
+	if (hTurn != NULL)
+		CloseHandle(hTurn);
+	if (stream != NULL)
+		fclose(stream);
+}
 
-		if (index == fileCount)
+/**
+ * @brief Diff one item into the DiffWrapper's stream.
+ * @return 0 on success, or ID of message telling what went wrong.
+ */
+UINT CPatchTool::DiffItem(CDiffWrapper &diffWrapper, const PATCHFILES &files) const
+{
+	// Set up DiffWrapper
+	diffWrapper.SetPaths(files.lfile, files.rfile);
+	if (m_dlgPatch.m_useGenericPaths != BST_UNCHECKED)
+		diffWrapper.SetAlternativePaths(String(_T("a")), String(_T("b")), true);
+	else
+		diffWrapper.SetAlternativePaths(files.pathLeft, files.pathRight);
+	diffWrapper.SetCompareFiles(files.lfile, files.rfile);
+	if (!diffWrapper.RunFileDiff())
+		return IDS_FILEERROR;
+	if (diffWrapper.m_status.bBinaries)
+		return IDS_CANNOT_CREATE_BINARYPATCH;
+	if (diffWrapper.m_status.bPatchFileFailed)
+		return IDS_FILEWRITE_ERROR;
+	return 0;
+}
+
+/**
+ * @brief Append an item's patch to the patch file, and pass the turn on.
+ * Called on the item's turn only, so no two threads get here at once.
+ * @param [in] i Index of item.
+ * @param [in] idsError Result of DiffItem().
+ * @param [in] stream Stream which holds the item's patch.
+ */
+void CPatchTool::WriteItem(LONG i, UINT idsError, FILE *stream)
+{
+	// Once an item has failed, later items are not written
+	if (m_iFailedItem == m_nItems && idsError == 0)
+	{
+		if (m_pOutput == NULL)
 		{
-			LanguageSelect.MsgBox(IDS_DIFF_SUCCEEDED, MB_ICONINFORMATION|MB_DONT_DISPLAY_AGAIN);
-			if (m_dlgPatch.m_openToEditor)
-			{
-				CMainFrame::OpenFileToExternalEditor(m_dlgPatch.m_fileResult.c_str());
-			}
+			m_pOutput = _tfopen(m_dlgPatch.m_fileResult.c_str(),
+				m_diffWrapper.bAppendFiles ? _T("a") : _T("w"));
+			if (m_pOutput != NULL)
+				setvbuf(m_pOutput, NULL, _IOFBF, 64 * 1024);
+		}
+		if (m_pOutput != NULL)
+		{
+			char buffer[64 * 1024];
+			rewind(stream);
+			while (size_t const cb = fread(buffer, 1, sizeof buffer, stream))
+				fwrite(buffer, 1, cb, m_pOutput);
 		}
+		if (m_pOutput == NULL || ferror(m_pOutput) || ferror(stream))
+			idsError = IDS_FILEWRITE_ERROR;
+	}
+	if (idsError != 0 && m_iFailedItem == m_nItems)
+	{
+		m_idsError = idsError;
+		m_iFailedItem = i;
+	}
+	if (stream != NULL)
+	{
+		rewind(stream);
+		_chsize(_fileno(stream), 0);
+	}
+	InterlockedIncrement(&m_nWrittenItems);
+	if (i + 1 < m_nItems)
+	{
+		// The next item may not have been claimed yet, in which case its
+		// thread will see m_nWrittenItems before waiting for its turn.
+		if (HANDLE const hTurn = InterlockedCompareExchangePointer(&m_rgTurnEvents[i + 1], NULL, NULL))
+			SetEvent(hTurn);
 	}
 }
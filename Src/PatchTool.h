@@ -49,6 +49,11 @@ struct PATCHFILES
  * This class is used to create patch files. The files to patch can be added
  * to list before calling CreatePatch(). Or user can select files in the
  * the dialog that CreatePatch() shows.
+ *
+ * File pairs are diffed on a pool of threads, each with its own DiffWrapper
+ * and its own temporary stream. A thread whose pair is done waits for its
+ * turn, and then appends its stream to the patch file, so the patch file
+ * comes out the same as if the pairs had been diffed one after another.
  */
 class CPatchTool
 {
@@ -57,7 +62,24 @@ public:
 	~CPatchTool();
 	void AddFiles(const PATCHFILES &);
 	void Run();
+	String RunHeadless(LPCTSTR patchfile);
 private:
-	CDiffWrapper m_diffWrapper; /**< DiffWrapper instance we use to create patch. */
+	void InitDiffWrapper();
+	UINT CreatePatch();
+	DWORD PatchThread();
+	void DiffItems();
+	UINT DiffItem(CDiffWrapper &, const PATCHFILES &) const;
+	void WriteItem(LONG, UINT, FILE *);
+
+	static UINT const MAX_THREADS = 8; /**< Upper limit for number of threads */
+	CDiffWrapper m_diffWrapper; /**< Options to copy to the DiffWrappers of the threads. */
 	CPatchDlg m_dlgPatch; /**< Dialog for selecting files and options. */
+	FILE *m_pOutput; /**< Patch file, written to in order of items */
+	LCID m_lcid; /**< Thread locale of caller, which affects path encoding */
+	LONG m_nItems; /**< Number of items to diff */
+	LONG volatile m_nNextItem; /**< Last item claimed by a thread */
+	LONG volatile m_nWrittenItems; /**< Number of items whose turn has passed */
+	LONG volatile m_iFailedItem; /**< First item which failed, or m_nItems */
+	UINT m_idsError; /**< Tells why m_iFailedItem failed */
+	std::vector<HANDLE> m_rgTurnEvents; /**< Per item, event of the thread to wake on its turn */
 };
@@ -57,6 +57,7 @@ BOOL PropCompare::OnInitDialog()
 		combo->AddString(_T("myers"));
 		combo->AddString(_T("patience"));
 		combo->AddString(_T("histogram"));
+		combo->AddString(_T("auto"));
 	}
 	return OptionsPanel::OnInitDialog();
 }
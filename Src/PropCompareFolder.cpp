@@ -32,6 +32,7 @@ bool PropCompareFolder::UpdateData()
 	DDX_Check<op>(IDC_COMPARE_SELFCOMPARE, m_bSelfCompare);
 	DDX_Check<op>(IDC_COMPARE_WALKUNIQUES, m_bWalkUniques);
 	DDX_Check<op>(IDC_COMPARE_CACHE_RESULTS, m_bCacheResults);
+	DDX_Check<op>(IDC_COMPARE_WATCH_FOLDERS, m_bWatchFolders);
 	DDX_Text<op>(IDC_COMPARE_QUICKC_LIMIT, m_nQuickCompareLimit);
 	DDX_Text<op>(IDC_COMPARE_BINARYC_LIMIT, m_nBinaryCompareLimit);
 	DDX_Text<op>(IDC_COMPARE_THREAD_COUNT, m_nCompareThreads);
@@ -97,6 +98,7 @@ void PropCompareFolder::ReadOptions()
 	m_bSelfCompare = COptionsMgr::Get(OPT_CMP_SELF_COMPARE);
 	m_bWalkUniques = COptionsMgr::Get(OPT_CMP_WALK_UNIQUES);
 	m_bCacheResults = COptionsMgr::Get(OPT_CMP_CACHE_RESULTS);
+	m_bWatchFolders = COptionsMgr::Get(OPT_CMP_WATCH_FOLDERS);
 	m_nQuickCompareLimit = COptionsMgr::Get(OPT_CMP_QUICK_LIMIT) / Mega;
 	m_nBinaryCompareLimit = COptionsMgr::Get(OPT_CMP_BINARY_LIMIT) / Mega;
 	m_nCompareThreads = COptionsMgr::Get(OPT_CMP_COMPARE_THREADS);
@@ -115,6 +117,7 @@ void PropCompareFolder::WriteOptions()
 	COptionsMgr::SaveOption(OPT_CMP_SELF_COMPARE, m_bSelfCompare != FALSE);
 	COptionsMgr::SaveOption(OPT_CMP_WALK_UNIQUES, m_bWalkUniques != FALSE);
 	COptionsMgr::SaveOption(OPT_CMP_CACHE_RESULTS, m_bCacheResults != FALSE);
+	COptionsMgr::SaveOption(OPT_CMP_WATCH_FOLDERS, m_bWatchFolders != FALSE);
 	COptionsMgr::SaveOption(OPT_CMP_QUICK_LIMIT, m_nQuickCompareLimit * Mega);
 	COptionsMgr::SaveOption(OPT_CMP_BINARY_LIMIT, m_nBinaryCompareLimit * Mega);
 	COptionsMgr::SaveOption(OPT_CMP_COMPARE_THREADS, m_nCompareThreads);
@@ -153,6 +156,7 @@ void PropCompareFolder::OnDefaults()
 	m_bSelfCompare = COptionsMgr::GetDefault(OPT_CMP_SELF_COMPARE);
 	m_bWalkUniques = COptionsMgr::GetDefault(OPT_CMP_WALK_UNIQUES);
 	m_bCacheResults = COptionsMgr::GetDefault(OPT_CMP_CACHE_RESULTS);
+	m_bWatchFolders = COptionsMgr::GetDefault(OPT_CMP_WATCH_FOLDERS);
 	m_nQuickCompareLimit = COptionsMgr::GetDefault(OPT_CMP_QUICK_LIMIT) / Mega;
 	m_nBinaryCompareLimit = COptionsMgr::GetDefault(OPT_CMP_BINARY_LIMIT) / Mega;
 	m_nCompareThreads = COptionsMgr::GetDefault(OPT_CMP_COMPARE_THREADS);
@@ -32,6 +32,7 @@ public:
 	BOOL    m_bSelfCompare;
 	BOOL    m_bWalkUniques;
 	BOOL    m_bCacheResults;
+	BOOL    m_bWatchFolders;
 	UINT    m_nQuickCompareLimit;
 	UINT    m_nBinaryCompareLimit;
 	int     m_nCompareThreads;
@@ -0,0 +1,214 @@
+/**
+ * @file  RealityIndex.cpp
+ *
+ * @brief Implementation of RealityIndex class.
+ */
+#include "StdAfx.h"
+#include "RealityIndex.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+/**
+ * @brief Find the first block which ends after the given line.
+ * @param [in] nSum APPARENT or REAL, telling which kind of line to look for.
+ * @param [in] nLine The line to look for.
+ * @param [out] block The block, if there is one.
+ * @return The index of the block, or the number of blocks if there is none.
+ */
+int RealityIndex::Find(int nSum, int nLine, RealityBlock &block) const
+{
+	int aBefore[Entries::SUMS];
+	int const nChunk = m_aEntries.FindChunk(nSum, nLine, aBefore);
+	int nBlock = aBefore[Entries::COUNT];
+	if (nChunk < m_aEntries.GetChunkCount())
+	{
+		const Entry *const pEntries = m_aEntries.GetEntries(nChunk);
+		int const nSize = m_aEntries.GetChunkSize(nChunk);
+		int nApparent = aBefore[APPARENT];
+		int nReal = aBefore[REAL];
+		for (int i = 0; i < nSize; ++i, ++nBlock)
+		{
+			const Entry &entry = pEntries[i];
+			block.nStartApparent = nApparent + entry.nGhostLines;
+			block.nStartReal = nReal + entry.nSkippedLines;
+			block.nCount = entry.nCount;
+			nApparent = block.nStartApparent + block.nCount;
+			nReal = block.nStartReal + block.nCount;
+			if ((nSum == REAL ? nReal : nApparent) > nLine)
+				break;
+		}
+	}
+	return nBlock;
+}
+
+/**
+ * @brief Find the first block which ends after the given apparent line.
+ * @param [in] nApparentLine The apparent line to look for.
+ * @param [out] block The block, if there is one.
+ * @return The index of the block, or the number of blocks if there is none.
+ */
+int RealityIndex::FindApparent(int nApparentLine, RealityBlock &block) const
+{
+	return Find(APPARENT, nApparentLine, block);
+}
+
+/**
+ * @brief Find the first block which ends after the given real line.
+ * @param [in] nRealLine The real line to look for.
+ * @param [out] block The block, if there is one.
+ * @return The index of the block, or the number of blocks if there is none.
+ */
+int RealityIndex::FindReal(int nRealLine, RealityBlock &block) const
+{
+	return Find(REAL, nRealLine, block);
+}
+
+/**
+ * @brief Return the block at the given index.
+ */
+RealityBlock RealityIndex::Get(int nBlock) const
+{
+	ASSERT(nBlock >= 0 && nBlock < GetCount());
+	int aBefore[Entries::SUMS];
+	int const nChunk = m_aEntries.Locate(nBlock, aBefore);
+	const Entry *const pEntries = m_aEntries.GetEntries(nChunk);
+	RealityBlock block = { aBefore[REAL], aBefore[APPARENT], 0 };
+	for (int i = 0; i <= nBlock; ++i)
+	{
+		const Entry &entry = pEntries[i];
+		block.nStartApparent += block.nCount + entry.nGhostLines;
+		block.nStartReal += block.nCount + entry.nSkippedLines;
+		block.nCount = entry.nCount;
+	}
+	return block;
+}
+
+/**
+ * @brief Replace a range of blocks.
+ * The blocks behind the range are stored relative to the end of the range,
+ * so they move along with it without being touched.
+ * @param [in] nFirst Index of the first replaced block.
+ * @param [in] nLast Index of the block after the last replaced block.
+ * @param [in] pBlocks The blocks to take the place of the range.
+ * @param [in] nCount Number of blocks to take the place of the range.
+ */
+void RealityIndex::Replace(int nFirst, int nLast, const RealityBlock *pBlocks, int nCount)
+{
+	ASSERT(nFirst >= 0 && nFirst <= nLast && nLast <= GetCount());
+	int nApparent = 0;
+	int nReal = 0;
+	if (nFirst > 0)
+	{
+		RealityBlock const block = Get(nFirst - 1);
+		nApparent = block.nStartApparent + block.nCount;
+		nReal = block.nStartReal + block.nCount;
+	}
+	std::vector<Entry> aEntries(nCount);
+	for (int i = 0; i < nCount; ++i)
+	{
+		RealityBlock const &block = pBlocks[i];
+		Entry &entry = aEntries[i];
+		entry.nGhostLines = block.nStartApparent - nApparent;
+		entry.nSkippedLines = block.nStartReal - nReal;
+		entry.nCount = block.nCount;
+		ASSERT(entry.nGhostLines >= 0 && entry.nSkippedLines >= 0 && entry.nCount > 0);
+		nApparent = block.nStartApparent + block.nCount;
+		nReal = block.nStartReal + block.nCount;
+	}
+	m_aEntries.Erase(nFirst, nLast - nFirst);
+	m_aEntries.Insert(nFirst, aEntries.data(), nCount);
+}
+
+TESTCASE
+{
+	// Compare against a plain array of blocks, leaving the splitting and
+	// merging of chunks to the self-test of ChunkedIndex
+	RealityIndex index;
+	std::vector<RealityBlock> blocks;
+	unsigned seed = 1;
+	for (int n = 0; n < 300; ++n)
+	{
+		int const nBlocks = static_cast<int>(blocks.size());
+		seed = seed * 1103515245 + 12345;
+		int const nFirst = static_cast<int>((seed >> 16) % (nBlocks + 1));
+		seed = seed * 1103515245 + 12345;
+		int const nLast = nFirst + static_cast<int>((seed >> 16) % (nBlocks - nFirst + 1) % 40);
+		seed = seed * 1103515245 + 12345;
+		int const nCount = (seed >> 16) % 20;
+		// make up new blocks, and shift the blocks behind them
+		std::vector<RealityBlock> aNew(nCount);
+		RealityBlock end = { 0, 0, 0 };
+		if (nFirst > 0)
+		{
+			end = blocks[nFirst - 1];
+			end.nStartApparent += end.nCount;
+			end.nStartReal += end.nCount;
+		}
+		for (int i = 0; i < nCount; ++i)
+		{
+			seed = seed * 1103515245 + 12345;
+			RealityBlock &block = aNew[i];
+			block.nStartApparent = end.nStartApparent + (seed >> 16) % 3;
+			block.nStartReal = end.nStartReal + (seed >> 20) % 3;
+			block.nCount = (seed >> 24) % 5 + 1;
+			end.nStartApparent = block.nStartApparent + block.nCount;
+			end.nStartReal = block.nStartReal + block.nCount;
+		}
+		if (nLast < nBlocks)
+		{
+			int nDeltaApparent = end.nStartApparent;
+			int nDeltaReal = end.nStartReal;
+			if (nLast > 0)
+			{
+				RealityBlock const &prev = blocks[nLast - 1];
+				nDeltaApparent -= prev.nStartApparent + prev.nCount;
+				nDeltaReal -= prev.nStartReal + prev.nCount;
+			}
+			for (int i = nLast; i < nBlocks; ++i)
+			{
+				blocks[i].nStartApparent += nDeltaApparent;
+				blocks[i].nStartReal += nDeltaReal;
+			}
+		}
+		index.Replace(nFirst, nLast, aNew.data(), nCount);
+		blocks.erase(blocks.begin() + nFirst, blocks.begin() + nLast);
+		blocks.insert(blocks.begin() + nFirst, aNew.begin(), aNew.end());
+		int const nTotal = static_cast<int>(blocks.size());
+		assert(index.GetCount() == nTotal);
+		if (nTotal == 0)
+		{
+			assert(index.GetApparentEnd() == 0 && index.GetRealEnd() == 0);
+			continue;
+		}
+		RealityBlock const &last = blocks.back();
+		assert(index.GetApparentEnd() == last.nStartApparent + last.nCount);
+		assert(index.GetRealEnd() == last.nStartReal + last.nCount);
+		// look up only some of the blocks to keep the test quick
+		for (int i = n % 7; i < nTotal; i += 7)
+		{
+			RealityBlock const &expected = blocks[i];
+			RealityBlock block = index.Get(i);
+			assert(block.nStartApparent == expected.nStartApparent &&
+				block.nStartReal == expected.nStartReal &&
+				block.nCount == expected.nCount);
+			int const nApparentLine = expected.nStartApparent + i % expected.nCount;
+			assert(index.FindApparent(nApparentLine, block) == i);
+			assert(block.nStartApparent == expected.nStartApparent);
+			int const nRealLine = expected.nStartReal + i % expected.nCount;
+			assert(index.FindReal(nRealLine, block) == i);
+			assert(block.nStartReal == expected.nStartReal);
+			// lines in front of a block belong to it
+			if (expected.nStartApparent > 0 && (i == 0 ||
+				blocks[i - 1].nStartApparent + blocks[i - 1].nCount < expected.nStartApparent))
+			{
+				assert(index.FindApparent(expected.nStartApparent - 1, block) == i);
+			}
+		}
+		RealityBlock block;
+		assert(index.FindApparent(index.GetApparentEnd(), block) == nTotal);
+		assert(index.FindReal(index.GetRealEnd(), block) == nTotal);
+	}
+	return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file RealityIndex.h
+ *
+ * @brief Declaration for RealityIndex class.
+ *
+ */
+#pragma once
+
+#include "ChunkedIndex.h"
+
+/**
+ * @brief A struct mapping real lines and apparent (screen) lines.
+ * This struct maps lines between real lines and apparent (screen) lines.
+ * The mapping records for each text block an apparent line and matching
+ * real line.
+ */
+struct RealityBlock
+{
+	int nStartReal; /**< Start line of real block. */
+	int nStartApparent; /**< Start line of apparent block. */
+	int nCount; /**< Lines in the block. */
+};
+
+/**
+ * @brief Sequence of reality blocks, with lookups by apparent and real line.
+ * Each block is stored relative to the end of the block before it, so that
+ * replacing some blocks leaves the blocks behind them untouched. The blocks
+ * are kept in a ChunkedIndex which sums up their apparent and real lines,
+ * so that lookups and edits take logarithmic time in the number of chunks
+ * plus linear time in the size of a chunk.
+ */
+class RealityIndex
+{
+public:
+	/** @brief Remove all blocks. */
+	void Clear() { m_aEntries.Clear(); }
+	/** @brief Return the number of blocks. */
+	int GetCount() const { return m_aEntries.GetTotal(Entries::COUNT); }
+	/** @brief Return the apparent line after the last block. */
+	int GetApparentEnd() const { return m_aEntries.GetTotal(APPARENT); }
+	/** @brief Return the real line after the last block. */
+	int GetRealEnd() const { return m_aEntries.GetTotal(REAL); }
+	RealityBlock Get(int nBlock) const;
+	int FindApparent(int nApparentLine, RealityBlock &block) const;
+	int FindReal(int nRealLine, RealityBlock &block) const;
+	void Replace(int nFirst, int nLast, const RealityBlock *pBlocks, int nCount);
+
+private:
+	/** @brief Sums over the blocks besides their number. */
+	enum { APPARENT = 1, REAL = 2 };
+
+	/** @brief A block relative to the end of the block before it. */
+	struct Entry
+	{
+		int nGhostLines; /**< Ghost lines before the block. */
+		int nSkippedLines; /**< Real lines skipped by the ghost lines. */
+		int nCount; /**< Lines in the block. */
+	};
+
+	struct EntryTraits
+	{
+		typedef RealityIndex::Entry Entry;
+		enum { SUMS = 2, CHUNK_SIZE = 64 };
+		static void Measure(const Entry &entry, int *aSums)
+		{
+			aSums[APPARENT] += entry.nGhostLines + entry.nCount;
+			aSums[REAL] += entry.nSkippedLines + entry.nCount;
+		}
+	};
+
+	typedef ChunkedIndex<EntryTraits> Entries;
+
+	int Find(int nSum, int nLine, RealityBlock &block) const;
+
+	Entries m_aEntries;
+};
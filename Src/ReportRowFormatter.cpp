@@ -0,0 +1,91 @@
+/**
+ * @file  ReportRowFormatter.cpp
+ *
+ * @brief Implementation file for ReportRowFormatter
+ *
+ */
+#include "StdAfx.h"
+#include "ReportRowFormatter.h"
+
+/**
+ * @brief Constructor.
+ */
+ReportRowFormatter::ReportRowFormatter()
+	: m_nFirstRow(0), m_nEndRow(0), m_nBlocks(0), m_nNextBlock(0)
+{
+}
+
+/**
+ * @brief Format given number of rows, and write them in order.
+ * @param [in] nRows Number of rows.
+ */
+void ReportRowFormatter::FormatRows(stl_size_t nRows)
+{
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	UINT const nThreads = max<UINT>(min<UINT>(si.dwNumberOfProcessors, MAX_THREADS), 1);
+	stl_size_t const nChunkRows = nThreads * BLOCKS_PER_THREAD * BLOCK_ROWS;
+	m_aBlocks.resize(nThreads * BLOCKS_PER_THREAD);
+	for (m_nFirstRow = 0 ; m_nFirstRow < nRows ; m_nFirstRow = m_nEndRow)
+	{
+		m_nEndRow = min(m_nFirstRow + nChunkRows, nRows);
+		m_nBlocks = static_cast<LONG>((m_nEndRow - m_nFirstRow + BLOCK_ROWS - 1) / BLOCK_ROWS);
+		m_nNextBlock = -1;
+		// Caller's thread takes part, so start helpers only for extra blocks
+		HANDLE rgThreads[MAX_THREADS];
+		DWORD nHelpers = 0;
+		while (nHelpers + 1 < nThreads && static_cast<LONG>(nHelpers + 1) < m_nBlocks)
+		{
+			HANDLE const hThread = BeginThreadEx(NULL, 0,
+				OException::ThreadProc<ReportRowFormatter, &ReportRowFormatter::FormatThread>,
+				this, 0, NULL);
+			if (hThread == NULL)
+				break;
+			rgThreads[nHelpers++] = hThread;
+		}
+		FormatBlocks();
+		if (nHelpers != 0)
+		{
+			WaitForMultipleObjects(nHelpers, rgThreads, TRUE, INFINITE);
+			do
+			{
+				CloseHandle(rgThreads[--nHelpers]);
+			} while (nHelpers != 0);
+		}
+		for (LONG iBlock = 0 ; iBlock < m_nBlocks ; ++iBlock)
+		{
+			stl_size_t const iRow = m_nFirstRow + iBlock * BLOCK_ROWS;
+			String &text = m_aBlocks[iBlock];
+			WriteRows(iRow, min(iRow + BLOCK_ROWS, m_nEndRow) - iRow, text);
+			text.clear();
+		}
+	}
+	m_aBlocks.clear();
+}
+
+/**
+ * @brief Helper thread function.
+ */
+DWORD ReportRowFormatter::FormatThread()
+{
+	FormatBlocks();
+	return 0;
+}
+
+/**
+ * @brief Format blocks of current chunk until none are left.
+ */
+void ReportRowFormatter::FormatBlocks()
+{
+	LONG iBlock;
+	while ((iBlock = InterlockedIncrement(&m_nNextBlock)) < m_nBlocks)
+	{
+		stl_size_t iRow = m_nFirstRow + iBlock * BLOCK_ROWS;
+		stl_size_t const nEnd = min(iRow + BLOCK_ROWS, m_nEndRow);
+		String &text = m_aBlocks[iBlock];
+		do
+		{
+			FormatRow(iRow, text);
+		} while (++iRow < nEnd);
+	}
+}
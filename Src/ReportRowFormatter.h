@@ -0,0 +1,42 @@
+/**
+ * @file  ReportRowFormatter.h
+ *
+ * @brief Declaration file for ReportRowFormatter
+ *
+ */
+#pragma once
+
+/**
+ * @brief Base class for reports which format their rows in parallel.
+ *
+ * Rows are formatted by worker threads in blocks, and handed back to the
+ * caller's thread in row order. Only one chunk of blocks is held in memory
+ * at a time, so the memory needed does not grow with the number of rows.
+ */
+class ReportRowFormatter
+{
+protected:
+	ReportRowFormatter();
+	void FormatRows(stl_size_t nRows);
+	/**
+	 * @brief Append text of given row to buffer.
+	 * Called on worker threads, so must not touch any windows.
+	 */
+	virtual void FormatRow(stl_size_t iRow, String &) = 0;
+	/**
+	 * @brief Write text of consecutive rows to output.
+	 * Called on the thread which called FormatRows().
+	 */
+	virtual void WriteRows(stl_size_t iRow, stl_size_t nRows, String &) = 0;
+private:
+	static stl_size_t const BLOCK_ROWS = 256; /**< Rows per block */
+	static UINT const BLOCKS_PER_THREAD = 8; /**< Blocks per thread and chunk */
+	static UINT const MAX_THREADS = 8; /**< Upper limit for number of threads */
+	DWORD FormatThread();
+	void FormatBlocks();
+	stl_size_t m_nFirstRow; /**< First row of current chunk */
+	stl_size_t m_nEndRow; /**< End of current chunk */
+	LONG m_nBlocks; /**< Number of blocks in current chunk */
+	LONG volatile m_nNextBlock; /**< Last block claimed by a thread */
+	std::vector<String> m_aBlocks; /**< Formatted text of current chunk */
+};
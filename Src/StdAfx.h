@@ -170,8 +170,16 @@ extern const char *const wine_version;
 	static int UNIQUENAME(TestMethod)(); \
 	static int UNIQUENAME(TestResult) = IsDebuggerPresent() ? UNIQUENAME(TestMethod)() : 0; \
 	static int UNIQUENAME(TestMethod)()
+// Benchmarks take their time, so they only run when asked to by setting the
+// WinMergeBenchmarks environment variable, and TRACE their results
+#define BENCHMARK \
+	static int UNIQUENAME(TestMethod)(); \
+	static int UNIQUENAME(TestResult) = IsDebuggerPresent() && \
+		GetEnvironmentVariableA("WinMergeBenchmarks", NULL, 0) ? UNIQUENAME(TestMethod)() : 0; \
+	static int UNIQUENAME(TestMethod)()
 #else
 #define TESTCASE inline int UNIQUENAME(TestMethod)()
+#define BENCHMARK inline int UNIQUENAME(TestMethod)()
 #endif
 
 #define A2W(A) OString(HString::Oct(A)->Uni()).W
@@ -190,6 +198,10 @@ extern const char *const wine_version;
 /* @{ */
 /// Directory compare thread asks UI (view) update
 const UINT MSG_UI_UPDATE = WM_APP + 1;
+/// Property extraction threads have read properties of all items
+const UINT MSG_PROPERTIES_READY = WM_APP + 2;
+/// Watched folders have changed on disk
+const UINT MSG_FOLDERS_CHANGED = WM_APP + 3;
 /* @} */
 
 const UINT MERGE_VIEW_COUNT = 2;
@@ -0,0 +1,202 @@
+/**
+ * @file  SubLineIndex.cpp
+ *
+ * @brief Implementation of SubLineIndex class.
+ */
+#include "StdAfx.h"
+#include "SubLineIndex.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+static int Magnitude(int nSubLines)
+{
+	return nSubLines < 0 ? -nSubLines : nSubLines;
+}
+
+/**
+ * @brief Return the sub line count of a line, negative if estimated.
+ */
+int SubLineIndex::Get(int nLine) const
+{
+	int aBefore[Counts::SUMS];
+	int const nChunk = m_aCounts.Locate(nLine, aBefore);
+	return m_aCounts.GetEntries(nChunk)[nLine];
+}
+
+/**
+ * @brief Set the sub line count of a line, negative if estimated.
+ * @return The difference to the number of sub lines accounted for so far.
+ */
+int SubLineIndex::Set(int nLine, int nSubLines)
+{
+	int aBefore[Counts::SUMS];
+	int const nChunk = m_aCounts.Locate(nLine, aBefore);
+	int &nCount = m_aCounts.GetEntries(nChunk)[nLine];
+	int const nDelta = Magnitude(nSubLines) - Magnitude(nCount);
+	nCount = nSubLines;
+	if (nDelta != 0)
+		m_aCounts.Adjust(nChunk, SUBLINES, nDelta);
+	return nDelta;
+}
+
+/**
+ * @brief Mark the sub line counts of the given lines as estimates.
+ * @param [in] nLine Index of the first line.
+ * @param [in] nCount Number of lines.
+ */
+void SubLineIndex::MarkEstimated(int nLine, int nCount)
+{
+	if (nCount <= 0)
+		return;
+	int aBefore[Counts::SUMS];
+	int nChunk = m_aCounts.Locate(nLine, aBefore);
+	while (nCount > 0)
+	{
+		int *const pCounts = m_aCounts.GetEntries(nChunk);
+		int const nEnd = min(m_aCounts.GetChunkSize(nChunk++), nLine + nCount);
+		for (int i = nLine; i < nEnd; ++i)
+		{
+			if (pCounts[i] > 0)
+				pCounts[i] = -pCounts[i];
+		}
+		nCount -= nEnd - nLine;
+		nLine = 0;
+	}
+}
+
+/**
+ * @brief Insert lines with no sub lines before the given line.
+ * @param [in] nLine Index of the first inserted line.
+ * @param [in] nCount Number of lines to insert.
+ */
+void SubLineIndex::Insert(int nLine, int nCount)
+{
+	m_aCounts.Insert(nLine, NULL, nCount);
+}
+
+/**
+ * @brief Remove lines.
+ * @param [in] nLine Index of the first removed line.
+ * @param [in] nCount Number of lines to remove.
+ */
+void SubLineIndex::Erase(int nLine, int nCount)
+{
+	m_aCounts.Erase(nLine, nCount);
+}
+
+/**
+ * @brief Return the number of sub lines of the lines before the given line.
+ */
+int SubLineIndex::GetSubLineIndex(int nLine) const
+{
+	if (m_aCounts.GetChunkCount() == 0)
+		return 0;
+	int aBefore[Counts::SUMS];
+	int const nChunk = m_aCounts.Locate(nLine, aBefore);
+	int nSubLineIndex = aBefore[SUBLINES];
+	const int *const pCounts = m_aCounts.GetEntries(nChunk);
+	for (int i = 0; i < nLine; ++i)
+		nSubLineIndex += Magnitude(pCounts[i]);
+	return nSubLineIndex;
+}
+
+/**
+ * @brief Find the line which contains the given sub line.
+ * @param [in,out] nSubLineIndex The sub line index on input, the sub line
+ *  relative to the returned line on output.
+ * @return The index of the line, or the number of lines if out of range.
+ */
+int SubLineIndex::FindSubLine(int &nSubLineIndex) const
+{
+	int aBefore[Counts::SUMS];
+	int const nChunk = m_aCounts.FindChunk(SUBLINES, nSubLineIndex, aBefore);
+	int nLine = aBefore[Counts::COUNT];
+	nSubLineIndex -= aBefore[SUBLINES];
+	if (nChunk < m_aCounts.GetChunkCount())
+	{
+		const int *const pCounts = m_aCounts.GetEntries(nChunk);
+		int const nSize = m_aCounts.GetChunkSize(nChunk);
+		for (int i = 0; i < nSize; ++i)
+		{
+			int const nSubLines = Magnitude(pCounts[i]);
+			if (nSubLineIndex < nSubLines)
+				return nLine + i;
+			nSubLineIndex -= nSubLines;
+		}
+		nLine += nSize;
+	}
+	return nLine;
+}
+
+TESTCASE
+{
+	// Compare against a plain array of counts, leaving the splitting and
+	// merging of chunks to the self-test of ChunkedIndex
+	SubLineIndex index;
+	std::vector<int> counts;
+	unsigned seed = 1;
+	for (int n = 0; n < 400; ++n)
+	{
+		seed = seed * 1103515245 + 12345;
+		int const nOp = (seed >> 16) % 5;
+		seed = seed * 1103515245 + 12345;
+		int const nLine = static_cast<int>((seed >> 16) % (counts.size() + 1));
+		seed = seed * 1103515245 + 12345;
+		// now and then insert more lines than fit in a chunk
+		int nCount = (seed >> 16) % (n % 50 == 0 ? 600 : 20);
+		if (nOp == 0 && nLine < static_cast<int>(counts.size()))
+		{
+			nCount = nCount % 9 - 4;
+			int const nDelta = index.Set(nLine, nCount);
+			assert(nDelta == abs(nCount) - abs(counts[nLine]));
+			counts[nLine] = nCount;
+		}
+		else if (nOp == 4)
+		{
+			nCount = min(nCount, static_cast<int>(counts.size()) - nLine);
+			index.MarkEstimated(nLine, nCount);
+			for (int i = nLine; i < nLine + nCount; ++i)
+				counts[i] = -abs(counts[i]);
+		}
+		else if (nOp == 1)
+		{
+			nCount = min(nCount, static_cast<int>(counts.size()) - nLine);
+			index.Erase(nLine, nCount);
+			counts.erase(counts.begin() + nLine, counts.begin() + nLine + nCount);
+		}
+		else
+		{
+			index.Insert(nLine, nCount);
+			counts.insert(counts.begin() + nLine, nCount, 0);
+			for (int i = nLine; i < nLine + nCount; ++i)
+			{
+				index.Set(i, i % 3 + 1);
+				counts[i] = i % 3 + 1;
+			}
+		}
+		int const nLines = static_cast<int>(counts.size());
+		assert(index.GetCount() == nLines);
+		int nSubLineIndex = 0;
+		for (int i = 0; i < nLines; ++i)
+		{
+			assert(index.Get(i) == counts[i]);
+			// look up only some of the lines to keep the test quick
+			if (i % 31 == 0 || i == nLines - 1)
+			{
+				assert(index.GetSubLineIndex(i) == nSubLineIndex);
+				for (int j = 0; j < abs(counts[i]); ++j)
+				{
+					int nSubLine = nSubLineIndex + j;
+					assert(index.FindSubLine(nSubLine) == i && nSubLine == j);
+				}
+			}
+			nSubLineIndex += abs(counts[i]);
+		}
+		assert(index.GetTotal() == nSubLineIndex);
+		int nSubLine = nSubLineIndex;
+		assert(index.FindSubLine(nSubLine) == nLines);
+	}
+	return 0;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file SubLineIndex.h
+ *
+ * @brief Declaration for SubLineIndex class.
+ *
+ */
+#pragma once
+
+#include "ChunkedIndex.h"
+
+/**
+ * @brief Sub line counts of the lines of a view, with sums over them.
+ * Counts are kept in a ChunkedIndex which sums up their sub lines, so that
+ * edits and lookups take logarithmic time in the number of chunks plus
+ * linear time in the size of a chunk. A negative count stands for an
+ * estimate, and counts by its magnitude.
+ */
+class SubLineIndex
+{
+public:
+	/** @brief Remove all lines. */
+	void Clear() { m_aCounts.Clear(); }
+	/** @brief Return the number of lines. */
+	int GetCount() const { return m_aCounts.GetTotal(Counts::COUNT); }
+	/** @brief Return the number of sub lines of all lines. */
+	int GetTotal() const { return m_aCounts.GetTotal(SUBLINES); }
+	int Get(int nLine) const;
+	int Set(int nLine, int nSubLines);
+	void MarkEstimated(int nLine, int nCount);
+	void Insert(int nLine, int nCount);
+	void Erase(int nLine, int nCount);
+	int GetSubLineIndex(int nLine) const;
+	int FindSubLine(int &nSubLineIndex) const;
+
+private:
+	/** @brief Sum over the magnitudes of the counts. */
+	enum { SUBLINES = 1 };
+
+	struct CountTraits
+	{
+		typedef int Entry; /**< Sub line count, negative if estimated. */
+		enum { SUMS = 1, CHUNK_SIZE = 256 };
+		static void Measure(int nSubLines, int *aSums)
+		{
+			aSums[SUBLINES] += nSubLines < 0 ? -nSubLines : nSubLines;
+		}
+	};
+
+	typedef ChunkedIndex<CountTraits> Counts;
+
+	Counts m_aCounts;
+};
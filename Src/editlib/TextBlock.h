@@ -70,6 +70,10 @@ public:
 		{
 			return m_dwCookie == -1;
 		}
+		bool operator==(Cookie const &other) const
+		{
+			return m_dwCookie == other.m_dwCookie && m_dwNesting == other.m_dwNesting;
+		}
 		/** Basic parser state information, semantics being up to the parser */
 		DWORD m_dwCookie;
 		/** Stack of block nesting levels inside JavaScript template strings */
@@ -0,0 +1,386 @@
+/**
+ * @file  UndoJournal.cpp
+ *
+ * @brief Implementation of UndoJournal class.
+ */
+#include "StdAfx.h"
+#include "UndoJournal.h"
+#include "DllProxies.h"
+#include "Environment.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+static USHORT const CompressionFormat =
+	COMPRESSION_FORMAT_LZNT1 | COMPRESSION_ENGINE_STANDARD;
+
+UndoJournal::UndoJournal()
+	: m_cbResident(0)
+	, m_cbLimit(0)
+	, m_nSpilled(0)
+	, m_nSpillEnd(0)
+	, m_hSpillFile(INVALID_HANDLE_VALUE)
+	, m_nCachedBlock(UINT_MAX)
+{
+}
+
+UndoJournal::~UndoJournal()
+{
+	Clear();
+}
+
+/**
+ * @brief Discard all payloads along with the spill file.
+ */
+void UndoJournal::Clear()
+{
+	while (!m_aBlocks.empty())
+		PopBlock();
+	if (m_hSpillFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_hSpillFile);
+		m_hSpillFile = INVALID_HANDLE_VALUE;
+	}
+	m_nSpillEnd = 0;
+	std::vector<BYTE>().swap(m_aCache);
+}
+
+/**
+ * @brief Set the amount of memory the journal may hold before it spills
+ * the oldest blocks to a temporary file.
+ * @param [in] cbLimit Limit in bytes, or 0 for no limit.
+ */
+void UndoJournal::SetMemoryLimit(size_t cbLimit)
+{
+	m_cbLimit = cbLimit;
+	Spill();
+}
+
+/**
+ * @brief Append a payload.
+ * @param [in] pv Payload bytes.
+ * @param [in] cb Number of payload bytes.
+ * @return Position of the payload.
+ * @note Invalidates pointers obtained from Read().
+ */
+UndoJournal::Entry UndoJournal::Append(const void *pv, UINT cb)
+{
+	Entry entry;
+	if (cb >= LARGE_PAYLOAD)
+	{
+		if (!m_aBlocks.empty() && m_aBlocks.back().bOpen)
+			Seal(m_aBlocks.back());
+		Block block = { static_cast<BYTE *>(malloc(cb)), cb, cb, cb, true, false, -1 };
+		memcpy(block.pData, pv, cb);
+		m_cbResident += cb;
+		entry.nBlock = static_cast<UINT>(m_aBlocks.size());
+		entry.nOffset = 0;
+		m_aBlocks.push_back(block);
+		Seal(m_aBlocks.back());
+	}
+	else if (cb != 0)
+	{
+		if (m_aBlocks.empty() || !m_aBlocks.back().bOpen ||
+			m_aBlocks.back().cbUsed + cb > BLOCK_SIZE)
+		{
+			if (!m_aBlocks.empty() && m_aBlocks.back().bOpen)
+				Seal(m_aBlocks.back());
+			Block block = { static_cast<BYTE *>(malloc(BLOCK_SIZE)), 0, 0, BLOCK_SIZE, true, false, -1 };
+			m_cbResident += BLOCK_SIZE;
+			m_aBlocks.push_back(block);
+		}
+		Block &block = m_aBlocks.back();
+		entry.nBlock = static_cast<UINT>(m_aBlocks.size() - 1);
+		entry.nOffset = block.cbUsed;
+		memcpy(block.pData + block.cbUsed, pv, cb);
+		block.cbUsed += cb;
+		block.cbStored = block.cbUsed;
+	}
+	else if (!m_aBlocks.empty() && m_aBlocks.back().bOpen)
+	{
+		// Empty payloads need a position for Truncate() but no storage
+		entry.nBlock = static_cast<UINT>(m_aBlocks.size() - 1);
+		entry.nOffset = m_aBlocks.back().cbUsed;
+	}
+	else
+	{
+		entry.nBlock = static_cast<UINT>(m_aBlocks.size());
+		entry.nOffset = 0;
+	}
+	Spill();
+	return entry;
+}
+
+/**
+ * @brief Get the bytes of a payload.
+ * @param [in] entry Position of the payload.
+ * @param [in] cb Number of payload bytes.
+ * @return Pointer to the payload bytes, valid until the next call to any
+ * other method of the journal.
+ */
+const void *UndoJournal::Read(const Entry &entry, UINT cb)
+{
+	static const DWORD empty = 0;
+	if (cb == 0)
+		return &empty;
+	ASSERT(entry.nBlock < m_aBlocks.size());
+	ASSERT(entry.nOffset + cb <= m_aBlocks[entry.nBlock].cbUsed);
+	return Load(entry.nBlock) + entry.nOffset;
+}
+
+/**
+ * @brief Discard a payload along with all payloads appended after it.
+ * @param [in] entry Position of the payload.
+ */
+void UndoJournal::Truncate(const Entry &entry)
+{
+	while (m_aBlocks.size() > entry.nBlock + 1)
+		PopBlock();
+	if (entry.nBlock < m_aBlocks.size())
+	{
+		if (entry.nOffset == 0)
+		{
+			PopBlock();
+		}
+		else
+		{
+			Reopen();
+			Block &block = m_aBlocks.back();
+			block.cbUsed = block.cbStored = entry.nOffset;
+		}
+	}
+}
+
+/**
+ * @brief Stop appending to a block, and compress it if that pays off.
+ */
+void UndoJournal::Seal(Block &block)
+{
+	ASSERT(block.bOpen);
+	block.bOpen = false;
+	if (!Compress(block) && block.cbAlloc > block.cbUsed)
+	{
+		// Give back the unused tail of the block
+		if (BYTE *pData = static_cast<BYTE *>(realloc(block.pData, block.cbUsed)))
+		{
+			m_cbResident -= block.cbAlloc - block.cbUsed;
+			block.pData = pData;
+			block.cbAlloc = block.cbUsed;
+		}
+	}
+}
+
+/**
+ * @brief Turn the last block back into an uncompressed in-memory block which
+ * accepts further payloads.
+ */
+void UndoJournal::Reopen()
+{
+	UINT const nBlock = static_cast<UINT>(m_aBlocks.size() - 1);
+	Block &block = m_aBlocks.back();
+	if (block.bOpen)
+		return;
+	// Only blocks for small payloads get truncated somewhere in the middle
+	ASSERT(block.cbUsed <= BLOCK_SIZE);
+	BYTE *const pData = static_cast<BYTE *>(malloc(BLOCK_SIZE));
+	memcpy(pData, Load(nBlock), block.cbUsed);
+	Free(block);
+	if (nBlock < m_nSpilled)
+	{
+		m_nSpilled = nBlock;
+		m_nSpillEnd = block.nSpillPos;
+		block.nSpillPos = -1;
+	}
+	if (m_nCachedBlock == nBlock)
+		m_nCachedBlock = UINT_MAX;
+	block.pData = pData;
+	block.cbAlloc = BLOCK_SIZE;
+	block.cbStored = block.cbUsed;
+	block.bOpen = true;
+	block.bCompressed = false;
+	m_cbResident += BLOCK_SIZE;
+}
+
+/**
+ * @brief Discard the last block.
+ */
+void UndoJournal::PopBlock()
+{
+	UINT const nBlock = static_cast<UINT>(m_aBlocks.size() - 1);
+	Block &block = m_aBlocks.back();
+	Free(block);
+	if (nBlock < m_nSpilled)
+	{
+		m_nSpilled = nBlock;
+		m_nSpillEnd = block.nSpillPos;
+	}
+	if (m_nCachedBlock == nBlock)
+		m_nCachedBlock = UINT_MAX;
+	m_aBlocks.pop_back();
+}
+
+/**
+ * @brief Move the oldest sealed blocks to the spill file until the memory
+ * held by the journal is back within its limit.
+ */
+void UndoJournal::Spill()
+{
+	while (m_cbLimit != 0 && m_cbResident > m_cbLimit &&
+		m_nSpilled < m_aBlocks.size() && !m_aBlocks[m_nSpilled].bOpen)
+	{
+		Block &block = m_aBlocks[m_nSpilled];
+		if (m_hSpillFile == INVALID_HANDLE_VALUE)
+		{
+			String path = env_GetTempFileName(env_GetTempPath(), _T("UND"));
+			if (!path.empty())
+			{
+				m_hSpillFile = CreateFile(path.c_str(),
+					GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+					FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+				if (m_hSpillFile == INVALID_HANDLE_VALUE)
+					DeleteFile(path.c_str());
+			}
+		}
+		LARGE_INTEGER pos;
+		pos.QuadPart = m_nSpillEnd;
+		DWORD cb = 0;
+		if (m_hSpillFile == INVALID_HANDLE_VALUE ||
+			!SetFilePointerEx(m_hSpillFile, pos, NULL, FILE_BEGIN) ||
+			!WriteFile(m_hSpillFile, block.pData, block.cbStored, &cb, NULL) ||
+			cb != block.cbStored)
+		{
+			// Keep the history in memory rather than losing it
+			m_cbLimit = 0;
+			break;
+		}
+		block.nSpillPos = m_nSpillEnd;
+		m_nSpillEnd += block.cbStored;
+		Free(block);
+		++m_nSpilled;
+	}
+}
+
+/**
+ * @brief Get the uncompressed bytes of a block.
+ * Compressed or spilled blocks are materialized into a single-block cache.
+ */
+const BYTE *UndoJournal::Load(UINT nBlock)
+{
+	const Block &block = m_aBlocks[nBlock];
+	if (block.pData != NULL && !block.bCompressed)
+		return block.pData;
+	if (m_nCachedBlock != nBlock)
+	{
+		m_nCachedBlock = UINT_MAX;
+		std::vector<BYTE> aSpilled;
+		const BYTE *pStored = block.pData;
+		if (pStored == NULL)
+		{
+			aSpilled.resize(block.cbStored);
+			LARGE_INTEGER pos;
+			pos.QuadPart = block.nSpillPos;
+			DWORD cb = 0;
+			if (!SetFilePointerEx(m_hSpillFile, pos, NULL, FILE_BEGIN) ||
+				!ReadFile(m_hSpillFile, &aSpilled.front(), block.cbStored, &cb, NULL))
+			{
+				OException::Throw(GetLastError());
+			}
+			if (cb != block.cbStored)
+				OException::Throw(ERROR_HANDLE_EOF);
+			pStored = &aSpilled.front();
+		}
+		if (block.bCompressed)
+		{
+			m_aCache.resize(block.cbUsed);
+			ULONG cbFinal = 0;
+			if (NTDLL->RtlDecompressBuffer(COMPRESSION_FORMAT_LZNT1,
+					&m_aCache.front(), block.cbUsed,
+					const_cast<BYTE *>(pStored), block.cbStored, &cbFinal) != 0 ||
+				cbFinal != block.cbUsed)
+			{
+				OException::Throw(ERROR_INVALID_DATA);
+			}
+		}
+		else
+		{
+			m_aCache.swap(aSpilled);
+		}
+		m_nCachedBlock = nBlock;
+	}
+	return &m_aCache.front();
+}
+
+/**
+ * @brief Compress a sealed block if that saves at least one eighth of its size.
+ * @return Whether the block is now compressed.
+ */
+bool UndoJournal::Compress(Block &block)
+{
+	struct NTDLL *const NTDLL = ::NTDLL;
+	if (NTDLL == NULL)
+		return false;
+	if (m_aWorkSpace.empty())
+	{
+		ULONG cbWorkSpace = 0;
+		ULONG cbFragmentWorkSpace = 0;
+		if (NTDLL->RtlGetCompressionWorkSpaceSize(CompressionFormat,
+				&cbWorkSpace, &cbFragmentWorkSpace) != 0)
+		{
+			return false;
+		}
+		m_aWorkSpace.resize(cbWorkSpace);
+	}
+	ULONG const cbMax = block.cbUsed - block.cbUsed / 8;
+	BYTE *pData = static_cast<BYTE *>(malloc(cbMax));
+	ULONG cbStored = 0;
+	if (pData == NULL || NTDLL->RtlCompressBuffer(CompressionFormat,
+			block.pData, block.cbUsed, pData, cbMax, 4096,
+			&cbStored, &m_aWorkSpace.front()) != 0)
+	{
+		free(pData);
+		return false;
+	}
+	if (BYTE *pShrunk = static_cast<BYTE *>(realloc(pData, cbStored)))
+		pData = pShrunk;
+	Free(block);
+	block.pData = pData;
+	block.cbStored = block.cbAlloc = cbStored;
+	block.bCompressed = true;
+	m_cbResident += cbStored;
+	return true;
+}
+
+/**
+ * @brief Release the memory held by a block.
+ */
+void UndoJournal::Free(Block &block)
+{
+	free(block.pData);
+	block.pData = NULL;
+	m_cbResident -= block.cbAlloc;
+	block.cbAlloc = 0;
+}
+
+TESTCASE
+{
+	UndoJournal journal;
+	// Small payloads spanning several blocks, followed by a large one
+	std::vector<UndoJournal::Entry> entries;
+	DWORD i;
+	for (i = 0; i < 40000; ++i)
+		entries.push_back(journal.Append(&i, sizeof i));
+	std::vector<DWORD> large(100000, 0xCAFEBABE);
+	UndoJournal::Entry const entry = journal.Append(large.data(), large.size() * sizeof(DWORD));
+	for (i = 0; i < 40000; i += 1000)
+		assert(*static_cast<const DWORD *>(journal.Read(entries[i], sizeof i)) == i);
+	assert(memcmp(journal.Read(entry, large.size() * sizeof(DWORD)),
+		large.data(), large.size() * sizeof(DWORD)) == 0);
+	// Truncate in the middle of a sealed block and append again
+	journal.Truncate(entries[30000]);
+	for (i = 30000; i < 40000; ++i)
+		entries[i] = journal.Append(&i, sizeof i);
+	for (i = 0; i < 40000; i += 999)
+		assert(*static_cast<const DWORD *>(journal.Read(entries[i], sizeof i)) == i);
+	return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file UndoJournal.h
+ *
+ * @brief Declaration for UndoJournal class.
+ *
+ */
+#pragma once
+
+/**
+ * @brief Append-only byte log holding the payloads of undo records.
+ * Small payloads are packed into fixed-size blocks, while large payloads get
+ * a block of their own. Blocks are compressed once they are sealed. When the
+ * memory held by the journal exceeds the configured limit, the oldest blocks
+ * are spilled to a temporary file and paged back in on demand.
+ */
+class UndoJournal
+{
+public:
+	/** @brief Position of a payload in the journal. */
+	struct Entry
+	{
+		UINT nBlock;
+		UINT nOffset;
+	};
+
+	UndoJournal();
+	~UndoJournal();
+
+	void Clear();
+	void SetMemoryLimit(size_t cbLimit);
+	Entry Append(const void *pv, UINT cb);
+	const void *Read(const Entry &, UINT cb);
+	void Truncate(const Entry &);
+
+private:
+	/** @brief Capacity of a block holding small payloads. */
+	static UINT const BLOCK_SIZE = 64 * 1024;
+	/** @brief Payloads from this size on get a block of their own. */
+	static UINT const LARGE_PAYLOAD = BLOCK_SIZE / 4;
+
+	struct Block
+	{
+		BYTE *pData; /**< Stored bytes, or NULL if spilled. */
+		UINT cbUsed; /**< Number of payload bytes. */
+		UINT cbStored; /**< Number of stored bytes (differs if compressed). */
+		UINT cbAlloc; /**< Number of allocated bytes. */
+		bool bOpen; /**< Block still accepts payloads. */
+		bool bCompressed; /**< Stored bytes are LZNT1 compressed. */
+		LONGLONG nSpillPos; /**< Position in spill file, or -1. */
+	};
+
+	void Seal(Block &);
+	void Reopen();
+	void PopBlock();
+	void Spill();
+	const BYTE *Load(UINT nBlock);
+	bool Compress(Block &);
+	void Free(Block &);
+
+	std::vector<Block> m_aBlocks;
+	size_t m_cbResident; /**< Bytes allocated for blocks held in memory. */
+	size_t m_cbLimit; /**< Limit for m_cbResident, or 0 for no limit. */
+	UINT m_nSpilled; /**< Blocks below this index live in the spill file. */
+	LONGLONG m_nSpillEnd; /**< End of used portion of the spill file. */
+	HANDLE m_hSpillFile;
+	UINT m_nCachedBlock; /**< Block whose payloads m_aCache holds. */
+	std::vector<BYTE> m_aCache; /**< Payloads of a compressed or spilled block. */
+	std::vector<BYTE> m_aWorkSpace; /**< Work space for RtlCompressBuffer(). */
+
+	UndoJournal(const UndoJournal &); // disallow copy construction
+	void operator=(const UndoJournal &); // disallow assignment
+};
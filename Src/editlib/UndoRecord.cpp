@@ -10,52 +10,32 @@
 #define new DEBUG_NEW
 #endif
 
-void UndoRecord::Clone(const UndoRecord &src)
+/**
+ * @brief Store the text in the journal.
+ * @note Must be called before SetRevisionNumbers().
+ */
+void UndoRecord::SetText(UndoJournal &journal, LPCTSTR pszText, int cchText)
 {
-	m_dwFlags = src.m_dwFlags;
-	m_ptStartPos = src.m_ptStartPos;
-	m_ptEndPos = src.m_ptEndPos;
-	m_nAction = src.m_nAction;
-	SetText(src.GetText(), src.GetTextLength());
+	m_text = journal.Append(pszText, static_cast<UINT>(cchText * sizeof(TCHAR)));
+	m_nTextLength = cchText;
 }
 
-void UndoRecord::SetText(LPCTSTR pszText, int nLength)
-{
-	FreeText();
-	if (nLength)
-	{
-		if (nLength > 1)
-		{
-			m_pszText = static_cast<TextBuffer *>(
-				malloc(sizeof(TextBuffer) + nLength * sizeof(TCHAR)));
-			m_pszText->size = nLength;
-			memcpy(m_pszText->data, pszText, nLength * sizeof(TCHAR));
-			m_pszText->data[nLength] = _T('?'); // debug sentinel
-		}
-		else
-		{
-			m_szText[0] = pszText[0];
-		}
-	}
-}
-
-void UndoRecord::FreeText()
+/**
+ * @brief Store the revision numbers of the lines affected by the record.
+ */
+void UndoRecord::SetRevisionNumbers(UndoJournal &journal, const std::vector<DWORD> &revisions)
 {
-	// See the m_szText/m_pszText definition
-	// Check if m_pszText is a pointer by removing bits having
-	// possible char value
-	if (reinterpret_cast<UINT_PTR>(m_pszText) > 0xFFFF)
-		free(m_pszText);
-	m_pszText = NULL;
+	m_nRevisionCount = static_cast<int>(revisions.size());
+	m_revisions = journal.Append(revisions.data(), static_cast<UINT>(m_nRevisionCount * sizeof(DWORD)));
 }
 
-bool UndoRecord::VerifyText(const String &text) const
+bool UndoRecord::VerifyText(UndoJournal &journal, const String &text) const
 {
 	// Verify recorded text against passed-in text, regardless of the former's
 	// EOL style, but assuming the latter to follow Unix EOL style.
 	LPCTSTR p = text.c_str();
 	LPCTSTR r = p + text.length();
-	LPCTSTR p2 = GetText();
+	LPCTSTR p2 = GetText(journal);
 	LPCTSTR r2 = p2 + GetTextLength();
 	while (size_t n = r - p)
 	{
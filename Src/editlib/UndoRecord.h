@@ -6,77 +6,61 @@
  */
 #pragma once
 
+#include "UndoJournal.h"
+
 class UndoRecord
 {
 public:
 	DWORD m_dwFlags;
 	POINT m_ptStartPos, m_ptEndPos;  //  Block of text participating
 	int m_nAction;            //  For information only: action type
-	std::vector<DWORD> m_paSavedRevisonNumbers;
 
 private:
-	//  TCHAR   *m_pcText;
-	//  Since in most cases we have 1 character here,
-	//  we should invent a better way. Note: 2 * sizeof(WORD) <= sizeof(TCHAR*)
-	//
-	//  Here we will use the following trick: on Win32 platforms high-order word
-	//  of any pointer will be != 0. So we can store 1 character strings without
-	//  allocating memory.
-	//
-	struct TextBuffer
-	{
-		int size;
-		TCHAR data[1];
-	};
-
-	union
-	{
-		TextBuffer *m_pszText;     //  For cases when we have > 1 character strings
-		TCHAR m_szText[2];    //  For single-character strings
-	};
-
-	void Clone(const UndoRecord &);
+	//  Text and saved line revision numbers live in the undo journal of the
+	//  owning buffer, so the record itself needs no allocations.
+	UndoJournal::Entry m_text;
+	int m_nTextLength;
+	UndoJournal::Entry m_revisions;
+	int m_nRevisionCount;
 
 public:
 	UndoRecord() // default constructor
 		: m_dwFlags(0)
 		, m_nAction(0)
-		, m_pszText(NULL)
+		, m_nTextLength(0)
+		, m_nRevisionCount(0)
 	{
 	}
 
-	UndoRecord(const UndoRecord &src) // copy constructor
-		: m_pszText(NULL)
-		, m_paSavedRevisonNumbers(src.m_paSavedRevisonNumbers)
+	void SetText(UndoJournal &, LPCTSTR pszText, int cchText);
+	void SetRevisionNumbers(UndoJournal &, const std::vector<DWORD> &);
+	bool VerifyText(UndoJournal &, const String &) const;
+
+	/** @brief Return the text, valid until the journal is accessed again. */
+	LPCTSTR GetText(UndoJournal &journal) const
 	{
-		Clone(src);
+		return static_cast<LPCTSTR>(journal.Read(m_text, static_cast<UINT>(m_nTextLength * sizeof(TCHAR))));
 	}
 
-	UndoRecord & operator=(const UndoRecord &src) // copy assignment
+	int GetTextLength() const
 	{
-		Clone(src);
-		return *this;
+		return m_nTextLength;
 	}
 
-	~UndoRecord() // destructor
+	/** @brief Return the saved revision numbers, valid until the journal is accessed again. */
+	const DWORD *GetRevisionNumbers(UndoJournal &journal) const
 	{
-		FreeText();
+		return static_cast<const DWORD *>(journal.Read(m_revisions, static_cast<UINT>(m_nRevisionCount * sizeof(DWORD))));
 	}
 
-	void SetText(LPCTSTR pszText, int cchText);
-	void FreeText();
-	bool VerifyText(const String &) const;
-
-	LPCTSTR GetText() const
+	int GetRevisionCount() const
 	{
-		// See the m_szText/m_pszText definition
-		// Check if m_pszText is a pointer by removing bits having
-		// possible char value
-		return reinterpret_cast<UINT_PTR>(m_pszText) > 0xFFFF ? m_pszText->data : m_szText;
+		return m_nRevisionCount;
 	}
 
-	int GetTextLength() const
+	/** @brief Return the position of the first payload the record owns. */
+	const UndoJournal::Entry &GetJournalEntry() const
 	{
-		return reinterpret_cast<UINT_PTR>(m_pszText) > 0xFFFF ? m_pszText->size : 1;
+		return m_text;
 	}
 };
@@ -30,15 +30,18 @@ using HtmlKeywords::IsDtdAttrName;
 using HtmlKeywords::IsEntityName;
 
 // Tag names involved in support of XML syntax for JSP scripting elements
+static LPCTSTR const s_apszJspScriptingTagNameList[] =
+{
+	_T("jsp:declaration"),
+	_T("jsp:expression"),
+	_T("jsp:scriptlet"),
+};
+
+static KeywordHash<_tcsncmp> const s_JspScriptingTagNameHash(s_apszJspScriptingTagNameList);
+
 static BOOL IsJspScriptingTagName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszJspScriptingTagNameList[] =
-	{
-		_T("jsp:declaration"),
-		_T("jsp:expression"),
-		_T("jsp:scriptlet"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszJspScriptingTagNameList);
+	return s_JspScriptingTagNameHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
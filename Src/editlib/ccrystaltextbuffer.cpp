@@ -195,6 +195,7 @@ CCrystalTextBuffer::CCrystalTextBuffer()
 	m_nTabSize = 4;
 	m_bSeparateCombinedChars = false;
 	m_nParseCookieCount = 0;
+	m_nParseCookieHint = 0;
 	m_nModeLineOverrides = 0;
 	//BEGIN SW
 	m_ptLastChange.x = m_ptLastChange.y = -1;
@@ -280,6 +281,8 @@ void CCrystalTextBuffer::AppendLine(int nLineIndex, LPCTSTR pszChars, int nLengt
  */
 void CCrystalTextBuffer::MoveLine(int line1, int line2, int newline1)
 {
+	// Moved lines break the chain of cookies which are candidates for reuse
+	m_nParseCookieHint = m_nParseCookieCount;
 	int ldiff = newline1 - line1;
 	if (ldiff > 0) {
 		for (int l = line2; l >= line1; l--)
@@ -296,6 +299,8 @@ void CCrystalTextBuffer::FreeAll()
 	// Free text
 	std::for_each(m_aLines.begin(), m_aLines.end(), std::mem_fun_ref(&LineInfo::Clear));
 	m_aLines.clear();
+	m_nParseCookieCount = 0;
+	m_nParseCookieHint = 0;
 #ifdef _DEBUG
 	m_bInit = false;
 #endif
@@ -511,6 +516,7 @@ void CCrystalTextBuffer::SetParseCookieCount(int nParseCookieCount)
 {
 	ASSERT(nParseCookieCount >= 0 && nParseCookieCount <= GetLineCount());
 	m_nParseCookieCount = nParseCookieCount;
+	m_nParseCookieHint = nParseCookieCount;
 }
 
 void CCrystalTextBuffer::UpdateViews(CCrystalTextView *pSource, CUpdateContext *pContext, DWORD dwUpdateFlags, int nLineIndex)
@@ -549,6 +555,11 @@ void CCrystalTextBuffer::InternalDeleteText(CCrystalTextView *pSource,
 	ASSERT(nStartLine != nEndLine || nStartChar != nEndChar);
 	ASSERT(!m_bReadOnly);
 
+	// Cookies of lines below the deleted range remain candidates for reuse
+	if (m_nParseCookieCount > nEndLine + 1)
+		m_nParseCookieHint = m_nParseCookieCount - (nEndLine - nStartLine);
+	else if (m_nParseCookieHint > nStartLine + 1)
+		m_nParseCookieHint = nStartLine + 1;
 	if (m_nParseCookieCount > nStartLine)
 		m_nParseCookieCount = nStartLine + 1;
 
@@ -615,6 +626,7 @@ POINT CCrystalTextBuffer::InternalInsertText(CCrystalTextView *pSource,
 	ASSERT(nPos >= 0 && nPos <= m_aLines[nLine].Length());
 	ASSERT(!m_bReadOnly);
 
+	int const nParseCookieCount = m_nParseCookieCount;
 	if (m_nParseCookieCount > nLine)
 		m_nParseCookieCount = nLine + 1;
 
@@ -700,6 +712,12 @@ POINT CCrystalTextBuffer::InternalInsertText(CCrystalTextView *pSource,
 		cchText -= nTextPos;
 	}
 
+	// Cookies of lines below the inserted text remain candidates for reuse
+	if (nParseCookieCount > nLine + 1)
+		m_nParseCookieHint = nParseCookieCount + nInsertedLines;
+	else if (m_nParseCookieHint > nLine + 1)
+		m_nParseCookieHint = nLine + 1;
+
 	// Compute the context : all positions after context.m_ptBegin are
 	// shifted accordingly to (context.m_ptEnd - context.m_ptBegin)
 	// The begin point is the insertion point.
@@ -838,7 +856,7 @@ void CCrystalTextBuffer::FlushUndoGroup(CCrystalTextView *pSource)
 		if (m_nUndoPosition > 0)
 		{
 			const UndoRecord &undo = GetUndoRecord(m_nUndoPosition - 1);
-			pSource->OnEditOperation(undo.m_nAction, undo.GetText(), undo.GetTextLength());
+			pSource->OnEditOperation(undo.m_nAction, undo.GetText(m_UndoJournal), undo.GetTextLength());
 		}
 	}
 	m_bUndoGroup = FALSE;
@@ -1277,23 +1295,65 @@ void CCrystalTextBuffer::InitParseCookie()
 
 TextBlock::Cookie CCrystalTextBuffer::GetParseCookie(int nLineIndex)
 {
-	int const nLineCount = GetLineCount();
+	ASSERT(nLineIndex >= 0 && nLineIndex < GetLineCount());
 	int L = GetParseCookieCount() - 1;
-	LineInfo const &li = m_aLines[nLineIndex < L ? nLineIndex : L];
-	TextBlock::Cookie cookie = li.m_cookie;
+	if (L < nLineIndex)
+	{
+		int const nParseCookieHint = std::min(m_nParseCookieHint, GetLineCount());
+		TextBlock::Cookie cookie = m_aLines[L].m_cookie;
+		TextBlock::Array rBlocks(NULL);
+		do
+		{
+			ASSERT(!cookie.Empty());
+			ParseLine(cookie, L, rBlocks);
+			LineInfo &li = m_aLines[++L];
+			if (L < nParseCookieHint && li.m_cookie == cookie)
+			{
+				// Parser state has converged with what it was before the most
+				// recent edit, so the cookies beyond this line still hold
+				L = nParseCookieHint - 1;
+				cookie = m_aLines[L].m_cookie;
+			}
+			else
+			{
+				li.m_cookie = cookie;
+			}
+		} while (L < nLineIndex);
+		m_nParseCookieCount = L + 1;
+	}
+	return m_aLines[nLineIndex].m_cookie;
+}
+
+TextBlock::Cookie CCrystalTextBuffer::GetProvisionalParseCookie(int nLineIndex)
+{
+	ASSERT(nLineIndex >= 0 && nLineIndex < GetLineCount());
+	if (nLineIndex < GetParseCookieCount() + nParseCookieChunk)
+		return GetParseCookie(nLineIndex);
+	// Seed the parser with whatever cookie a nearby line happens to carry, or
+	// with the initial one, and hope for it to settle within a few lines
+	int L = nLineIndex - nParseCookieLookBehind;
+	TextBlock::Cookie cookie = m_aLines[L].m_cookie;
+	if (cookie.Empty())
+		cookie.m_dwCookie = m_CurSourceDef->flags & COOKIE_PARSER_GLOBAL;
 	TextBlock::Array rBlocks(NULL);
-	ASSERT(!cookie.Empty());
-	while (L < nLineIndex)
+	do
 	{
 		ParseLine(cookie, L, rBlocks);
-		ASSERT(!cookie.Empty());
-		if (++L < nLineCount)
-			m_aLines[L].m_cookie = cookie;
-	}
-	SetParseCookieCount(L < nLineCount ? L + 1 : nLineCount);
+	} while (++L < nLineIndex);
 	return cookie;
 }
 
+bool CCrystalTextBuffer::ParseCookiesAhead(int nLines)
+{
+	int const nLineCount = GetLineCount();
+	int const nParseCookieCount = GetParseCookieCount();
+	if (nParseCookieCount == 0 || nParseCookieCount >= nLineCount)
+		return false;
+	int const nLineIndex = nParseCookieCount - 1 + nLines;
+	GetParseCookie(nLineIndex < nLineCount ? nLineIndex : nLineCount - 1);
+	return GetParseCookieCount() < nLineCount;
+}
+
 void CCrystalTextBuffer::ParseLine(TextBlock::Cookie &cookie, int nLineIndex, TextBlock::Array &pBuf) const
 {
 	if (LPCTSTR const pszChars = GetLineChars(nLineIndex))
@@ -132,6 +132,12 @@ protected:
 	int m_nTabSize;
 	int m_nMaxLineLength;
 	int m_nParseCookieCount;
+	/**
+	 * Lines in [m_nParseCookieCount, m_nParseCookieHint) still carry the
+	 * cookies computed before the most recent edit. Once the parser state
+	 * converges with one of them, the remaining ones need not be recomputed.
+	 */
+	int m_nParseCookieHint;
 	int m_nModeLineOverrides;
 
 	enum
@@ -159,6 +165,8 @@ protected:
 	// Undo
 	virtual const UndoRecord &GetUndoRecord(stl_size_t i) const = 0;
 	virtual stl_size_t GetUndoRecordCount() const = 0;
+	/** @brief Storage for the text and revision numbers of undo records. */
+	UndoJournal m_UndoJournal;
 
 	stl_size_t m_nUndoPosition;
 	stl_size_t m_nSyncPosition;
@@ -335,6 +343,25 @@ public:
 	 */
 	TextBlock::Cookie GetParseCookie(int nLineIndex);
 
+	/**
+	 * @brief Estimate the parse cookie value of a line for rendering purpose.
+	 *
+	 * @note Lines too far beyond the computed cookies are seeded from a
+	 * nearby line rather than parsing all the way down to them.
+	 */
+	TextBlock::Cookie GetProvisionalParseCookie(int nLineIndex);
+
+	/**
+	 * @brief Compute the parse cookies of the next chunk of lines.
+	 * @return Whether there are lines left whose cookies are yet to be computed.
+	 */
+	bool ParseCookiesAhead(int nLines = nParseCookieChunk);
+
+	/** @brief Number of lines to parse per chunk when computing cookies ahead. */
+	static int const nParseCookieChunk = 4096;
+	/** @brief Number of lines to parse when estimating a provisional cookie. */
+	static int const nParseCookieLookBehind = 256;
+
 	void ParseLine(TextBlock::Cookie &cookie, int nLineIndex, TextBlock::Array &pBuf) const;
 
 private:
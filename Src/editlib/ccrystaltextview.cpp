@@ -257,7 +257,6 @@ LRESULT CCrystalTextView::WindowProc(UINT uMsg, WPARAM wParam, LPARAM lParam)
 CCrystalTextView::CCrystalTextView(HWindow *pWnd, size_t ZeroInit)
 : H2O::ZeroInit<CCrystalTextView>(ZeroInit)
 , m_bSelMargin(true)
-, m_nLastLineIndexCalculatedSubLineIndex(-1)
 {
 	Subclass(pWnd);
 	CCrystalTextView::ResetView();
@@ -1042,27 +1041,62 @@ void CCrystalTextView::WrapLineCached(int nLineIndex, int *anBreaks, int &nBreak
 
 void CCrystalTextView::InvalidateLineCache(int nLineIndex1, int nLineIndex2)
 {
+	if (nLineIndex2 != -1 && nLineIndex1 > nLineIndex2)
+		eastl::swap(nLineIndex1, nLineIndex2);
 	// invalidate cached sub line index
-	InvalidateSubLineIndexCache(nLineIndex1);
+	InvalidateSubLineIndexCache(nLineIndex1, nLineIndex2);
 	// invalidate cached sub line count
 	if (nLineIndex2 == -1)
 		nLineIndex2 = upperBound(m_panSubLines);
-	else if (nLineIndex1 > nLineIndex2)
-		eastl::swap(nLineIndex1, nLineIndex2);
 	if (nLineIndex2 > upperBound(m_panSubLines))
 		nLineIndex2 = upperBound(m_panSubLines);
 	for (int i = nLineIndex1; i <= nLineIndex2; i++)
 		m_panSubLines[i] = -1;
+	InvalidateRenderCache(nLineIndex1, nLineIndex2);
+}
+
+/**
+ * @brief Drop cached color runs for the given range of lines.
+ * @param [in] nLineIndex1 Index of the first line to invalidate.
+ * @param [in] nLineIndex2 Index of the last line to invalidate, or -1 for
+ *  all lines from nLineIndex1 to the end.
+ */
+void CCrystalTextView::InvalidateRenderCache(int nLineIndex1, int nLineIndex2)
+{
+	if (m_pRenderCache == NULL)
+		return;
+	for (int i = 0; i < RENDER_CACHE_SIZE; ++i)
+	{
+		RenderCacheEntry &entry = m_pRenderCache[i];
+		if (entry.nLineIndex >= nLineIndex1 &&
+			(nLineIndex2 == -1 || entry.nLineIndex <= nLineIndex2))
+		{
+			entry.nLineIndex = -1;
+		}
+	}
 }
 
 /**
- * @brief Invalidate sub line index cache from the specified index to the end of file.
- * @param [in] nLineIndex Index of the first line to invalidate
+ * @brief Invalidate sub line counts of the specified range of lines.
+ * The counts are kept as estimates until the lines are wrapped again. If the
+ * number of lines has changed, lines are taken as inserted or removed just
+ * after nLineIndex1, which is where edits report their changes.
+ * @param [in] nLineIndex1 Index of the first line to invalidate
+ * @param [in] nLineIndex2 Index of the last line to invalidate, or -1 for
+ *  all lines from nLineIndex1 to the end.
  */
-void CCrystalTextView::InvalidateSubLineIndexCache(int nLineIndex)
+void CCrystalTextView::InvalidateSubLineIndexCache(int nLineIndex1, int nLineIndex2)
 {
-	if (m_nLastLineIndexCalculatedSubLineIndex >= nLineIndex)
-		m_nLastLineIndexCalculatedSubLineIndex = nLineIndex - 1;
+	// nothing to keep if no sub line has been looked up so far
+	if (m_aSubLineCounts.GetCount() == 0)
+		return;
+	ResizeSubLineCounts(nLineIndex1 + 1);
+	int const nCount = m_aSubLineCounts.GetCount();
+	if (nLineIndex2 == -1 || nLineIndex2 >= nCount)
+		nLineIndex2 = nCount - 1;
+	m_aSubLineCounts.MarkEstimated(nLineIndex1, nLineIndex2 - nLineIndex1 + 1);
+	if (m_nFirstEstimatedSubLine > nLineIndex1)
+		m_nFirstEstimatedSubLine = nLineIndex1;
 }
 
 /**
@@ -1072,7 +1106,13 @@ void CCrystalTextView::InvalidateScreenRect()
 {
 	RECT rect;
 	GetClientRect(&rect);
-	m_nScreenChars = (rect.right - rect.left - GetMarginWidth()) / GetCharWidth();
+	int const nScreenChars = (rect.right - rect.left - GetMarginWidth()) / GetCharWidth();
+	if (m_nScreenChars != nScreenChars)
+	{
+		m_nScreenChars = nScreenChars;
+		// sub line counts for a different width make poor estimates
+		m_aSubLineCounts.Clear();
+	}
 	m_nScreenLines = (rect.bottom - rect.top - GetTopMarginHeight()) / GetLineHeight();
 	InvalidateLineCache(0, -1);
 }
@@ -1253,6 +1293,62 @@ void CCrystalTextView::MergeTextBlocks(TextBlock::Array &pBuf1, TextBlock::Array
 	TextBlock::Array(NULL).swap(pBuf2); // micro-optimize memory footprint
 }
 
+/**
+ * @brief Get the color runs of a line, reusing the cached ones if possible.
+ * @param [in] nLineIndex Index of the line.
+ * @return Color runs, owned by the render cache.
+ * @note The returned array remains valid until the next call.
+ */
+TextBlock::Array &CCrystalTextView::GetTextBlocks(int nLineIndex)
+{
+	if (m_pRenderCache == NULL)
+		m_pRenderCache.reset(new RenderCacheEntry[RENDER_CACHE_SIZE]);
+	RenderCacheEntry &entry = m_pRenderCache[nLineIndex % RENDER_CACHE_SIZE];
+
+	LineInfo const &li = m_pTextBuffer->GetLineInfo(nLineIndex);
+	LPCTSTR const pszChars = li.GetLine();
+	int const nLength = GetViewableLineLength(nLineIndex);
+	TextBlock::Cookie const cookie = m_pTextBuffer->GetProvisionalParseCookie(nLineIndex);
+	if (nLineIndex >= m_pTextBuffer->GetParseCookieCount())
+		m_bProvisionalParseCookies = true;
+	DWORD const dwAdditionalKey = GetAdditionalTextBlocksKey(nLineIndex);
+
+	if (entry.nLineIndex == nLineIndex &&
+		entry.pszChars == pszChars &&
+		entry.nLength == nLength &&
+		entry.dwFlags == li.m_dwFlags &&
+		entry.dwRevisionNumber == li.m_dwRevisionNumber &&
+		entry.dwAdditionalKey == dwAdditionalKey &&
+		entry.cookie == cookie &&
+		entry.pSourceDef == m_pTextBuffer->m_CurSourceDef)
+	{
+		return entry.pBuf;
+	}
+
+	TextBlock::Array pBuf(new TextBlock[nLength + 1]); // be aware of nLength == 0
+	// insert at least one textblock of normal color at the beginning
+	pBuf[0].m_nCharPos = 0;
+	pBuf[0].m_nColorIndex = COLORINDEX_NORMALTEXT;
+	pBuf[0].m_nBgColorIndex = COLORINDEX_BKGND;
+	TextBlock::Cookie cookieParse = cookie;
+	m_pTextBuffer->ParseLine(cookieParse, nLineIndex, pBuf);
+
+	TextBlock::Array pAddedBuf(NULL);
+	GetAdditionalTextBlocks(nLineIndex, pAddedBuf);
+	MergeTextBlocks(pBuf, pAddedBuf);
+
+	entry.pBuf.swap(pBuf);
+	entry.nLineIndex = nLineIndex;
+	entry.pszChars = pszChars;
+	entry.nLength = nLength;
+	entry.dwFlags = li.m_dwFlags;
+	entry.dwRevisionNumber = li.m_dwRevisionNumber;
+	entry.dwAdditionalKey = dwAdditionalKey;
+	entry.cookie = cookie;
+	entry.pSourceDef = m_pTextBuffer->m_CurSourceDef;
+	return entry.pBuf;
+}
+
 bool CCrystalTextView::DrawSingleLine(HSurface *pdc, const RECT &rc, int nLineIndex)
 {
 	ASSERT(nLineIndex >= 0 && nLineIndex < GetLineCount());
@@ -1266,16 +1362,7 @@ bool CCrystalTextView::DrawSingleLine(HSurface *pdc, const RECT &rc, int nLineIn
 		int const nLength = GetViewableLineLength(nLineIndex);
 
 		// Parse the line
-		TextBlock::Array pBuf(new TextBlock[nLength + 1]); // be aware of nLength == 0
-		// insert at least one textblock of normal color at the beginning
-		pBuf[0].m_nCharPos = 0;
-		pBuf[0].m_nColorIndex = COLORINDEX_NORMALTEXT;
-		pBuf[0].m_nBgColorIndex = COLORINDEX_BKGND;
-		m_pTextBuffer->ParseLine(m_pTextBuffer->GetParseCookie(nLineIndex), nLineIndex, pBuf);
-
-		TextBlock::Array pAddedBuf(NULL);
-		GetAdditionalTextBlocks(nLineIndex, pAddedBuf);
-		MergeTextBlocks(pBuf, pAddedBuf);
+		TextBlock::Array &pBuf = GetTextBlocks(nLineIndex);
 
 		int nActualItem = 0;
 		int nActualOffset = 0;
@@ -1782,6 +1869,12 @@ void CCrystalTextView::OnDraw(HSurface *pdc)
 	rcClient.bottom = rcClient.top + nTopMarginHeight;
 	if (pdc->RectVisible(&rcClient))
 		DrawTopMargin(pdc, rcClient);
+	// Let the remaining parse cookies be computed in chunks while idle
+	if (m_pTextBuffer && m_pTextBuffer->GetParseCookieCount() < nLineCount)
+		SetTimer(m_nParseCookieTimer, 10);
+	// Let the estimated sub line counts be replaced in chunks while idle
+	if (m_bWordWrap && m_nFirstEstimatedSubLine < nLineCount)
+		SetTimer(m_nSubLineTimer, 10);
 }
 
 void CCrystalTextView::ResetView()
@@ -1804,6 +1897,14 @@ void CCrystalTextView::ResetView()
 		KillTimer(m_nDragSelTimer);
 	}
 	m_bDragSelection = false;
+	if (m_hWnd)
+	{
+		KillTimer(m_nParseCookieTimer);
+		KillTimer(m_nSubLineTimer);
+	}
+	m_bProvisionalParseCookies = false;
+	m_aSubLineCounts.Clear();
+	InvalidateRenderCache();
 	if (m_pTextBuffer)
 	{
 		m_pTextBuffer->InitParseCookie();
@@ -1951,7 +2052,9 @@ int CCrystalTextView::GetSubLines(int nLineIndex)
 	// get a number of lines this wrapped lines contains
 	int nBreaks = 0;
 	WrapLineCached(nLineIndex, NULL, nBreaks);
-	return GetEmptySubLines(nLineIndex) + nBreaks + 1;
+	int const nSubLines = GetEmptySubLines(nLineIndex) + nBreaks + 1;
+	UpdateSubLineCount(nLineIndex, nSubLines);
+	return nSubLines;
 }
 
 int CCrystalTextView::GetEmptySubLines(int nLineIndex)
@@ -1959,6 +2062,90 @@ int CCrystalTextView::GetEmptySubLines(int nLineIndex)
 	return 0;
 }
 
+/**
+ * @brief Estimate the number of sublines of a line from its length.
+ * Serves for lines which have not been wrapped yet. Views which add empty
+ * sublines to align with other views estimate those as well.
+ */
+int CCrystalTextView::EstimateSubLines(int nLineIndex)
+{
+	int const nLength = GetLineLength(nLineIndex);
+	return m_nScreenChars > 0 ? nLength / m_nScreenChars + 1 : 1;
+}
+
+/**
+ * @brief Bring the number of sub line counts in line with the number of
+ * lines, by inserting or removing counts at the given line.
+ * @param [in] nLineIndex Index of the first inserted or removed line. Values
+ *  beyond the end refer to the end.
+ */
+void CCrystalTextView::ResizeSubLineCounts(int nLineIndex)
+{
+	int const nLineCount = GetLineCount();
+	int const nCount = m_aSubLineCounts.GetCount();
+	if (nCount == nLineCount)
+		return;
+	if (nLineIndex > nCount)
+		nLineIndex = nCount;
+	if (nLineCount > nCount)
+	{
+		int const nInserted = nLineCount - nCount;
+		m_aSubLineCounts.Insert(nLineIndex, nInserted);
+		for (int i = nLineIndex; i < nLineIndex + nInserted; ++i)
+			m_aSubLineCounts.Set(i, -EstimateSubLines(i));
+	}
+	else
+	{
+		if (nLineIndex > nLineCount)
+			nLineIndex = nLineCount;
+		m_aSubLineCounts.Erase(nLineIndex, nCount - nLineCount);
+	}
+	if (m_nFirstEstimatedSubLine > nLineIndex)
+		m_nFirstEstimatedSubLine = nLineIndex;
+}
+
+/**
+ * @brief Record the exact number of sublines of a line, unless the subline
+ * index is out of sync with the lines.
+ * @return The difference to the number of sublines accounted for so far.
+ */
+int CCrystalTextView::UpdateSubLineCount(int nLineIndex, int nSubLines)
+{
+	int const nCount = m_aSubLineCounts.GetCount();
+	if (nLineIndex >= nCount || nCount != GetLineCount())
+		return 0;
+	return m_aSubLineCounts.Set(nLineIndex, nSubLines);
+}
+
+/**
+ * @brief Wrap a chunk of the lines whose sub line counts are estimated.
+ * @return Whether lines with estimated sub line counts remain.
+ */
+bool CCrystalTextView::WrapLinesAhead()
+{
+	if (!m_bWordWrap)
+		return false;
+	ResizeSubLineCounts(INT_MAX);
+	int const nLineCount = GetLineCount();
+	int nLineIndex = m_nFirstEstimatedSubLine;
+	int const nEndLine = std::min(nLineIndex + 4096, nLineCount);
+	while (nLineIndex < nEndLine)
+	{
+		int const nCount = m_aSubLineCounts.Get(nLineIndex);
+		if (nCount < 0)
+		{
+			int const nEstimate = -nCount;
+			int const nDelta = GetSubLines(nLineIndex) - nEstimate;
+			// keep the same line at the top of the screen
+			if (nLineIndex < m_nTopLine)
+				m_nTopSubLine += nDelta;
+		}
+		++nLineIndex;
+	}
+	m_nFirstEstimatedSubLine = nLineIndex;
+	return nLineIndex < nLineCount;
+}
+
 bool CCrystalTextView::IsEmptySubLineIndex(int nSubLineIndex)
 {
 	int nLineIndex;
@@ -2257,9 +2444,8 @@ int CCrystalTextView::GetSubLineCount()
 	if (!m_bWordWrap)
 		return nLineCount;
 	// calculate number of sub lines
-	if (nLineCount <= 0)
-		return 0;
-	return GetSubLineIndex(nLineCount - 1) + GetSubLines(nLineCount - 1);
+	ResizeSubLineCounts(INT_MAX);
+	return m_aSubLineCounts.GetTotal();
 }
 
 int CCrystalTextView::GetSubLineIndex(int nLineIndex)
@@ -2269,36 +2455,13 @@ int CCrystalTextView::GetSubLineIndex(int nLineIndex)
 		return nLineIndex;
 
 	// calculate subline index of the line
-	int	nSubLineCount = 0;
-	int nLineCount = GetLineCount();
-
+	int const nLineCount = GetLineCount();
 	if (nLineIndex >= nLineCount)
 		nLineIndex = nLineCount - 1;
 
-	// return cached subline index of the line if it is already cached.
-	if (nLineIndex <= m_nLastLineIndexCalculatedSubLineIndex)
-		return m_panSubLineIndexCache[nLineIndex];
-
-	// calculate subline index of the line and cache it.
-	if (m_nLastLineIndexCalculatedSubLineIndex >= 0)
-	{
-		nSubLineCount = m_panSubLineIndexCache[m_nLastLineIndexCalculatedSubLineIndex];
-	}
-	else
-	{
-		m_nLastLineIndexCalculatedSubLineIndex = 0;
-		setAtGrow(m_panSubLineIndexCache, 0, 0);
-	}
-
-	for (int i = m_nLastLineIndexCalculatedSubLineIndex; i < nLineIndex; i++)
-	{
-		setAtGrow(m_panSubLineIndexCache, i, nSubLineCount);
-		nSubLineCount += GetSubLines(i);
-	}
-	setAtGrow(m_panSubLineIndexCache, nLineIndex, nSubLineCount);
-	m_nLastLineIndexCalculatedSubLineIndex = nLineIndex;
-
-	return nSubLineCount;
+	// sum up the sublines of preceding lines
+	ResizeSubLineCounts(INT_MAX);
+	return m_aSubLineCounts.GetSubLineIndex(nLineIndex);
 }
 
 // See comment in the header file
@@ -2314,22 +2477,21 @@ int CCrystalTextView::GetLineBySubLine(int nSubLineIndex, int &nLine)
 	}
 
 	// compute result
-	int nSubLineCount = 0;
-	int nLastSubLines = 0;
+	ResizeSubLineCounts(INT_MAX);
 	int const nLineCount = GetLineCount();
-
-	int i = 0;
-	for (i = 0; i < nLineCount; i++)
+	int nSubLine;
+	int i;
+	do
 	{
-		nLastSubLines = GetSubLines(i);
-		nSubLineCount += nLastSubLines;
-		if (nSubLineCount > nSubLineIndex)
-			break;
-	}
+		nSubLine = nSubLineIndex;
+		i = m_aSubLineCounts.FindSubLine(nSubLine);
+		// wrap the line if its count is estimated, and search again if the
+		// subline turns out to be beyond it
+	} while (i < nLineCount && nSubLine >= GetSubLines(i));
 
 	ASSERT(i < nLineCount);
 	nLine = i;
-	return nSubLineIndex - nSubLineCount + nLastSubLines;
+	return nSubLine;
 }
 
 int CCrystalTextView::GetLineLength(int nLineIndex) const
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "LineInfo.h"
+#include "SubLineIndex.h"
 #include "string_util.h"
 
 ////////////////////////////////////////////////////////////////////////////
@@ -106,9 +107,39 @@ private:
 	initialize the member objects. This would destroy a CArray object.
 	*/
 	std::vector<int> m_panSubLines;
-	std::vector<int> m_panSubLineIndexCache;
-	int m_nLastLineIndexCalculatedSubLineIndex;
+	/**
+	Contains for each line the number of sublines, including empty sublines,
+	and serves subline index lookups. A negative value means that the line
+	has changed since it was last wrapped, and that its negation is an
+	estimate of the number of sublines.
+	*/
+	SubLineIndex m_aSubLineCounts;
+	/** All lines before this one have exact sub line counts. */
+	int m_nFirstEstimatedSubLine;
 	//END SW
+
+	/**
+	 * @brief Cached color runs (syntax + additional blocks) of a line.
+	 * An entry is valid as long as its key matches the current state of the
+	 * line it was computed from.
+	 */
+	struct RenderCacheEntry
+	{
+		RenderCacheEntry() : pBuf(NULL), nLineIndex(-1) { }
+		TextBlock::Array pBuf;
+		int nLineIndex;
+		LPCTSTR pszChars;
+		int nLength;
+		DWORD dwFlags;
+		DWORD dwRevisionNumber;
+		DWORD dwAdditionalKey;
+		TextBlock::Cookie cookie;
+		TextDefinition const *pSourceDef;
+	};
+	/** @brief Number of entries in the direct-mapped render cache. */
+	static int const RENDER_CACHE_SIZE = 512;
+	/** @brief Render cache, indexed by line index modulo RENDER_CACHE_SIZE. */
+	scoped_array<RenderCacheEntry> m_pRenderCache;
 
 	int m_nIdealCharPos;
 
@@ -143,6 +174,10 @@ protected:
 	bool m_bDragSelection, m_bWordSelection, m_bLineSelection;
 	static UINT_PTR const m_nDragSelTimer = 1001;
 	static UINT_PTR const m_nTripleClickTimer = 1002;
+	static UINT_PTR const m_nParseCookieTimer = 1003;
+	static UINT_PTR const m_nSubLineTimer = 1004;
+	/** @brief Some lines have been drawn with provisional parse cookies. */
+	bool m_bProvisionalParseCookies;
 
 	POINT m_ptDrawSelStart, m_ptDrawSelEnd;
 	POINT m_ptAnchor;
@@ -257,6 +292,10 @@ protected:
 	int GetSubLines(int nLineIndex);
 
 	virtual int GetEmptySubLines(int nLineIndex);
+	virtual int EstimateSubLines(int nLineIndex);
+	void ResizeSubLineCounts(int nLineIndex);
+	virtual int UpdateSubLineCount(int nLineIndex, int nSubLines);
+	bool WrapLinesAhead();
 	bool IsEmptySubLineIndex(int nSubLineIndex);
 
 	/**
@@ -504,7 +543,7 @@ protected:
 	-1 (default) all lines from nLineIndex1 to the end are invalidated.
 	*/
 	virtual void InvalidateLineCache(int nLineIndex1, int nLineIndex2);
-	virtual void InvalidateSubLineIndexCache(int nLineIndex1);
+	virtual void InvalidateSubLineIndexCache(int nLineIndex1, int nLineIndex2);
 	void InvalidateScreenRect();
 	//END SW
 
@@ -520,12 +559,17 @@ protected:
 
 	void MergeTextBlocks(TextBlock::Array &pBuf1, TextBlock::Array &pBuf2);
 	virtual void GetAdditionalTextBlocks(int nLineIndex, TextBlock::Array &pBuf) = 0;
+	/** @brief Return a value which changes whenever the additional text blocks of a line would change. */
+	virtual DWORD GetAdditionalTextBlocksKey(int nLineIndex) { return 0; }
+	TextBlock::Array &GetTextBlocks(int nLineIndex);
 
 public:
 	void GetHTMLLine(int nLineIndex, String &);
 	void GetHTMLStyles(String &);
 	void GetHTMLAttribute(int nColorIndex, int nBgColorIndex, COLORREF crText, COLORREF crBkgnd, String &);
 
+	void InvalidateRenderCache(int nLineIndex1 = 0, int nLineIndex2 = -1);
+
 	void GoToLine(int nLine, bool bRelative);
 	// Attributes
 public:
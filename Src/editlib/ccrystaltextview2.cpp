@@ -787,6 +787,29 @@ void CCrystalTextView::OnTimer(UINT_PTR nIDEvent)
 	{
 		KillTimer(m_nTripleClickTimer);
 	}
+	else if (nIDEvent == m_nParseCookieTimer)
+	{
+		bool const bMore = m_pTextBuffer != NULL && m_pTextBuffer->ParseCookiesAhead();
+		if (!bMore)
+			KillTimer(m_nParseCookieTimer);
+		// Redraw lines which have been drawn with provisional parse cookies
+		// once the computed cookies have caught up with them
+		if (m_bProvisionalParseCookies && (!bMore ||
+			m_pTextBuffer->GetParseCookieCount() > m_nTopLine + GetScreenLines()))
+		{
+			m_bProvisionalParseCookies = false;
+			Invalidate();
+		}
+	}
+	else if (nIDEvent == m_nSubLineTimer)
+	{
+		if (!WrapLinesAhead())
+		{
+			KillTimer(m_nSubLineTimer);
+			// The scroll range is exact now
+			RecalcVertScrollBar();
+		}
+	}
 }
 
 /**
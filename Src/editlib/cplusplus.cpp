@@ -35,201 +35,207 @@
 using CommonKeywords::IsNumeric;
 
 // C++ keywords (MSVC5.0 + POET5.0)
+static LPCTSTR const s_apszCppKeywordList[] =
+{
+	_T("__asm"),
+	_T("__based"),
+	_T("__cdecl"),
+	_T("__declspec"),
+	_T("__except"),
+	_T("__export"),
+	_T("__far16"),
+	_T("__fastcall"),
+	_T("__finally"),
+	_T("__inline"),
+	_T("__int16"),
+	_T("__int32"),
+	_T("__int64"),
+	_T("__int8"),
+	_T("__leave"),
+	_T("__multiple_inheritance"),
+	_T("__pascal"),
+	_T("__single_inheritance"),
+	_T("__stdcall"),
+	_T("__syscall"),
+	_T("__try"),
+	_T("__uuidof"),
+	_T("__virtual_inheritance"),
+	_T("_asm"),
+	_T("_cdecl"),
+	_T("_export"),
+	_T("_far16"),
+	_T("_fastcall"),
+	_T("_pascal"),
+	_T("_persistent"),
+	_T("_stdcall"),
+	_T("_syscall"),
+	_T("alignas"),
+	_T("alignof"),
+	_T("auto"),
+	_T("bool"),
+	_T("break"),
+	_T("case"),
+	_T("catch"),
+	_T("char"),
+	_T("char16_t"),
+	_T("char32_t"),
+	_T("class"),
+	_T("const"),
+	_T("const_cast"),
+	_T("constexpr"),
+	_T("continue"),
+	_T("cset"),
+	_T("decltype"),
+	_T("default"),
+	_T("delete"),
+	_T("depend"),
+	_T("dllexport"),
+	_T("dllimport"),
+	_T("do"),
+	_T("double"),
+	_T("dynamic_cast"),
+	_T("else"),
+	_T("enum"),
+	_T("explicit"),
+	_T("extern"),
+	_T("false"),
+	_T("float"),
+	_T("for"),
+	_T("friend"),
+	_T("goto"),
+	_T("if"),
+	_T("indexdef"),
+	_T("inline"),
+	_T("int"),
+	_T("interface"),
+	_T("long"),
+	_T("main"),
+	_T("mutable"),
+	_T("naked"),
+	_T("namespace"),
+	_T("new"),
+	_T("noexcept"),
+	_T("nullptr"),
+	_T("ondemand"),
+	_T("operator"),
+	_T("persistent"),
+	_T("private"),
+	_T("protected"),
+	_T("public"),
+	_T("register"),
+	_T("reinterpret_cast"),
+	_T("return"),
+	_T("short"),
+	_T("signed"),
+	_T("sizeof"),
+	_T("static"),
+	_T("static_assert"),
+	_T("static_cast"),
+	_T("struct"),
+	_T("switch"),
+	_T("template"),
+	_T("this"),
+	_T("thread"),
+	_T("thread_local"),
+	_T("throw"),
+	_T("transient"),
+	_T("true"),
+	_T("try"),
+	_T("typedef"),
+	_T("typeid"),
+	_T("typename"),
+	_T("union"),
+	_T("unsigned"),
+	_T("useindex"),
+	_T("using"),
+	_T("uuid"),
+	_T("virtual"),
+	_T("void"),
+	_T("volatile"),
+	_T("while"),
+	_T("wmain"),
+	_T("xalloc"),
+};
+
+static KeywordHash<_tcsncmp> const s_CppKeywordHash(s_apszCppKeywordList);
+
 static BOOL IsCppKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszCppKeywordList[] =
-	{
-		_T("__asm"),
-		_T("__based"),
-		_T("__cdecl"),
-		_T("__declspec"),
-		_T("__except"),
-		_T("__export"),
-		_T("__far16"),
-		_T("__fastcall"),
-		_T("__finally"),
-		_T("__inline"),
-		_T("__int16"),
-		_T("__int32"),
-		_T("__int64"),
-		_T("__int8"),
-		_T("__leave"),
-		_T("__multiple_inheritance"),
-		_T("__pascal"),
-		_T("__single_inheritance"),
-		_T("__stdcall"),
-		_T("__syscall"),
-		_T("__try"),
-		_T("__uuidof"),
-		_T("__virtual_inheritance"),
-		_T("_asm"),
-		_T("_cdecl"),
-		_T("_export"),
-		_T("_far16"),
-		_T("_fastcall"),
-		_T("_pascal"),
-		_T("_persistent"),
-		_T("_stdcall"),
-		_T("_syscall"),
-		_T("alignas"),
-		_T("alignof"),
-		_T("auto"),
-		_T("bool"),
-		_T("break"),
-		_T("case"),
-		_T("catch"),
-		_T("char"),
-		_T("char16_t"),
-		_T("char32_t"),
-		_T("class"),
-		_T("const"),
-		_T("const_cast"),
-		_T("constexpr"),
-		_T("continue"),
-		_T("cset"),
-		_T("decltype"),
-		_T("default"),
-		_T("delete"),
-		_T("depend"),
-		_T("dllexport"),
-		_T("dllimport"),
-		_T("do"),
-		_T("double"),
-		_T("dynamic_cast"),
-		_T("else"),
-		_T("enum"),
-		_T("explicit"),
-		_T("extern"),
-		_T("false"),
-		_T("float"),
-		_T("for"),
-		_T("friend"),
-		_T("goto"),
-		_T("if"),
-		_T("indexdef"),
-		_T("inline"),
-		_T("int"),
-		_T("interface"),
-		_T("long"),
-		_T("main"),
-		_T("mutable"),
-		_T("naked"),
-		_T("namespace"),
-		_T("new"),
-		_T("noexcept"),
-		_T("nullptr"),
-		_T("ondemand"),
-		_T("operator"),
-		_T("persistent"),
-		_T("private"),
-		_T("protected"),
-		_T("public"),
-		_T("register"),
-		_T("reinterpret_cast"),
-		_T("return"),
-		_T("short"),
-		_T("signed"),
-		_T("sizeof"),
-		_T("static"),
-		_T("static_assert"),
-		_T("static_cast"),
-		_T("struct"),
-		_T("switch"),
-		_T("template"),
-		_T("this"),
-		_T("thread"),
-		_T("thread_local"),
-		_T("throw"),
-		_T("transient"),
-		_T("true"),
-		_T("try"),
-		_T("typedef"),
-		_T("typeid"),
-		_T("typename"),
-		_T("union"),
-		_T("unsigned"),
-		_T("useindex"),
-		_T("using"),
-		_T("uuid"),
-		_T("virtual"),
-		_T("void"),
-		_T("volatile"),
-		_T("while"),
-		_T("wmain"),
-		_T("xalloc"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszCppKeywordList);
+	return s_CppKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("BOOL"),
+	_T("BSTR"),
+	_T("BYTE"),
+	_T("CHAR"),
+	_T("COLORREF"),
+	_T("DWORD"),
+	_T("DWORD32"),
+	_T("FALSE"),
+	_T("HANDLE"),
+	_T("INT"),
+	_T("INT16"),
+	_T("INT32"),
+	_T("INT64"),
+	_T("INT8"),
+	_T("LONG"),
+	_T("LPARAM"),
+	_T("LPBOOL"),
+	_T("LPBYTE"),
+	_T("LPCBYTE"),
+	_T("LPCSTR"),
+	_T("LPCTSTR"),
+	_T("LPCVOID"),
+	_T("LPCWSTR"),
+	_T("LPDWORD"),
+	_T("LPINT"),
+	_T("LPLONG"),
+	_T("LPRECT"),
+	_T("LPSTR"),
+	_T("LPTSTR"),
+	_T("LPVOID"),
+	_T("LPWORD"),
+	_T("LPWSTR"),
+	_T("LRESULT"),
+	_T("PBOOL"),
+	_T("PBYTE"),
+	_T("PDWORD"),
+	_T("PDWORD32"),
+	_T("PINT"),
+	_T("PINT16"),
+	_T("PINT32"),
+	_T("PINT64"),
+	_T("PINT8"),
+	_T("POSITION"),
+	_T("PUINT"),
+	_T("PUINT16"),
+	_T("PUINT32"),
+	_T("PUINT64"),
+	_T("PUINT8"),
+	_T("PULONG32"),
+	_T("PWORD"),
+	_T("TCHAR"),
+	_T("TRUE"),
+	_T("UINT"),
+	_T("UINT16"),
+	_T("UINT32"),
+	_T("UINT64"),
+	_T("UINT8"),
+	_T("ULONG32"),
+	_T("VOID"),
+	_T("WCHAR"),
+	_T("WNDPROC"),
+	_T("WORD"),
+	_T("WPARAM"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("BOOL"),
-		_T("BSTR"),
-		_T("BYTE"),
-		_T("CHAR"),
-		_T("COLORREF"),
-		_T("DWORD"),
-		_T("DWORD32"),
-		_T("FALSE"),
-		_T("HANDLE"),
-		_T("INT"),
-		_T("INT16"),
-		_T("INT32"),
-		_T("INT64"),
-		_T("INT8"),
-		_T("LONG"),
-		_T("LPARAM"),
-		_T("LPBOOL"),
-		_T("LPBYTE"),
-		_T("LPCBYTE"),
-		_T("LPCSTR"),
-		_T("LPCTSTR"),
-		_T("LPCVOID"),
-		_T("LPCWSTR"),
-		_T("LPDWORD"),
-		_T("LPINT"),
-		_T("LPLONG"),
-		_T("LPRECT"),
-		_T("LPSTR"),
-		_T("LPTSTR"),
-		_T("LPVOID"),
-		_T("LPWORD"),
-		_T("LPWSTR"),
-		_T("LRESULT"),
-		_T("PBOOL"),
-		_T("PBYTE"),
-		_T("PDWORD"),
-		_T("PDWORD32"),
-		_T("PINT"),
-		_T("PINT16"),
-		_T("PINT32"),
-		_T("PINT64"),
-		_T("PINT8"),
-		_T("POSITION"),
-		_T("PUINT"),
-		_T("PUINT16"),
-		_T("PUINT32"),
-		_T("PUINT64"),
-		_T("PUINT8"),
-		_T("PULONG32"),
-		_T("PWORD"),
-		_T("TCHAR"),
-		_T("TRUE"),
-		_T("UINT"),
-		_T("UINT16"),
-		_T("UINT32"),
-		_T("UINT64"),
-		_T("UINT8"),
-		_T("ULONG32"),
-		_T("VOID"),
-		_T("WCHAR"),
-		_T("WNDPROC"),
-		_T("WORD"),
-		_T("WPARAM"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -35,96 +35,99 @@
 using CommonKeywords::IsNumeric;
 
 // C# keywords
+static LPCTSTR const s_apszCSharpKeywordList[] =
+{
+	_T("abstract"),
+	_T("as"),
+	_T("async"),
+	_T("await"),
+	_T("base"),
+	_T("bool"),
+	_T("break"),
+	_T("byte"),
+	_T("case"),
+	_T("catch"),
+	_T("char"),
+	_T("checked"),
+	_T("class"),
+	_T("const"),
+	_T("continue"),
+	_T("decimal"),
+	_T("default"),
+	_T("delegate"),
+	_T("do"),
+	_T("double"),
+	_T("else"),
+	_T("enum"),
+	_T("event"),
+	_T("exdouble"),
+	_T("exfloat"),
+	_T("explicit"),
+	_T("extern"),
+	_T("false"),
+	_T("finally"),
+	_T("fixed"),
+	_T("float"),
+	_T("for"),
+	_T("foreach"),
+	_T("get"),
+	_T("goto"),
+	_T("if"),
+	_T("implicit"),
+	_T("in"),
+	_T("int"),
+	_T("interface"),
+	_T("internal"),
+	_T("is"),
+	_T("lock"),
+	_T("long"),
+	_T("namespace"),
+	_T("new"),
+	_T("null"),
+	_T("object"),
+	_T("operator"),
+	_T("out"),
+	_T("override"),
+	_T("params"),
+	_T("private"),
+	_T("protected"),
+	_T("public"),
+	_T("readonly"),
+	_T("ref"),
+	_T("return"),
+	_T("sbyte"),
+	_T("sealed"),
+	_T("set"),
+	_T("short"),
+	_T("sizeof"),
+	_T("stackalloc"),
+	_T("static"),
+	_T("string"),
+	_T("struct"),
+	_T("switch"),
+	_T("this"),
+	_T("throw"),
+	_T("true"),
+	_T("try"),
+	_T("typeof"),
+	_T("uint"),
+	_T("ulong"),
+	_T("unchecked"),
+	_T("unsafe"),
+	_T("ushort"),
+	_T("using"),
+	_T("var"),
+	_T("virtual"),
+	_T("void"),
+	_T("volatile"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsncmp> const s_CSharpKeywordHash(s_apszCSharpKeywordList);
+
 static BOOL IsCSharpKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszCSharpKeywordList[] =
-	{
-		_T("abstract"),
-		_T("as"),
-		_T("async"),
-		_T("await"),
-		_T("base"),
-		_T("bool"),
-		_T("break"),
-		_T("byte"),
-		_T("case"),
-		_T("catch"),
-		_T("char"),
-		_T("checked"),
-		_T("class"),
-		_T("const"),
-		_T("continue"),
-		_T("decimal"),
-		_T("default"),
-		_T("delegate"),
-		_T("do"),
-		_T("double"),
-		_T("else"),
-		_T("enum"),
-		_T("event"),
-		_T("exdouble"),
-		_T("exfloat"),
-		_T("explicit"),
-		_T("extern"),
-		_T("false"),
-		_T("finally"),
-		_T("fixed"),
-		_T("float"),
-		_T("for"),
-		_T("foreach"),
-		_T("get"),
-		_T("goto"),
-		_T("if"),
-		_T("implicit"),
-		_T("in"),
-		_T("int"),
-		_T("interface"),
-		_T("internal"),
-		_T("is"),
-		_T("lock"),
-		_T("long"),
-		_T("namespace"),
-		_T("new"),
-		_T("null"),
-		_T("object"),
-		_T("operator"),
-		_T("out"),
-		_T("override"),
-		_T("params"),
-		_T("private"),
-		_T("protected"),
-		_T("public"),
-		_T("readonly"),
-		_T("ref"),
-		_T("return"),
-		_T("sbyte"),
-		_T("sealed"),
-		_T("set"),
-		_T("short"),
-		_T("sizeof"),
-		_T("stackalloc"),
-		_T("static"),
-		_T("string"),
-		_T("struct"),
-		_T("switch"),
-		_T("this"),
-		_T("throw"),
-		_T("true"),
-		_T("try"),
-		_T("typeof"),
-		_T("uint"),
-		_T("ulong"),
-		_T("unchecked"),
-		_T("unsafe"),
-		_T("ushort"),
-		_T("using"),
-		_T("var"),
-		_T("virtual"),
-		_T("void"),
-		_T("volatile"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszCSharpKeywordList);
+	return s_CSharpKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
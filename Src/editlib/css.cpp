@@ -22,163 +22,169 @@
 #endif
 
 // CSS 1
+static LPCTSTR const s_apszCss1KeywordList[] =
+{
+	_T("background"),
+	_T("background-attachment"),
+	_T("background-color"),
+	_T("background-image"),
+	_T("background-position"),
+	_T("background-repeat"),
+	_T("border"),
+	_T("border-bottom"),
+	_T("border-bottom-width"),
+	_T("border-color"),
+	_T("border-left"),
+	_T("border-left-width"),
+	_T("border-right"),
+	_T("border-right-width"),
+	_T("border-style"),
+	_T("border-top"),
+	_T("border-top-width"),
+	_T("border-width"),
+	_T("clear"),
+	_T("color"),
+	_T("display"),
+	_T("float"),
+	_T("font"),
+	_T("font-family"),
+	_T("font-size"),
+	_T("font-style"),
+	_T("font-variant"),
+	_T("font-weight"),
+	_T("height"),
+	_T("letter-spacing"),
+	_T("line-height"),
+	_T("list-style"),
+	_T("list-style-image"),
+	_T("list-style-position"),
+	_T("list-style-type"),
+	_T("margin"),
+	_T("margin-bottom"),
+	_T("margin-left"),
+	_T("margin-right"),
+	_T("margin-top"),
+	_T("padding"),
+	_T("padding-bottom"),
+	_T("padding-left"),
+	_T("padding-right"),
+	_T("padding-top"),
+	_T("text-align"),
+	_T("text-decoration"),
+	_T("text-indent"),
+	_T("text-transform"),
+	_T("vertical-align"),
+	_T("white-space"),
+	_T("width"),
+	_T("word-spacing"),
+};
+
+static KeywordHash<_tcsnicmp> const s_Css1KeywordHash(s_apszCss1KeywordList);
+
 static BOOL IsCss1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszCss1KeywordList[] =
-	{
-		_T("background"),
-		_T("background-attachment"),
-		_T("background-color"),
-		_T("background-image"),
-		_T("background-position"),
-		_T("background-repeat"),
-		_T("border"),
-		_T("border-bottom"),
-		_T("border-bottom-width"),
-		_T("border-color"),
-		_T("border-left"),
-		_T("border-left-width"),
-		_T("border-right"),
-		_T("border-right-width"),
-		_T("border-style"),
-		_T("border-top"),
-		_T("border-top-width"),
-		_T("border-width"),
-		_T("clear"),
-		_T("color"),
-		_T("display"),
-		_T("float"),
-		_T("font"),
-		_T("font-family"),
-		_T("font-size"),
-		_T("font-style"),
-		_T("font-variant"),
-		_T("font-weight"),
-		_T("height"),
-		_T("letter-spacing"),
-		_T("line-height"),
-		_T("list-style"),
-		_T("list-style-image"),
-		_T("list-style-position"),
-		_T("list-style-type"),
-		_T("margin"),
-		_T("margin-bottom"),
-		_T("margin-left"),
-		_T("margin-right"),
-		_T("margin-top"),
-		_T("padding"),
-		_T("padding-bottom"),
-		_T("padding-left"),
-		_T("padding-right"),
-		_T("padding-top"),
-		_T("text-align"),
-		_T("text-decoration"),
-		_T("text-indent"),
-		_T("text-transform"),
-		_T("vertical-align"),
-		_T("white-space"),
-		_T("width"),
-		_T("word-spacing"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszCss1KeywordList);
+	return s_Css1KeywordHash.Find(pszChars, nLength);
 }
 
 // CSS 2
+static LPCTSTR const s_apszCss2KeywordList[] =
+{
+	_T("ascent"),
+	_T("azimuth"),
+	_T("baseline"),
+	_T("bbox"),
+	_T("border-bottom-color"),
+	_T("border-bottom-style"),
+	_T("border-collapse"),
+	_T("border-color"),
+	_T("border-left-color"),
+	_T("border-left-style"),
+	_T("border-right-color"),
+	_T("border-right-style"),
+	_T("border-spacing"),
+	_T("border-style"),
+	_T("border-top-color"),
+	_T("border-top-style"),
+	_T("bottom"),
+	_T("cap-height"),
+	_T("caption-side"),
+	_T("centerline"),
+	_T("clip"),
+	_T("content"),
+	_T("counter-increment"),
+	_T("counter-reset"),
+	_T("cue"),
+	_T("cue-after"),
+	_T("cue-before"),
+	_T("cursor"),
+	_T("definition-src"),
+	_T("descent"),
+	_T("direction"),
+	_T("elevation"),
+	_T("empty-cells"),
+	_T("font-size-adjust"),
+	_T("font-stretch"),
+	_T("left"),
+	_T("marker-offset"),
+	_T("marks"),
+	_T("mathline"),
+	_T("max-height"),
+	_T("max-width"),
+	_T("min-height"),
+	_T("min-width"),
+	_T("orphans"),
+	_T("outline"),
+	_T("outline-color"),
+	_T("outline-style"),
+	_T("outline-width"),
+	_T("overflow"),
+	_T("page"),
+	_T("page-break-after"),
+	_T("page-break-before"),
+	_T("page-break-inside"),
+	_T("panose-1"),
+	_T("pause"),
+	_T("pause-after"),
+	_T("pause-before"),
+	_T("pitch"),
+	_T("pitch-range"),
+	_T("play-during"),
+	_T("position"),
+	_T("quotes"),
+	_T("richness"),
+	_T("right"),
+	_T("size"),
+	_T("slope"),
+	_T("speak"),
+	_T("speak-header"),
+	_T("speak-numeral"),
+	_T("speak-punctuation"),
+	_T("speech-rate"),
+	_T("src"),
+	_T("stemh"),
+	_T("stemv"),
+	_T("stress"),
+	_T("table-layout"),
+	_T("text-shadow"),
+	_T("top"),
+	_T("topline"),
+	_T("unicode-bidi"),
+	_T("unicode-range"),
+	_T("units-per-em"),
+	_T("visibility"),
+	_T("voice-family"),
+	_T("volume"),
+	_T("widows"),
+	_T("widths"),
+	_T("x-height"),
+	_T("z-index"),
+};
+
+static KeywordHash<_tcsnicmp> const s_Css2KeywordHash(s_apszCss2KeywordList);
+
 static BOOL IsCss2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszCss2KeywordList[] =
-	{
-		_T("ascent"),
-		_T("azimuth"),
-		_T("baseline"),
-		_T("bbox"),
-		_T("border-bottom-color"),
-		_T("border-bottom-style"),
-		_T("border-collapse"),
-		_T("border-color"),
-		_T("border-left-color"),
-		_T("border-left-style"),
-		_T("border-right-color"),
-		_T("border-right-style"),
-		_T("border-spacing"),
-		_T("border-style"),
-		_T("border-top-color"),
-		_T("border-top-style"),
-		_T("bottom"),
-		_T("cap-height"),
-		_T("caption-side"),
-		_T("centerline"),
-		_T("clip"),
-		_T("content"),
-		_T("counter-increment"),
-		_T("counter-reset"),
-		_T("cue"),
-		_T("cue-after"),
-		_T("cue-before"),
-		_T("cursor"),
-		_T("definition-src"),
-		_T("descent"),
-		_T("direction"),
-		_T("elevation"),
-		_T("empty-cells"),
-		_T("font-size-adjust"),
-		_T("font-stretch"),
-		_T("left"),
-		_T("marker-offset"),
-		_T("marks"),
-		_T("mathline"),
-		_T("max-height"),
-		_T("max-width"),
-		_T("min-height"),
-		_T("min-width"),
-		_T("orphans"),
-		_T("outline"),
-		_T("outline-color"),
-		_T("outline-style"),
-		_T("outline-width"),
-		_T("overflow"),
-		_T("page"),
-		_T("page-break-after"),
-		_T("page-break-before"),
-		_T("page-break-inside"),
-		_T("panose-1"),
-		_T("pause"),
-		_T("pause-after"),
-		_T("pause-before"),
-		_T("pitch"),
-		_T("pitch-range"),
-		_T("play-during"),
-		_T("position"),
-		_T("quotes"),
-		_T("richness"),
-		_T("right"),
-		_T("size"),
-		_T("slope"),
-		_T("speak"),
-		_T("speak-header"),
-		_T("speak-numeral"),
-		_T("speak-punctuation"),
-		_T("speech-rate"),
-		_T("src"),
-		_T("stemh"),
-		_T("stemv"),
-		_T("stress"),
-		_T("table-layout"),
-		_T("text-shadow"),
-		_T("top"),
-		_T("topline"),
-		_T("unicode-bidi"),
-		_T("unicode-range"),
-		_T("units-per-em"),
-		_T("visibility"),
-		_T("voice-family"),
-		_T("volume"),
-		_T("widows"),
-		_T("widths"),
-		_T("x-height"),
-		_T("z-index"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszCss2KeywordList);
+	return s_Css2KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -23,97 +23,106 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszDclKeywordList[] =
+{
+	_T("boxed_column"),
+	_T("boxed_radio_column"),
+	_T("boxed_radio_row"),
+	_T("boxed_row"),
+	_T("button"),
+	_T("column"),
+	_T("concatenation"),
+	_T("dialog"),
+	_T("edit_box"),
+	_T("image"),
+	_T("list_box"),
+	_T("paragraph"),
+	_T("popup_list"),
+	_T("radio_button"),
+	_T("row"),
+	_T("slider"),
+	_T("spacer"),
+	_T("text"),
+	_T("text_part"),
+	_T("toggle"),
+};
+
+static KeywordHash<_tcsncmp> const s_DclKeywordHash(s_apszDclKeywordList);
+
 static BOOL IsDclKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszDclKeywordList[] =
-	{
-		_T("boxed_column"),
-		_T("boxed_radio_column"),
-		_T("boxed_radio_row"),
-		_T("boxed_row"),
-		_T("button"),
-		_T("column"),
-		_T("concatenation"),
-		_T("dialog"),
-		_T("edit_box"),
-		_T("image"),
-		_T("list_box"),
-		_T("paragraph"),
-		_T("popup_list"),
-		_T("radio_button"),
-		_T("row"),
-		_T("slider"),
-		_T("spacer"),
-		_T("text"),
-		_T("text_part"),
-		_T("toggle"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszDclKeywordList);
+	return s_DclKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("cancel_button"),
+	_T("default_button"),
+	_T("errtile"),
+	_T("help_button"),
+	_T("image_button"),
+	_T("info_button"),
+	_T("ok_button"),
+	_T("ok_cancel"),
+	_T("ok_cancel_err"),
+	_T("ok_cancel_help"),
+	_T("ok_cancel_help_errtile"),
+	_T("ok_cancel_help_info"),
+	_T("ok_only"),
+	_T("radio_column"),
+	_T("radio_row"),
+	_T("retirement_button"),
+	_T("spacer_0"),
+	_T("spacer_1"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("cancel_button"),
-		_T("default_button"),
-		_T("errtile"),
-		_T("help_button"),
-		_T("image_button"),
-		_T("info_button"),
-		_T("ok_button"),
-		_T("ok_cancel"),
-		_T("ok_cancel_err"),
-		_T("ok_cancel_help"),
-		_T("ok_cancel_help_errtile"),
-		_T("ok_cancel_help_info"),
-		_T("ok_only"),
-		_T("radio_column"),
-		_T("radio_row"),
-		_T("retirement_button"),
-		_T("spacer_0"),
-		_T("spacer_1"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser2KeywordList[] =
+{
+	_T("action"),
+	_T("alignment"),
+	_T("allow_accept"),
+	_T("aspect_ratio"),
+	_T("big_increment"),
+	_T("children_alignment"),
+	_T("children_fixed_height"),
+	_T("children_fixed_width"),
+	_T("edit_limit"),
+	_T("edit_width"),
+	_T("fixed_height"),
+	_T("fixed_width"),
+	_T("height"),
+	_T("initial_focus"),
+	_T("is_bold"),
+	_T("is_cancel"),
+	_T("is_default"),
+	_T("is_enabled"),
+	_T("is_tab_stop"),
+	_T("key"),
+	_T("label"),
+	_T("layout"),
+	_T("list"),
+	_T("max_value"),
+	_T("min_value"),
+	_T("mnemonic"),
+	_T("multiple_select"),
+	_T("small_increment"),
+	_T("tabs"),
+	_T("value"),
+	_T("width"),
+};
+
+static KeywordHash<_tcsncmp> const s_User2KeywordHash(s_apszUser2KeywordList);
+
 static BOOL IsUser2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser2KeywordList[] =
-	{
-		_T("action"),
-		_T("alignment"),
-		_T("allow_accept"),
-		_T("aspect_ratio"),
-		_T("big_increment"),
-		_T("children_alignment"),
-		_T("children_fixed_height"),
-		_T("children_fixed_width"),
-		_T("edit_limit"),
-		_T("edit_width"),
-		_T("fixed_height"),
-		_T("fixed_width"),
-		_T("height"),
-		_T("initial_focus"),
-		_T("is_bold"),
-		_T("is_cancel"),
-		_T("is_default"),
-		_T("is_enabled"),
-		_T("is_tab_stop"),
-		_T("key"),
-		_T("label"),
-		_T("layout"),
-		_T("list"),
-		_T("max_value"),
-		_T("min_value"),
-		_T("mnemonic"),
-		_T("multiple_select"),
-		_T("small_increment"),
-		_T("tabs"),
-		_T("value"),
-		_T("width"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser2KeywordList);
+	return s_User2KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
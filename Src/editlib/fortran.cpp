@@ -23,216 +23,219 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszFortranKeywordList[] =
+{
+	_T(".and."),
+	_T(".not."),
+	_T(".or."),
+	_T("abs"),
+	_T("achar"),
+	_T("acos"),
+	_T("adjustl"),
+	_T("adjustr"),
+	_T("aimag"),
+	_T("aint"),
+	_T("all"),
+	_T("allocatable"),
+	_T("allocate"),
+	_T("allocated"),
+	_T("anint"),
+	_T("any"),
+	_T("asin"),
+	_T("assignment"),
+	_T("associated"),
+	_T("atan"),
+	_T("atan2"),
+	_T("backspace"),
+	_T("bit_size"),
+	_T("block"),
+	_T("blockdata"),
+	_T("btest"),
+	_T("call"),
+	_T("case"),
+	_T("ceiling"),
+	_T("char"),
+	_T("character"),
+	_T("close"),
+	_T("cmplx"),
+	_T("common"),
+	_T("complex"),
+	_T("conjg"),
+	_T("contains"),
+	_T("continue"),
+	_T("cos"),
+	_T("cosh"),
+	_T("count"),
+	_T("cshift"),
+	_T("cycle"),
+	_T("data"),
+	_T("date_and_time"),
+	_T("dble"),
+	_T("deallocate"),
+	_T("default"),
+	_T("digits"),
+	_T("dim"),
+	_T("dimension"),
+	_T("do"),
+	_T("dot_product"),
+	_T("double"),
+	_T("doubleprecision"),
+	_T("dprod"),
+	_T("else"),
+	_T("elseif"),
+	_T("elsewhere"),
+	_T("end"),
+	_T("endblock"),
+	_T("endblockdata"),
+	_T("enddo"),
+	_T("endfile"),
+	_T("endif"),
+	_T("endinterface"),
+	_T("endselect"),
+	_T("endtype"),
+	_T("endwhere"),
+	_T("entry"),
+	_T("eoshift"),
+	_T("epsilon"),
+	_T("equivalence"),
+	_T("exit"),
+	_T("exp"),
+	_T("exponent"),
+	_T("external"),
+	_T("file"),
+	_T("floor"),
+	_T("format."),
+	_T("fraction"),
+	_T("function"),
+	_T("go"),
+	_T("goto"),
+	_T("huge"),
+	_T("iachar"),
+	_T("iand"),
+	_T("ibclr"),
+	_T("ibits"),
+	_T("ibset"),
+	_T("ichar"),
+	_T("ieor"),
+	_T("if"),
+	_T("implicit"),
+	_T("in"),
+	_T("index"),
+	_T("inout"),
+	_T("inquire"),
+	_T("int"),
+	_T("integer"),
+	_T("intent"),
+	_T("interface"),
+	_T("intrinsic"),
+	_T("iolength"),
+	_T("ior"),
+	_T("ishftc"),
+	_T("ishift"),
+	_T("kind"),
+	_T("lbound"),
+	_T("len"),
+	_T("len_trim"),
+	_T("lge"),
+	_T("lgt"),
+	_T("lle"),
+	_T("llt"),
+	_T("log"),
+	_T("log10"),
+	_T("logical"),
+	_T("matmul"),
+	_T("max"),
+	_T("maxexponent"),
+	_T("maxloc"),
+	_T("maxval"),
+	_T("merge"),
+	_T("min"),
+	_T("minexponent"),
+	_T("minloc"),
+	_T("minval"),
+	_T("mod"),
+	_T("module"),
+	_T("modulo"),
+	_T("mvbits"),
+	_T("namelist"),
+	_T("nearest"),
+	_T("nint"),
+	_T("none"),
+	_T("nullify"),
+	_T("only"),
+	_T("open"),
+	_T("operator"),
+	_T("optional"),
+	_T("out"),
+	_T("pack"),
+	_T("parameter"),
+	_T("pointer"),
+	_T("precision"),
+	_T("present"),
+	_T("print"),
+	_T("private"),
+	_T("procedure"),
+	_T("product"),
+	_T("program"),
+	_T("public"),
+	_T("radix"),
+	_T("random_number"),
+	_T("random_seed"),
+	_T("rangereal"),
+	_T("read"),
+	_T("real"),
+	_T("recursive"),
+	_T("repeat"),
+	_T("reshape"),
+	_T("result"),
+	_T("return"),
+	_T("rewrind"),
+	_T("rrspacing"),
+	_T("save"),
+	_T("scale"),
+	_T("scan"),
+	_T("select"),
+	_T("selectcase"),
+	_T("selected_int_kind"),
+	_T("selected_real_kind"),
+	_T("sequence"),
+	_T("set_exponent"),
+	_T("shape"),
+	_T("sign"),
+	_T("sin"),
+	_T("sinh"),
+	_T("size"),
+	_T("spacing"),
+	_T("spread"),
+	_T("sqrt"),
+	_T("stop"),
+	_T("subroutine"),
+	_T("sum"),
+	_T("system_clock"),
+	_T("tan"),
+	_T("tanh"),
+	_T("target"),
+	_T("then"),
+	_T("tiny"),
+	_T("to"),
+	_T("transfer"),
+	_T("transpose"),
+	_T("trim"),
+	_T("type"),
+	_T("unbound"),
+	_T("unpack"),
+	_T("use"),
+	_T("verify"),
+	_T("where"),
+	_T("while"),
+	_T("write"),
+};
+
+static KeywordHash<_tcsnicmp> const s_FortranKeywordHash(s_apszFortranKeywordList);
+
 static BOOL IsFortranKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszFortranKeywordList[] =
-	{
-		_T(".and."),
-		_T(".not."),
-		_T(".or."),
-		_T("abs"),
-		_T("achar"),
-		_T("acos"),
-		_T("adjustl"),
-		_T("adjustr"),
-		_T("aimag"),
-		_T("aint"),
-		_T("all"),
-		_T("allocatable"),
-		_T("allocate"),
-		_T("allocated"),
-		_T("anint"),
-		_T("any"),
-		_T("asin"),
-		_T("assignment"),
-		_T("associated"),
-		_T("atan"),
-		_T("atan2"),
-		_T("backspace"),
-		_T("bit_size"),
-		_T("block"),
-		_T("blockdata"),
-		_T("btest"),
-		_T("call"),
-		_T("case"),
-		_T("ceiling"),
-		_T("char"),
-		_T("character"),
-		_T("close"),
-		_T("cmplx"),
-		_T("common"),
-		_T("complex"),
-		_T("conjg"),
-		_T("contains"),
-		_T("continue"),
-		_T("cos"),
-		_T("cosh"),
-		_T("count"),
-		_T("cshift"),
-		_T("cycle"),
-		_T("data"),
-		_T("date_and_time"),
-		_T("dble"),
-		_T("deallocate"),
-		_T("default"),
-		_T("digits"),
-		_T("dim"),
-		_T("dimension"),
-		_T("do"),
-		_T("dot_product"),
-		_T("double"),
-		_T("doubleprecision"),
-		_T("dprod"),
-		_T("else"),
-		_T("elseif"),
-		_T("elsewhere"),
-		_T("end"),
-		_T("endblock"),
-		_T("endblockdata"),
-		_T("enddo"),
-		_T("endfile"),
-		_T("endif"),
-		_T("endinterface"),
-		_T("endselect"),
-		_T("endtype"),
-		_T("endwhere"),
-		_T("entry"),
-		_T("eoshift"),
-		_T("epsilon"),
-		_T("equivalence"),
-		_T("exit"),
-		_T("exp"),
-		_T("exponent"),
-		_T("external"),
-		_T("file"),
-		_T("floor"),
-		_T("format."),
-		_T("fraction"),
-		_T("function"),
-		_T("go"),
-		_T("goto"),
-		_T("huge"),
-		_T("iachar"),
-		_T("iand"),
-		_T("ibclr"),
-		_T("ibits"),
-		_T("ibset"),
-		_T("ichar"),
-		_T("ieor"),
-		_T("if"),
-		_T("implicit"),
-		_T("in"),
-		_T("index"),
-		_T("inout"),
-		_T("inquire"),
-		_T("int"),
-		_T("integer"),
-		_T("intent"),
-		_T("interface"),
-		_T("intrinsic"),
-		_T("iolength"),
-		_T("ior"),
-		_T("ishftc"),
-		_T("ishift"),
-		_T("kind"),
-		_T("lbound"),
-		_T("len"),
-		_T("len_trim"),
-		_T("lge"),
-		_T("lgt"),
-		_T("lle"),
-		_T("llt"),
-		_T("log"),
-		_T("log10"),
-		_T("logical"),
-		_T("matmul"),
-		_T("max"),
-		_T("maxexponent"),
-		_T("maxloc"),
-		_T("maxval"),
-		_T("merge"),
-		_T("min"),
-		_T("minexponent"),
-		_T("minloc"),
-		_T("minval"),
-		_T("mod"),
-		_T("module"),
-		_T("modulo"),
-		_T("mvbits"),
-		_T("namelist"),
-		_T("nearest"),
-		_T("nint"),
-		_T("none"),
-		_T("nullify"),
-		_T("only"),
-		_T("open"),
-		_T("operator"),
-		_T("optional"),
-		_T("out"),
-		_T("pack"),
-		_T("parameter"),
-		_T("pointer"),
-		_T("precision"),
-		_T("present"),
-		_T("print"),
-		_T("private"),
-		_T("procedure"),
-		_T("product"),
-		_T("program"),
-		_T("public"),
-		_T("radix"),
-		_T("random_number"),
-		_T("random_seed"),
-		_T("rangereal"),
-		_T("read"),
-		_T("real"),
-		_T("recursive"),
-		_T("repeat"),
-		_T("reshape"),
-		_T("result"),
-		_T("return"),
-		_T("rewrind"),
-		_T("rrspacing"),
-		_T("save"),
-		_T("scale"),
-		_T("scan"),
-		_T("select"),
-		_T("selectcase"),
-		_T("selected_int_kind"),
-		_T("selected_real_kind"),
-		_T("sequence"),
-		_T("set_exponent"),
-		_T("shape"),
-		_T("sign"),
-		_T("sin"),
-		_T("sinh"),
-		_T("size"),
-		_T("spacing"),
-		_T("spread"),
-		_T("sqrt"),
-		_T("stop"),
-		_T("subroutine"),
-		_T("sum"),
-		_T("system_clock"),
-		_T("tan"),
-		_T("tanh"),
-		_T("target"),
-		_T("then"),
-		_T("tiny"),
-		_T("to"),
-		_T("transfer"),
-		_T("transpose"),
-		_T("trim"),
-		_T("type"),
-		_T("unbound"),
-		_T("unpack"),
-		_T("use"),
-		_T("verify"),
-		_T("where"),
-		_T("while"),
-		_T("write"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszFortranKeywordList);
+	return s_FortranKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
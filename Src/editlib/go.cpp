@@ -24,84 +24,90 @@
 using CommonKeywords::IsNumeric;
 
 // Go keywords
+static LPCTSTR const s_apszGoKeywordList[] =
+{
+	_T("break"),
+	_T("case"),
+	_T("chan"),
+	_T("const"),
+	_T("continue"),
+	_T("default"),
+	_T("defer"),
+	_T("else"),
+	_T("fallthrough"),
+	_T("for"),
+	_T("func"),
+	_T("go"),
+	_T("goto"),
+	_T("if"),
+	_T("import"),
+	_T("interface"),
+	_T("map"),
+	_T("package"),
+	_T("range"),
+	_T("return"),
+	_T("select"),
+	_T("struct"),
+	_T("switch"),
+	_T("type"),
+	_T("var"),
+};
+
+static KeywordHash<_tcsncmp> const s_GoKeywordHash(s_apszGoKeywordList);
+
 static BOOL IsGoKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszGoKeywordList[] =
-	{
-		_T("break"),
-		_T("case"),
-		_T("chan"),
-		_T("const"),
-		_T("continue"),
-		_T("default"),
-		_T("defer"),
-		_T("else"),
-		_T("fallthrough"),
-		_T("for"),
-		_T("func"),
-		_T("go"),
-		_T("goto"),
-		_T("if"),
-		_T("import"),
-		_T("interface"),
-		_T("map"),
-		_T("package"),
-		_T("range"),
-		_T("return"),
-		_T("select"),
-		_T("struct"),
-		_T("switch"),
-		_T("type"),
-		_T("var"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszGoKeywordList);
+	return s_GoKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("append"),
+	_T("bool"),
+	_T("byte"),
+	_T("cap"),
+	_T("close"),
+	_T("complex"),
+	_T("complex128"),
+	_T("complex64"),
+	_T("copy"),
+	_T("delete"),
+	_T("error"),
+	_T("false"),
+	_T("float32"),
+	_T("float64"),
+	_T("imag"),
+	_T("int"),
+	_T("int16"),
+	_T("int32"),
+	_T("int64"),
+	_T("int8"),
+	_T("iota"),
+	_T("len"),
+	_T("make"),
+	_T("new"),
+	_T("nil"),
+	_T("panic"),
+	_T("print"),
+	_T("println"),
+	_T("real"),
+	_T("recover"),
+	_T("rune"),
+	_T("string"),
+	_T("true"),
+	_T("uint"),
+	_T("uint16"),
+	_T("uint32"),
+	_T("uint64"),
+	_T("uint8"),
+	_T("uintptr"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("append"),
-		_T("bool"),
-		_T("byte"),
-		_T("cap"),
-		_T("close"),
-		_T("complex"),
-		_T("complex128"),
-		_T("complex64"),
-		_T("copy"),
-		_T("delete"),
-		_T("error"),
-		_T("false"),
-		_T("float32"),
-		_T("float64"),
-		_T("imag"),
-		_T("int"),
-		_T("int16"),
-		_T("int32"),
-		_T("int64"),
-		_T("int8"),
-		_T("iota"),
-		_T("len"),
-		_T("make"),
-		_T("new"),
-		_T("nil"),
-		_T("panic"),
-		_T("print"),
-		_T("println"),
-		_T("real"),
-		_T("recover"),
-		_T("rune"),
-		_T("string"),
-		_T("true"),
-		_T("uint"),
-		_T("uint16"),
-		_T("uint32"),
-		_T("uint64"),
-		_T("uint8"),
-		_T("uintptr"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -23,258 +23,264 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszInnoSetupKeywordList[] =
+{
+	_T("AdminPrivilegesRequired"),
+	_T("AfterInstall"),
+	_T("AllowCancelDuringInstall"),
+	_T("AllowNoIcons"),
+	_T("AllowRootDirectory"),
+	_T("AllowUNCPath"),
+	_T("AlwaysRestart"),
+	_T("AlwaysShowComponentsList"),
+	_T("AlwaysShowDirOnReadyPage"),
+	_T("AlwaysShowGroupOnReadyPage"),
+	_T("AlwaysUsePersonalGroup"),
+	_T("and"),
+	_T("AppComments"),
+	_T("AppContact"),
+	_T("AppCopyright"),
+	_T("AppendDefaultDirName"),
+	_T("AppendDefaultGroupName"),
+	_T("AppId"),
+	_T("AppModifyPath"),
+	_T("AppMutex"),
+	_T("AppName"),
+	_T("AppPublisher"),
+	_T("AppPublisherURL"),
+	_T("AppReadmeFile"),
+	_T("AppSupportURL"),
+	_T("AppUpdatesURL"),
+	_T("AppUserModelID"),
+	_T("AppUserModelToastActivatorCLSID"),
+	_T("AppVerName"),
+	_T("AppVersion"),
+	_T("ArchitecturesAllowed"),
+	_T("ArchitecturesInstallIn64BitMode"),
+	_T("ASLRCompatible"),
+	_T("Attribs"),
+	_T("BackColor"),
+	_T("BackColor2"),
+	_T("BackColorDirection"),
+	_T("BackSolid"),
+	_T("BeforeInstall"),
+	_T("ChangesAssociations"),
+	_T("ChangesEnvironment"),
+	_T("Check"),
+	_T("CodeFile"),
+	_T("Comment"),
+	_T("Components"),
+	_T("Compression"),
+	_T("CopyMode"),
+	_T("CreateAppDir"),
+	_T("CreateUninstallRegKey"),
+	_T("DefaultDirName"),
+	_T("DefaultGroupName"),
+	_T("DefaultUserInfoName"),
+	_T("DefaultUserInfoOrg"),
+	_T("DefaultUserInfoSerial"),
+	_T("Description"),
+	_T("DestDir"),
+	_T("DestName"),
+	_T("DirExistsWarning"),
+	_T("DisableDirPage"),
+	_T("DisableFinishedPage"),
+	_T("DisableProgramGroupPage"),
+	_T("DisableReadyMemo"),
+	_T("DisableReadyPage"),
+	_T("DisableStartupPrompt"),
+	_T("DiskClusterSize"),
+	_T("DiskSliceSize"),
+	_T("DiskSpaceMBLabel"),
+	_T("DiskSpanning"),
+	_T("DontMergeDuplicateFiles"),
+	_T("EnableDirDoesntExistWarning"),
+	_T("Encryption"),
+	_T("Excludes"),
+	_T("ExtraDiskSpaceRequired"),
+	_T("Filename"),
+	_T("Flags"),
+	_T("FlatComponentsList"),
+	_T("FontInstall"),
+	_T("GroupDescription"),
+	_T("HotKey"),
+	_T("IconFilename"),
+	_T("IconIndex"),
+	_T("InfoAfterFile"),
+	_T("InfoBeforeFile"),
+	_T("InternalCompressLevel"),
+	_T("Key"),
+	_T("LanguageDetectionMethod"),
+	_T("Languages"),
+	_T("LicenseFile"),
+	_T("MergeDuplicateFiles"),
+	_T("MessagesFile"),
+	_T("MinVersion"),
+	_T("Name"),
+	_T("OnlyBelowVersion"),
+	_T("OutputBaseFilename"),
+	_T("OutputDir"),
+	_T("OutputManifestFile"),
+	_T("Parameters"),
+	_T("Password"),
+	_T("Permissions"),
+	_T("PrivilegesRequired"),
+	_T("PrivilegesRequiredOverridesAllowed"),
+	_T("ReserveBytes"),
+	_T("RestartIfNeededByRun"),
+	_T("Root"),
+	_T("RunOnceId"),
+	_T("Section"),
+	_T("SetupIconFile"),
+	_T("ShowComponentSizes"),
+	_T("ShowLanguageDialog"),
+	_T("ShowTasksTreeLines"),
+	_T("SlicesPerDisk"),
+	_T("SolidCompression"),
+	_T("Source"),
+	_T("SourceDir"),
+	_T("StatusMsg"),
+	_T("String"),
+	_T("Subkey"),
+	_T("Tasks"),
+	_T("TimeStampRounding"),
+	_T("TimeStampsInUTC"),
+	_T("TouchDate"),
+	_T("TouchTime"),
+	_T("Type"),
+	_T("Types"),
+	_T("Uninstallable"),
+	_T("UninstallDisplayIcon"),
+	_T("UninstallDisplayName"),
+	_T("UninstallFilesDir"),
+	_T("UninstallIconFile"),
+	_T("UninstallLogMode"),
+	_T("UninstallRestartComputer"),
+	_T("UninstallStyle"),
+	_T("UpdateUninstallLogAppName"),
+	_T("UsePreviousAppDir"),
+	_T("UsePreviousGroup"),
+	_T("UsePreviousPrivileges"),
+	_T("UsePreviousSetupType"),
+	_T("UsePreviousTasks"),
+	_T("UsePreviousUserInfo"),
+	_T("UserInfoPage"),
+	_T("UseSetupLdr"),
+	_T("ValueData"),
+	_T("ValueName"),
+	_T("ValueType"),
+	_T("VersionInfoCompany"),
+	_T("VersionInfoDescription"),
+	_T("VersionInfoTextVersion"),
+	_T("VersionInfoVersion"),
+	_T("WindowResizable"),
+	_T("WindowShowCaption"),
+	_T("WindowStartMaximized"),
+	_T("WindowVisible"),
+	_T("WizardImageBackColor"),
+	_T("WizardImageFile"),
+	_T("WizardImageStretch"),
+	_T("WizardSmallImageBackColor"),
+	_T("WizardSmallImageFile"),
+	_T("WizardStyle"),
+	_T("WorkingDir"),
+};
+
+static KeywordHash<_tcsnicmp> const s_InnoSetupKeywordHash(s_apszInnoSetupKeywordList);
+
 static BOOL IsInnoSetupKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszInnoSetupKeywordList[] =
-	{
-		_T("AdminPrivilegesRequired"),
-		_T("AfterInstall"),
-		_T("AllowCancelDuringInstall"),
-		_T("AllowNoIcons"),
-		_T("AllowRootDirectory"),
-		_T("AllowUNCPath"),
-		_T("AlwaysRestart"),
-		_T("AlwaysShowComponentsList"),
-		_T("AlwaysShowDirOnReadyPage"),
-		_T("AlwaysShowGroupOnReadyPage"),
-		_T("AlwaysUsePersonalGroup"),
-		_T("and"),
-		_T("AppComments"),
-		_T("AppContact"),
-		_T("AppCopyright"),
-		_T("AppendDefaultDirName"),
-		_T("AppendDefaultGroupName"),
-		_T("AppId"),
-		_T("AppModifyPath"),
-		_T("AppMutex"),
-		_T("AppName"),
-		_T("AppPublisher"),
-		_T("AppPublisherURL"),
-		_T("AppReadmeFile"),
-		_T("AppSupportURL"),
-		_T("AppUpdatesURL"),
-		_T("AppUserModelID"),
-		_T("AppUserModelToastActivatorCLSID"),
-		_T("AppVerName"),
-		_T("AppVersion"),
-		_T("ArchitecturesAllowed"),
-		_T("ArchitecturesInstallIn64BitMode"),
-		_T("ASLRCompatible"),
-		_T("Attribs"),
-		_T("BackColor"),
-		_T("BackColor2"),
-		_T("BackColorDirection"),
-		_T("BackSolid"),
-		_T("BeforeInstall"),
-		_T("ChangesAssociations"),
-		_T("ChangesEnvironment"),
-		_T("Check"),
-		_T("CodeFile"),
-		_T("Comment"),
-		_T("Components"),
-		_T("Compression"),
-		_T("CopyMode"),
-		_T("CreateAppDir"),
-		_T("CreateUninstallRegKey"),
-		_T("DefaultDirName"),
-		_T("DefaultGroupName"),
-		_T("DefaultUserInfoName"),
-		_T("DefaultUserInfoOrg"),
-		_T("DefaultUserInfoSerial"),
-		_T("Description"),
-		_T("DestDir"),
-		_T("DestName"),
-		_T("DirExistsWarning"),
-		_T("DisableDirPage"),
-		_T("DisableFinishedPage"),
-		_T("DisableProgramGroupPage"),
-		_T("DisableReadyMemo"),
-		_T("DisableReadyPage"),
-		_T("DisableStartupPrompt"),
-		_T("DiskClusterSize"),
-		_T("DiskSliceSize"),
-		_T("DiskSpaceMBLabel"),
-		_T("DiskSpanning"),
-		_T("DontMergeDuplicateFiles"),
-		_T("EnableDirDoesntExistWarning"),
-		_T("Encryption"),
-		_T("Excludes"),
-		_T("ExtraDiskSpaceRequired"),
-		_T("Filename"),
-		_T("Flags"),
-		_T("FlatComponentsList"),
-		_T("FontInstall"),
-		_T("GroupDescription"),
-		_T("HotKey"),
-		_T("IconFilename"),
-		_T("IconIndex"),
-		_T("InfoAfterFile"),
-		_T("InfoBeforeFile"),
-		_T("InternalCompressLevel"),
-		_T("Key"),
-		_T("LanguageDetectionMethod"),
-		_T("Languages"),
-		_T("LicenseFile"),
-		_T("MergeDuplicateFiles"),
-		_T("MessagesFile"),
-		_T("MinVersion"),
-		_T("Name"),
-		_T("OnlyBelowVersion"),
-		_T("OutputBaseFilename"),
-		_T("OutputDir"),
-		_T("OutputManifestFile"),
-		_T("Parameters"),
-		_T("Password"),
-		_T("Permissions"),
-		_T("PrivilegesRequired"),
-		_T("PrivilegesRequiredOverridesAllowed"),
-		_T("ReserveBytes"),
-		_T("RestartIfNeededByRun"),
-		_T("Root"),
-		_T("RunOnceId"),
-		_T("Section"),
-		_T("SetupIconFile"),
-		_T("ShowComponentSizes"),
-		_T("ShowLanguageDialog"),
-		_T("ShowTasksTreeLines"),
-		_T("SlicesPerDisk"),
-		_T("SolidCompression"),
-		_T("Source"),
-		_T("SourceDir"),
-		_T("StatusMsg"),
-		_T("String"),
-		_T("Subkey"),
-		_T("Tasks"),
-		_T("TimeStampRounding"),
-		_T("TimeStampsInUTC"),
-		_T("TouchDate"),
-		_T("TouchTime"),
-		_T("Type"),
-		_T("Types"),
-		_T("Uninstallable"),
-		_T("UninstallDisplayIcon"),
-		_T("UninstallDisplayName"),
-		_T("UninstallFilesDir"),
-		_T("UninstallIconFile"),
-		_T("UninstallLogMode"),
-		_T("UninstallRestartComputer"),
-		_T("UninstallStyle"),
-		_T("UpdateUninstallLogAppName"),
-		_T("UsePreviousAppDir"),
-		_T("UsePreviousGroup"),
-		_T("UsePreviousPrivileges"),
-		_T("UsePreviousSetupType"),
-		_T("UsePreviousTasks"),
-		_T("UsePreviousUserInfo"),
-		_T("UserInfoPage"),
-		_T("UseSetupLdr"),
-		_T("ValueData"),
-		_T("ValueName"),
-		_T("ValueType"),
-		_T("VersionInfoCompany"),
-		_T("VersionInfoDescription"),
-		_T("VersionInfoTextVersion"),
-		_T("VersionInfoVersion"),
-		_T("WindowResizable"),
-		_T("WindowShowCaption"),
-		_T("WindowStartMaximized"),
-		_T("WindowVisible"),
-		_T("WizardImageBackColor"),
-		_T("WizardImageFile"),
-		_T("WizardImageStretch"),
-		_T("WizardSmallImageBackColor"),
-		_T("WizardSmallImageFile"),
-		_T("WizardStyle"),
-		_T("WorkingDir"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszInnoSetupKeywordList);
+	return s_InnoSetupKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("alwaysoverwrite"),
+	_T("alwaysskipifsameorolder"),
+	_T("append"),
+	_T("binary"),
+	_T("classic"),
+	_T("closeonexit"),
+	_T("comparetimestamp"),
+	_T("confirmoverwrite"),
+	_T("createkeyifdoesntexist"),
+	_T("createonlyiffileexists"),
+	_T("createvalueifdoesntexist"),
+	_T("deleteafterinstall"),
+	_T("deletekey"),
+	_T("deletevalue"),
+	_T("dirifempty"),
+	_T("disablenouninstallwarning"),
+	_T("dontcloseonexit"),
+	_T("dontcopy"),
+	_T("dontcreatekey"),
+	_T("dword"),
+	_T("exclusive"),
+	_T("expandsz"),
+	_T("external"),
+	_T("files"),
+	_T("filesandordirs"),
+	_T("fixed"),
+	_T("fontisnttruetype"),
+	_T("HKCC"),
+	_T("HKCR"),
+	_T("HKCU"),
+	_T("HKLM"),
+	_T("HKU"),
+	_T("ignoreversion"),
+	_T("iscustom"),
+	_T("isreadme"),
+	_T("modern"),
+	_T("multisz"),
+	_T("new"),
+	_T("noerror"),
+	_T("none"),
+	_T("normal"),
+	_T("nowait"),
+	_T("onlyifdestfileexists"),
+	_T("onlyifdoesntexist"),
+	_T("onlyifnewer"),
+	_T("overwrite"),
+	_T("overwritereadonly"),
+	_T("postinstall"),
+	_T("preservestringtype"),
+	_T("promptifolder"),
+	_T("regserver"),
+	_T("regtypelib"),
+	_T("restart"),
+	_T("restartreplace"),
+	_T("runhidden"),
+	_T("runmaximized"),
+	_T("runminimized"),
+	_T("sharedfile"),
+	_T("shellexec"),
+	_T("showcheckbox"),
+	_T("silent"),
+	_T("skipifdoesntexist"),
+	_T("skipifnotsilent"),
+	_T("skipifsilent"),
+	_T("skipifsourcedoesntexist"),
+	_T("sortfilesbyextension"),
+	_T("unchecked"),
+	_T("uninsalwaysuninstall"),
+	_T("uninsclearvalue"),
+	_T("uninsdeleteentry"),
+	_T("uninsdeletekey"),
+	_T("uninsdeletekeyifempty"),
+	_T("uninsdeletesection"),
+	_T("uninsdeletesectionifempty"),
+	_T("uninsdeletevalue"),
+	_T("uninsneveruninstall"),
+	_T("useapppaths"),
+	_T("verysilent"),
+	_T("waituntilidle"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("alwaysoverwrite"),
-		_T("alwaysskipifsameorolder"),
-		_T("append"),
-		_T("binary"),
-		_T("classic"),
-		_T("closeonexit"),
-		_T("comparetimestamp"),
-		_T("confirmoverwrite"),
-		_T("createkeyifdoesntexist"),
-		_T("createonlyiffileexists"),
-		_T("createvalueifdoesntexist"),
-		_T("deleteafterinstall"),
-		_T("deletekey"),
-		_T("deletevalue"),
-		_T("dirifempty"),
-		_T("disablenouninstallwarning"),
-		_T("dontcloseonexit"),
-		_T("dontcopy"),
-		_T("dontcreatekey"),
-		_T("dword"),
-		_T("exclusive"),
-		_T("expandsz"),
-		_T("external"),
-		_T("files"),
-		_T("filesandordirs"),
-		_T("fixed"),
-		_T("fontisnttruetype"),
-		_T("HKCC"),
-		_T("HKCR"),
-		_T("HKCU"),
-		_T("HKLM"),
-		_T("HKU"),
-		_T("ignoreversion"),
-		_T("iscustom"),
-		_T("isreadme"),
-		_T("modern"),
-		_T("multisz"),
-		_T("new"),
-		_T("noerror"),
-		_T("none"),
-		_T("normal"),
-		_T("nowait"),
-		_T("onlyifdestfileexists"),
-		_T("onlyifdoesntexist"),
-		_T("onlyifnewer"),
-		_T("overwrite"),
-		_T("overwritereadonly"),
-		_T("postinstall"),
-		_T("preservestringtype"),
-		_T("promptifolder"),
-		_T("regserver"),
-		_T("regtypelib"),
-		_T("restart"),
-		_T("restartreplace"),
-		_T("runhidden"),
-		_T("runmaximized"),
-		_T("runminimized"),
-		_T("sharedfile"),
-		_T("shellexec"),
-		_T("showcheckbox"),
-		_T("silent"),
-		_T("skipifdoesntexist"),
-		_T("skipifnotsilent"),
-		_T("skipifsilent"),
-		_T("skipifsourcedoesntexist"),
-		_T("sortfilesbyextension"),
-		_T("unchecked"),
-		_T("uninsalwaysuninstall"),
-		_T("uninsclearvalue"),
-		_T("uninsdeleteentry"),
-		_T("uninsdeletekey"),
-		_T("uninsdeletekeyifempty"),
-		_T("uninsdeletesection"),
-		_T("uninsdeletesectionifempty"),
-		_T("uninsdeletevalue"),
-		_T("uninsneveruninstall"),
-		_T("useapppaths"),
-		_T("verysilent"),
-		_T("waituntilidle"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
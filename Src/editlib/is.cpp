@@ -35,117 +35,126 @@
 using CommonKeywords::IsNumeric;
 
 // InstallShield keywords (IS3.0)
+static LPCTSTR const s_apszISKeywordList[] =
+{
+	_T("BOOL"),
+	_T("BYREF"),
+	_T("CHAR"),
+	_T("HIWORD"),
+	_T("HWND"),
+	_T("INT"),
+	_T("LIST"),
+	_T("LONG"),
+	_T("LOWORD"),
+	_T("NUMBER"),
+	_T("POINTER"),
+	_T("QUAD"),
+	_T("RGB"),
+	_T("SHORT"),
+	_T("STRING"),
+	_T("begin"),
+	_T("call"),
+	_T("case"),
+	_T("declare"),
+	_T("default"),
+	_T("downto"),
+	_T("else"),
+	_T("elseif"),
+	_T("end"),
+	_T("endif"),
+	_T("endswitch"),
+	_T("endwhile"),
+	_T("external"),
+	_T("for"),
+	_T("function"),
+	_T("goto"),
+	_T("if"),
+	_T("program"),
+	_T("prototype"),
+	_T("repeat"),
+	_T("return"),
+	_T("step"),
+	_T("switch"),
+	_T("then"),
+	_T("to"),
+	_T("typedef"),
+	_T("until"),
+	_T("void"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsncmp> const s_ISKeywordHash(s_apszISKeywordList);
+
 static BOOL IsISKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszISKeywordList[] =
-	{
-		_T("BOOL"),
-		_T("BYREF"),
-		_T("CHAR"),
-		_T("HIWORD"),
-		_T("HWND"),
-		_T("INT"),
-		_T("LIST"),
-		_T("LONG"),
-		_T("LOWORD"),
-		_T("NUMBER"),
-		_T("POINTER"),
-		_T("QUAD"),
-		_T("RGB"),
-		_T("SHORT"),
-		_T("STRING"),
-		_T("begin"),
-		_T("call"),
-		_T("case"),
-		_T("declare"),
-		_T("default"),
-		_T("downto"),
-		_T("else"),
-		_T("elseif"),
-		_T("end"),
-		_T("endif"),
-		_T("endswitch"),
-		_T("endwhile"),
-		_T("external"),
-		_T("for"),
-		_T("function"),
-		_T("goto"),
-		_T("if"),
-		_T("program"),
-		_T("prototype"),
-		_T("repeat"),
-		_T("return"),
-		_T("step"),
-		_T("switch"),
-		_T("then"),
-		_T("to"),
-		_T("typedef"),
-		_T("until"),
-		_T("void"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszISKeywordList);
+	return s_ISKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("AFTER"),
+	_T("APPEND"),
+	_T("BACK"),
+	_T("BEFORE"),
+	_T("CANCEL"),
+	_T("COMMAND"),
+	_T("COMMANDEX"),
+	_T("CONTINUE"),
+	_T("DISABLE"),
+	_T("DLG_ERR"),
+	_T("ENABLE"),
+	_T("EXCLUSIVE"),
+	_T("EXISTS"),
+	_T("FAILIFEXISTS"),
+	_T("FALSE"),
+	_T("FULL"),
+	_T("NEXT"),
+	_T("NO"),
+	_T("NONEXCLUSIVE"),
+	_T("NOSET"),
+	_T("OFF"),
+	_T("ON"),
+	_T("PARTIAL"),
+	_T("REPLACE"),
+	_T("REPLACE_ITEM"),
+	_T("RESET"),
+	_T("RESTART"),
+	_T("SET"),
+	_T("TRUE"),
+	_T("YES"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("AFTER"),
-		_T("APPEND"),
-		_T("BACK"),
-		_T("BEFORE"),
-		_T("CANCEL"),
-		_T("COMMAND"),
-		_T("COMMANDEX"),
-		_T("CONTINUE"),
-		_T("DISABLE"),
-		_T("DLG_ERR"),
-		_T("ENABLE"),
-		_T("EXCLUSIVE"),
-		_T("EXISTS"),
-		_T("FAILIFEXISTS"),
-		_T("FALSE"),
-		_T("FULL"),
-		_T("NEXT"),
-		_T("NO"),
-		_T("NONEXCLUSIVE"),
-		_T("NOSET"),
-		_T("OFF"),
-		_T("ON"),
-		_T("PARTIAL"),
-		_T("REPLACE"),
-		_T("REPLACE_ITEM"),
-		_T("RESET"),
-		_T("RESTART"),
-		_T("SET"),
-		_T("TRUE"),
-		_T("YES"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser2KeywordList[] =
+{
+	_T("CMDLINE"),
+	_T("ERRORFILENAME"),
+	_T("INFOFILENAME"),
+	_T("ISRES"),
+	_T("ISUSER"),
+	_T("ISVERSION"),
+	_T("SRCDIR"),
+	_T("SRCDISK"),
+	_T("SUPPORTDIR"),
+	_T("TARGETDIR"),
+	_T("TARGETDISK"),
+	_T("WINDIR"),
+	_T("WINDISK"),
+	_T("WINSYSDIR"),
+	_T("WINSYSDISK"),
+};
+
+static KeywordHash<_tcsncmp> const s_User2KeywordHash(s_apszUser2KeywordList);
+
 static BOOL IsUser2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser2KeywordList[] =
-	{
-		_T("CMDLINE"),
-		_T("ERRORFILENAME"),
-		_T("INFOFILENAME"),
-		_T("ISRES"),
-		_T("ISUSER"),
-		_T("ISVERSION"),
-		_T("SRCDIR"),
-		_T("SRCDISK"),
-		_T("SUPPORTDIR"),
-		_T("TARGETDIR"),
-		_T("TARGETDISK"),
-		_T("WINDIR"),
-		_T("WINDISK"),
-		_T("WINSYSDIR"),
-		_T("WINSYSDISK"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser2KeywordList);
+	return s_User2KeywordHash.Find(pszChars, nLength);
 }
 
 /* built-in functions
@@ -23,67 +23,70 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszJavaKeywordList[] =
+{
+	_T("abstract"),
+	_T("async") SCRIPT_LEXIS_ONLY,
+	_T("await") SCRIPT_LEXIS_ONLY,
+	_T("boolean"),
+	_T("break"),
+	_T("byte"),
+	_T("byvalue"),
+	_T("case"),
+	_T("catch"),
+	_T("char"),
+	_T("class"),
+	_T("const"),
+	_T("continue"),
+	_T("default"),
+	_T("do"),
+	_T("double"),
+	_T("else"),
+	_T("extends"),
+	_T("false"),
+	_T("final"),
+	_T("finally"),
+	_T("float"),
+	_T("for"),
+	_T("function") SCRIPT_LEXIS_ONLY,
+	_T("goto"),
+	_T("if"),
+	_T("implements"),
+	_T("import"),
+	_T("instanceof"),
+	_T("int"),
+	_T("interface"),
+	_T("long"),
+	_T("native"),
+	_T("new"),
+	_T("null"),
+	_T("package"),
+	_T("private"),
+	_T("protected"),
+	_T("public"),
+	_T("return"),
+	_T("short"),
+	_T("static"),
+	_T("super"),
+	_T("switch"),
+	_T("synchronized"),
+	_T("this"),
+	_T("threadsafe"),
+	_T("throw"),
+	_T("transient"),
+	_T("true"),
+	_T("try"),
+	_T("undefined") SCRIPT_LEXIS_ONLY,
+	_T("var") SCRIPT_LEXIS_ONLY,
+	_T("void"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsncmp> const s_JavaKeywordHash(s_apszJavaKeywordList);
+
 static BOOL IsJavaKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszJavaKeywordList[] =
-	{
-		_T("abstract"),
-		_T("async") SCRIPT_LEXIS_ONLY,
-		_T("await") SCRIPT_LEXIS_ONLY,
-		_T("boolean"),
-		_T("break"),
-		_T("byte"),
-		_T("byvalue"),
-		_T("case"),
-		_T("catch"),
-		_T("char"),
-		_T("class"),
-		_T("const"),
-		_T("continue"),
-		_T("default"),
-		_T("do"),
-		_T("double"),
-		_T("else"),
-		_T("extends"),
-		_T("false"),
-		_T("final"),
-		_T("finally"),
-		_T("float"),
-		_T("for"),
-		_T("function") SCRIPT_LEXIS_ONLY,
-		_T("goto"),
-		_T("if"),
-		_T("implements"),
-		_T("import"),
-		_T("instanceof"),
-		_T("int"),
-		_T("interface"),
-		_T("long"),
-		_T("native"),
-		_T("new"),
-		_T("null"),
-		_T("package"),
-		_T("private"),
-		_T("protected"),
-		_T("public"),
-		_T("return"),
-		_T("short"),
-		_T("static"),
-		_T("super"),
-		_T("switch"),
-		_T("synchronized"),
-		_T("this"),
-		_T("threadsafe"),
-		_T("throw"),
-		_T("transient"),
-		_T("true"),
-		_T("try"),
-		_T("undefined") SCRIPT_LEXIS_ONLY,
-		_T("var") SCRIPT_LEXIS_ONLY,
-		_T("void"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszJavaKeywordList);
+	return s_JavaKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
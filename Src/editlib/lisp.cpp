@@ -23,238 +23,241 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszLispKeywordList[] =
+{
+	_T("abs"),
+	_T("acad_colordlg"),
+	_T("acad_helpdlg"),
+	_T("acad_strlsort"),
+	_T("action_tile"),
+	_T("add_list"),
+	_T("ads"),
+	_T("alert"),
+	_T("alloc"),
+	_T("and"),
+	_T("angle"),
+	_T("angtof"),
+	_T("angtos"),
+	_T("append"),
+	_T("apply"),
+	_T("arx"),
+	_T("arxload"),
+	_T("arxunload"),
+	_T("ascii"),
+	_T("assoc"),
+	_T("atan"),
+	_T("atof"),
+	_T("atoi"),
+	_T("atom"),
+	_T("atoms-family"),
+	_T("autoarxload"),
+	_T("autoload"),
+	_T("autoxload"),
+	_T("boole"),
+	_T("boundp"),
+	_T("caaaar"),
+	_T("caaadr"),
+	_T("caaar"),
+	_T("caadar"),
+	_T("caaddr"),
+	_T("caadr"),
+	_T("caar"),
+	_T("cadaar"),
+	_T("cadadr"),
+	_T("cadar"),
+	_T("caddar"),
+	_T("cadddr"),
+	_T("caddr"),
+	_T("cadr"),
+	_T("car"),
+	_T("cdaaar"),
+	_T("cdaadr"),
+	_T("cdaar"),
+	_T("cdadar"),
+	_T("cdaddr"),
+	_T("cdadr"),
+	_T("cdar"),
+	_T("cddaar"),
+	_T("cddadr"),
+	_T("cddar"),
+	_T("cdddar"),
+	_T("cddddr"),
+	_T("cdddr"),
+	_T("cddr"),
+	_T("cdr"),
+	_T("chr"),
+	_T("client_data_tile"),
+	_T("close"),
+	_T("command"),
+	_T("cond"),
+	_T("cons"),
+	_T("cos"),
+	_T("cvunit"),
+	_T("defun"),
+	_T("dictnext"),
+	_T("dictsearch"),
+	_T("dimx_tile"),
+	_T("dimy_tile"),
+	_T("distance"),
+	_T("distof"),
+	_T("done_dialog"),
+	_T("end_image"),
+	_T("end_list"),
+	_T("entdel"),
+	_T("entget"),
+	_T("entlast"),
+	_T("entmake"),
+	_T("entmod"),
+	_T("entnext"),
+	_T("entsel"),
+	_T("entupd"),
+	_T("eq"),
+	_T("equal"),
+	_T("eval"),
+	_T("exit"),
+	_T("exp"),
+	_T("expand"),
+	_T("expt"),
+	_T("fill_image"),
+	_T("findfile"),
+	_T("fix"),
+	_T("float"),
+	_T("foreach"),
+	_T("gc"),
+	_T("gcd"),
+	_T("get_attr"),
+	_T("get_tile"),
+	_T("getangle"),
+	_T("getcfg"),
+	_T("getcorner"),
+	_T("getdist"),
+	_T("getenv"),
+	_T("getfield"),
+	_T("getint"),
+	_T("getkword"),
+	_T("getorient"),
+	_T("getpoint"),
+	_T("getreal"),
+	_T("getstring"),
+	_T("getvar"),
+	_T("graphscr"),
+	_T("grclear"),
+	_T("grdraw"),
+	_T("grread"),
+	_T("grtext"),
+	_T("grvecs"),
+	_T("handent"),
+	_T("help"),
+	_T("if"),
+	_T("initget"),
+	_T("inters"),
+	_T("itoa"),
+	_T("lambda"),
+	_T("last"),
+	_T("length"),
+	_T("list"),
+	_T("listp"),
+	_T("load"),
+	_T("load_dialog"),
+	_T("log"),
+	_T("logand"),
+	_T("logior"),
+	_T("lsh"),
+	_T("mapcar"),
+	_T("max"),
+	_T("mem"),
+	_T("member"),
+	_T("menucmd"),
+	_T("min"),
+	_T("minusp"),
+	_T("mode_tile"),
+	_T("namedobjdict"),
+	_T("nentsel"),
+	_T("nentselp"),
+	_T("new_dialog"),
+	_T("not"),
+	_T("nth"),
+	_T("null"),
+	_T("numberp"),
+	_T("open"),
+	_T("or"),
+	_T("osnap"),
+	_T("polar"),
+	_T("prin1"),
+	_T("princ"),
+	_T("print"),
+	_T("progn"),
+	_T("prompt"),
+	_T("quit"),
+	_T("quote"),
+	_T("read"),
+	_T("read-char"),
+	_T("read-line"),
+	_T("redraw"),
+	_T("regapp"),
+	_T("rem"),
+	_T("repeat"),
+	_T("reverse"),
+	_T("rtos"),
+	_T("set"),
+	_T("set_tile"),
+	_T("setcfg"),
+	_T("setfunhelp"),
+	_T("setq"),
+	_T("setvar"),
+	_T("sin"),
+	_T("slide_image"),
+	_T("snvalid"),
+	_T("sqrt"),
+	_T("ssadd"),
+	_T("ssdel"),
+	_T("ssget"),
+	_T("sslength"),
+	_T("ssmemb"),
+	_T("ssname"),
+	_T("start_dialog"),
+	_T("start_image"),
+	_T("start_list"),
+	_T("startapp"),
+	_T("strcase"),
+	_T("strcat"),
+	_T("strlen"),
+	_T("subst"),
+	_T("substr"),
+	_T("tablet"),
+	_T("tblnext"),
+	_T("tblobjname"),
+	_T("tblsearch"),
+	_T("term_dialog"),
+	_T("terpri"),
+	_T("textbox"),
+	_T("textpage"),
+	_T("textscr"),
+	_T("trace"),
+	_T("trans"),
+	_T("type"),
+	_T("unload_dialog"),
+	_T("untrace"),
+	_T("vector_image"),
+	_T("ver"),
+	_T("vmon"),
+	_T("vports"),
+	_T("wcmatch"),
+	_T("while"),
+	_T("write-char"),
+	_T("write-line"),
+	_T("xdroom"),
+	_T("xdsize"),
+	_T("xload"),
+	_T("xunload"),
+	_T("zerop"),
+};
+
+static KeywordHash<_tcsncmp> const s_LispKeywordHash(s_apszLispKeywordList);
+
 static BOOL IsLispKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszLispKeywordList[] =
-	{
-		_T("abs"),
-		_T("acad_colordlg"),
-		_T("acad_helpdlg"),
-		_T("acad_strlsort"),
-		_T("action_tile"),
-		_T("add_list"),
-		_T("ads"),
-		_T("alert"),
-		_T("alloc"),
-		_T("and"),
-		_T("angle"),
-		_T("angtof"),
-		_T("angtos"),
-		_T("append"),
-		_T("apply"),
-		_T("arx"),
-		_T("arxload"),
-		_T("arxunload"),
-		_T("ascii"),
-		_T("assoc"),
-		_T("atan"),
-		_T("atof"),
-		_T("atoi"),
-		_T("atom"),
-		_T("atoms-family"),
-		_T("autoarxload"),
-		_T("autoload"),
-		_T("autoxload"),
-		_T("boole"),
-		_T("boundp"),
-		_T("caaaar"),
-		_T("caaadr"),
-		_T("caaar"),
-		_T("caadar"),
-		_T("caaddr"),
-		_T("caadr"),
-		_T("caar"),
-		_T("cadaar"),
-		_T("cadadr"),
-		_T("cadar"),
-		_T("caddar"),
-		_T("cadddr"),
-		_T("caddr"),
-		_T("cadr"),
-		_T("car"),
-		_T("cdaaar"),
-		_T("cdaadr"),
-		_T("cdaar"),
-		_T("cdadar"),
-		_T("cdaddr"),
-		_T("cdadr"),
-		_T("cdar"),
-		_T("cddaar"),
-		_T("cddadr"),
-		_T("cddar"),
-		_T("cdddar"),
-		_T("cddddr"),
-		_T("cdddr"),
-		_T("cddr"),
-		_T("cdr"),
-		_T("chr"),
-		_T("client_data_tile"),
-		_T("close"),
-		_T("command"),
-		_T("cond"),
-		_T("cons"),
-		_T("cos"),
-		_T("cvunit"),
-		_T("defun"),
-		_T("dictnext"),
-		_T("dictsearch"),
-		_T("dimx_tile"),
-		_T("dimy_tile"),
-		_T("distance"),
-		_T("distof"),
-		_T("done_dialog"),
-		_T("end_image"),
-		_T("end_list"),
-		_T("entdel"),
-		_T("entget"),
-		_T("entlast"),
-		_T("entmake"),
-		_T("entmod"),
-		_T("entnext"),
-		_T("entsel"),
-		_T("entupd"),
-		_T("eq"),
-		_T("equal"),
-		_T("eval"),
-		_T("exit"),
-		_T("exp"),
-		_T("expand"),
-		_T("expt"),
-		_T("fill_image"),
-		_T("findfile"),
-		_T("fix"),
-		_T("float"),
-		_T("foreach"),
-		_T("gc"),
-		_T("gcd"),
-		_T("get_attr"),
-		_T("get_tile"),
-		_T("getangle"),
-		_T("getcfg"),
-		_T("getcorner"),
-		_T("getdist"),
-		_T("getenv"),
-		_T("getfield"),
-		_T("getint"),
-		_T("getkword"),
-		_T("getorient"),
-		_T("getpoint"),
-		_T("getreal"),
-		_T("getstring"),
-		_T("getvar"),
-		_T("graphscr"),
-		_T("grclear"),
-		_T("grdraw"),
-		_T("grread"),
-		_T("grtext"),
-		_T("grvecs"),
-		_T("handent"),
-		_T("help"),
-		_T("if"),
-		_T("initget"),
-		_T("inters"),
-		_T("itoa"),
-		_T("lambda"),
-		_T("last"),
-		_T("length"),
-		_T("list"),
-		_T("listp"),
-		_T("load"),
-		_T("load_dialog"),
-		_T("log"),
-		_T("logand"),
-		_T("logior"),
-		_T("lsh"),
-		_T("mapcar"),
-		_T("max"),
-		_T("mem"),
-		_T("member"),
-		_T("menucmd"),
-		_T("min"),
-		_T("minusp"),
-		_T("mode_tile"),
-		_T("namedobjdict"),
-		_T("nentsel"),
-		_T("nentselp"),
-		_T("new_dialog"),
-		_T("not"),
-		_T("nth"),
-		_T("null"),
-		_T("numberp"),
-		_T("open"),
-		_T("or"),
-		_T("osnap"),
-		_T("polar"),
-		_T("prin1"),
-		_T("princ"),
-		_T("print"),
-		_T("progn"),
-		_T("prompt"),
-		_T("quit"),
-		_T("quote"),
-		_T("read"),
-		_T("read-char"),
-		_T("read-line"),
-		_T("redraw"),
-		_T("regapp"),
-		_T("rem"),
-		_T("repeat"),
-		_T("reverse"),
-		_T("rtos"),
-		_T("set"),
-		_T("set_tile"),
-		_T("setcfg"),
-		_T("setfunhelp"),
-		_T("setq"),
-		_T("setvar"),
-		_T("sin"),
-		_T("slide_image"),
-		_T("snvalid"),
-		_T("sqrt"),
-		_T("ssadd"),
-		_T("ssdel"),
-		_T("ssget"),
-		_T("sslength"),
-		_T("ssmemb"),
-		_T("ssname"),
-		_T("start_dialog"),
-		_T("start_image"),
-		_T("start_list"),
-		_T("startapp"),
-		_T("strcase"),
-		_T("strcat"),
-		_T("strlen"),
-		_T("subst"),
-		_T("substr"),
-		_T("tablet"),
-		_T("tblnext"),
-		_T("tblobjname"),
-		_T("tblsearch"),
-		_T("term_dialog"),
-		_T("terpri"),
-		_T("textbox"),
-		_T("textpage"),
-		_T("textscr"),
-		_T("trace"),
-		_T("trans"),
-		_T("type"),
-		_T("unload_dialog"),
-		_T("untrace"),
-		_T("vector_image"),
-		_T("ver"),
-		_T("vmon"),
-		_T("vports"),
-		_T("wcmatch"),
-		_T("while"),
-		_T("write-char"),
-		_T("write-line"),
-		_T("xdroom"),
-		_T("xdsize"),
-		_T("xload"),
-		_T("xunload"),
-		_T("zerop"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszLispKeywordList);
+	return s_LispKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -27,34 +27,37 @@
 using CommonKeywords::IsNumeric;
 
 // Lua keywords
+static LPCTSTR const s_apszLuaKeywordList[] =
+{
+	_T("and"),
+	_T("break"),
+	_T("do"),
+	_T("else"),
+	_T("elseif"),
+	_T("end"),
+	_T("false"),
+	_T("for"),
+	_T("function"),
+	_T("goto"),
+	_T("if"),
+	_T("in"),
+	_T("local"),
+	_T("nil"),
+	_T("not"),
+	_T("or"),
+	_T("repeat"),
+	_T("return"),
+	_T("then"),
+	_T("true"),
+	_T("until"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsncmp> const s_LuaKeywordHash(s_apszLuaKeywordList);
+
 static BOOL IsLuaKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszLuaKeywordList[] =
-	{
-		_T("and"),
-		_T("break"),
-		_T("do"),
-		_T("else"),
-		_T("elseif"),
-		_T("end"),
-		_T("false"),
-		_T("for"),
-		_T("function"),
-		_T("goto"),
-		_T("if"),
-		_T("in"),
-		_T("local"),
-		_T("nil"),
-		_T("not"),
-		_T("or"),
-		_T("repeat"),
-		_T("return"),
-		_T("then"),
-		_T("true"),
-		_T("until"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszLuaKeywordList);
+	return s_LuaKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -34,340 +34,346 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszNsisKeywordList[] =
+{
+	_T("Abort"),
+	_T("AddBrandingImage"),
+	_T("AddSharedDLL"),
+	_T("AddSize"),
+	_T("AllowRootDirInstall"),
+	_T("AllowSkipFiles"),
+	_T("AutoCloseWindow"),
+	_T("BGFont"),
+	_T("BGGradient"),
+	_T("BrandingText"),
+	_T("BringToFront"),
+	_T("CRCCheck"),
+	_T("Call"),
+	_T("CallInstDLL"),
+	_T("Caption"),
+	_T("ChangeUI"),
+	_T("CheckBitmap"),
+	_T("ClearErrors"),
+	_T("CloseWinamp"),
+	_T("CompareDLLVersions"),
+	_T("CompareFileTimes"),
+	_T("CompletedText"),
+	_T("ComponentText"),
+	_T("CopyFiles"),
+	_T("CreateDirectory"),
+	_T("CreateFont"),
+	_T("CreateShortCut"),
+	_T("Delete"),
+	_T("DeleteINISec"),
+	_T("DeleteINIStr"),
+	_T("DeleteNSPlug"),
+	_T("DeleteRegKey"),
+	_T("DeleteRegValue"),
+	_T("DetailPrint"),
+	_T("DetailsButtonText"),
+	_T("DirShow"),
+	_T("DirText"),
+	_T("DirVar"),
+	_T("DirVerify"),
+	_T("DisabledBitmap"),
+	_T("EnableWindow"),
+	_T("EnabledBitmap"),
+	_T("EnumRegKey"),
+	_T("EnumRegValue"),
+	_T("Exch"),
+	_T("Exec"),
+	_T("ExecShell"),
+	_T("ExecWait"),
+	_T("ExpandEnvStrings"),
+	_T("File"),
+	_T("FileBufSize"),
+	_T("FileClose"),
+	_T("FileErrorText"),
+	_T("FileOpen"),
+	_T("FileRead"),
+	_T("FileReadByte"),
+	_T("FileSeek"),
+	_T("FileWrite"),
+	_T("FileWriteByte"),
+	_T("FindClose"),
+	_T("FindFirst"),
+	_T("FindNext"),
+	_T("FindWindow"),
+	_T("FindWindowByTitle"),
+	_T("FlushINI"),
+	_T("Function"),
+	_T("FunctionEnd"),
+	_T("GetCurInstType"),
+	_T("GetCurrentAddress"),
+	_T("GetDLLVersion"),
+	_T("GetDLLVersionLocal"),
+	_T("GetDlgItem"),
+	_T("GetErrorLevel"),
+	_T("GetFileTime"),
+	_T("GetFileTimeLocal"),
+	_T("GetFullDLLPath"),
+	_T("GetFullPathName"),
+	_T("GetFunctionAddress"),
+	_T("GetIEVersion"),
+	_T("GetInstDirError"),
+	_T("GetLabelAddress"),
+	_T("GetParameters"),
+	_T("GetParent"),
+	_T("GetParentDir"),
+	_T("GetTempFileName"),
+	_T("GetWinampDSPPath"),
+	_T("GetWinampInstPath"),
+	_T("GetWinampSkinPath"),
+	_T("GetWinampVisPath"),
+	_T("GetWindowsVersion"),
+	_T("Goto"),
+	_T("HideWindow"),
+	_T("Icon"),
+	_T("IfAbort"),
+	_T("IfErrors"),
+	_T("IfFileExists"),
+	_T("IfRebootFlag"),
+	_T("IfSilent"),
+	_T("InitPluginsDir"),
+	_T("InstNSPlug"),
+	_T("InstProgressFlags"),
+	_T("InstType"),
+	_T("InstTypeGetText"),
+	_T("InstTypeSetText"),
+	_T("InstallButtonText"),
+	_T("InstallColors"),
+	_T("InstallDir"),
+	_T("InstallDirRegKey"),
+	_T("InstallNetscapePlugin"),
+	_T("IntCmp"),
+	_T("IntCmpU"),
+	_T("IntFmt"),
+	_T("IntOp"),
+	_T("IsFlashInstalled"),
+	_T("IsWindow"),
+	_T("LangString"),
+	_T("LangStringUP"),
+	_T("LicenseBkColor"),
+	_T("LicenseData"),
+	_T("LicenseForceSelection"),
+	_T("LicenseLangString"),
+	_T("LicenseText"),
+	_T("LoadLanguageFile"),
+	_T("LockWindow"),
+	_T("LogSet"),
+	_T("LogText"),
+	_T("LogicLib"),
+	_T("MessageBox"),
+	_T("MiscButtonText"),
+	_T("Name"),
+	_T("Nop"),
+	_T("OutFile"),
+	_T("PackEXEHeader"),
+	_T("Page"),
+	_T("PageCallbacks"),
+	_T("PageEx"),
+	_T("Pop"),
+	_T("Push"),
+	_T("Quit"),
+	_T("RMDir"),
+	_T("ReadEnvStr"),
+	_T("ReadINIStr"),
+	_T("ReadRegDWORD"),
+	_T("ReadRegStr"),
+	_T("Reboot"),
+	_T("RegDLL"),
+	_T("Rename"),
+	_T("ReserveFile"),
+	_T("Return"),
+	_T("SearchPath"),
+	_T("Section"),
+	_T("SectionDivider"),
+	_T("SectionEnd"),
+	_T("SectionGetFlags"),
+	_T("SectionGetInstTypes"),
+	_T("SectionGetSize"),
+	_T("SectionGetText"),
+	_T("SectionGroup"),
+	_T("SectionGroupEnd"),
+	_T("SectionIn"),
+	_T("SectionSetFlags"),
+	_T("SectionSetInstTypes"),
+	_T("SectionSetSize"),
+	_T("SectionSetText"),
+	_T("SendMessage"),
+	_T("SetAutoClose"),
+	_T("SetBrandingImage"),
+	_T("SetCompress"),
+	_T("SetCompressionLevel"),
+	_T("SetCompressor"),
+	_T("SetCompressorDictSize"),
+	_T("SetCtlColors"),
+	_T("SetCurInstType"),
+	_T("SetDatablockOptimize"),
+	_T("SetDateSave"),
+	_T("SetDetailsPrint"),
+	_T("SetDetailsView"),
+	_T("SetErrorLevel"),
+	_T("SetErrors"),
+	_T("SetFileAttributes"),
+	_T("SetFont"),
+	_T("SetOutPath"),
+	_T("SetOverwrite"),
+	_T("SetPluginUnload"),
+	_T("SetRebootFlag"),
+	_T("SetShellVarContext"),
+	_T("SetSilent"),
+	_T("SetStaticBkColor"),
+	_T("SetWindowLong"),
+	_T("ShowInstDetails"),
+	_T("ShowUnInstDetails"),
+	_T("ShowWindow"),
+	_T("SilentInstall"),
+	_T("SilentUnInstall"),
+	_T("Sleep"),
+	_T("SpaceTexts"),
+	_T("StrCmp"),
+	_T("StrCpy"),
+	_T("StrLen"),
+	_T("StrStr"),
+	_T("SubCaption"),
+	_T("SubSection"),
+	_T("SubSectionEnd"),
+	_T("TrimNewlines"),
+	_T("UnRegDLL"),
+	_T("UninstPage"),
+	_T("UninstallButtonText"),
+	_T("UninstallCaption"),
+	_T("UninstallExeName"),
+	_T("UninstallIcon"),
+	_T("UninstallSubCaption"),
+	_T("UninstallText"),
+	_T("UpgradeDLL"),
+	_T("VIAddVersionKey"),
+	_T("VIProductVersion"),
+	_T("Var"),
+	_T("WindowIcon"),
+	_T("WriteINIStr"),
+	_T("WriteRegBin"),
+	_T("WriteRegDWORD"),
+	_T("WriteRegExpandStr"),
+	_T("WriteRegStr"),
+	_T("WriteUninstaller"),
+	_T("XPStyle"),
+};
+
+static KeywordHash<_tcsncmp> const s_NsisKeywordHash(s_apszNsisKeywordList);
+
 static BOOL IsNsisKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszNsisKeywordList[] =
-	{
-		_T("Abort"),
-		_T("AddBrandingImage"),
-		_T("AddSharedDLL"),
-		_T("AddSize"),
-		_T("AllowRootDirInstall"),
-		_T("AllowSkipFiles"),
-		_T("AutoCloseWindow"),
-		_T("BGFont"),
-		_T("BGGradient"),
-		_T("BrandingText"),
-		_T("BringToFront"),
-		_T("CRCCheck"),
-		_T("Call"),
-		_T("CallInstDLL"),
-		_T("Caption"),
-		_T("ChangeUI"),
-		_T("CheckBitmap"),
-		_T("ClearErrors"),
-		_T("CloseWinamp"),
-		_T("CompareDLLVersions"),
-		_T("CompareFileTimes"),
-		_T("CompletedText"),
-		_T("ComponentText"),
-		_T("CopyFiles"),
-		_T("CreateDirectory"),
-		_T("CreateFont"),
-		_T("CreateShortCut"),
-		_T("Delete"),
-		_T("DeleteINISec"),
-		_T("DeleteINIStr"),
-		_T("DeleteNSPlug"),
-		_T("DeleteRegKey"),
-		_T("DeleteRegValue"),
-		_T("DetailPrint"),
-		_T("DetailsButtonText"),
-		_T("DirShow"),
-		_T("DirText"),
-		_T("DirVar"),
-		_T("DirVerify"),
-		_T("DisabledBitmap"),
-		_T("EnableWindow"),
-		_T("EnabledBitmap"),
-		_T("EnumRegKey"),
-		_T("EnumRegValue"),
-		_T("Exch"),
-		_T("Exec"),
-		_T("ExecShell"),
-		_T("ExecWait"),
-		_T("ExpandEnvStrings"),
-		_T("File"),
-		_T("FileBufSize"),
-		_T("FileClose"),
-		_T("FileErrorText"),
-		_T("FileOpen"),
-		_T("FileRead"),
-		_T("FileReadByte"),
-		_T("FileSeek"),
-		_T("FileWrite"),
-		_T("FileWriteByte"),
-		_T("FindClose"),
-		_T("FindFirst"),
-		_T("FindNext"),
-		_T("FindWindow"),
-		_T("FindWindowByTitle"),
-		_T("FlushINI"),
-		_T("Function"),
-		_T("FunctionEnd"),
-		_T("GetCurInstType"),
-		_T("GetCurrentAddress"),
-		_T("GetDLLVersion"),
-		_T("GetDLLVersionLocal"),
-		_T("GetDlgItem"),
-		_T("GetErrorLevel"),
-		_T("GetFileTime"),
-		_T("GetFileTimeLocal"),
-		_T("GetFullDLLPath"),
-		_T("GetFullPathName"),
-		_T("GetFunctionAddress"),
-		_T("GetIEVersion"),
-		_T("GetInstDirError"),
-		_T("GetLabelAddress"),
-		_T("GetParameters"),
-		_T("GetParent"),
-		_T("GetParentDir"),
-		_T("GetTempFileName"),
-		_T("GetWinampDSPPath"),
-		_T("GetWinampInstPath"),
-		_T("GetWinampSkinPath"),
-		_T("GetWinampVisPath"),
-		_T("GetWindowsVersion"),
-		_T("Goto"),
-		_T("HideWindow"),
-		_T("Icon"),
-		_T("IfAbort"),
-		_T("IfErrors"),
-		_T("IfFileExists"),
-		_T("IfRebootFlag"),
-		_T("IfSilent"),
-		_T("InitPluginsDir"),
-		_T("InstNSPlug"),
-		_T("InstProgressFlags"),
-		_T("InstType"),
-		_T("InstTypeGetText"),
-		_T("InstTypeSetText"),
-		_T("InstallButtonText"),
-		_T("InstallColors"),
-		_T("InstallDir"),
-		_T("InstallDirRegKey"),
-		_T("InstallNetscapePlugin"),
-		_T("IntCmp"),
-		_T("IntCmpU"),
-		_T("IntFmt"),
-		_T("IntOp"),
-		_T("IsFlashInstalled"),
-		_T("IsWindow"),
-		_T("LangString"),
-		_T("LangStringUP"),
-		_T("LicenseBkColor"),
-		_T("LicenseData"),
-		_T("LicenseForceSelection"),
-		_T("LicenseLangString"),
-		_T("LicenseText"),
-		_T("LoadLanguageFile"),
-		_T("LockWindow"),
-		_T("LogSet"),
-		_T("LogText"),
-		_T("LogicLib"),
-		_T("MessageBox"),
-		_T("MiscButtonText"),
-		_T("Name"),
-		_T("Nop"),
-		_T("OutFile"),
-		_T("PackEXEHeader"),
-		_T("Page"),
-		_T("PageCallbacks"),
-		_T("PageEx"),
-		_T("Pop"),
-		_T("Push"),
-		_T("Quit"),
-		_T("RMDir"),
-		_T("ReadEnvStr"),
-		_T("ReadINIStr"),
-		_T("ReadRegDWORD"),
-		_T("ReadRegStr"),
-		_T("Reboot"),
-		_T("RegDLL"),
-		_T("Rename"),
-		_T("ReserveFile"),
-		_T("Return"),
-		_T("SearchPath"),
-		_T("Section"),
-		_T("SectionDivider"),
-		_T("SectionEnd"),
-		_T("SectionGetFlags"),
-		_T("SectionGetInstTypes"),
-		_T("SectionGetSize"),
-		_T("SectionGetText"),
-		_T("SectionGroup"),
-		_T("SectionGroupEnd"),
-		_T("SectionIn"),
-		_T("SectionSetFlags"),
-		_T("SectionSetInstTypes"),
-		_T("SectionSetSize"),
-		_T("SectionSetText"),
-		_T("SendMessage"),
-		_T("SetAutoClose"),
-		_T("SetBrandingImage"),
-		_T("SetCompress"),
-		_T("SetCompressionLevel"),
-		_T("SetCompressor"),
-		_T("SetCompressorDictSize"),
-		_T("SetCtlColors"),
-		_T("SetCurInstType"),
-		_T("SetDatablockOptimize"),
-		_T("SetDateSave"),
-		_T("SetDetailsPrint"),
-		_T("SetDetailsView"),
-		_T("SetErrorLevel"),
-		_T("SetErrors"),
-		_T("SetFileAttributes"),
-		_T("SetFont"),
-		_T("SetOutPath"),
-		_T("SetOverwrite"),
-		_T("SetPluginUnload"),
-		_T("SetRebootFlag"),
-		_T("SetShellVarContext"),
-		_T("SetSilent"),
-		_T("SetStaticBkColor"),
-		_T("SetWindowLong"),
-		_T("ShowInstDetails"),
-		_T("ShowUnInstDetails"),
-		_T("ShowWindow"),
-		_T("SilentInstall"),
-		_T("SilentUnInstall"),
-		_T("Sleep"),
-		_T("SpaceTexts"),
-		_T("StrCmp"),
-		_T("StrCpy"),
-		_T("StrLen"),
-		_T("StrStr"),
-		_T("SubCaption"),
-		_T("SubSection"),
-		_T("SubSectionEnd"),
-		_T("TrimNewlines"),
-		_T("UnRegDLL"),
-		_T("UninstPage"),
-		_T("UninstallButtonText"),
-		_T("UninstallCaption"),
-		_T("UninstallExeName"),
-		_T("UninstallIcon"),
-		_T("UninstallSubCaption"),
-		_T("UninstallText"),
-		_T("UpgradeDLL"),
-		_T("VIAddVersionKey"),
-		_T("VIProductVersion"),
-		_T("Var"),
-		_T("WindowIcon"),
-		_T("WriteINIStr"),
-		_T("WriteRegBin"),
-		_T("WriteRegDWORD"),
-		_T("WriteRegExpandStr"),
-		_T("WriteRegStr"),
-		_T("WriteUninstaller"),
-		_T("XPStyle"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszNsisKeywordList);
+	return s_NsisKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("ARCHIVE"),
+	_T("FILE_ATTRIBUTE_ARCHIVE"),
+	_T("FILE_ATTRIBUTE_HIDDEN"),
+	_T("FILE_ATTRIBUTE_NORMAL"),
+	_T("FILE_ATTRIBUTE_OFFLINE"),
+	_T("FILE_ATTRIBUTE_READONLY"),
+	_T("FILE_ATTRIBUTE_SYSTEM"),
+	_T("FILE_ATTRIBUTE_TEMPORARY"),
+	_T("HIDDEN"),
+	_T("HKCC"),
+	_T("HKCR"),
+	_T("HKCU"),
+	_T("HKDD"),
+	_T("HKEY_CLASSES_ROOT"),
+	_T("HKEY_CURRENT_CONFIG"),
+	_T("HKEY_CURRENT_USER"),
+	_T("HKEY_DYN_DATA"),
+	_T("HKEY_LOCAL_MACHINE"),
+	_T("HKEY_PERFORMANCE_DATA"),
+	_T("HKEY_USERS"),
+	_T("HKLM"),
+	_T("HKPD"),
+	_T("HKU"),
+	_T("IDABORT"),
+	_T("IDCANCEL"),
+	_T("IDIGNORE"),
+	_T("IDNO"),
+	_T("IDOK"),
+	_T("IDRETRY"),
+	_T("IDYES"),
+	_T("MB_ABORTRETRYIGNORE"),
+	_T("MB_DEFBUTTON1"),
+	_T("MB_DEFBUTTON2"),
+	_T("MB_DEFBUTTON3"),
+	_T("MB_DEFBUTTON4"),
+	_T("MB_ICONEXCLAMATION"),
+	_T("MB_ICONINFORMATION"),
+	_T("MB_ICONQUESTION"),
+	_T("MB_ICONSTOP"),
+	_T("MB_ICONSTOP"),
+	_T("MB_OK"),
+	_T("MB_OKCANCEL"),
+	_T("MB_RETRYCANCEL"),
+	_T("MB_RIGHT"),
+	_T("MB_RTLREADING"),
+	_T("MB_SETFOREGROUND"),
+	_T("MB_TOPMOST"),
+	_T("MB_YESNO"),
+	_T("MB_YESNO"),
+	_T("MB_YESNOCANCEL"),
+	_T("NORMAL"),
+	_T("OFFLINE"),
+	_T("READONLY"),
+	_T("RO"),
+	_T("SW_HIDE"),
+	_T("SW_SHOWMAXIMIZED"),
+	_T("SW_SHOWMINIMIZED"),
+	_T("SW_SHOWNORMAL"),
+	_T("SYSTEM"),
+	_T("TEMPORARY"),
+	_T("alwaysoff"),
+	_T("auto"),
+	_T("both"),
+	_T("bottom"),
+	_T("bzip2"),
+	_T("components"),
+	_T("custom"),
+	_T("directory"),
+	_T("false"),
+	_T("force"),
+	_T("hide"),
+	_T("ifdiff"),
+	_T("ifnewer"),
+	_T("instfiles"),
+	_T("lastused"),
+	_T("leave"),
+	_T("left"),
+	_T("license"),
+	_T("listonly"),
+	_T("lzma"),
+	_T("manual"),
+	_T("nevershow"),
+	_T("none"),
+	_T("normal"),
+	_T("off"),
+	_T("on"),
+	_T("right"),
+	_T("show"),
+	_T("silent"),
+	_T("silentlog"),
+	_T("textonly"),
+	_T("top"),
+	_T("true"),
+	_T("try"),
+	_T("uninstConfirm"),
+	_T("zlib"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("ARCHIVE"),
-		_T("FILE_ATTRIBUTE_ARCHIVE"),
-		_T("FILE_ATTRIBUTE_HIDDEN"),
-		_T("FILE_ATTRIBUTE_NORMAL"),
-		_T("FILE_ATTRIBUTE_OFFLINE"),
-		_T("FILE_ATTRIBUTE_READONLY"),
-		_T("FILE_ATTRIBUTE_SYSTEM"),
-		_T("FILE_ATTRIBUTE_TEMPORARY"),
-		_T("HIDDEN"),
-		_T("HKCC"),
-		_T("HKCR"),
-		_T("HKCU"),
-		_T("HKDD"),
-		_T("HKEY_CLASSES_ROOT"),
-		_T("HKEY_CURRENT_CONFIG"),
-		_T("HKEY_CURRENT_USER"),
-		_T("HKEY_DYN_DATA"),
-		_T("HKEY_LOCAL_MACHINE"),
-		_T("HKEY_PERFORMANCE_DATA"),
-		_T("HKEY_USERS"),
-		_T("HKLM"),
-		_T("HKPD"),
-		_T("HKU"),
-		_T("IDABORT"),
-		_T("IDCANCEL"),
-		_T("IDIGNORE"),
-		_T("IDNO"),
-		_T("IDOK"),
-		_T("IDRETRY"),
-		_T("IDYES"),
-		_T("MB_ABORTRETRYIGNORE"),
-		_T("MB_DEFBUTTON1"),
-		_T("MB_DEFBUTTON2"),
-		_T("MB_DEFBUTTON3"),
-		_T("MB_DEFBUTTON4"),
-		_T("MB_ICONEXCLAMATION"),
-		_T("MB_ICONINFORMATION"),
-		_T("MB_ICONQUESTION"),
-		_T("MB_ICONSTOP"),
-		_T("MB_ICONSTOP"),
-		_T("MB_OK"),
-		_T("MB_OKCANCEL"),
-		_T("MB_RETRYCANCEL"),
-		_T("MB_RIGHT"),
-		_T("MB_RTLREADING"),
-		_T("MB_SETFOREGROUND"),
-		_T("MB_TOPMOST"),
-		_T("MB_YESNO"),
-		_T("MB_YESNO"),
-		_T("MB_YESNOCANCEL"),
-		_T("NORMAL"),
-		_T("OFFLINE"),
-		_T("READONLY"),
-		_T("RO"),
-		_T("SW_HIDE"),
-		_T("SW_SHOWMAXIMIZED"),
-		_T("SW_SHOWMINIMIZED"),
-		_T("SW_SHOWNORMAL"),
-		_T("SYSTEM"),
-		_T("TEMPORARY"),
-		_T("alwaysoff"),
-		_T("auto"),
-		_T("both"),
-		_T("bottom"),
-		_T("bzip2"),
-		_T("components"),
-		_T("custom"),
-		_T("directory"),
-		_T("false"),
-		_T("force"),
-		_T("hide"),
-		_T("ifdiff"),
-		_T("ifnewer"),
-		_T("instfiles"),
-		_T("lastused"),
-		_T("leave"),
-		_T("left"),
-		_T("license"),
-		_T("listonly"),
-		_T("lzma"),
-		_T("manual"),
-		_T("nevershow"),
-		_T("none"),
-		_T("normal"),
-		_T("off"),
-		_T("on"),
-		_T("right"),
-		_T("show"),
-		_T("silent"),
-		_T("silentlog"),
-		_T("textonly"),
-		_T("top"),
-		_T("true"),
-		_T("try"),
-		_T("uninstConfirm"),
-		_T("zlib"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
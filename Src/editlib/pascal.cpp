@@ -24,89 +24,92 @@
 using CommonKeywords::IsNumeric;
 
 // Pascal keywords
+static LPCTSTR const s_apszPascalKeywordList[] =
+{
+	_T("Abstract"),
+	_T("and"),
+	_T("array"),
+	_T("As"),
+	_T("asm"),
+	_T("assembler"),
+	_T("begin"),
+	_T("case"),
+	_T("Class"),
+	_T("const"),
+	_T("constructor"),
+	_T("Default"),
+	_T("destructor"),
+	_T("div"),
+	_T("do"),
+	_T("downto"),
+	_T("Dynamic"),
+	_T("else"),
+	_T("end"),
+	_T("Except"),
+	_T("exit"),
+	_T("Export"),
+	_T("external"),
+	_T("far"),
+	_T("file"),
+	_T("Finally"),
+	_T("for"),
+	_T("function"),
+	_T("goto"),
+	_T("if"),
+	_T("implementation"),
+	_T("In"),
+	_T("Index"),
+	_T("inherited"),
+	_T("inline"),
+	_T("interface"),
+	_T("Is"),
+	_T("label"),
+	_T("mod"),
+	_T("near"),
+	_T("nil"),
+	_T("not"),
+	_T("object"),
+	_T("of"),
+	_T("On"),
+	_T("or"),
+	_T("Out"),
+	_T("Overload"),
+	_T("Override"),
+	_T("Packed"),
+	_T("Private"),
+	_T("procedure"),
+	_T("program"),
+	_T("Property"),
+	_T("Protected"),
+	_T("Public"),
+	_T("Published"),
+	_T("Raise"),
+	_T("record"),
+	_T("repeat"),
+	_T("set"),
+	_T("Shl"),
+	_T("Shr"),
+	_T("string"),
+	_T("then"),
+	_T("ThreadVar"),
+	_T("to"),
+	_T("Try"),
+	_T("type"),
+	_T("unit"),
+	_T("until"),
+	_T("uses"),
+	_T("var"),
+	_T("virtual"),
+	_T("while"),
+	_T("with"),
+	_T("xor"),
+};
+
+static KeywordHash<_tcsnicmp> const s_PascalKeywordHash(s_apszPascalKeywordList);
+
 static BOOL IsPascalKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPascalKeywordList[] =
-	{
-		_T("Abstract"),
-		_T("and"),
-		_T("array"),
-		_T("As"),
-		_T("asm"),
-		_T("assembler"),
-		_T("begin"),
-		_T("case"),
-		_T("Class"),
-		_T("const"),
-		_T("constructor"),
-		_T("Default"),
-		_T("destructor"),
-		_T("div"),
-		_T("do"),
-		_T("downto"),
-		_T("Dynamic"),
-		_T("else"),
-		_T("end"),
-		_T("Except"),
-		_T("exit"),
-		_T("Export"),
-		_T("external"),
-		_T("far"),
-		_T("file"),
-		_T("Finally"),
-		_T("for"),
-		_T("function"),
-		_T("goto"),
-		_T("if"),
-		_T("implementation"),
-		_T("In"),
-		_T("Index"),
-		_T("inherited"),
-		_T("inline"),
-		_T("interface"),
-		_T("Is"),
-		_T("label"),
-		_T("mod"),
-		_T("near"),
-		_T("nil"),
-		_T("not"),
-		_T("object"),
-		_T("of"),
-		_T("On"),
-		_T("or"),
-		_T("Out"),
-		_T("Overload"),
-		_T("Override"),
-		_T("Packed"),
-		_T("Private"),
-		_T("procedure"),
-		_T("program"),
-		_T("Property"),
-		_T("Protected"),
-		_T("Public"),
-		_T("Published"),
-		_T("Raise"),
-		_T("record"),
-		_T("repeat"),
-		_T("set"),
-		_T("Shl"),
-		_T("Shr"),
-		_T("string"),
-		_T("then"),
-		_T("ThreadVar"),
-		_T("to"),
-		_T("Try"),
-		_T("type"),
-		_T("unit"),
-		_T("until"),
-		_T("uses"),
-		_T("var"),
-		_T("virtual"),
-		_T("while"),
-		_T("with"),
-		_T("xor"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPascalKeywordList);
+	return s_PascalKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
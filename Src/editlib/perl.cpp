@@ -23,233 +23,236 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszPerlKeywordList[] =
+{
+	_T("abs"),
+	_T("accept"),
+	_T("alarm"),
+	_T("and"),
+	_T("atan2"),
+	_T("bind"),
+	_T("binmode"),
+	_T("bless"),
+	_T("bootstrap"),
+	_T("caller"),
+	_T("chdir"),
+	_T("chmod"),
+	_T("chomp"),
+	_T("chop"),
+	_T("chown"),
+	_T("chr"),
+	_T("chroot"),
+	_T("close"),
+	_T("closedir"),
+	_T("connect"),
+	_T("continue"),
+	_T("cos"),
+	_T("crypt"),
+	_T("dbmclose"),
+	_T("dbmopen"),
+	_T("defined"),
+	_T("delete"),
+	_T("die"),
+	_T("do"),
+	_T("dump"),
+	_T("each"),
+	_T("else"),
+	_T("elsif"),
+	_T("endgrent"),
+	_T("endhostent"),
+	_T("endnetent"),
+	_T("endprotoent"),
+	_T("endpwent"),
+	_T("endservent"),
+	_T("eof"),
+	_T("eq"),
+	_T("eval"),
+	_T("exec"),
+	_T("exists"),
+	_T("exit"),
+	_T("exp"),
+	_T("fcntl"),
+	_T("fileno"),
+	_T("flock"),
+	_T("for"),
+	_T("foreach"),
+	_T("fork"),
+	_T("formline"),
+	_T("getc"),
+	_T("getgrent"),
+	_T("getgrgid"),
+	_T("getgrnam"),
+	_T("getgrname"),
+	_T("gethostbyaddr"),
+	_T("gethostbyname"),
+	_T("gethostent"),
+	_T("getlogin"),
+	_T("getnetbyaddr"),
+	_T("getnetbyname"),
+	_T("getnetent"),
+	_T("getpeername"),
+	_T("getpgrp"),
+	_T("getppid"),
+	_T("getpriority"),
+	_T("getprotobyname"),
+	_T("getprotobynumber"),
+	_T("getprotoent"),
+	_T("getpwent"),
+	_T("getpwnam"),
+	_T("getpwuid"),
+	_T("getservbyname"),
+	_T("getservbyport"),
+	_T("getservent"),
+	_T("getsockname"),
+	_T("getsockopt"),
+	_T("glob"),
+	_T("gmtime"),
+	_T("goto"),
+	_T("grep"),
+	_T("hex"),
+	_T("if"),
+	_T("import"),
+	_T("index"),
+	_T("int"),
+	_T("ioctl"),
+	_T("join"),
+	_T("keys"),
+	_T("kill"),
+	_T("last"),
+	_T("lc"),
+	_T("lcfirst"),
+	_T("length"),
+	_T("link"),
+	_T("listen"),
+	_T("local"),
+	_T("localtime"),
+	_T("log"),
+	_T("lstat"),
+	_T("m"),
+	_T("map"),
+	_T("mkdir"),
+	_T("msgctl"),
+	_T("msgget"),
+	_T("msgrcv"),
+	_T("msgsnd"),
+	_T("my"),
+	_T("ne"),
+	_T("next"),
+	_T("no"),
+	_T("not"),
+	_T("oct"),
+	_T("open"),
+	_T("opendir"),
+	_T("or"),
+	_T("ord"),
+	_T("pack"),
+	_T("package"),
+	_T("pipe"),
+	_T("pop"),
+	_T("pos"),
+	_T("print"),
+	_T("printf"),
+	_T("push"),
+	_T("q"),
+	_T("qq"),
+	_T("quotemeta"),
+	_T("qw"),
+	_T("qx"),
+	_T("rand"),
+	_T("read"),
+	_T("readdir"),
+	_T("readlink"),
+	_T("recv"),
+	_T("redo"),
+	_T("ref"),
+	_T("rename"),
+	_T("require"),
+	_T("reset"),
+	_T("return"),
+	_T("reverse"),
+	_T("rewinddir"),
+	_T("rindex"),
+	_T("rmdir"),
+	_T("s"),
+	_T("scalar"),
+	_T("seek"),
+	_T("seekdir"),
+	_T("select"),
+	_T("semctl"),
+	_T("semget"),
+	_T("semop"),
+	_T("send"),
+	_T("setgrent"),
+	_T("sethostent"),
+	_T("setnetent"),
+	_T("setpgrp"),
+	_T("setpriority"),
+	_T("setprotoent"),
+	_T("setpwent"),
+	_T("setservent"),
+	_T("setsockopt"),
+	_T("sgmget"),
+	_T("shift"),
+	_T("shmctl"),
+	_T("shmread"),
+	_T("shmwrite"),
+	_T("shutdown"),
+	_T("sin"),
+	_T("sleep"),
+	_T("socket"),
+	_T("socketpair"),
+	_T("sort"),
+	_T("splice"),
+	_T("split"),
+	_T("sprintf"),
+	_T("sqrt"),
+	_T("srand"),
+	_T("stat"),
+	_T("study"),
+	_T("sub"),
+	_T("substr"),
+	_T("symlink"),
+	_T("syscall"),
+	_T("sysread"),
+	_T("system"),
+	_T("syswrite"),
+	_T("tan"),
+	_T("tell"),
+	_T("telldir"),
+	_T("tie"),
+	_T("time"),
+	_T("times"),
+	_T("tr"),
+	_T("truncate"),
+	_T("uc"),
+	_T("ucfirst"),
+	_T("umask"),
+	_T("undef"),
+	_T("unless"),
+	_T("unlink"),
+	_T("unpack"),
+	_T("unshift"),
+	_T("untie"),
+	_T("until"),
+	_T("use"),
+	_T("utime"),
+	_T("values"),
+	_T("vec"),
+	_T("wait"),
+	_T("waitpid"),
+	_T("wantarray"),
+	_T("warn"),
+	_T("while"),
+	_T("write"),
+	_T("x"),
+	_T("y"),
+};
+
+static KeywordHash<_tcsnicmp> const s_PerlKeywordHash(s_apszPerlKeywordList);
+
 static BOOL IsPerlKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPerlKeywordList[] =
-	{
-		_T("abs"),
-		_T("accept"),
-		_T("alarm"),
-		_T("and"),
-		_T("atan2"),
-		_T("bind"),
-		_T("binmode"),
-		_T("bless"),
-		_T("bootstrap"),
-		_T("caller"),
-		_T("chdir"),
-		_T("chmod"),
-		_T("chomp"),
-		_T("chop"),
-		_T("chown"),
-		_T("chr"),
-		_T("chroot"),
-		_T("close"),
-		_T("closedir"),
-		_T("connect"),
-		_T("continue"),
-		_T("cos"),
-		_T("crypt"),
-		_T("dbmclose"),
-		_T("dbmopen"),
-		_T("defined"),
-		_T("delete"),
-		_T("die"),
-		_T("do"),
-		_T("dump"),
-		_T("each"),
-		_T("else"),
-		_T("elsif"),
-		_T("endgrent"),
-		_T("endhostent"),
-		_T("endnetent"),
-		_T("endprotoent"),
-		_T("endpwent"),
-		_T("endservent"),
-		_T("eof"),
-		_T("eq"),
-		_T("eval"),
-		_T("exec"),
-		_T("exists"),
-		_T("exit"),
-		_T("exp"),
-		_T("fcntl"),
-		_T("fileno"),
-		_T("flock"),
-		_T("for"),
-		_T("foreach"),
-		_T("fork"),
-		_T("formline"),
-		_T("getc"),
-		_T("getgrent"),
-		_T("getgrgid"),
-		_T("getgrnam"),
-		_T("getgrname"),
-		_T("gethostbyaddr"),
-		_T("gethostbyname"),
-		_T("gethostent"),
-		_T("getlogin"),
-		_T("getnetbyaddr"),
-		_T("getnetbyname"),
-		_T("getnetent"),
-		_T("getpeername"),
-		_T("getpgrp"),
-		_T("getppid"),
-		_T("getpriority"),
-		_T("getprotobyname"),
-		_T("getprotobynumber"),
-		_T("getprotoent"),
-		_T("getpwent"),
-		_T("getpwnam"),
-		_T("getpwuid"),
-		_T("getservbyname"),
-		_T("getservbyport"),
-		_T("getservent"),
-		_T("getsockname"),
-		_T("getsockopt"),
-		_T("glob"),
-		_T("gmtime"),
-		_T("goto"),
-		_T("grep"),
-		_T("hex"),
-		_T("if"),
-		_T("import"),
-		_T("index"),
-		_T("int"),
-		_T("ioctl"),
-		_T("join"),
-		_T("keys"),
-		_T("kill"),
-		_T("last"),
-		_T("lc"),
-		_T("lcfirst"),
-		_T("length"),
-		_T("link"),
-		_T("listen"),
-		_T("local"),
-		_T("localtime"),
-		_T("log"),
-		_T("lstat"),
-		_T("m"),
-		_T("map"),
-		_T("mkdir"),
-		_T("msgctl"),
-		_T("msgget"),
-		_T("msgrcv"),
-		_T("msgsnd"),
-		_T("my"),
-		_T("ne"),
-		_T("next"),
-		_T("no"),
-		_T("not"),
-		_T("oct"),
-		_T("open"),
-		_T("opendir"),
-		_T("or"),
-		_T("ord"),
-		_T("pack"),
-		_T("package"),
-		_T("pipe"),
-		_T("pop"),
-		_T("pos"),
-		_T("print"),
-		_T("printf"),
-		_T("push"),
-		_T("q"),
-		_T("qq"),
-		_T("quotemeta"),
-		_T("qw"),
-		_T("qx"),
-		_T("rand"),
-		_T("read"),
-		_T("readdir"),
-		_T("readlink"),
-		_T("recv"),
-		_T("redo"),
-		_T("ref"),
-		_T("rename"),
-		_T("require"),
-		_T("reset"),
-		_T("return"),
-		_T("reverse"),
-		_T("rewinddir"),
-		_T("rindex"),
-		_T("rmdir"),
-		_T("s"),
-		_T("scalar"),
-		_T("seek"),
-		_T("seekdir"),
-		_T("select"),
-		_T("semctl"),
-		_T("semget"),
-		_T("semop"),
-		_T("send"),
-		_T("setgrent"),
-		_T("sethostent"),
-		_T("setnetent"),
-		_T("setpgrp"),
-		_T("setpriority"),
-		_T("setprotoent"),
-		_T("setpwent"),
-		_T("setservent"),
-		_T("setsockopt"),
-		_T("sgmget"),
-		_T("shift"),
-		_T("shmctl"),
-		_T("shmread"),
-		_T("shmwrite"),
-		_T("shutdown"),
-		_T("sin"),
-		_T("sleep"),
-		_T("socket"),
-		_T("socketpair"),
-		_T("sort"),
-		_T("splice"),
-		_T("split"),
-		_T("sprintf"),
-		_T("sqrt"),
-		_T("srand"),
-		_T("stat"),
-		_T("study"),
-		_T("sub"),
-		_T("substr"),
-		_T("symlink"),
-		_T("syscall"),
-		_T("sysread"),
-		_T("system"),
-		_T("syswrite"),
-		_T("tan"),
-		_T("tell"),
-		_T("telldir"),
-		_T("tie"),
-		_T("time"),
-		_T("times"),
-		_T("tr"),
-		_T("truncate"),
-		_T("uc"),
-		_T("ucfirst"),
-		_T("umask"),
-		_T("undef"),
-		_T("unless"),
-		_T("unlink"),
-		_T("unpack"),
-		_T("unshift"),
-		_T("untie"),
-		_T("until"),
-		_T("use"),
-		_T("utime"),
-		_T("values"),
-		_T("vec"),
-		_T("wait"),
-		_T("waitpid"),
-		_T("wantarray"),
-		_T("warn"),
-		_T("while"),
-		_T("write"),
-		_T("x"),
-		_T("y"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPerlKeywordList);
+	return s_PerlKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
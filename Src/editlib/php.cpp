@@ -23,84 +23,93 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszPhpKeywordList[] =
+{
+	_T("array"),
+	_T("as"),
+	_T("break"),
+	_T("case"),
+	_T("cfunction"),
+	_T("class"),
+	_T("const"),
+	_T("continue"),
+	_T("declare"),
+	_T("default"),
+	_T("die"),
+	_T("do"),
+	_T("echo"),
+	_T("else"),
+	_T("elseif"),
+	_T("empty"),
+	_T("enddeclare"),
+	_T("endfor"),
+	_T("endforeach"),
+	_T("endif"),
+	_T("endswitch"),
+	_T("endwhile"),
+	_T("eval"),
+	_T("exception"),
+	_T("exit"),
+	_T("extends"),
+	_T("for"),
+	_T("foreach"),
+	_T("function"),
+	_T("global"),
+	_T("if"),
+	_T("include"),
+	_T("include_once"),
+	_T("isset"),
+	_T("list"),
+	_T("new"),
+	_T("old_function"),
+	_T("php_user_filter"),
+	_T("print"),
+	_T("require"),
+	_T("require_once"),
+	_T("return"),
+	_T("static"),
+	_T("switch"),
+	_T("unset"),
+	_T("use"),
+	_T("var"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsnicmp> const s_PhpKeywordHash(s_apszPhpKeywordList);
+
 static BOOL IsPhpKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPhpKeywordList[] =
-	{
-		_T("array"),
-		_T("as"),
-		_T("break"),
-		_T("case"),
-		_T("cfunction"),
-		_T("class"),
-		_T("const"),
-		_T("continue"),
-		_T("declare"),
-		_T("default"),
-		_T("die"),
-		_T("do"),
-		_T("echo"),
-		_T("else"),
-		_T("elseif"),
-		_T("empty"),
-		_T("enddeclare"),
-		_T("endfor"),
-		_T("endforeach"),
-		_T("endif"),
-		_T("endswitch"),
-		_T("endwhile"),
-		_T("eval"),
-		_T("exception"),
-		_T("exit"),
-		_T("extends"),
-		_T("for"),
-		_T("foreach"),
-		_T("function"),
-		_T("global"),
-		_T("if"),
-		_T("include"),
-		_T("include_once"),
-		_T("isset"),
-		_T("list"),
-		_T("new"),
-		_T("old_function"),
-		_T("php_user_filter"),
-		_T("print"),
-		_T("require"),
-		_T("require_once"),
-		_T("return"),
-		_T("static"),
-		_T("switch"),
-		_T("unset"),
-		_T("use"),
-		_T("var"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPhpKeywordList);
+	return s_PhpKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszPhp1KeywordList[] =
+{
+	_T("AND"),
+	_T("OR"),
+	_T("XOR"),
+};
+
+static KeywordHash<_tcsnicmp> const s_Php1KeywordHash(s_apszPhp1KeywordList);
+
 static BOOL IsPhp1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPhp1KeywordList[] =
-	{
-		_T("AND"),
-		_T("OR"),
-		_T("XOR"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPhp1KeywordList);
+	return s_Php1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszPhp2KeywordList[] =
+{
+	_T("__CLASS__"),
+	_T("__FILE__"),
+	_T("__FUNCTION__"),
+	_T("__LINE__"),
+	_T("__METHOD__"),
+};
+
+static KeywordHash<_tcsnicmp> const s_Php2KeywordHash(s_apszPhp2KeywordList);
+
 static BOOL IsPhp2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPhp2KeywordList[] =
-	{
-		_T("__CLASS__"),
-		_T("__FILE__"),
-		_T("__FUNCTION__"),
-		_T("__LINE__"),
-		_T("__METHOD__"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPhp2KeywordList);
+	return s_Php2KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -23,16 +23,19 @@
 #endif
 
 // PO keywords
+static LPCTSTR const s_apszPoKeywordList[] =
+{
+	_T("msgctxt"),
+	_T("msgid"),
+	_T("msgid_plural"),
+	_T("msgstr"),
+};
+
+static KeywordHash<_tcsnicmp> const s_PoKeywordHash(s_apszPoKeywordList);
+
 static BOOL IsPoKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPoKeywordList[] =
-	{
-		_T("msgctxt"),
-		_T("msgid"),
-		_T("msgid_plural"),
-		_T("msgstr"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPoKeywordList);
+	return s_PoKeywordHash.Find(pszChars, nLength);
 }
 
 static BOOL IsPoNumber(LPCTSTR pszChars, int nLength)
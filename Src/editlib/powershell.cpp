@@ -24,316 +24,322 @@
 using CommonKeywords::IsNumeric;
 
 // PowerShell keywords
+static LPCTSTR const s_apszPowerShellKeywordList[] =
+{
+	_T("-and"),
+	_T("-as"),
+	_T("-band"),
+	_T("-bor"),
+	_T("-ccontains"),
+	_T("-ceq"),
+	_T("-cge"),
+	_T("-cgt"),
+	_T("-cle"),
+	_T("-clike"),
+	_T("-clt"),
+	_T("-cmatch"),
+	_T("-cne"),
+	_T("-cnotcontains"),
+	_T("-cnotlike"),
+	_T("-cnotmatch"),
+	_T("-comp"),
+	_T("-contains"),
+	_T("-creplace"),
+	_T("-eq"),
+	_T("-ge"),
+	_T("-gt"),
+	_T("-icontains"),
+	_T("-ieq"),
+	_T("-ige"),
+	_T("-igt"),
+	_T("-ile"),
+	_T("-ilike"),
+	_T("-ilt"),
+	_T("-imatch"),
+	_T("-ine"),
+	_T("-inot"),
+	_T("-inotcontains"),
+	_T("-inotlike"),
+	_T("-inotmatch"),
+	_T("-ireplace"),
+	_T("-is"),
+	_T("-isnot"),
+	_T("-le"),
+	_T("-like"),
+	_T("-lt"),
+	_T("-match"),
+	_T("-ne"),
+	_T("-not"),
+	_T("-notcontains"),
+	_T("-notlike"),
+	_T("-notmatch"),
+	_T("-or"),
+	_T("-replace"),
+	_T("-sl"),
+	_T("-sr"),
+	_T("-xor"),
+	_T("break"),
+	_T("continue"),
+	_T("do"),
+	_T("else"),
+	_T("elseif"),
+	_T("filter"),
+	_T("for"),
+	_T("foreach"),
+	_T("function"),
+	_T("if"),
+	_T("in"),
+	_T("return"),
+	_T("switch"),
+	_T("until"),
+	_T("where"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsnicmp> const s_PowerShellKeywordHash(s_apszPowerShellKeywordList);
+
 static BOOL IsPowerShellKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPowerShellKeywordList[] =
-	{
-		_T("-and"),
-		_T("-as"),
-		_T("-band"),
-		_T("-bor"),
-		_T("-ccontains"),
-		_T("-ceq"),
-		_T("-cge"),
-		_T("-cgt"),
-		_T("-cle"),
-		_T("-clike"),
-		_T("-clt"),
-		_T("-cmatch"),
-		_T("-cne"),
-		_T("-cnotcontains"),
-		_T("-cnotlike"),
-		_T("-cnotmatch"),
-		_T("-comp"),
-		_T("-contains"),
-		_T("-creplace"),
-		_T("-eq"),
-		_T("-ge"),
-		_T("-gt"),
-		_T("-icontains"),
-		_T("-ieq"),
-		_T("-ige"),
-		_T("-igt"),
-		_T("-ile"),
-		_T("-ilike"),
-		_T("-ilt"),
-		_T("-imatch"),
-		_T("-ine"),
-		_T("-inot"),
-		_T("-inotcontains"),
-		_T("-inotlike"),
-		_T("-inotmatch"),
-		_T("-ireplace"),
-		_T("-is"),
-		_T("-isnot"),
-		_T("-le"),
-		_T("-like"),
-		_T("-lt"),
-		_T("-match"),
-		_T("-ne"),
-		_T("-not"),
-		_T("-notcontains"),
-		_T("-notlike"),
-		_T("-notmatch"),
-		_T("-or"),
-		_T("-replace"),
-		_T("-sl"),
-		_T("-sr"),
-		_T("-xor"),
-		_T("break"),
-		_T("continue"),
-		_T("do"),
-		_T("else"),
-		_T("elseif"),
-		_T("filter"),
-		_T("for"),
-		_T("foreach"),
-		_T("function"),
-		_T("if"),
-		_T("in"),
-		_T("return"),
-		_T("switch"),
-		_T("until"),
-		_T("where"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszPowerShellKeywordList);
+	return s_PowerShellKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszCmdletKeywordList[] =
+{
+	_T("ac"),
+	_T("add-content"),
+	_T("add-history"),
+	_T("add-member"),
+	_T("add-pssnapin"),
+	_T("asnp"),
+	_T("cat"),
+	_T("cd"),
+	_T("chdir"),
+	_T("clc"),
+	_T("clear"),
+	_T("clear-content"),
+	_T("clear-item"),
+	_T("clear-itemproperty"),
+	_T("clear-variable"),
+	_T("cli"),
+	_T("clp"),
+	_T("cls"),
+	_T("clv"),
+	_T("compare-object"),
+	_T("convert-path"),
+	_T("convertfrom-securestring"),
+	_T("convertto-html"),
+	_T("convertto-securestring"),
+	_T("copy"),
+	_T("copy-item"),
+	_T("copy-itemproperty"),
+	_T("cp"),
+	_T("cpi"),
+	_T("cpp"),
+	_T("cvpa"),
+	_T("del"),
+	_T("diff"),
+	_T("dir"),
+	_T("echo"),
+	_T("epal"),
+	_T("epcsv"),
+	_T("erase"),
+	_T("export-alias"),
+	_T("export-clixml"),
+	_T("export-console"),
+	_T("export-csv"),
+	_T("fc"),
+	_T("fl"),
+	_T("foreach"),
+	_T("foreach-object"),
+	_T("format-custom"),
+	_T("format-list"),
+	_T("format-table"),
+	_T("format-wide"),
+	_T("ft"),
+	_T("fw"),
+	_T("gal"),
+	_T("gc"),
+	_T("gci"),
+	_T("gcm"),
+	_T("gdr"),
+	_T("get-acl"),
+	_T("get-alias"),
+	_T("get-authenticodesignature"),
+	_T("get-childitem"),
+	_T("get-command"),
+	_T("get-content"),
+	_T("get-credential"),
+	_T("get-culture"),
+	_T("get-date"),
+	_T("get-eventlog"),
+	_T("get-executionpolicy"),
+	_T("get-help"),
+	_T("get-history"),
+	_T("get-host"),
+	_T("get-item"),
+	_T("get-itemproperty"),
+	_T("get-location"),
+	_T("get-member"),
+	_T("get-pfxcertificate"),
+	_T("get-process"),
+	_T("get-psdrive"),
+	_T("get-psprovider"),
+	_T("get-pssnapin"),
+	_T("get-service"),
+	_T("get-tracesource"),
+	_T("get-uiculture"),
+	_T("get-unique"),
+	_T("get-variable"),
+	_T("get-wmiobject"),
+	_T("ghy"),
+	_T("gi"),
+	_T("gl"),
+	_T("gm"),
+	_T("gp"),
+	_T("gps"),
+	_T("group"),
+	_T("group-object"),
+	_T("gsnp"),
+	_T("gsv"),
+	_T("gu"),
+	_T("gv"),
+	_T("gwmi"),
+	_T("h"),
+	_T("history"),
+	_T("iex"),
+	_T("ihy"),
+	_T("ii"),
+	_T("import-alias"),
+	_T("import-clixml"),
+	_T("import-csv"),
+	_T("invoke-expression"),
+	_T("invoke-history"),
+	_T("invoke-item"),
+	_T("ipal"),
+	_T("ipcsv"),
+	_T("join-path"),
+	_T("kill"),
+	_T("lp"),
+	_T("ls"),
+	_T("measure-command"),
+	_T("measure-object"),
+	_T("mi"),
+	_T("mount"),
+	_T("move"),
+	_T("move-item"),
+	_T("move-itemproperty"),
+	_T("mp"),
+	_T("mv"),
+	_T("nal"),
+	_T("ndr"),
+	_T("new-alias"),
+	_T("new-item"),
+	_T("new-itemproperty"),
+	_T("new-object"),
+	_T("new-psdrive"),
+	_T("new-service"),
+	_T("new-timespan"),
+	_T("new-variable"),
+	_T("ni"),
+	_T("nv"),
+	_T("oh"),
+	_T("out-default"),
+	_T("out-file"),
+	_T("out-host"),
+	_T("out-null"),
+	_T("out-printer"),
+	_T("out-string"),
+	_T("pop-location"),
+	_T("popd"),
+	_T("ps"),
+	_T("push-location"),
+	_T("pushd"),
+	_T("pwd"),
+	_T("r"),
+	_T("rd"),
+	_T("rdr"),
+	_T("read-host"),
+	_T("remove-item"),
+	_T("remove-itemproperty"),
+	_T("remove-psdrive"),
+	_T("remove-pssnapin"),
+	_T("remove-variable"),
+	_T("ren"),
+	_T("rename-item"),
+	_T("rename-itemproperty"),
+	_T("resolve-path"),
+	_T("restart-service"),
+	_T("resume-service"),
+	_T("ri"),
+	_T("rm"),
+	_T("rmdir"),
+	_T("rni"),
+	_T("rnp"),
+	_T("rp"),
+	_T("rsnp"),
+	_T("rv"),
+	_T("rvpa"),
+	_T("sal"),
+	_T("sasv"),
+	_T("sc"),
+	_T("select"),
+	_T("select-object"),
+	_T("select-string"),
+	_T("set"),
+	_T("set-acl"),
+	_T("set-alias"),
+	_T("set-authenticodesignature"),
+	_T("set-content"),
+	_T("set-date"),
+	_T("set-executionpolicy"),
+	_T("set-item"),
+	_T("set-itemproperty"),
+	_T("set-location"),
+	_T("set-psdebug"),
+	_T("set-service"),
+	_T("set-tracesource"),
+	_T("set-variable"),
+	_T("si"),
+	_T("sl"),
+	_T("sleep"),
+	_T("sort"),
+	_T("sort-object"),
+	_T("sp"),
+	_T("split-path"),
+	_T("spps"),
+	_T("spsv"),
+	_T("start-service"),
+	_T("start-sleep"),
+	_T("start-transcript"),
+	_T("stop-process"),
+	_T("stop-service"),
+	_T("stop-transcript"),
+	_T("suspend-service"),
+	_T("sv"),
+	_T("tee"),
+	_T("tee-object"),
+	_T("test-path"),
+	_T("trace-command"),
+	_T("type"),
+	_T("update-formatdata"),
+	_T("update-typedata"),
+	_T("where"),
+	_T("where-object"),
+	_T("write"),
+	_T("write-debug"),
+	_T("write-error"),
+	_T("write-host"),
+	_T("write-output"),
+	_T("write-progress"),
+	_T("write-verbose"),
+	_T("write-warning"),
+};
+
+static KeywordHash<_tcsnicmp> const s_CmdletKeywordHash(s_apszCmdletKeywordList);
+
 static BOOL IsCmdletKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszCmdletKeywordList[] =
-	{
-		_T("ac"),
-		_T("add-content"),
-		_T("add-history"),
-		_T("add-member"),
-		_T("add-pssnapin"),
-		_T("asnp"),
-		_T("cat"),
-		_T("cd"),
-		_T("chdir"),
-		_T("clc"),
-		_T("clear"),
-		_T("clear-content"),
-		_T("clear-item"),
-		_T("clear-itemproperty"),
-		_T("clear-variable"),
-		_T("cli"),
-		_T("clp"),
-		_T("cls"),
-		_T("clv"),
-		_T("compare-object"),
-		_T("convert-path"),
-		_T("convertfrom-securestring"),
-		_T("convertto-html"),
-		_T("convertto-securestring"),
-		_T("copy"),
-		_T("copy-item"),
-		_T("copy-itemproperty"),
-		_T("cp"),
-		_T("cpi"),
-		_T("cpp"),
-		_T("cvpa"),
-		_T("del"),
-		_T("diff"),
-		_T("dir"),
-		_T("echo"),
-		_T("epal"),
-		_T("epcsv"),
-		_T("erase"),
-		_T("export-alias"),
-		_T("export-clixml"),
-		_T("export-console"),
-		_T("export-csv"),
-		_T("fc"),
-		_T("fl"),
-		_T("foreach"),
-		_T("foreach-object"),
-		_T("format-custom"),
-		_T("format-list"),
-		_T("format-table"),
-		_T("format-wide"),
-		_T("ft"),
-		_T("fw"),
-		_T("gal"),
-		_T("gc"),
-		_T("gci"),
-		_T("gcm"),
-		_T("gdr"),
-		_T("get-acl"),
-		_T("get-alias"),
-		_T("get-authenticodesignature"),
-		_T("get-childitem"),
-		_T("get-command"),
-		_T("get-content"),
-		_T("get-credential"),
-		_T("get-culture"),
-		_T("get-date"),
-		_T("get-eventlog"),
-		_T("get-executionpolicy"),
-		_T("get-help"),
-		_T("get-history"),
-		_T("get-host"),
-		_T("get-item"),
-		_T("get-itemproperty"),
-		_T("get-location"),
-		_T("get-member"),
-		_T("get-pfxcertificate"),
-		_T("get-process"),
-		_T("get-psdrive"),
-		_T("get-psprovider"),
-		_T("get-pssnapin"),
-		_T("get-service"),
-		_T("get-tracesource"),
-		_T("get-uiculture"),
-		_T("get-unique"),
-		_T("get-variable"),
-		_T("get-wmiobject"),
-		_T("ghy"),
-		_T("gi"),
-		_T("gl"),
-		_T("gm"),
-		_T("gp"),
-		_T("gps"),
-		_T("group"),
-		_T("group-object"),
-		_T("gsnp"),
-		_T("gsv"),
-		_T("gu"),
-		_T("gv"),
-		_T("gwmi"),
-		_T("h"),
-		_T("history"),
-		_T("iex"),
-		_T("ihy"),
-		_T("ii"),
-		_T("import-alias"),
-		_T("import-clixml"),
-		_T("import-csv"),
-		_T("invoke-expression"),
-		_T("invoke-history"),
-		_T("invoke-item"),
-		_T("ipal"),
-		_T("ipcsv"),
-		_T("join-path"),
-		_T("kill"),
-		_T("lp"),
-		_T("ls"),
-		_T("measure-command"),
-		_T("measure-object"),
-		_T("mi"),
-		_T("mount"),
-		_T("move"),
-		_T("move-item"),
-		_T("move-itemproperty"),
-		_T("mp"),
-		_T("mv"),
-		_T("nal"),
-		_T("ndr"),
-		_T("new-alias"),
-		_T("new-item"),
-		_T("new-itemproperty"),
-		_T("new-object"),
-		_T("new-psdrive"),
-		_T("new-service"),
-		_T("new-timespan"),
-		_T("new-variable"),
-		_T("ni"),
-		_T("nv"),
-		_T("oh"),
-		_T("out-default"),
-		_T("out-file"),
-		_T("out-host"),
-		_T("out-null"),
-		_T("out-printer"),
-		_T("out-string"),
-		_T("pop-location"),
-		_T("popd"),
-		_T("ps"),
-		_T("push-location"),
-		_T("pushd"),
-		_T("pwd"),
-		_T("r"),
-		_T("rd"),
-		_T("rdr"),
-		_T("read-host"),
-		_T("remove-item"),
-		_T("remove-itemproperty"),
-		_T("remove-psdrive"),
-		_T("remove-pssnapin"),
-		_T("remove-variable"),
-		_T("ren"),
-		_T("rename-item"),
-		_T("rename-itemproperty"),
-		_T("resolve-path"),
-		_T("restart-service"),
-		_T("resume-service"),
-		_T("ri"),
-		_T("rm"),
-		_T("rmdir"),
-		_T("rni"),
-		_T("rnp"),
-		_T("rp"),
-		_T("rsnp"),
-		_T("rv"),
-		_T("rvpa"),
-		_T("sal"),
-		_T("sasv"),
-		_T("sc"),
-		_T("select"),
-		_T("select-object"),
-		_T("select-string"),
-		_T("set"),
-		_T("set-acl"),
-		_T("set-alias"),
-		_T("set-authenticodesignature"),
-		_T("set-content"),
-		_T("set-date"),
-		_T("set-executionpolicy"),
-		_T("set-item"),
-		_T("set-itemproperty"),
-		_T("set-location"),
-		_T("set-psdebug"),
-		_T("set-service"),
-		_T("set-tracesource"),
-		_T("set-variable"),
-		_T("si"),
-		_T("sl"),
-		_T("sleep"),
-		_T("sort"),
-		_T("sort-object"),
-		_T("sp"),
-		_T("split-path"),
-		_T("spps"),
-		_T("spsv"),
-		_T("start-service"),
-		_T("start-sleep"),
-		_T("start-transcript"),
-		_T("stop-process"),
-		_T("stop-service"),
-		_T("stop-transcript"),
-		_T("suspend-service"),
-		_T("sv"),
-		_T("tee"),
-		_T("tee-object"),
-		_T("test-path"),
-		_T("trace-command"),
-		_T("type"),
-		_T("update-formatdata"),
-		_T("update-typedata"),
-		_T("where"),
-		_T("where-object"),
-		_T("write"),
-		_T("write-debug"),
-		_T("write-error"),
-		_T("write-host"),
-		_T("write-output"),
-		_T("write-progress"),
-		_T("write-verbose"),
-		_T("write-warning"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszCmdletKeywordList);
+	return s_CmdletKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
@@ -24,153 +24,162 @@
 using CommonKeywords::IsNumeric;
 
 // Python 2.6 keywords
+static LPCTSTR const s_apszPythonKeywordList[] =
+{
+	_T("and"),
+	_T("as"),
+	_T("assert"),
+	_T("break"),
+	_T("class"),
+	_T("continue"),
+	_T("def"),
+	_T("del"),
+	_T("elif"),
+	_T("else"),
+	_T("except"),
+	_T("exec"),
+	_T("finally"),
+	_T("for"),
+	_T("from"),
+	_T("global"),
+	_T("if"),
+	_T("import"),
+	_T("in"),
+	_T("is"),
+	_T("lambda"),
+	_T("not"),
+	_T("or"),
+	_T("pass"),
+	_T("print"),
+	_T("raise"),
+	_T("return"),
+	_T("try"),
+	_T("while"),
+	_T("whith"),
+	_T("yield"),
+};
+
+static KeywordHash<_tcsncmp> const s_PythonKeywordHash(s_apszPythonKeywordList);
+
 static BOOL IsPythonKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszPythonKeywordList[] =
-	{
-		_T("and"),
-		_T("as"),
-		_T("assert"),
-		_T("break"),
-		_T("class"),
-		_T("continue"),
-		_T("def"),
-		_T("del"),
-		_T("elif"),
-		_T("else"),
-		_T("except"),
-		_T("exec"),
-		_T("finally"),
-		_T("for"),
-		_T("from"),
-		_T("global"),
-		_T("if"),
-		_T("import"),
-		_T("in"),
-		_T("is"),
-		_T("lambda"),
-		_T("not"),
-		_T("or"),
-		_T("pass"),
-		_T("print"),
-		_T("raise"),
-		_T("return"),
-		_T("try"),
-		_T("while"),
-		_T("whith"),
-		_T("yield"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszPythonKeywordList);
+	return s_PythonKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("AttributeError"),
+	_T("EOFError"),
+	_T("Ellipsis"),
+	_T("False"),
+	_T("IOError"),
+	_T("ImportError"),
+	_T("IndexError"),
+	_T("KeyError"),
+	_T("KeyboardInterrupt"),
+	_T("MemoryError"),
+	_T("NameError"),
+	_T("None"),
+	_T("NotImplemented"),
+	_T("OverflowError"),
+	_T("RuntimeError"),
+	_T("SyntaxError"),
+	_T("SystemError"),
+	_T("SystemExit"),
+	_T("True"),
+	_T("TypeError"),
+	_T("ValueError"),
+	_T("ZeroDivisionError"),
+	_T("__debug__"),
+	_T("argv"),
+	_T("builtin_module_names"),
+	_T("exc_traceback"),
+	_T("exc_type"),
+	_T("exc_value"),
+	_T("exit"),
+	_T("exitfunc"),
+	_T("last_traceback"),
+	_T("last_type"),
+	_T("last_value"),
+	_T("modules"),
+	_T("path"),
+	_T("ps1"),
+	_T("ps2"),
+	_T("setprofile"),
+	_T("settrace"),
+	_T("stderr"),
+	_T("stdin"),
+	_T("stdout"),
+	_T("tracebacklimit"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("AttributeError"),
-		_T("EOFError"),
-		_T("Ellipsis"),
-		_T("False"),
-		_T("IOError"),
-		_T("ImportError"),
-		_T("IndexError"),
-		_T("KeyError"),
-		_T("KeyboardInterrupt"),
-		_T("MemoryError"),
-		_T("NameError"),
-		_T("None"),
-		_T("NotImplemented"),
-		_T("OverflowError"),
-		_T("RuntimeError"),
-		_T("SyntaxError"),
-		_T("SystemError"),
-		_T("SystemExit"),
-		_T("True"),
-		_T("TypeError"),
-		_T("ValueError"),
-		_T("ZeroDivisionError"),
-		_T("__debug__"),
-		_T("argv"),
-		_T("builtin_module_names"),
-		_T("exc_traceback"),
-		_T("exc_type"),
-		_T("exc_value"),
-		_T("exit"),
-		_T("exitfunc"),
-		_T("last_traceback"),
-		_T("last_type"),
-		_T("last_value"),
-		_T("modules"),
-		_T("path"),
-		_T("ps1"),
-		_T("ps2"),
-		_T("setprofile"),
-		_T("settrace"),
-		_T("stderr"),
-		_T("stdin"),
-		_T("stdout"),
-		_T("tracebacklimit"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser2KeywordList[] =
+{
+	_T("__abs__"),
+	_T("__add__"),
+	_T("__and__"),
+	_T("__bases__"),
+	_T("__class__"),
+	_T("__cmp__"),
+	_T("__coerce__"),
+	_T("__del__"),
+	_T("__dict__"),
+	_T("__div__"),
+	_T("__divmod__"),
+	_T("__float__"),
+	_T("__getitem__"),
+	_T("__hash__"),
+	_T("__hex__"),
+	_T("__init__"),
+	_T("__int__"),
+	_T("__invert__"),
+	_T("__len__"),
+	_T("__long__"),
+	_T("__lshift__"),
+	_T("__members__"),
+	_T("__methods__"),
+	_T("__mod__"),
+	_T("__mul__"),
+	_T("__neg__"),
+	_T("__nonzero__"),
+	_T("__oct__"),
+	_T("__or__"),
+	_T("__pos__"),
+	_T("__pow__"),
+	_T("__repr__"),
+	_T("__rshift__"),
+	_T("__str__"),
+	_T("__sub__"),
+	_T("__xor__"),
+	_T("abs"),
+	_T("coerce"),
+	_T("divmod"),
+	_T("float"),
+	_T("hex"),
+	_T("id"),
+	_T("int"),
+	_T("len"),
+	_T("long"),
+	_T("nonzero"),
+	_T("oct"),
+	_T("pow"),
+	_T("range"),
+	_T("round"),
+	_T("xrange"),
+};
+
+static KeywordHash<_tcsncmp> const s_User2KeywordHash(s_apszUser2KeywordList);
+
 static BOOL IsUser2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser2KeywordList[] =
-	{
-		_T("__abs__"),
-		_T("__add__"),
-		_T("__and__"),
-		_T("__bases__"),
-		_T("__class__"),
-		_T("__cmp__"),
-		_T("__coerce__"),
-		_T("__del__"),
-		_T("__dict__"),
-		_T("__div__"),
-		_T("__divmod__"),
-		_T("__float__"),
-		_T("__getitem__"),
-		_T("__hash__"),
-		_T("__hex__"),
-		_T("__init__"),
-		_T("__int__"),
-		_T("__invert__"),
-		_T("__len__"),
-		_T("__long__"),
-		_T("__lshift__"),
-		_T("__members__"),
-		_T("__methods__"),
-		_T("__mod__"),
-		_T("__mul__"),
-		_T("__neg__"),
-		_T("__nonzero__"),
-		_T("__oct__"),
-		_T("__or__"),
-		_T("__pos__"),
-		_T("__pow__"),
-		_T("__repr__"),
-		_T("__rshift__"),
-		_T("__str__"),
-		_T("__sub__"),
-		_T("__xor__"),
-		_T("abs"),
-		_T("coerce"),
-		_T("divmod"),
-		_T("float"),
-		_T("hex"),
-		_T("id"),
-		_T("int"),
-		_T("len"),
-		_T("long"),
-		_T("nonzero"),
-		_T("oct"),
-		_T("pow"),
-		_T("range"),
-		_T("round"),
-		_T("xrange"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser2KeywordList);
+	return s_User2KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
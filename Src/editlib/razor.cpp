@@ -33,43 +33,52 @@ using HtmlKeywords::IsDtdAttrName;
 using HtmlKeywords::IsEntityName;
 
 // Keywords which do nothing about parsing logic
+static LPCTSTR const s_apszTrivialKeywordList[] =
+{
+	_T("section"),
+};
+
+static KeywordHash<_tcsncmp> const s_TrivialKeywordHash(s_apszTrivialKeywordList);
+
 static BOOL IsTrivialKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszTrivialKeywordList[] =
-	{
-		_T("section"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszTrivialKeywordList);
+	return s_TrivialKeywordHash.Find(pszChars, nLength);
 }
 
 // Keywords which pass rest of line to subordinate parser
+static LPCTSTR const s_apszSpecialKeywordList[] =
+{
+	_T("model"),
+	_T("using"),
+};
+
+static KeywordHash<_tcsncmp> const s_SpecialKeywordHash(s_apszSpecialKeywordList);
+
 static BOOL IsSpecialKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSpecialKeywordList[] =
-	{
-		_T("model"),
-		_T("using"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszSpecialKeywordList);
+	return s_SpecialKeywordHash.Find(pszChars, nLength);
 }
 
 // Keywords which enter snorkel mode when found at top nesting level
+static LPCTSTR const s_apszSnorkelKeywordList[] =
+{
+	_T("do"),
+	_T("for"),
+	_T("foreach"),
+	_T("helper"),
+	_T("if"),
+	_T("lock"),
+	_T("switch"),
+	_T("try"),
+	_T("using"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsncmp> const s_SnorkelKeywordHash(s_apszSnorkelKeywordList);
+
 static BOOL IsSnorkelKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSnorkelKeywordList[] =
-	{
-		_T("do"),
-		_T("for"),
-		_T("foreach"),
-		_T("helper"),
-		_T("if"),
-		_T("lock"),
-		_T("switch"),
-		_T("try"),
-		_T("using"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszSnorkelKeywordList);
+	return s_SnorkelKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
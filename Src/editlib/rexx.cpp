@@ -23,86 +23,92 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszRexxKeywordList[] =
+{
+	_T("ADDRESS"),
+	_T("ARG"),
+	_T("BY"),
+	_T("CALL"),
+	_T("DIGITS"),
+	_T("DO"),
+	_T("DROP"),
+	_T("ELSE"),
+	_T("END"),
+	_T("ENGINEERING"),
+	_T("ERROR"),
+	_T("EXIT"),
+	_T("EXPOSE"),
+	_T("FAILURE"),
+	_T("FOR"),
+	_T("FOREVER"),
+	_T("FORM"),
+	_T("FUZZ"),
+	_T("HALT"),
+	_T("IF"),
+	_T("INTERPRET"),
+	_T("ITERATE"),
+	_T("LEAVE"),
+	_T("NAME"),
+	_T("NOP"),
+	_T("NOTREADY"),
+	_T("NOVALUE"),
+	_T("NUMERIC"),
+	_T("OFF"),
+	_T("ON"),
+	_T("OPTIONS"),
+	_T("OTHERWISE"),
+	_T("OVER"),
+	_T("PARSE"),
+	_T("PROCEDURE"),
+	_T("PULL"),
+	_T("PUSH"),
+	_T("QUEUE"),
+	_T("RETURN"),
+	_T("SAY"),
+	_T("SCIENTIFIC"),
+	_T("SELECT"),
+	_T("SIGNAL"),
+	_T("SOURCE"),
+	_T("SYNTAX"),
+	_T("THEN"),
+	_T("TO"),
+	_T("TRACE"),
+	_T("UNTIL"),
+	_T("UPPER"),
+	_T("VALUE"),
+	_T("VAR"),
+	_T("VERSION"),
+	_T("WHEN"),
+	_T("WHILE"),
+	_T("WITH"),
+};
+
+static KeywordHash<_tcsnicmp> const s_RexxKeywordHash(s_apszRexxKeywordList);
+
 static BOOL IsRexxKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszRexxKeywordList[] =
-	{
-		_T("ADDRESS"),
-		_T("ARG"),
-		_T("BY"),
-		_T("CALL"),
-		_T("DIGITS"),
-		_T("DO"),
-		_T("DROP"),
-		_T("ELSE"),
-		_T("END"),
-		_T("ENGINEERING"),
-		_T("ERROR"),
-		_T("EXIT"),
-		_T("EXPOSE"),
-		_T("FAILURE"),
-		_T("FOR"),
-		_T("FOREVER"),
-		_T("FORM"),
-		_T("FUZZ"),
-		_T("HALT"),
-		_T("IF"),
-		_T("INTERPRET"),
-		_T("ITERATE"),
-		_T("LEAVE"),
-		_T("NAME"),
-		_T("NOP"),
-		_T("NOTREADY"),
-		_T("NOVALUE"),
-		_T("NUMERIC"),
-		_T("OFF"),
-		_T("ON"),
-		_T("OPTIONS"),
-		_T("OTHERWISE"),
-		_T("OVER"),
-		_T("PARSE"),
-		_T("PROCEDURE"),
-		_T("PULL"),
-		_T("PUSH"),
-		_T("QUEUE"),
-		_T("RETURN"),
-		_T("SAY"),
-		_T("SCIENTIFIC"),
-		_T("SELECT"),
-		_T("SIGNAL"),
-		_T("SOURCE"),
-		_T("SYNTAX"),
-		_T("THEN"),
-		_T("TO"),
-		_T("TRACE"),
-		_T("UNTIL"),
-		_T("UPPER"),
-		_T("VALUE"),
-		_T("VAR"),
-		_T("VERSION"),
-		_T("WHEN"),
-		_T("WHILE"),
-		_T("WITH"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszRexxKeywordList);
+	return s_RexxKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("BOOLEAN"),
+	_T("CATCH"),
+	_T("CHAR"),
+	_T("CLASS"),
+	_T("EXTENDS"),
+	_T("IMPLEMENTS"),
+	_T("LOOP"),
+	_T("METHOD"),
+	_T("NULL"),
+	_T("RETURNS"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("BOOLEAN"),
-		_T("CATCH"),
-		_T("CHAR"),
-		_T("CLASS"),
-		_T("EXTENDS"),
-		_T("IMPLEMENTS"),
-		_T("LOOP"),
-		_T("METHOD"),
-		_T("NULL"),
-		_T("RETURNS"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
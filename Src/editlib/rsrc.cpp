@@ -23,151 +23,157 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszRsrcKeywordList[] =
+{
+	_T("ACCELERATORS"),
+	_T("ALT"),
+	_T("ASCII"),
+	_T("AUTO3STATE"),
+	_T("AUTOCHECKBOX"),
+	_T("AUTORADIOBUTTON"),
+	_T("BEDIT"),
+	_T("BEGIN"),
+	_T("BITMAP"),
+	_T("BLOCK"),
+	_T("BUTTON"),
+	_T("CAPTION"),
+	_T("CHARACTERISTICS"),
+	_T("CHECKBOX"),
+	_T("CHECKED"),
+	_T("CLASS"),
+	_T("COMBOBOX"),
+	_T("CONTROL"),
+	_T("CTEXT"),
+	_T("CURSOR"),
+	_T("DEFPUSHBUTTON"),
+	_T("DIALOG"),
+	_T("DIALOGEX"),
+	_T("DISCARDABLE"),
+	_T("EDIT"),
+	_T("EDITTEXT"),
+	_T("END"),
+	_T("EXSTYLE"),
+	_T("FILEFLAGS"),
+	_T("FILEFLAGSMASK"),
+	_T("FILEOS"),
+	_T("FILESUBTYPE"),
+	_T("FILETYPE"),
+	_T("FILEVERSION"),
+	_T("FIXED"),
+	_T("FONT"),
+	_T("GRAYED"),
+	_T("GROUPBOX"),
+	_T("HEDIT"),
+	_T("HELP"),
+	_T("ICON"),
+	_T("IEDIT"),
+	_T("IMPURE"),
+	_T("INACTIVE"),
+	_T("LANGUAGE"),
+	_T("LISTBOX"),
+	_T("LOADONCALL"),
+	_T("LTEXT"),
+	_T("MENU"),
+	_T("MENUBARBREAK"),
+	_T("MENUBREAK"),
+	_T("MENUEX"),
+	_T("MENUITEM"),
+	_T("MESSAGETABLE"),
+	_T("MOVEABLE"),
+	_T("NOINVERT"),
+	_T("NONSHARED"),
+	_T("POPUP"),
+	_T("PRELOAD"),
+	_T("PRODUCTVERSION"),
+	_T("PURE"),
+	_T("PUSHBOX"),
+	_T("PUSHBUTTON"),
+	_T("RADIOBUTTON"),
+	_T("RCDATA"),
+	_T("RTEXT"),
+	_T("SCROLLBAR"),
+	_T("SEPARATOR"),
+	_T("SHARED"),
+	_T("SHIFT"),
+	_T("STATE3"),
+	_T("STATIC"),
+	_T("STRINGTABLE"),
+	_T("STYLE"),
+	_T("TEXTINCLUDE"),
+	_T("USERBUTTON"),
+	_T("VALUE"),
+	_T("VERSION"),
+	_T("VERSIONINFO"),
+	_T("VIRTKEY"),
+};
+
+static KeywordHash<_tcsnicmp> const s_RsrcKeywordHash(s_apszRsrcKeywordList);
+
 static BOOL IsRsrcKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszRsrcKeywordList[] =
-	{
-		_T("ACCELERATORS"),
-		_T("ALT"),
-		_T("ASCII"),
-		_T("AUTO3STATE"),
-		_T("AUTOCHECKBOX"),
-		_T("AUTORADIOBUTTON"),
-		_T("BEDIT"),
-		_T("BEGIN"),
-		_T("BITMAP"),
-		_T("BLOCK"),
-		_T("BUTTON"),
-		_T("CAPTION"),
-		_T("CHARACTERISTICS"),
-		_T("CHECKBOX"),
-		_T("CHECKED"),
-		_T("CLASS"),
-		_T("COMBOBOX"),
-		_T("CONTROL"),
-		_T("CTEXT"),
-		_T("CURSOR"),
-		_T("DEFPUSHBUTTON"),
-		_T("DIALOG"),
-		_T("DIALOGEX"),
-		_T("DISCARDABLE"),
-		_T("EDIT"),
-		_T("EDITTEXT"),
-		_T("END"),
-		_T("EXSTYLE"),
-		_T("FILEFLAGS"),
-		_T("FILEFLAGSMASK"),
-		_T("FILEOS"),
-		_T("FILESUBTYPE"),
-		_T("FILETYPE"),
-		_T("FILEVERSION"),
-		_T("FIXED"),
-		_T("FONT"),
-		_T("GRAYED"),
-		_T("GROUPBOX"),
-		_T("HEDIT"),
-		_T("HELP"),
-		_T("ICON"),
-		_T("IEDIT"),
-		_T("IMPURE"),
-		_T("INACTIVE"),
-		_T("LANGUAGE"),
-		_T("LISTBOX"),
-		_T("LOADONCALL"),
-		_T("LTEXT"),
-		_T("MENU"),
-		_T("MENUBARBREAK"),
-		_T("MENUBREAK"),
-		_T("MENUEX"),
-		_T("MENUITEM"),
-		_T("MESSAGETABLE"),
-		_T("MOVEABLE"),
-		_T("NOINVERT"),
-		_T("NONSHARED"),
-		_T("POPUP"),
-		_T("PRELOAD"),
-		_T("PRODUCTVERSION"),
-		_T("PURE"),
-		_T("PUSHBOX"),
-		_T("PUSHBUTTON"),
-		_T("RADIOBUTTON"),
-		_T("RCDATA"),
-		_T("RTEXT"),
-		_T("SCROLLBAR"),
-		_T("SEPARATOR"),
-		_T("SHARED"),
-		_T("SHIFT"),
-		_T("STATE3"),
-		_T("STATIC"),
-		_T("STRINGTABLE"),
-		_T("STYLE"),
-		_T("TEXTINCLUDE"),
-		_T("USERBUTTON"),
-		_T("VALUE"),
-		_T("VERSION"),
-		_T("VERSIONINFO"),
-		_T("VIRTKEY"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszRsrcKeywordList);
+	return s_RsrcKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("VK_BACK"),
+	_T("VK_CANCEL"),
+	_T("VK_CAPITAL"),
+	_T("VK_CLEAR"),
+	_T("VK_CONTROL"),
+	_T("VK_DELETE"),
+	_T("VK_DOWN"),
+	_T("VK_END"),
+	_T("VK_ESCAPE"),
+	_T("VK_F1"),
+	_T("VK_F10"),
+	_T("VK_F11"),
+	_T("VK_F12"),
+	_T("VK_F13"),
+	_T("VK_F14"),
+	_T("VK_F15"),
+	_T("VK_F16"),
+	_T("VK_F17"),
+	_T("VK_F18"),
+	_T("VK_F19"),
+	_T("VK_F2"),
+	_T("VK_F20"),
+	_T("VK_F21"),
+	_T("VK_F22"),
+	_T("VK_F23"),
+	_T("VK_F24"),
+	_T("VK_F3"),
+	_T("VK_F4"),
+	_T("VK_F5"),
+	_T("VK_F6"),
+	_T("VK_F7"),
+	_T("VK_F8"),
+	_T("VK_F9"),
+	_T("VK_HELP"),
+	_T("VK_HOME"),
+	_T("VK_INSERT"),
+	_T("VK_LBUTTON"),
+	_T("VK_LEFT"),
+	_T("VK_MBUTTON"),
+	_T("VK_MENU"),
+	_T("VK_NEXT"),
+	_T("VK_PAUSE"),
+	_T("VK_PRIOR"),
+	_T("VK_RBUTTON"),
+	_T("VK_RETURN"),
+	_T("VK_RIGHT"),
+	_T("VK_SELECT"),
+	_T("VK_SHIFT"),
+	_T("VK_SPACE"),
+	_T("VK_TAB"),
+	_T("VK_UP"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("VK_BACK"),
-		_T("VK_CANCEL"),
-		_T("VK_CAPITAL"),
-		_T("VK_CLEAR"),
-		_T("VK_CONTROL"),
-		_T("VK_DELETE"),
-		_T("VK_DOWN"),
-		_T("VK_END"),
-		_T("VK_ESCAPE"),
-		_T("VK_F1"),
-		_T("VK_F10"),
-		_T("VK_F11"),
-		_T("VK_F12"),
-		_T("VK_F13"),
-		_T("VK_F14"),
-		_T("VK_F15"),
-		_T("VK_F16"),
-		_T("VK_F17"),
-		_T("VK_F18"),
-		_T("VK_F19"),
-		_T("VK_F2"),
-		_T("VK_F20"),
-		_T("VK_F21"),
-		_T("VK_F22"),
-		_T("VK_F23"),
-		_T("VK_F24"),
-		_T("VK_F3"),
-		_T("VK_F4"),
-		_T("VK_F5"),
-		_T("VK_F6"),
-		_T("VK_F7"),
-		_T("VK_F8"),
-		_T("VK_F9"),
-		_T("VK_HELP"),
-		_T("VK_HOME"),
-		_T("VK_INSERT"),
-		_T("VK_LBUTTON"),
-		_T("VK_LEFT"),
-		_T("VK_MBUTTON"),
-		_T("VK_MENU"),
-		_T("VK_NEXT"),
-		_T("VK_PAUSE"),
-		_T("VK_PRIOR"),
-		_T("VK_RBUTTON"),
-		_T("VK_RETURN"),
-		_T("VK_RIGHT"),
-		_T("VK_SELECT"),
-		_T("VK_SHIFT"),
-		_T("VK_SPACE"),
-		_T("VK_TAB"),
-		_T("VK_UP"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
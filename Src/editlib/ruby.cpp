@@ -24,96 +24,102 @@
 using CommonKeywords::IsNumeric;
 
 // Ruby reserved words.
+static LPCTSTR const s_apszRubyKeywordList[] =
+{
+	_T("BEGIN"),
+	_T("END"),
+	_T("alias"),
+	_T("alias_method"),
+	_T("and"),
+	_T("begin"),
+	_T("break"),
+	_T("case"),
+	_T("catch"),
+	_T("class"),
+	_T("def"),
+	_T("do"),
+	_T("else"),
+	_T("elsif"),
+	_T("end"),
+	_T("ensure"),
+	_T("false"),
+	_T("for"),
+	_T("if"),
+	_T("in"),
+	_T("lambda"),
+	_T("load"),
+	_T("module"),
+	_T("next"),
+	_T("nil"),
+	_T("not"),
+	_T("or"),
+	_T("proc"),
+	_T("raise"),
+	_T("redo"),
+	_T("remove_method"),
+	_T("require"),
+	_T("require_gem"),
+	_T("rescue"),
+	_T("retry"),
+	_T("return"),
+	_T("self"),
+	_T("super"),
+	_T("then"),
+	_T("throw"),
+	_T("true"),
+	_T("undef"),
+	_T("undef_method"),
+	_T("unless"),
+	_T("until"),
+	_T("when"),
+	_T("while"),
+	_T("yield"),
+};
+
+static KeywordHash<_tcsncmp> const s_RubyKeywordHash(s_apszRubyKeywordList);
+
 static BOOL IsRubyKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszRubyKeywordList[] =
-	{
-		_T("BEGIN"),
-		_T("END"),
-		_T("alias"),
-		_T("alias_method"),
-		_T("and"),
-		_T("begin"),
-		_T("break"),
-		_T("case"),
-		_T("catch"),
-		_T("class"),
-		_T("def"),
-		_T("do"),
-		_T("else"),
-		_T("elsif"),
-		_T("end"),
-		_T("ensure"),
-		_T("false"),
-		_T("for"),
-		_T("if"),
-		_T("in"),
-		_T("lambda"),
-		_T("load"),
-		_T("module"),
-		_T("next"),
-		_T("nil"),
-		_T("not"),
-		_T("or"),
-		_T("proc"),
-		_T("raise"),
-		_T("redo"),
-		_T("remove_method"),
-		_T("require"),
-		_T("require_gem"),
-		_T("rescue"),
-		_T("retry"),
-		_T("return"),
-		_T("self"),
-		_T("super"),
-		_T("then"),
-		_T("throw"),
-		_T("true"),
-		_T("undef"),
-		_T("undef_method"),
-		_T("unless"),
-		_T("until"),
-		_T("when"),
-		_T("while"),
-		_T("yield"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszRubyKeywordList);
+	return s_RubyKeywordHash.Find(pszChars, nLength);
 }
 
 // Ruby constants (preprocessor color).
+static LPCTSTR const s_apszRubyConstantsList[] =
+{
+	_T("$DEBUG"),
+	_T("$FILENAME"),
+	_T("$LOAD_PATH"),
+	_T("$SAFE"),
+	_T("$VERBOSE"),
+	_T("$deferr"),
+	_T("$defout"),
+	_T("$stderr"),
+	_T("$stdin"),
+	_T("$stdout"),
+	_T("ARGF"),
+	_T("ARGV"),
+	_T("DATA"),
+	_T("ENV"),
+	_T("FALSE"),
+	_T("NIL"),
+	_T("RUBY_PLATFORM"),
+	_T("RUBY_RELEASE_DATE"),
+	_T("RUBY_VERSION"),
+	_T("SCRIPT_LINES__"),
+	_T("STDERR"),
+	_T("STDIN"),
+	_T("STDOUT"),
+	_T("TOPLEVEL_BINDING"),
+	_T("TRUE"),
+	_T("__FILE__"),
+	_T("__LINE__"),
+};
+
+static KeywordHash<_tcsncmp> const s_RubyConstantsHash(s_apszRubyConstantsList);
+
 static BOOL IsRubyConstant(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszRubyConstantsList[] =
-	{
-		_T("$DEBUG"),
-		_T("$FILENAME"),
-		_T("$LOAD_PATH"),
-		_T("$SAFE"),
-		_T("$VERBOSE"),
-		_T("$deferr"),
-		_T("$defout"),
-		_T("$stderr"),
-		_T("$stdin"),
-		_T("$stdout"),
-		_T("ARGF"),
-		_T("ARGV"),
-		_T("DATA"),
-		_T("ENV"),
-		_T("FALSE"),
-		_T("NIL"),
-		_T("RUBY_PLATFORM"),
-		_T("RUBY_RELEASE_DATE"),
-		_T("RUBY_VERSION"),
-		_T("SCRIPT_LINES__"),
-		_T("STDERR"),
-		_T("STDIN"),
-		_T("STDOUT"),
-		_T("TOPLEVEL_BINDING"),
-		_T("TRUE"),
-		_T("__FILE__"),
-		_T("__LINE__"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszRubyConstantsList);
+	return s_RubyConstantsHash.Find(pszChars, nLength);
 }
 
 inline BOOL xisspace(LPCTSTR pch)
@@ -24,90 +24,96 @@
 using CommonKeywords::IsNumeric;
 
 // Rust keywords
+static LPCTSTR const s_apszRustKeywordList[] =
+{
+	_T("Self"),
+	_T("abstract"),
+	_T("alignof"),
+	_T("as"),
+	_T("become"),
+	_T("box"),
+	_T("break"),
+	_T("const"),
+	_T("continue"),
+	_T("crate"),
+	_T("do"),
+	_T("else"),
+	_T("enum"),
+	_T("extern"),
+	_T("false"),
+	_T("final"),
+	_T("fn"),
+	_T("for"),
+	_T("if"),
+	_T("impl"),
+	_T("in"),
+	_T("let"),
+	_T("loop"),
+	_T("macro"),
+	_T("match"),
+	_T("mod"),
+	_T("move"),
+	_T("mut"),
+	_T("offsetof"),
+	_T("override"),
+	_T("priv"),
+	_T("proc"),
+	_T("pub"),
+	_T("pure"),
+	_T("ref"),
+	_T("return"),
+	_T("self"),
+	_T("sizeof"),
+	_T("static"),
+	_T("struct"),
+	_T("super"),
+	_T("trait"),
+	_T("true"),
+	_T("type"),
+	_T("typeof"),
+	_T("unsafe"),
+	_T("unsized"),
+	_T("use"),
+	_T("virtual"),
+	_T("where"),
+	_T("while"),
+	_T("yield"),
+};
+
+static KeywordHash<_tcsncmp> const s_RustKeywordHash(s_apszRustKeywordList);
+
 static BOOL IsRustKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszRustKeywordList[] =
-	{
-		_T("Self"),
-		_T("abstract"),
-		_T("alignof"),
-		_T("as"),
-		_T("become"),
-		_T("box"),
-		_T("break"),
-		_T("const"),
-		_T("continue"),
-		_T("crate"),
-		_T("do"),
-		_T("else"),
-		_T("enum"),
-		_T("extern"),
-		_T("false"),
-		_T("final"),
-		_T("fn"),
-		_T("for"),
-		_T("if"),
-		_T("impl"),
-		_T("in"),
-		_T("let"),
-		_T("loop"),
-		_T("macro"),
-		_T("match"),
-		_T("mod"),
-		_T("move"),
-		_T("mut"),
-		_T("offsetof"),
-		_T("override"),
-		_T("priv"),
-		_T("proc"),
-		_T("pub"),
-		_T("pure"),
-		_T("ref"),
-		_T("return"),
-		_T("self"),
-		_T("sizeof"),
-		_T("static"),
-		_T("struct"),
-		_T("super"),
-		_T("trait"),
-		_T("true"),
-		_T("type"),
-		_T("typeof"),
-		_T("unsafe"),
-		_T("unsized"),
-		_T("use"),
-		_T("virtual"),
-		_T("where"),
-		_T("while"),
-		_T("yield"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszRustKeywordList);
+	return s_RustKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("String"),
+	_T("binary32"),
+	_T("binary64"),
+	_T("bool"),
+	_T("char"),
+	_T("f32"),
+	_T("f64"),
+	_T("i16"),
+	_T("i32"),
+	_T("i64"),
+	_T("i8"),
+	_T("isize"),
+	_T("str"),
+	_T("u16"),
+	_T("u32"),
+	_T("u64"),
+	_T("u8"),
+	_T("usize"),
+};
+
+static KeywordHash<_tcsncmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("String"),
-		_T("binary32"),
-		_T("binary64"),
-		_T("bool"),
-		_T("char"),
-		_T("f32"),
-		_T("f64"),
-		_T("i16"),
-		_T("i32"),
-		_T("i64"),
-		_T("i8"),
-		_T("isize"),
-		_T("str"),
-		_T("u16"),
-		_T("u32"),
-		_T("u64"),
-		_T("u8"),
-		_T("usize"),
-	};
-	return xiskeyword<_tcsncmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
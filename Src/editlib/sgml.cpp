@@ -26,79 +26,85 @@ using HtmlKeywords::IsDtdTagName;
 using HtmlKeywords::IsDtdAttrName;
 using HtmlKeywords::IsEntityName;
 
+static LPCTSTR const s_apszSgmlTagNameList[] =
+{
+	_T("ABSTRACT"),
+	_T("ARTICLE"),
+	_T("AUTHOR"),
+	_T("BF"),
+	_T("BOOK"),
+	_T("CHAPT"),
+	_T("CODE"),
+	_T("COPYRIGHT"),
+	_T("DATE"),
+	_T("DEBIANDOC"),
+	_T("DESCRIP"),
+	_T("DOCTYPE"),
+	_T("EM"),
+	_T("EMAIL"),
+	_T("ENUM"),
+	_T("ENUMLIST"),
+	_T("EXAMPLE"),
+	_T("FOOTNOTE"),
+	_T("FTPPATH"),
+	_T("FTPSITE"),
+	_T("HEADING"),
+	_T("HTMLURL"),
+	_T("HTTPPATH"),
+	_T("HTTPSITE"),
+	_T("IT"),
+	_T("ITEM"),
+	_T("ITEMIZE"),
+	_T("LABEL"),
+	_T("LIST"),
+	_T("MANREF"),
+	_T("NAME"),
+	_T("P"),
+	_T("PRGN"),
+	_T("PUBLIC"),
+	_T("QREF"),
+	_T("QUOTE"),
+	_T("REF"),
+	_T("SECT"),
+	_T("SECT1"),
+	_T("SECT2"),
+	_T("SECT3"),
+	_T("SECT4"),
+	_T("STRONG"),
+	_T("SYSTEM"),
+	_T("TAG"),
+	_T("TAGLIST"),
+	_T("TITLE"),
+	_T("TITLEPAG"),
+	_T("TOC"),
+	_T("TSCREEN"),
+	_T("TT"),
+	_T("URL"),
+	_T("VAR"),
+	_T("VERB"),
+	_T("VERSION"),
+};
+
+static KeywordHash<_tcsnicmp> const s_SgmlTagNameHash(s_apszSgmlTagNameList);
+
 static BOOL IsSgmlTagName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSgmlTagNameList[] =
-	{
-		_T("ABSTRACT"),
-		_T("ARTICLE"),
-		_T("AUTHOR"),
-		_T("BF"),
-		_T("BOOK"),
-		_T("CHAPT"),
-		_T("CODE"),
-		_T("COPYRIGHT"),
-		_T("DATE"),
-		_T("DEBIANDOC"),
-		_T("DESCRIP"),
-		_T("DOCTYPE"),
-		_T("EM"),
-		_T("EMAIL"),
-		_T("ENUM"),
-		_T("ENUMLIST"),
-		_T("EXAMPLE"),
-		_T("FOOTNOTE"),
-		_T("FTPPATH"),
-		_T("FTPSITE"),
-		_T("HEADING"),
-		_T("HTMLURL"),
-		_T("HTTPPATH"),
-		_T("HTTPSITE"),
-		_T("IT"),
-		_T("ITEM"),
-		_T("ITEMIZE"),
-		_T("LABEL"),
-		_T("LIST"),
-		_T("MANREF"),
-		_T("NAME"),
-		_T("P"),
-		_T("PRGN"),
-		_T("PUBLIC"),
-		_T("QREF"),
-		_T("QUOTE"),
-		_T("REF"),
-		_T("SECT"),
-		_T("SECT1"),
-		_T("SECT2"),
-		_T("SECT3"),
-		_T("SECT4"),
-		_T("STRONG"),
-		_T("SYSTEM"),
-		_T("TAG"),
-		_T("TAGLIST"),
-		_T("TITLE"),
-		_T("TITLEPAG"),
-		_T("TOC"),
-		_T("TSCREEN"),
-		_T("TT"),
-		_T("URL"),
-		_T("VAR"),
-		_T("VERB"),
-		_T("VERSION"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszSgmlTagNameList);
+	return s_SgmlTagNameHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszSgmlAttrNameList[] =
+{
+	_T("COMPACT"),
+	_T("ID"),
+	_T("NAME"),
+	_T("SECTION"),
+};
+
+static KeywordHash<_tcsnicmp> const s_SgmlAttrNameHash(s_apszSgmlAttrNameList);
+
 static BOOL IsSgmlAttrName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSgmlAttrNameList[] =
-	{
-		_T("COMPACT"),
-		_T("ID"),
-		_T("NAME"),
-		_T("SECTION"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszSgmlAttrNameList);
+	return s_SgmlAttrNameHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
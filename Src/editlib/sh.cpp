@@ -23,56 +23,62 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszShKeywordList[] =
+{
+	_T("alias"),
+	_T("break"),
+	_T("case"),
+	_T("do"),
+	_T("done"),
+	_T("echo"),
+	_T("elif"),
+	_T("else"),
+	_T("esac"),
+	_T("exec"),
+	_T("exit"),
+	_T("export"),
+	_T("fi"),
+	_T("for"),
+	_T("function"),
+	_T("if"),
+	_T("in"),
+	_T("read"),
+	_T("return"),
+	_T("select"),
+	_T("set"),
+	_T("shift"),
+	_T("source"),
+	_T("then"),
+	_T("unalias"),
+	_T("unset"),
+	_T("until"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsnicmp> const s_ShKeywordHash(s_apszShKeywordList);
+
 static BOOL IsShKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszShKeywordList[] =
-	{
-		_T("alias"),
-		_T("break"),
-		_T("case"),
-		_T("do"),
-		_T("done"),
-		_T("echo"),
-		_T("elif"),
-		_T("else"),
-		_T("esac"),
-		_T("exec"),
-		_T("exit"),
-		_T("export"),
-		_T("fi"),
-		_T("for"),
-		_T("function"),
-		_T("if"),
-		_T("in"),
-		_T("read"),
-		_T("return"),
-		_T("select"),
-		_T("set"),
-		_T("shift"),
-		_T("source"),
-		_T("then"),
-		_T("unalias"),
-		_T("unset"),
-		_T("until"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszShKeywordList);
+	return s_ShKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("chmod"),
+	_T("chown"),
+	_T("logout"),
+	_T("ls"),
+	_T("pwd"),
+	_T("ssh"),
+	_T("telnet"),
+	_T("who"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("chmod"),
-		_T("chown"),
-		_T("logout"),
-		_T("ls"),
-		_T("pwd"),
-		_T("ssh"),
-		_T("telnet"),
-		_T("who"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
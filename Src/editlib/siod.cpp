@@ -23,310 +23,319 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszSiodKeywordList[] =
+{
+	_T("abs"),
+	_T("alarm"),
+	_T("and"),
+	_T("append"),
+	_T("apply"),
+	_T("ass"),
+	_T("assoc"),
+	_T("assq"),
+	_T("assv"),
+	_T("base64decode"),
+	_T("base64encode"),
+	_T("begin"),
+	_T("caaar"),
+	_T("caadr"),
+	_T("caar"),
+	_T("cadar"),
+	_T("caddr"),
+	_T("cadr"),
+	_T("car"),
+	_T("cdaar"),
+	_T("cdadr"),
+	_T("cdar"),
+	_T("cddar"),
+	_T("cdddr"),
+	_T("cddr"),
+	_T("cdr"),
+	_T("cond"),
+	_T("cons-array"),
+	_T("define"),
+	_T("eq?"),
+	_T("equal?"),
+	_T("eqv?"),
+	_T("eval"),
+	_T("exec"),
+	_T("exit"),
+	_T("fclose"),
+	_T("fopen"),
+	_T("if"),
+	_T("lambda"),
+	_T("length"),
+	_T("let"),
+	_T("let*"),
+	_T("letrec"),
+	_T("list"),
+	_T("load"),
+	_T("max"),
+	_T("member"),
+	_T("memq"),
+	_T("memv"),
+	_T("min"),
+	_T("nil"),
+	_T("not"),
+	_T("null?"),
+	_T("number->string"),
+	_T("number?"),
+	_T("or"),
+	_T("pair?"),
+	_T("quit"),
+	_T("quote"),
+	_T("read"),
+	_T("reverse"),
+	_T("set!"),
+	_T("set-car!"),
+	_T("set-cdr!"),
+	_T("string->number"),
+	_T("string-append"),
+	_T("string-length"),
+	_T("string?"),
+	_T("substring"),
+	_T("symbol?"),
+};
+
+static KeywordHash<_tcsnicmp> const s_SiodKeywordHash(s_apszSiodKeywordList);
+
 static BOOL IsSiodKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSiodKeywordList[] =
-	{
-		_T("abs"),
-		_T("alarm"),
-		_T("and"),
-		_T("append"),
-		_T("apply"),
-		_T("ass"),
-		_T("assoc"),
-		_T("assq"),
-		_T("assv"),
-		_T("base64decode"),
-		_T("base64encode"),
-		_T("begin"),
-		_T("caaar"),
-		_T("caadr"),
-		_T("caar"),
-		_T("cadar"),
-		_T("caddr"),
-		_T("cadr"),
-		_T("car"),
-		_T("cdaar"),
-		_T("cdadr"),
-		_T("cdar"),
-		_T("cddar"),
-		_T("cdddr"),
-		_T("cddr"),
-		_T("cdr"),
-		_T("cond"),
-		_T("cons-array"),
-		_T("define"),
-		_T("eq?"),
-		_T("equal?"),
-		_T("eqv?"),
-		_T("eval"),
-		_T("exec"),
-		_T("exit"),
-		_T("fclose"),
-		_T("fopen"),
-		_T("if"),
-		_T("lambda"),
-		_T("length"),
-		_T("let"),
-		_T("let*"),
-		_T("letrec"),
-		_T("list"),
-		_T("load"),
-		_T("max"),
-		_T("member"),
-		_T("memq"),
-		_T("memv"),
-		_T("min"),
-		_T("nil"),
-		_T("not"),
-		_T("null?"),
-		_T("number->string"),
-		_T("number?"),
-		_T("or"),
-		_T("pair?"),
-		_T("quit"),
-		_T("quote"),
-		_T("read"),
-		_T("reverse"),
-		_T("set!"),
-		_T("set-car!"),
-		_T("set-cdr!"),
-		_T("string->number"),
-		_T("string-append"),
-		_T("string-length"),
-		_T("string?"),
-		_T("substring"),
-		_T("symbol?"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszSiodKeywordList);
+	return s_SiodKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("acos"),
+	_T("asin"),
+	_T("atan"),
+	_T("cos"),
+	_T("exp"),
+	_T("log"),
+	_T("sin"),
+	_T("sqrt"),
+	_T("tan"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("acos"),
-		_T("asin"),
-		_T("atan"),
-		_T("cos"),
-		_T("exp"),
-		_T("log"),
-		_T("sin"),
-		_T("sqrt"),
-		_T("tan"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser2KeywordList[] =
+{
+	_T("%%%memref"),
+	_T("%%closure"),
+	_T("%%closure-code"),
+	_T("%%closure-env"),
+	_T("%%stack-limit"),
+	_T("*after-gc*"),
+	_T("*args*"),
+	_T("*catch"),
+	_T("*env*"),
+	_T("*eval-history-ptr*"),
+	_T("*pi*"),
+	_T("*plists*"),
+	_T("*throw"),
+	_T("*traced*"),
+	_T("access-problem?"),
+	_T("allocate-heap"),
+	_T("apropos"),
+	_T("aref"),
+	_T("array->hexstr"),
+	_T("aset"),
+	_T("ash"),
+	_T("atan2"),
+	_T("benchmark-eval"),
+	_T("benchmark-funcall1"),
+	_T("benchmark-funcall2"),
+	_T("bit-and"),
+	_T("bit-not"),
+	_T("bit-or"),
+	_T("bit-xor"),
+	_T("butlast"),
+	_T("bytes-append"),
+	_T("chdir"),
+	_T("chmod"),
+	_T("chown"),
+	_T("closedir"),
+	_T("copy-list"),
+	_T("cpu-usage-limits"),
+	_T("crypt"),
+	_T("current-resource-usage"),
+	_T("datlength"),
+	_T("datref"),
+	_T("decode-file-mode"),
+	_T("delete-file"),
+	_T("delq"),
+	_T("encode-file-mode"),
+	_T("encode-open-flags"),
+	_T("endpwent"),
+	_T("env-lookup"),
+	_T("eof-val"),
+	_T("errobj"),
+	_T("error"),
+	_T("F_GETLK"),
+	_T("F_SETLK"),
+	_T("F_SETLKW"),
+	_T("fast-load"),
+	_T("fast-print"),
+	_T("fast-read"),
+	_T("fast-save"),
+	_T("fchmod"),
+	_T("fflush"),
+	_T("file-times"),
+	_T("first"),
+	_T("fmod"),
+	_T("fnmatch"),
+	_T("fork"),
+	_T("fread"),
+	_T("fseek"),
+	_T("fstat"),
+	_T("ftell"),
+	_T("fwrite"),
+	_T("gc"),
+	_T("gc-info"),
+	_T("gc-status"),
+	_T("get"),
+	_T("getc"),
+	_T("getcwd"),
+	_T("getenv"),
+	_T("getgid"),
+	_T("getgrgid"),
+	_T("getpass"),
+	_T("getpgrp"),
+	_T("getpid"),
+	_T("getppid"),
+	_T("getpwent"),
+	_T("getpwnam"),
+	_T("getpwuid"),
+	_T("gets"),
+	_T("getuid"),
+	_T("gmtime"),
+	_T("hexstr->bytes"),
+	_T("href"),
+	_T("hset"),
+	_T("html-encode"),
+	_T("intern"),
+	_T("kill"),
+	_T("larg-default"),
+	_T("last"),
+	_T("last-c-error"),
+	_T("lchown"),
+	_T("link"),
+	_T("lkey-default"),
+	_T("load-so"),
+	_T("localtime"),
+	_T("lref-default"),
+	_T("lstat"),
+	_T("make-list"),
+	_T("mapcar"),
+	_T("md5-final"),
+	_T("md5-init"),
+	_T("md5-update"),
+	_T("mkdatref"),
+	_T("mkdir"),
+	_T("mktime"),
+	_T("nconc"),
+	_T("nice"),
+	_T("nreverse"),
+	_T("nth"),
+	_T("opendir"),
+	_T("os-classification"),
+	_T("parse-number"),
+	_T("pclose"),
+	_T("popen"),
+	_T("pow"),
+	_T("prin1"),
+	_T("print"),
+	_T("print-to-string"),
+	_T("prog1"),
+	_T("putc"),
+	_T("putenv"),
+	_T("putprop"),
+	_T("puts"),
+	_T("qsort"),
+	_T("rand"),
+	_T("random"),
+	_T("read-from-string"),
+	_T("readdir"),
+	_T("readline"),
+	_T("readlink"),
+	_T("realtime"),
+	_T("rename"),
+	_T("require"),
+	_T("require-so"),
+	_T("rest"),
+	_T("rld-pathnames"),
+	_T("rmdir"),
+	_T("runtime"),
+	_T("save-forms"),
+	_T("sdatref"),
+	_T("set-eval-history"),
+	_T("set-symbol-value!"),
+	_T("setprop"),
+	_T("setpwent"),
+	_T("setuid"),
+	_T("siod-lib"),
+	_T("sleep"),
+	_T("so-ext"),
+	_T("srand"),
+	_T("srandom"),
+	_T("stat"),
+	_T("strbreakup"),
+	_T("strcat"),
+	_T("strcmp"),
+	_T("strcpy"),
+	_T("strcspn"),
+	_T("strftime"),
+	_T("string-dimension"),
+	_T("string-downcase"),
+	_T("string-lessp"),
+	_T("string-search"),
+	_T("string-trim"),
+	_T("string-trim-left"),
+	_T("string-trim-right"),
+	_T("string-upcase"),
+	_T("strptime"),
+	_T("strspn"),
+	_T("subset"),
+	_T("substring-equal?"),
+	_T("swrite"),
+	_T("sxhash"),
+	_T("symbol-bound?"),
+	_T("symbol-value"),
+	_T("symbolconc"),
+	_T("symlink"),
+	_T("system"),
+	_T("t"),
+	_T("the-environment"),
+	_T("trace"),
+	_T("trunc"),
+	_T("typeof"),
+	_T("unbreakupstr"),
+	_T("ungetc"),
+	_T("unix-ctime"),
+	_T("unix-time"),
+	_T("unix-time->strtime"),
+	_T("unlink"),
+	_T("untrace"),
+	_T("url-decode"),
+	_T("url-encode"),
+	_T("utime"),
+	_T("verbose"),
+	_T("wait"),
+	_T("while"),
+	_T("writes"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User2KeywordHash(s_apszUser2KeywordList);
+
 static BOOL IsUser2Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser2KeywordList[] =
-	{
-		_T("%%%memref"),
-		_T("%%closure"),
-		_T("%%closure-code"),
-		_T("%%closure-env"),
-		_T("%%stack-limit"),
-		_T("*after-gc*"),
-		_T("*args*"),
-		_T("*catch"),
-		_T("*env*"),
-		_T("*eval-history-ptr*"),
-		_T("*pi*"),
-		_T("*plists*"),
-		_T("*throw"),
-		_T("*traced*"),
-		_T("access-problem?"),
-		_T("allocate-heap"),
-		_T("apropos"),
-		_T("aref"),
-		_T("array->hexstr"),
-		_T("aset"),
-		_T("ash"),
-		_T("atan2"),
-		_T("benchmark-eval"),
-		_T("benchmark-funcall1"),
-		_T("benchmark-funcall2"),
-		_T("bit-and"),
-		_T("bit-not"),
-		_T("bit-or"),
-		_T("bit-xor"),
-		_T("butlast"),
-		_T("bytes-append"),
-		_T("chdir"),
-		_T("chmod"),
-		_T("chown"),
-		_T("closedir"),
-		_T("copy-list"),
-		_T("cpu-usage-limits"),
-		_T("crypt"),
-		_T("current-resource-usage"),
-		_T("datlength"),
-		_T("datref"),
-		_T("decode-file-mode"),
-		_T("delete-file"),
-		_T("delq"),
-		_T("encode-file-mode"),
-		_T("encode-open-flags"),
-		_T("endpwent"),
-		_T("env-lookup"),
-		_T("eof-val"),
-		_T("errobj"),
-		_T("error"),
-		_T("F_GETLK"),
-		_T("F_SETLK"),
-		_T("F_SETLKW"),
-		_T("fast-load"),
-		_T("fast-print"),
-		_T("fast-read"),
-		_T("fast-save"),
-		_T("fchmod"),
-		_T("fflush"),
-		_T("file-times"),
-		_T("first"),
-		_T("fmod"),
-		_T("fnmatch"),
-		_T("fork"),
-		_T("fread"),
-		_T("fseek"),
-		_T("fstat"),
-		_T("ftell"),
-		_T("fwrite"),
-		_T("gc"),
-		_T("gc-info"),
-		_T("gc-status"),
-		_T("get"),
-		_T("getc"),
-		_T("getcwd"),
-		_T("getenv"),
-		_T("getgid"),
-		_T("getgrgid"),
-		_T("getpass"),
-		_T("getpgrp"),
-		_T("getpid"),
-		_T("getppid"),
-		_T("getpwent"),
-		_T("getpwnam"),
-		_T("getpwuid"),
-		_T("gets"),
-		_T("getuid"),
-		_T("gmtime"),
-		_T("hexstr->bytes"),
-		_T("href"),
-		_T("hset"),
-		_T("html-encode"),
-		_T("intern"),
-		_T("kill"),
-		_T("larg-default"),
-		_T("last"),
-		_T("last-c-error"),
-		_T("lchown"),
-		_T("link"),
-		_T("lkey-default"),
-		_T("load-so"),
-		_T("localtime"),
-		_T("lref-default"),
-		_T("lstat"),
-		_T("make-list"),
-		_T("mapcar"),
-		_T("md5-final"),
-		_T("md5-init"),
-		_T("md5-update"),
-		_T("mkdatref"),
-		_T("mkdir"),
-		_T("mktime"),
-		_T("nconc"),
-		_T("nice"),
-		_T("nreverse"),
-		_T("nth"),
-		_T("opendir"),
-		_T("os-classification"),
-		_T("parse-number"),
-		_T("pclose"),
-		_T("popen"),
-		_T("pow"),
-		_T("prin1"),
-		_T("print"),
-		_T("print-to-string"),
-		_T("prog1"),
-		_T("putc"),
-		_T("putenv"),
-		_T("putprop"),
-		_T("puts"),
-		_T("qsort"),
-		_T("rand"),
-		_T("random"),
-		_T("read-from-string"),
-		_T("readdir"),
-		_T("readline"),
-		_T("readlink"),
-		_T("realtime"),
-		_T("rename"),
-		_T("require"),
-		_T("require-so"),
-		_T("rest"),
-		_T("rld-pathnames"),
-		_T("rmdir"),
-		_T("runtime"),
-		_T("save-forms"),
-		_T("sdatref"),
-		_T("set-eval-history"),
-		_T("set-symbol-value!"),
-		_T("setprop"),
-		_T("setpwent"),
-		_T("setuid"),
-		_T("siod-lib"),
-		_T("sleep"),
-		_T("so-ext"),
-		_T("srand"),
-		_T("srandom"),
-		_T("stat"),
-		_T("strbreakup"),
-		_T("strcat"),
-		_T("strcmp"),
-		_T("strcpy"),
-		_T("strcspn"),
-		_T("strftime"),
-		_T("string-dimension"),
-		_T("string-downcase"),
-		_T("string-lessp"),
-		_T("string-search"),
-		_T("string-trim"),
-		_T("string-trim-left"),
-		_T("string-trim-right"),
-		_T("string-upcase"),
-		_T("strptime"),
-		_T("strspn"),
-		_T("subset"),
-		_T("substring-equal?"),
-		_T("swrite"),
-		_T("sxhash"),
-		_T("symbol-bound?"),
-		_T("symbol-value"),
-		_T("symbolconc"),
-		_T("symlink"),
-		_T("system"),
-		_T("t"),
-		_T("the-environment"),
-		_T("trace"),
-		_T("trunc"),
-		_T("typeof"),
-		_T("unbreakupstr"),
-		_T("ungetc"),
-		_T("unix-ctime"),
-		_T("unix-time"),
-		_T("unix-time->strtime"),
-		_T("unlink"),
-		_T("untrace"),
-		_T("url-decode"),
-		_T("url-encode"),
-		_T("utime"),
-		_T("verbose"),
-		_T("wait"),
-		_T("while"),
-		_T("writes"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser2KeywordList);
+	return s_User2KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
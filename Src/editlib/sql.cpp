@@ -23,47 +23,53 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszSqlKeywordList[] =
+{
+	_T("all"),
+	_T("and"),
+	_T("by"),
+	_T("distinct"),
+	_T("from"),
+	_T("group"),
+	_T("in"),
+	_T("insert"),
+	_T("into"),
+	_T("join"),
+	_T("not"),
+	_T("or"),
+	_T("order"),
+	_T("select"),
+	_T("union"),
+	_T("update"),
+	_T("where"),
+};
+
+static KeywordHash<_tcsnicmp> const s_SqlKeywordHash(s_apszSqlKeywordList);
+
 static BOOL IsSqlKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszSqlKeywordList[] =
-	{
-		_T("all"),
-		_T("and"),
-		_T("by"),
-		_T("distinct"),
-		_T("from"),
-		_T("group"),
-		_T("in"),
-		_T("insert"),
-		_T("into"),
-		_T("join"),
-		_T("not"),
-		_T("or"),
-		_T("order"),
-		_T("select"),
-		_T("union"),
-		_T("update"),
-		_T("where"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszSqlKeywordList);
+	return s_SqlKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszUser1KeywordList[] =
+{
+	_T("BYTE"),
+	_T("CHAR"),
+	_T("DATE"),
+	_T("DOUBLE"),
+	_T("INTEGER"),
+	_T("MEMO"),
+	_T("REAL"),
+	_T("TIME"),
+	_T("VARCHAR"),
+	_T("WORD"),
+};
+
+static KeywordHash<_tcsnicmp> const s_User1KeywordHash(s_apszUser1KeywordList);
+
 static BOOL IsUser1Keyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszUser1KeywordList[] =
-	{
-		_T("BYTE"),
-		_T("CHAR"),
-		_T("DATE"),
-		_T("DOUBLE"),
-		_T("INTEGER"),
-		_T("MEMO"),
-		_T("REAL"),
-		_T("TIME"),
-		_T("VARCHAR"),
-		_T("WORD"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszUser1KeywordList);
+	return s_User1KeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
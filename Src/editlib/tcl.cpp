@@ -23,26 +23,29 @@
 
 using CommonKeywords::IsNumeric;
 
+static LPCTSTR const s_apszTclKeywordList[] =
+{
+	_T("case"),
+	_T("do"),
+	_T("done"),
+	_T("elif"),
+	_T("else"),
+	_T("esac"),
+	_T("fi"),
+	_T("for"),
+	_T("function"),
+	_T("if"),
+	_T("in"),
+	_T("then"),
+	_T("until"),
+	_T("while"),
+};
+
+static KeywordHash<_tcsnicmp> const s_TclKeywordHash(s_apszTclKeywordList);
+
 static BOOL IsTclKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszTclKeywordList[] =
-	{
-		_T("case"),
-		_T("do"),
-		_T("done"),
-		_T("elif"),
-		_T("else"),
-		_T("esac"),
-		_T("fi"),
-		_T("for"),
-		_T("function"),
-		_T("if"),
-		_T("in"),
-		_T("then"),
-		_T("until"),
-		_T("while"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszTclKeywordList);
+	return s_TclKeywordHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
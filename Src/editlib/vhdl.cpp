@@ -22,134 +22,140 @@
 #endif
 
 // VHDL keywords
+static LPCTSTR const s_apszVhdlKeywordList[] =
+{
+	_T("abs"),
+	_T("access"),
+	_T("after"),
+	_T("alias"),
+	_T("all"),
+	_T("and"),
+	_T("architecture"),
+	_T("array"),
+	_T("assert"),
+	_T("attribute"),
+	_T("begin"),
+	_T("block"),
+	_T("body"),
+	_T("buffer"),
+	_T("bus"),
+	_T("case"),
+	_T("component"),
+	_T("configuration"),
+	_T("constant"),
+	_T("disconnect"),
+	_T("downto"),
+	_T("else"),
+	_T("elsif"),
+	_T("end"),
+	_T("entity"),
+	_T("exit"),
+	_T("false"),
+	_T("file"),
+	_T("for"),
+	_T("function"),
+	_T("generate"),
+	_T("generic"),
+	_T("guarded"),
+	_T("if"),
+	_T("in"),
+	_T("inout"),
+	_T("is"),
+	_T("label"),
+	_T("library"),
+	_T("linkage"),
+	_T("loop"),
+	_T("map"),
+	_T("mod"),
+	_T("nand"),
+	_T("new"),
+	_T("next"),
+	_T("nor"),
+	_T("not"),
+	_T("null"),
+	_T("of"),
+	_T("on"),
+	_T("open"),
+	_T("or"),
+	_T("others"),
+	_T("out"),
+	_T("pakage"),
+	_T("port"),
+	_T("procedure"),
+	_T("process"),
+	_T("range"),
+	_T("record"),
+	_T("register"),
+	_T("rem"),
+	_T("report"),
+	_T("return"),
+	_T("select"),
+	_T("severity"),
+	_T("signal"),
+	_T("subtype"),
+	_T("then"),
+	_T("to"),
+	_T("transport"),
+	_T("true"),
+	_T("type"),
+	_T("units"),
+	_T("until"),
+	_T("use"),
+	_T("variable"),
+	_T("wait"),
+	_T("when"),
+	_T("while"),
+	_T("with"),
+	_T("xor")
+};
+
+static KeywordHash<_tcsnicmp> const s_VhdlKeywordHash(s_apszVhdlKeywordList);
+
 static BOOL IsVhdlKeyword(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszVhdlKeywordList[] =
-	{
-		_T("abs"),
-		_T("access"),
-		_T("after"),
-		_T("alias"),
-		_T("all"),
-		_T("and"),
-		_T("architecture"),
-		_T("array"),
-		_T("assert"),
-		_T("attribute"),
-		_T("begin"),
-		_T("block"),
-		_T("body"),
-		_T("buffer"),
-		_T("bus"),
-		_T("case"),
-		_T("component"),
-		_T("configuration"),
-		_T("constant"),
-		_T("disconnect"),
-		_T("downto"),
-		_T("else"),
-		_T("elsif"),
-		_T("end"),
-		_T("entity"),
-		_T("exit"),
-		_T("false"),
-		_T("file"),
-		_T("for"),
-		_T("function"),
-		_T("generate"),
-		_T("generic"),
-		_T("guarded"),
-		_T("if"),
-		_T("in"),
-		_T("inout"),
-		_T("is"),
-		_T("label"),
-		_T("library"),
-		_T("linkage"),
-		_T("loop"),
-		_T("map"),
-		_T("mod"),
-		_T("nand"),
-		_T("new"),
-		_T("next"),
-		_T("nor"),
-		_T("not"),
-		_T("null"),
-		_T("of"),
-		_T("on"),
-		_T("open"),
-		_T("or"),
-		_T("others"),
-		_T("out"),
-		_T("pakage"),
-		_T("port"),
-		_T("procedure"),
-		_T("process"),
-		_T("range"),
-		_T("record"),
-		_T("register"),
-		_T("rem"),
-		_T("report"),
-		_T("return"),
-		_T("select"),
-		_T("severity"),
-		_T("signal"),
-		_T("subtype"),
-		_T("then"),
-		_T("to"),
-		_T("transport"),
-		_T("true"),
-		_T("type"),
-		_T("units"),
-		_T("until"),
-		_T("use"),
-		_T("variable"),
-		_T("wait"),
-		_T("when"),
-		_T("while"),
-		_T("with"),
-		_T("xor")
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszVhdlKeywordList);
+	return s_VhdlKeywordHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszVhdlAttributeList[] =
+{
+	_T("active"),
+	_T("ascending"),
+	_T("base"),
+	_T("delayed"),
+	_T("driving"),
+	_T("driving_value"),
+	_T("event"),
+	_T("high"),
+	_T("image"),
+	_T("instance_name"),
+	_T("last_active"),
+	_T("last_event"),
+	_T("last_value"),
+	_T("left"),
+	_T("leftof"),
+	_T("length"),
+	_T("low"),
+	_T("path_name"),
+	_T("pos"),
+	_T("pred"),
+	_T("quiet"),
+	_T("range"),
+	_T("reverse_range"),
+	_T("right"),
+	_T("rightof"),
+	_T("simple_name"),
+	_T("stable"),
+	_T("succ"),
+	_T("transaction"),
+	_T("val"),
+	_T("value")
+};
+
+static KeywordHash<_tcsnicmp> const s_VhdlAttributeHash(s_apszVhdlAttributeList);
+
 static BOOL IsVhdlAttribute(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszVhdlAttributeList[] =
-	{
-		_T("active"),
-		_T("ascending"),
-		_T("base"),
-		_T("delayed"),
-		_T("driving"),
-		_T("driving_value"),
-		_T("event"),
-		_T("high"),
-		_T("image"),
-		_T("instance_name"),
-		_T("last_active"),
-		_T("last_event"),
-		_T("last_value"),
-		_T("left"),
-		_T("leftof"),
-		_T("length"),
-		_T("low"),
-		_T("path_name"),
-		_T("pos"),
-		_T("pred"),
-		_T("quiet"),
-		_T("range"),
-		_T("reverse_range"),
-		_T("right"),
-		_T("rightof"),
-		_T("simple_name"),
-		_T("stable"),
-		_T("succ"),
-		_T("transaction"),
-		_T("val"),
-		_T("value")
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszVhdlAttributeList);
+	return s_VhdlAttributeHash.Find(pszChars, nLength);
 }
 
 static BOOL IsVhdlAttributeEx(LPCTSTR pszChars, int nLength, int *nAttributeBegin)
@@ -166,71 +172,77 @@ static BOOL IsVhdlAttributeEx(LPCTSTR pszChars, int nLength, int *nAttributeBegi
 }
 
 // VHDL Types
+static LPCTSTR const s_apszVhdlTypeList[] =
+{
+	_T("bit"),
+	_T("bit_vector"),
+	_T("boolean"),
+	_T("character"),
+	_T("fs"),
+	_T("hr"),
+	_T("integer"),
+	_T("line"),
+	_T("min"),
+	_T("ms"),
+	_T("natural"),
+	_T("now"),
+	_T("ns"),
+	_T("positive"),
+	_T("ps"),
+	_T("real"),
+	_T("sec"),
+	_T("side"),
+	_T("signed"),
+	_T("std_logic"),
+	_T("std_logic_vector"),
+	_T("std_ulogic"),
+	_T("std_ulogic_vector"),
+	_T("string"),
+	_T("text"),
+	_T("time"),
+	_T("unsigned"),
+	_T("us"),
+	_T("width")
+};
+
+static KeywordHash<_tcsnicmp> const s_VhdlTypeHash(s_apszVhdlTypeList);
+
 static BOOL IsVhdlType(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszVhdlTypeList[] =
-	{
-		_T("bit"),
-		_T("bit_vector"),
-		_T("boolean"),
-		_T("character"),
-		_T("fs"),
-		_T("hr"),
-		_T("integer"),
-		_T("line"),
-		_T("min"),
-		_T("ms"),
-		_T("natural"),
-		_T("now"),
-		_T("ns"),
-		_T("positive"),
-		_T("ps"),
-		_T("real"),
-		_T("sec"),
-		_T("side"),
-		_T("signed"),
-		_T("std_logic"),
-		_T("std_logic_vector"),
-		_T("std_ulogic"),
-		_T("std_ulogic_vector"),
-		_T("string"),
-		_T("text"),
-		_T("time"),
-		_T("unsigned"),
-		_T("us"),
-		_T("width")
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszVhdlTypeList);
+	return s_VhdlTypeHash.Find(pszChars, nLength);
 }
 
 // VHDL functions
+static LPCTSTR const s_apszVhdlFunctionList[] =
+{
+	_T("conv_integer"),
+	_T("conv_signed"),
+	_T("conv_std_logic_vector"),
+	_T("conv_unsigned"),
+	_T("falling_edge"),
+	_T("hread"),
+	_T("hwrite"),
+	_T("oread"),
+	_T("owrite"),
+	_T("read"),
+	_T("readline"),
+	_T("rising_edge"),
+	_T("to_bit"),
+	_T("to_bitvector"),
+	_T("to_signed"),
+	_T("to_stdlogicvector"),
+	_T("to_stdulogic"),
+	_T("to_stdulogicvector"),
+	_T("to_unsigned"),
+	_T("write"),
+	_T("writeline"),
+};
+
+static KeywordHash<_tcsnicmp> const s_VhdlFunctionHash(s_apszVhdlFunctionList);
+
 static BOOL IsVhdlFunction(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszVhdlFunctionList[] =
-	{
-		_T("conv_integer"),
-		_T("conv_signed"),
-		_T("conv_std_logic_vector"),
-		_T("conv_unsigned"),
-		_T("falling_edge"),
-		_T("hread"),
-		_T("hwrite"),
-		_T("oread"),
-		_T("owrite"),
-		_T("read"),
-		_T("readline"),
-		_T("rising_edge"),
-		_T("to_bit"),
-		_T("to_bitvector"),
-		_T("to_signed"),
-		_T("to_stdlogicvector"),
-		_T("to_stdulogic"),
-		_T("to_stdulogicvector"),
-		_T("to_unsigned"),
-		_T("write"),
-		_T("writeline"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszVhdlFunctionList);
+	return s_VhdlFunctionHash.Find(pszChars, nLength);
 }
 
 static bool IsVhdlNumber(LPCTSTR pszChars, int nLength)
@@ -26,24 +26,30 @@ using HtmlKeywords::IsDtdTagName;
 using HtmlKeywords::IsDtdAttrName;
 using HtmlKeywords::IsEntityName;
 
+static LPCTSTR const s_apszXmlTagNameList[] =
+{
+	_T("xml"),
+};
+
+static KeywordHash<_tcsnicmp> const s_XmlTagNameHash(s_apszXmlTagNameList);
+
 static BOOL IsXmlTagName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszXmlTagNameList[] =
-	{
-		_T("xml"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszXmlTagNameList);
+	return s_XmlTagNameHash.Find(pszChars, nLength);
 }
 
+static LPCTSTR const s_apszXmlAttrNameList[] =
+{
+	_T("encoding"),
+	_T("standalone"),
+	_T("version"),
+};
+
+static KeywordHash<_tcsnicmp> const s_XmlAttrNameHash(s_apszXmlAttrNameList);
+
 static BOOL IsXmlAttrName(LPCTSTR pszChars, int nLength)
 {
-	static LPCTSTR const s_apszXmlAttrNameList[] =
-	{
-		_T("encoding"),
-		_T("standalone"),
-		_T("version"),
-	};
-	return xiskeyword<_tcsnicmp>(pszChars, nLength, s_apszXmlAttrNameList);
+	return s_XmlAttrNameHash.Find(pszChars, nLength);
 }
 
 #define DEFINE_BLOCK pBuf.DefineBlock
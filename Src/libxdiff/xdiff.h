@@ -82,6 +82,9 @@ typedef struct s_xpparam {
 	/* See Documentation/diff-options.txt. */
 	char **anchors;
 	size_t anchors_nr;
+
+	/* Number of threads to diff the ranges between anchors; 0 or 1 is serial */
+	long threads;
 } xpparam_t;
 
 typedef struct s_xdemitcb {
@@ -376,13 +376,99 @@ out:
 	return result;
 }
 
+/*
+ * Take the steps histogram_diff() would take, breadth first, until there are
+ * enough ranges to keep the threads busy. Each range which is split around its
+ * LCS is replaced with the part before the LCS, and the part after the LCS is
+ * appended. Ranges which histogram_diff() would hand to Myers are marked as
+ * classic, so that their LCS is not searched for again.
+ */
+static int histogram_split(xpparam_t const *xpp, xdfenv_t *env,
+	xdranges_t *split)
+{
+	long const target = xpp->threads * 8;
+	long i, nr;
+	int progress;
+
+	do {
+		progress = 0;
+		nr = split->nr;
+		for (i = 0; i < nr && split->nr < target; i++) {
+			struct region lcs;
+			int lcs_found;
+			xdrange_t *range = split->ranges + i;
+			int line1 = range->line1, count1 = range->count1;
+			int line2 = range->line2, count2 = range->count2;
+
+			/* trivial cases are left to histogram_diff() */
+			if (range->classic || !count1 || !count2 ||
+				count1 + count2 < XDL_SPLIT_MIN)
+				continue;
+			if (LINE_END(1) >= MAX_PTR)
+				return -1;
+
+			memset(&lcs, 0, sizeof(lcs));
+			lcs_found = find_lcs(xpp, env, &lcs, line1, count1, line2, count2);
+			if (lcs_found < 0)
+				return -1;
+			if (lcs_found) {
+				range->classic = 1;
+			} else if (lcs.begin1 == 0 && lcs.begin2 == 0) {
+				while (count1--)
+					env->xdf1.rchg[line1++ - 1] = 1;
+				while (count2--)
+					env->xdf2.rchg[line2++ - 1] = 1;
+				range->count1 = range->count2 = 0;
+			} else {
+				range->count1 = lcs.begin1 - line1;
+				range->count2 = lcs.begin2 - line2;
+				if (xdl_add_range(split,
+						lcs.end1 + 1, LINE_END(1) - lcs.end1,
+						lcs.end2 + 1, LINE_END(2) - lcs.end2, 0))
+					return -1;
+				progress = 1;
+			}
+		}
+	} while (progress && split->nr < target);
+
+	return 0;
+}
+
+static int histogram_diff_range(xpparam_t const *xpp, xdfenv_t *env,
+	xdrange_t const *range)
+{
+	if (range->classic)
+		return fall_back_to_classic_diff(xpp, env,
+			range->line1, range->count1, range->line2, range->count2);
+
+	return histogram_diff(xpp, env,
+		range->line1, range->count1, range->line2, range->count2);
+}
+
 int xdl_do_histogram_diff(mmfile_t *file1, mmfile_t *file2,
 	xpparam_t const *xpp, xdfenv_t *env)
 {
+	xdranges_t split;
+	int result;
+
 	if (xdl_prepare_env(file1, file2, xpp, env) < 0)
 		return -1;
 
-	return histogram_diff(xpp, env,
+	if (!xdl_split_wanted(xpp, env->xdf1.dend - env->xdf1.dstart + 1,
+			env->xdf2.dend - env->xdf2.dstart + 1))
+		return histogram_diff(xpp, env,
+			env->xdf1.dstart + 1, env->xdf1.dend - env->xdf1.dstart + 1,
+			env->xdf2.dstart + 1, env->xdf2.dend - env->xdf2.dstart + 1);
+
+	/* The parts before and after an LCS are independent */
+	memset(&split, 0, sizeof(split));
+	result = xdl_add_range(&split,
 		env->xdf1.dstart + 1, env->xdf1.dend - env->xdf1.dstart + 1,
-		env->xdf2.dstart + 1, env->xdf2.dend - env->xdf2.dstart + 1);
+		env->xdf2.dstart + 1, env->xdf2.dend - env->xdf2.dstart + 1, 0);
+	if (!result)
+		result = histogram_split(xpp, env, &split);
+	if (!result)
+		result = xdl_diff_ranges(xpp, env, &split, histogram_diff_range);
+	xdl_free_ranges(&split);
+	return result;
 }
@@ -38,6 +38,7 @@
 #include "xutils.h"
 #include "xprepare.h"
 #include "xdiffi.h"
+#include "xparallel.h"
 #include "xemit.h"
 
 int xdl_diff_modified(mmfile_t *mf1, mmfile_t *mf2, xpparam_t const *xpp,
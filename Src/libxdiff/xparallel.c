@@ -0,0 +1,146 @@
+/*
+ *  Anchor-split parallel diffing for LibXDiff
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#include "xinclude.h"
+
+#ifdef _WIN32
+#  include <windows.h>
+#  include <process.h>
+#else
+#  include <pthread.h>
+#endif
+
+typedef struct s_xdworker {
+	xpparam_t const *xpp;
+	xdfenv_t *env;
+	xdranges_t const *ranges;
+	xdl_range_func_t func;
+	long volatile next;
+	long volatile failed;
+} xdworker_t;
+
+/*
+ * Is it worth to split a range of the given size into parallel work?
+ */
+int xdl_split_wanted(xpparam_t const *xpp, long count1, long count2) {
+
+	return xpp->threads > 1 && count1 + count2 >= XDL_PARALLEL_MIN;
+}
+
+int xdl_add_range(xdranges_t *ranges, long line1, long count1, long line2, long count2, int classic) {
+	xdrange_t *range;
+
+	if (ranges->nr == ranges->alloc) {
+		long alloc = ranges->alloc ? 2 * ranges->alloc : 64;
+		if (!(range = (xdrange_t *) xdl_realloc(ranges->ranges, alloc * sizeof(xdrange_t))))
+			return -1;
+		ranges->ranges = range;
+		ranges->alloc = alloc;
+	}
+	range = ranges->ranges + ranges->nr++;
+	range->line1 = line1;
+	range->count1 = count1;
+	range->line2 = line2;
+	range->count2 = count2;
+	range->classic = classic;
+
+	return 0;
+}
+
+void xdl_free_ranges(xdranges_t *ranges) {
+
+	xdl_free(ranges->ranges);
+	memset(ranges, 0, sizeof(*ranges));
+}
+
+static long xdl_next_range(xdworker_t *w) {
+#ifdef _WIN32
+	return InterlockedIncrement(&w->next) - 1;
+#else
+	return __sync_fetch_and_add(&w->next, 1);
+#endif
+}
+
+/*
+ * Take ranges from the shared list until none are left. Workers do not wait
+ * for each other, so a worker which got a small range takes the next one.
+ */
+static void xdl_work_ranges(xdworker_t *w) {
+	long i;
+
+	while ((i = xdl_next_range(w)) < w->ranges->nr && !w->failed) {
+		if (w->func(w->xpp, w->env, w->ranges->ranges + i) < 0)
+			w->failed = 1;
+	}
+}
+
+#ifdef _WIN32
+static unsigned __stdcall xdl_worker_proc(void *p) {
+
+	xdl_work_ranges((xdworker_t *) p);
+	return 0;
+}
+#else
+static void *xdl_worker_proc(void *p) {
+
+	xdl_work_ranges((xdworker_t *) p);
+	return NULL;
+}
+#endif
+
+/*
+ * Diff the given ranges on up to xpp->threads threads, including the calling
+ * thread. The ranges must not overlap, so that each one writes only its own
+ * part of the rchg vectors.
+ */
+int xdl_diff_ranges(xpparam_t const *xpp, xdfenv_t *env, xdranges_t const *ranges,
+		    xdl_range_func_t func) {
+	xdworker_t w;
+	long i, nthreads = XDL_MIN(XDL_MIN(xpp->threads, ranges->nr), XDL_MAX_THREADS);
+#ifdef _WIN32
+	HANDLE threads[XDL_MAX_THREADS];
+#else
+	pthread_t threads[XDL_MAX_THREADS];
+#endif
+
+	w.xpp = xpp;
+	w.env = env;
+	w.ranges = ranges;
+	w.func = func;
+	w.next = 0;
+	w.failed = 0;
+
+	/*
+	 * Threads which fail to start leave their share to the others. On Windows,
+	 * start them through the CRT, as the workers allocate through it.
+	 */
+	for (i = 0; i < nthreads - 1; i++) {
+#ifdef _WIN32
+		if (!(threads[i] = (HANDLE) _beginthreadex(NULL, 0, xdl_worker_proc, &w, 0, NULL)))
+			break;
+#else
+		if (pthread_create(threads + i, NULL, xdl_worker_proc, &w) != 0)
+			break;
+#endif
+	}
+	xdl_work_ranges(&w);
+#ifdef _WIN32
+	if (i) {
+		WaitForMultipleObjects(i, threads, TRUE, INFINITE);
+		while (i--)
+			CloseHandle(threads[i]);
+	}
+#else
+	while (i--)
+		pthread_join(threads[i], NULL);
+#endif
+
+	return w.failed ? -1 : 0;
+}
@@ -0,0 +1,45 @@
+/*
+ *  Anchor-split parallel diffing for LibXDiff
+ *
+ *  Patience and histogram diff find common lines first, and then diff the
+ *  ranges between them independently of each other. Each such range writes
+ *  only its own part of the rchg vectors, so the ranges can be diffed
+ *  concurrently, and the change script which xdl_build_script() derives from
+ *  rchg comes out exactly the same as from a serial run.
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ */
+
+#if !defined(XPARALLEL_H)
+#define XPARALLEL_H
+
+/* Files with fewer lines in between common prefix and suffix are diffed serially */
+#define XDL_PARALLEL_MIN 16384
+/* Ranges with fewer lines are not split any further */
+#define XDL_SPLIT_MIN 1024
+/* Upper bound on the number of worker threads */
+#define XDL_MAX_THREADS 32
+
+typedef struct s_xdrange {
+	long line1, count1, line2, count2;
+	int classic; /* diff with Myers rather than with the splitting algorithm */
+} xdrange_t;
+
+typedef struct s_xdranges {
+	xdrange_t *ranges;
+	long nr, alloc;
+} xdranges_t;
+
+typedef int (*xdl_range_func_t)(xpparam_t const *xpp, xdfenv_t *env, xdrange_t const *range);
+
+int xdl_split_wanted(xpparam_t const *xpp, long count1, long count2);
+int xdl_add_range(xdranges_t *ranges, long line1, long count1, long line2, long count2, int classic);
+void xdl_free_ranges(xdranges_t *ranges);
+int xdl_diff_ranges(xpparam_t const *xpp, xdfenv_t *env, xdranges_t const *ranges,
+		    xdl_range_func_t func);
+
+#endif /* #if !defined(XPARALLEL_H) */
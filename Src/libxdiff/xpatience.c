@@ -76,6 +76,8 @@ struct hashmap {
 	mmfile_t *file1, *file2;
 	xdfenv_t *env;
 	xpparam_t const *xpp;
+	/* if set, collect the ranges between common lines instead of recursing */
+	xdranges_t *split;
 };
 
 static int is_anchor(xpparam_t const *xpp, const char *line)
@@ -263,7 +265,8 @@ static int match(struct hashmap *map, int line1, int line2)
 
 static int patience_diff(mmfile_t *file1, mmfile_t *file2,
 		xpparam_t const *xpp, xdfenv_t *env,
-		int line1, int count1, int line2, int count2);
+		int line1, int count1, int line2, int count2,
+		xdranges_t *split);
 
 static int walk_common_sequence(struct hashmap *map, struct entry *first,
 		int line1, int count1, int line2, int count2)
@@ -296,10 +299,15 @@ static int walk_common_sequence(struct hashmap *map, struct entry *first,
 			struct hashmap submap;
 
 			memset(&submap, 0, sizeof(submap));
-			if (patience_diff(map->file1, map->file2,
+			if (map->split) {
+				if (xdl_add_range(map->split,
+						line1, next1 - line1,
+						line2, next2 - line2, 0))
+					return -1;
+			} else if (patience_diff(map->file1, map->file2,
 					map->xpp, map->env,
 					line1, next1 - line1,
-					line2, next2 - line2))
+					line2, next2 - line2, NULL))
 				return -1;
 		}
 
@@ -333,10 +341,14 @@ static int fall_back_to_classic_diff(struct hashmap *map,
  * and if none was found, ask xdl_do_diff() to do the job.
  *
  * This function assumes that env was prepared with xdl_prepare_env().
+ *
+ * If split is not NULL, the ranges between the common lines are added to it
+ * rather than being diffed right away.
  */
 static int patience_diff(mmfile_t *file1, mmfile_t *file2,
 		xpparam_t const *xpp, xdfenv_t *env,
-		int line1, int count1, int line2, int count2)
+		int line1, int count1, int line2, int count2,
+		xdranges_t *split)
 {
 	struct hashmap map;
 	struct entry *first;
@@ -354,6 +366,7 @@ static int patience_diff(mmfile_t *file1, mmfile_t *file2,
 	}
 
 	memset(&map, 0, sizeof(map));
+	map.split = split;
 	if (fill_hashmap(file1, file2, xpp, env, &map,
 			line1, count1, line2, count2))
 		return -1;
@@ -380,13 +393,38 @@ static int patience_diff(mmfile_t *file1, mmfile_t *file2,
 	return result;
 }
 
+/*
+ * Diff one of the ranges collected by the top level patience_diff().
+ * The files are only passed through the recursion, so they are not needed.
+ */
+static int patience_diff_range(xpparam_t const *xpp, xdfenv_t *env,
+		xdrange_t const *range)
+{
+	return patience_diff(NULL, NULL, xpp, env,
+			range->line1, range->count1,
+			range->line2, range->count2, NULL);
+}
+
 int xdl_do_patience_diff(mmfile_t *file1, mmfile_t *file2,
 		xpparam_t const *xpp, xdfenv_t *env)
 {
+	xdranges_t split;
+	int result;
+
 	if (xdl_prepare_env(file1, file2, xpp, env) < 0)
 		return -1;
 
 	/* environment is cleaned up in xdl_diff() */
-	return patience_diff(file1, file2, xpp, env,
-			1, env->xdf1.nrec, 1, env->xdf2.nrec);
+	if (!xdl_split_wanted(xpp, env->xdf1.nrec, env->xdf2.nrec))
+		return patience_diff(file1, file2, xpp, env,
+				1, env->xdf1.nrec, 1, env->xdf2.nrec, NULL);
+
+	/* The ranges between the common unique lines are independent */
+	memset(&split, 0, sizeof(split));
+	result = patience_diff(file1, file2, xpp, env,
+			1, env->xdf1.nrec, 1, env->xdf2.nrec, &split);
+	if (!result)
+		result = xdl_diff_ranges(xpp, env, &split, patience_diff_range);
+	xdl_free_ranges(&split);
+	return result;
 }
@@ -459,6 +459,7 @@
 #define IDC_COMPARE_WALKUNIQUES                 1349
 #define IDC_COMPARE_QUICKC_LIMIT                1350
 #define IDC_MATCH_SIMILAR_LINES_MAX             1351
+#define IDC_COMPARE_WATCH_FOLDERS               1352
 #define IDC_COMPARE_BINARYC_LIMIT               1353
 #define IDC_BUTTON_NEW_FOLDER                   1354
 #define IDC_STATIC_FILTER                       1355
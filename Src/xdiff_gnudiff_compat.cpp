@@ -19,7 +19,88 @@ static int hunk_func(long start_a, long count_a, long start_b, long count_b, voi
 	return 0;
 }
 
-struct change *diff_2_files_xdiff(struct comparison *cmp, int bMoved_blocks_flag, int *bin_file, int algorithm)
+/**
+ * @brief Upper bound on N * D below which the minimal Myers diff is cheap.
+ * N is the number of lines left after prefix/suffix trimming, D is the
+ * estimated edit distance. Beyond it, DIFF_ALGORITHM_AUTO gives up the
+ * minimal diff in favor of xdiff's cost-limited heuristic.
+ */
+static const UINT64 MinimalCostBudget = 1 << 24;
+
+/**
+ * @brief Choose an algorithm for DIFF_ALGORITHM_AUTO.
+ * Looks at the equivalence classes which read_files() has assigned to the
+ * lines between the common prefix and suffix:
+ * - Lines whose class does not occur in the other file must be inserted or
+ *   deleted, so their count is a lower bound on the edit distance D. Small or
+ *   near-identical inputs go to Myers, which takes O(N * D).
+ * - Files which consist mostly of repeated lines (generated code, tables)
+ *   provide few anchors, so they go to histogram, which copes with those.
+ * - Files with plenty of lines unique to both sides go to patience.
+ * @param [in] cmp Files as prepared by read_files().
+ * @param [out] cost Estimated N * D.
+ * @return The DiffAlgorithm to run.
+ */
+static int choose_diff_algorithm(struct comparison const *cmp, UINT64 &cost)
+{
+	lin const n0 = cmp->file[0].buffered_lines;
+	lin const n1 = cmp->file[1].buffered_lines;
+	lin const *const equivs0 = cmp->file[0].equivs;
+	lin const *const equivs1 = cmp->file[1].equivs;
+	lin const equiv_max = cmp->file[0].equiv_max;
+	cost = 0;
+	// Binary files and files compared to themselves have no classes
+	if (equivs0 == NULL || equivs1 == NULL || equiv_max <= 1)
+		return DIFF_ALGORITHM_XDF_MYERS;
+	lin *const counts = static_cast<lin *>(zalloc(equiv_max * 2 * sizeof *counts));
+	lin i;
+	for (i = 0; i < n0; ++i)
+		++counts[2 * equivs0[i]];
+	for (i = 0; i < n1; ++i)
+		++counts[2 * equivs1[i] + 1];
+	lin unmatched = 0; // lines which occur on one side only
+	lin unique = 0; // lines which occur once in their own file
+	lin unique_common = 0; // lines which occur exactly once in each file
+	// Class 0 holds lines which were not hashed
+	for (i = 1; i < equiv_max; ++i)
+	{
+		lin const c0 = counts[2 * i];
+		lin const c1 = counts[2 * i + 1];
+		if (c0 == 0 || c1 == 0)
+			unmatched += c0 + c1;
+		if (c0 == 1)
+			++unique;
+		if (c1 == 1)
+			++unique;
+		if (c0 == 1 && c1 == 1)
+			++unique_common;
+	}
+	free(counts);
+	lin const n = n0 + n1;
+	cost = static_cast<UINT64>(n) * static_cast<UINT64>(max<lin>(unmatched, 1));
+	if (cost <= MinimalCostBudget)
+		return DIFF_ALGORITHM_XDF_MYERS;
+	// Less than half of the lines are unique within their own file
+	if (2 * unique < n)
+		return DIFF_ALGORITHM_XDF_HISTOGRAM;
+	// Patience diff needs common unique lines to anchor the matching
+	if (4 * unique_common < min(n0, n1))
+		return DIFF_ALGORITHM_XDF_HISTOGRAM;
+	return DIFF_ALGORITHM_XDF_PATIENCE;
+}
+
+/**
+ * @brief Compare two files using libxdiff.
+ * @param [in] cmp Files to compare.
+ * @param [in] bMoved_blocks_flag Whether to detect moved blocks.
+ * @param [out] bin_file Which files are binary, as a bitmap.
+ * @param [in,out] algorithm Requested DiffAlgorithm on entry, the one which
+ * actually ran on return. DIFF_ALGORITHM_AUTO is resolved per file.
+ * @param [out] cost_capped Whether the minimal diff was given up as too
+ * expensive.
+ * @return Change script, or NULL if files are identical.
+ */
+struct change *diff_2_files_xdiff(struct comparison *cmp, int bMoved_blocks_flag, int *bin_file, int *algorithm, bool *cost_capped, long threads)
 {
 	change *script = NULL;
 	xdfenv_t xe;
@@ -28,18 +109,6 @@ struct change *diff_2_files_xdiff(struct comparison *cmp, int bMoved_blocks_flag
 	xdemitconf_t xecfg = { 0 };
 	xdemitcb_t ecb = { 0 };
 
-	switch (algorithm)
-	{
-	case DIFF_ALGORITHM_XDF_PATIENCE:
-		xpp.flags = XDF_PATIENCE_DIFF;
-		break;
-	case DIFF_ALGORITHM_XDF_HISTOGRAM:
-		xpp.flags = XDF_HISTOGRAM_DIFF;
-		break;
-	default:
-		break;
-	}
-
 	if (cmp->ignore_case)
 		xpp.flags |= XDF_IGNORE_CASE;
 	if (cmp->ignore_blank_lines)
@@ -66,6 +135,34 @@ struct change *diff_2_files_xdiff(struct comparison *cmp, int bMoved_blocks_flag
 
 	read_files(cmp, bin_file);
 
+	*cost_capped = false;
+	if (*algorithm == DIFF_ALGORITHM_AUTO)
+	{
+		UINT64 cost;
+		*algorithm = choose_diff_algorithm(cmp, cost);
+		// Once the edit script explodes, a near-minimal diff is good enough
+		if (cost > MinimalCostBudget && (xpp.flags & XDF_NEED_MINIMAL))
+		{
+			xpp.flags &= ~XDF_NEED_MINIMAL;
+			*cost_capped = true;
+		}
+	}
+
+	switch (*algorithm)
+	{
+	case DIFF_ALGORITHM_XDF_PATIENCE:
+		xpp.flags |= XDF_PATIENCE_DIFF;
+		break;
+	case DIFF_ALGORITHM_XDF_HISTOGRAM:
+		xpp.flags |= XDF_HISTOGRAM_DIFF;
+		break;
+	default:
+		break;
+	}
+
+	// Patience and histogram diff the ranges between common lines in parallel
+	xpp.threads = threads;
+
 	mmfile_t mmfile1 = {
 		const_cast<char *>(cmp->file[0].prefix_end),
 		static_cast<long>(cmp->file[0].suffix_begin - cmp->file[0].prefix_end) - cmp->file[0].missing_newline
@@ -89,3 +186,58 @@ struct change *diff_2_files_xdiff(struct comparison *cmp, int bMoved_blocks_flag
 
 	return script;
 }
+
+TESTCASE
+{
+	// Diffing the ranges between common lines in parallel must not change the script
+	char *const buf[2] = { static_cast<char *>(malloc(1 << 20)), static_cast<char *>(malloc(1 << 20)) };
+	mmfile_t mmfile[2] = { { buf[0], 0 }, { buf[1], 0 } };
+	unsigned seed = 1;
+	for (int i = 0; i < 40000; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		unsigned const r = seed >> 16;
+		// Mostly unique lines, some repeated ones, and random edits on either side
+		int const line = r % 8 == 0 ? r % 16 : i;
+		for (int side = 0; side < 2; ++side)
+		{
+			if (r % 97 == static_cast<unsigned>(side))
+				continue;
+			int const edit = r % 89 == static_cast<unsigned>(side) ? 1000000 : 0;
+			mmfile[side].size += sprintf(buf[side] + mmfile[side].size, "%d\n", line + edit);
+		}
+	}
+	static const unsigned long rgFlags[] = { XDF_PATIENCE_DIFF, XDF_HISTOGRAM_DIFF };
+	for (int j = 0; j < _countof(rgFlags); ++j)
+	{
+		xdchange_t *xscr[2];
+		for (int k = 0; k < 2; ++k)
+		{
+			xpparam_t xpp = { 0 };
+			xdemitconf_t xecfg = { 0 };
+			xdemitcb_t ecb = { 0 };
+			xdfenv_t xe;
+			xpp.flags = rgFlags[j];
+			xpp.threads = k == 0 ? 0 : 4;
+			xecfg.hunk_func = hunk_func;
+			int const result = xdl_diff_modified(&mmfile[0], &mmfile[1], &xpp, &xecfg, &ecb, &xe, &xscr[k]);
+			assert(result == 0);
+			xdl_free_env(&xe);
+		}
+		xdchange_t *p = xscr[0];
+		xdchange_t *q = xscr[1];
+		assert(p != NULL);
+		while (p && q)
+		{
+			assert(p->i1 == q->i1 && p->i2 == q->i2 && p->chg1 == q->chg1 && p->chg2 == q->chg2);
+			p = p->next;
+			q = q->next;
+		}
+		assert(p == NULL && q == NULL);
+		xdl_free_script(xscr[0]);
+		xdl_free_script(xscr[1]);
+	}
+	free(buf[0]);
+	free(buf[1]);
+	return 0;
+}
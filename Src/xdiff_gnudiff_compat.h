@@ -1,3 +1,3 @@
 #pragma once
 
-struct change *diff_2_files_xdiff(struct comparison *, int bMoved_blocks_flag, int *bin_file, int algorithm);
+struct change *diff_2_files_xdiff(struct comparison *, int bMoved_blocks_flag, int *bin_file, int *algorithm, bool *cost_capped, long threads);